@@ -217,13 +217,17 @@ $(4): $(OBJDIR)/$(5)/$(1)
 endef
 
 # Generate list of automatic unit tests from $(call run-unit-test,...)
+# Each entry of RUN_UNIT_TEST is a test and its args joined by ':', such
+# that a test can be registered multiple times with different args.
+_run-unit-test-empty:=
+_run-unit-test-space:=$(_run-unit-test-empty) $(_run-unit-test-empty)
 unit-test: $(OBJDIR)/unit-test/automatic.txt
 define _run-unit-test
-RUN_UNIT_TEST+=$(OBJDIR)/unit-test/$(1)
+RUN_UNIT_TEST+=$(subst $(_run-unit-test-space),:,$(strip $(OBJDIR)/unit-test/$(1) $(2)))
 endef
 $(OBJDIR)/unit-test/automatic.txt:
 	$(MKDIR) "$(OBJDIR)/unit-test"
-	@$(foreach test,$(RUN_UNIT_TEST),echo $(test)>>$@;)
+	@$(foreach test,$(RUN_UNIT_TEST),echo '$(subst :, ,$(test))'>>$@;)
 
 # Generate list of automatic integration tests from $(call run-integration-test,...)
 integration-test: $(OBJDIR)/integration-test/automatic.txt
@@ -269,7 +273,7 @@ make-bin       = $(eval $(call _make-exe,$(1),$(2),$(3),bin,bin,$(4) $(LDFLAGS_E
 make-bin-rust  = $(eval $(call _make-exe,$(1),$(2),$(3),rust,bin,$(4) $(LDFLAGS_EXE)))
 make-shared    = $(eval $(call _make-exe,$(1),$(2),$(3),lib,lib,$(4) $(LDFLAGS_SO)))
 make-unit-test = $(eval $(call _make-exe,$(1),$(2),$(3),unit-test,unit-test,$(4) $(LDFLAGS_EXE)))
-run-unit-test  = $(eval $(call _run-unit-test,$(1)))
+run-unit-test  = $(eval $(call _run-unit-test,$(1),$(2)))
 make-integration-test = $(eval $(call _make-exe,$(1),$(2),$(3),integration-test,integration-test,$(4) $(LDFLAGS_EXE)))
 run-integration-test  = $(eval $(call _run-integration-test,$(1)))
 make-fuzz-test = $(eval $(call _fuzz-test,$(1),$(2),$(3),$(4) $(LDFLAGS_EXE)))
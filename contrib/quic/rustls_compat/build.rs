@@ -0,0 +1,51 @@
+use std::env;
+use std::path::PathBuf;
+
+fn main() {
+    let cargo_manifest_dir = env::var("CARGO_MANIFEST_DIR").unwrap();
+    let mut repo_path = PathBuf::new().join(cargo_manifest_dir);
+    repo_path.pop();
+    repo_path.pop();
+    repo_path.pop();
+
+    let mut lib_path = repo_path.clone();
+    lib_path.push("build");
+    lib_path.push("native");
+    lib_path.push("gcc");
+    lib_path.push("lib");
+
+    let mut src_path = repo_path.clone();
+    src_path.push("src");
+
+    cc::Build::new()
+        .file("shim.c")
+        .include(src_path)
+        .flag("-std=c17")
+        .define("FD_HAS_HOSTED", "1")
+        .define("FD_HAS_ATOMIC", "1")
+        .define("FD_HAS_THREADS", "1")
+        .define("FD_HAS_INT128", "1")
+        .define("FD_HAS_DOUBLE", "1")
+        .define("FD_HAS_ALLOCA", "1")
+        .define("FD_HAS_X86", "1")
+        .define("FD_HAS_SSE", "1")
+        .define("_XOPEN_SOURCE", "700")
+        .compile("fd_tls_shim");
+    println!("cargo:rerun-if-changed=shim.c");
+
+    println!("cargo:rustc-link-search={}", lib_path.to_str().unwrap());
+    for lib in &[
+        "fd_waltz",
+        "fd_tls",
+        "fd_ballet", // crypto
+        "fd_util",
+    ] {
+        println!("cargo:rustc-link-lib=static={}", lib);
+        println!(
+            "cargo:rerun-if-changed={}/lib{}.a",
+            lib_path.to_str().unwrap(),
+            lib
+        );
+    }
+    println!("cargo:rustc-link-lib=static=stdc++"); // fd_tile_threads.cxx
+}
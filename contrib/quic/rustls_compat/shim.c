@@ -0,0 +1,188 @@
+/* C side of the fd_tls <-> rustls interop harness.  Wraps a single
+   fd_tls handshake behind a byte-oriented API. */
+
+#include "waltz/tls/fd_tls.h"
+#include "waltz/tls/test_tls_helper.h"
+#include "ballet/ed25519/fd_x25519.h"
+#include "ballet/x509/fd_x509_mock.h"
+
+static test_record_buf_t _out;
+
+static fd_rng_t               _rng[1];
+static fd_rng_t *             rng;
+static fd_tls_test_sign_ctx_t sign_ctx[1];
+static fd_tls_t               tls[1];
+static int                    is_server;
+static union {
+  fd_tls_estate_srv_t srv;
+  fd_tls_estate_cli_t cli;
+} hs[1];
+
+static fd_tls_session_t _session[1];
+static ulong            _session_cnt;
+
+static uchar tp_peer[ 256 ];
+static ulong tp_peer_sz;
+
+static uchar const tp_self[] = { 0x01, 0x02, 0x47, 0xd0 };
+
+static void
+_secrets( void const * h, void const * r, void const * s, uint level ) {
+  (void)h; (void)r; (void)s; (void)level;
+}
+
+static int
+_sendmsg( void const * h, void const * rec, ulong sz, uint level, int flush ) {
+  (void)h; (void)flush;
+  test_record_send( &_out, level, rec, sz );
+  return 1;
+}
+
+static ulong
+_tp_self( void * h, uchar * tp, ulong bufsz ) {
+  (void)h;
+  FD_TEST( bufsz>=sizeof(tp_self) );
+  fd_memcpy( tp, tp_self, sizeof(tp_self) );
+  return sizeof(tp_self);
+}
+
+static void
+_tp_peer( void * h, uchar const * tp, ulong sz ) {
+  (void)h;
+  FD_TEST( sz<=sizeof(tp_peer) );
+  fd_memcpy( tp_peer, tp, sz );
+  tp_peer_sz = sz;
+}
+
+static void
+_session_fn( void const * h, fd_tls_session_t const * session ) {
+  (void)h;
+  *_session = *session;
+  _session_cnt++;
+}
+
+static ulong
+_clock( void * ctx ) {
+  (void)ctx;
+  return (ulong)fd_log_wallclock() / (ulong)1e6;
+}
+
+static uchar const _ticket_key[ 16 ] = {
+  0x3a, 0x51, 0x0e, 0x8c, 0x27, 0x94, 0xd6, 0x1b,
+  0x70, 0xc2, 0x4f, 0xa9, 0x05, 0xe3, 0x6d, 0xb8
+};
+
+void
+shim_boot( void ) {
+  int argc = 1;
+  char * _argv[] = { "fd_tls_rustls_compat", "--log-level-stderr", "3", NULL };
+  char ** argv = _argv;
+  argc = 3;
+  fd_boot( &argc, &argv );
+  rng = fd_rng_join( fd_rng_new( _rng, (uint)fd_log_wallclock(), 0UL ) );
+}
+
+/* shim_identity generates an Ed25519 identity and its mock X.509 cert.
+   Used for the rustls peer. */
+
+void
+shim_identity( uchar private_key[ 32 ],
+               uchar cert[ FD_X509_MOCK_CERT_SZ ] ) {
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+  uchar public_key[ 32 ];
+  for( ulong b=0; b<32UL; b++ ) private_key[b] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( public_key, private_key, sha );
+  fd_x509_mock_cert( cert, public_key );
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+}
+
+ulong shim_cert_sz( void ) { return FD_X509_MOCK_CERT_SZ; }
+
+/* shim_new starts a new fd_tls handshake.  role 1 is server, 0 is
+   client.  A client offers the last session it received if resume. */
+
+void
+shim_new( int role,
+          int resume ) {
+  test_record_reset( &_out );
+  tp_peer_sz = 0UL;
+  is_server  = role;
+
+  fd_tls_join( fd_tls_new( tls ) );
+  fd_tls_test_sign_ctx( sign_ctx, rng );
+  *tls = (fd_tls_t) {
+    .rand       = fd_tls_test_rand( rng ),
+    .secrets_fn = _secrets,
+    .sendmsg_fn = _sendmsg,
+    .quic       = 1,
+    .quic_tp_peer_fn = _tp_peer,
+    .quic_tp_self_fn = _tp_self,
+    .sign       = fd_tls_test_sign( sign_ctx ),
+    .alpn       = "\xasolana-tpu",
+    .alpn_sz    = 11UL,
+    .clock      = { .clock_fn = _clock },
+  };
+  for( ulong b=0; b<32UL; b++ ) tls->kex_private_key[b] = fd_rng_uchar( rng );
+  fd_x25519_public( tls->kex_public_key, tls->kex_private_key );
+  fd_memcpy( tls->cert_public_key, sign_ctx->public_key, 32UL );
+  fd_x509_mock_cert( tls->cert_x509, tls->cert_public_key );
+  tls->cert_x509_sz = FD_X509_MOCK_CERT_SZ;
+
+  if( role ) {
+    tls->ticket_lifetime = 3600U;
+    fd_tls_rotate_ticket_key( tls, _ticket_key );
+    FD_TEST( fd_tls_estate_srv_new( &hs->srv ) );
+  } else {
+    tls->session_fn = _session_fn;
+    FD_TEST( fd_tls_estate_cli_new( &hs->cli ) );
+    if( resume ) {
+      FD_TEST( _session_cnt );
+      hs->cli.session = _session;
+    }
+    /* ClientHello */
+    FD_TEST( fd_tls_client_handshake( tls, &hs->cli, NULL, 0UL, FD_TLS_LEVEL_INITIAL )>=0L );
+  }
+}
+
+/* shim_recv feeds a handshake message stream chunk.  Returns 0 on
+   success or the negative TLS alert on failure. */
+
+long
+shim_recv( uint          level,
+           uchar const * data,
+           ulong         data_sz ) {
+  while( data_sz ) {
+    long res = is_server ?
+        fd_tls_server_handshake( tls, &hs->srv, data, data_sz, level ) :
+        fd_tls_client_handshake( tls, &hs->cli, data, data_sz, level );
+    if( res<0L ) {
+      FD_LOG_WARNING(( "fd_tls handshake failed (alert %ld-%s; reason %u-%s)",
+                       res, fd_tls_alert_cstr( (uint)-res ),
+                       hs->srv.base.reason, fd_tls_reason_cstr( hs->srv.base.reason ) ));
+      return res;
+    }
+    if( res==0L ) break;
+    data += res; data_sz -= (ulong)res;
+  }
+  return 0L;
+}
+
+/* shim_send pops the next outgoing message.  Returns its size or 0. */
+
+ulong
+shim_send( uint * level,
+           uchar *out,
+           ulong  out_max ) {
+  test_record_t * rec = test_record_recv( &_out );
+  if( !rec ) return 0UL;
+  FD_TEST( rec->cur<=out_max );
+  *level = rec->level;
+  fd_memcpy( out, rec->buf, rec->cur );
+  return rec->cur;
+}
+
+int   shim_connected  ( void ) { return hs->srv.base.state==FD_TLS_HS_CONNECTED; }
+int   shim_resumed    ( void ) { return is_server ? hs->srv.resumed : hs->cli.psk_accepted; }
+int   shim_psk_offered( void ) { return is_server ? 0 : hs->cli.psk_offered; }
+ulong shim_session_cnt( void ) { return _session_cnt; }
+ulong shim_tp_peer_sz ( void ) { return tp_peer_sz; }
@@ -0,0 +1,230 @@
+//! Session resumption interop between fd_tls and rustls (QUIC mode).
+
+use std::sync::Arc;
+
+use rustls::client::danger::{HandshakeSignatureValid, ServerCertVerified, ServerCertVerifier};
+use rustls::crypto::{ring, verify_tls13_signature, CryptoProvider};
+use rustls::pki_types::{CertificateDer, PrivateKeyDer, PrivatePkcs8KeyDer, ServerName, UnixTime};
+use rustls::quic::{self, KeyChange, Version};
+use rustls::server::danger::{ClientCertVerified, ClientCertVerifier};
+use rustls::{DigitallySignedStruct, DistinguishedName, SignatureScheme};
+
+extern "C" {
+    fn shim_boot();
+    fn shim_identity(private_key: *mut u8, cert: *mut u8);
+    fn shim_cert_sz() -> u64;
+    fn shim_new(role: i32, resume: i32);
+    fn shim_recv(level: u32, data: *const u8, sz: u64) -> i64;
+    fn shim_send(level: *mut u32, out: *mut u8, max: u64) -> u64;
+    fn shim_connected() -> i32;
+    fn shim_resumed() -> i32;
+    fn shim_psk_offered() -> i32;
+    fn shim_session_cnt() -> u64;
+    fn shim_tp_peer_sz() -> u64;
+}
+
+const LEVEL_INITIAL: u32 = 0;
+const LEVEL_HANDSHAKE: u32 = 2;
+const LEVEL_APPLICATION: u32 = 3;
+
+fn provider() -> Arc<CryptoProvider> {
+    Arc::new(ring::default_provider())
+}
+
+/// Verifies the peer's handshake signature against its certificate, but
+/// accepts any certificate (like Agave's SkipServerVerification).
+#[derive(Debug)]
+struct AnyCert(Arc<CryptoProvider>);
+
+impl ServerCertVerifier for AnyCert {
+    fn verify_server_cert(&self, _: &CertificateDer<'_>, _: &[CertificateDer<'_>], _: &ServerName<'_>, _: &[u8], _: UnixTime) -> Result<ServerCertVerified, rustls::Error> {
+        Ok(ServerCertVerified::assertion())
+    }
+    fn verify_tls12_signature(&self, _: &[u8], _: &CertificateDer<'_>, _: &DigitallySignedStruct) -> Result<HandshakeSignatureValid, rustls::Error> {
+        Err(rustls::Error::General("tls12".into()))
+    }
+    fn verify_tls13_signature(&self, msg: &[u8], cert: &CertificateDer<'_>, dss: &DigitallySignedStruct) -> Result<HandshakeSignatureValid, rustls::Error> {
+        verify_tls13_signature(msg, cert, dss, &self.0.signature_verification_algorithms)
+    }
+    fn supported_verify_schemes(&self) -> Vec<SignatureScheme> {
+        self.0.signature_verification_algorithms.supported_schemes()
+    }
+}
+
+impl ClientCertVerifier for AnyCert {
+    fn root_hint_subjects(&self) -> &[DistinguishedName] { &[] }
+    fn client_auth_mandatory(&self) -> bool { false }
+    fn verify_client_cert(&self, _: &CertificateDer<'_>, _: &[CertificateDer<'_>], _: UnixTime) -> Result<ClientCertVerified, rustls::Error> {
+        Ok(ClientCertVerified::assertion())
+    }
+    fn verify_tls12_signature(&self, _: &[u8], _: &CertificateDer<'_>, _: &DigitallySignedStruct) -> Result<HandshakeSignatureValid, rustls::Error> {
+        Err(rustls::Error::General("tls12".into()))
+    }
+    fn verify_tls13_signature(&self, msg: &[u8], cert: &CertificateDer<'_>, dss: &DigitallySignedStruct) -> Result<HandshakeSignatureValid, rustls::Error> {
+        verify_tls13_signature(msg, cert, dss, &self.0.signature_verification_algorithms)
+    }
+    fn supported_verify_schemes(&self) -> Vec<SignatureScheme> {
+        self.0.signature_verification_algorithms.supported_schemes()
+    }
+}
+
+/// Returns a mock X.509 cert and PKCS#8 Ed25519 key for the rustls peer.
+fn identity() -> (CertificateDer<'static>, PrivateKeyDer<'static>) {
+    let mut seed = [0u8; 32];
+    let mut cert = vec![0u8; unsafe { shim_cert_sz() } as usize];
+    unsafe { shim_identity(seed.as_mut_ptr(), cert.as_mut_ptr()) };
+    let mut pkcs8 = vec![
+        0x30, 0x2e, 0x02, 0x01, 0x00, 0x30, 0x05, 0x06, 0x03, 0x2b, 0x65, 0x70, 0x04, 0x22, 0x04, 0x20,
+    ];
+    pkcs8.extend_from_slice(&seed);
+    (CertificateDer::from(cert), PrivateKeyDer::Pkcs8(PrivatePkcs8KeyDer::from(pkcs8)))
+}
+
+const TP: [u8; 4] = [0x01, 0x02, 0x47, 0xd0];
+
+/// Moves handshake data from rustls to fd_tls.  Returns false on an
+/// fd_tls alert.
+fn rustls_to_fd(conn: &mut quic::Connection, level: &mut u32) -> bool {
+    loop {
+        let mut buf = Vec::new();
+        let change = conn.write_hs(&mut buf);
+        if !buf.is_empty() {
+            if unsafe { shim_recv(*level, buf.as_ptr(), buf.len() as u64) } < 0 {
+                return false;
+            }
+        }
+        match change {
+            Some(KeyChange::Handshake { .. }) => *level = LEVEL_HANDSHAKE,
+            Some(KeyChange::OneRtt { .. }) => *level = LEVEL_APPLICATION,
+            None => {
+                if buf.is_empty() {
+                    return true;
+                }
+            }
+        }
+    }
+}
+
+/// Moves one handshake message from fd_tls to rustls.  Returns false
+/// if fd_tls had nothing to send.
+fn fd_to_rustls(conn: &mut quic::Connection) -> bool {
+    let mut buf = vec![0u8; 4096];
+    let mut level = 0u32;
+    let sz = unsafe { shim_send(&mut level, buf.as_mut_ptr(), buf.len() as u64) } as usize;
+    if sz == 0 {
+        return false;
+    }
+    if let Err(e) = conn.read_hs(&buf[..sz]) {
+        panic!("rustls rejected fd_tls message: {e:?} (alert {:?})", conn.alert());
+    }
+    true
+}
+
+/// Runs a handshake to completion.  Returns (fd_tls resumed, rustls resumed).
+fn handshake(mut conn: quic::Connection) -> (bool, bool) {
+    let mut level = LEVEL_INITIAL;
+    // rustls expects a write_hs call between messages of different
+    // encryption levels, so move fd_tls output one message at a time.
+    loop {
+        assert!(rustls_to_fd(&mut conn, &mut level), "fd_tls rejected rustls message");
+        if !fd_to_rustls(&mut conn) {
+            break;
+        }
+    }
+    assert_ne!(unsafe { shim_connected() }, 0, "fd_tls handshake incomplete");
+    assert_eq!(conn.quic_transport_parameters(), Some(&TP[..]));
+    assert_eq!(unsafe { shim_tp_peer_sz() }, TP.len() as u64);
+    let rustls_resumed = match &conn {
+        quic::Connection::Client(c) => {
+            assert!(!c.is_handshaking());
+            c.handshake_kind() == Some(rustls::HandshakeKind::Resumed)
+        }
+        quic::Connection::Server(s) => {
+            assert!(!s.is_handshaking());
+            s.handshake_kind() == Some(rustls::HandshakeKind::Resumed)
+        }
+    };
+    (unsafe { shim_resumed() } != 0, rustls_resumed)
+}
+
+fn client_config() -> Arc<rustls::ClientConfig> {
+    let p = provider();
+    let (cert, key) = identity();
+    let mut cfg = rustls::ClientConfig::builder_with_provider(p.clone())
+        .with_protocol_versions(&[&rustls::version::TLS13])
+        .unwrap()
+        .dangerous()
+        .with_custom_certificate_verifier(Arc::new(AnyCert(p)))
+        .with_client_auth_cert(vec![cert], key)
+        .unwrap();
+    cfg.alpn_protocols = vec![b"solana-tpu".to_vec()];
+    Arc::new(cfg)
+}
+
+fn server_config(stateless: bool) -> Arc<rustls::ServerConfig> {
+    let p = provider();
+    let (cert, key) = identity();
+    let mut cfg = rustls::ServerConfig::builder_with_provider(p.clone())
+        .with_protocol_versions(&[&rustls::version::TLS13])
+        .unwrap()
+        .with_client_cert_verifier(Arc::new(AnyCert(p)))
+        .with_single_cert(vec![cert], key)
+        .unwrap();
+    cfg.alpn_protocols = vec![b"solana-tpu".to_vec()];
+    if stateless {
+        cfg.ticketer = ring::Ticketer::new().unwrap();
+    }
+    Arc::new(cfg)
+}
+
+/// rustls client => fd_tls server
+fn test_server() {
+    let cfg = client_config();
+    let name = ServerName::try_from("localhost").unwrap();
+    for (i, resume) in [false, true, true].into_iter().enumerate() {
+        unsafe { shim_new(1, 0) };
+        let conn = quic::ClientConnection::new(cfg.clone(), Version::V1, name.clone(), TP.to_vec()).unwrap();
+        let (fd, rs) = handshake(quic::Connection::Client(conn));
+        println!("rustls client => fd_tls server #{i}: fd_tls resumed={fd} rustls resumed={rs}");
+        assert_eq!(fd, resume);
+        assert_eq!(rs, resume);
+    }
+}
+
+/// fd_tls client => rustls server
+fn test_client(stateless: bool) {
+    let cfg = server_config(stateless);
+    for (i, resume) in [false, true, true].into_iter().enumerate() {
+        let cnt = unsafe { shim_session_cnt() };
+        unsafe { shim_new(0, resume as i32) };
+        let conn = quic::ServerConnection::new(cfg.clone(), Version::V1, TP.to_vec()).unwrap();
+        let (fd, rs) = handshake(quic::Connection::Server(conn));
+        println!(
+            "fd_tls client => rustls server ({}) #{i}: offered={} fd_tls resumed={fd} rustls resumed={rs} new tickets={}",
+            if stateless { "stateless" } else { "stateful" },
+            unsafe { shim_psk_offered() },
+            unsafe { shim_session_cnt() } - cnt
+        );
+        assert_eq!(unsafe { shim_psk_offered() } != 0, resume);
+        assert_eq!(fd, resume);
+        assert_eq!(rs, resume);
+        assert!(unsafe { shim_session_cnt() } > cnt);
+    }
+
+    // A server that does not know the ticket falls back to a full handshake
+    let other = server_config(stateless);
+    unsafe { shim_new(0, 1) };
+    let conn = quic::ServerConnection::new(other, Version::V1, TP.to_vec()).unwrap();
+    let (fd, rs) = handshake(quic::Connection::Server(conn));
+    println!("fd_tls client => unrelated rustls server: offered={} fd_tls resumed={fd} rustls resumed={rs}", unsafe { shim_psk_offered() });
+    assert!(unsafe { shim_psk_offered() } != 0);
+    assert!(!fd && !rs);
+}
+
+fn main() {
+    unsafe { shim_boot() };
+    test_server();
+    test_client(false);
+    test_client(true);
+    println!("pass");
+}
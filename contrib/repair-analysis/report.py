@@ -13,7 +13,12 @@ This script generates a report on repair analysis off of one testnet run.
        enabled = true
        folder_path = /my/folder
 
-2. Start up firedancer-dev with the above config. The following files will be generated:
+2. Start up firedancer-dev with the above config. The capture will be
+   written to /my/folder/capture.bin.  Convert it with
+
+     build/native/gcc/bin/fd_shredcap_convert --capture /my/folder/capture.bin --out /my/folder
+
+   The following files will be generated:
     - /my/folder/request_data.csv
     - /my/folder/shred_data.csv
     - /my/folder/fec_complete.csv
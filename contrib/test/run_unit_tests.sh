@@ -268,7 +268,7 @@ dispatch () {
   local logdir
   logdir="$(dirname "$(dirname "$prog")")/log/$progname"
   mkdir -p "$logdir"
-  local log; log="$logdir/$(date -u +%Y%m%d-%H%M%S).log"
+  local log; log="$logdir/$(date -u +%Y%m%d-%H%M%S)-$cpu.log"
 
   if [[ "$VERBOSE" == 1 ]]; then
     echo "test.sh: NUMA $numa_idx: $progname" >&2
@@ -302,7 +302,9 @@ sow () {
       local test="${TEST_LIST[0]}"
       TEST_LIST=( "${TEST_LIST[@]:1}" )
       NUMA_JOBS[$numa]="$(( NUMA_JOBS[numa] - 1 ))"
-      dispatch "$numa" "$cpu" "$test"
+      # A test line is the test path followed by its args
+      # shellcheck disable=SC2086
+      dispatch "$numa" "$cpu" $test
     done
   done
 }
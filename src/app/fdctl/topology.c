@@ -137,7 +137,7 @@ fd_topo_initialize( config_t * config ) {
 
   fd_topos_net_tiles( topo, config->layout.net_tile_count, &config->net, config->tiles.netlink.max_routes, config->tiles.netlink.max_peer_routes, config->tiles.netlink.max_neighbors, tile_to_cpu );
 
-  FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_quic",  i, config->net.ingress_buffer_size );
+  FOR(net_tile_cnt) fd_topos_net_rx_lanes( topo, "net_quic",  i, config->net.ingress_buffer_size, quic_tile_cnt );
   FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_shred", i, config->net.ingress_buffer_size );
 
   /*                                  topo, tile_name, tile_wksp, metrics_wksp, cpu_idx,                       is_agave, uses_keyswitch */
@@ -160,8 +160,7 @@ fd_topo_initialize( config_t * config ) {
   for( ulong j=0UL; j<shred_tile_cnt; j++ )
                    fd_topos_tile_in_net(  topo,                          "metric_in", "shred_net",    j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
 
-  FOR(quic_tile_cnt) for( ulong j=0UL; j<net_tile_cnt; j++ )
-                       fd_topob_tile_in(  topo, "quic",    i,            "metric_in", "net_quic",     j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
+  FOR(quic_tile_cnt)   fd_topos_tile_in_net_lane( topo, "quic", i, "metric_in", "net_quic", i, FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   FOR(quic_tile_cnt)   fd_topob_tile_out( topo, "quic",    i,                         "quic_verify",  i                                                  );
   FOR(quic_tile_cnt)   fd_topob_tile_out( topo, "quic",    i,                         "quic_net",     i                                                  );
   /* All verify tiles read from all QUIC tiles, packets are round robin. */
@@ -378,6 +377,7 @@ fd_topo_initialize( config_t * config ) {
   }
   FD_TEST( fd_pod_insertf_ulong( topo->props, poh_shred_obj->id, "poh_shred" ) );
 
+  if( config->net.xdp.direct_tx ) FOR(shred_tile_cnt) fd_topos_net_tx_direct( topo, "shred_net", i );
   FOR(net_tile_cnt) fd_topos_net_tile_finish( topo, i );
 
   for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
@@ -403,6 +403,7 @@ fd_topo_initialize( config_t * config ) {
       tile->quic.idle_timeout_millis            = config->tiles.quic.idle_timeout_millis;
       tile->quic.ack_delay_millis               = config->tiles.quic.ack_delay_millis;
       tile->quic.retry                          = config->tiles.quic.retry;
+      tile->quic.session_ticket_ttl_seconds     = config->tiles.quic.session_ticket_ttl_seconds;
       fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( tile->quic.key_log_path ), config->tiles.quic.ssl_key_log_file, sizeof(tile->quic.key_log_path) ) );
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "bundle" ) ) ) {
@@ -494,6 +495,9 @@ fd_topo_initialize( config_t * config ) {
       if( FD_UNLIKELY( !fd_cstr_to_ip4_addr( config->tiles.metric.prometheus_listen_address, &tile->metric.prometheus_listen_addr ) ) )
         FD_LOG_ERR(( "failed to parse prometheus listen address `%s`", config->tiles.metric.prometheus_listen_address ));
       tile->metric.prometheus_listen_port = config->tiles.metric.prometheus_listen_port;
+      fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( tile->metric.recorder_path ), config->tiles.metric.recorder_path, sizeof(tile->metric.recorder_path)-1UL ) );
+      tile->metric.recorder_interval_ns   = (long)config->tiles.metric.recorder_interval_millis * 1000000L;
+      tile->metric.recorder_file_sz       = config->tiles.metric.recorder_max_file_size_mib << 20;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "cswtch" ) ) ) {
 
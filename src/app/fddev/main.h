@@ -126,6 +126,7 @@ extern action_t fd_action_dump;
 extern action_t fd_action_flame;
 extern action_t fd_action_help;
 extern action_t fd_action_load;
+extern action_t fd_action_metrics_dump;
 extern action_t fd_action_pktgen;
 extern action_t fd_action_quic_trace;
 extern action_t fd_action_txn;
@@ -153,6 +154,7 @@ action_t * ACTIONS[] = {
   &fd_action_dump,
   &fd_action_flame,
   &fd_action_load,
+  &fd_action_metrics_dump,
   &fd_action_pktgen,
   &fd_action_quic_trace,
   &fd_action_txn,
@@ -197,6 +197,24 @@ backtest_topo( config_t * config ) {
   FOR(writer_tile_cnt) for( ulong j=0UL; j<exec_tile_cnt; j++ )
     fd_topob_tile_in( topo, "writer", i, "metric_in", "exec_writer", j, FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
 
+  /**********************************************************************/
+  /* Setup the solcap tile and ring, if capturing asynchronously        */
+  /**********************************************************************/
+
+  if( FD_UNLIKELY( strlen( config->capture.solcap_capture ) && config->capture.solcap_ring_sz ) ) {
+    /* The backtest tile halts the ring once playback is done, such
+       that the capture is complete before the topology exits. */
+    fd_topob_wksp( topo, "solcap" );
+    fd_topo_tile_t * solcap_tile = fd_topob_tile( topo, "solcap", "solcap", "metric_in", cpu_idx++, 0, 0 );
+
+    fd_topo_obj_t * solcap_ring_obj = fd_topob_obj( topo, "solcap_ring", "solcap" );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, fd_ulong_pow2_up( config->capture.solcap_ring_sz ), "obj.%lu.depth", solcap_ring_obj->id ) );
+    fd_topob_tile_uses( topo, replay_tile,   solcap_ring_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    fd_topob_tile_uses( topo, solcap_tile,   solcap_ring_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    fd_topob_tile_uses( topo, backtest_tile, solcap_ring_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, solcap_ring_obj->id, "solcap_ring" ) );
+  }
+
   /**********************************************************************/
   /* Setup the shared objs used by replay and exec tiles                */
   /**********************************************************************/
@@ -205,7 +223,7 @@ backtest_topo( config_t * config ) {
 
   /* blockstore_obj shared by replay and backtest tiles */
   fd_topob_wksp( topo, "blockstore" );
-  fd_topo_obj_t * blockstore_obj = setup_topo_blockstore( topo, "blockstore", config->firedancer.blockstore.shred_max, config->firedancer.blockstore.block_max, config->firedancer.blockstore.idx_max, config->firedancer.blockstore.alloc_max );
+  fd_topo_obj_t * blockstore_obj = setup_topo_blockstore( topo, "blockstore", config->firedancer.blockstore.shred_max, config->firedancer.blockstore.block_max, config->firedancer.blockstore.idx_max, config->firedancer.blockstore.alloc_max, 0 );
   fd_topob_tile_uses( topo, replay_tile, blockstore_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   fd_topob_tile_uses( topo, backtest_tile, blockstore_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FD_TEST( fd_pod_insertf_ulong( topo->props, blockstore_obj->id, "blockstore" ) );
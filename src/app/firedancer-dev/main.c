@@ -27,6 +27,7 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_exec_spad;
 extern fd_topo_obj_callbacks_t fd_obj_cb_banks;
 extern fd_topo_obj_callbacks_t fd_obj_cb_funk;
 extern fd_topo_obj_callbacks_t fd_obj_cb_bank_hash_cmp;
+extern fd_topo_obj_callbacks_t fd_obj_cb_solcap_ring;
 
 fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_mcache,
@@ -48,6 +49,7 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_banks,
   &fd_obj_cb_funk,
   &fd_obj_cb_bank_hash_cmp,
+  &fd_obj_cb_solcap_ring,
   NULL,
 };
 
@@ -98,6 +100,8 @@ extern fd_topo_run_tile_t fd_tile_poh;
 extern fd_topo_run_tile_t fd_tile_send;
 extern fd_topo_run_tile_t fd_tile_tower;
 extern fd_topo_run_tile_t fd_tile_rpcserv;
+extern fd_topo_run_tile_t fd_tile_rpcsim;
+extern fd_topo_run_tile_t fd_tile_solcap;
 extern fd_topo_run_tile_t fd_tile_backtest;
 extern fd_topo_run_tile_t fd_tile_archiver_feeder;
 extern fd_topo_run_tile_t fd_tile_archiver_writer;
@@ -136,6 +140,8 @@ fd_topo_run_tile_t * TILES[] = {
   &fd_tile_send,
   &fd_tile_tower,
   &fd_tile_rpcserv,
+  &fd_tile_rpcsim,
+  &fd_tile_solcap,
   &fd_tile_archiver_feeder,
   &fd_tile_archiver_writer,
   &fd_tile_archiver_playback,
@@ -171,6 +177,7 @@ extern action_t fd_action_dump;
 extern action_t fd_action_flame;
 extern action_t fd_action_help;
 extern action_t fd_action_load;
+extern action_t fd_action_metrics_dump;
 extern action_t fd_action_pktgen;
 extern action_t fd_action_quic_trace;
 extern action_t fd_action_txn;
@@ -199,6 +206,7 @@ action_t * ACTIONS[] = {
   &fd_action_dump,
   &fd_action_flame,
   &fd_action_load,
+  &fd_action_metrics_dump,
   &fd_action_pktgen,
   &fd_action_quic_trace,
   &fd_action_txn,
@@ -6,6 +6,7 @@
 #include "../../flamenco/runtime/fd_blockstore.h"
 #include "../../flamenco/runtime/fd_runtime.h"
 #include "../../flamenco/runtime/fd_runtime_public.h"
+#include "../../flamenco/capture/fd_solcap_ring.h"
 
 #define VAL(name) (__extension__({                                                             \
   ulong __x = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "obj.%lu.%s", obj->id, name );      \
@@ -143,7 +144,15 @@ blockstore_align( fd_topo_t const *     topo FD_FN_UNUSED,
 static void
 blockstore_new( fd_topo_t const *     topo,
                 fd_topo_obj_t const * obj ) {
-  FD_TEST( fd_blockstore_new( fd_topo_obj_laddr( topo, obj->id ), VAL("wksp_tag"), VAL("seed"), VAL("shred_max"), VAL("block_max"), VAL("idx_max") ) );
+  void * shblockstore = fd_blockstore_new( fd_topo_obj_laddr( topo, obj->id ), VAL("wksp_tag"), VAL("seed"), VAL("shred_max"), VAL("block_max"), VAL("idx_max") );
+  FD_TEST( shblockstore );
+
+  /* Completed blocks are only copied out for the RPC server */
+  fd_blockstore_t   ljoin[1];
+  fd_blockstore_t * blockstore = fd_blockstore_join( ljoin, shblockstore );
+  FD_TEST( blockstore );
+  fd_blockstore_block_data_enable( blockstore, !!VAL("block_data") );
+  FD_TEST( fd_blockstore_leave( blockstore ) );
 }
 
 fd_topo_obj_callbacks_t fd_obj_cb_blockstore = {
@@ -253,4 +262,29 @@ fd_topo_obj_callbacks_t fd_obj_cb_exec_spad = {
   .new       = exec_spad_new,
 };
 
+static ulong
+solcap_ring_footprint( fd_topo_t const *     topo,
+                       fd_topo_obj_t const * obj ) {
+  return fd_solcap_ring_footprint( VAL("depth") );
+}
+
+static ulong
+solcap_ring_align( fd_topo_t const *     topo FD_FN_UNUSED,
+                   fd_topo_obj_t const * obj  FD_FN_UNUSED ) {
+  return fd_solcap_ring_align();
+}
+
+static void
+solcap_ring_new( fd_topo_t const *     topo,
+                 fd_topo_obj_t const * obj ) {
+  FD_TEST( fd_solcap_ring_new( fd_topo_obj_laddr( topo, obj->id ), VAL("depth") ) );
+}
+
+fd_topo_obj_callbacks_t fd_obj_cb_solcap_ring = {
+  .name      = "solcap_ring",
+  .footprint = solcap_ring_footprint,
+  .align     = solcap_ring_align,
+  .new       = solcap_ring_new,
+};
+
 #undef VAL
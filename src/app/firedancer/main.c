@@ -25,6 +25,7 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_exec_spad;
 extern fd_topo_obj_callbacks_t fd_obj_cb_banks;
 extern fd_topo_obj_callbacks_t fd_obj_cb_funk;
 extern fd_topo_obj_callbacks_t fd_obj_cb_bank_hash_cmp;
+extern fd_topo_obj_callbacks_t fd_obj_cb_solcap_ring;
 
 fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_mcache,
@@ -46,6 +47,7 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_banks,
   &fd_obj_cb_funk,
   &fd_obj_cb_bank_hash_cmp,
+  &fd_obj_cb_solcap_ring,
   NULL,
 };
 
@@ -86,6 +88,8 @@ extern fd_topo_run_tile_t fd_tile_poh;
 extern fd_topo_run_tile_t fd_tile_send;
 extern fd_topo_run_tile_t fd_tile_tower;
 extern fd_topo_run_tile_t fd_tile_rpcserv;
+extern fd_topo_run_tile_t fd_tile_rpcsim;
+extern fd_topo_run_tile_t fd_tile_solcap;
 
 fd_topo_run_tile_t * TILES[] = {
   &fd_tile_net,
@@ -112,6 +116,8 @@ fd_topo_run_tile_t * TILES[] = {
   &fd_tile_send,
   &fd_tile_tower,
   &fd_tile_rpcserv,
+  &fd_tile_rpcsim,
+  &fd_tile_solcap,
   NULL,
 };
 
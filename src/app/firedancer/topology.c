@@ -1,6 +1,7 @@
 #include "topology.h"
 
 #include "../../discof/replay/fd_replay_notif.h"
+#include "../../discof/rpcserver/fd_rpcsim.h"
 #include "../../disco/net/fd_net_tile.h"
 #include "../../disco/quic/fd_tpu.h"
 #include "../../disco/tiles.h"
@@ -24,7 +25,8 @@ setup_topo_blockstore( fd_topo_t *  topo,
                        ulong        shred_max,
                        ulong        block_max,
                        ulong        idx_max,
-                       ulong        alloc_max ) {
+                       ulong        alloc_max,
+                       int          block_data ) {
   fd_topo_obj_t * obj = fd_topob_obj( topo, "blockstore", wksp_name );
 
   ulong seed;
@@ -36,6 +38,7 @@ setup_topo_blockstore( fd_topo_t *  topo,
   FD_TEST( fd_pod_insertf_ulong( topo->props, block_max,  "obj.%lu.block_max",  obj->id ) );
   FD_TEST( fd_pod_insertf_ulong( topo->props, idx_max,    "obj.%lu.idx_max",    obj->id ) );
   FD_TEST( fd_pod_insertf_ulong( topo->props, alloc_max,  "obj.%lu.alloc_max",  obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, !!block_data, "obj.%lu.block_data", obj->id ) );
 
   /* DO NOT MODIFY LOOSE WITHOUT CHANGING HOW BLOCKSTORE ALLOCATES INTERNAL STRUCTURES */
 
@@ -228,6 +231,7 @@ fd_topo_initialize( config_t * config ) {
   ulong resolv_tile_cnt = config->layout.resolv_tile_count;
 
   int enable_rpc = ( config->rpc.port != 0 );
+  ulong rpcsim_tile_cnt = enable_rpc ? config->rpc.simulate_tile_count : 0UL;
 
   fd_topo_t * topo = { fd_topob_new( &config->topo, config->name ) };
   topo->max_page_size = fd_cstr_to_shmem_page_sz( config->hugetlbfs.max_page_size );
@@ -321,6 +325,12 @@ fd_topo_initialize( config_t * config ) {
 
   fd_topob_wksp( topo, "slot_fseqs"  ); /* fseqs for marked slots eg. turbine slot */
   if( enable_rpc ) fd_topob_wksp( topo, "rpcsrv" );
+  if( rpcsim_tile_cnt ) {
+    fd_topob_wksp( topo, "rpcsim"      );
+    fd_topob_wksp( topo, "rpcsim_spad" );
+    fd_topob_wksp( topo, "rpc_sim"     );
+    fd_topob_wksp( topo, "sim_rpc"     );
+  }
 
   #define FOR(cnt) for( ulong i=0UL; i<cnt; i++ )
 
@@ -361,6 +371,9 @@ fd_topo_initialize( config_t * config ) {
 
   FOR(exec_tile_cnt)   fd_topob_link( topo, "exec_writer",  "exec_writer",  128UL,                                    FD_EXEC_WRITER_MTU,            1UL );
 
+  FOR(rpcsim_tile_cnt) fd_topob_link( topo, "rpc_sim",      "rpc_sim",      FD_RPCSIM_LINK_DEPTH,                     FD_RPCSIM_REQ_MTU,             1UL );
+  FOR(rpcsim_tile_cnt) fd_topob_link( topo, "sim_rpc",      "sim_rpc",      FD_RPCSIM_LINK_DEPTH,                     FD_RPCSIM_RES_MTU,             1UL );
+
   /**/                 fd_topob_link( topo, "gossip_verif", "gossip_verif", config->tiles.verify.receive_buffer_size, FD_TPU_MTU,                    1UL );
   /**/                 fd_topob_link( topo, "gossip_tower", "gossip_tower", 128UL,                                    FD_TPU_MTU,                    1UL );
   /**/                 fd_topob_link( topo, "replay_tower", "replay_tower", 128UL,                                    65536UL,                       1UL );
@@ -432,7 +445,7 @@ fd_topo_initialize( config_t * config ) {
 
   FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_gossip", i, config->net.ingress_buffer_size );
   FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_repair", i, config->net.ingress_buffer_size );
-  FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_quic",   i, config->net.ingress_buffer_size );
+  FOR(net_tile_cnt) fd_topos_net_rx_lanes( topo, "net_quic",   i, config->net.ingress_buffer_size, quic_tile_cnt );
   FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_shred",  i, config->net.ingress_buffer_size );
   FOR(net_tile_cnt) fd_topos_net_rx_link( topo, "net_send",   i, config->net.ingress_buffer_size );
 
@@ -457,6 +470,7 @@ fd_topo_initialize( config_t * config ) {
 
   fd_topo_tile_t * rpcserv_tile = NULL;
   if( enable_rpc ) rpcserv_tile =  fd_topob_tile( topo, "rpcsrv",  "rpcsrv",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
+  FOR(rpcsim_tile_cnt)             fd_topob_tile( topo, "rpcsim",  "rpcsim",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
 
   fd_topo_tile_t * snaprd_tile = fd_topob_tile( topo, "snaprd", "snaprd", "metric_in", tile_to_cpu[ topo->tile_cnt ], 0, 0 );
   snaprd_tile->allow_shutdown = 1;
@@ -476,6 +490,7 @@ fd_topo_initialize( config_t * config ) {
   FOR(exec_tile_cnt)   fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   /*                */ fd_topob_tile_uses( topo, replay_tile,  funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   if(rpcserv_tile)     fd_topob_tile_uses( topo, rpcserv_tile, funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FOR(rpcsim_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "rpcsim", i ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FOR(writer_tile_cnt) fd_topob_tile_uses( topo,  &topo->tiles[ fd_topo_find_tile( topo, "writer", i ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
 
   /* Setup a shared wksp object for the blockstore. */
@@ -484,7 +499,8 @@ fd_topo_initialize( config_t * config ) {
                                                           config->firedancer.blockstore.shred_max,
                                                           config->firedancer.blockstore.block_max,
                                                           config->firedancer.blockstore.idx_max,
-                                                          config->firedancer.blockstore.alloc_max );
+                                                          config->firedancer.blockstore.alloc_max,
+                                                          !!rpcserv_tile );
   fd_topob_tile_uses( topo, replay_tile, blockstore_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   fd_topob_tile_uses( topo, repair_tile, blockstore_obj, FD_SHMEM_JOIN_MODE_READ_ONLY );
   if( enable_rpc ) {
@@ -499,6 +515,7 @@ fd_topo_initialize( config_t * config ) {
   fd_topob_tile_uses( topo, replay_tile, banks_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FOR(exec_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], banks_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FOR(writer_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "writer", i ) ], banks_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FOR(rpcsim_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "rpcsim", i ) ], banks_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FD_TEST( fd_pod_insertf_ulong( topo->props, banks_obj->id, "banks" ) );
 
   /* Setup a shared wksp object for bank hash cmp. */
@@ -564,6 +581,12 @@ fd_topo_initialize( config_t * config ) {
     FD_TEST( fd_pod_insertf_ulong( topo->props, exec_spad_obj->id, "exec_spad.%lu", i ) );
   }
 
+  for( ulong i=0UL; i<rpcsim_tile_cnt; i++ ) {
+    fd_topo_obj_t * rpcsim_spad_obj = fd_topob_obj( topo, "exec_spad", "rpcsim_spad" );
+    fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "rpcsim", i ) ], rpcsim_spad_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, rpcsim_spad_obj->id, "rpcsim_spad.%lu", i ) );
+  }
+
   for( ulong i=0UL; i<exec_tile_cnt; i++ ) {
     fd_topo_obj_t * exec_fseq_obj = fd_topob_obj( topo, "fseq", "exec_fseq" );
     fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], exec_fseq_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
@@ -644,8 +667,7 @@ fd_topo_initialize( config_t * config ) {
                   fd_topos_tile_in_net(  topo,                          "metric_in", "shred_net",    j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   for( ulong j=0UL; j<quic_tile_cnt; j++ )
                   fd_topos_tile_in_net(  topo,                          "metric_in", "quic_net",     j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
-  FOR(quic_tile_cnt) for( ulong j=0UL; j<net_tile_cnt; j++ )
-                      fd_topob_tile_in(  topo, "quic",    i,            "metric_in", "net_quic",     j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
+  FOR(quic_tile_cnt)   fd_topos_tile_in_net_lane( topo, "quic", i, "metric_in", "net_quic", i, FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   FOR(quic_tile_cnt)   fd_topob_tile_out( topo, "quic",    i,                         "quic_verify",  i                                                  );
   FOR(quic_tile_cnt)   fd_topob_tile_out( topo, "quic",    i,                         "quic_net",     i                                                  );
   /* All verify tiles read from all QUIC tiles, packets are round robin. */
@@ -809,6 +831,19 @@ fd_topo_initialize( config_t * config ) {
     fd_topob_tile_out( topo, "replay", 0UL, "replay_scap", 0UL );
   }
 
+  if( FD_UNLIKELY( strlen( config->capture.solcap_capture ) && config->capture.solcap_ring_sz ) ) {
+    /* The replay tile publishes the solcap capture into a ring which is
+       written to disk by the solcap tile. */
+    fd_topob_wksp( topo, "solcap" );
+    fd_topo_tile_t * solcap_tile = fd_topob_tile( topo, "solcap", "solcap", "metric_in", tile_to_cpu[ topo->tile_cnt ], 0, 0 );
+
+    fd_topo_obj_t * solcap_ring_obj = fd_topob_obj( topo, "solcap_ring", "solcap" );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, fd_ulong_pow2_up( config->capture.solcap_ring_sz ), "obj.%lu.depth", solcap_ring_obj->id ) );
+    fd_topob_tile_uses( topo, replay_tile, solcap_ring_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    fd_topob_tile_uses( topo, solcap_tile, solcap_ring_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, solcap_ring_obj->id, "solcap_ring" ) );
+  }
+
   fd_topob_wksp( topo, "replay_notif" );
   /* We may be notifying an external service, so always publish on this link. */
   /**/ fd_topob_link( topo, "replay_notif", "replay_notif", FD_REPLAY_NOTIF_DEPTH, FD_REPLAY_NOTIF_MTU, 1UL )->permit_no_consumers = 1;
@@ -817,6 +852,13 @@ fd_topo_initialize( config_t * config ) {
   if( enable_rpc ) {
     fd_topob_tile_in(  topo, "rpcsrv", 0UL, "metric_in",  "replay_notif", 0UL, FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   );
     fd_topob_tile_in(  topo, "rpcsrv", 0UL, "metric_in",  "stake_out",    0UL, FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   );
+
+    /* Results of rpcsim tile i are in link 2+i of rpcsrv, and requests
+       to it are out link i */
+    FOR(rpcsim_tile_cnt) fd_topob_tile_out( topo, "rpcsrv", 0UL,              "rpc_sim", i                                          );
+    FOR(rpcsim_tile_cnt) fd_topob_tile_in(  topo, "rpcsim", i,   "metric_in", "rpc_sim", i, FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED   );
+    FOR(rpcsim_tile_cnt) fd_topob_tile_out( topo, "rpcsim", i,                "sim_rpc", i                                          );
+    FOR(rpcsim_tile_cnt) fd_topob_tile_in(  topo, "rpcsrv", 0UL, "metric_in", "sim_rpc", i, FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED   );
   }
 
   /* For now the only plugin consumer is the GUI */
@@ -850,6 +892,7 @@ fd_topo_initialize( config_t * config ) {
     /**/                 fd_topob_tile_in(  topo, "gui",    0UL,        "metric_in",     "plugin_out",   0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   }
 
+  if( config->net.xdp.direct_tx ) FOR(shred_tile_cnt) fd_topos_net_tx_direct( topo, "shred_net", i );
   FOR(net_tile_cnt) fd_topos_net_tile_finish( topo, i );
 
   for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
@@ -912,6 +955,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
       tile->quic.idle_timeout_millis            = config->tiles.quic.idle_timeout_millis;
       tile->quic.ack_delay_millis               = config->tiles.quic.ack_delay_millis;
       tile->quic.retry                          = config->tiles.quic.retry;
+      tile->quic.session_ticket_ttl_seconds     = config->tiles.quic.session_ticket_ttl_seconds;
       fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( tile->quic.key_log_path ), config->tiles.quic.ssl_key_log_file, sizeof(tile->quic.key_log_path) ) );
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "verify" ) ) ) {
@@ -997,6 +1041,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
 
       tile->replay.capture_start_slot = config->capture.capture_start_slot;
       strncpy( tile->replay.solcap_capture, config->capture.solcap_capture, sizeof(tile->replay.solcap_capture) );
+      tile->replay.solcap_ring_obj_id = fd_pod_query_ulong( config->topo.props, "solcap_ring", ULONG_MAX );
       strncpy( tile->replay.dump_proto_dir, config->capture.dump_proto_dir, sizeof(tile->replay.dump_proto_dir) );
       tile->replay.dump_block_to_pb = config->capture.dump_block_to_pb;
 
@@ -1009,6 +1054,9 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
       if( FD_UNLIKELY( !fd_cstr_to_ip4_addr( config->tiles.metric.prometheus_listen_address, &tile->metric.prometheus_listen_addr ) ) )
         FD_LOG_ERR(( "failed to parse prometheus listen address `%s`", config->tiles.metric.prometheus_listen_address ));
       tile->metric.prometheus_listen_port = config->tiles.metric.prometheus_listen_port;
+      fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( tile->metric.recorder_path ), config->tiles.metric.recorder_path, sizeof(tile->metric.recorder_path)-1UL ) );
+      tile->metric.recorder_interval_ns   = (long)config->tiles.metric.recorder_interval_millis * 1000000L;
+      tile->metric.recorder_file_sz       = config->tiles.metric.recorder_max_file_size_mib << 20;
     } else if( FD_UNLIKELY( !strcmp( tile->name, "pack" ) ) ) {
       tile->pack.max_pending_transactions      = config->tiles.pack.max_pending_transactions;
       tile->pack.bank_tile_count               = config->layout.bank_tile_count;
@@ -1040,6 +1088,10 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
       tile->rpcserv.acct_index_max = config->rpc.acct_index_max;
       strncpy( tile->rpcserv.history_file, config->rpc.history_file, sizeof(tile->rpcserv.history_file) );
       strncpy( tile->rpcserv.identity_key_path, config->paths.identity_key, sizeof(tile->rpcserv.identity_key_path) );
+      tile->rpcserv.sim_timeout_millis = config->rpc.simulate_timeout_millis;
+    } else if( FD_UNLIKELY( !strcmp( tile->name, "rpcsim" ) ) ) {
+      tile->rpcsim.funk_obj_id = fd_pod_query_ulong( config->topo.props, "funk", ULONG_MAX );
+      tile->rpcsim.cu_max      = config->rpc.simulate_compute_unit_limit;
     } else if( FD_UNLIKELY( !strcmp( tile->name, "gui" ) ) ) {
       if( FD_UNLIKELY( !fd_cstr_to_ip4_addr( config->tiles.gui.gui_listen_address, &tile->gui.listen_addr ) ) )
         FD_LOG_ERR(( "failed to parse gui listen address `%s`", config->tiles.gui.gui_listen_address ));
@@ -1076,6 +1128,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
       strncpy( tile->archiver.rocksdb_path, config->tiles.archiver.rocksdb_path, sizeof(tile->archiver.rocksdb_path) );
     } else if( FD_UNLIKELY( !strcmp( tile->name, "back" ) ) ) {
         tile->archiver.end_slot = config->tiles.archiver.end_slot;
+        tile->archiver.solcap_ring_obj_id = fd_pod_query_ulong( config->topo.props, "solcap_ring", ULONG_MAX );
         strncpy( tile->archiver.ingest_mode, config->tiles.archiver.ingest_mode, sizeof(tile->archiver.ingest_mode) );
         if( FD_UNLIKELY( 0==strlen( tile->archiver.ingest_mode ) ) ) {
           FD_LOG_ERR(( "`archiver.ingest_mode` not specified in toml" ));
@@ -1103,6 +1156,9 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
       tile->shredcap.repair_intake_listen_port = config->tiles.repair.repair_intake_listen_port;
       strncpy( tile->shredcap.folder_path, config->tiles.shredcap.folder_path, sizeof(tile->shredcap.folder_path) );
       tile->shredcap.write_buffer_size = config->tiles.shredcap.write_buffer_size;
+    } else if( FD_UNLIKELY( !strcmp( tile->name, "solcap" ) ) ) {
+      strncpy( tile->solcap.path, config->capture.solcap_capture, sizeof(tile->solcap.path) );
+      tile->solcap.ring_obj_id = fd_pod_query_ulong( config->topo.props, "solcap_ring", ULONG_MAX );
     } else {
       return 0;
     }
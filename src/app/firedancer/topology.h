@@ -19,7 +19,8 @@ setup_topo_blockstore( fd_topo_t *  topo,
                        ulong        shred_max,
                        ulong        block_max,
                        ulong        idx_max,
-                       ulong        alloc_max );
+                       ulong        alloc_max,
+                       int          block_data );
 
 fd_topo_obj_t *
 setup_topo_runtime_pub( fd_topo_t *  topo,
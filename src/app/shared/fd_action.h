@@ -67,6 +67,13 @@ union fdctl_args {
     char name[ 13UL ];
   } flame;
 
+  struct {
+    char   file_path[ 256UL ];
+    char   filter[ 64UL ];
+    double last_seconds;
+    int    summary;
+  } metrics_dump;
+
   struct {
     char    affinity[ AFFINITY_SZ ];
     uint    tpu_ip;
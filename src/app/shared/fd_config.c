@@ -7,6 +7,7 @@
 #include "genesis_hash.h"
 #include "../../ballet/toml/fd_toml.h"
 #include "../../disco/genesis/fd_genesis_cluster.h"
+#include "../../disco/net/fd_net_tile.h"
 
 #include <unistd.h>
 #include <errno.h>
@@ -505,6 +506,10 @@ fd_config_validate( fd_config_t const * config ) {
     CFG_HAS_NON_EMPTY( net.xdp.xdp_mode );
     CFG_HAS_POW2     ( net.xdp.xdp_rx_queue_size );
     CFG_HAS_POW2     ( net.xdp.xdp_tx_queue_size );
+    if( FD_UNLIKELY( config->layout.quic_tile_count>FD_NET_RX_LANE_MAX ) ) {
+      FD_LOG_ERR(( "`layout.quic_tile_count` must be at most %lu with the \"xdp\" `net.provider`, "
+                   "as each net tile steers packets to at most that many QUIC tiles", FD_NET_RX_LANE_MAX ));
+    }
   } else if( 0==strcmp( config->net.provider, "socket" ) ) {
     CFG_HAS_NON_ZERO( net.socket.receive_buffer_size );
     CFG_HAS_NON_ZERO( net.socket.send_buffer_size );
@@ -538,6 +543,11 @@ fd_config_validate( fd_config_t const * config ) {
   }
 
   CFG_HAS_NON_ZERO( tiles.metric.prometheus_listen_port );
+  CFG_HAS_NON_ZERO( tiles.metric.recorder_interval_millis );
+  CFG_HAS_NON_ZERO( tiles.metric.recorder_max_file_size_mib );
+  if( FD_UNLIKELY( config->tiles.metric.recorder_max_file_size_mib>(ULONG_MAX>>20) ) ) {
+    FD_LOG_ERR(( "`tiles.metric.recorder_max_file_size_mib` must be at most %lu", ULONG_MAX>>20 ));
+  }
 
   CFG_HAS_NON_ZERO( tiles.gui.gui_listen_port );
 
@@ -158,6 +158,7 @@ struct fd_config_net {
   struct {
     char xdp_mode[ 8 ];
     int  xdp_zero_copy;
+    int  direct_tx;
 
     uint xdp_rx_queue_size;
     uint xdp_tx_queue_size;
@@ -242,6 +243,9 @@ struct fd_config {
     uint   txn_index_max;
     uint   acct_index_max;
     char   history_file[ PATH_MAX ];
+    uint   simulate_tile_count;
+    ulong  simulate_compute_unit_limit;
+    ulong  simulate_timeout_millis;
   } rpc;
 
   struct {
@@ -297,6 +301,21 @@ struct fd_config {
       ulong fund_initial_amount_lamports;
       ulong vote_account_stake_lamports;
       int   warmup_epochs;
+
+      struct {
+        ulong seed;
+        ulong validators;
+        ulong stake_accounts;
+        ulong stake_lamports;
+        ulong token_mints;
+        ulong token_accounts;
+        ulong data_accounts;
+        ulong data_size_min;
+        ulong data_size_max;
+        ulong data_owners;
+        ulong system_accounts;
+        ulong threads;
+      } synthetic;
     } genesis;
 
     struct {
@@ -346,6 +365,7 @@ struct fd_config {
       uint idle_timeout_millis;
       uint ack_delay_millis;
       int  retry;
+      uint session_ticket_ttl_seconds;
 
       char ssl_key_log_file[ PATH_MAX ];
     } quic;
@@ -399,6 +419,9 @@ struct fd_config {
     struct {
       char   prometheus_listen_address[ 16 ];
       ushort prometheus_listen_port;
+      char   recorder_path[ PATH_MAX ];
+      ulong  recorder_interval_millis;
+      ulong  recorder_max_file_size_mib;
     } metric;
 
     struct {
@@ -457,6 +480,7 @@ struct fd_config {
     ulong capture_start_slot;
     char  dump_proto_dir[ PATH_MAX ];
     char  solcap_capture[ PATH_MAX ];
+    ulong solcap_ring_sz;
     int   dump_syscall_to_pb;
     int   dump_instr_to_pb;
     int   dump_txn_to_pb;
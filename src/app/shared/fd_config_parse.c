@@ -151,6 +151,9 @@ fd_config_extract_pod( uchar *       pod,
     CFG_POP      ( uint,   rpc.txn_index_max                              );
     CFG_POP      ( uint,   rpc.acct_index_max                             );
     CFG_POP      ( cstr,   rpc.history_file                               );
+    CFG_POP      ( uint,   rpc.simulate_tile_count                        );
+    CFG_POP      ( ulong,  rpc.simulate_compute_unit_limit                );
+    CFG_POP      ( ulong,  rpc.simulate_timeout_millis                    );
   }
 
   CFG_POP      ( cstr,   layout.affinity                                  );
@@ -172,6 +175,7 @@ fd_config_extract_pod( uchar *       pod,
   CFG_POP      ( uint,   net.ingress_buffer_size                          );
   CFG_POP      ( cstr,   net.xdp.xdp_mode                                 );
   CFG_POP      ( bool,   net.xdp.xdp_zero_copy                            );
+  CFG_POP      ( bool,   net.xdp.direct_tx                                );
   CFG_POP      ( uint,   net.xdp.xdp_rx_queue_size                        );
   CFG_POP      ( uint,   net.xdp.xdp_tx_queue_size                        );
   CFG_POP      ( uint,   net.xdp.flush_timeout_micros                     );
@@ -190,6 +194,7 @@ fd_config_extract_pod( uchar *       pod,
   CFG_POP      ( uint,   tiles.quic.idle_timeout_millis                   );
   CFG_POP      ( uint,   tiles.quic.ack_delay_millis                      );
   CFG_POP      ( bool,   tiles.quic.retry                                 );
+  CFG_POP      ( uint,   tiles.quic.session_ticket_ttl_seconds            );
   CFG_POP      ( cstr,   tiles.quic.ssl_key_log_file                      );
 
   CFG_POP      ( uint,   tiles.verify.signature_cache_size                );
@@ -221,6 +226,9 @@ fd_config_extract_pod( uchar *       pod,
 
   CFG_POP      ( cstr,   tiles.metric.prometheus_listen_address           );
   CFG_POP      ( ushort, tiles.metric.prometheus_listen_port              );
+  CFG_POP      ( cstr,   tiles.metric.recorder_path                       );
+  CFG_POP      ( ulong,  tiles.metric.recorder_interval_millis            );
+  CFG_POP      ( ulong,  tiles.metric.recorder_max_file_size_mib          );
 
   CFG_POP      ( bool,   tiles.gui.enabled                                );
   CFG_POP      ( cstr,   tiles.gui.gui_listen_address                     );
@@ -237,6 +245,7 @@ fd_config_extract_pod( uchar *       pod,
 
   CFG_POP      ( ulong,  capture.capture_start_slot                       );
   CFG_POP      ( cstr,   capture.solcap_capture                           );
+  CFG_POP      ( ulong,  capture.solcap_ring_sz                           );
   CFG_POP      ( cstr,   capture.dump_proto_dir                           );
   CFG_POP      ( bool,   capture.dump_syscall_to_pb                       );
   CFG_POP      ( bool,   capture.dump_instr_to_pb                          );
@@ -295,6 +304,18 @@ fd_config_extract_pod( uchar *       pod,
   CFG_POP      ( ulong,  development.genesis.fund_initial_amount_lamports );
   CFG_POP      ( ulong,  development.genesis.vote_account_stake_lamports  );
   CFG_POP      ( bool,   development.genesis.warmup_epochs                );
+  CFG_POP      ( ulong,  development.genesis.synthetic.seed               );
+  CFG_POP      ( ulong,  development.genesis.synthetic.validators         );
+  CFG_POP      ( ulong,  development.genesis.synthetic.stake_accounts     );
+  CFG_POP      ( ulong,  development.genesis.synthetic.stake_lamports     );
+  CFG_POP      ( ulong,  development.genesis.synthetic.token_mints        );
+  CFG_POP      ( ulong,  development.genesis.synthetic.token_accounts     );
+  CFG_POP      ( ulong,  development.genesis.synthetic.data_accounts      );
+  CFG_POP      ( ulong,  development.genesis.synthetic.data_size_min      );
+  CFG_POP      ( ulong,  development.genesis.synthetic.data_size_max      );
+  CFG_POP      ( ulong,  development.genesis.synthetic.data_owners        );
+  CFG_POP      ( ulong,  development.genesis.synthetic.system_accounts    );
+  CFG_POP      ( ulong,  development.genesis.synthetic.threads            );
 
   CFG_POP      ( uint,   development.bench.benchg_tile_count              );
   CFG_POP      ( uint,   development.bench.benchs_tile_count              );
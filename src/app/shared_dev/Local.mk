@@ -13,6 +13,7 @@ $(call add-objs,commands/dev,fddev_shared)
 $(call add-objs,commands/dump,fddev_shared)
 $(call add-objs,commands/flame,fddev_shared)
 $(call add-objs,commands/load,fddev_shared)
+$(call add-objs,commands/metrics_dump,fddev_shared)
 $(call add-objs,commands/pktgen/pktgen,fddev_shared)
 $(call add-objs,commands/txn,fddev_shared)
 $(call add-objs,commands/udpecho/udpecho,fddev_shared)
@@ -8,10 +8,14 @@
 #include "../../../../disco/keyguard/fd_keyload.h"
 #include "../../../../flamenco/features/fd_features.h"
 #include "../../../../flamenco/genesis/fd_genesis_create.h"
+#include "../../../../flamenco/genesis/fd_genesis_synth.h"
 #include "../../../../flamenco/types/fd_types_custom.h"
 #include "../../../../flamenco/runtime/sysvar/fd_sysvar_clock.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <unistd.h>
 #include <dirent.h>
 #include <sys/stat.h>
@@ -218,6 +222,188 @@ create_genesis( config_t const * config,
   return blob_sz;
 }
 
+/* The synthetic accounts are generated by a pool of threads, each of
+   which writes a contiguous range of accounts to its own region of the
+   genesis file.  A first pass computes the size of each range. */
+
+#define SYNTH_THREAD_MAX (256UL)
+#define SYNTH_BUF_SZ     (8UL<<20)
+
+struct synth_part {
+  fd_genesis_synth_t const * synth;
+  int                        fd;
+  ulong                      idx0;
+  ulong                      idx1;
+  ulong                      off;  /* file offset of account idx0 */
+  ulong                      sz;   /* encoded size of accounts [idx0,idx1) */
+};
+
+typedef struct synth_part synth_part_t;
+
+static void
+pwrite_all( int          fd,
+            void const * buf,
+            ulong        sz,
+            ulong        off ) {
+  uchar const * p = (uchar const *)buf;
+  while( sz ) {
+    long res = pwrite( fd, p, sz, (long)off );
+    if( FD_UNLIKELY( res<=0L ) ) {
+      if( FD_LIKELY( res<0L && errno==EINTR ) ) continue;
+      FD_LOG_ERR(( "pwrite() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    }
+    p   += (ulong)res;
+    off += (ulong)res;
+    sz  -= (ulong)res;
+  }
+}
+
+static void *
+synth_size_main( void * _part ) {
+  synth_part_t * part = (synth_part_t *)_part;
+  part->sz = fd_genesis_synth_range_sz( part->synth, part->idx0, part->idx1 );
+  return NULL;
+}
+
+static void *
+synth_write_main( void * _part ) {
+  synth_part_t * part   = (synth_part_t *)_part;
+  ulong          sz_max = fd_genesis_synth_acct_sz_max( part->synth );
+  ulong          buf_sz = fd_ulong_max( SYNTH_BUF_SZ, sz_max );
+  uchar *        buf    = malloc( buf_sz );
+  if( FD_UNLIKELY( !buf ) ) FD_LOG_ERR(( "malloc(%lu) failed", buf_sz ));
+
+  ulong off = part->off;
+  ulong cnt = 0UL;
+  for( ulong i=part->idx0; i<part->idx1; i++ ) {
+    if( FD_UNLIKELY( cnt+sz_max>buf_sz ) ) {
+      pwrite_all( part->fd, buf, cnt, off );
+      off += cnt;
+      cnt  = 0UL;
+    }
+    cnt += fd_genesis_synth_acct( part->synth, i, buf+cnt );
+  }
+  pwrite_all( part->fd, buf, cnt, off );
+  off += cnt;
+  FD_TEST( off==part->off+part->sz );
+
+  free( buf );
+  return NULL;
+}
+
+static void
+synth_run( synth_part_t * parts,
+           ulong          thread_cnt,
+           void *      (* fn)( void * ) ) {
+  pthread_t threads[ SYNTH_THREAD_MAX ];
+  for( ulong i=0UL; i<thread_cnt; i++ ) {
+    int err = pthread_create( &threads[ i ], NULL, fn, &parts[ i ] );
+    if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "pthread_create() failed (%i-%s)", err, fd_io_strerror( err ) ));
+  }
+  for( ulong i=0UL; i<thread_cnt; i++ ) {
+    int err = pthread_join( threads[ i ], NULL );
+    if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "pthread_join() failed (%i-%s)", err, fd_io_strerror( err ) ));
+  }
+}
+
+/* write_synthetic writes the genesis blob [blob,blob+blob_sz) extended
+   with the configured synthetic accounts to the file fd.  Returns the
+   size of the file. */
+
+static ulong
+write_synthetic( config_t const * config,
+                 int              fd,
+                 uchar const *    blob,
+                 ulong            blob_sz ) {
+  fd_genesis_synth_options_t opts = {
+    .seed           = config->development.genesis.synthetic.seed,
+    .validator_cnt  = config->development.genesis.synthetic.validators,
+    .stake_cnt      = config->development.genesis.synthetic.stake_accounts,
+    .stake_lamports = config->development.genesis.synthetic.stake_lamports,
+    .mint_cnt       = config->development.genesis.synthetic.token_mints,
+    .token_cnt      = config->development.genesis.synthetic.token_accounts,
+    .data_cnt       = config->development.genesis.synthetic.data_accounts,
+    .data_sz_min    = config->development.genesis.synthetic.data_size_min,
+    .data_sz_max    = config->development.genesis.synthetic.data_size_max,
+    .owner_cnt      = config->development.genesis.synthetic.data_owners,
+    .system_cnt     = config->development.genesis.synthetic.system_accounts,
+  };
+
+  static uchar scratch_smem[ 16<<20UL ];
+         ulong scratch_fmem[ 4 ];
+  fd_scratch_attach( scratch_smem, scratch_fmem,
+                     sizeof(scratch_smem), sizeof(scratch_fmem)/sizeof(ulong) );
+  fd_genesis_synth_t synth[1];
+  if( FD_UNLIKELY( !fd_genesis_synth_init( synth, &opts, blob, blob_sz ) ) ) FD_LOG_ERR(( "invalid [development.genesis.synthetic] options" ));
+  fd_scratch_detach( NULL );
+
+  ulong thread_cnt = config->development.genesis.synthetic.threads;
+  if( !thread_cnt ) thread_cnt = fd_shmem_cpu_cnt();
+  thread_cnt = fd_ulong_max( fd_ulong_min( fd_ulong_min( thread_cnt, SYNTH_THREAD_MAX ), synth->acct_cnt ), 1UL );
+
+  long dt = -fd_log_wallclock();
+
+  static synth_part_t parts[ SYNTH_THREAD_MAX ];
+  for( ulong i=0UL; i<thread_cnt; i++ ) {
+    parts[ i ] = (synth_part_t){
+      .synth = synth,
+      .fd    = fd,
+      .idx0  = synth->acct_cnt* i     /thread_cnt,
+      .idx1  = synth->acct_cnt*(i+1UL)/thread_cnt,
+    };
+  }
+  synth_run( parts, thread_cnt, synth_size_main );
+
+  ulong off = synth->acct_end_off;
+  for( ulong i=0UL; i<thread_cnt; i++ ) {
+    parts[ i ].off = off;
+    off += parts[ i ].sz;
+  }
+  ulong file_sz = off + blob_sz - synth->acct_end_off;
+
+  /* Firedancer reads and bincode decodes the whole genesis into its
+     runtime heap at boot (see fd_runtime_read_genesis), which takes
+     about twice the file size, and keeps it there for the lifetime of
+     the process.  Refuse to write a genesis it can't load. */
+  if( config->is_firedancer ) {
+    ulong heap_sz = config->firedancer.runtime.heap_size_gib<<30;
+    if( FD_UNLIKELY( file_sz>heap_sz/2UL ) )
+      FD_LOG_ERR(( "the synthetic genesis would be %lu bytes, but it is decoded into the runtime heap at boot, "
+                   "which needs about twice that and [runtime.heap_size_gib] is %lu.  Reduce the number or size "
+                   "of [development.genesis.synthetic] accounts or increase [runtime.heap_size_gib].",
+                   file_sz, config->firedancer.runtime.heap_size_gib ));
+  }
+
+  if( FD_UNLIKELY( ftruncate( fd, (long)file_sz ) ) ) FD_LOG_ERR(( "ftruncate() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  synth_run( parts, thread_cnt, synth_write_main );
+
+  /* The accounts vector of the base blob, with the synthetic accounts
+     added to its length, and everything after it */
+
+  ulong acct_cnt = synth->base_acct_cnt + synth->acct_cnt;
+  ulong hdr_sz   = synth->cnt_off + sizeof(ulong);
+  pwrite_all( fd, blob,                     synth->cnt_off,                  0UL            );
+  pwrite_all( fd, &acct_cnt,                sizeof(ulong),                   synth->cnt_off );
+  pwrite_all( fd, blob+hdr_sz,              synth->acct_end_off-hdr_sz,      hdr_sz         );
+  pwrite_all( fd, blob+synth->acct_end_off, blob_sz-synth->acct_end_off,     off            );
+
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "generated %lu synthetic genesis accounts (%lu bytes) with %lu threads in %.3f s",
+                  synth->acct_cnt, file_sz-blob_sz, thread_cnt, (double)dt/1e9 ));
+  return file_sz;
+}
+
+static ulong
+synthetic_acct_cnt( config_t const * config ) {
+  return config->development.genesis.synthetic.validators      +
+         config->development.genesis.synthetic.stake_accounts  +
+         config->development.genesis.synthetic.token_mints     +
+         config->development.genesis.synthetic.token_accounts  +
+         config->development.genesis.synthetic.data_accounts   +
+         config->development.genesis.synthetic.system_accounts;
+}
+
 static void
 init( config_t const * config ) {
   if( FD_UNLIKELY( -1==fd_file_util_mkdir_all( config->paths.ledger, config->uid, config->gid ) ) )
@@ -240,12 +426,17 @@ init( config_t const * config ) {
 
   char genesis_path[ PATH_MAX ];
   FD_TEST( fd_cstr_printf_check( genesis_path, PATH_MAX, NULL, "%s/genesis.bin", config->paths.ledger ) );
-  do {
+  if( FD_LIKELY( !synthetic_acct_cnt( config ) ) ) {
     FILE * genesis_file = fopen( genesis_path, "w" );
     FD_TEST( genesis_file );
     FD_TEST( 1L == fwrite( blob, blob_sz, 1L, genesis_file ) );
     FD_TEST( !fclose( genesis_file ) );
-  } while(0);
+  } else {
+    int fd = open( genesis_path, O_WRONLY|O_CREAT|O_TRUNC, S_IRUSR|S_IWUSR );
+    if( FD_UNLIKELY( fd<0 ) ) FD_LOG_ERR(( "open(`%s`) failed (%i-%s)", genesis_path, errno, fd_io_strerror( errno ) ));
+    blob_sz = write_synthetic( config, fd, blob, blob_sz );
+    if( FD_UNLIKELY( close( fd ) ) ) FD_LOG_ERR(( "close(`%s`) failed (%i-%s)", genesis_path, errno, fd_io_strerror( errno ) ));
+  }
 
   umask( previous );
 
@@ -0,0 +1,313 @@
+#include "../../shared/fd_config.h"
+#include "../../shared/fd_action.h"
+#include "../../../disco/metrics/fd_metrics.h"
+#include "../../../disco/metrics/fd_metrics_rec.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* metrics-dump reads back a recording written by the metric tile when
+   [tiles.metric.recorder_path] is set (see fd_metrics_rec.h), and
+   prints either every sample in a time window as CSV, or a summary of
+   each metric over the window.
+
+   Values are printed raw, as they are in the metrics shared memory, so
+   metrics measured in ticks are not converted. */
+
+#define COLUMN_NAME_SZ (128UL)
+
+struct column {
+  char  name[ COLUMN_NAME_SZ ];
+  int   is_counter;
+  ulong idx;
+
+  /* Summary over the window */
+  ulong sample_cnt;
+  ulong min;
+  ulong max;
+  double sum;
+  double rate_min;
+  double rate_max;
+  ulong stall_cnt;  /* Intervals where a counter did not change */
+  ulong prev;
+};
+
+typedef struct column column_t;
+
+struct dump_ctx {
+  column_t * cols;
+  ulong      col_cnt;
+  long       ts_begin;
+  long       ts_prev;
+  long       gap_ns;   /* Consecutive samples further apart than this are not used for rates */
+  int        summary;
+  ulong      row_cnt;
+};
+
+typedef struct dump_ctx dump_ctx_t;
+
+void
+metrics_dump_cmd_args( int *    pargc,
+                       char *** pargv,
+                       args_t * args ) {
+  char const * file_path = fd_env_strip_cmdline_cstr  ( pargc, pargv, "--file",    NULL, ""  );
+  char const * filter    = fd_env_strip_cmdline_cstr  ( pargc, pargv, "--filter",  NULL, ""  );
+  args->metrics_dump.last_seconds = fd_env_strip_cmdline_double( pargc, pargv, "--last", NULL, 0.0 );
+  args->metrics_dump.summary      = fd_env_strip_cmdline_contains( pargc, pargv, "--summary" );
+
+  if( FD_UNLIKELY( args->metrics_dump.last_seconds<0.0 ) ) FD_LOG_ERR(( "--last must be non-negative" ));
+  if( FD_UNLIKELY( strlen( file_path )>=sizeof(args->metrics_dump.file_path) ) )
+    FD_LOG_ERR(( "--file `%s` is too long (max %lu)", file_path, sizeof(args->metrics_dump.file_path)-1UL ));
+  if( FD_UNLIKELY( strlen( filter )>=sizeof(args->metrics_dump.filter) ) )
+    FD_LOG_ERR(( "--filter `%s` is too long (max %lu)", filter, sizeof(args->metrics_dump.filter)-1UL ));
+  fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( args->metrics_dump.file_path ), file_path, sizeof(args->metrics_dump.file_path)-1UL ) );
+  fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( args->metrics_dump.filter ),    filter,    sizeof(args->metrics_dump.filter)-1UL    ) );
+}
+
+/* add_column appends a column for the value at idx to col, unless it
+   does not match filter.  col has room for col_max columns, and there
+   are col_max values in a sample.  Columns beyond col_max can only come
+   from tiles overlapping in a corrupt recording, and are dropped. */
+
+static ulong
+add_column( column_t *                col,
+            ulong                     col_cnt,
+            ulong                     col_max,
+            char const *              filter,
+            fd_metrics_rec_tile_t const * tile,
+            fd_metrics_meta_t const * meta,
+            char const *              suffix,
+            ulong                     idx ) {
+  char name[ COLUMN_NAME_SZ ];
+  if( FD_UNLIKELY( !fd_cstr_printf_check( name, sizeof(name), NULL, "%s:%lu:%s%s%s%s", tile->name, tile->kind_id, meta->name,
+                                          meta->enum_variant ? ":" : "", meta->enum_variant ? meta->enum_variant : "", suffix ) ) )
+    FD_LOG_ERR(( "metric name too long" ));
+  if( FD_LIKELY( filter[ 0 ] && !strstr( name, filter ) ) ) return col_cnt;
+  if( FD_UNLIKELY( col_cnt>=col_max || idx>=col_max ) ) return col_cnt;
+
+  column_t * c = &col[ col_cnt ];
+  memset( c, 0, sizeof(column_t) );
+  strcpy( c->name, name );
+  c->is_counter = meta->type!=FD_METRICS_TYPE_GAUGE;
+  c->idx        = idx;
+  c->min        = ULONG_MAX;
+  c->rate_min   = (double)ULONG_MAX;
+  return col_cnt+1UL;
+}
+
+static ulong
+add_tile_meta( column_t *                    col,
+               ulong                         col_cnt,
+               ulong                         col_max,
+               char const *                  filter,
+               fd_metrics_rec_tile_t const * tile,
+               ulong                         base,
+               fd_metrics_meta_t const *     metas,
+               ulong                         meta_cnt ) {
+  for( ulong i=0UL; i<meta_cnt; i++ ) {
+    fd_metrics_meta_t const * meta = &metas[ i ];
+    if( FD_LIKELY( meta->type!=FD_METRICS_TYPE_HISTOGRAM ) ) {
+      col_cnt = add_column( col, col_cnt, col_max, filter, tile, meta, "", base+meta->offset );
+    } else {
+      char suffix[ 32 ];
+      for( ulong k=0UL; k<FD_HISTF_BUCKET_CNT; k++ ) {
+        FD_TEST( fd_cstr_printf_check( suffix, sizeof(suffix), NULL, "_bucket%lu", k ) );
+        col_cnt = add_column( col, col_cnt, col_max, filter, tile, meta, suffix, base+meta->offset+k );
+      }
+      col_cnt = add_column( col, col_cnt, col_max, filter, tile, meta, "_sum", base+meta->offset+FD_HISTF_BUCKET_CNT );
+    }
+  }
+  return col_cnt;
+}
+
+/* build_columns fills col with the columns of every metric in the
+   recording that matches filter, and returns how many there are.  col
+   has room for hdr->value_cnt columns.  The values of each tile must
+   lie within a sample, anything else is a corrupt recording. */
+
+static ulong
+build_columns( column_t *                   col,
+               fd_metrics_rec_hdr_t const * hdr,
+               char const *                 filter ) {
+  ulong col_max = hdr->value_cnt;
+  ulong col_cnt = 0UL;
+  for( ulong i=0UL; i<hdr->tile_cnt; i++ ) {
+    fd_metrics_rec_tile_t const * tile = &hdr->tile[ i ];
+
+    if( FD_UNLIKELY( !memchr( tile->name, '\0', sizeof(tile->name) ) ||
+                     tile->in_cnt>col_max || tile->out_cnt>col_max || tile->value_off>col_max ||
+                     tile->value_off + 2UL + tile->in_cnt*FD_METRICS_ALL_LINK_IN_TOTAL + tile->out_cnt*FD_METRICS_ALL_LINK_OUT_TOTAL +
+                     FD_METRICS_TOTAL_SZ/sizeof(ulong) > col_max ) )
+      FD_LOG_ERR(( "recording has a corrupt descriptor for tile %lu", i ));
+
+    ulong base = tile->value_off + 2UL;
+
+    char suffix[ 32 ];
+    for( ulong j=0UL; j<tile->in_cnt; j++ ) {
+      FD_TEST( fd_cstr_printf_check( suffix, sizeof(suffix), NULL, ":in%lu", j ) );
+      for( ulong m=0UL; m<FD_METRICS_ALL_LINK_IN_TOTAL; m++ ) {
+        col_cnt = add_column( col, col_cnt, col_max, filter, tile, &FD_METRICS_ALL_LINK_IN[ m ], suffix, base+j*FD_METRICS_ALL_LINK_IN_TOTAL+m );
+      }
+    }
+    base += tile->in_cnt*FD_METRICS_ALL_LINK_IN_TOTAL;
+
+    for( ulong j=0UL; j<tile->out_cnt; j++ ) {
+      FD_TEST( fd_cstr_printf_check( suffix, sizeof(suffix), NULL, ":out%lu", j ) );
+      for( ulong m=0UL; m<FD_METRICS_ALL_LINK_OUT_TOTAL; m++ ) {
+        col_cnt = add_column( col, col_cnt, col_max, filter, tile, &FD_METRICS_ALL_LINK_OUT[ m ], suffix, base+j*FD_METRICS_ALL_LINK_OUT_TOTAL+m );
+      }
+    }
+    base += tile->out_cnt*FD_METRICS_ALL_LINK_OUT_TOTAL;
+
+    col_cnt = add_tile_meta( col, col_cnt, col_max, filter, tile, base, FD_METRICS_ALL, FD_METRICS_ALL_TOTAL );
+    for( ulong k=0UL; k<FD_METRICS_TILE_KIND_CNT; k++ ) {
+      if( FD_LIKELY( strcmp( FD_METRICS_TILE_KIND_NAMES[ k ], tile->name ) ) ) continue;
+      col_cnt = add_tile_meta( col, col_cnt, col_max, filter, tile, base, FD_METRICS_TILE_KIND_METRICS[ k ], FD_METRICS_TILE_KIND_SIZES[ k ] );
+    }
+  }
+  return col_cnt;
+}
+
+static void
+on_sample( void *        _ctx,
+           long          ts,
+           ulong const * values ) {
+  dump_ctx_t * ctx = (dump_ctx_t *)_ctx;
+  if( FD_UNLIKELY( ts<ctx->ts_begin ) ) return;
+
+  if( FD_UNLIKELY( !ctx->summary ) ) {
+    printf( "%ld", ts );
+    for( ulong i=0UL; i<ctx->col_cnt; i++ ) printf( ",%lu", values[ ctx->cols[ i ].idx ] );
+    printf( "\n" );
+    ctx->row_cnt++;
+    return;
+  }
+
+  long dt = ts - ctx->ts_prev;
+  int  has_rate = ctx->row_cnt>0UL && dt>0L && dt<=ctx->gap_ns;
+  for( ulong i=0UL; i<ctx->col_cnt; i++ ) {
+    column_t * c = &ctx->cols[ i ];
+    ulong      v = values[ c->idx ];
+    c->sample_cnt++;
+    c->min  = fd_ulong_min( c->min, v );
+    c->max  = fd_ulong_max( c->max, v );
+    c->sum += (double)v;
+    if( FD_LIKELY( c->is_counter && has_rate ) ) {
+      double rate = (double)(v - c->prev) * 1e9 / (double)dt;
+      c->rate_min = fd_double_if( rate<c->rate_min, rate, c->rate_min );
+      c->rate_max = fd_double_if( rate>c->rate_max, rate, c->rate_max );
+      c->stall_cnt += (ulong)(v==c->prev);
+    }
+    c->prev = v;
+  }
+  ctx->ts_prev = ts;
+  ctx->row_cnt++;
+}
+
+static int
+block_seq_cmp( void const * a,
+               void const * b ) {
+  ulong sa = (*(fd_metrics_rec_block_t const **)a)->seq;
+  ulong sb = (*(fd_metrics_rec_block_t const **)b)->seq;
+  return (sa>sb) - (sa<sb);
+}
+
+void
+metrics_dump_cmd_fn( args_t *   args,
+                     config_t * config ) {
+  char const * path = args->metrics_dump.file_path[ 0 ] ? args->metrics_dump.file_path : config->tiles.metric.recorder_path;
+  if( FD_UNLIKELY( !path[ 0 ] ) ) FD_LOG_ERR(( "no recording to read, pass --file or set [tiles.metric.recorder_path]" ));
+
+  int fd = open( path, O_RDONLY|O_CLOEXEC );
+  if( FD_UNLIKELY( -1==fd ) ) FD_LOG_ERR(( "open(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+
+  struct stat st;
+  if( FD_UNLIKELY( -1==fstat( fd, &st ) ) ) FD_LOG_ERR(( "fstat(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  ulong file_sz = (ulong)st.st_size;
+  if( FD_UNLIKELY( file_sz<FD_METRICS_REC_HDR_SZ ) ) FD_LOG_ERR(( "`%s` is not a metrics recording", path ));
+
+  uchar const * file = mmap( NULL, file_sz, PROT_READ, MAP_PRIVATE, fd, 0 );
+  if( FD_UNLIKELY( MAP_FAILED==file ) ) FD_LOG_ERR(( "mmap(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( -1==close( fd ) ) ) FD_LOG_ERR(( "close(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+
+  fd_metrics_rec_hdr_t const * hdr = (fd_metrics_rec_hdr_t const *)file;
+  if( FD_UNLIKELY( hdr->magic!=FD_METRICS_REC_MAGIC ) )     FD_LOG_ERR(( "`%s` is not a metrics recording", path ));
+  if( FD_UNLIKELY( hdr->version!=FD_METRICS_REC_VERSION ) ) FD_LOG_ERR(( "`%s` has unsupported version %lu", path, hdr->version ));
+  if( FD_UNLIKELY( hdr->tile_cnt>FD_TOPO_MAX_TILES || hdr->value_cnt>FD_METRICS_REC_VALUE_MAX || !hdr->block_sz ) )
+    FD_LOG_ERR(( "`%s` has a corrupt header", path ));
+
+  /* The writer might not have filled the whole ring yet, in which case
+     the file is shorter than block_cnt blocks. */
+
+  ulong block_cnt = fd_ulong_min( hdr->block_cnt, (file_sz-FD_METRICS_REC_HDR_SZ)/hdr->block_sz );
+
+  fd_metrics_rec_block_t const ** blocks = malloc( fd_ulong_max( block_cnt, 1UL )*sizeof(fd_metrics_rec_block_t const *) );
+  ulong   *                       values = malloc( fd_ulong_max( hdr->value_cnt, 1UL )*sizeof(ulong) );
+  column_t *                      cols   = malloc( fd_ulong_max( hdr->value_cnt, 1UL )*sizeof(column_t) );
+  if( FD_UNLIKELY( !blocks || !values || !cols ) ) FD_LOG_ERR(( "malloc failed" ));
+
+  ulong valid_cnt = 0UL;
+  long  ts_end    = LONG_MIN;
+  for( ulong i=0UL; i<block_cnt; i++ ) {
+    fd_metrics_rec_block_t const * block = (fd_metrics_rec_block_t const *)(file + FD_METRICS_REC_HDR_SZ + i*hdr->block_sz);
+    if( FD_UNLIKELY( block->magic!=FD_METRICS_REC_MAGIC || !block->sample_cnt ) ) continue;
+    blocks[ valid_cnt++ ] = block;
+    ts_end = fd_long_max( ts_end, block->ts_last );
+  }
+  qsort( blocks, valid_cnt, sizeof(fd_metrics_rec_block_t const *), block_seq_cmp );
+
+  dump_ctx_t ctx = {
+    .cols     = cols,
+    .col_cnt  = build_columns( cols, hdr, args->metrics_dump.filter ),
+    .ts_begin = args->metrics_dump.last_seconds>0.0 ? ts_end - (long)(args->metrics_dump.last_seconds*1e9) : LONG_MIN,
+    .ts_prev  = 0L,
+    .gap_ns   = 4L*hdr->interval_ns,
+    .summary  = args->metrics_dump.summary,
+    .row_cnt  = 0UL,
+  };
+  if( FD_UNLIKELY( !ctx.col_cnt ) ) FD_LOG_ERR(( "no metrics match filter `%s`", args->metrics_dump.filter ));
+
+  if( FD_LIKELY( !ctx.summary ) ) {
+    printf( "timestamp_nanos" );
+    for( ulong i=0UL; i<ctx.col_cnt; i++ ) printf( ",%s", cols[ i ].name );
+    printf( "\n" );
+  }
+
+  for( ulong i=0UL; i<valid_cnt; i++ ) {
+    if( FD_LIKELY( blocks[ i ]->ts_last<ctx.ts_begin ) ) continue;
+    if( FD_UNLIKELY( fd_metrics_rec_block_decode( blocks[ i ], hdr->block_sz, hdr->value_cnt, values, on_sample, &ctx ) ) )
+      FD_LOG_WARNING(( "block %lu of `%s` is corrupt, skipping rest of block", blocks[ i ]->seq, path ));
+  }
+
+  if( FD_LIKELY( ctx.summary ) ) {
+    printf( "%-64s %-7s %10s %20s %20s %20s %20s %20s %10s\n", "metric", "type", "samples", "min", "mean", "max", "min_rate/s", "max_rate/s", "stalls" );
+    for( ulong i=0UL; i<ctx.col_cnt; i++ ) {
+      column_t const * c = &cols[ i ];
+      if( FD_UNLIKELY( !c->sample_cnt ) ) continue;
+      printf( "%-64s %-7s %10lu %20lu %20.1f %20lu", c->name, c->is_counter ? "counter" : "gauge", c->sample_cnt, c->min, c->sum/(double)c->sample_cnt, c->max );
+      if( FD_LIKELY( c->is_counter && c->rate_max>=0.0 && c->rate_min<=c->rate_max ) ) printf( " %20.1f %20.1f %10lu\n", c->rate_min, c->rate_max, c->stall_cnt );
+      else                                                                             printf( " %20s %20s %10s\n", "-", "-", "-" );
+    }
+  }
+
+  FD_LOG_NOTICE(( "read %lu samples from %lu blocks of `%s`, sampled every %ld ns", ctx.row_cnt, valid_cnt, path, hdr->interval_ns ));
+
+  free( cols );
+  free( values );
+  free( blocks );
+  if( FD_UNLIKELY( -1==munmap( (void *)file, file_sz ) ) ) FD_LOG_ERR(( "munmap(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+}
+
+action_t fd_action_metrics_dump = {
+  .name          = "metrics-dump",
+  .args          = metrics_dump_cmd_args,
+  .fn            = metrics_dump_cmd_fn,
+  .perm          = NULL,
+  .description   = "Print a high frequency metrics recording as CSV or a summary",
+  .is_diagnostic = 1
+};
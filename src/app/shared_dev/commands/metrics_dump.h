@@ -0,0 +1,8 @@
+#ifndef HEADER_fd_src_app_shared_dev_commands_metrics_dump_h
+#define HEADER_fd_src_app_shared_dev_commands_metrics_dump_h
+
+#include "../../shared/fd_config.h"
+
+extern action_t fd_action_metrics_dump;
+
+#endif /* HEADER_fd_src_app_shared_dev_commands_metrics_dump_h */
@@ -48,6 +48,23 @@ fd_ed25519_point_frombytes( fd_ed25519_point_t * r,
   return r;
 }
 
+int
+fd_ed25519_point_validate_2x( uchar const buf1[ 32 ],
+                              uchar const buf2[ 32 ] ) {
+  fd_f25519_t y[2], u[2], v[2], x[2];
+  fd_f25519_frombytes( &y[0], buf1 );
+  fd_f25519_frombytes( &y[1], buf2 );
+
+  fd_f25519_sqr2( &u[0], &y[0],              &u[1], &y[1]              );
+  fd_f25519_mul2( &v[0], &u[0], fd_f25519_d, &v[1], &u[1], fd_f25519_d );
+  for( int i=0; i<2; i++ ) {
+    fd_f25519_sub( &u[i], &u[i], fd_f25519_one ); /* u = y^2-1 */
+    fd_f25519_add( &v[i], &v[i], fd_f25519_one ); /* v = dy^2+1 */
+  }
+
+  return fd_f25519_sqrt_ratio2( &x[0], &u[0], &v[0], &x[1], &u[1], &v[1] );
+}
+
 uchar *
 fd_ed25519_point_tobytes( uchar                      out[ 32 ],
                           fd_ed25519_point_t const * a ) {
@@ -206,6 +206,17 @@ fd_ed25519_point_validate(uchar const buf[ 32 ] ) {
   return !!fd_ed25519_point_frombytes( t, buf );
 }
 
+/* fd_ed25519_point_validate_2x is fd_ed25519_point_validate on 2x
+   32-byte buffers buf1, buf2, with both square roots computed
+   concurrently.  Unlike fd_ed25519_point_frombytes_2x, it accepts
+   exactly the same encodings as fd_ed25519_point_frombytes.
+   It returns a bit field: bit 0 is set if buf1 represents a valid
+   point, bit 1 is set if buf2 does.
+   Cost: 2sqrt (executed concurrently if possible) */
+int
+fd_ed25519_point_validate_2x( uchar const buf1[ 32 ],
+                              uchar const buf2[ 32 ] );
+
 /* fd_ed25519_point_tobytes serializes a point a into
    a 32-byte buffer out, and returns out.
    out is in little endian form, according to RFC 8032. */
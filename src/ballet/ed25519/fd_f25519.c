@@ -58,6 +58,58 @@ fd_f25519_pow22523( fd_f25519_t *       r,
   return r;
 }
 
+/* fd_f25519_pow22523_2 computes r1 = a1^(2^252-3) and r2 = a2^(2^252-3)
+   with the same addition chain as fd_f25519_pow22523, and returns r1. */
+fd_f25519_t *
+fd_f25519_pow22523_2( fd_f25519_t * r1, fd_f25519_t const * a1,
+                      fd_f25519_t * r2, fd_f25519_t const * a2 ) {
+  fd_f25519_t t0[2];
+  fd_f25519_t t1[2];
+  fd_f25519_t t2[2];
+
+  fd_f25519_sqr2( &t0[0], a1,     &t0[1], a2     );
+  fd_f25519_sqr2( &t1[0], &t0[0], &t1[1], &t0[1] );
+  for( int i=1; i<  2; i++ ) fd_f25519_sqr2( &t1[0], &t1[0], &t1[1], &t1[1] );
+
+  fd_f25519_mul2( &t1[0], a1,     &t1[0], &t1[1], a2,     &t1[1] );
+  fd_f25519_mul2( &t0[0], &t0[0], &t1[0], &t0[1], &t0[1], &t1[1] );
+  fd_f25519_sqr2( &t0[0], &t0[0],         &t0[1], &t0[1]         );
+  fd_f25519_mul2( &t0[0], &t1[0], &t0[0], &t0[1], &t1[1], &t0[1] );
+  fd_f25519_sqr2( &t1[0], &t0[0],         &t1[1], &t0[1]         );
+  for( int i=1; i<  5; i++ ) fd_f25519_sqr2( &t1[0], &t1[0], &t1[1], &t1[1] );
+
+  fd_f25519_mul2( &t0[0], &t1[0], &t0[0], &t0[1], &t1[1], &t0[1] );
+  fd_f25519_sqr2( &t1[0], &t0[0],         &t1[1], &t0[1]         );
+  for( int i=1; i< 10; i++ ) fd_f25519_sqr2( &t1[0], &t1[0], &t1[1], &t1[1] );
+
+  fd_f25519_mul2( &t1[0], &t1[0], &t0[0], &t1[1], &t1[1], &t0[1] );
+  fd_f25519_sqr2( &t2[0], &t1[0],         &t2[1], &t1[1]         );
+  for( int i=1; i< 20; i++ ) fd_f25519_sqr2( &t2[0], &t2[0], &t2[1], &t2[1] );
+
+  fd_f25519_mul2( &t1[0], &t2[0], &t1[0], &t1[1], &t2[1], &t1[1] );
+  fd_f25519_sqr2( &t1[0], &t1[0],         &t1[1], &t1[1]         );
+  for( int i=1; i< 10; i++ ) fd_f25519_sqr2( &t1[0], &t1[0], &t1[1], &t1[1] );
+
+  fd_f25519_mul2( &t0[0], &t1[0], &t0[0], &t0[1], &t1[1], &t0[1] );
+  fd_f25519_sqr2( &t1[0], &t0[0],         &t1[1], &t0[1]         );
+  for( int i=1; i< 50; i++ ) fd_f25519_sqr2( &t1[0], &t1[0], &t1[1], &t1[1] );
+
+  fd_f25519_mul2( &t1[0], &t1[0], &t0[0], &t1[1], &t1[1], &t0[1] );
+  fd_f25519_sqr2( &t2[0], &t1[0],         &t2[1], &t1[1]         );
+  for( int i=1; i<100; i++ ) fd_f25519_sqr2( &t2[0], &t2[0], &t2[1], &t2[1] );
+
+  fd_f25519_mul2( &t1[0], &t2[0], &t1[0], &t1[1], &t2[1], &t1[1] );
+  fd_f25519_sqr2( &t1[0], &t1[0],         &t1[1], &t1[1]         );
+  for( int i=1; i< 50; i++ ) fd_f25519_sqr2( &t1[0], &t1[0], &t1[1], &t1[1] );
+
+  fd_f25519_mul2( &t0[0], &t1[0], &t0[0], &t0[1], &t1[1], &t0[1] );
+  fd_f25519_sqr2( &t0[0], &t0[0],         &t0[1], &t0[1]         );
+  for( int i=1; i<  2; i++ ) fd_f25519_sqr2( &t0[0], &t0[0], &t0[1], &t0[1] );
+
+  fd_f25519_mul2( r1, &t0[0], a1, r2, &t0[1], a2 );
+  return r1;
+}
+
 /* fd_f25519_inv computes r = 1/a, and returns r. */
 fd_f25519_t *
 fd_f25519_inv( fd_f25519_t *       r,
@@ -141,3 +193,45 @@ fd_f25519_sqrt_ratio( fd_f25519_t *       r,
   fd_f25519_abs( r, r );
   return correct_sign_sqrt|flipped_sign_sqrt;
 }
+
+/* fd_f25519_sqrt_ratio2 is fd_f25519_sqrt_ratio on (r1,u1,v1) and
+   (r2,u2,v2), computing both exponentiations concurrently.  Returns
+   the result of the 1st sqrt_ratio in bit 0 and of the 2nd in bit 1. */
+int
+fd_f25519_sqrt_ratio2( fd_f25519_t * r1, fd_f25519_t const * u1, fd_f25519_t const * v1,
+                       fd_f25519_t * r2, fd_f25519_t const * u2, fd_f25519_t const * v2 ) {
+  fd_f25519_t *       r[2] = { r1, r2 };
+  fd_f25519_t const * u[2] = { u1, u2 };
+
+  /* r = (u * v^3) * (u * v^7)^((p-5)/8) */
+  fd_f25519_t vv [2]; fd_f25519_sqr2( &vv [0], v1,               &vv [1], v2               );
+  fd_f25519_t v3 [2]; fd_f25519_mul2( &v3 [0], &vv[0], v1,       &v3 [1], &vv[1], v2       );
+  fd_f25519_t uv3[2]; fd_f25519_mul2( &uv3[0], u1,     &v3[0],   &uv3[1], u2,     &v3[1]   );
+  fd_f25519_t v6 [2]; fd_f25519_sqr2( &v6 [0], &v3[0],           &v6 [1], &v3[1]           );
+  fd_f25519_t v7 [2]; fd_f25519_mul2( &v7 [0], &v6[0], v1,       &v7 [1], &v6[1], v2       );
+  fd_f25519_t uv7[2]; fd_f25519_mul2( &uv7[0], u1,     &v7[0],   &uv7[1], u2,     &v7[1]   );
+  fd_f25519_pow22523_2( r1, &uv7[0], r2, &uv7[1] );
+  fd_f25519_mul2      ( r1, r1, &uv3[0], r2, r2, &uv3[1] );
+
+  /* check = v * r^2 */
+  fd_f25519_t check[2];
+  fd_f25519_sqr2( &check[0], r1,            &check[1], r2            );
+  fd_f25519_mul2( &check[0], &check[0], v1, &check[1], &check[1], v2 );
+
+  /* The remaining steps are cheap, see fd_f25519_sqrt_ratio */
+  int res = 0;
+  for( int i=0; i<2; i++ ) {
+    fd_f25519_t u_neg[1];        fd_f25519_neg( u_neg,        u[i] );
+    fd_f25519_t u_neg_sqrtm1[1]; fd_f25519_mul( u_neg_sqrtm1, u_neg, fd_f25519_sqrtm1 );
+    int correct_sign_sqrt   = fd_f25519_eq( &check[i], u[i] );
+    int flipped_sign_sqrt   = fd_f25519_eq( &check[i], u_neg );
+    int flipped_sign_sqrt_i = fd_f25519_eq( &check[i], u_neg_sqrtm1 );
+
+    fd_f25519_t r_prime[1];
+    fd_f25519_mul( r_prime, r[i], fd_f25519_sqrtm1 );
+    fd_f25519_if( r[i], flipped_sign_sqrt|flipped_sign_sqrt_i, r_prime, r[i] );
+    fd_f25519_abs( r[i], r[i] );
+    res |= (correct_sign_sqrt|flipped_sign_sqrt)<<i;
+  }
+  return res;
+}
@@ -241,13 +241,14 @@ fd_f25519_sqr4( fd_f25519_t * r1, fd_f25519_t const * a1,
                 fd_f25519_t * r3, fd_f25519_t const * a3,
                 fd_f25519_t * r4, fd_f25519_t const * a4 );
 
-/* fd_f25519_pow22523 computes r = a^(2^252-3), and returns r. */
+/* fd_f25519_pow22523_2 computes r_i = a_i^(2^252-3), and returns r1. */
 fd_f25519_t *
 fd_f25519_pow22523_2( fd_f25519_t * r1, fd_f25519_t const * a1,
                       fd_f25519_t * r2, fd_f25519_t const * a2 );
 
-/* fd_f25519_sqrt_ratio computes r = (u * v^3) * (u * v^7)^((p-5)/8),
-   returns 0 on success, 1 on failure. */
+/* fd_f25519_sqrt_ratio2 computes r_i = (u_i * v_i^3) * (u_i * v_i^7)^((p-5)/8),
+   like fd_f25519_sqrt_ratio.  Returns the result of the 1st sqrt_ratio
+   in bit 0 and the result of the 2nd in bit 1. */
 int
 fd_f25519_sqrt_ratio2( fd_f25519_t * r1, fd_f25519_t const * u1, fd_f25519_t const * v1,
                        fd_f25519_t * r2, fd_f25519_t const * u2, fd_f25519_t const * v2 );
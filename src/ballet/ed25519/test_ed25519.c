@@ -555,50 +555,76 @@ test_fe_pow22523( fd_rng_t * rng ) {
     log_bench( "fd_f25519_pow22523", iter, dt );
   }
 
-  /* during refactor, fd_f25519_pow22523_2 & fd_f25519_pow22523_4
-     were not implemented. leaving the tests in case we add them. */
-#if 0
   fd_f25519_t _fb[1]; fd_f25519_t * fb = _fb;
   fd_f25519_t _hb[1]; fd_f25519_t * hb = _hb;
-  fd_f25519_t _fc[1]; fd_f25519_t * fc = _fc;
-  fd_f25519_t _hc[1]; fd_f25519_t * hc = _hc;
-  fd_f25519_t _fd[1]; fd_f25519_t * fd = _fd;
-  fd_f25519_t _hd[1]; fd_f25519_t * hd = _hd;
   fd_f25519_t _ref_h[1]; fd_f25519_t * ref_h = _ref_h;
-  memset(ref_h, 0, sizeof(fd_f25519_t));
-  memset(h, 0, sizeof(fd_f25519_t));
-  memset(hb, 0, sizeof(fd_f25519_t));
-  memset(hc, 0, sizeof(fd_f25519_t));
-  memset(hd, 0, sizeof(fd_f25519_t));
   fd_f25519_rng_unsafe( fb, rng );
-  fd_f25519_rng_unsafe( fc, rng );
-  fd_f25519_rng_unsafe( fd, rng );
 
   fd_f25519_pow22523( ref_h, f );
-  fd_f25519_pow22523_2( h,f, hb,f );
-  FD_TEST( !memcmp( h,  ref_h, sizeof(fd_f25519_t) ) );
-  FD_TEST( !memcmp( hb, ref_h, sizeof(fd_f25519_t) ) );
+  FD_TEST( fd_f25519_pow22523_2( h,f, hb,f )==h );
+  FD_TEST( fd_f25519_eq( h,  ref_h ) );
+  FD_TEST( fd_f25519_eq( hb, ref_h ) );
 
-  fd_f25519_pow22523_4( h,f, hb,f, hc,f, hd,f );
-  FD_TEST( !memcmp( h,  ref_h, sizeof(fd_f25519_t) ) );
-  FD_TEST( !memcmp( hb, ref_h, sizeof(fd_f25519_t) ) );
-  FD_TEST( !memcmp( hc, ref_h, sizeof(fd_f25519_t) ) );
-  FD_TEST( !memcmp( hd, ref_h, sizeof(fd_f25519_t) ) );
+  fd_f25519_pow22523( ref_h, fb );
+  fd_f25519_pow22523_2( h,f, hb,fb );
+  FD_TEST( fd_f25519_eq( hb, ref_h ) );
 
+  /* With the ref backend, fd_f25519_pow22523_2 costs two
+     fd_f25519_pow22523; with avx512 it should cost much less */
   {
     long dt = fd_log_wallclock();
     for( ulong rem=iter; rem; rem-- ) { FD_COMPILER_FORGET( f ); FD_COMPILER_FORGET( h ); fd_f25519_pow22523_2( h,f, hb,fb ); }
     dt = fd_log_wallclock() - dt;
     log_bench( "fd_f25519_pow22523_2", iter, dt );
   }
+}
+
+void
+test_fe_sqrt_ratio2( fd_rng_t * rng ) {
+  fd_f25519_t u[2], v[2], r[2], ref_r[2];
+
+  /* Must match fd_f25519_sqrt_ratio on both halves, including zero
+     inputs and non-squares */
+
+  fd_f25519_t const * edge[] = { fd_f25519_zero, fd_f25519_one, fd_f25519_minus_one, fd_f25519_sqrtm1, fd_f25519_d };
+  ulong edge_cnt = sizeof(edge)/sizeof(edge[0]);
+  for( ulong i=0UL; i<edge_cnt*edge_cnt; i++ ) {
+    fd_f25519_set( &u[0], edge[ i%edge_cnt ] ); fd_f25519_set( &v[0], edge[ i/edge_cnt ] );
+    fd_f25519_set( &u[1], edge[ i/edge_cnt ] ); fd_f25519_set( &v[1], edge[ i%edge_cnt ] );
+    int expected = fd_f25519_sqrt_ratio( &ref_r[0], &u[0], &v[0] ) | (fd_f25519_sqrt_ratio( &ref_r[1], &u[1], &v[1] )<<1);
+    FD_TEST( fd_f25519_sqrt_ratio2( &r[0], &u[0], &v[0], &r[1], &u[1], &v[1] )==expected );
+    FD_TEST( fd_f25519_eq( &r[0], &ref_r[0] ) );
+    FD_TEST( fd_f25519_eq( &r[1], &ref_r[1] ) );
+  }
 
+  int seen = 0;
+  for( ulong iter=0UL; iter<1024UL; iter++ ) {
+    for( ulong j=0UL; j<2UL; j++ ) { fd_f25519_rng_unsafe( &u[j], rng ); fd_f25519_rng_unsafe( &v[j], rng ); }
+    int expected = fd_f25519_sqrt_ratio( &ref_r[0], &u[0], &v[0] ) | (fd_f25519_sqrt_ratio( &ref_r[1], &u[1], &v[1] )<<1);
+    FD_TEST( fd_f25519_sqrt_ratio2( &r[0], &u[0], &v[0], &r[1], &u[1], &v[1] )==expected );
+    FD_TEST( fd_f25519_eq( &r[0], &ref_r[0] ) );
+    FD_TEST( fd_f25519_eq( &r[1], &ref_r[1] ) );
+    seen |= 1<<expected;
+  }
+  FD_TEST( seen==0xf );
+
+  /* fd_ed25519_point_validate_2x relies on this being cheaper than two
+     fd_f25519_sqrt_ratio with the avx512 backend */
+  fd_f25519_t * pu = u;
+  fd_f25519_t * pv = v;
+  ulong iter = 100000UL;
   {
     long dt = fd_log_wallclock();
-    for( ulong rem=iter; rem; rem-- ) { FD_COMPILER_FORGET( f ); FD_COMPILER_FORGET( h ); fd_f25519_pow22523_4( h,f, hb,fb, hc,fc, hd,fd ); }
+    for( ulong rem=iter; rem; rem-- ) { FD_COMPILER_FORGET( pu ); FD_COMPILER_FORGET( pv ); int c = fd_f25519_sqrt_ratio( &r[0], &pu[0], &pv[0] ); FD_COMPILER_FORGET( c ); }
     dt = fd_log_wallclock() - dt;
-    log_bench( "fd_f25519_pow22523_4", iter, dt );
+    log_bench( "fd_f25519_sqrt_ratio", iter, dt );
+  }
+  {
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) { FD_COMPILER_FORGET( pu ); FD_COMPILER_FORGET( pv ); int c = fd_f25519_sqrt_ratio2( &r[0], &pu[0], &pv[0], &r[1], &pu[1], &pv[1] ); FD_COMPILER_FORGET( c ); }
+    dt = fd_log_wallclock() - dt;
+    log_bench( "fd_f25519_sqrt_ratio2", iter, dt );
   }
-#endif
 }
 
 void
@@ -711,6 +737,63 @@ test_point_validate( FD_PARAM_UNUSED fd_rng_t * rng ) {
 }
 
 
+static void
+test_point_validate_2x( fd_rng_t * rng ) {
+  static char const * vec[] = {
+    "0000000000000000000000000000000000000000000000000000000000000000",
+    "0000000000000000000000000000000000000000000000000000000000000080",
+    "0100000000000000000000000000000000000000000000000000000000000080",
+    "0200000000000000000000000000000000000000000000000000000000000000",
+    "edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+    "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+    "b898e00f6f6df758b3f9a05cbf73b15fd392a008a9a417d471c178c1b28c7447",
+    "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc05",
+  };
+  ulong vec_cnt = sizeof(vec)/sizeof(vec[0]);
+
+  /* Must match fd_ed25519_point_validate on every pair, including the
+     edge cases where fd_ed25519_point_frombytes_2x differs */
+
+  uchar buf[2][32];
+  for( ulong i=0UL; i<vec_cnt; i++ ) {
+    for( ulong j=0UL; j<vec_cnt; j++ ) {
+      fd_hex_decode( buf[0], vec[i], 32 );
+      fd_hex_decode( buf[1], vec[j], 32 );
+      int expected = fd_ed25519_point_validate( buf[0] ) | (fd_ed25519_point_validate( buf[1] )<<1);
+      FD_TEST( fd_ed25519_point_validate_2x( buf[0], buf[1] )==expected );
+    }
+  }
+
+  int seen = 0;
+  for( ulong iter=0UL; iter<1024UL; iter++ ) {
+    fd_rng_b256( rng, buf[0] );
+    fd_rng_b256( rng, buf[1] );
+    int expected = fd_ed25519_point_validate( buf[0] ) | (fd_ed25519_point_validate( buf[1] )<<1);
+    FD_TEST( fd_ed25519_point_validate_2x( buf[0], buf[1] )==expected );
+    seen |= 1<<expected;
+  }
+  FD_TEST( seen==0xf );
+
+  /* fd_vm_syscall_sol_try_find_program_address only pairs candidates
+     if one fd_ed25519_point_validate_2x is cheaper than two
+     fd_ed25519_point_validate */
+  uchar * b0 = buf[0];
+  uchar * b1 = buf[1];
+  ulong iter = 100000UL;
+  {
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) { FD_COMPILER_FORGET( b0 ); int r = fd_ed25519_point_validate( b0 ); FD_COMPILER_FORGET( r ); }
+    dt = fd_log_wallclock() - dt;
+    log_bench( "fd_ed25519_point_validate", iter, dt );
+  }
+  {
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) { FD_COMPILER_FORGET( b0 ); FD_COMPILER_FORGET( b1 ); int r = fd_ed25519_point_validate_2x( b0, b1 ); FD_COMPILER_FORGET( r ); }
+    dt = fd_log_wallclock() - dt;
+    log_bench( "fd_ed25519_point_validate_2x", iter, dt );
+  }
+}
+
 /**********************************************************************/
 
 void
@@ -1163,11 +1246,13 @@ main( int     argc,
   test_fe_if        ( rng );
   test_fe_isnonzero ( rng );
   test_fe_pow22523  ( rng );
+  test_fe_sqrt_ratio2( rng );
 
   test_affine_frombytes      ( rng );
   test_affine_is_small_order ( rng );
 
   test_point_validate( rng );
+  test_point_validate_2x( rng );
 
   test_sc_validate  ( rng );
   test_sc_reduce    ( rng );
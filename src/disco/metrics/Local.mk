@@ -1,5 +1,7 @@
 ifdef FD_HAS_ALLOCA
-$(call add-hdrs,fd_prometheus.h fd_metrics.h)
-$(call add-objs,fd_prometheus fd_metrics ,fd_disco)
+$(call add-hdrs,fd_prometheus.h fd_metrics.h fd_metrics_rec.h)
+$(call add-objs,fd_prometheus fd_metrics fd_metrics_rec,fd_disco)
 $(call add-objs,fd_metric_tile,fd_disco)
+$(call make-unit-test,test_metrics_rec,test_metrics_rec,fd_disco fd_tango fd_util)
+$(call run-unit-test,test_metrics_rec)
 endif
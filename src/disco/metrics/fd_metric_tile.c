@@ -1,10 +1,13 @@
 #include "fd_prometheus.h"
 #include "fd_metrics.h"
+#include "fd_metrics_rec.h"
 #include "../../waltz/http/fd_http_server.h"
 #include "../../util/net/fd_ip4.h"
 
 #include <sys/types.h>
 #include <sys/socket.h> /* SOCK_CLOEXEC, SOCK_NONBLOCK needed for seccomp filter */
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <string.h>
 
@@ -18,6 +21,10 @@
 #define FD_HTTP_SERVER_METRICS_MAX_REQUEST_LEN    8192
 #define FD_HTTP_SERVER_METRICS_OUTGOING_BUFFER_SZ (32UL<<20UL) /* 32MiB reserved for buffering metrics responses */
 
+/* How often the partially filled block of the recorder is written out,
+   so that a crash loses at most this much of the recording. */
+#define FD_METRIC_RECORDER_FLUSH_INTERVAL_NS (1000L*1000L*1000L)
+
 const fd_http_server_params_t METRICS_PARAMS = {
   .max_connection_cnt    = FD_HTTP_SERVER_METRICS_MAX_CONNS,
   .max_ws_connection_cnt = 0UL,
@@ -32,6 +39,12 @@ typedef struct {
 
   fd_http_server_t * metrics_server;
 
+  int                recorder_fd;
+  fd_metrics_rec_t * recorder;
+  long               recorder_interval_ns;
+  long               recorder_next;
+  long               recorder_flush_next;
+
   long boot_ts;
 } fd_metric_ctx_t;
 
@@ -42,11 +55,12 @@ scratch_align( void ) {
 
 FD_FN_PURE static inline ulong
 scratch_footprint( fd_topo_tile_t const * tile ) {
-  (void)tile;
-
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_metric_ctx_t ), sizeof( fd_metric_ctx_t ) );
   l = FD_LAYOUT_APPEND( l, fd_http_server_align(), fd_http_server_footprint( METRICS_PARAMS ) );
+  if( FD_UNLIKELY( tile->metric.recorder_path[ 0 ] ) ) {
+    l = FD_LAYOUT_APPEND( l, fd_metrics_rec_align(), fd_metrics_rec_footprint() );
+  }
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -56,6 +70,22 @@ before_credit( fd_metric_ctx_t *   ctx,
                int *               charge_busy ) {
   (void)stem;
   *charge_busy = fd_http_server_poll( ctx->metrics_server, 1 ); /* 1ms */
+
+  if( FD_LIKELY( !ctx->recorder ) ) return;
+
+  long now = fd_log_wallclock();
+  if( FD_UNLIKELY( now>=ctx->recorder_next ) ) {
+    fd_metrics_rec_sample( ctx->recorder, ctx->topo, now );
+    /* If we fell behind by more than an interval (eg, the HTTP server
+       was busy), skip the missed samples rather than bunching them. */
+    ctx->recorder_next = fd_long_max( ctx->recorder_next+ctx->recorder_interval_ns, now );
+    *charge_busy = 1;
+  }
+  if( FD_UNLIKELY( now>=ctx->recorder_flush_next ) ) {
+    fd_metrics_rec_flush( ctx->recorder );
+    ctx->recorder_flush_next = now + FD_METRIC_RECORDER_FLUSH_INTERVAL_NS;
+    *charge_busy = 1;
+  }
 }
 
 static fd_http_server_response_t
@@ -109,6 +139,12 @@ privileged_init( fd_topo_t *      topo,
   };
   ctx->metrics_server = fd_http_server_join( fd_http_server_new( _metrics, METRICS_PARAMS, metrics_callbacks, ctx ) );
   fd_http_server_listen( ctx->metrics_server, tile->metric.prometheus_listen_addr, tile->metric.prometheus_listen_port );
+
+  ctx->recorder_fd = -1;
+  if( FD_UNLIKELY( tile->metric.recorder_path[ 0 ] ) ) {
+    ctx->recorder_fd = open( tile->metric.recorder_path, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0644 );
+    if( FD_UNLIKELY( -1==ctx->recorder_fd ) ) FD_LOG_ERR(( "open(%s) failed (%i-%s)", tile->metric.recorder_path, errno, fd_io_strerror( errno ) ));
+  }
 }
 
 static void
@@ -119,9 +155,22 @@ unprivileged_init( fd_topo_t *      topo,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_metric_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_metric_ctx_t ), sizeof( fd_metric_ctx_t ) );
 
+  FD_SCRATCH_ALLOC_APPEND( l, fd_http_server_align(), fd_http_server_footprint( METRICS_PARAMS ) );
+
   ctx->topo = topo;
   ctx->boot_ts = fd_log_wallclock();
 
+  ctx->recorder = NULL;
+  if( FD_UNLIKELY( tile->metric.recorder_path[ 0 ] ) ) {
+    void * _recorder = FD_SCRATCH_ALLOC_APPEND( l, fd_metrics_rec_align(), fd_metrics_rec_footprint() );
+    ctx->recorder = fd_metrics_rec_join( fd_metrics_rec_new( _recorder, ctx->recorder_fd, topo, tile->metric.recorder_interval_ns, tile->metric.recorder_file_sz ) );
+    if( FD_UNLIKELY( !ctx->recorder ) ) FD_LOG_ERR(( "failed to create metrics recorder" ));
+    ctx->recorder_interval_ns = tile->metric.recorder_interval_ns;
+    ctx->recorder_next        = ctx->boot_ts;
+    ctx->recorder_flush_next  = ctx->boot_ts + FD_METRIC_RECORDER_FLUSH_INTERVAL_NS;
+    FD_LOG_NOTICE(( "recording metrics every %ld ns to `%s`", ctx->recorder_interval_ns, tile->metric.recorder_path ));
+  }
+
   ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, 1UL );
   if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) )
     FD_LOG_ERR(( "scratch overflow %lu %lu %lu", scratch_top - (ulong)scratch - scratch_footprint( tile ), scratch_top, (ulong)scratch + scratch_footprint( tile ) ));
@@ -138,7 +187,7 @@ populate_allowed_seccomp( fd_topo_t const *      topo,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_metric_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_metric_ctx_t ), sizeof( fd_metric_ctx_t ) );
 
-  populate_sock_filter_policy_fd_metric_tile( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)fd_http_server_fd( ctx->metrics_server ) );
+  populate_sock_filter_policy_fd_metric_tile( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)fd_http_server_fd( ctx->metrics_server ), (uint)ctx->recorder_fd );
   return sock_filter_policy_fd_metric_tile_instr_cnt;
 }
 
@@ -151,13 +200,15 @@ populate_allowed_fds( fd_topo_t const *      topo,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_metric_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_metric_ctx_t ), sizeof( fd_metric_ctx_t ) );
 
-  if( FD_UNLIKELY( out_fds_cnt<3UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
+  if( FD_UNLIKELY( out_fds_cnt<4UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
 
   ulong out_cnt = 0;
   out_fds[ out_cnt++ ] = 2; /* stderr */
   if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
     out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
   out_fds[ out_cnt++ ] = fd_http_server_fd( ctx->metrics_server ); /* metrics listen socket */
+  if( FD_UNLIKELY( -1!=ctx->recorder_fd ) )
+    out_fds[ out_cnt++ ] = ctx->recorder_fd; /* metrics recording */
   return out_cnt;
 }
 
@@ -174,7 +225,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 
 fd_topo_run_tile_t fd_tile_metric = {
   .name                     = "metric",
-  .rlimit_file_cnt          = FD_HTTP_SERVER_METRICS_MAX_CONNS+5UL, /* pipefd, socket, stderr, logfile, and one spare for new accept() connections */
+  .rlimit_file_cnt          = FD_HTTP_SERVER_METRICS_MAX_CONNS+6UL, /* pipefd, socket, stderr, logfile, recording, and one spare for new accept() connections */
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
@@ -0,0 +1,302 @@
+#include "fd_metrics_rec.h"
+#include "fd_metrics.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+FD_FN_CONST ulong
+fd_metrics_rec_align( void ) {
+  return FD_METRICS_REC_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_metrics_rec_footprint( void ) {
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_METRICS_REC_ALIGN, sizeof(fd_metrics_rec_t)                );
+  l = FD_LAYOUT_APPEND( l, FD_METRICS_REC_ALIGN, FD_METRICS_REC_HDR_SZ                   );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),       FD_METRICS_REC_VALUE_MAX*sizeof(ulong)  );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),       FD_METRICS_REC_VALUE_MAX*sizeof(ulong)  );
+  l = FD_LAYOUT_APPEND( l, FD_METRICS_REC_ALIGN, FD_METRICS_REC_BLOCK_SZ                 );
+  return FD_LAYOUT_FINI( l, FD_METRICS_REC_ALIGN );
+}
+
+static inline ulong
+tile_value_cnt( ulong const * metrics ) {
+  if( FD_UNLIKELY( !metrics ) ) return 0UL;
+  return 2UL + FD_METRICS_ALL_LINK_IN_TOTAL*metrics[ 0 ] + FD_METRICS_ALL_LINK_OUT_TOTAL*metrics[ 1 ] + FD_METRICS_TOTAL_SZ/sizeof(ulong);
+}
+
+static int
+write_at( fd_metrics_rec_t * rec,
+          void const *       buf,
+          ulong              sz,
+          ulong              off ) {
+  uchar const * p = (uchar const *)buf;
+  while( sz ) {
+    long res = pwrite( rec->fd, p, sz, (long)off );
+    if( FD_UNLIKELY( res<0L ) ) {
+      if( FD_LIKELY( errno==EINTR ) ) continue;
+      rec->metrics.write_err_cnt++;
+      FD_LOG_WARNING(( "pwrite to metrics recording failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+      return -1;
+    }
+    p   += (ulong)res;
+    off += (ulong)res;
+    sz  -= (ulong)res;
+  }
+  return 0;
+}
+
+static void
+block_reset( fd_metrics_rec_t * rec ) {
+  fd_metrics_rec_block_t * block = (fd_metrics_rec_block_t *)rec->block;
+  block->magic      = FD_METRICS_REC_MAGIC;
+  block->seq        = rec->block_seq;
+  block->sample_cnt = 0UL;
+  block->data_sz    = 0UL;
+  block->ts_first   = 0L;
+  block->ts_last    = 0L;
+  fd_memset( rec->prev, 0, rec->value_cnt*sizeof(ulong) );
+}
+
+void *
+fd_metrics_rec_new( void *            shmem,
+                    int               fd,
+                    fd_topo_t const * topo,
+                    long              interval_ns,
+                    ulong             file_sz ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_metrics_rec_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( topo->tile_cnt>FD_TOPO_MAX_TILES ) ) {
+    FD_LOG_WARNING(( "too many tiles %lu", topo->tile_cnt ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( interval_ns<=0L ) ) {
+    FD_LOG_WARNING(( "invalid interval %ld", interval_ns ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_metrics_rec_t *     rec   = FD_SCRATCH_ALLOC_APPEND( l, FD_METRICS_REC_ALIGN, sizeof(fd_metrics_rec_t)               );
+  fd_metrics_rec_hdr_t * hdr   = FD_SCRATCH_ALLOC_APPEND( l, FD_METRICS_REC_ALIGN, FD_METRICS_REC_HDR_SZ                  );
+  ulong *                prev  = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),       FD_METRICS_REC_VALUE_MAX*sizeof(ulong) );
+  ulong *                cur   = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),       FD_METRICS_REC_VALUE_MAX*sizeof(ulong) );
+  uchar *                block = FD_SCRATCH_ALLOC_APPEND( l, FD_METRICS_REC_ALIGN, FD_METRICS_REC_BLOCK_SZ                );
+  FD_SCRATCH_ALLOC_FINI( l, FD_METRICS_REC_ALIGN );
+
+  fd_memset( hdr, 0, FD_METRICS_REC_HDR_SZ );
+
+  ulong value_cnt = 0UL;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t const * tile = &topo->tiles[ i ];
+    fd_metrics_rec_tile_t * desc = &hdr->tile[ i ];
+    fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( desc->name ), tile->name, sizeof(desc->name)-1UL ) );
+    desc->kind_id   = tile->kind_id;
+    desc->in_cnt    = tile->metrics ? tile->metrics[ 0 ] : 0UL;
+    desc->out_cnt   = tile->metrics ? tile->metrics[ 1 ] : 0UL;
+    desc->value_off = value_cnt;
+    value_cnt += tile_value_cnt( tile->metrics );
+  }
+
+  if( FD_UNLIKELY( value_cnt>FD_METRICS_REC_VALUE_MAX ) ) {
+    FD_LOG_WARNING(( "topology has too many metrics to record (%lu, max %lu)", value_cnt, FD_METRICS_REC_VALUE_MAX ));
+    return NULL;
+  }
+
+  ulong block_cnt = fd_ulong_max( 1UL, fd_ulong_sat_sub( file_sz, FD_METRICS_REC_HDR_SZ ) / FD_METRICS_REC_BLOCK_SZ );
+
+  hdr->magic       = FD_METRICS_REC_MAGIC;
+  hdr->version     = FD_METRICS_REC_VERSION;
+  hdr->block_sz    = FD_METRICS_REC_BLOCK_SZ;
+  hdr->block_cnt   = block_cnt;
+  hdr->interval_ns = interval_ns;
+  hdr->tick_per_ns = fd_tempo_tick_per_ns( NULL );
+  hdr->value_cnt   = value_cnt;
+  hdr->tile_cnt    = topo->tile_cnt;
+
+  fd_memset( rec, 0, sizeof(fd_metrics_rec_t) );
+  rec->fd        = fd;
+  rec->block_cnt = block_cnt;
+  rec->value_cnt = value_cnt;
+  rec->block_seq = 0UL;
+  rec->ts_prev   = 0L;
+  rec->prev      = prev;
+  rec->cur       = cur;
+  rec->block     = block;
+  rec->hdr       = hdr;
+
+  if( FD_UNLIKELY( write_at( rec, hdr, FD_METRICS_REC_HDR_SZ, 0UL ) ) ) return NULL;
+
+  block_reset( rec );
+
+  return shmem;
+}
+
+fd_metrics_rec_t *
+fd_metrics_rec_join( void * shrec ) {
+  return (fd_metrics_rec_t *)shrec;
+}
+
+void *
+fd_metrics_rec_leave( fd_metrics_rec_t * rec ) {
+  return (void *)rec;
+}
+
+void *
+fd_metrics_rec_delete( void * shrec ) {
+  return shrec;
+}
+
+void
+fd_metrics_rec_flush( fd_metrics_rec_t * rec ) {
+  fd_metrics_rec_block_t const * block = (fd_metrics_rec_block_t const *)rec->block;
+  if( FD_UNLIKELY( !block->sample_cnt ) ) return;
+
+  ulong off = FD_METRICS_REC_HDR_SZ + (rec->block_seq % rec->block_cnt)*FD_METRICS_REC_BLOCK_SZ;
+  write_at( rec, rec->block, sizeof(fd_metrics_rec_block_t)+block->data_sz, off );
+}
+
+static uchar *
+encode_sample( uchar *       p,
+               ulong const * prev,
+               ulong const * cur,
+               ulong         cnt ) {
+  ulong run = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    ulong delta = cur[ i ] - prev[ i ];
+    if( FD_LIKELY( !delta ) ) {
+      run++;
+      continue;
+    }
+
+    if( FD_UNLIKELY( run ) ) {
+      p = fd_ulong_svw_enc( p, (run<<1) | 1UL );
+      run = 0UL;
+    }
+
+    ulong zz = fd_long_zz_enc( (long)delta );
+    if( FD_LIKELY( !(zz>>63) ) ) {
+      p = fd_ulong_svw_enc( p, zz<<1 );
+    } else {
+      p = fd_ulong_svw_enc( p, 1UL );
+      p = fd_ulong_svw_enc( p, cur[ i ] );
+    }
+  }
+  if( FD_UNLIKELY( run ) ) p = fd_ulong_svw_enc( p, (run<<1) | 1UL );
+  return p;
+}
+
+void
+fd_metrics_rec_append( fd_metrics_rec_t * rec,
+                       long               ts,
+                       ulong const *      values ) {
+  fd_metrics_rec_block_t * block = (fd_metrics_rec_block_t *)rec->block;
+
+  /* Seal the block if the worst case sample might not fit in it.  We
+     only know the real encoded size after encoding, so be
+     conservative. */
+
+  ulong sample_max = FD_ULONG_SVW_ENC_MAX + rec->value_cnt*(1UL+FD_ULONG_SVW_ENC_MAX);
+  if( FD_UNLIKELY( sizeof(fd_metrics_rec_block_t)+block->data_sz+sample_max>FD_METRICS_REC_BLOCK_SZ ) ) {
+    fd_metrics_rec_flush( rec );
+    rec->metrics.block_cnt++;
+    rec->block_seq++;
+    block_reset( rec );
+  }
+
+  if( FD_UNLIKELY( !block->sample_cnt ) ) {
+    block->ts_first = ts;
+    rec->ts_prev    = ts;
+  }
+
+  uchar * p0 = rec->block + sizeof(fd_metrics_rec_block_t) + block->data_sz;
+  uchar * p  = fd_ulong_svw_enc( p0, (ulong)(ts - rec->ts_prev) );
+  p = encode_sample( p, rec->prev, values, rec->value_cnt );
+
+  block->data_sz += (ulong)(p - p0);
+  block->sample_cnt++;
+  block->ts_last = ts;
+  rec->ts_prev   = ts;
+  if( FD_LIKELY( values!=rec->prev ) ) fd_memcpy( rec->prev, values, rec->value_cnt*sizeof(ulong) );
+
+  rec->metrics.sample_cnt++;
+}
+
+void
+fd_metrics_rec_sample( fd_metrics_rec_t * rec,
+                       fd_topo_t const *  topo,
+                       long               ts ) {
+  ulong * cur = rec->cur;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    ulong const * metrics = topo->tiles[ i ].metrics;
+    ulong cnt = tile_value_cnt( metrics );
+    /* The producer updates each metric with a single atomic store, so
+       reading them one ulong at a time gives a consistent value for
+       each, like the Prometheus renderer.  Don't memcpy. */
+    for( ulong j=0UL; j<cnt; j++ ) cur[ j ] = FD_VOLATILE_CONST( metrics[ j ] );
+    cur += cnt;
+  }
+  fd_metrics_rec_append( rec, ts, rec->cur );
+}
+
+int
+fd_metrics_rec_block_decode( fd_metrics_rec_block_t const * block,
+                             ulong                          block_sz,
+                             ulong                          value_cnt,
+                             ulong *                        values,
+                             fd_metrics_rec_sample_fn_t     fn,
+                             void *                         ctx ) {
+  if( FD_UNLIKELY( block_sz<sizeof(fd_metrics_rec_block_t) ) ) return -1;
+  if( FD_UNLIKELY( block->magic!=FD_METRICS_REC_MAGIC ) ) return -1;
+  if( FD_UNLIKELY( block->data_sz>block_sz-sizeof(fd_metrics_rec_block_t) ) ) return -1;
+
+  uchar const * p   = (uchar const *)(block+1);
+  uchar const * end = p + block->data_sz;
+
+  /* Every token is followed by at least one more byte or ends the
+     block, but a corrupt block can end in the middle of a token, so
+     check the worst case token size against the end before each
+     decode. */
+
+# define DECODE( x ) do {                                                   \
+    if( FD_UNLIKELY( p>=end || p+fd_ulong_svw_dec_sz( p )>end ) ) return -1; \
+    p = fd_ulong_svw_dec( p, (x) );                                         \
+  } while(0)
+
+  fd_memset( values, 0, value_cnt*sizeof(ulong) );
+  long ts = block->ts_first;
+  for( ulong s=0UL; s<block->sample_cnt; s++ ) {
+    ulong dt; DECODE( &dt );
+    ts += (long)dt;
+
+    ulong i = 0UL;
+    while( i<value_cnt ) {
+      ulong tok; DECODE( &tok );
+      if( FD_LIKELY( !(tok & 1UL) ) ) {
+        values[ i++ ] += (ulong)fd_long_zz_dec( tok>>1 );
+      } else if( FD_LIKELY( tok>>1 ) ) {
+        ulong run = tok>>1;
+        if( FD_UNLIKELY( run>value_cnt-i ) ) return -1;
+        i += run;
+      } else {
+        DECODE( values+i );
+        i++;
+      }
+    }
+
+    fn( ctx, ts, values );
+  }
+
+# undef DECODE
+
+  return p==end ? 0 : -1;
+}
@@ -0,0 +1,226 @@
+#ifndef HEADER_fd_src_disco_metrics_fd_metrics_rec_h
+#define HEADER_fd_src_disco_metrics_fd_metrics_rec_h
+
+/* fd_metrics_rec is a high frequency recorder for the metrics shared
+   memory regions of every tile in a topology.  Prometheus scrapes only
+   see averages over the scrape interval (typically 10-15 seconds),
+   which hides sub-second stalls.  The recorder instead snapshots every
+   metric of every tile at a fixed interval (down to a few
+   milliseconds) and writes the samples, delta compressed, to a bounded
+   ring file on disk.
+
+   The recorder only reads the metric regions, the same way the
+   Prometheus renderer does, so it does not add any work to the tiles
+   being recorded.  It is run from the metric tile.
+
+   The file is laid out as
+
+    [ header (FD_METRICS_REC_HDR_SZ) ]
+    [ block 0 ][ block 1 ] ... [ block block_cnt-1 ]
+
+   where each block is FD_METRICS_REC_BLOCK_SZ bytes and starts with a
+   fd_metrics_rec_block_t.  Blocks are written round-robin, so once the
+   file is full, the oldest block is overwritten.  Each block is self
+   contained: the first sample in a block is encoded relative to all
+   zeros and every subsequent sample relative to the previous one, so
+   a reader can decode any block without looking at the others.  Blocks
+   are ordered by their seq number.
+
+   A sample is encoded as the svw encoded nanosecond delta between its
+   timestamp and the timestamp of the previous sample in the block
+   (zero for the first sample), followed by a stream of svw encoded
+   tokens covering all value_cnt values in order,
+
+     (zz(delta)<<1) | 0  ... one value, changed by delta
+     (run<<1)       | 1  ... run values, all unchanged (run>0)
+     1, svw(value)       ... one value, given literally (used when the
+                             delta does not fit in 63 bits)
+
+   where zz is the zig-zag encoding of the signed difference.  Most
+   metrics change slowly or not at all between samples, so a sample
+   typically costs one byte per changed metric plus a few bytes per run
+   of unchanged ones. */
+
+#include "fd_metrics_base.h"
+#include "../topo/fd_topo.h"
+
+#define FD_METRICS_REC_MAGIC     (0xf17eda2c3ec0ddedUL)
+#define FD_METRICS_REC_VERSION   (1UL)
+
+#define FD_METRICS_REC_ALIGN     (4096UL)
+#define FD_METRICS_REC_HDR_SZ    (16384UL)
+#define FD_METRICS_REC_BLOCK_SZ  (2UL<<20)   /* 2 MiB */
+
+/* FD_METRICS_REC_VALUE_MAX is the maximum number of metric values
+   (summed over all tiles, including link metrics) that can be
+   recorded in one sample.  It bounds the size of an encoded sample so
+   that at least one always fits in a block. */
+
+#define FD_METRICS_REC_VALUE_MAX (1UL<<17)
+
+/* FD_METRICS_REC_SAMPLE_MAX is the worst case encoded size of a single
+   sample. */
+
+#define FD_METRICS_REC_SAMPLE_MAX (FD_ULONG_SVW_ENC_MAX + FD_METRICS_REC_VALUE_MAX*(1UL+FD_ULONG_SVW_ENC_MAX))
+
+/* fd_metrics_rec_tile_t describes where the metrics of one tile are in
+   a sample.  The values of the tile are its entire metrics region, as
+   described in fd_metrics.h, that is
+
+     [ in_cnt ][ out_cnt ][ in link metrics ][ out link metrics ][ tile metrics ]
+
+   starting at value_off. */
+
+struct fd_metrics_rec_tile {
+  char  name[ 8UL ];
+  ulong kind_id;
+  ulong in_cnt;    /* Number of in links with metrics */
+  ulong out_cnt;   /* Number of reliable out link consumers with metrics */
+  ulong value_off; /* Index of the first value of this tile in a sample */
+};
+
+typedef struct fd_metrics_rec_tile fd_metrics_rec_tile_t;
+
+struct fd_metrics_rec_hdr {
+  ulong  magic;       /* ==FD_METRICS_REC_MAGIC */
+  ulong  version;     /* ==FD_METRICS_REC_VERSION */
+  ulong  block_sz;    /* ==FD_METRICS_REC_BLOCK_SZ */
+  ulong  block_cnt;   /* Number of blocks in the ring */
+  long   interval_ns; /* Configured sampling interval */
+  double tick_per_ns; /* Tick rate of the recording host, for converting tick valued metrics */
+  ulong  value_cnt;   /* Number of values in each sample */
+  ulong  tile_cnt;
+  fd_metrics_rec_tile_t tile[ FD_TOPO_MAX_TILES ];
+};
+
+typedef struct fd_metrics_rec_hdr fd_metrics_rec_hdr_t;
+
+FD_STATIC_ASSERT( sizeof(fd_metrics_rec_hdr_t)<=FD_METRICS_REC_HDR_SZ, metrics_rec );
+
+struct fd_metrics_rec_block {
+  ulong magic;      /* ==FD_METRICS_REC_MAGIC */
+  ulong seq;        /* Sequence number of this block, increasing by one for each block written */
+  ulong sample_cnt; /* Number of samples encoded in the block */
+  ulong data_sz;    /* Number of encoded bytes following this header */
+  long  ts_first;   /* Wallclock of the first sample in the block */
+  long  ts_last;    /* Wallclock of the last sample in the block */
+};
+
+typedef struct fd_metrics_rec_block fd_metrics_rec_block_t;
+
+FD_STATIC_ASSERT( sizeof(fd_metrics_rec_block_t)+FD_METRICS_REC_SAMPLE_MAX<=FD_METRICS_REC_BLOCK_SZ, metrics_rec );
+
+/* fd_metrics_rec_t is the writer side of a recording.  It is a local
+   object owned by a single thread. */
+
+struct __attribute__((aligned(FD_METRICS_REC_ALIGN))) fd_metrics_rec_private {
+  int     fd;
+  ulong   block_cnt;
+  ulong   value_cnt;
+
+  ulong   block_seq; /* Sequence number of the block being filled */
+  long    ts_prev;   /* Timestamp of the last sample appended to the block */
+  ulong * prev;      /* Values of the last sample appended to the block, indexed [0,value_cnt) */
+  ulong * cur;       /* Scratch for gathering a sample, indexed [0,value_cnt) */
+  uchar * block;     /* Block being filled, FD_METRICS_REC_BLOCK_SZ bytes */
+
+  fd_metrics_rec_hdr_t const * hdr;
+
+  struct {
+    ulong sample_cnt;
+    ulong block_cnt;
+    ulong write_err_cnt;
+  } metrics;
+
+  /* hdr, prev, cur and block follow here */
+};
+
+typedef struct fd_metrics_rec_private fd_metrics_rec_t;
+
+/* fd_metrics_rec_sample_fn_t is the callback used when decoding a
+   block.  It is called once per sample in order, with the wallclock
+   timestamp of the sample and the decoded values, indexed
+   [0,value_cnt).  The values are only valid for the duration of the
+   call. */
+
+typedef void (* fd_metrics_rec_sample_fn_t)( void *        ctx,
+                                             long          ts,
+                                             ulong const * values );
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_metrics_rec_align( void );
+
+FD_FN_CONST ulong
+fd_metrics_rec_footprint( void );
+
+/* fd_metrics_rec_new formats a memory region as a recorder writing to
+   the file descriptor fd, which should be open for writing.  The file
+   will hold a ring of as many blocks as fit in file_sz bytes after the
+   header (at least one).  The layout of the samples is taken from the
+   tiles in topo, whose metrics must already be joined.  The file
+   header is written immediately.  Returns shmem on success, and NULL
+   on failure (logs details), for example if the topology has more
+   than FD_METRICS_REC_VALUE_MAX metric values, or the header could not
+   be written. */
+
+void *
+fd_metrics_rec_new( void *            shmem,
+                    int               fd,
+                    fd_topo_t const * topo,
+                    long              interval_ns,
+                    ulong             file_sz );
+
+fd_metrics_rec_t *
+fd_metrics_rec_join( void * shrec );
+
+void *
+fd_metrics_rec_leave( fd_metrics_rec_t * rec );
+
+void *
+fd_metrics_rec_delete( void * shrec );
+
+/* fd_metrics_rec_sample snapshots the metrics regions of every tile in
+   topo, which must be the same topology the recorder was created with,
+   and appends the sample with timestamp ts.  Samples are only
+   guaranteed to be durable once the block they are in is full, or
+   after fd_metrics_rec_flush. */
+
+void
+fd_metrics_rec_sample( fd_metrics_rec_t * rec,
+                       fd_topo_t const *  topo,
+                       long               ts );
+
+/* fd_metrics_rec_append appends an already gathered sample to the
+   recording.  values is indexed [0,value_cnt). */
+
+void
+fd_metrics_rec_append( fd_metrics_rec_t * rec,
+                       long               ts,
+                       ulong const *      values );
+
+/* fd_metrics_rec_flush writes the partially filled current block to the
+   file, so that it can be read back even if the writer dies. */
+
+void
+fd_metrics_rec_flush( fd_metrics_rec_t * rec );
+
+/* fd_metrics_rec_block_decode decodes all samples in a block read back
+   from a recording with value_cnt values per sample, calling fn for
+   each one.  block points to the first block_sz bytes of the block.
+   values is scratch space for value_cnt ulongs.  Returns 0 on success,
+   or -1 if the block is not valid or is corrupt, in which case fn may
+   have been called for some of the samples. */
+
+int
+fd_metrics_rec_block_decode( fd_metrics_rec_block_t const * block,
+                             ulong                          block_sz,
+                             ulong                          value_cnt,
+                             ulong *                        values,
+                             fd_metrics_rec_sample_fn_t     fn,
+                             void *                         ctx );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_disco_metrics_fd_metrics_rec_h */
@@ -58,6 +58,7 @@ const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT] = {
     "snaprd",
     "snapdc",
     "snapin",
+    "solcap",
 };
 
 const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT] = {
@@ -83,6 +84,7 @@ const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT] = {
     FD_METRICS_SNAPRD_TOTAL,
     FD_METRICS_SNAPDC_TOTAL,
     FD_METRICS_SNAPIN_TOTAL,
+    FD_METRICS_SOLCAP_TOTAL,
 };
 const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT] = {
     FD_METRICS_NET,
@@ -107,4 +109,5 @@ const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT]
     FD_METRICS_SNAPRD,
     FD_METRICS_SNAPDC,
     FD_METRICS_SNAPIN,
+    FD_METRICS_SOLCAP,
 };
@@ -23,6 +23,7 @@
 #include "fd_metrics_snaprd.h"
 #include "fd_metrics_snapdc.h"
 #include "fd_metrics_snapin.h"
+#include "fd_metrics_solcap.h"
 #include "fd_metrics_metric.h"
 /* Start of LINK OUT metrics */
 
@@ -160,7 +161,7 @@ extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_T
 
 #define FD_METRICS_TOTAL_SZ (8UL*253UL)
 
-#define FD_METRICS_TILE_KIND_CNT 22
+#define FD_METRICS_TILE_KIND_CNT 23
 extern const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT];
 extern const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT];
 extern const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT];
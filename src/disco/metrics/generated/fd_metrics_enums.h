@@ -197,6 +197,24 @@
 #define FD_METRICS_ENUM_RESOLVE_STASH_OPERATION_V_REMOVED_IDX  3
 #define FD_METRICS_ENUM_RESOLVE_STASH_OPERATION_V_REMOVED_NAME "removed"
 
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_NAME "resolve_blockhash_lookup"
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_CNT (3UL)
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_RECENT_IDX  0
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_RECENT_NAME "recent"
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_HISTORY_IDX  1
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_HISTORY_NAME "history"
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_UNKNOWN_IDX  2
+#define FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_UNKNOWN_NAME "unknown"
+
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_NAME "resolve_nonce_lookup"
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_CNT (3UL)
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_CURRENT_IDX  0
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_CURRENT_NAME "current"
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_STALE_IDX  1
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_STALE_NAME "stale"
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_UNKNOWN_IDX  2
+#define FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_UNKNOWN_NAME "unknown"
+
 #define FD_METRICS_ENUM_PACK_TXN_INSERT_RETURN_NAME "pack_txn_insert_return"
 #define FD_METRICS_ENUM_PACK_TXN_INSERT_RETURN_CNT (21UL)
 #define FD_METRICS_ENUM_PACK_TXN_INSERT_RETURN_V_NONCE_CONFLICT_IDX  0
@@ -3,6 +3,12 @@
 
 const fd_metrics_meta_t FD_METRICS_RESOLV[FD_METRICS_RESOLV_TOTAL] = {
     DECLARE_METRIC( RESOLV_NO_BANK_DROP, COUNTER ),
+    DECLARE_METRIC_ENUM( RESOLV_BLOCKHASH_LOOKUP, COUNTER, RESOLVE_BLOCKHASH_LOOKUP, RECENT ),
+    DECLARE_METRIC_ENUM( RESOLV_BLOCKHASH_LOOKUP, COUNTER, RESOLVE_BLOCKHASH_LOOKUP, HISTORY ),
+    DECLARE_METRIC_ENUM( RESOLV_BLOCKHASH_LOOKUP, COUNTER, RESOLVE_BLOCKHASH_LOOKUP, UNKNOWN ),
+    DECLARE_METRIC_ENUM( RESOLV_NONCE_LOOKUP, COUNTER, RESOLVE_NONCE_LOOKUP, CURRENT ),
+    DECLARE_METRIC_ENUM( RESOLV_NONCE_LOOKUP, COUNTER, RESOLVE_NONCE_LOOKUP, STALE ),
+    DECLARE_METRIC_ENUM( RESOLV_NONCE_LOOKUP, COUNTER, RESOLVE_NONCE_LOOKUP, UNKNOWN ),
     DECLARE_METRIC_ENUM( RESOLV_STASH_OPERATION, COUNTER, RESOLVE_STASH_OPERATION, INSERTED ),
     DECLARE_METRIC_ENUM( RESOLV_STASH_OPERATION, COUNTER, RESOLVE_STASH_OPERATION, OVERRUN ),
     DECLARE_METRIC_ENUM( RESOLV_STASH_OPERATION, COUNTER, RESOLVE_STASH_OPERATION, PUBLISHED ),
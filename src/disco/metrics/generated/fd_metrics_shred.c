@@ -22,4 +22,5 @@ const fd_metrics_meta_t FD_METRICS_SHRED[FD_METRICS_SHRED_TOTAL] = {
     DECLARE_METRIC( SHRED_FORCE_COMPLETE_REQUEST, COUNTER ),
     DECLARE_METRIC( SHRED_FORCE_COMPLETE_FAILURE, COUNTER ),
     DECLARE_METRIC( SHRED_FORCE_COMPLETE_SUCCESS, COUNTER ),
+    DECLARE_METRIC( SHRED_NET_TX_DIRECT_FULL, COUNTER ),
 };
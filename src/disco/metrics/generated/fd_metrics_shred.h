@@ -111,5 +111,11 @@
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_DESC "The number of times we successfully forced completed a FEC set on request"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_SHRED_TOTAL (20UL)
+#define FD_METRICS_COUNTER_SHRED_NET_TX_DIRECT_FULL_OFF  (116UL)
+#define FD_METRICS_COUNTER_SHRED_NET_TX_DIRECT_FULL_NAME "shred_net_tx_direct_full"
+#define FD_METRICS_COUNTER_SHRED_NET_TX_DIRECT_FULL_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SHRED_NET_TX_DIRECT_FULL_DESC "The number of outgoing shreds dropped because the net tiles were still sending older packets from the XDP buffer (net.xdp.direct_tx only)"
+#define FD_METRICS_COUNTER_SHRED_NET_TX_DIRECT_FULL_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_SHRED_TOTAL (21UL)
 extern const fd_metrics_meta_t FD_METRICS_SHRED[FD_METRICS_SHRED_TOTAL];
@@ -0,0 +1,8 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+#include "fd_metrics_solcap.h"
+
+const fd_metrics_meta_t FD_METRICS_SOLCAP[FD_METRICS_SOLCAP_TOTAL] = {
+    DECLARE_METRIC( SOLCAP_BYTES_WRITTEN, COUNTER ),
+    DECLARE_METRIC( SOLCAP_CHUNKS_DROPPED, COUNTER ),
+    DECLARE_METRIC( SOLCAP_BYTES_DROPPED, COUNTER ),
+};
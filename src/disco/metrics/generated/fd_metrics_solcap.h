@@ -0,0 +1,25 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+
+#include "../fd_metrics_base.h"
+#include "fd_metrics_enums.h"
+
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_WRITTEN_OFF  (16UL)
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_WRITTEN_NAME "solcap_bytes_written"
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_WRITTEN_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_WRITTEN_DESC "Number of bytes written to the solcap capture file, including the file header"
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_WRITTEN_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SOLCAP_CHUNKS_DROPPED_OFF  (17UL)
+#define FD_METRICS_COUNTER_SOLCAP_CHUNKS_DROPPED_NAME "solcap_chunks_dropped"
+#define FD_METRICS_COUNTER_SOLCAP_CHUNKS_DROPPED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOLCAP_CHUNKS_DROPPED_DESC "Number of capture chunks dropped because the solcap ring was full"
+#define FD_METRICS_COUNTER_SOLCAP_CHUNKS_DROPPED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_DROPPED_OFF  (18UL)
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_DROPPED_NAME "solcap_bytes_dropped"
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_DROPPED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_DROPPED_DESC "Number of capture bytes dropped because the solcap ring was full"
+#define FD_METRICS_COUNTER_SOLCAP_BYTES_DROPPED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_SOLCAP_TOTAL (3UL)
+extern const fd_metrics_meta_t FD_METRICS_SOLCAP[FD_METRICS_SOLCAP_TOTAL];
@@ -0,0 +1,244 @@
+#include "fd_metrics_rec.h"
+#include "fd_metrics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define TILE_CNT (3UL)
+
+static fd_topo_t topo[1];
+
+static uchar metrics_mem[ TILE_CNT ][ FD_METRICS_FOOTPRINT( 4UL, 2UL ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
+
+static uchar rec_mem[ 5UL<<20 ] __attribute__((aligned(FD_METRICS_REC_ALIGN)));
+static uchar block_mem[ FD_METRICS_REC_BLOCK_SZ ] __attribute__((aligned(FD_METRICS_REC_ALIGN)));
+
+static ulong shadow[ FD_METRICS_REC_VALUE_MAX ];
+static ulong shadow_cnt;
+
+static void
+init_topo( void ) {
+  static char const * names[ TILE_CNT ] = { "quic", "verify", "verify" };
+  static ulong const  in_cnt[ TILE_CNT ] = { 1UL, 4UL, 4UL };
+  static ulong const  out_cnt[ TILE_CNT ] = { 2UL, 1UL, 1UL };
+
+  topo->tile_cnt = TILE_CNT;
+  for( ulong i=0UL; i<TILE_CNT; i++ ) {
+    fd_topo_tile_t * tile = &topo->tiles[ i ];
+    strcpy( tile->name, names[ i ] );
+    tile->kind_id = i ? i-1UL : 0UL;
+    tile->metrics = fd_metrics_join( fd_metrics_new( metrics_mem[ i ], in_cnt[ i ], out_cnt[ i ] ) );
+  }
+}
+
+/* mutate applies a random change to the metrics of the topology, like
+   tiles would do concurrently. */
+
+static void
+mutate( fd_rng_t * rng ) {
+  ulong change_cnt = fd_rng_ulong_roll( rng, 16UL );
+  for( ulong c=0UL; c<change_cnt; c++ ) {
+    fd_topo_tile_t * tile = &topo->tiles[ fd_rng_ulong_roll( rng, TILE_CNT ) ];
+    volatile ulong * metrics = fd_metrics_tile( tile->metrics );
+    ulong idx = fd_rng_ulong_roll( rng, FD_METRICS_TOTAL_SZ/sizeof(ulong) );
+    switch( fd_rng_uint_roll( rng, 4U ) ) {
+      case 0U: metrics[ idx ] += fd_rng_ulong_roll( rng, 100UL );      break; /* counter */
+      case 1U: metrics[ idx ] -= fd_rng_ulong_roll( rng, 100UL );      break; /* gauge going down */
+      case 2U: metrics[ idx ]  = fd_rng_ulong( rng );                  break; /* arbitrary, needs a literal */
+      case 3U: fd_metrics_link_in( tile->metrics, 0UL )[ 0 ] += 1UL;   break;
+    }
+  }
+}
+
+static void
+snapshot( void ) {
+  shadow_cnt = 0UL;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    ulong const * metrics = topo->tiles[ i ].metrics;
+    ulong cnt = 2UL + FD_METRICS_ALL_LINK_IN_TOTAL*metrics[ 0 ] + FD_METRICS_ALL_LINK_OUT_TOTAL*metrics[ 1 ] + FD_METRICS_TOTAL_SZ/sizeof(ulong);
+    memcpy( shadow+shadow_cnt, metrics, cnt*sizeof(ulong) );
+    shadow_cnt += cnt;
+  }
+}
+
+struct verify_ctx {
+  fd_rng_t * rng;
+  ulong      sample_cnt;
+  long       ts_next;
+};
+
+typedef struct verify_ctx verify_ctx_t;
+
+static void
+verify_sample( void *        _ctx,
+               long          ts,
+               ulong const * values ) {
+  verify_ctx_t * ctx = (verify_ctx_t *)_ctx;
+  mutate( ctx->rng );
+  snapshot();
+  FD_TEST( ts==ctx->ts_next );
+  FD_TEST( !memcmp( values, shadow, shadow_cnt*sizeof(ulong) ) );
+  ctx->ts_next += 1000L + (long)ctx->sample_cnt;
+  ctx->sample_cnt++;
+}
+
+static void
+read_block( int   fd,
+            ulong idx ) {
+  long res = pread( fd, block_mem, FD_METRICS_REC_BLOCK_SZ, (long)(FD_METRICS_REC_HDR_SZ+idx*FD_METRICS_REC_BLOCK_SZ) );
+  FD_TEST( res>=(long)sizeof(fd_metrics_rec_block_t) );
+}
+
+static int
+tmp_file( void ) {
+  char path[] = "/tmp/test_metrics_rec.XXXXXX";
+  int fd = mkstemp( path );
+  FD_TEST( fd>=0 );
+  FD_TEST( !unlink( path ) );
+  return fd;
+}
+
+static void
+test_roundtrip( fd_rng_t * rng ) {
+  memset( metrics_mem, 0, sizeof(metrics_mem) );
+  init_topo();
+
+  int fd = tmp_file();
+  ulong file_sz = FD_METRICS_REC_HDR_SZ + 64UL*FD_METRICS_REC_BLOCK_SZ;
+  fd_metrics_rec_t * rec = fd_metrics_rec_join( fd_metrics_rec_new( rec_mem, fd, topo, 10000000L, file_sz ) );
+  FD_TEST( rec );
+  FD_TEST( rec->block_cnt==64UL );
+
+  fd_metrics_rec_hdr_t hdr[1];
+  FD_TEST( pread( fd, hdr, sizeof(fd_metrics_rec_hdr_t), 0L )==(long)sizeof(fd_metrics_rec_hdr_t) );
+  FD_TEST( hdr->magic==FD_METRICS_REC_MAGIC );
+  FD_TEST( hdr->tile_cnt==TILE_CNT );
+  FD_TEST( !strcmp( hdr->tile[ 1 ].name, "verify" ) );
+  FD_TEST( hdr->tile[ 2 ].kind_id==1UL );
+  snapshot();
+  FD_TEST( hdr->value_cnt==shadow_cnt );
+  FD_TEST( hdr->tile[ 1 ].value_off==2UL+FD_METRICS_ALL_LINK_IN_TOTAL+2UL*FD_METRICS_ALL_LINK_OUT_TOTAL+FD_METRICS_TOTAL_SZ/sizeof(ulong) );
+
+  /* Record enough samples to span several blocks.  Use the same seed
+     for the writer and the verifier so the verifier can reproduce the
+     metrics of every sample. */
+
+  ulong seed = fd_rng_ulong( rng );
+  fd_rng_t _wrng[1]; fd_rng_t * wrng = fd_rng_join( fd_rng_new( _wrng, (uint)seed, 0UL ) );
+  ulong sample_cnt = 200000UL;
+  long  ts         = 1000L;
+  for( ulong i=0UL; i<sample_cnt; i++ ) {
+    mutate( wrng );
+    fd_metrics_rec_sample( rec, topo, ts );
+    ts += 1000L + (long)i;
+  }
+  fd_metrics_rec_flush( rec );
+  FD_TEST( rec->metrics.sample_cnt==sample_cnt );
+  FD_TEST( rec->metrics.block_cnt>=2UL );
+  FD_TEST( rec->block_seq<64UL );
+  FD_TEST( !rec->metrics.write_err_cnt );
+
+  memset( metrics_mem, 0, sizeof(metrics_mem) );
+  init_topo();
+  fd_rng_t _vrng[1];
+  verify_ctx_t ctx = {
+    .rng        = fd_rng_join( fd_rng_new( _vrng, (uint)seed, 0UL ) ),
+    .sample_cnt = 0UL,
+    .ts_next    = 1000L,
+  };
+  static ulong values[ FD_METRICS_REC_VALUE_MAX ];
+  for( ulong b=0UL; b<=rec->block_seq; b++ ) {
+    read_block( fd, b );
+    fd_metrics_rec_block_t const * block = (fd_metrics_rec_block_t const *)block_mem;
+    FD_TEST( block->seq==b );
+    FD_TEST( !fd_metrics_rec_block_decode( block, FD_METRICS_REC_BLOCK_SZ, hdr->value_cnt, values, verify_sample, &ctx ) );
+  }
+  FD_TEST( ctx.sample_cnt==sample_cnt );
+
+  /* Truncated and corrupt blocks are rejected */
+
+  read_block( fd, 0UL );
+  fd_metrics_rec_block_t * block = (fd_metrics_rec_block_t *)block_mem;
+  memset( metrics_mem, 0, sizeof(metrics_mem) );
+  init_topo();
+  ctx.rng = fd_rng_join( fd_rng_new( _vrng, (uint)seed, 0UL ) ); ctx.sample_cnt = 0UL; ctx.ts_next = 1000L;
+  block->data_sz -= 1UL;
+  FD_TEST( fd_metrics_rec_block_decode( block, FD_METRICS_REC_BLOCK_SZ, hdr->value_cnt, values, verify_sample, &ctx ) );
+  block->data_sz = FD_METRICS_REC_BLOCK_SZ;
+  FD_TEST( fd_metrics_rec_block_decode( block, FD_METRICS_REC_BLOCK_SZ, hdr->value_cnt, values, verify_sample, &ctx ) );
+  block->magic = 0UL;
+  FD_TEST( fd_metrics_rec_block_decode( block, FD_METRICS_REC_BLOCK_SZ, hdr->value_cnt, values, verify_sample, &ctx ) );
+
+  FD_TEST( fd_metrics_rec_delete( fd_metrics_rec_leave( rec ) )==rec_mem );
+  FD_TEST( !close( fd ) );
+}
+
+static void
+count_sample( void *        _ctx,
+              long          ts,
+              ulong const * values ) {
+  (void)ts; (void)values;
+  (*(ulong *)_ctx)++;
+}
+
+static void
+test_wrap( void ) {
+  memset( metrics_mem, 0, sizeof(metrics_mem) );
+  init_topo();
+
+  int fd = tmp_file();
+  fd_metrics_rec_t * rec = fd_metrics_rec_join( fd_metrics_rec_new( rec_mem, fd, topo, 10000000L, FD_METRICS_REC_HDR_SZ + 2UL*FD_METRICS_REC_BLOCK_SZ ) );
+  FD_TEST( rec );
+  FD_TEST( rec->block_cnt==2UL );
+
+  /* A sample where every value changes fills a block quickly */
+
+  ulong i = 0UL;
+  while( rec->block_seq<5UL ) {
+    for( ulong t=0UL; t<TILE_CNT; t++ ) {
+      volatile ulong * metrics = fd_metrics_tile( topo->tiles[ t ].metrics );
+      for( ulong j=0UL; j<FD_METRICS_TOTAL_SZ/sizeof(ulong); j++ ) metrics[ j ] += j;
+    }
+    fd_metrics_rec_sample( rec, topo, (long)i++ );
+  }
+  fd_metrics_rec_flush( rec );
+
+  /* Only the last two blocks survive, each in the slot for its seq */
+
+  static ulong values[ FD_METRICS_REC_VALUE_MAX ];
+  ulong total = 0UL;
+  for( ulong b=0UL; b<2UL; b++ ) {
+    read_block( fd, b );
+    fd_metrics_rec_block_t const * block = (fd_metrics_rec_block_t const *)block_mem;
+    FD_TEST( block->seq==4UL+b );
+    FD_TEST( block->seq%2UL==b );
+    ulong cnt = 0UL;
+    FD_TEST( !fd_metrics_rec_block_decode( block, FD_METRICS_REC_BLOCK_SZ, rec->value_cnt, values, count_sample, &cnt ) );
+    FD_TEST( cnt==block->sample_cnt );
+    total += cnt;
+    if( b==1UL ) FD_TEST( block->ts_last==(long)(i-1UL) );
+  }
+  FD_TEST( total<i );
+
+  FD_TEST( !close( fd ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_metrics_rec_footprint()<=sizeof(rec_mem) );
+
+  test_roundtrip( rng );
+  test_wrap();
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
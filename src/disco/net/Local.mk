@@ -2,3 +2,4 @@ ifdef FD_HAS_ALLOCA
 $(call add-hdrs,fd_net_tile.h)
 $(call add-objs,fd_net_tile_topo,fd_disco)
 endif
+$(call make-unit-test,bench_net_rx_demux,bench_net_rx_demux,fd_disco fd_tango fd_util)
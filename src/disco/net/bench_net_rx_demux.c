@@ -0,0 +1,169 @@
+#include "../fd_disco_base.h"
+
+#include <math.h>
+
+/* bench_net_rx_demux compares two ways of distributing net tile RX
+   frags to cnt QUIC tiles, for cnt in [1,--lane-max]:
+
+   - bcast: All consumers read one shared mcache.  Each consumer reads
+     the metadata of every frag and keeps those with hash%cnt==idx.
+   - lanes: The producer publishes each frag to one of cnt mcaches
+     selected by hash%cnt (see fd_topos_net_rx_lanes).  Each consumer
+     only reads its own lane.
+
+   Frags are published in rounds of --burst frags with random flow
+   hashes.  After each round, every consumer drains its input in turn.
+   Reports the metadata reads per frag, the producer cost, the cost of
+   the busiest consumer, and the frag rate the producer and cnt
+   consumers would sustain on separate cores.  This runs in a single
+   thread, so the cross-core cache line transfers of a real topology
+   (which grow with every mline read) are not accounted for. */
+
+#define LANE_MAX (16UL)
+#define DEPTH    (16384UL)
+#define SIG_CNT  (65536UL)
+
+static uchar mcache_mem[ LANE_MAX ][ FD_MCACHE_FOOTPRINT( DEPTH, 0UL ) ] __attribute__((aligned(FD_MCACHE_ALIGN)));
+static ulong sig_tbl[ SIG_CNT ];
+
+struct bench_link {
+  fd_frag_meta_t * mcache;
+  ulong            prod_seq;
+  ulong            cons_seq[ LANE_MAX ];
+};
+
+typedef struct bench_link bench_link_t;
+
+/* publish publishes burst frags starting at sig_tbl[ *sig_idx ].  If
+   lanes, steers each frag to link hash%lane_cnt, else publishes all
+   frags to link 0. */
+
+__attribute__((noinline)) static void
+publish( bench_link_t * link,
+         ulong          lane_cnt,
+         int            lanes,
+         ulong          burst,
+         ulong *        sig_idx ) {
+  ulong idx = *sig_idx;
+  for( ulong j=0UL; j<burst; j++ ) {
+    ulong sig = sig_tbl[ idx ];
+    idx = (idx+1UL) & (SIG_CNT-1UL);
+    bench_link_t * out = link;
+    if( lanes ) out += fd_disco_netmux_sig_hash( sig ) % lane_cnt;
+    fd_mcache_publish( out->mcache, DEPTH, out->prod_seq, sig, 0UL, 1232UL, 0UL, 0UL, 0U );
+    out->prod_seq = fd_seq_inc( out->prod_seq, 1UL );
+  }
+  *sig_idx = idx;
+}
+
+/* drain consumes all frags available to consumer lane_idx, like a stem
+   tile polling a single unreliable in link.  If filter, skips frags of
+   other consumers like fd_quic_tile before_frag.  Returns the number of
+   mlines read, accumulates frag sizes to *acc. */
+
+__attribute__((noinline)) static ulong
+drain( fd_frag_meta_t const * mcache,
+       ulong *                seq,
+       ulong                  lane_cnt,
+       ulong                  lane_idx,
+       int                    filter,
+       ulong *                acc ) {
+  ulong read_cnt = 0UL;
+  for(;;) {
+    fd_frag_meta_t const * mline = mcache + fd_mcache_line_idx( *seq, DEPTH );
+    ulong seq_found = fd_frag_meta_seq_query( mline );
+    if( fd_seq_ne( seq_found, *seq ) ) break; /* caught up */
+    FD_COMPILER_MFENCE();
+    ulong sig = mline->sig;
+    ulong sz  = mline->sz;
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( fd_seq_ne( fd_frag_meta_seq_query( mline ), seq_found ) ) ) FD_LOG_ERR(( "overrun" ));
+    read_cnt++;
+    *seq = fd_seq_inc( *seq, 1UL );
+    if( filter && fd_disco_netmux_sig_hash( sig )%lane_cnt!=lane_idx ) continue;
+    *acc += sz;
+  }
+  return read_cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong lane_max  = fd_env_strip_cmdline_ulong( &argc, &argv, "--lane-max",  NULL,     16UL );
+  ulong burst     = fd_env_strip_cmdline_ulong( &argc, &argv, "--burst",     NULL,   1024UL );
+  ulong round_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--round-cnt", NULL,   4096UL );
+  uint  rng_seed  = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed",  NULL,    1234U );
+
+  if( FD_UNLIKELY( !lane_max || lane_max>LANE_MAX ) ) FD_LOG_ERR(( "--lane-max must be in [1,%lu]", LANE_MAX ));
+  if( FD_UNLIKELY( !burst    || burst>DEPTH/2UL   ) ) FD_LOG_ERR(( "--burst must be in [1,%lu]", DEPTH/2UL ));
+
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, rng_seed, 0UL ) );
+  for( ulong j=0UL; j<SIG_CNT; j++ ) {
+    sig_tbl[ j ] = fd_disco_netmux_sig( fd_rng_uint( rng ), fd_rng_ushort( rng ), 0U, DST_PROTO_TPU_QUIC, 42UL );
+  }
+
+  bench_link_t link[ LANE_MAX ];
+  for( ulong j=0UL; j<LANE_MAX; j++ ) {
+    link[ j ].mcache = fd_mcache_join( fd_mcache_new( mcache_mem[ j ], DEPTH, 0UL, 0UL ) );
+    FD_TEST( link[ j ].mcache );
+  }
+
+  double tick_per_ns = fd_tempo_tick_per_ns( NULL );
+  ulong  frag_cnt    = burst*round_cnt;
+
+  FD_LOG_NOTICE(( "%lu rounds of %lu frags", round_cnt, burst ));
+  FD_LOG_NOTICE(( "cnt  mode   reads/frag  prod ns/frag  cons max ns/frag  Mfrag/s" ));
+
+  for( ulong lane_cnt=1UL; lane_cnt<=lane_max; lane_cnt++ ) {
+    for( int lanes=0; lanes<2; lanes++ ) {
+      ulong link_cnt = lanes ? lane_cnt : 1UL;
+      for( ulong j=0UL; j<LANE_MAX; j++ ) {
+        link[ j ].prod_seq = 0UL;
+        for( ulong k=0UL; k<LANE_MAX; k++ ) link[ j ].cons_seq[ k ] = 0UL;
+        fd_mcache_seq_update( fd_mcache_seq_laddr( link[ j ].mcache ), 0UL );
+      }
+      /* Invalidate mlines of the previous run */
+      for( ulong j=0UL; j<link_cnt; j++ ) {
+        for( ulong k=0UL; k<DEPTH; k++ ) link[ j ].mcache[ k ].seq = fd_seq_dec( k, 1UL );
+      }
+
+      long  prod_ticks = 0L;
+      long  cons_ticks[ LANE_MAX ] = {0};
+      ulong read_cnt = 0UL;
+      ulong acc      = 0UL;
+      ulong sig_idx  = 0UL;
+      for( ulong r=0UL; r<round_cnt; r++ ) {
+        long t0 = fd_tickcount();
+        publish( link, lane_cnt, lanes, burst, &sig_idx );
+        long t1 = fd_tickcount();
+        prod_ticks += t1-t0;
+        for( ulong k=0UL; k<lane_cnt; k++ ) {
+          bench_link_t * in = lanes ? &link[ k ] : &link[ 0 ];
+          long s0 = fd_tickcount();
+          read_cnt += drain( in->mcache, &in->cons_seq[ k ], lane_cnt, k, !lanes, &acc );
+          cons_ticks[ k ] += fd_tickcount() - s0;
+        }
+      }
+      FD_TEST( acc==1232UL*frag_cnt );
+
+      long cons_max = 0L;
+      for( ulong k=0UL; k<lane_cnt; k++ ) cons_max = fd_long_max( cons_max, cons_ticks[ k ] );
+      double prod_ns = (double)prod_ticks / tick_per_ns / (double)frag_cnt;
+      double cons_ns = (double)cons_max   / tick_per_ns / (double)frag_cnt;
+      FD_LOG_NOTICE(( "%3lu  %s  %10.2f  %12.2f  %16.2f  %7.1f",
+                      lane_cnt, lanes ? "lanes" : "bcast",
+                      (double)read_cnt/(double)frag_cnt, prod_ns, cons_ns,
+                      1e3/fmax( prod_ns, cons_ns ) ));
+    }
+  }
+
+  for( ulong j=0UL; j<LANE_MAX; j++ ) fd_mcache_delete( fd_mcache_leave( link[ j ].mcache ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
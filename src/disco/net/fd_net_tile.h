@@ -61,6 +61,85 @@ fd_net_rx_translate_frag( fd_net_rx_bounds_t const * bounds,
 
 FD_PROTOTYPES_END
 
+/* Helpers for producers of net tile TX packets on direct TX links
+
+   By default, the net tile copies each outgoing packet from the
+   producer's dcache into one of its own XDP TX frames.  A direct TX
+   link instead registers its dcache as part of the net tile UMEM (see
+   fd_topos_net_tx_direct), so the net tiles submit the producer's
+   buffer to the kernel as is.
+
+   XDP requires each packet to start at a 2048 byte aligned frame.
+   Frames are thus assigned by seq number: frag seq is written to frame
+   seq%depth (fd_net_tx_direct_chunk) instead of compact dcache chunks.
+   Frames remain owned by the net tiles after publishing.  Each net tile
+   publishes a tx_done seq number once it ignored, dropped or finished
+   sending a frag.  Before writing frag seq, producers check with
+   fd_net_tx_direct_ready that all net tiles are done with the frag that
+   previously used the same frame.  Like an overrun on a regular net TX
+   link, the packet should be dropped if not ready. */
+
+#define FD_NET_TX_DIRECT_NET_MAX (32UL)
+
+struct fd_net_tx_direct {
+  ulong         chunk0;   /* chunk index of frame 0 */
+  ulong         depth;    /* number of frames (same as link depth) */
+  ulong         done_min; /* min tx_done seq across net tiles (cached) */
+  ulong         net_cnt;
+  ulong const * tx_done[ FD_NET_TX_DIRECT_NET_MAX ];
+};
+
+typedef struct fd_net_tx_direct fd_net_tx_direct_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_net_tx_direct_frame0 returns the address of the first frame in
+   the dcache of a direct TX link. */
+
+FD_FN_CONST static inline ulong
+fd_net_tx_direct_frame0( void const * dcache ) {
+  return fd_ulong_align_up( (ulong)dcache, FD_NET_MTU );
+}
+
+/* fd_net_tx_direct_join prepares a producer to publish to the link
+   with the given id.  Returns tx on success.  Returns NULL if the link
+   is not a direct TX link, in which case the producer should use the
+   link like a regular dcache. */
+
+fd_net_tx_direct_t *
+fd_net_tx_direct_join( fd_net_tx_direct_t * tx,
+                       fd_topo_t const *    topo,
+                       ulong                link_id );
+
+/* fd_net_tx_direct_chunk returns the dcache chunk that frag seq must be
+   written to. */
+
+FD_FN_PURE static inline ulong
+fd_net_tx_direct_chunk( fd_net_tx_direct_t const * tx,
+                        ulong                      seq ) {
+  return tx->chunk0 + ( seq & (tx->depth-1UL) )*( FD_NET_MTU>>FD_CHUNK_LG_SZ );
+}
+
+/* fd_net_tx_direct_ready returns 1 if frag seq may be written to its
+   frame, 0 otherwise.  seq is the next seq number to be published. */
+
+static inline int
+fd_net_tx_direct_ready( fd_net_tx_direct_t * tx,
+                        ulong                seq ) {
+  if( FD_LIKELY( fd_seq_lt( seq, tx->done_min+tx->depth ) ) ) return 1;
+
+  ulong done_min = seq;
+  for( ulong j=0UL; j<tx->net_cnt; j++ ) {
+    ulong done = fd_fseq_query( tx->tx_done[ j ] );
+    if( FD_UNLIKELY( done==ULONG_MAX ) ) return 0; /* net tile not booted yet */
+    done_min = fd_ulong_if( fd_seq_lt( done, done_min ), done, done_min );
+  }
+  tx->done_min = done_min;
+  return fd_seq_lt( seq, done_min+tx->depth );
+}
+
+FD_PROTOTYPES_END
+
 /* Topology APIs */
 
 FD_PROTOTYPES_BEGIN
@@ -90,6 +169,50 @@ fd_topos_net_rx_link( fd_topo_t *  topo,
                       ulong        net_kind_id,
                       ulong        depth );
 
+/* fd_topos_net_rx_lanes is like fd_topos_net_rx_link, but steers
+   packets to one of lane_cnt consumers instead of broadcasting them.
+
+   A net RX link is normally read by all consumer tiles of the same
+   kind, which pick their share of frags by flow hash (see
+   fd_disco_netmux_sig_hash).  Each consumer thus reads the metadata of
+   every frag.  With XDP, this creates lane_cnt separate RX links for
+   net tile net_kind_id instead, and the net tile publishes each packet
+   to lane hash%lane_cnt.  Packets of the same flow stay on the same
+   lane in order.  Each lane gets a depth of depth/lane_cnt (rounded up
+   to a power of two, at least FD_NET_RX_LANE_DEPTH_MIN).
+
+   The sock tile receives directly into the link dcache and cannot
+   steer packets, so only a single broadcast link is created when not
+   using XDP.  Consumers subscribe via fd_topos_tile_in_net_lane and
+   should keep filtering by flow hash if their link is shared with
+   other consumers (fd_topo_link_consumer_cnt).  A net tile steers to
+   at most FD_NET_RX_LANE_MAX lanes. */
+
+#define FD_NET_RX_LANE_DEPTH_MIN (1024UL)
+#define FD_NET_RX_LANE_MAX       (16UL)
+
+void
+fd_topos_net_rx_lanes( fd_topo_t *  topo,
+                       char const * link_name,
+                       ulong        net_kind_id,
+                       ulong        depth,
+                       ulong        lane_cnt );
+
+/* fd_topos_tile_in_net_lane subscribes a consumer tile to lane lane_idx
+   of the RX links created by fd_topos_net_rx_lanes across all net
+   tiles.  Subscribes to the whole link if a net tile did not create
+   lanes. */
+
+void
+fd_topos_tile_in_net_lane( fd_topo_t *  topo,
+                           char const * tile_name,
+                           ulong        tile_kind_id,
+                           char const * fseq_wksp,
+                           char const * link_name,
+                           ulong        lane_idx,
+                           int          reliable,
+                           int          polled );
+
 /* fd_topob_tile_in_net registers a net TX link with all net tiles. */
 
 void
@@ -100,6 +223,22 @@ fd_topos_tile_in_net( fd_topo_t *  topo,
                       int          reliable,
                       int          polled );
 
+/* fd_topos_net_tx_direct turns an app->net TX link into a direct TX
+   link (see fd_net_tx_direct_t).  Moves the link's dcache into a
+   dedicated workspace that the net tiles register as part of their
+   XDP UMEM, and creates a tx_done fseq for each net tile in it.  Should
+   be called after the link was registered with the net tiles (see
+   fd_topos_tile_in_net) and its producer.  No-op if the net tiles do
+   not use XDP.
+
+   The producer tile only gains access to its own TX frames, not to the
+   net_umem workspace holding the RX packet buffers of the net tiles. */
+
+void
+fd_topos_net_tx_direct( fd_topo_t *  topo,
+                        char const * link_name,
+                        ulong        link_kind_id );
+
 /* This should be called *after* all app<->net tile links have been
    created.  Should be called once per net tile. */
 
@@ -166,6 +166,59 @@ fd_topos_net_rx_link( fd_topo_t *  topo,
   }
 }
 
+void
+fd_topos_net_rx_lanes( fd_topo_t *  topo,
+                       char const * link_name,
+                       ulong        net_kind_id,
+                       ulong        depth,
+                       ulong        lane_cnt ) {
+  if( FD_UNLIKELY( !lane_cnt ) ) FD_LOG_ERR(( "zero lane_cnt for %s", link_name ));
+  if( FD_UNLIKELY( lane_cnt>FD_NET_RX_LANE_MAX ) ) FD_LOG_ERR(( "too many lanes for %s (%lu, max %lu)", link_name, lane_cnt, FD_NET_RX_LANE_MAX ));
+  if( !topo_is_xdp( topo ) || lane_cnt==1UL ) {
+    fd_topos_net_rx_link( topo, link_name, net_kind_id, depth );
+    return;
+  }
+
+  /* Lanes of net tile i get link kind IDs [i*lane_cnt,(i+1)*lane_cnt) */
+
+  ulong lane_depth = fd_ulong_min( depth, fd_ulong_pow2_up( fd_ulong_max( depth/lane_cnt, FD_NET_RX_LANE_DEPTH_MIN ) ) );
+  for( ulong j=0UL; j<lane_cnt; j++ ) {
+    add_xdp_rx_link( topo, link_name, net_kind_id, lane_depth );
+    fd_topob_tile_out( topo, "net", net_kind_id, link_name, topo->links[ topo->link_cnt-1UL ].kind_id );
+  }
+}
+
+void
+fd_topos_tile_in_net_lane( fd_topo_t *  topo,
+                           char const * tile_name,
+                           ulong        tile_kind_id,
+                           char const * fseq_wksp,
+                           char const * link_name,
+                           ulong        lane_idx,
+                           int          reliable,
+                           int          polled ) {
+  for( ulong j=0UL; j<(topo->tile_cnt); j++ ) {
+    fd_topo_tile_t const * net_tile = &topo->tiles[ j ];
+    if( 0!=strcmp( net_tile->name, "net"  ) &&
+        0!=strcmp( net_tile->name, "sock" ) ) continue;
+
+    /* Out links of a net tile with the same name are its lanes */
+
+    ulong lane_cnt = 0UL;
+    ulong link_id  = ULONG_MAX;
+    for( ulong k=0UL; k<(net_tile->out_cnt); k++ ) {
+      fd_topo_link_t const * link = &topo->links[ net_tile->out_link_id[ k ] ];
+      if( 0!=strcmp( link->name, link_name ) ) continue;
+      if( lane_cnt==lane_idx || !lane_cnt ) link_id = link->id;
+      lane_cnt++;
+    }
+    if( FD_UNLIKELY( link_id==ULONG_MAX ) ) FD_LOG_ERR(( "%s:%lu does not produce link %s", net_tile->name, net_tile->kind_id, link_name ));
+    if( FD_UNLIKELY( lane_cnt>1UL && lane_idx>=lane_cnt ) ) FD_LOG_ERR(( "%s:%lu has no lane %lu of link %s", net_tile->name, net_tile->kind_id, lane_idx, link_name ));
+
+    fd_topob_tile_in( topo, tile_name, tile_kind_id, fseq_wksp, link_name, topo->links[ link_id ].kind_id, reliable, polled );
+  }
+}
+
 void
 fd_topos_tile_in_net( fd_topo_t *  topo,
                       char const * fseq_wksp,
@@ -181,6 +234,84 @@ fd_topos_tile_in_net( fd_topo_t *  topo,
   }
 }
 
+void
+fd_topos_net_tx_direct( fd_topo_t *  topo,
+                        char const * link_name,
+                        ulong        link_kind_id ) {
+  if( !topo_is_xdp( topo ) ) return;
+
+  ulong link_id = fd_topo_find_link( topo, link_name, link_kind_id );
+  if( FD_UNLIKELY( link_id==ULONG_MAX ) ) FD_LOG_ERR(( "link %s:%lu not found", link_name, link_kind_id ));
+  fd_topo_link_t * link = &topo->links[ link_id ];
+  if( FD_UNLIKELY( link->mtu!=FD_NET_MTU ) ) FD_LOG_ERR(( "link %s does not have a normal MTU", link->name ));
+
+  ulong producer_id = fd_topo_find_link_producer( topo, link );
+  if( FD_UNLIKELY( producer_id==ULONG_MAX ) ) FD_LOG_ERR(( "link %s has no producer", link->name ));
+  fd_topo_tile_t * producer = &topo->tiles[ producer_id ];
+
+  /* net_txd*: TX frames of a direct TX link.  Each link gets its own
+     workspace, such that the producer does not get access to the RX
+     frames of the net tiles or the frames of other producers.  The net
+     tiles map it next to their own UMEM workspace (see fd_xdp_tile.c). */
+
+  char wksp_name[ sizeof(topo->workspaces[0].name) ];
+  FD_TEST( fd_cstr_printf_check( wksp_name, sizeof(wksp_name), NULL, "net_txd%lu", link_id ) );
+  fd_topob_wksp( topo, wksp_name );
+
+  /* Frames are assigned by seq number, so reserve room for depth
+     frames plus alignment */
+
+  topo->objs[ link->dcache_obj_id ].wksp_id = fd_topo_find_wksp( topo, wksp_name );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, (link->depth+1UL)*FD_NET_MTU, "obj.%lu.data_sz", link->dcache_obj_id ) );
+
+  for( ulong j=0UL; j<(topo->tile_cnt); j++ ) {
+    fd_topo_tile_t * net_tile = &topo->tiles[ j ];
+    if( 0!=strcmp( net_tile->name, "net" ) ) continue;
+    if( FD_UNLIKELY( fd_topo_find_tile_in_link( topo, net_tile, link_name, link_kind_id )==ULONG_MAX ) ) {
+      FD_LOG_ERR(( "net:%lu does not consume link %s:%lu", net_tile->kind_id, link_name, link_kind_id ));
+    }
+
+    fd_topo_obj_t * tx_done_obj = fd_topob_obj( topo, "fseq", wksp_name );
+    fd_topob_tile_uses( topo, net_tile, tx_done_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    fd_topob_tile_uses( topo, producer, tx_done_obj, FD_SHMEM_JOIN_MODE_READ_ONLY  );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, tx_done_obj->id, "net.%lu.tx_done.%lu", net_tile->kind_id, link_id ) );
+
+    net_tile->xdp.tx_direct_frame_cnt += fd_ulong_align_up( link->depth, 64UL );
+  }
+}
+
+fd_net_tx_direct_t *
+fd_net_tx_direct_join( fd_net_tx_direct_t * tx,
+                       fd_topo_t const *    topo,
+                       ulong                link_id ) {
+  fd_topo_link_t const * link = &topo->links[ link_id ];
+
+  memset( tx, 0, sizeof(fd_net_tx_direct_t) );
+  for( ulong j=0UL; j<(topo->tile_cnt); j++ ) {
+    fd_topo_tile_t const * net_tile = &topo->tiles[ j ];
+    if( 0!=strcmp( net_tile->name, "net" ) ) continue;
+    ulong tx_done_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "net.%lu.tx_done.%lu", net_tile->kind_id, link_id );
+    if( tx_done_obj_id==ULONG_MAX ) return NULL;
+    if( FD_UNLIKELY( tx->net_cnt>=FD_NET_TX_DIRECT_NET_MAX ) ) FD_LOG_ERR(( "too many net tiles" ));
+    tx->tx_done[ tx->net_cnt ] = fd_fseq_join( fd_topo_obj_laddr( topo, tx_done_obj_id ) );
+    if( FD_UNLIKELY( !tx->tx_done[ tx->net_cnt ] ) ) FD_LOG_ERR(( "failed to join tx_done fseq of link %s", link->name ));
+    tx->net_cnt++;
+  }
+  if( !tx->net_cnt ) return NULL;
+
+  fd_wksp_t * wksp = topo->workspaces[ topo->objs[ link->dcache_obj_id ].wksp_id ].wksp;
+  tx->chunk0   = fd_laddr_to_chunk( wksp, (void const *)fd_net_tx_direct_frame0( link->dcache ) );
+  tx->depth    = link->depth;
+  if( FD_UNLIKELY( fd_net_tx_direct_frame0( link->dcache ) + tx->depth*FD_NET_MTU >
+                   (ulong)link->dcache + fd_dcache_data_sz( link->dcache ) ) ) {
+    FD_LOG_ERR(( "dcache of direct TX link %s is too small", link->name ));
+  }
+
+  /* Not ready until all net tiles published an initial tx_done */
+  tx->done_min = fd_seq_dec( fd_mcache_seq_query( fd_mcache_seq_laddr_const( link->mcache ) ), tx->depth );
+  return tx;
+}
+
 void
 fd_topos_net_tile_finish( fd_topo_t * topo,
                           ulong       net_kind_id ) {
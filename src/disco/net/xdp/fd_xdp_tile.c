@@ -2,6 +2,8 @@
    traffic.  It is responsible for setting up the XDP and
    XSK socket configuration. */
 
+#define _GNU_SOURCE /* MAP_ANONYMOUS */
+
 #include <errno.h>
 #include <fcntl.h>
 #include <net/if.h>
@@ -10,6 +12,7 @@
 #include <linux/if_xdp.h>
 
 #include "../fd_net_common.h"
+#include "../fd_net_tile.h"
 #include "../../metrics/fd_metrics.h"
 #include "../../netlink/fd_netlink_tile.h" /* neigh4_solicit */
 #include "../../topo/fd_topo.h"
@@ -24,12 +27,15 @@
 #include "../../../util/net/fd_eth.h"
 #include "../../../util/net/fd_ip4.h"
 #include "../../../util/net/fd_gre.h"
+#include "../../../util/pod/fd_pod_format.h"
+#include "../../../util/shmem/fd_shmem_private.h" /* fd_shmem_private_path */
 
 #include <unistd.h>
 #include <linux/if.h> /* struct ifreq */
 #include <sys/ioctl.h>
 #include <linux/unistd.h>
 #include <linux/if_arp.h>
+#include <sys/mman.h>
 
 #include "generated/xdp_seccomp.h"
 
@@ -38,6 +44,11 @@
 
 #define MAX_NET_INS (32UL)
 
+/* MAX_NET_RX_LANES controls the max number of QUIC tiles that a net
+   tile can steer packets to (see fd_topos_net_rx_lanes). */
+
+#define MAX_NET_RX_LANES FD_NET_RX_LANE_MAX
+
 /* FD_XDP_STATS_INTERVAL_NS controls the XDP stats refresh interval.
    This should be lower than the interval at which the metrics tile
    collects metrics. */
@@ -51,12 +62,27 @@
 #define XSK_IDX_LO   1
 
 /* fd_net_in_ctx_t contains consumer information for an incoming tango
-   link.  It is used as part of the TX path. */
+   link.  It is used as part of the TX path.
+
+   Direct TX links (see fd_net_tx_direct_t) carry packets in frames that
+   are part of the UMEM region.  The net tile submits such frames to the
+   XSK TX ring in place.  A frame is handed back to the producer once
+   all frags up to and including its own are done (ignored, dropped, or
+   released by the kernel via the completion ring).  tx_done publishes
+   the seq number of the first frag that is not done yet. */
 
 typedef struct {
   fd_wksp_t * mem;
   ulong       chunk0;
   ulong       wmark;
+
+  /* Direct TX link state (tx_done==NULL if not a direct TX link) */
+  ulong *     tx_done;
+  ulong       frame_off; /* UMEM offset of the link's first frame */
+  ulong       depth;     /* Number of frames (power of 2) */
+  ulong       seq_next;  /* Seq number of the next frag to be seen */
+  ulong       seq_done;  /* All frags before seq_done are done */
+  ulong *     busy;      /* Bit set of frames owned by the kernel */
 } fd_net_in_ctx_t;
 
 /* fd_net_out_ctx_t contains publisher information for a link to a
@@ -164,9 +190,11 @@ typedef struct {
   fd_xsk_t xsk[ 2 ];
   int      prog_link_fds[ 2 ];
 
-  /* UMEM frame region within dcache */
+  /* UMEM frame region.  Spans the net tile's own dcache, followed by
+     the dcaches of all direct TX links (see net_umem_map). */
   void *   umem_frame0; /* First UMEM frame */
   ulong    umem_sz;     /* Usable UMEM size starting at frame0 */
+  ulong    umem_own_sz;  /* Usable size of the net tile's own dcache (starts at frame0) */
 
   /* UMEM chunk region within workspace */
   uint     umem_chunk0; /* Lowest allowed chunk number */
@@ -183,6 +211,7 @@ typedef struct {
   /* Details pertaining to an inflight send op */
   struct {
     uint   xsk_idx;
+    uint   direct;            /* frame belongs to a direct TX link */
     void * frame;
     uchar  mac_addrs[12];     /* First 12 bytes of Ethernet header */
     uint   src_ip;            /* src_ip in net order */
@@ -213,7 +242,13 @@ typedef struct {
   ulong in_cnt;
   fd_net_in_ctx_t in[ MAX_NET_INS ];
 
-  fd_net_out_ctx_t quic_out[1];
+  /* Indexes of direct TX links in in[] */
+  ulong tx_direct_cnt;
+  uchar tx_direct_in[ MAX_NET_INS ];
+
+  /* RX lanes of QUIC tiles, selected by flow hash */
+  ulong            quic_out_cnt;
+  fd_net_out_ctx_t quic_out[ MAX_NET_RX_LANES ];
   fd_net_out_ctx_t shred_out[1];
   fd_net_out_ctx_t gossip_out[1];
   fd_net_out_ctx_t repair_out[1];
@@ -279,6 +314,7 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof(fd_net_ctx_t), sizeof(fd_net_ctx_t)                      );
   l = FD_LAYOUT_APPEND( l, alignof(ulong),        tile->xdp.free_ring_depth * sizeof(ulong) );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),        (tile->xdp.tx_direct_frame_cnt>>6) * sizeof(ulong) );
   l = FD_LAYOUT_APPEND( l, fd_netdev_tbl_align(), fd_netdev_tbl_footprint( NETDEV_MAX, BOND_MASTER_MAX ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
@@ -411,20 +447,60 @@ net_check_gre_interface_exists( fd_net_ctx_t * ctx ) {
 /* net_tx_ready returns 1 if the current XSK is ready to submit a TX send
    job.  If the XSK is blocked for sends, returns 0.  Reasons for block
    include:
-   - No XSK TX buffer is available
+   - No XSK TX buffer is available (unless direct, in which case the
+     packet already sits in a UMEM frame)
    - XSK TX ring is full */
 
 static int
 net_tx_ready( fd_net_ctx_t * ctx,
-              uint           xsk_idx ) {
+              uint           xsk_idx,
+              int            direct ) {
   fd_xsk_t *           xsk     = &ctx->xsk[ xsk_idx ];
   fd_xdp_ring_t *      tx_ring = &xsk->ring_tx;
   fd_net_free_ring_t * free    = &ctx->free_tx;
-  if( free->prod == free->cons ) return 0; /* drop */
+  if( !direct && free->prod == free->cons ) return 0; /* drop */
   if( tx_ring->prod - tx_ring->cons >= tx_ring->depth ) return 0; /* drop */
   return 1;
 }
 
+/* net_tx_direct_advance moves the tx_done cursor of a direct TX link
+   past all frags that were seen and whose frame is not owned by the
+   kernel. */
+
+static void
+net_tx_direct_advance( fd_net_in_ctx_t * in ) {
+  ulong seq_done = in->seq_done;
+  ulong seq_next = in->seq_next;
+  ulong mask     = in->depth - 1UL;
+  while( seq_done!=seq_next ) {
+    ulong idx = seq_done & mask;
+    if( in->busy[ idx>>6 ] & (1UL<<(idx&63UL)) ) break;
+    seq_done = fd_seq_inc( seq_done, 1UL );
+  }
+  if( seq_done!=in->seq_done ) {
+    in->seq_done = seq_done;
+    fd_fseq_update( in->tx_done, seq_done );
+  }
+}
+
+/* net_tx_direct_complete is called when the kernel releases the TX
+   frame at UMEM offset frame_off.  Returns 1 if the frame belongs to a
+   direct TX link, 0 otherwise. */
+
+static int
+net_tx_direct_complete( fd_net_ctx_t * ctx,
+                        ulong          frame_off ) {
+  for( ulong j=0UL; j<ctx->tx_direct_cnt; j++ ) {
+    fd_net_in_ctx_t * in  = &ctx->in[ ctx->tx_direct_in[ j ] ];
+    ulong             idx = ( frame_off - in->frame_off ) / FD_NET_MTU;
+    if( idx>=in->depth ) continue; /* also catches frame_off<in->frame_off */
+    in->busy[ idx>>6 ] &= ~(1UL<<(idx&63UL));
+    net_tx_direct_advance( in );
+    return 1;
+  }
+  return 0;
+}
+
 /* net_rx_wakeup triggers xsk_recvmsg to run in the kernel.  Needs to be
    called periodically in order to receive packets. */
 
@@ -636,7 +712,11 @@ before_frag( fd_net_ctx_t * ctx,
              ulong          in_idx,
              ulong          seq,
              ulong          sig ) {
-  (void)in_idx; (void)seq;
+
+  /* Every frag of a direct TX link is done once seen, unless its frame
+     gets submitted in after_frag below */
+  fd_net_in_ctx_t * in = &ctx->in[ in_idx ];
+  if( in->tx_done ) in->seq_next = fd_seq_inc( seq, 1UL );
 
   /* Find interface index of next packet */
   ulong proto = fd_disco_netmux_sig_proto( sig );
@@ -698,13 +778,24 @@ before_frag( fd_net_ctx_t * ctx,
 
   if( net_tile_id!=target_idx ) return 1; /* ignore */
 
+  /* Packets on direct TX links are sent from the frame they were
+     written to.  GRE encapsulation needs headroom in front of the
+     packet, so these packets are copied to a TX frame instead. */
+
+  int direct = !!in->tx_done & !ctx->tx_op.use_gre;
+  ctx->tx_op.direct = (uint)direct;
+
   /* Skip if TX is blocked */
 
-  if( FD_UNLIKELY( !net_tx_ready( ctx, xsk_idx ) ) ) {
+  if( FD_UNLIKELY( !net_tx_ready( ctx, xsk_idx, direct ) ) ) {
     ctx->metrics.tx_full_fail_cnt++;
     return 1;
   }
 
+  /* Frame is located in during_frag */
+
+  if( direct ) return 0;
+
   /* Allocate buffer for receive */
 
   fd_net_free_ring_t * free      = &ctx->free_tx;
@@ -737,6 +828,17 @@ during_frag( fd_net_ctx_t * ctx,
   if( FD_UNLIKELY( sz>FD_ETH_PAYLOAD_MAX ) )
     FD_LOG_ERR(( "packet too big %lu (in_idx=%lu)", sz, in_idx ));
 
+  if( ctx->tx_op.direct ) {
+    /* Packet is already in place (chunk0 and wmark bound the link's
+       frames).  Address it via the UMEM mapping of the link's frames. */
+    fd_net_in_ctx_t const * in  = &ctx->in[ in_idx ];
+    ulong                   off = ( chunk - in->chunk0 )<<FD_CHUNK_LG_SZ;
+    if( FD_UNLIKELY( off & (FD_NET_MTU-1UL) ) )
+      FD_LOG_ERR(( "chunk %lu is not at the start of a UMEM frame (in_idx=%lu)", chunk, in_idx ));
+    ctx->tx_op.frame = (uchar *)ctx->umem_frame0 + in->frame_off + off;
+    return;
+  }
+
   void * frame = ctx->tx_op.frame;
   if( FD_UNLIKELY( (ulong)frame < (ulong)ctx->umem_frame0 ) )
     FD_LOG_ERR(( "frame %p out of bounds (below %p)", frame, (void *)ctx->umem_frame0 ));
@@ -862,14 +964,20 @@ after_frag( fd_net_ctx_t *      ctx,
   fd_xdp_ring_t * tx_ring = &xsk->ring_tx;
   uint            tx_seq  = FD_VOLATILE_CONST( *tx_ring->prod );
   uint            tx_mask = tx_ring->depth - 1U;
+  ulong           tx_off  = (ulong)frame - (ulong)ctx->umem_frame0;
   xsk->ring_tx.packet_ring[ tx_seq&tx_mask ] = (struct xdp_desc) {
-    .addr    = (ulong)frame - (ulong)ctx->umem_frame0,
+    .addr    = tx_off,
     .len     = (uint)sz,
     .options = 0
   };
 
   /* Frame is now owned by kernel. Clear tx_op. */
   ctx->tx_op.frame = NULL;
+  if( ctx->tx_op.direct ) {
+    fd_net_in_ctx_t * in  = &ctx->in[ in_idx ];
+    ulong             idx = ( tx_off - in->frame_off ) / FD_NET_MTU;
+    in->busy[ idx>>6 ] |= 1UL<<(idx&63UL);
+  }
 
   /* Register newly enqueued packet */
   FD_VOLATILE( *xsk->ring_tx.prod ) = tx_ring->cached_prod = tx_seq+1U;
@@ -965,10 +1073,10 @@ net_rx_packet( fd_net_ctx_t * ctx,
     out = ctx->shred_out;
   } else if( FD_UNLIKELY( udp_dstport==ctx->quic_transaction_listen_port ) ) {
     proto = DST_PROTO_TPU_QUIC;
-    out = ctx->quic_out;
+    out = ctx->quic_out; /* lane selected below */
   } else if( FD_UNLIKELY( udp_dstport==ctx->legacy_transaction_listen_port ) ) {
     proto = DST_PROTO_TPU_UDP;
-    out = ctx->quic_out;
+    out = ctx->quic_out; /* lane selected below */
   } else if( FD_UNLIKELY( udp_dstport==ctx->gossip_listen_port ) ) {
     proto = DST_PROTO_GOSSIP;
     out = ctx->gossip_out;
@@ -1000,6 +1108,10 @@ net_rx_packet( fd_net_ctx_t * ctx,
   /* tile can decide how to partition based on src ip addr and src port */
   ulong sig              = fd_disco_netmux_sig( ip_srcaddr, udp_srcport, 0U, proto, 14UL+8UL+iplen );
 
+  /* Steer TPU flows to their QUIC tile's lane, which is the lane the
+     QUIC tile would have picked out of a shared link */
+  if( out==ctx->quic_out ) out += fd_disco_netmux_sig_hash( sig ) % ctx->quic_out_cnt;
+
   /* Peek the mline for an old frame */
   fd_frag_meta_t * mline = out->mcache + fd_mcache_line_idx( out->seq, out->depth );
   *freed_chunk           = mline->chunk;
@@ -1034,6 +1146,14 @@ net_comp_event( fd_net_ctx_t * ctx,
                  frame, (ulong)ctx->umem_sz ));
   }
 
+  /* Hand back frames of direct TX links to the producer */
+
+  if( FD_UNLIKELY( ctx->tx_direct_cnt ) && net_tx_direct_complete( ctx, frame & (~frame_mask) ) ) {
+    FD_VOLATILE( *comp_ring->cons ) = comp_ring->cached_cons = comp_seq+1U;
+    ctx->metrics.tx_complete_cnt++;
+    return;
+  }
+
   /* Check if we have space to return the freed frame */
 
   fd_net_free_ring_t * free      = &ctx->free_tx;
@@ -1121,13 +1241,21 @@ before_credit( fd_net_ctx_t *      ctx,
 
   if( ctx->tx_op.frame ) {
     *charge_busy = 1;
-    fd_net_free_ring_t * free      = &ctx->free_tx;
-    ulong                alloc_seq = free->prod;
-    free->queue[ alloc_seq % free->depth ] = (ulong)ctx->tx_op.frame;
-    free->prod = fd_seq_inc( alloc_seq, 1UL );
+    if( !ctx->tx_op.direct ) {
+      fd_net_free_ring_t * free      = &ctx->free_tx;
+      ulong                alloc_seq = free->prod;
+      free->queue[ alloc_seq % free->depth ] = (ulong)ctx->tx_op.frame;
+      free->prod = fd_seq_inc( alloc_seq, 1UL );
+    }
     ctx->tx_op.frame = NULL;
   }
 
+  /* Release frames of direct TX links that were not submitted */
+
+  for( ulong j=0UL; j<ctx->tx_direct_cnt; j++ ) {
+    net_tx_direct_advance( &ctx->in[ ctx->tx_direct_in[ j ] ] );
+  }
+
   /* Check if new packets are available or if TX frames are free again
      (Round-robin through sockets) */
 
@@ -1203,6 +1331,79 @@ interface_addrs( const char * interface,
     FD_LOG_ERR(( "could not close socket (%i-%s)", errno, fd_io_strerror( errno ) ));
 }
 
+/* fd_net_umem_region_t is a shared memory region that is part of the
+   UMEM.  shmem is the address of its regular join, alias the address
+   of its mapping in the UMEM range. */
+
+typedef struct {
+  fd_shmem_join_info_t info;
+  uchar *              alias;
+} fd_net_umem_region_t;
+
+static inline ulong
+net_umem_alias( fd_net_umem_region_t const * region,
+                ulong                        laddr ) {
+  return (ulong)region->alias + ( laddr - (ulong)region->info.shmem );
+}
+
+/* net_umem_map maps the given shmem regions back to back into a fresh
+   range of the address space, so they can be registered as a single
+   UMEM.  region[0] is the net tile's own workspace, the others are the
+   workspaces of direct TX links.  The UMEM needs to be contiguous, but
+   producers of direct TX links should not have access to the RX frames
+   in the net tile's workspace, so they cannot share a workspace.
+
+   Mappings need to be aligned to their page size.  region[0] is thus
+   placed such that it ends at a boundary of the largest page size, and
+   the other regions follow in order of decreasing page size, which
+   leaves no gaps.  Reorders region[1,region_cnt). */
+
+static void
+net_umem_map( fd_net_umem_region_t * region,
+              ulong                  region_cnt ) {
+  for( ulong i=2UL; i<region_cnt; i++ ) {
+    for( ulong j=i; j>1UL && region[ j-1UL ].info.page_sz<region[ j ].info.page_sz; j-- ) {
+      fd_net_umem_region_t tmp = region[ j ]; region[ j ] = region[ j-1UL ]; region[ j-1UL ] = tmp;
+    }
+  }
+
+  ulong page_max = 0UL;
+  ulong total_sz = 0UL;
+  for( ulong i=0UL; i<region_cnt; i++ ) {
+    page_max  = fd_ulong_max( page_max, region[ i ].info.page_sz );
+    total_sz += region[ i ].info.page_sz * region[ i ].info.page_cnt;
+  }
+  ulong own_sz  = region[ 0 ].info.page_sz * region[ 0 ].info.page_cnt;
+  ulong own_pad = fd_ulong_align_up( own_sz, page_max ) - own_sz;
+
+  /* Reserve the range, then replace it with the mappings */
+
+  void * reserve = mmap( NULL, total_sz+own_pad+page_max, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0 );
+  if( FD_UNLIKELY( reserve==MAP_FAILED ) ) {
+    FD_LOG_ERR(( "mmap(NULL,%lu KiB,PROT_NONE) failed (%i-%s)", (total_sz+own_pad+page_max)>>10, errno, fd_io_strerror( errno ) ));
+  }
+
+  ulong cursor = fd_ulong_align_up( (ulong)reserve, page_max ) + own_pad;
+  for( ulong i=0UL; i<region_cnt; i++ ) {
+    fd_shmem_join_info_t const * info = &region[ i ].info;
+    ulong sz = info->page_sz * info->page_cnt;
+    if( FD_UNLIKELY( !fd_ulong_is_aligned( cursor, info->page_sz ) ) ) FD_LOG_ERR(( "misaligned UMEM region %s", info->name ));
+
+    char path[ FD_SHMEM_PRIVATE_PATH_BUF_MAX ];
+    int fd = open( fd_shmem_private_path( info->name, info->page_sz, path ), O_RDWR, (mode_t)0 );
+    if( FD_UNLIKELY( fd==-1 ) ) FD_LOG_ERR(( "open(\"%s\",O_RDWR,0) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    void * alias = mmap( (void *)cursor, sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_FIXED, fd, (off_t)0 );
+    if( FD_UNLIKELY( alias==MAP_FAILED ) ) {
+      FD_LOG_ERR(( "mmap(%p,%lu KiB,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_FIXED,\"%s\",0) failed (%i-%s)",
+                   (void *)cursor, sz>>10, path, errno, fd_io_strerror( errno ) ));
+    }
+    if( FD_UNLIKELY( -1==close( fd ) ) ) FD_LOG_ERR(( "close(%d) failed (%d-%s)", fd, errno, fd_io_strerror( errno ) ));
+
+    region[ i ].alias = alias;
+    cursor += sz;
+  }
+}
+
 /* privileged_init does the following initialization steps:
 
    - Create an AF_XDP socket
@@ -1246,17 +1447,61 @@ privileged_init( fd_topo_t *      topo,
   ulong  const umem_dcache_data_sz = fd_dcache_data_sz( umem_dcache );
   ulong  const umem_frame_sz       = 2048UL;
 
+  /* Map the UMEM workspace and the workspaces of direct TX links next
+     to each other (see net_umem_map) */
+
+  fd_net_umem_region_t region[ 1UL+MAX_NET_INS ];
+  ulong                region_cnt = 1UL;
+  if( FD_UNLIKELY( fd_shmem_join_query_by_addr( dcache_mem, 1UL, &region[ 0 ].info ) ) ) {
+    FD_LOG_ERR(( "UMEM dcache is not in a shmem region" ));
+  }
+  if( FD_UNLIKELY( tile->in_cnt>MAX_NET_INS ) ) FD_LOG_ERR(( "net tile in link cnt %lu exceeds MAX_NET_INS %lu", tile->in_cnt, MAX_NET_INS ));
+  ulong direct_in[ MAX_NET_INS ];
+  ulong direct_cnt = 0UL;
+  for( ulong i=0UL; i<tile->in_cnt; i++ ) {
+    fd_topo_link_t const * link = &topo->links[ tile->in_link_id[ i ] ];
+    if( fd_pod_queryf_ulong( topo->props, ULONG_MAX, "net.%lu.tx_done.%lu", tile->kind_id, link->id )==ULONG_MAX ) continue;
+    void * link_dcache = fd_topo_obj_laddr( topo, link->dcache_obj_id );
+    if( FD_UNLIKELY( fd_shmem_join_query_by_addr( link_dcache, 1UL, &region[ region_cnt ].info ) ) ) {
+      FD_LOG_ERR(( "dcache of direct TX link %s is not in a shmem region", link->name ));
+    }
+    if( FD_UNLIKELY( region[ region_cnt ].info.shmem==region[ 0 ].info.shmem ) ) {
+      FD_LOG_ERR(( "direct TX link %s is in the UMEM workspace", link->name ));
+    }
+    region_cnt++;
+    direct_in[ direct_cnt++ ] = i;
+  }
+  net_umem_map( region, region_cnt );
+
   /* Left shrink UMEM region to be 4096 byte aligned */
 
-  void * const umem_frame0 = (void *)fd_ulong_align_up( (ulong)umem_dcache, 4096UL );
-  ulong        umem_sz     = umem_dcache_data_sz - ((ulong)umem_frame0 - (ulong)umem_dcache);
-  umem_sz = fd_ulong_align_dn( umem_sz, umem_frame_sz );
+  ulong const own_lo     = fd_ulong_align_up( (ulong)umem_dcache, 4096UL );
+  ulong const own_frame0 = net_umem_alias( &region[ 0 ], own_lo );
+  ulong       own_sz     = umem_dcache_data_sz - (own_lo - (ulong)umem_dcache);
+  own_sz = fd_ulong_align_dn( own_sz, umem_frame_sz );
+
+  /* Extend UMEM region to cover the frames of direct TX links.  These
+     are mapped after the net tile's own workspace. */
+
+  ulong umem_hi = own_frame0 + own_sz;
+  for( ulong j=0UL; j<direct_cnt; j++ ) {
+    fd_topo_link_t const * link = &topo->links[ tile->in_link_id[ direct_in[ j ] ] ];
+    ulong frame0 = fd_net_tx_direct_frame0( fd_topo_obj_laddr( topo, link->dcache_obj_id ) );
+    for( ulong i=1UL; i<region_cnt; i++ ) {
+      ulong lo = (ulong)region[ i ].info.shmem;
+      if( frame0<lo || frame0>=lo+region[ i ].info.page_sz*region[ i ].info.page_cnt ) continue;
+      ctx->in[ direct_in[ j ] ].frame_off = net_umem_alias( &region[ i ], frame0 ) - own_frame0;
+      umem_hi = fd_ulong_max( umem_hi, net_umem_alias( &region[ i ], frame0 ) + link->depth*umem_frame_sz );
+    }
+  }
 
-  /* Derive chunk bounds */
+  void * const umem_frame0 = (void *)own_frame0;
+  ulong  const umem_sz     = fd_ulong_align_dn( umem_hi-own_frame0, umem_frame_sz );
 
+  /* Derive chunk bounds of the net tile's own frames */
   void * const umem_base   = fd_wksp_containing( dcache_mem );
-  ulong  const umem_chunk0 = ( (ulong)umem_frame0 - (ulong)umem_base )>>FD_CHUNK_LG_SZ;
-  ulong  const umem_wmark  = umem_chunk0 + ( ( umem_sz-umem_frame_sz )>>FD_CHUNK_LG_SZ );
+  ulong  const umem_chunk0 = ( own_lo - (ulong)umem_base )>>FD_CHUNK_LG_SZ;
+  ulong  const umem_wmark  = umem_chunk0 + ( ( own_sz-umem_frame_sz )>>FD_CHUNK_LG_SZ );
 
   if( FD_UNLIKELY( umem_chunk0>UINT_MAX || umem_wmark>UINT_MAX || umem_chunk0>umem_wmark ) ) {
     FD_LOG_ERR(( "Calculated invalid UMEM bounds [%lu,%lu]", umem_chunk0, umem_wmark ));
@@ -1265,10 +1510,11 @@ privileged_init( fd_topo_t *      topo,
   if( FD_UNLIKELY( !umem_base   ) ) FD_LOG_ERR(( "UMEM dcache is not in a workspace" ));
   if( FD_UNLIKELY( !umem_dcache ) ) FD_LOG_ERR(( "Failed to join UMEM dcache" ));
 
-  ctx->umem_frame0 = umem_frame0;
-  ctx->umem_sz     = umem_sz;
-  ctx->umem_chunk0 = (uint)umem_chunk0;
-  ctx->umem_wmark  = (uint)umem_wmark;
+  ctx->umem_frame0  = umem_frame0;
+  ctx->umem_sz      = umem_sz;
+  ctx->umem_own_sz  = own_sz;
+  ctx->umem_chunk0  = (uint)umem_chunk0;
+  ctx->umem_wmark   = (uint)umem_wmark;
 
   ctx->free_tx.queue = free_tx;
   ctx->free_tx.depth = tile->xdp.xdp_tx_queue_size;
@@ -1362,6 +1608,7 @@ unprivileged_init( fd_topo_t *      topo,
   FD_TEST( ctx->xsk_cnt!=0 );
   FD_TEST( ctx->free_tx.queue!=NULL );
   (void)FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong), tile->xdp.free_ring_depth * sizeof(ulong) );
+  ulong * tx_direct_busy       = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong), (tile->xdp.tx_direct_frame_cnt>>6) * sizeof(ulong) );
   ctx->netdev_buf              = FD_SCRATCH_ALLOC_APPEND( l, fd_netdev_tbl_align(), ctx->netdev_buf_sz );
 
   ctx->net_tile_id  = (uint)tile->kind_id;
@@ -1389,16 +1636,41 @@ unprivileged_init( fd_topo_t *      topo,
     ctx->in[ i ].mem    = topo->workspaces[ topo->objs[ link->dcache_obj_id ].wksp_id ].wksp;
     ctx->in[ i ].chunk0 = fd_dcache_compact_chunk0( ctx->in[ i ].mem, link->dcache );
     ctx->in[ i ].wmark  = fd_dcache_compact_wmark( ctx->in[ i ].mem, link->dcache, link->mtu );
+
+    ulong tx_done_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "net.%lu.tx_done.%lu", tile->kind_id, link->id );
+    if( tx_done_obj_id==ULONG_MAX ) continue;
+
+    /* Direct TX link: only accept frags that point to the start of a
+       frame, and publish the initial tx_done seq to unblock the
+       producer. */
+
+    fd_net_in_ctx_t * in = &ctx->in[ i ];
+    in->tx_done   = fd_fseq_join( fd_topo_obj_laddr( topo, tx_done_obj_id ) );
+    if( FD_UNLIKELY( !in->tx_done ) ) FD_LOG_ERR(( "Failed to join tx_done fseq of direct TX link %s", link->name ));
+    in->depth     = link->depth;
+    in->chunk0    = fd_laddr_to_chunk( in->mem, (void const *)fd_net_tx_direct_frame0( link->dcache ) );
+    in->wmark     = in->chunk0 + ( (in->depth-1UL) * (FD_NET_MTU>>FD_CHUNK_LG_SZ) );
+    in->busy      = tx_direct_busy;
+    tx_direct_busy += fd_ulong_align_up( in->depth, 64UL )>>6;
+    fd_memset( in->busy, 0, (fd_ulong_align_up( in->depth, 64UL )>>6)*sizeof(ulong) );
+    if( FD_UNLIKELY( !fd_ulong_is_pow2( in->depth ) || in->frame_off+in->depth*FD_NET_MTU > ctx->umem_sz ) ) {
+      FD_LOG_ERR(( "direct TX link %s is not within UMEM", link->name ));
+    }
+    in->seq_next  = fd_mcache_seq_query( fd_mcache_seq_laddr_const( link->mcache ) );
+    in->seq_done  = in->seq_next;
+    fd_fseq_update( in->tx_done, in->seq_done );
+    ctx->tx_direct_in[ ctx->tx_direct_cnt++ ] = (uchar)i;
   }
 
   for( ulong i = 0; i < tile->out_cnt; i++ ) {
     fd_topo_link_t * out_link = &topo->links[ tile->out_link_id[ i  ] ];
     if( strcmp( out_link->name, "net_quic" ) == 0 ) {
-      fd_topo_link_t * quic_out = out_link;
-      ctx->quic_out->mcache = quic_out->mcache;
-      ctx->quic_out->sync   = fd_mcache_seq_laddr( ctx->quic_out->mcache );
-      ctx->quic_out->depth  = fd_mcache_depth( ctx->quic_out->mcache );
-      ctx->quic_out->seq    = fd_mcache_seq_query( ctx->quic_out->sync );
+      if( FD_UNLIKELY( ctx->quic_out_cnt>=MAX_NET_RX_LANES ) ) FD_LOG_ERR(( "net tile has more than %lu net_quic lanes", MAX_NET_RX_LANES ));
+      fd_net_out_ctx_t * quic_out = &ctx->quic_out[ ctx->quic_out_cnt++ ];
+      quic_out->mcache = out_link->mcache;
+      quic_out->sync   = fd_mcache_seq_laddr( quic_out->mcache );
+      quic_out->depth  = fd_mcache_depth( quic_out->mcache );
+      quic_out->seq    = fd_mcache_seq_query( quic_out->sync );
     } else if( strcmp( out_link->name, "net_shred" ) == 0 ) {
       fd_topo_link_t * shred_out = out_link;
       ctx->shred_out->mcache = shred_out->mcache;
@@ -1511,7 +1783,7 @@ unprivileged_init( fd_topo_t *      topo,
     net_tx_wakeup( ctx, &ctx->xsk[ j ], &_charge_busy );
   }
 
-  if( FD_UNLIKELY( frame_off > ctx->umem_sz ) ) {
+  if( FD_UNLIKELY( frame_off > ctx->umem_own_sz ) ) {
     FD_LOG_ERR(( "UMEM is too small" ));
   }
 }
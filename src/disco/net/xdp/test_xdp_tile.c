@@ -1,7 +1,7 @@
+#include "fd_xdp_tile.c"
 #include <linux/if_arp.h>
 #include <linux/if_link.h>
 #include <stdlib.h>
-#include "fd_xdp_tile.c"
 #include "../../../disco/topo/fd_topob.h"
 #include "../../../waltz/neigh/fd_neigh4_map.h"
 #include "../../../util/net/fd_ip4.h"
@@ -830,6 +830,97 @@ main( int     argc,
     tx_chunk = fd_dcache_compact_next( tx_chunk, during_frag_expected_sz, tx_chunk0, tx_wmark );
   }
 
+  /* Direct TX link: the producer writes packets into UMEM frames, the
+     net tile submits them in place and publishes tx_done once a frame
+     is handed back by the kernel or a frag is ignored. */
+
+  ulong const direct_depth = 16UL;
+  static uchar tx_done_mem[ FD_FSEQ_FOOTPRINT ] __attribute__((aligned(FD_FSEQ_ALIGN)));
+  ulong direct_busy[ 1 ] = {0UL};
+
+  fd_net_in_ctx_t * in = &ctx->in[ 0 ];
+  in->tx_done   = fd_fseq_join( fd_fseq_new( tx_done_mem, 0UL ) );
+  in->depth     = direct_depth;
+  in->frame_off = ctx->umem_sz - direct_depth*frame_sz;
+  in->mem       = umem_base;
+  in->chunk0    = fd_laddr_to_chunk( umem_base, (uchar *)ctx->umem_frame0 + in->frame_off );
+  in->wmark     = in->chunk0 + (direct_depth-1UL)*(frame_sz>>FD_CHUNK_LG_SZ);
+  in->busy      = direct_busy;
+  in->seq_next  = 0UL;
+  in->seq_done  = 0UL;
+  ctx->tx_direct_in[ 0 ] = 0;
+  ctx->tx_direct_cnt     = 1UL;
+  FD_TEST( in->tx_done );
+
+  fd_net_tx_direct_t direct[1] = {{
+    .chunk0   = in->chunk0,
+    .depth    = direct_depth,
+    .done_min = fd_seq_dec( 0UL, direct_depth ),
+    .net_cnt  = 1UL,
+    .tx_done  = { in->tx_done }
+  }};
+
+  xsk->if_idx = IF_IDX_ETH1;
+  ulong const direct_sz = sizeof(tx_pkt_before_during_frag);
+  ulong const out_sig   = fd_disco_netmux_sig( 0, SHRED_PORT, random_ip, DST_PROTO_OUTGOING, direct_sz );
+  ulong const skip_sig  = fd_disco_netmux_sig( 0, SHRED_PORT, random_ip, DST_PROTO_SHRED,    direct_sz );
+  ulong       held_off  = ULONG_MAX;
+  for( ulong seq=0UL; seq<2UL*direct_depth; seq++ ) {
+    ulong done = fd_fseq_query( in->tx_done );
+    if( !fd_net_tx_direct_ready( direct, seq ) ) {
+      /* Frame of seq-depth is still owned by the kernel */
+      FD_TEST( seq==done+direct_depth && held_off!=ULONG_MAX );
+      xsk->ring_cr.frame_ring[ xdp_cr_ring_prod&(xsk_rings_depth-1U) ] = held_off;
+      xdp_cr_ring_prod++;
+      net_comp_event( ctx, xsk, xdp_cr_ring_cons );
+      FD_TEST( fd_fseq_query( in->tx_done )==seq );
+      FD_TEST( fd_net_tx_direct_ready( direct, seq ) );
+      held_off = ULONG_MAX;
+    }
+
+    ulong   chunk = fd_net_tx_direct_chunk( direct, seq );
+    uchar * frame = fd_chunk_to_laddr( umem_base, chunk );
+    fd_memcpy( frame, &tx_pkt_before_during_frag, direct_sz );
+
+    if( seq&1UL ) {
+      /* Frags not meant for TX are done right away */
+      FD_TEST( before_frag( ctx, 0, seq, skip_sig )==1 );
+      net_tx_direct_advance( in );
+      FD_TEST( fd_fseq_query( in->tx_done )==fd_ulong_if( held_off==ULONG_MAX, seq+1UL, done ) );
+      continue;
+    }
+
+    FD_TEST( before_frag( ctx, 0, seq, out_sig )==0 );
+    FD_TEST( ctx->tx_op.direct );
+    during_frag( ctx, 0, seq, out_sig, chunk, direct_sz, 0 );
+    FD_TEST( ctx->tx_op.frame==frame );
+    after_frag( ctx, 0, seq, out_sig, direct_sz, 0, 0, NULL );
+    struct xdp_desc * tx_ring_entry = &xsk->ring_tx.packet_ring[ (xdp_tx_ring_prod-1)&(xsk_rings_depth-1U) ];
+    FD_TEST( tx_ring_entry->addr==(ulong)frame-(ulong)ctx->umem_frame0 );
+    FD_TEST( tx_ring_entry->len==sizeof(tx_pkt_after_frag) );
+    FD_TEST( fd_memeq( frame, &tx_pkt_after_frag, sizeof(tx_pkt_after_frag) ) );
+
+    /* Frame stays owned by the kernel until completion.  Complete all
+       but the first submitted frame immediately. */
+    net_tx_direct_advance( in );
+    FD_TEST( fd_fseq_query( in->tx_done )==fd_ulong_if( held_off==ULONG_MAX, seq, done ) );
+    if( held_off==ULONG_MAX ) {
+      held_off = tx_ring_entry->addr;
+    } else {
+      xsk->ring_cr.frame_ring[ xdp_cr_ring_prod&(xsk_rings_depth-1U) ] = tx_ring_entry->addr;
+      xdp_cr_ring_prod++;
+      net_comp_event( ctx, xsk, xdp_cr_ring_cons );
+      FD_TEST( fd_fseq_query( in->tx_done )==done );
+    }
+  }
+
+  /* GRE routes fall back to copying into a TX frame */
+  tx_pkt_before_frag_gre.inner_ip4.daddr = gre1_dst_ip;
+  ulong gre_sig = fd_disco_netmux_sig( 0, SHRED_PORT, gre1_dst_ip, DST_PROTO_OUTGOING, sizeof(tx_pkt_before_frag_gre) );
+  FD_TEST( before_frag( ctx, 0, 2UL*direct_depth, gre_sig )==0 );
+  FD_TEST( !ctx->tx_op.direct && ctx->tx_op.frame );
+  FD_TEST( (ulong)ctx->tx_op.frame-(ulong)ctx->umem_frame0 < in->frame_off );
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
 }
@@ -178,14 +178,17 @@ before_frag( fd_quic_ctx_t * ctx,
              ulong           in_idx,
              ulong           seq,
              ulong           sig ) {
-  (void)in_idx;
   (void)seq;
 
   ulong proto = fd_disco_netmux_sig_proto( sig );
   if( FD_UNLIKELY( proto!=DST_PROTO_TPU_UDP && proto!=DST_PROTO_TPU_QUIC ) ) return 1;
 
-  ulong hash = fd_disco_netmux_sig_hash( sig );
-  if( FD_UNLIKELY( (hash % ctx->round_robin_cnt) != ctx->round_robin_id ) ) return 1;
+  /* Net tiles steer flows to per-QUIC tile lanes where possible (see
+     fd_topos_net_rx_lanes).  Shared links are filtered by flow hash. */
+  if( FD_UNLIKELY( ctx->net_in_shared[ in_idx ] ) ) {
+    ulong hash = fd_disco_netmux_sig_hash( sig );
+    if( FD_UNLIKELY( (hash % ctx->round_robin_cnt) != ctx->round_robin_id ) ) return 1;
+  }
 
   return 0;
 }
@@ -537,6 +540,7 @@ unprivileged_init( fd_topo_t *      topo,
       FD_LOG_ERR(( "unexpected input link %s", link->name ));
     }
     fd_net_rx_bounds_init( &ctx->net_in_bounds[ i ], link->dcache );
+    ctx->net_in_shared[ i ] = (uchar)( fd_topo_link_consumer_cnt( topo, link )>1UL );
   }
 
   if( FD_UNLIKELY( getrandom( ctx->tls_priv_key, ED25519_PRIV_KEY_SZ, 0 )!=ED25519_PRIV_KEY_SZ ) ) {
@@ -565,12 +569,16 @@ unprivileged_init( fd_topo_t *      topo,
   if( FD_UNLIKELY( tile->quic.ack_delay_millis >= tile->quic.idle_timeout_millis ) ) {
     FD_LOG_ERR(( "Invalid `ack_delay_millis`: must be lower than `idle_timeout_millis`" ));
   }
+  if( FD_UNLIKELY( tile->quic.session_ticket_ttl_seconds > FD_TLS_TICKET_LIFETIME_MAX ) ) {
+    FD_LOG_ERR(( "Invalid `session_ticket_ttl_seconds`: must be at most %u (7 days)", FD_TLS_TICKET_LIFETIME_MAX ));
+  }
 
   quic->config.role                       = FD_QUIC_ROLE_SERVER;
   quic->config.idle_timeout               = tile->quic.idle_timeout_millis * (ulong)1e6;
   quic->config.ack_delay                  = tile->quic.ack_delay_millis * (ulong)1e6;
   quic->config.initial_rx_max_stream_data = FD_TXN_MTU;
   quic->config.retry                      = tile->quic.retry;
+  quic->config.session_ticket_ttl         = tile->quic.session_ticket_ttl_seconds * (ulong)1e9;
   fd_memcpy( quic->config.identity_public_key, ctx->tls_pub_key, ED25519_PUB_KEY_SZ );
 
   quic->config.sign         = quic_tls_cv_sign;
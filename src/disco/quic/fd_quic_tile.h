@@ -32,6 +32,7 @@ typedef struct {
   ulong round_robin_id;
 
   fd_net_rx_bounds_t net_in_bounds[ FD_QUIC_TILE_IN_MAX ];
+  uchar              net_in_shared[ FD_QUIC_TILE_IN_MAX ]; /* link also read by other QUIC tiles */
 
   fd_wksp_t * net_out_mem;
   ulong       net_out_chunk0;
@@ -190,6 +190,11 @@ typedef struct {
   ulong       net_out_wmark;
   ulong       net_out_chunk;
 
+  /* If the net link is a direct TX link, packets are written straight
+     into XDP frames, net_out_chunk is unused */
+  fd_net_tx_direct_t * net_out_direct;
+  fd_net_tx_direct_t   net_out_direct_[1];
+
   ulong       store_out_idx;
   fd_wksp_t * store_out_mem;
   ulong       store_out_chunk0;
@@ -214,6 +219,7 @@ typedef struct {
     ulong shred_processing_result[ FD_FEC_RESOLVER_ADD_SHRED_RETVAL_CNT+FD_SHRED_ADD_SHRED_EXTRA_RETVAL_CNT ];
     ulong invalid_block_id_cnt;
     ulong shred_rejected_unchained_cnt;
+    ulong net_tx_direct_full_cnt;
   } metrics[ 1 ];
 
   struct {
@@ -285,6 +291,7 @@ metrics_write( fd_shred_ctx_t * ctx ) {
 
   FD_MCNT_SET  ( SHRED, INVALID_BLOCK_ID,           ctx->metrics->invalid_block_id_cnt         );
   FD_MCNT_SET  ( SHRED, SHRED_REJECTED_UNCHAINED,   ctx->metrics->shred_rejected_unchained_cnt );
+  FD_MCNT_SET  ( SHRED, NET_TX_DIRECT_FULL,         ctx->metrics->net_tx_direct_full_cnt       );
 
   FD_MCNT_ENUM_COPY( SHRED, SHRED_PROCESSED, ctx->metrics->shred_processing_result             );
 }
@@ -625,7 +632,17 @@ send_shred( fd_shred_ctx_t                 * ctx,
 
   if( FD_UNLIKELY( !dest->ip4 ) ) return;
 
-  uchar * packet = fd_chunk_to_laddr( ctx->net_out_mem, ctx->net_out_chunk );
+  ulong chunk = ctx->net_out_chunk;
+  if( ctx->net_out_direct ) {
+    ulong seq = stem->seqs[ NET_OUT_IDX ];
+    if( FD_UNLIKELY( !fd_net_tx_direct_ready( ctx->net_out_direct, seq ) ) ) {
+      ctx->metrics->net_tx_direct_full_cnt++;
+      return;
+    }
+    chunk = fd_net_tx_direct_chunk( ctx->net_out_direct, seq );
+  }
+
+  uchar * packet = fd_chunk_to_laddr( ctx->net_out_mem, chunk );
 
   int is_data = fd_shred_is_data( fd_shred_type( shred->variant ) );
   fd_ip4_udp_hdrs_t * hdr  = (fd_ip4_udp_hdrs_t *)packet;
@@ -672,9 +689,10 @@ send_shred( fd_shred_ctx_t                 * ctx,
   ulong pkt_sz = shred_sz + sizeof(fd_ip4_udp_hdrs_t);
   ulong tspub  = fd_frag_meta_ts_comp( fd_tickcount() );
   ulong sig    = fd_disco_netmux_sig( dest->ip4, dest->port, dest->ip4, DST_PROTO_OUTGOING, sizeof(fd_ip4_udp_hdrs_t) );
-  ulong const chunk = ctx->net_out_chunk;
   fd_stem_publish( stem, NET_OUT_IDX, sig, chunk, pkt_sz, 0UL, tsorig, tspub );
-  ctx->net_out_chunk = fd_dcache_compact_next( chunk, pkt_sz, ctx->net_out_chunk0, ctx->net_out_wmark );
+  if( !ctx->net_out_direct ) {
+    ctx->net_out_chunk = fd_dcache_compact_next( chunk, pkt_sz, ctx->net_out_chunk0, ctx->net_out_wmark );
+  }
 }
 
 static void
@@ -1194,6 +1212,7 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->net_out_mem    = topo->workspaces[ topo->objs[ net_out->dcache_obj_id ].wksp_id ].wksp;
   ctx->net_out_wmark  = fd_dcache_compact_wmark ( ctx->net_out_mem, net_out->dcache, net_out->mtu );
   ctx->net_out_chunk  = ctx->net_out_chunk0;
+  ctx->net_out_direct = fd_net_tx_direct_join( ctx->net_out_direct_, topo, net_out->id );
 
   ctx->blockstore = NULL;
   ulong blockstore_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "blockstore" );
@@ -1244,6 +1263,7 @@ unprivileged_init( fd_topo_t *      topo,
   memset( ctx->metrics->shred_processing_result, '\0', sizeof(ctx->metrics->shred_processing_result) );
   ctx->metrics->invalid_block_id_cnt = 0UL;
   ctx->metrics->shred_rejected_unchained_cnt = 0UL;
+  ctx->metrics->net_tx_direct_full_cnt = 0UL;
 
   ctx->pending_batch.microblock_cnt = 0UL;
   ctx->pending_batch.txn_cnt        = 0UL;
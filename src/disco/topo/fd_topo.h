@@ -171,6 +171,8 @@ struct fd_topo_tile {
       char   xdp_mode[8];
       int    zero_copy;
 
+      ulong  tx_direct_frame_cnt;  /* Frames of direct TX in links (see fd_net_tx_direct_t), multiple of 64 */
+
       ulong netdev_dbl_buf_obj_id; /* dbl_buf containing netdev_tbl */
       ulong fib4_main_obj_id;      /* fib4 containing main route table */
       ulong fib4_local_obj_id;     /* fib4 containing local route table */
@@ -203,6 +205,7 @@ struct fd_topo_tile {
       ulong  idle_timeout_millis;
       uint   ack_delay_millis;
       int    retry;
+      ulong  session_ticket_ttl_seconds;
       char   key_log_path[ PATH_MAX ];
     } quic;
 
@@ -299,6 +302,10 @@ struct fd_topo_tile {
     struct {
       uint   prometheus_listen_addr;
       ushort prometheus_listen_port;
+
+      char   recorder_path[ PATH_MAX ];
+      long   recorder_interval_ns;
+      ulong  recorder_file_sz;
     } metric;
 
     struct {
@@ -334,6 +341,7 @@ struct fd_topo_tile {
 
       ulong capture_start_slot;
       char  solcap_capture[ PATH_MAX ];
+      ulong solcap_ring_obj_id; /* ULONG_MAX if solcap is written synchronously */
       char  dump_proto_dir[ PATH_MAX ];
       int   dump_block_to_pb;
 
@@ -436,8 +444,14 @@ struct fd_topo_tile {
       uint    txn_index_max;
       uint    acct_index_max;
       char    history_file[ PATH_MAX ];
+      ulong   sim_timeout_millis;
     } rpcserv;
 
+    struct {
+      ulong funk_obj_id;
+      ulong cu_max;
+    } rpcsim;
+
     struct {
       uint fake_dst_ip;
     } pktgen;
@@ -448,6 +462,7 @@ struct fd_topo_tile {
       char  shredcap_path[ PATH_MAX ];
       char  bank_hash_path[ PATH_MAX ];
       char  ingest_mode[ 32 ];
+      ulong solcap_ring_obj_id; /* ULONG_MAX if there is no solcap tile */
 
       /* Set internally by the archiver tile */
       int archive_fd;
@@ -464,14 +479,18 @@ struct fd_topo_tile {
       ulong   write_buffer_size; /* Size of the write buffer for the capture tile */
 
       /* Set internally by the capture tile */
-      int shreds_fd;
-      int requests_fd;
-      int fecs_fd;
-      int peers_fd;
-      int bank_hashes_fd;
-      int slices_fd;
+      int capture_fd;
+      int index_fd;
     } shredcap;
 
+    struct {
+      char  path[ PATH_MAX ];
+      ulong ring_obj_id;
+
+      /* Set internally by the solcap tile */
+      int fd;
+    } solcap;
+
     struct {
       char  snapshots_path[ PATH_MAX ];
       char  cluster[ 8UL ];
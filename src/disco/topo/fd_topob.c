@@ -374,6 +374,7 @@ fd_topob_auto_layout( fd_topo_t * topo,
     "send",   /* FIREDANCER only */
     "tower",  /* FIREDANCER only */
     "rpcsrv", /* FIREDANCER only */
+    "rpcsim", /* FIREDANCER only */
     "pktgen",
     "snaprd", /* FIREDANCER only */
     "snapdc", /* FIREDANCER only */
@@ -5,6 +5,7 @@
 
 #include "../../util/pod/fd_pod_format.h"
 #include "../../flamenco/runtime/fd_rocksdb.h"
+#include "../../flamenco/capture/fd_solcap_ring.h"
 #include "../../discof/replay/fd_replay_notif.h"
 #include "../../discof/fd_discof.h"
 #include <errno.h>
@@ -17,6 +18,8 @@
 #define FD_BACKTEST_ROCKSDB_INGEST  (0UL)
 #define FD_BACKTEST_SHREDCAP_INGEST (1UL)
 
+#define FD_BACKTEST_SOLCAP_HALT_TIMEOUT_NS (30L*1000L*1000L*1000L)
+
 /* TODO: this should be bounded to the max number of unrooted banks
    that the client can support. Currently there is no bound, so 2048
    is a relatively reasonable bound. */
@@ -94,6 +97,8 @@ typedef struct {
   ulong                  slot_cnt;
 
   fd_tower_t *           tower;
+
+  fd_solcap_ring_t *     solcap_ring; /* NULL if solcap is written synchronously */
 } ctx_t;
 
 FD_FN_PURE static inline ulong
@@ -205,6 +210,12 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->replay_in_chunk0           = fd_dcache_compact_chunk0( ctx->replay_in_mem, replay_in_link->dcache );
   ctx->replay_in_wmark            = fd_dcache_compact_wmark( ctx->replay_in_mem, replay_in_link->dcache, replay_in_link->mtu );
 
+  ctx->solcap_ring = NULL;
+  if( tile->archiver.solcap_ring_obj_id!=ULONG_MAX ) {
+    ctx->solcap_ring = fd_solcap_ring_join( fd_topo_obj_laddr( topo, tile->archiver.solcap_ring_obj_id ) );
+    if( FD_UNLIKELY( !ctx->solcap_ring ) ) FD_LOG_ERR(( "failed to join solcap ring" ));
+  }
+
   ctx->tower_replay_out_idx = fd_topo_find_tile_out_link( topo, tile, "tower_replay", 0 );
   FD_TEST( ctx->tower_replay_out_idx!= ULONG_MAX );
 
@@ -615,6 +626,7 @@ after_frag( ctx_t *             ctx,
             ctx->slot_cnt,
             replay_time_s,
             sec_per_slot ));
+      if( ctx->solcap_ring ) fd_solcap_ring_halt( ctx->solcap_ring, FD_BACKTEST_SOLCAP_HALT_TIMEOUT_NS );
       FD_LOG_ERR(( "Backtest playback done." ));
     }
   }
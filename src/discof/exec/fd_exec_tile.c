@@ -7,6 +7,7 @@
 #include "../../flamenco/runtime/fd_runtime_public.h"
 #include "../../flamenco/runtime/fd_executor.h"
 #include "../../flamenco/runtime/fd_hashes.h"
+#include "../../flamenco/runtime/program/fd_bpf_program_util.h"
 
 #include "../../funk/fd_funk.h"
 
@@ -260,6 +261,39 @@ snap_hash_gather( fd_exec_tile_ctx_t *                ctx,
                                       pairs, &ctx->runtime_public->features );
 }
 
+static void
+bpf_prewarm( fd_exec_tile_ctx_t *                  ctx,
+             fd_runtime_public_bpf_prewarm_msg_t * msg ) {
+
+  ctx->slot = msg->slot;
+  fd_funk_txn_map_t * txn_map = fd_funk_txn_map( ctx->funk );
+  if( FD_UNLIKELY( !txn_map->map ) ) {
+    FD_LOG_ERR(( "Could not find valid funk transaction map" ));
+  }
+  fd_funk_txn_start_read( ctx->funk );
+  fd_funk_txn_t * funk_txn = fd_funk_txn_query( &msg->xid, txn_map );
+  if( FD_UNLIKELY( !funk_txn ) ) {
+    FD_LOG_ERR(( "Could not find valid funk transaction" ));
+  }
+  fd_funk_txn_end_read( ctx->funk );
+
+  fd_banks_lock( ctx->banks );
+
+  /* Prewarming happens before any block is replayed, so the root bank
+     is the bank of the snapshot. */
+  fd_exec_slot_ctx_t slot_ctx = {
+    .magic    = FD_EXEC_SLOT_CTX_MAGIC,
+    .banks    = ctx->banks,
+    .bank     = (fd_bank_t *)fd_banks_root( ctx->banks ),
+    .funk     = ctx->funk,
+    .funk_txn = funk_txn
+  };
+  ulong cnt = fd_bpf_prewarm_range( &slot_ctx, msg->worker_idx, msg->worker_cnt, ctx->exec_spad, msg->deadline );
+  FD_LOG_DEBUG(( "prewarmed %lu programs", cnt ));
+
+  fd_banks_unlock( ctx->banks );
+}
+
 static void
 during_frag( fd_exec_tile_ctx_t * ctx,
              ulong                in_idx,
@@ -296,6 +330,10 @@ during_frag( fd_exec_tile_ctx_t * ctx,
       fd_runtime_public_snap_hash_msg_t * msg = fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
       FD_LOG_DEBUG(( "snap hash gather msg recvd" ));
       snap_hash_gather( ctx, msg );
+    } else if( sig==EXEC_BPF_PREWARM_SIG ) {
+      fd_runtime_public_bpf_prewarm_msg_t * msg = fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
+      FD_LOG_DEBUG(( "bpf prewarm msg recvd" ));
+      bpf_prewarm( ctx, msg );
     } else {
       FD_LOG_ERR(( "Unknown signature" ));
     }
@@ -351,6 +389,9 @@ after_frag( fd_exec_tile_ctx_t * ctx,
   } else if( sig==EXEC_SNAP_HASH_ACCS_GATHER_SIG ) {
     FD_LOG_NOTICE(("Sending ack for snap hash gather msg" ));
     fd_fseq_update( ctx->exec_fseq, fd_exec_fseq_set_snap_hash_gather_done() );
+  } else if( sig==EXEC_BPF_PREWARM_SIG ) {
+    FD_LOG_DEBUG(( "Sending ack for bpf prewarm msg" ));
+    fd_fseq_update( ctx->exec_fseq, fd_exec_fseq_set_bpf_prewarm_done( ctx->slot ) );
   } else {
     FD_LOG_ERR(( "Unknown message signature" ));
   }
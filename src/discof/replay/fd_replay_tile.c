@@ -13,6 +13,7 @@
 #include "../../flamenco/runtime/fd_runtime_init.h"
 #include "../../flamenco/runtime/fd_runtime.h"
 #include "../../flamenco/runtime/fd_runtime_public.h"
+#include "../../flamenco/runtime/program/fd_bpf_program_util.h"
 #include "../../flamenco/rewards/fd_rewards.h"
 #include "../../disco/metrics/fd_metrics.h"
 #include "../../choreo/fd_choreo.h"
@@ -404,6 +405,70 @@ block_finalize_tiles_cb( void * para_arg_1,
   }
 }
 
+static void
+bpf_prewarm_tiles_cb( void * para_arg_1,
+                      void * para_arg_2,
+                      void * fn_arg_1,
+                      void * fn_arg_2,
+                      void * fn_arg_3 FD_PARAM_UNUSED,
+                      void * fn_arg_4 FD_PARAM_UNUSED ) {
+
+  fd_replay_tile_ctx_t * ctx      = (fd_replay_tile_ctx_t *)para_arg_1;
+  fd_stem_context_t *    stem     = (fd_stem_context_t *)para_arg_2;
+  fd_exec_slot_ctx_t *   slot_ctx = (fd_exec_slot_ctx_t *)fn_arg_1;
+  long                   deadline = *(long const *)fn_arg_2;
+
+  ulong slot = fd_bank_slot_get( slot_ctx->bank );
+
+  /* Every exec tile finds and prewarms the programs in its own range of
+     the record map. */
+  for( ulong worker_idx=0UL; worker_idx<ctx->exec_cnt; worker_idx++ ) {
+    ulong tsorig = fd_frag_meta_ts_comp( fd_tickcount() );
+
+    fd_replay_out_link_t * exec_out = &ctx->exec_out[ worker_idx ];
+
+    fd_runtime_public_bpf_prewarm_msg_t * msg = (fd_runtime_public_bpf_prewarm_msg_t *)fd_chunk_to_laddr( exec_out->mem, exec_out->chunk );
+    msg->worker_idx = worker_idx;
+    msg->worker_cnt = ctx->exec_cnt;
+    msg->xid        = slot_ctx->funk_txn->xid;
+    msg->slot       = slot;
+    msg->deadline   = deadline;
+
+    ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_stem_publish( stem,
+                     exec_out->idx,
+                     EXEC_BPF_PREWARM_SIG,
+                     exec_out->chunk,
+                     sizeof(fd_runtime_public_bpf_prewarm_msg_t),
+                     0UL,
+                     tsorig,
+                     tspub );
+    exec_out->chunk = fd_dcache_compact_next( exec_out->chunk, sizeof(fd_runtime_public_bpf_prewarm_msg_t), exec_out->chunk0, exec_out->wmark );
+  }
+
+  /* Spins and blocks until all exec tiles are done prewarming.  They
+     stop at the deadline, so this is bounded by the prewarm budget. */
+  uchar prewarm_done[ FD_PACK_MAX_BANK_TILES ] = {0};
+  for( ;; ) {
+    uchar wait_cnt = 0;
+    for( ulong i=0UL; i<ctx->exec_cnt; i++ ) {
+      if( !prewarm_done[ i ] ) {
+        ulong res   = fd_fseq_query( ctx->exec_fseq[ i ] );
+        uint  state = fd_exec_fseq_get_state( res );
+        uint  slot_ = fd_exec_fseq_get_slot( res );
+        if( state==FD_EXEC_STATE_BPF_PREWARM_DONE && slot_==(uint)slot ) {
+          prewarm_done[ i ] = 1;
+        } else {
+          wait_cnt++;
+        }
+      }
+    }
+    if( !wait_cnt ) {
+      break;
+    }
+  }
+}
+
 static void
 txncache_publish( fd_replay_tile_ctx_t * ctx,
                   fd_funk_txn_t *        to_root_txn,
@@ -758,6 +823,18 @@ init_after_snapshot( fd_replay_tile_ctx_t * ctx,
     fd_fseq_update( ctx->published_wmark, root );
   }
 
+  /* Load the programs in the snapshot into the program cache before
+     replay starts, so the first slots do not pay for it inline.  This
+     gives up after FD_BPF_PREWARM_BUDGET_NS, the rest of the programs
+     are loaded on first use. */
+
+  fd_exec_para_cb_ctx_t exec_para_ctx_bpf_prewarm = {
+    .func       = bpf_prewarm_tiles_cb,
+    .para_arg_1 = ctx,
+    .para_arg_2 = stem,
+  };
+  fd_bpf_program_cache_prewarm( ctx->slot_ctx, ctx->runtime_spad, &exec_para_ctx_bpf_prewarm, FD_BPF_PREWARM_BUDGET_NS );
+
   /* Now that the snapshot(s) are done loading, we can mark all of the
      exec tiles as ready. */
   for( ulong i=0UL; i<ctx->exec_cnt; i++ ) {
@@ -1414,6 +1491,13 @@ exec_slice_fini_slot( fd_replay_tile_ctx_t * ctx, fd_stem_context_t * stem ) {
 
   ulong curr_slot = fd_bank_slot_get( ctx->slot_ctx->bank );
 
+  /* Update the capture file header before announcing the slot, such
+     that a consumer halting on the notification (backtest) sees a
+     capture that covers the slot. */
+  if( ctx->capture_ctx ) {
+    fd_solcap_writer_flush( ctx->capture_ctx->capture );
+  }
+
   ulong block_entry_height = fd_bank_block_height_get( ctx->slot_ctx->bank );
   publish_slot_notifications( ctx, stem, block_entry_height, curr_slot );
 
@@ -1450,10 +1534,6 @@ exec_slice_fini_slot( fd_replay_tile_ctx_t * ctx, fd_stem_context_t * stem ) {
     fflush( ctx->slots_replayed_file );
   }
 
-  if (NULL != ctx->capture_ctx) {
-    fd_solcap_writer_flush( ctx->capture_ctx->capture );
-  }
-
   /**********************************************************************/
   /* Bank hash comparison, and halt if there's a mismatch after replay  */
   /**********************************************************************/
@@ -1860,13 +1940,20 @@ unprivileged_init( fd_topo_t *      topo,
 
   if( strlen(tile->replay.solcap_capture) > 0 ) {
     ctx->capture_ctx->checkpt_freq = ULONG_MAX;
-    ctx->capture_file = fopen( tile->replay.solcap_capture, "w+" );
-    if( FD_UNLIKELY( !ctx->capture_file ) ) {
-      FD_LOG_ERR(( "fopen(%s) failed (%d-%s)", tile->replay.solcap_capture, errno, strerror( errno ) ));
-    }
     ctx->capture_ctx->capture_txns = 0;
     ctx->capture_ctx->solcap_start_slot = tile->replay.capture_start_slot;
-    fd_solcap_writer_init( ctx->capture_ctx->capture, ctx->capture_file );
+    if( tile->replay.solcap_ring_obj_id!=ULONG_MAX ) {
+      /* Capture is written to disk asynchronously by the solcap tile */
+      fd_solcap_ring_t * solcap_ring = fd_solcap_ring_join( fd_topo_obj_laddr( topo, tile->replay.solcap_ring_obj_id ) );
+      if( FD_UNLIKELY( !solcap_ring ) ) FD_LOG_ERR(( "failed to join solcap ring" ));
+      fd_solcap_writer_init_ring( ctx->capture_ctx->capture, solcap_ring );
+    } else {
+      ctx->capture_file = fopen( tile->replay.solcap_capture, "w+" );
+      if( FD_UNLIKELY( !ctx->capture_file ) ) {
+        FD_LOG_ERR(( "fopen(%s) failed (%d-%s)", tile->replay.solcap_capture, errno, strerror( errno ) ));
+      }
+      fd_solcap_writer_init( ctx->capture_ctx->capture, ctx->capture_file );
+    }
   }
 
   if ( strlen(tile->replay.dump_proto_dir) > 0) {
@@ -1,3 +1,3 @@
 ifdef FD_HAS_ALLOCA
-$(call add-objs,fd_resolv_tile,fd_discof)
+$(call add-objs,fd_resolv_tile fd_resolv_cache,fd_discof)
 endif
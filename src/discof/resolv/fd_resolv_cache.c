@@ -0,0 +1 @@
+../../discoh/resolv/fd_resolv_cache.c
\ No newline at end of file
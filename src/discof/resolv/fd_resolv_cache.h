@@ -0,0 +1 @@
+../../discoh/resolv/fd_resolv_cache.h
\ No newline at end of file
@@ -1,7 +1,11 @@
 ifdef FD_HAS_INT128
 $(call add-hdrs,fd_rpc_service.h)
-$(call add-objs,fd_block_to_json fd_methods fd_rpc_service fd_webserver json_lex keywords fd_stub_to_json base_enc fd_rpcserv_tile fd_rpc_history,fd_discof)
+$(call add-objs,fd_block_to_json fd_methods fd_rpc_service fd_webserver json_lex keywords fd_stub_to_json base_enc fd_rpcserv_tile fd_rpcsim_tile fd_rpc_history fd_rpc_prio_fees fd_rpc_acct_cache,fd_discof)
 
 $(call make-unit-test,test_rpc_keywords,test_keywords keywords,fd_util)
+$(call make-unit-test,test_rpc_prio_fees,test_rpc_prio_fees fd_rpc_prio_fees,fd_util)
+$(call run-unit-test,test_rpc_prio_fees)
+$(call make-unit-test,test_rpc_acct_cache,test_rpc_acct_cache fd_rpc_acct_cache,fd_util)
+$(call run-unit-test,test_rpc_acct_cache)
 #$(call make-fuzz-test,fuzz_json_lex,fuzz_json_lex json_lex,fd_util)
 endif
@@ -10,6 +10,7 @@
 #include "../../flamenco/types/fd_solana_block.pb.h"
 #include "../../flamenco/runtime/fd_blockstore.h"
 #include "../../flamenco/runtime/fd_executor_err.h"
+#include "../../flamenco/runtime/fd_runtime_err.h"
 #include "../../flamenco/runtime/fd_system_ids.h"
 #include "fd_block_to_json.h"
 #include "fd_stub_to_json.h"
@@ -102,6 +103,72 @@ instr_strerror( int err ) {
   return "";
 }
 
+static char const *
+txn_strerror( int err ) {
+  switch( err ) {
+  case FD_RUNTIME_TXN_ERR_ACCOUNT_IN_USE                           : return "AccountInUse";
+  case FD_RUNTIME_TXN_ERR_ACCOUNT_LOADED_TWICE                     : return "AccountLoadedTwice";
+  case FD_RUNTIME_TXN_ERR_ACCOUNT_NOT_FOUND                        : return "AccountNotFound";
+  case FD_RUNTIME_TXN_ERR_PROGRAM_ACCOUNT_NOT_FOUND                : return "ProgramAccountNotFound";
+  case FD_RUNTIME_TXN_ERR_INSUFFICIENT_FUNDS_FOR_FEE               : return "InsufficientFundsForFee";
+  case FD_RUNTIME_TXN_ERR_INVALID_ACCOUNT_FOR_FEE                  : return "InvalidAccountForFee";
+  case FD_RUNTIME_TXN_ERR_ALREADY_PROCESSED                        : return "AlreadyProcessed";
+  case FD_RUNTIME_TXN_ERR_BLOCKHASH_NOT_FOUND                      : return "BlockhashNotFound";
+  case FD_RUNTIME_TXN_ERR_INSTRUCTION_ERROR                        : return "InstructionError";
+  case FD_RUNTIME_TXN_ERR_CALL_CHAIN_TOO_DEEP                      : return "CallChainTooDeep";
+  case FD_RUNTIME_TXN_ERR_MISSING_SIGNATURE_FOR_FEE                : return "MissingSignatureForFee";
+  case FD_RUNTIME_TXN_ERR_INVALID_ACCOUNT_INDEX                    : return "InvalidAccountIndex";
+  case FD_RUNTIME_TXN_ERR_SIGNATURE_FAILURE                        : return "SignatureFailure";
+  case FD_RUNTIME_TXN_ERR_INVALID_PROGRAM_FOR_EXECUTION            : return "InvalidProgramForExecution";
+  case FD_RUNTIME_TXN_ERR_SANITIZE_FAILURE                         : return "SanitizeFailure";
+  case FD_RUNTIME_TXN_ERR_CLUSTER_MAINTENANCE                      : return "ClusterMaintenance";
+  case FD_RUNTIME_TXN_ERR_ACCOUNT_BORROW_OUTSTANDING               : return "AccountBorrowOutstanding";
+  case FD_RUNTIME_TXN_ERR_WOULD_EXCEED_MAX_BLOCK_COST_LIMIT        : return "WouldExceedMaxBlockCostLimit";
+  case FD_RUNTIME_TXN_ERR_UNSUPPORTED_VERSION                      : return "UnsupportedVersion";
+  case FD_RUNTIME_TXN_ERR_INVALID_WRITABLE_ACCOUNT                 : return "InvalidWritableAccount";
+  case FD_RUNTIME_TXN_ERR_WOULD_EXCEED_MAX_ACCOUNT_COST_LIMIT      : return "WouldExceedMaxAccountCostLimit";
+  case FD_RUNTIME_TXN_ERR_WOULD_EXCEED_ACCOUNT_DATA_BLOCK_LIMIT    : return "WouldExceedAccountDataBlockLimit";
+  case FD_RUNTIME_TXN_ERR_TOO_MANY_ACCOUNT_LOCKS                   : return "TooManyAccountLocks";
+  case FD_RUNTIME_TXN_ERR_ADDRESS_LOOKUP_TABLE_NOT_FOUND           : return "AddressLookupTableNotFound";
+  case FD_RUNTIME_TXN_ERR_INVALID_ADDRESS_LOOKUP_TABLE_OWNER       : return "InvalidAddressLookupTableOwner";
+  case FD_RUNTIME_TXN_ERR_INVALID_ADDRESS_LOOKUP_TABLE_DATA        : return "InvalidAddressLookupTableData";
+  case FD_RUNTIME_TXN_ERR_INVALID_ADDRESS_LOOKUP_TABLE_INDEX       : return "InvalidAddressLookupTableIndex";
+  case FD_RUNTIME_TXN_ERR_INVALID_RENT_PAYING_ACCOUNT              : return "InvalidRentPayingAccount";
+  case FD_RUNTIME_TXN_ERR_WOULD_EXCEED_MAX_VOTE_COST_LIMIT         : return "WouldExceedMaxVoteCostLimit";
+  case FD_RUNTIME_TXN_ERR_WOULD_EXCEED_ACCOUNT_DATA_TOTAL_LIMIT    : return "WouldExceedAccountDataTotalLimit";
+  case FD_RUNTIME_TXN_ERR_DUPLICATE_INSTRUCTION                    : return "DuplicateInstruction";
+  case FD_RUNTIME_TXN_ERR_INSUFFICIENT_FUNDS_FOR_RENT              : return "InsufficientFundsForRent";
+  case FD_RUNTIME_TXN_ERR_MAX_LOADED_ACCOUNTS_DATA_SIZE_EXCEEDED   : return "MaxLoadedAccountsDataSizeExceeded";
+  case FD_RUNTIME_TXN_ERR_INVALID_LOADED_ACCOUNTS_DATA_SIZE_LIMIT  : return "InvalidLoadedAccountsDataSizeLimit";
+  case FD_RUNTIME_TXN_ERR_RESANITIZATION_NEEDED                    : return "ResanitizationNeeded";
+  case FD_RUNTIME_TXN_ERR_PROGRAM_EXECUTION_TEMPORARILY_RESTRICTED : return "ProgramExecutionTemporarilyRestricted";
+  case FD_RUNTIME_TXN_ERR_UNBALANCED_TRANSACTION                   : return "UnbalancedTransaction";
+  case FD_RUNTIME_TXN_ERR_PROGRAM_CACHE_HIT_MAX_LIMIT              : return "ProgramCacheHitMaxLimit";
+  default: break;
+  }
+
+  return "";
+}
+
+void
+fd_txn_err_to_json( fd_webserver_t * ws,
+                    int              txn_err,
+                    int              instr_err,
+                    int              instr_idx,
+                    uint             custom_err ) {
+  if( txn_err==FD_RUNTIME_EXECUTE_SUCCESS ) {
+    EMIT_SIMPLE("null");
+  } else if( txn_err==FD_RUNTIME_TXN_ERR_INSTRUCTION_ERROR ) {
+    if( instr_err==FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR ) {
+      fd_web_reply_sprintf(ws, "{\"InstructionError\":[%d,{\"Custom\":%u}]}", instr_idx, custom_err);
+    } else {
+      fd_web_reply_sprintf(ws, "{\"InstructionError\":[%d,\"%s\"]}", instr_idx, instr_strerror( instr_err ));
+    }
+  } else {
+    fd_web_reply_sprintf(ws, "\"%s\"", txn_strerror( txn_err ));
+  }
+}
+
 void
 fd_error_to_json( fd_webserver_t * ws,
                   const uchar* bytes,
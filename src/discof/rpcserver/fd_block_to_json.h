@@ -40,6 +40,17 @@ const char* fd_block_to_json( fd_webserver_t * ws,
                               fd_block_rewards_t * rewards,
                               fd_spad_t * spad );
 
+/* fd_txn_err_to_json emits the JSON for the result of executing a
+   transaction, in the format of the err field of transaction metadata.
+   txn_err is FD_RUNTIME_EXECUTE_SUCCESS (emitted as null) or one of
+   FD_RUNTIME_TXN_ERR_*.  The remaining arguments are only used for
+   FD_RUNTIME_TXN_ERR_INSTRUCTION_ERROR. */
+void fd_txn_err_to_json( fd_webserver_t * ws,
+                         int              txn_err,
+                         int              instr_err,
+                         int              instr_idx,
+                         uint             custom_err );
+
 #define FD_LONG_UNSET (1L << 63L)
 
 const char* fd_account_to_json( fd_webserver_t * ws,
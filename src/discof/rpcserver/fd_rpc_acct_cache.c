@@ -0,0 +1,197 @@
+#include "fd_rpc_acct_cache.h"
+
+struct fd_rpc_acct_cache_ent {
+  fd_rpc_acct_cache_key_t key;
+  ulong                   next;
+  ulong                   dlist_prev;
+  ulong                   dlist_next;
+  fd_rpc_acct_cache_ver_t ver;
+  ulong                   data_off; /* Position of the bytes in the ring, not wrapped */
+  ulong                   data_sz;
+};
+typedef struct fd_rpc_acct_cache_ent fd_rpc_acct_cache_ent_t;
+
+#define MAP_NAME               fd_rpc_acct_cache_map
+#define MAP_KEY_T              fd_rpc_acct_cache_key_t
+#define MAP_ELE_T              fd_rpc_acct_cache_ent_t
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_rpc_acct_cache_key_t) )
+#define MAP_KEY_EQ(k0,k1)      (!memcmp( k0, k1, sizeof(fd_rpc_acct_cache_key_t) ))
+#include "../../util/tmpl/fd_map_chain.c"
+
+#define POOL_NAME fd_rpc_acct_cache_pool
+#define POOL_T    fd_rpc_acct_cache_ent_t
+#include "../../util/tmpl/fd_pool.c"
+
+/* Entries in insertion order, oldest at the head */
+#define DLIST_NAME  fd_rpc_acct_cache_dlist
+#define DLIST_ELE_T fd_rpc_acct_cache_ent_t
+#define DLIST_PREV  dlist_prev
+#define DLIST_NEXT  dlist_next
+#include "../../util/tmpl/fd_dlist.c"
+
+struct fd_rpc_acct_cache {
+  ulong data_sz;
+  ulong head;      /* End of the newest bytes in the ring, not wrapped */
+  ulong map_off;
+  ulong pool_off;
+  ulong dlist_off;
+  ulong data_off;
+};
+
+static inline fd_rpc_acct_cache_map_t *
+fd_rpc_acct_cache_map( fd_rpc_acct_cache_t * cache ) {
+  return (fd_rpc_acct_cache_map_t *)( (ulong)cache + cache->map_off );
+}
+
+static inline fd_rpc_acct_cache_ent_t *
+fd_rpc_acct_cache_pool( fd_rpc_acct_cache_t * cache ) {
+  return (fd_rpc_acct_cache_ent_t *)( (ulong)cache + cache->pool_off );
+}
+
+static inline fd_rpc_acct_cache_dlist_t *
+fd_rpc_acct_cache_dlist( fd_rpc_acct_cache_t * cache ) {
+  return (fd_rpc_acct_cache_dlist_t *)( (ulong)cache + cache->dlist_off );
+}
+
+static inline char *
+fd_rpc_acct_cache_data( fd_rpc_acct_cache_t * cache ) {
+  return (char *)( (ulong)cache + cache->data_off );
+}
+
+ulong
+fd_rpc_acct_cache_align( void ) {
+  return fd_ulong_max( fd_ulong_max( alignof(fd_rpc_acct_cache_t), fd_rpc_acct_cache_map_align() ),
+                       fd_ulong_max( fd_rpc_acct_cache_pool_align(), fd_rpc_acct_cache_dlist_align() ) );
+}
+
+ulong
+fd_rpc_acct_cache_footprint( ulong ent_max,
+                             ulong data_sz ) {
+  ulong chain_cnt = fd_rpc_acct_cache_map_chain_cnt_est( ent_max );
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_rpc_acct_cache_t),     sizeof(fd_rpc_acct_cache_t)                  );
+  l = FD_LAYOUT_APPEND( l, fd_rpc_acct_cache_map_align(),   fd_rpc_acct_cache_map_footprint( chain_cnt ) );
+  l = FD_LAYOUT_APPEND( l, fd_rpc_acct_cache_pool_align(),  fd_rpc_acct_cache_pool_footprint( ent_max )  );
+  l = FD_LAYOUT_APPEND( l, fd_rpc_acct_cache_dlist_align(), fd_rpc_acct_cache_dlist_footprint()          );
+  l = FD_LAYOUT_APPEND( l, 1UL,                             data_sz                                      );
+  return FD_LAYOUT_FINI( l, fd_rpc_acct_cache_align() );
+}
+
+void *
+fd_rpc_acct_cache_new( void * shmem,
+                       ulong  ent_max,
+                       ulong  data_sz,
+                       ulong  seed ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_rpc_acct_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !ent_max || !data_sz ) ) {
+    FD_LOG_WARNING(( "zero ent_max or data_sz" ));
+    return NULL;
+  }
+
+  ulong chain_cnt = fd_rpc_acct_cache_map_chain_cnt_est( ent_max );
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_rpc_acct_cache_t * cache = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_rpc_acct_cache_t),     sizeof(fd_rpc_acct_cache_t)                  );
+  void *                map   = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_cache_map_align(),   fd_rpc_acct_cache_map_footprint( chain_cnt ) );
+  void *                pool  = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_cache_pool_align(),  fd_rpc_acct_cache_pool_footprint( ent_max )  );
+  void *                dlist = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_acct_cache_dlist_align(), fd_rpc_acct_cache_dlist_footprint()          );
+  void *                data  = FD_SCRATCH_ALLOC_APPEND( l, 1UL,                             data_sz                                      );
+  FD_SCRATCH_ALLOC_FINI( l, fd_rpc_acct_cache_align() );
+
+  fd_rpc_acct_cache_map_t *   map_join   = fd_rpc_acct_cache_map_join  ( fd_rpc_acct_cache_map_new  ( map, chain_cnt, seed ) );
+  fd_rpc_acct_cache_ent_t *   pool_join  = fd_rpc_acct_cache_pool_join ( fd_rpc_acct_cache_pool_new ( pool, ent_max      ) );
+  fd_rpc_acct_cache_dlist_t * dlist_join = fd_rpc_acct_cache_dlist_join( fd_rpc_acct_cache_dlist_new( dlist              ) );
+  if( FD_UNLIKELY( !map_join || !pool_join || !dlist_join ) ) return NULL;
+
+  cache->data_sz   = data_sz;
+  cache->head      = 0UL;
+  cache->map_off   = (ulong)map_join   - (ulong)shmem;
+  cache->pool_off  = (ulong)pool_join  - (ulong)shmem;
+  cache->dlist_off = (ulong)dlist_join - (ulong)shmem;
+  cache->data_off  = (ulong)data       - (ulong)shmem;
+  return shmem;
+}
+
+fd_rpc_acct_cache_t *
+fd_rpc_acct_cache_join( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+  return (fd_rpc_acct_cache_t *)shcache;
+}
+
+static void
+fd_rpc_acct_cache_remove( fd_rpc_acct_cache_t *     cache,
+                          fd_rpc_acct_cache_ent_t * ent ) {
+  fd_rpc_acct_cache_ent_t * pool = fd_rpc_acct_cache_pool( cache );
+  fd_rpc_acct_cache_dlist_ele_remove( fd_rpc_acct_cache_dlist( cache ), ent, pool );
+  fd_rpc_acct_cache_map_ele_remove( fd_rpc_acct_cache_map( cache ), &ent->key, NULL, pool );
+  fd_rpc_acct_cache_pool_ele_release( pool, ent );
+}
+
+char const *
+fd_rpc_acct_cache_query( fd_rpc_acct_cache_t *           cache,
+                         fd_rpc_acct_cache_key_t const * key,
+                         fd_rpc_acct_cache_ver_t const * ver,
+                         ulong *                         sz ) {
+  fd_rpc_acct_cache_ent_t * ent = fd_rpc_acct_cache_map_ele_query( fd_rpc_acct_cache_map( cache ), key, NULL, fd_rpc_acct_cache_pool( cache ) );
+  if( !ent ) return NULL;
+  if( FD_UNLIKELY( memcmp( &ent->ver, ver, sizeof(fd_rpc_acct_cache_ver_t) ) ) ) {
+    /* The account changed since it was encoded */
+    fd_rpc_acct_cache_remove( cache, ent );
+    return NULL;
+  }
+  *sz = ent->data_sz;
+  return fd_rpc_acct_cache_data( cache ) + ( ent->data_off % cache->data_sz );
+}
+
+void
+fd_rpc_acct_cache_insert( fd_rpc_acct_cache_t *           cache,
+                          fd_rpc_acct_cache_key_t const * key,
+                          fd_rpc_acct_cache_ver_t const * ver,
+                          char const *                    data,
+                          ulong                           sz ) {
+  if( FD_UNLIKELY( sz > cache->data_sz/4UL ) ) return;
+
+  fd_rpc_acct_cache_map_t *   map   = fd_rpc_acct_cache_map( cache );
+  fd_rpc_acct_cache_ent_t *   pool  = fd_rpc_acct_cache_pool( cache );
+  fd_rpc_acct_cache_dlist_t * dlist = fd_rpc_acct_cache_dlist( cache );
+
+  fd_rpc_acct_cache_ent_t * prev = fd_rpc_acct_cache_map_ele_query( map, key, NULL, pool );
+  if( prev ) fd_rpc_acct_cache_remove( cache, prev );
+
+  /* The bytes of an entry are contiguous, so skip to the start of the
+     ring if they would wrap around. */
+
+  ulong start = cache->head;
+  if( ( start % cache->data_sz ) + sz > cache->data_sz ) start = ( start / cache->data_sz + 1UL ) * cache->data_sz;
+  ulong end = start + sz;
+
+  /* An entry starting at or after end-data_sz cannot share bytes with
+     [start,end), and entries are in ring order, so evict from the head
+     until that holds and there is a free entry. */
+
+  while( !fd_rpc_acct_cache_dlist_is_empty( dlist, pool ) ) {
+    fd_rpc_acct_cache_ent_t * oldest = fd_rpc_acct_cache_dlist_ele_peek_head( dlist, pool );
+    if( oldest->data_off + cache->data_sz >= end && fd_rpc_acct_cache_pool_free( pool ) ) break;
+    fd_rpc_acct_cache_remove( cache, oldest );
+  }
+
+  fd_memcpy( fd_rpc_acct_cache_data( cache ) + ( start % cache->data_sz ), data, sz );
+  cache->head = end;
+
+  fd_rpc_acct_cache_ent_t * ent = fd_rpc_acct_cache_pool_ele_acquire( pool );
+  ent->key      = *key;
+  ent->ver      = *ver;
+  ent->data_off = start;
+  ent->data_sz  = sz;
+  fd_rpc_acct_cache_map_ele_insert( map, ent, pool );
+  fd_rpc_acct_cache_dlist_ele_push_tail( dlist, ent, pool );
+}
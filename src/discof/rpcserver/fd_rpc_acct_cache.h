@@ -0,0 +1,87 @@
+#ifndef HEADER_fd_src_discof_rpcserver_fd_rpc_acct_cache_h
+#define HEADER_fd_src_discof_rpcserver_fd_rpc_acct_cache_h
+
+/* fd_rpc_acct_cache is a bounded cache of encoded accounts, i.e. the
+   "value" objects produced by fd_account_to_json, for getAccountInfo
+   and getMultipleAccounts.  Hot accounts are queried many times per
+   slot with the same parameters, and re-reading and re-encoding them
+   (base58 in particular) dominates the cost of those methods.
+
+   Entries are keyed by account, encoding and data slice, and carry the
+   version of the funk record they were encoded from.  A lookup with a
+   different version, which is what replay publishing a new version of
+   the account produces, drops the entry.
+
+   Encoded bytes live in a ring of data_sz bytes and entries are evicted
+   in insertion order as the ring wraps around or runs out of entries.
+   Responses larger than a quarter of the ring are not cached. */
+
+#include "../../flamenco/types/fd_types_custom.h"
+
+struct fd_rpc_acct_cache_key {
+  fd_pubkey_t acct;
+  long        off;  /* Data slice, FD_LONG_UNSET if none */
+  long        len;
+  ulong       enc;  /* fd_rpc_encoding_t */
+};
+typedef struct fd_rpc_acct_cache_key fd_rpc_acct_cache_key_t;
+
+/* fd_rpc_acct_cache_ver_t identifies a version of a funk record.  A
+   new version of a record is a new record element with a new value
+   allocation, so this cannot be confused with a prior version. */
+
+struct fd_rpc_acct_cache_ver {
+  ulong rec;       /* Address of the record */
+  ulong val_gaddr; /* Global address of its value */
+  ulong val_sz;
+  ulong slot;      /* Slot the account was last modified in */
+};
+typedef struct fd_rpc_acct_cache_ver fd_rpc_acct_cache_ver_t;
+
+struct fd_rpc_acct_cache;
+typedef struct fd_rpc_acct_cache fd_rpc_acct_cache_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_rpc_acct_cache_align( void );
+
+FD_FN_CONST ulong
+fd_rpc_acct_cache_footprint( ulong ent_max,
+                             ulong data_sz );
+
+void *
+fd_rpc_acct_cache_new( void * shmem,
+                       ulong  ent_max,
+                       ulong  data_sz,
+                       ulong  seed );
+
+fd_rpc_acct_cache_t *
+fd_rpc_acct_cache_join( void * shcache );
+
+/* fd_rpc_acct_cache_query returns the encoded bytes cached for key if
+   they were encoded from version ver of the account, and stores their
+   size in *sz.  The bytes are valid until the next insert.  Returns
+   NULL on a miss, and drops the entry if it is for another version. */
+
+char const *
+fd_rpc_acct_cache_query( fd_rpc_acct_cache_t *           cache,
+                         fd_rpc_acct_cache_key_t const * key,
+                         fd_rpc_acct_cache_ver_t const * ver,
+                         ulong *                         sz );
+
+/* fd_rpc_acct_cache_insert caches the sz bytes at data as the encoding
+   for key of version ver of the account, replacing any prior entry for
+   key.  Evicts the oldest entries as needed.  data must not point into
+   the cache. */
+
+void
+fd_rpc_acct_cache_insert( fd_rpc_acct_cache_t *           cache,
+                          fd_rpc_acct_cache_key_t const * key,
+                          fd_rpc_acct_cache_ver_t const * ver,
+                          char const *                    data,
+                          ulong                           sz );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_rpcserver_fd_rpc_acct_cache_h */
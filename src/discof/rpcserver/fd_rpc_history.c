@@ -1,6 +1,11 @@
 #include "fd_rpc_history.h"
 #include <unistd.h>
 #include "../../flamenco/runtime/fd_system_ids.h"
+#include "../../disco/pack/fd_compute_budget_program.h"
+
+/* Max number of account prioritization fee ladders kept across the
+   recent slots */
+#define FD_RPC_HISTORY_PRIO_FEES_ACCT_MAX (1UL<<18)
 
 struct fd_rpc_block {
   ulong slot;
@@ -78,6 +83,7 @@ struct fd_rpc_history {
   fd_rpc_txn_t * txn_map;
   fd_rpc_acct_map_t * acct_map;
   fd_rpc_acct_map_elem_t * acct_pool;
+  fd_rpc_prio_fees_t * prio_fees;
   ulong first_slot;
   ulong latest_slot;
   int file_fd;
@@ -103,6 +109,9 @@ fd_rpc_history_create(fd_rpcserver_args_t * args) {
   mem = fd_spad_alloc( spad, fd_rpc_acct_map_pool_align(), fd_rpc_acct_map_pool_footprint( args->acct_index_max ) );
   hist->acct_pool = fd_rpc_acct_map_pool_join( fd_rpc_acct_map_pool_new( mem, args->acct_index_max ) );
 
+  mem = fd_spad_alloc( spad, fd_rpc_prio_fees_align(), fd_rpc_prio_fees_footprint( FD_RPC_HISTORY_PRIO_FEES_ACCT_MAX ) );
+  hist->prio_fees = fd_rpc_prio_fees_join( fd_rpc_prio_fees_new( mem, FD_RPC_HISTORY_PRIO_FEES_ACCT_MAX, 0 ) );
+
   hist->file_fd = open( args->history_file, O_CREAT | O_RDWR | O_TRUNC, 0644 );
   if( hist->file_fd == -1 ) FD_LOG_ERR(( "unable to open rpc history file: %s", args->history_file ));
   hist->file_totsz = 0;
@@ -118,7 +127,12 @@ fd_rpc_history_save(fd_rpc_history_t * hist, fd_blockstore_t * blockstore, fd_re
     ulong blk_max = info->slot_exec.shred_cnt * FD_SHRED_MAX_SZ;
     uchar * blk_data = fd_spad_alloc( hist->spad, 1, blk_max );
     ulong blk_sz;
-    if( fd_blockstore_slice_query( blockstore, info->slot_exec.slot, 0, (uint)(info->slot_exec.shred_cnt-1), blk_max, blk_data, &blk_sz) ) {
+    int err = fd_blockstore_block_data_query( blockstore, info->slot_exec.slot, blk_max, blk_data, &blk_sz );
+    if( FD_UNLIKELY( err==FD_BLOCKSTORE_ERR_EMPTY ) ) {
+      /* Block data was not published, reassemble it from the shreds */
+      err = fd_blockstore_slice_query( blockstore, info->slot_exec.slot, 0, (uint)(info->slot_exec.shred_cnt-1), blk_max, blk_data, &blk_sz );
+    }
+    if( err ) {
       FD_LOG_WARNING(( "unable to read slot %lu block", info->slot_exec.slot ));
       return;
     }
@@ -143,10 +157,18 @@ fd_rpc_history_save(fd_rpc_history_t * hist, fd_blockstore_t * blockstore, fd_re
     hist->file_totsz += blk_sz;
     hist->block_cnt ++;
 
+    /* Compute unit prices of the non-vote transactions, overall and per
+       writable account.  Every transaction has at least one signature
+       and every account address is in the block, which bounds these. */
+    ulong * txn_fee = fd_spad_alloc( hist->spad, alignof(ulong), (blk_sz/FD_ED25519_SIG_SZ + 1UL)*sizeof(ulong) );
+    ulong   txn_cnt = 0;
+    fd_rpc_prio_fees_acct_t * acct_fee = fd_spad_alloc( hist->spad, alignof(fd_rpc_prio_fees_acct_t), (blk_sz/sizeof(fd_pubkey_t) + 1UL)*sizeof(fd_rpc_prio_fees_acct_t) );
+    ulong acct_fee_cnt = 0;
+
     ulong blockoff = 0;
     while (blockoff < blk_sz) {
       if ( blockoff + sizeof(ulong) > blk_sz )
-        return;
+        break;
       ulong mcount = *(const ulong *)(blk_data + blockoff);
       blockoff += sizeof(ulong);
 
@@ -184,6 +206,13 @@ fd_rpc_history_save(fd_rpc_history_t * hist, fd_blockstore_t * blockstore, fd_re
           fd_rpc_txn_key_t sig0;
           memcpy(&sig0, (const uchar*)sigs, sizeof(sig0));
           fd_pubkey_t * accs = (fd_pubkey_t *)((uchar *)raw + txn->acct_addr_off);
+          int is_vote = 0;
+          for( ulong i = 0UL; i < txn->acct_addr_cnt; i++ ) {
+            if( !memcmp(&accs[i], fd_solana_vote_program_id.key, sizeof(fd_pubkey_t)) ) {
+              is_vote = 1;
+              break;
+            }
+          }
           for( ulong i = 0UL; i < txn->acct_addr_cnt; i++ ) {
             if( !memcmp(&accs[i], fd_solana_vote_program_id.key, sizeof(fd_pubkey_t)) ) continue; /* Ignore votes */
             if( !fd_rpc_acct_map_pool_free( hist->acct_pool ) ) break;
@@ -194,13 +223,35 @@ fd_rpc_history_save(fd_rpc_history_t * hist, fd_blockstore_t * blockstore, fd_re
             fd_rpc_acct_map_ele_insert( hist->acct_map, ele, hist->acct_pool );
           }
 
+          /* Prioritization fees, which like Agave leave votes out */
+          if( !is_vote ) {
+            fd_compute_budget_program_state_t cbp_state;
+            fd_compute_budget_program_init( &cbp_state );
+            for( ulong i = 0UL; i < txn->instr_cnt; i++ ) {
+              if( !memcmp( &accs[ txn->instr[i].program_id ], FD_COMPUTE_BUDGET_PROGRAM_ID, sizeof(fd_pubkey_t) ) ) {
+                fd_compute_budget_program_parse( raw + txn->instr[i].data_off, txn->instr[i].data_sz, &cbp_state );
+              }
+            }
+            ulong fee = cbp_state.micro_lamports_per_cu;
+            txn_fee[ txn_cnt++ ] = fee;
+            for( fd_txn_acct_iter_t iter = fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+                 iter != fd_txn_acct_iter_end();
+                 iter = fd_txn_acct_iter_next( iter ) ) {
+              fd_rpc_prio_fees_acct_t * af = acct_fee + (acct_fee_cnt++);
+              af->key = accs[ fd_txn_acct_iter_idx( iter ) ];
+              af->fee = fee;
+            }
+          }
+
           blockoff += pay_sz;
         }
       }
     }
-    if ( blockoff != blk_sz )
+    if ( blockoff > blk_sz )
       FD_LOG_ERR(("garbage at end of block"));
 
+    fd_rpc_prio_fees_add_slot( hist->prio_fees, info->slot_exec.slot, txn_fee, txn_cnt, acct_fee, acct_fee_cnt );
+
   } FD_SPAD_FRAME_END;
 }
 
@@ -214,6 +265,11 @@ fd_rpc_history_latest_slot(fd_rpc_history_t * hist) {
   return hist->latest_slot;
 }
 
+fd_rpc_prio_fees_t const *
+fd_rpc_history_prio_fees(fd_rpc_history_t * hist) {
+  return hist->prio_fees;
+}
+
 fd_replay_notif_msg_t *
 fd_rpc_history_get_block_info(fd_rpc_history_t * hist, ulong slot) {
   fd_rpc_block_t * blk = fd_rpc_block_map_query( hist->block_map, &slot, NULL );
@@ -2,6 +2,7 @@
 #define HEADER_fd_src_discof_rpcserver_fd_rpc_history_h
 
 #include "fd_rpc_service.h"
+#include "fd_rpc_prio_fees.h"
 
 struct fd_rpc_history;
 typedef struct fd_rpc_history fd_rpc_history_t;
@@ -19,6 +20,8 @@ ulong fd_rpc_history_first_slot(fd_rpc_history_t * hist);
 
 ulong fd_rpc_history_latest_slot(fd_rpc_history_t * hist);
 
+fd_rpc_prio_fees_t const * fd_rpc_history_prio_fees(fd_rpc_history_t * hist);
+
 fd_replay_notif_msg_t * fd_rpc_history_get_block_info(fd_rpc_history_t * hist, ulong slot);
 
 fd_replay_notif_msg_t * fd_rpc_history_get_block_info_by_hash(fd_rpc_history_t * hist, fd_hash_t * h);
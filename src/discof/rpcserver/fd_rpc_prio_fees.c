@@ -0,0 +1,312 @@
+#include "fd_rpc_prio_fees.h"
+
+static const ushort fd_rpc_prio_fees_pctl[ FD_RPC_PRIO_FEES_PCTL_CNT ] = { 0, 2500, 5000, 7500, 9000, 9500, 10000 };
+
+/* An account ladder.  The ladders of a slot are linked through
+   slot_next so they can be released together. */
+
+struct fd_rpc_prio_fees_ele {
+  fd_pubkey_t key;
+  ulong       next;
+  ulong       prev;
+  ulong       slot_next;
+  ulong       slot;
+  ulong       fee[ FD_RPC_PRIO_FEES_PCTL_CNT ];
+};
+typedef struct fd_rpc_prio_fees_ele fd_rpc_prio_fees_ele_t;
+
+#define MAP_NAME fd_rpc_prio_fees_map
+#define MAP_KEY_T fd_pubkey_t
+#define MAP_ELE_T fd_rpc_prio_fees_ele_t
+#define MAP_KEY_HASH(key,seed) fd_hash( seed, key, sizeof(fd_pubkey_t) )
+#define MAP_KEY_EQ(k0,k1)      fd_pubkey_eq( k0, k1 )
+#define MAP_MULTI 1
+#define MAP_OPTIMIZE_RANDOM_ACCESS_REMOVAL 1
+#define MAP_PREV prev
+#include "../../util/tmpl/fd_map_chain.c"
+#define POOL_NAME fd_rpc_prio_fees_pool
+#define POOL_T    fd_rpc_prio_fees_ele_t
+#include "../../util/tmpl/fd_pool.c"
+
+#define SORT_NAME        fd_rpc_prio_fees_sort_fee
+#define SORT_KEY_T       ulong
+#include "../../util/tmpl/fd_sort.c"
+
+#define SORT_NAME        fd_rpc_prio_fees_sort_acct
+#define SORT_KEY_T       fd_rpc_prio_fees_acct_t
+#define SORT_BEFORE(a,b) fd_rpc_prio_fees_acct_before( &(a), &(b) )
+
+static inline int
+fd_rpc_prio_fees_acct_before( fd_rpc_prio_fees_acct_t const * a,
+                              fd_rpc_prio_fees_acct_t const * b ) {
+  int c = memcmp( a->key.uc, b->key.uc, sizeof(fd_pubkey_t) );
+  return c ? c<0 : a->fee<b->fee;
+}
+
+#include "../../util/tmpl/fd_sort.c"
+
+/* The summary of a slot.  slot is ULONG_MAX if the entry is unused. */
+
+struct fd_rpc_prio_fees_slot {
+  ulong slot;
+  ulong fee[ FD_RPC_PRIO_FEES_PCTL_CNT ];
+  ulong acct_head; /* First ladder of the slot in the pool, or idx_null */
+};
+typedef struct fd_rpc_prio_fees_slot fd_rpc_prio_fees_slot_t;
+
+struct fd_rpc_prio_fees {
+  ulong                   latest_slot; /* ULONG_MAX if nothing was added */
+  ulong                   map_off;
+  ulong                   pool_off;
+  fd_rpc_prio_fees_slot_t slots[ FD_RPC_PRIO_FEES_SLOT_MAX ];
+};
+
+static inline fd_rpc_prio_fees_map_t *
+fd_rpc_prio_fees_map( fd_rpc_prio_fees_t const * fees ) {
+  return (fd_rpc_prio_fees_map_t *)( (ulong)fees + fees->map_off );
+}
+
+static inline fd_rpc_prio_fees_ele_t *
+fd_rpc_prio_fees_pool( fd_rpc_prio_fees_t const * fees ) {
+  return (fd_rpc_prio_fees_ele_t *)( (ulong)fees + fees->pool_off );
+}
+
+ulong
+fd_rpc_prio_fees_align( void ) {
+  return fd_ulong_max( alignof(fd_rpc_prio_fees_t), fd_ulong_max( fd_rpc_prio_fees_map_align(), fd_rpc_prio_fees_pool_align() ) );
+}
+
+ulong
+fd_rpc_prio_fees_footprint( ulong acct_max ) {
+  ulong chain_cnt = fd_rpc_prio_fees_map_chain_cnt_est( acct_max );
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_rpc_prio_fees_t),    sizeof(fd_rpc_prio_fees_t)                    );
+  l = FD_LAYOUT_APPEND( l, fd_rpc_prio_fees_map_align(),  fd_rpc_prio_fees_map_footprint( chain_cnt )   );
+  l = FD_LAYOUT_APPEND( l, fd_rpc_prio_fees_pool_align(), fd_rpc_prio_fees_pool_footprint( acct_max )   );
+  return FD_LAYOUT_FINI( l, fd_rpc_prio_fees_align() );
+}
+
+void *
+fd_rpc_prio_fees_new( void * shmem,
+                      ulong  acct_max,
+                      ulong  seed ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_rpc_prio_fees_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong chain_cnt = fd_rpc_prio_fees_map_chain_cnt_est( acct_max );
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_rpc_prio_fees_t * fees = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_rpc_prio_fees_t),    sizeof(fd_rpc_prio_fees_t)                  );
+  void *               map  = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_prio_fees_map_align(),  fd_rpc_prio_fees_map_footprint( chain_cnt ) );
+  void *               pool = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_prio_fees_pool_align(), fd_rpc_prio_fees_pool_footprint( acct_max ) );
+  FD_SCRATCH_ALLOC_FINI( l, fd_rpc_prio_fees_align() );
+
+  fd_rpc_prio_fees_map_t * map_join  = fd_rpc_prio_fees_map_join ( fd_rpc_prio_fees_map_new ( map, chain_cnt, seed ) );
+  fd_rpc_prio_fees_ele_t * pool_join = fd_rpc_prio_fees_pool_join( fd_rpc_prio_fees_pool_new( pool, acct_max ) );
+  if( FD_UNLIKELY( !map_join || !pool_join ) ) return NULL;
+
+  /* The joins are plain offsets into the region, so they are
+     remembered relative to it. */
+
+  memset( fees, 0, sizeof(fd_rpc_prio_fees_t) );
+  fees->latest_slot = ULONG_MAX;
+  fees->map_off     = (ulong)map_join  - (ulong)shmem;
+  fees->pool_off    = (ulong)pool_join - (ulong)shmem;
+  for( ulong i=0UL; i<FD_RPC_PRIO_FEES_SLOT_MAX; i++ ) {
+    fees->slots[ i ].slot      = ULONG_MAX;
+    fees->slots[ i ].acct_head = fd_rpc_prio_fees_pool_idx_null( NULL );
+  }
+  return shmem;
+}
+
+fd_rpc_prio_fees_t *
+fd_rpc_prio_fees_join( void * shfees ) {
+  if( FD_UNLIKELY( !shfees ) ) {
+    FD_LOG_WARNING(( "NULL shfees" ));
+    return NULL;
+  }
+  fd_rpc_prio_fees_t * fees = (fd_rpc_prio_fees_t *)shfees;
+  return fees;
+}
+
+ulong
+fd_rpc_prio_fees_pctl_idx( ulong pctl ) {
+  pctl = fd_ulong_min( pctl, FD_RPC_PRIO_FEES_PCTL_MAX );
+  ulong i = 0UL;
+  while( fd_rpc_prio_fees_pctl[ i ]<pctl ) i++;
+  return i;
+}
+
+/* fd_rpc_prio_fees_rank returns the index in a sorted list of cnt
+   values (cnt>0) of rung i of the ladder, by nearest rank. */
+
+FD_FN_CONST static inline ulong
+fd_rpc_prio_fees_rank( ulong i,
+                       ulong cnt ) {
+  ulong rank = ( fd_rpc_prio_fees_pctl[ i ]*cnt + FD_RPC_PRIO_FEES_PCTL_MAX - 1UL ) / FD_RPC_PRIO_FEES_PCTL_MAX;
+  return rank ? rank-1UL : 0UL;
+}
+
+/* fd_rpc_prio_fees_acct_ladder fills fee with the ladder of the cnt
+   (cnt>0) entries of an account in acct, which are sorted by fee. */
+
+static inline void
+fd_rpc_prio_fees_acct_ladder( ulong                           fee[ FD_RPC_PRIO_FEES_PCTL_CNT ],
+                              fd_rpc_prio_fees_acct_t const * acct,
+                              ulong                           cnt ) {
+  for( ulong i=0UL; i<FD_RPC_PRIO_FEES_PCTL_CNT; i++ ) fee[ i ] = acct[ fd_rpc_prio_fees_rank( i, cnt ) ].fee;
+}
+
+/* fd_rpc_prio_fees_evict_accts releases the account ladders of ent. */
+
+static void
+fd_rpc_prio_fees_evict_accts( fd_rpc_prio_fees_t *      fees,
+                              fd_rpc_prio_fees_slot_t * ent ) {
+  fd_rpc_prio_fees_map_t * map  = fd_rpc_prio_fees_map( fees );
+  fd_rpc_prio_fees_ele_t * pool = fd_rpc_prio_fees_pool( fees );
+  ulong idx = ent->acct_head;
+  while( idx!=fd_rpc_prio_fees_pool_idx_null( pool ) ) {
+    fd_rpc_prio_fees_ele_t * ele = pool + idx;
+    idx = ele->slot_next;
+    fd_rpc_prio_fees_map_ele_remove_fast( map, ele, pool );
+    fd_rpc_prio_fees_pool_ele_release( pool, ele );
+  }
+  ent->acct_head = fd_rpc_prio_fees_pool_idx_null( pool );
+}
+
+static void
+fd_rpc_prio_fees_evict( fd_rpc_prio_fees_t *      fees,
+                        fd_rpc_prio_fees_slot_t * ent ) {
+  fd_rpc_prio_fees_evict_accts( fees, ent );
+  ent->slot = ULONG_MAX;
+}
+
+/* fd_rpc_prio_fees_acct_relevant returns 1 if the ladder of an account
+   is above the ladder of its slot at some percentile. */
+
+static inline int
+fd_rpc_prio_fees_acct_relevant( ulong const fee[ FD_RPC_PRIO_FEES_PCTL_CNT ],
+                                ulong const slot_fee[ FD_RPC_PRIO_FEES_PCTL_CNT ] ) {
+  int relevant = 0;
+  for( ulong i=0UL; i<FD_RPC_PRIO_FEES_PCTL_CNT; i++ ) relevant |= fee[ i ]>slot_fee[ i ];
+  return relevant;
+}
+
+void
+fd_rpc_prio_fees_add_slot( fd_rpc_prio_fees_t *      fees,
+                           ulong                     slot,
+                           ulong *                   txn_fee,
+                           ulong                     txn_cnt,
+                           fd_rpc_prio_fees_acct_t * acct_fee,
+                           ulong                     acct_fee_cnt ) {
+  fd_rpc_prio_fees_map_t * map  = fd_rpc_prio_fees_map( fees );
+  fd_rpc_prio_fees_ele_t * pool = fd_rpc_prio_fees_pool( fees );
+
+  if( fees->latest_slot==ULONG_MAX || slot>fees->latest_slot ) {
+    fees->latest_slot = slot;
+    for( ulong i=0UL; i<FD_RPC_PRIO_FEES_SLOT_MAX; i++ ) {
+      fd_rpc_prio_fees_slot_t * ent = fees->slots + i;
+      if( ent->slot!=ULONG_MAX && ent->slot+FD_RPC_PRIO_FEES_SLOT_MAX<=slot ) fd_rpc_prio_fees_evict( fees, ent );
+    }
+  } else if( slot+FD_RPC_PRIO_FEES_SLOT_MAX<=fees->latest_slot ) {
+    return; /* Already out of the window */
+  }
+
+  fd_rpc_prio_fees_slot_t * ent = fees->slots + ( slot % FD_RPC_PRIO_FEES_SLOT_MAX );
+  if( ent->slot!=ULONG_MAX ) fd_rpc_prio_fees_evict( fees, ent );
+
+  fd_rpc_prio_fees_sort_fee_inplace( txn_fee, txn_cnt );
+  for( ulong i=0UL; i<FD_RPC_PRIO_FEES_PCTL_CNT; i++ ) {
+    ent->fee[ i ] = txn_cnt ? txn_fee[ fd_rpc_prio_fees_rank( i, txn_cnt ) ] : 0UL;
+  }
+  ent->slot = slot;
+
+  /* Count the accounts that need a ladder.  If the pool is short, the
+     account ladders of the oldest slots go first. */
+
+  fd_rpc_prio_fees_sort_acct_inplace( acct_fee, acct_fee_cnt );
+  ulong need = 0UL;
+  for( ulong i=0UL; i<acct_fee_cnt; ) {
+    ulong j = i+1UL;
+    while( j<acct_fee_cnt && fd_pubkey_eq( &acct_fee[ j ].key, &acct_fee[ i ].key ) ) j++;
+    ulong fee[ FD_RPC_PRIO_FEES_PCTL_CNT ];
+    fd_rpc_prio_fees_acct_ladder( fee, acct_fee+i, j-i );
+    need += (ulong)fd_rpc_prio_fees_acct_relevant( fee, ent->fee );
+    i = j;
+  }
+  while( fd_rpc_prio_fees_pool_free( pool )<need ) {
+    fd_rpc_prio_fees_slot_t * oldest = NULL;
+    for( ulong i=0UL; i<FD_RPC_PRIO_FEES_SLOT_MAX; i++ ) {
+      fd_rpc_prio_fees_slot_t * cur = fees->slots + i;
+      if( cur==ent || cur->slot==ULONG_MAX || cur->acct_head==fd_rpc_prio_fees_pool_idx_null( pool ) ) continue;
+      if( !oldest || cur->slot<oldest->slot ) oldest = cur;
+    }
+    if( !oldest ) break;
+    fd_rpc_prio_fees_evict_accts( fees, oldest );
+  }
+
+  for( ulong i=0UL; i<acct_fee_cnt; ) {
+    ulong j = i+1UL;
+    while( j<acct_fee_cnt && fd_pubkey_eq( &acct_fee[ j ].key, &acct_fee[ i ].key ) ) j++;
+    ulong fee[ FD_RPC_PRIO_FEES_PCTL_CNT ];
+    fd_rpc_prio_fees_acct_ladder( fee, acct_fee+i, j-i );
+    if( fd_rpc_prio_fees_acct_relevant( fee, ent->fee ) ) {
+      if( FD_UNLIKELY( !fd_rpc_prio_fees_pool_free( pool ) ) ) {
+        FD_LOG_WARNING(( "out of prioritization fee account space in slot %lu", slot ));
+        break;
+      }
+      fd_rpc_prio_fees_ele_t * ele = fd_rpc_prio_fees_pool_ele_acquire( pool );
+      ele->key  = acct_fee[ i ].key;
+      ele->slot = slot;
+      memcpy( ele->fee, fee, sizeof(fee) );
+      ele->slot_next = ent->acct_head;
+      ent->acct_head = fd_rpc_prio_fees_pool_idx( pool, ele );
+      fd_rpc_prio_fees_map_ele_insert( map, ele, pool );
+    }
+    i = j;
+  }
+}
+
+ulong
+fd_rpc_prio_fees_query( fd_rpc_prio_fees_t const * fees,
+                        fd_pubkey_t const *        accts,
+                        ulong                      acct_cnt,
+                        ulong                      pctl_idx,
+                        ulong *                    out_slot,
+                        ulong *                    out_fee ) {
+  if( FD_UNLIKELY( fees->latest_slot==ULONG_MAX ) ) return 0UL;
+
+  /* Slots in the window occupy distinct entries, so walking the window
+     in slot order gives the results in ascending order. */
+
+  ulong pos[ FD_RPC_PRIO_FEES_SLOT_MAX ];
+  ulong cnt   = 0UL;
+  ulong start = fees->latest_slot+1UL - fd_ulong_min( fees->latest_slot+1UL, FD_RPC_PRIO_FEES_SLOT_MAX );
+  for( ulong slot=start; slot<=fees->latest_slot; slot++ ) {
+    ulong                           i   = slot % FD_RPC_PRIO_FEES_SLOT_MAX;
+    fd_rpc_prio_fees_slot_t const * ent = fees->slots + i;
+    if( ent->slot!=slot ) { pos[ i ] = ULONG_MAX; continue; }
+    pos[ i ]        = cnt;
+    out_slot[ cnt ] = slot;
+    out_fee [ cnt ] = ent->fee[ pctl_idx ];
+    cnt++;
+  }
+
+  fd_rpc_prio_fees_map_t const * map  = fd_rpc_prio_fees_map( fees );
+  fd_rpc_prio_fees_ele_t const * pool = fd_rpc_prio_fees_pool( fees );
+  for( ulong j=0UL; j<acct_cnt; j++ ) {
+    for( fd_rpc_prio_fees_ele_t const * ele = fd_rpc_prio_fees_map_ele_query_const( map, accts+j, NULL, pool );
+         ele;
+         ele = fd_rpc_prio_fees_map_ele_next_const( ele, NULL, pool ) ) {
+      ulong p = pos[ ele->slot % FD_RPC_PRIO_FEES_SLOT_MAX ];
+      if( FD_UNLIKELY( p==ULONG_MAX ) ) continue;
+      out_fee[ p ] = fd_ulong_max( out_fee[ p ], ele->fee[ pctl_idx ] );
+    }
+  }
+  return cnt;
+}
@@ -0,0 +1,113 @@
+#ifndef HEADER_fd_src_discof_rpcserver_fd_rpc_prio_fees_h
+#define HEADER_fd_src_discof_rpcserver_fd_rpc_prio_fees_h
+
+/* fd_rpc_prio_fees keeps a rolling summary of the compute unit prices
+   (in micro-lamports per compute unit) paid in the most recent
+   FD_RPC_PRIO_FEES_SLOT_MAX slots, for getRecentPrioritizationFees.
+
+   The summary is built once per slot, when the block is saved, and
+   queries never look at block contents again.  Each slot records a
+   ladder of percentiles over all of its non-vote transactions, and a
+   ladder per writable account over the transactions that write to it.
+   Like Agave, an account ladder is only kept when it is above the slot
+   ladder at some percentile, since otherwise it can never change an
+   answer.  Account ladders come from a fixed size pool.  They are
+   released as soon as their slot leaves the window, and if the pool
+   runs out, the oldest slots in the window lose theirs first.
+
+   A query for acct_cnt accounts costs O(acct_cnt*SLOT_MAX) regardless
+   of the size of the blocks. */
+
+#include "../../flamenco/types/fd_types_custom.h"
+
+/* FD_RPC_PRIO_FEES_SLOT_MAX is the number of recent slots summarized,
+   which matches the 150 slots Agave reports. */
+
+#define FD_RPC_PRIO_FEES_SLOT_MAX (150UL)
+
+/* FD_RPC_PRIO_FEES_ACCT_QUERY_MAX is the max number of accounts in a
+   getRecentPrioritizationFees request (MAX_TX_ACCOUNT_LOCKS). */
+
+#define FD_RPC_PRIO_FEES_ACCT_QUERY_MAX (128UL)
+
+/* The ladder has FD_RPC_PRIO_FEES_PCTL_CNT rungs, at the 0th (the
+   minimum, which is what getRecentPrioritizationFees reports by
+   default), 25th, 50th, 75th, 90th, 95th and 100th percentiles.
+   Percentiles are given in basis points. */
+
+#define FD_RPC_PRIO_FEES_PCTL_CNT (7UL)
+#define FD_RPC_PRIO_FEES_PCTL_MAX (10000UL)
+
+/* fd_rpc_prio_fees_acct_t is the compute unit price paid by a
+   transaction that writes to an account. */
+
+struct fd_rpc_prio_fees_acct {
+  fd_pubkey_t key;
+  ulong       fee;
+};
+typedef struct fd_rpc_prio_fees_acct fd_rpc_prio_fees_acct_t;
+
+struct fd_rpc_prio_fees;
+typedef struct fd_rpc_prio_fees fd_rpc_prio_fees_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_rpc_prio_fees_align( void );
+
+/* fd_rpc_prio_fees_footprint returns the footprint of a summary that
+   holds up to acct_max account ladders across the whole window. */
+
+FD_FN_CONST ulong
+fd_rpc_prio_fees_footprint( ulong acct_max );
+
+void *
+fd_rpc_prio_fees_new( void * shmem,
+                      ulong  acct_max,
+                      ulong  seed );
+
+fd_rpc_prio_fees_t *
+fd_rpc_prio_fees_join( void * shfees );
+
+/* fd_rpc_prio_fees_pctl_idx returns the index of the smallest rung of
+   the ladder at or above pctl basis points.  pctl is clamped to
+   FD_RPC_PRIO_FEES_PCTL_MAX. */
+
+FD_FN_PURE ulong
+fd_rpc_prio_fees_pctl_idx( ulong pctl );
+
+/* fd_rpc_prio_fees_add_slot summarizes slot.  txn_fee[i] for i in
+   [0,txn_cnt) is the compute unit price of every non-vote transaction
+   in the block.  acct_fee[i] for i in [0,acct_fee_cnt) has an entry
+   for every writable account of every such transaction.  Both arrays
+   are sorted in place.  Slots that are already out of the window are
+   ignored, and adding a slot again replaces its summary.  Slots that
+   fall out of the window are evicted. */
+
+void
+fd_rpc_prio_fees_add_slot( fd_rpc_prio_fees_t *      fees,
+                           ulong                     slot,
+                           ulong *                   txn_fee,
+                           ulong                     txn_cnt,
+                           fd_rpc_prio_fees_acct_t * acct_fee,
+                           ulong                     acct_fee_cnt );
+
+/* fd_rpc_prio_fees_query computes, for every slot in the window, the
+   prioritization fee a transaction writing to accts[i] for i in
+   [0,acct_cnt) would have needed, at rung pctl_idx of the ladder.  That
+   is the maximum of the slot rung and the rungs of the accounts.
+   Results are stored in ascending slot order in out_slot and out_fee,
+   which must have room for FD_RPC_PRIO_FEES_SLOT_MAX entries.  Returns
+   the number of results. */
+
+ulong
+fd_rpc_prio_fees_query( fd_rpc_prio_fees_t const * fees,
+                        fd_pubkey_t const *        accts,
+                        ulong                      acct_cnt,
+                        ulong                      pctl_idx,
+                        ulong *                    out_slot,
+                        ulong *                    out_fee );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_rpcserver_fd_rpc_prio_fees_h */
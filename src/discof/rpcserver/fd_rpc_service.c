@@ -11,6 +11,7 @@
 #include "../../ballet/base58/fd_base58.h"
 #include "../../ballet/base64/fd_base64.h"
 #include "fd_rpc_history.h"
+#include "fd_rpc_acct_cache.h"
 #include "keywords.h"
 #include <errno.h>
 #include <stdlib.h>
@@ -18,6 +19,9 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <stdarg.h>
+#if FD_HAS_ZSTD
+#include <zstd.h>
+#endif
 
 #include "../../app/firedancer/version.h"
 
@@ -62,6 +66,29 @@ typedef struct fd_perf_sample fd_perf_sample_t;
 #define DEQUE_MAX  720UL /* MAX RPC PERF SAMPLES */
 #include "../../util/tmpl/fd_deque.c"
 
+#define FD_RPC_SIM_PENDING_MAX     1024UL    /* MAX simulateTransaction requests in progress */
+#define FD_RPC_SIM_EXPIRE_INTERVAL 1000000L  /* Check deadlines every millisecond */
+
+#define FD_RPC_ACCT_CACHE_ENT_MAX  16384UL   /* MAX encoded accounts cached */
+#define FD_RPC_ACCT_CACHE_DATA_SZ  (64UL<<20) /* Bytes of encoded accounts cached */
+
+#define FD_RPC_SIM_FREE     0
+#define FD_RPC_SIM_QUEUED   1 /* Waiting for room on an rpcsim tile */
+#define FD_RPC_SIM_INFLIGHT 2 /* Sent to rpcsim tile tile_idx */
+
+struct fd_rpc_sim_pending {
+  int state;
+  ulong conn_id; /* ULONG_MAX once answered or the connection closed */
+  ulong tile_idx;
+  char call_id[64];
+  fd_rpcsim_req_t req;
+};
+
+#define DEQUE_NAME fd_rpc_sim_queue
+#define DEQUE_T    ulong
+#define DEQUE_MAX  FD_RPC_SIM_PENDING_MAX
+#include "../../util/tmpl/fd_deque.c"
+
 struct fd_rpc_global_ctx {
   fd_spad_t * spad;
   fd_webserver_t ws;
@@ -79,6 +106,16 @@ struct fd_rpc_global_ctx {
   fd_multi_epoch_leaders_t * leaders;
   ulong acct_age;
   fd_rpc_history_t * history;
+  fd_rpc_acct_cache_t * acct_cache;
+  ulong sim_tile_cnt;
+  long sim_timeout;
+  struct fd_rpc_sim_pending * sim_pending;
+  ulong * sim_free;
+  ulong sim_free_cnt;
+  ulong * sim_queue;
+  ulong sim_inflight[FD_TOPO_MAX_TILE_OUT_LINKS];
+  ulong sim_seq;
+  long sim_expire_ts;
 };
 typedef struct fd_rpc_global_ctx fd_rpc_global_ctx_t;
 
@@ -118,6 +155,110 @@ read_account( fd_rpc_ctx_t * ctx, fd_funk_rec_key_t * recid, ulong * result_len
   return fd_funk_rec_query_copy( ctx->global->funk, NULL, recid, fd_spad_virtual(ctx->global->spad), result_len );
 }
 
+/* Reads the version of the latest copy of an account, for validating
+   the encoded account cache.  Returns 0 if there is no such account. */
+static int
+read_account_version( fd_rpc_ctx_t * ctx, fd_funk_rec_key_t * recid, fd_rpc_acct_cache_ver_t * ver ) {
+  fd_funk_t * funk = ctx->global->funk;
+  for(;;) {
+    fd_funk_rec_query_t   query[1];
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try( funk, NULL, recid, query );
+    if( rec == NULL ) return 0;
+    ver->rec       = (ulong)rec;
+    ver->val_gaddr = rec->val_gaddr;
+    ver->val_sz    = rec->val_sz;
+    ver->slot      = 0UL;
+    if( ver->val_gaddr && ver->val_sz >= sizeof(fd_account_meta_t) ) {
+      fd_account_meta_t const * meta = (fd_account_meta_t const *)fd_funk_val( rec, fd_funk_wksp( funk ) );
+      ver->slot = meta->slot;
+    }
+    if( FD_LIKELY( fd_funk_rec_query_test( query ) == FD_FUNK_SUCCESS ) ) return 1;
+  }
+}
+
+/* Accounts at least this big are also encoded with base64+zstd when
+   they are cached, since compressing them is the most expensive part of
+   serving them. */
+#define FD_RPC_ACCT_CACHE_ZSTD_MIN (16UL<<10)
+
+/* Bound on the json fd_account_to_json renders around the account
+   data */
+#define FD_RPC_ACCT_CACHE_JSON_MAX (1UL<<10)
+
+/* Appends the encoded account to the reply like fd_account_to_json,
+   serving it from the encoded account cache when possible.  *found is
+   cleared and nothing is appended if the account does not exist.
+   Returns an error message or NULL. */
+static const char *
+reply_account( fd_rpc_ctx_t * ctx, fd_pubkey_t acct, fd_rpc_encoding_t enc, long off, long len, int * found ) {
+  fd_webserver_t *      ws    = &ctx->global->ws;
+  fd_rpc_acct_cache_t * cache = ctx->global->acct_cache;
+  fd_funk_rec_key_t     recid = fd_funk_acc_key(&acct);
+
+  fd_rpc_acct_cache_ver_t ver;
+  if( !read_account_version( ctx, &recid, &ver ) ) {
+    *found = 0;
+    return NULL;
+  }
+  *found = 1;
+
+  fd_rpc_acct_cache_key_t key;
+  memset( &key, 0, sizeof(key) );
+  key.acct = acct;
+  key.off  = off;
+  key.len  = len;
+  key.enc  = (ulong)enc;
+  ulong cached_sz;
+  const char * cached = fd_rpc_acct_cache_query( cache, &key, &ver, &cached_sz );
+  if( cached ) {
+    fd_web_reply_append( ws, cached, cached_sz );
+    return NULL;
+  }
+
+  ulong val_sz;
+  const void * val = read_account( ctx, &recid, &val_sz );
+  if( val == NULL ) {
+    *found = 0;
+    return NULL;
+  }
+  ulong mark = fd_web_reply_mark( ws );
+  const char * err = fd_account_to_json( ws, acct, enc, val, val_sz, off, len, ctx->global->spad );
+  if( err ) return err;
+
+  /* Only cache what was rendered from the version we checked */
+  fd_rpc_acct_cache_ver_t ver2;
+  if( !read_account_version( ctx, &recid, &ver2 ) || memcmp( &ver, &ver2, sizeof(ver) ) ) return NULL;
+
+  ulong        text_sz;
+  const char * text = fd_web_reply_since( ws, mark, &text_sz );
+  if( text ) fd_rpc_acct_cache_insert( cache, &key, &ver, text, text_sz );
+
+#if FD_HAS_ZSTD
+  if( enc != FD_ENC_BASE64_ZSTD && off == FD_LONG_UNSET && len == FD_LONG_UNSET && val_sz >= FD_RPC_ACCT_CACHE_ZSTD_MIN ) {
+    key.enc = (ulong)FD_ENC_BASE64_ZSTD;
+    /* Rendered into scratch so that the reply staged so far is never
+       at risk.  The scratch holds the base64 of the worst case
+       compressed size plus the json around it, and fd_account_to_json
+       needs the worst case compressed size again for itself. */
+    ulong zstd_max    = ZSTD_compressBound( val_sz );
+    ulong scratch_max = 4UL*((zstd_max+2UL)/3UL) + FD_RPC_ACCT_CACHE_JSON_MAX;
+    fd_spad_t * spad  = ctx->global->spad;
+    if( !fd_rpc_acct_cache_query( cache, &key, &ver, &cached_sz ) &&
+        fd_spad_alloc_max( spad, 1UL ) >= scratch_max + zstd_max ) {
+      FD_SPAD_FRAME_BEGIN( spad ) {
+        char * scratch = fd_spad_alloc( spad, 1UL, scratch_max );
+        fd_web_reply_scratch_begin( ws, scratch, scratch_max );
+        err = fd_account_to_json( ws, acct, FD_ENC_BASE64_ZSTD, val, val_sz, off, len, spad );
+        text_sz = fd_web_reply_scratch_end( ws );
+        if( !err && text_sz!=ULONG_MAX ) fd_rpc_acct_cache_insert( cache, &key, &ver, scratch, text_sz );
+      } FD_SPAD_FRAME_END;
+    }
+  }
+#endif
+
+  return NULL;
+}
+
 static ulong
 get_slot_from_commitment_level( struct json_values * values, fd_rpc_ctx_t * ctx ) {
   ulong        commit_str_sz = 0;
@@ -195,15 +336,6 @@ method_getAccountInfo(struct json_values* values, fd_rpc_ctx_t * ctx) {
       return 0;
     }
 
-    ulong val_sz;
-    fd_funk_rec_key_t recid = fd_funk_acc_key(&acct);
-    const void * val        = read_account(ctx, &recid, &val_sz);
-    if (val == NULL) {
-      fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":null},\"id\":%s}" CRLF,
-                           fd_rpc_history_latest_slot( ctx->global->history ), ctx->call_id);
-      return 0;
-    }
-
     static const uint PATH3[5] = {
       (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
       (JSON_TOKEN_LBRACKET<<16) | 1,
@@ -227,11 +359,13 @@ method_getAccountInfo(struct json_values* values, fd_rpc_ctx_t * ctx) {
 
     fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":",
                          fd_rpc_history_latest_slot( ctx->global->history ) );
-    const char * err = fd_account_to_json( ws, acct, enc, val, val_sz, off, len, ctx->global->spad );
+    int found;
+    const char * err = reply_account( ctx, acct, enc, off, len, &found );
     if( err ) {
       fd_method_error(ctx, -1, "%s", err);
       return 0;
     }
+    if( !found ) EMIT_SIMPLE("null");
     fd_web_reply_sprintf(ws, "},\"id\":%s}" CRLF, ctx->call_id);
 
   } FD_SPAD_FRAME_END;
@@ -1033,19 +1167,13 @@ method_getMultipleAccounts(struct json_values* values, fd_rpc_ctx_t * ctx) {
         return 0;
       }
       FD_SPAD_FRAME_BEGIN( ctx->global->spad ) {
-        ulong val_sz;
-        fd_funk_rec_key_t recid = fd_funk_acc_key(&acct);
-        const void * val        = read_account(ctx, &recid, &val_sz);
-        if (val == NULL) {
-          fd_web_reply_sprintf(ws, "null");
-          continue;
-        }
-
-        const char * err = fd_account_to_json( ws, acct, enc, val, val_sz, FD_LONG_UNSET, FD_LONG_UNSET, ctx->global->spad );
+        int found;
+        const char * err = reply_account( ctx, acct, enc, FD_LONG_UNSET, FD_LONG_UNSET, &found );
         if( err ) {
           fd_method_error(ctx, -1, "%s", err);
           return 0;
         }
+        if( !found ) fd_web_reply_sprintf(ws, "null");
       } FD_SPAD_FRAME_END;
     }
 
@@ -1103,12 +1231,63 @@ method_getRecentPerformanceSamples(struct json_values* values, fd_rpc_ctx_t * ct
 }
 
 // Implementation of the "getRecentPrioritizationFees" methods
+// Answered from the per-slot summaries kept by the history, so the
+// cost only depends on the number of accounts requested.  As an
+// extension, an optional "percentile" config (in basis points) selects
+// a rung of the fee ladder instead of the minimum.
 static int
 method_getRecentPrioritizationFees(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "getRecentPrioritizationFees is not implemented" ));
-  fd_method_error(ctx, -1, "getRecentPrioritizationFees is not implemented");
+  fd_webserver_t * ws = &ctx->global->ws;
+
+  fd_pubkey_t accts[ FD_RPC_PRIO_FEES_ACCT_QUERY_MAX ];
+  ulong acct_cnt = 0;
+  for ( ulong i = 0; ; ++i ) {
+    uint path[4];
+    path[0] = (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS;
+    path[1] = (JSON_TOKEN_LBRACKET<<16) | 0;
+    path[2] = (uint) ((JSON_TOKEN_LBRACKET<<16) | i);
+    path[3] = (JSON_TOKEN_STRING<<16);
+    ulong arg_sz = 0;
+    const void* arg = json_get_value(values, path, 4, &arg_sz);
+    if (arg == NULL)
+      // End of list
+      break;
+
+    if( acct_cnt == FD_RPC_PRIO_FEES_ACCT_QUERY_MAX ) {
+      fd_method_error(ctx, -1, "Too many inputs provided; max %lu", FD_RPC_PRIO_FEES_ACCT_QUERY_MAX);
+      return 0;
+    }
+    if( fd_base58_decode_32((const char *)arg, accts[acct_cnt].uc) == NULL ) {
+      fd_method_error(ctx, -1, "invalid base58 encoding");
+      return 0;
+    }
+    acct_cnt++;
+  }
+
+  static const uint PCTL_PATH[4] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
+    (JSON_TOKEN_LBRACKET<<16) | 1,
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PERCENTILE,
+    (JSON_TOKEN_INTEGER<<16)
+  };
+  ulong pctl_sz = 0;
+  const void* pctl_ptr = json_get_value(values, PCTL_PATH, 4, &pctl_sz);
+  ulong pctl = ( pctl_ptr ? *(const ulong*)pctl_ptr : 0UL );
+  if( pctl > FD_RPC_PRIO_FEES_PCTL_MAX ) {
+    fd_method_error(ctx, -1, "Percentile is too big; max value is %lu", FD_RPC_PRIO_FEES_PCTL_MAX);
+    return 0;
+  }
+
+  ulong out_slot[ FD_RPC_PRIO_FEES_SLOT_MAX ];
+  ulong out_fee[ FD_RPC_PRIO_FEES_SLOT_MAX ];
+  ulong cnt = fd_rpc_prio_fees_query( fd_rpc_history_prio_fees( ctx->global->history ), accts, acct_cnt,
+                                      fd_rpc_prio_fees_pctl_idx( pctl ), out_slot, out_fee );
+
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":[");
+  for( ulong i = 0; i < cnt; ++i ) {
+    fd_web_reply_sprintf(ws, "%s{\"slot\":%lu,\"prioritizationFee\":%lu}", (i ? "," : ""), out_slot[i], out_fee[i]);
+  }
+  fd_web_reply_sprintf(ws, "],\"id\":%s}" CRLF, ctx->call_id);
   return 0;
 }
 
@@ -1665,10 +1844,10 @@ method_requestAirdrop(struct json_values* values, fd_rpc_ctx_t * ctx) {
   return 0;
 }
 
-// Implementation of the "sendTransaction" methods
+// Decode the transaction passed as first parameter of sendTransaction
+// and simulateTransaction. Replies with an error and returns -1 on failure.
 static int
-method_sendTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  fd_webserver_t * ws = &ctx->global->ws;
+decode_txn_param(struct json_values* values, fd_rpc_ctx_t * ctx, const char * method, uchar data[FD_TXN_MTU], ulong * data_sz) {
   static const uint ENCPATH[4] = {
     (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
     (JSON_TOKEN_LBRACKET<<16) | 1,
@@ -1684,7 +1863,7 @@ method_sendTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
     enc = FD_ENC_BASE64;
   else {
     fd_method_error(ctx, -1, "invalid data encoding %s", (const char*)enc_str);
-    return 0;
+    return -1;
   }
 
   static const uint DATAPATH[3] = {
@@ -1695,29 +1874,40 @@ method_sendTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
   ulong arg_sz = 0;
   const void* arg = json_get_value(values, DATAPATH, 3, &arg_sz);
   if (arg == NULL) {
-    fd_method_error(ctx, -1, "sendTransaction requires a string as first parameter");
-    return 0;
+    fd_method_error(ctx, -1, "%s requires a string as first parameter", method);
+    return -1;
   }
 
-  uchar data[FD_TXN_MTU];
-  ulong data_sz = FD_TXN_MTU;
+  *data_sz = FD_TXN_MTU;
   if( enc == FD_ENC_BASE58 ) {
-    if( b58tobin( data, &data_sz, (const char*)arg, arg_sz ) ) {
+    if( b58tobin( data, data_sz, (const char*)arg, arg_sz ) ) {
       fd_method_error(ctx, -1, "failed to decode base58 data");
-      return 0;
+      return -1;
     }
   } else {
     FD_TEST( enc == FD_ENC_BASE64 );
     if( FD_BASE64_DEC_SZ( arg_sz ) > FD_TXN_MTU ) {
       fd_method_error(ctx, -1, "failed to decode base64 data");
-      return 0;
+      return -1;
     }
     long res = fd_base64_decode( data, (const char*)arg, arg_sz );
     if( res < 0 ) {
       fd_method_error(ctx, -1, "failed to decode base64 data");
-      return 0;
+      return -1;
     }
-    data_sz = (ulong)res;
+    *data_sz = (ulong)res;
+  }
+  return 0;
+}
+
+// Implementation of the "sendTransaction" methods
+static int
+method_sendTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
+  fd_webserver_t * ws = &ctx->global->ws;
+  uchar data[FD_TXN_MTU];
+  ulong data_sz;
+  if( decode_txn_param( values, ctx, "sendTransaction", data, &data_sz ) ) {
+    return 0;
   }
 
   FD_LOG_NOTICE(( "received transaction of size %lu", data_sz ));
@@ -1746,15 +1936,232 @@ method_sendTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
 }
 
 // Implementation of the "simulateTransaction" methods
+
+// The transaction is executed asynchronously by the rpcsim tiles, so
+// the reply is deferred until fd_rpc_sim_result or the deadline
 static int
 method_simulateTransaction(struct json_values* values, fd_rpc_ctx_t * ctx) {
-  (void)values;
-  (void)ctx;
-  FD_LOG_WARNING(( "simulateTransaction is not implemented" ));
-  fd_method_error(ctx, -1, "simulateTransaction is not implemented");
+  fd_rpc_global_ctx_t * gctx = ctx->global;
+  if( !gctx->sim_tile_cnt ) {
+    fd_method_error(ctx, -1, "simulateTransaction is not enabled");
+    return 0;
+  }
+
+  uchar data[FD_TXN_MTU];
+  ulong data_sz;
+  if( decode_txn_param( values, ctx, "simulateTransaction", data, &data_sz ) ) {
+    return 0;
+  }
+
+  uchar txn_out[FD_TXN_MAX_SZ];
+  if( !fd_txn_parse( data, data_sz, txn_out, NULL ) ) {
+    fd_method_error(ctx, -1, "failed to parse transaction");
+    return 0;
+  }
+
+  static const uint SIGVERIFYPATH[4] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
+    (JSON_TOKEN_LBRACKET<<16) | 1,
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_SIGVERIFY,
+    (JSON_TOKEN_BOOL<<16)
+  };
+  static const uint REPLACEPATH[4] = {
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_PARAMS,
+    (JSON_TOKEN_LBRACKET<<16) | 1,
+    (JSON_TOKEN_LBRACE<<16) | KEYW_JSON_REPLACERECENTBLOCKHASH,
+    (JSON_TOKEN_BOOL<<16)
+  };
+  uint flags = 0;
+  ulong arg_sz = 0;
+  const void* arg = json_get_value(values, SIGVERIFYPATH, 4, &arg_sz);
+  if( arg && *(const int *)arg ) flags |= FD_RPCSIM_FLAG_SIG_VERIFY;
+  arg = json_get_value(values, REPLACEPATH, 4, &arg_sz);
+  if( arg && *(const int *)arg ) flags |= FD_RPCSIM_FLAG_REPLACE_BLOCKHASH;
+  if( flags == (FD_RPCSIM_FLAG_SIG_VERIFY | FD_RPCSIM_FLAG_REPLACE_BLOCKHASH) ) {
+    fd_method_error(ctx, -1, "sigVerify may not be used with replaceRecentBlockhash");
+    return 0;
+  }
+
+  ulong slot = get_slot_from_commitment_level( values, ctx );
+  if( slot == FD_SLOT_NULL ) return 0;
+
+  if( !gctx->sim_free_cnt ) {
+    fd_method_error(ctx, -1, "too many simulations in progress");
+    return 0;
+  }
+  ulong conn_id = fd_web_reply_defer( &gctx->ws );
+  if( conn_id == ULONG_MAX ) {
+    fd_method_error(ctx, -1, "simulateTransaction is not supported in batches or over websockets");
+    return 0;
+  }
+
+  ulong idx = gctx->sim_free[ --gctx->sim_free_cnt ];
+  struct fd_rpc_sim_pending * p = &gctx->sim_pending[ idx ];
+  p->state   = FD_RPC_SIM_QUEUED;
+  p->conn_id = conn_id;
+  memcpy( p->call_id, ctx->call_id, sizeof(p->call_id) );
+  p->req.req_id     = (gctx->sim_seq++)*FD_RPC_SIM_PENDING_MAX + idx;
+  p->req.slot       = slot;
+  p->req.deadline   = fd_log_wallclock() + gctx->sim_timeout;
+  p->req.flags      = flags;
+  p->req.payload_sz = (ushort)data_sz;
+  memcpy( p->req.payload, data, data_sz );
+  fd_rpc_sim_queue_push_tail( gctx->sim_queue, idx );
   return 0;
 }
 
+// Release a simulateTransaction request
+static void
+sim_release( fd_rpc_global_ctx_t * gctx, ulong idx ) {
+  gctx->sim_pending[ idx ].state = FD_RPC_SIM_FREE;
+  gctx->sim_free[ gctx->sim_free_cnt++ ] = idx;
+}
+
+// Answer a deferred simulateTransaction request with an error
+static void
+sim_reply_error( fd_rpc_global_ctx_t * gctx, struct fd_rpc_sim_pending * p, const char * text ) {
+  fd_webserver_t * ws = &gctx->ws;
+  fd_web_reply_new( ws );
+  fd_web_reply_error( ws, -1, text, p->call_id );
+  fd_web_reply_deferred( ws, p->conn_id );
+  p->conn_id = ULONG_MAX;
+}
+
+// Answer a deferred simulateTransaction request with the result
+static void
+sim_reply( fd_rpc_global_ctx_t * gctx, struct fd_rpc_sim_pending * p, fd_rpcsim_res_t const * res ) {
+  fd_webserver_t * ws = &gctx->ws;
+  char text[128];
+  switch( res->status ) {
+  case FD_RPCSIM_STATUS_OK:
+    break;
+  case FD_RPCSIM_STATUS_EXPIRED:
+    sim_reply_error( gctx, p, "simulation timed out" );
+    return;
+  case FD_RPCSIM_STATUS_NO_SLOT:
+    snprintf( text, sizeof(text), "slot %lu is not available for simulation", res->slot );
+    sim_reply_error( gctx, p, text );
+    return;
+  case FD_RPCSIM_STATUS_PRUNED:
+    snprintf( text, sizeof(text), "slot %lu was pruned during simulation", res->slot );
+    sim_reply_error( gctx, p, text );
+    return;
+  default:
+    sim_reply_error( gctx, p, "failed to parse transaction" );
+    return;
+  }
+
+  fd_web_reply_new( ws );
+  fd_web_reply_sprintf(ws, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"apiVersion\":\"" FIREDANCER_VERSION "\",\"slot\":%lu},\"value\":{\"err\":",
+                       res->slot);
+  fd_txn_err_to_json( ws, res->txn_err, res->instr_err, res->instr_err_idx, res->custom_err );
+
+  /* Logs are rendered as a sequence of records, each a kind byte
+     followed by a varint length and the message */
+  EMIT_SIMPLE(",\"logs\":[");
+  uchar const * log     = res->logs;
+  uchar const * log_end = res->logs + fd_ulong_min( res->logs_sz, sizeof(res->logs) );
+  char msg[ FD_LOG_COLLECTOR_MAX + 1 ];
+  for( int first = 1; log + 2 <= log_end; first = 0 ) {
+    ulong msg_sz = log[1] & 0x7FUL;
+    ulong hdr_sz = 2;
+    if( log[1] & 0x80U ) {
+      if( log + 3 > log_end ) break;
+      msg_sz |= (ulong)log[2] << 7;
+      hdr_sz  = 3;
+    }
+    if( log + hdr_sz + msg_sz > log_end || msg_sz > FD_LOG_COLLECTOR_MAX ) break;
+    memcpy( msg, log + hdr_sz, msg_sz );
+    msg[ msg_sz ] = '\0';
+    if( !first ) EMIT_SIMPLE(",");
+    fd_web_reply_encode_json_string( ws, msg );
+    log += hdr_sz + msg_sz;
+  }
+  fd_web_reply_sprintf(ws, "],\"accounts\":null,\"unitsConsumed\":%lu,\"returnData\":", res->cu_consumed);
+  if( res->return_data_sz ) {
+    EMIT_SIMPLE("{\"programId\":\"");
+    fd_web_reply_encode_base58( ws, &res->return_program_id, sizeof(fd_pubkey_t) );
+    EMIT_SIMPLE("\",\"data\":[\"");
+    fd_web_reply_encode_base64( ws, res->return_data, fd_ulong_min( res->return_data_sz, sizeof(res->return_data) ) );
+    EMIT_SIMPLE("\",\"base64\"]}");
+  } else {
+    EMIT_SIMPLE("null");
+  }
+  EMIT_SIMPLE(",\"innerInstructions\":null,\"replacementBlockhash\":");
+  if( p->req.flags & FD_RPCSIM_FLAG_REPLACE_BLOCKHASH ) {
+    EMIT_SIMPLE("{\"blockhash\":\"");
+    fd_web_reply_encode_base58( ws, &res->blockhash, sizeof(fd_hash_t) );
+    fd_web_reply_sprintf(ws, "\",\"lastValidBlockHeight\":%lu}", res->last_valid_block_height);
+  } else {
+    EMIT_SIMPLE("null");
+  }
+  fd_web_reply_sprintf(ws, "}},\"id\":%s}" CRLF, p->call_id);
+  fd_web_reply_deferred( ws, p->conn_id );
+  p->conn_id = ULONG_MAX;
+}
+
+// Answer the simulateTransaction requests that are past their deadline.
+// The entries are released once they leave the queue or their result
+// comes back.
+static void
+sim_expire( fd_rpc_global_ctx_t * gctx ) {
+  if( gctx->sim_free_cnt == FD_RPC_SIM_PENDING_MAX ) return;
+  long now = fd_log_wallclock();
+  if( now < gctx->sim_expire_ts ) return;
+  gctx->sim_expire_ts = now + FD_RPC_SIM_EXPIRE_INTERVAL;
+  for( ulong idx = 0; idx < FD_RPC_SIM_PENDING_MAX; ++idx ) {
+    struct fd_rpc_sim_pending * p = &gctx->sim_pending[ idx ];
+    if( p->state != FD_RPC_SIM_FREE && p->conn_id != ULONG_MAX && p->req.deadline < now ) {
+      sim_reply_error( gctx, p, "simulation timed out" );
+    }
+  }
+}
+
+fd_rpcsim_req_t const *
+fd_rpc_sim_next(fd_rpc_ctx_t * ctx, ulong * tile_idx) {
+  fd_rpc_global_ctx_t * gctx = ctx->global;
+  sim_expire( gctx );
+  while( !fd_rpc_sim_queue_empty( gctx->sim_queue ) ) {
+    ulong idx = *fd_rpc_sim_queue_peek_head( gctx->sim_queue );
+    struct fd_rpc_sim_pending * p = &gctx->sim_pending[ idx ];
+    if( p->conn_id == ULONG_MAX ) {
+      /* Already answered, or the client went away */
+      fd_rpc_sim_queue_pop_head( gctx->sim_queue );
+      sim_release( gctx, idx );
+      continue;
+    }
+
+    /* Send to the least loaded tile with room */
+    ulong best = ULONG_MAX;
+    for( ulong i = 0; i < gctx->sim_tile_cnt; ++i ) {
+      if( gctx->sim_inflight[i] < FD_RPCSIM_INFLIGHT_MAX &&
+          ( best == ULONG_MAX || gctx->sim_inflight[i] < gctx->sim_inflight[best] ) ) best = i;
+    }
+    if( best == ULONG_MAX ) return NULL;
+
+    fd_rpc_sim_queue_pop_head( gctx->sim_queue );
+    p->state    = FD_RPC_SIM_INFLIGHT;
+    p->tile_idx = best;
+    gctx->sim_inflight[best]++;
+    *tile_idx = best;
+    return &p->req;
+  }
+  return NULL;
+}
+
+void
+fd_rpc_sim_result(fd_rpc_ctx_t * ctx, ulong tile_idx, fd_rpcsim_res_t const * res) {
+  fd_rpc_global_ctx_t * gctx = ctx->global;
+  ulong idx = res->req_id % FD_RPC_SIM_PENDING_MAX;
+  struct fd_rpc_sim_pending * p = &gctx->sim_pending[ idx ];
+  if( FD_UNLIKELY( p->state != FD_RPC_SIM_INFLIGHT || p->req.req_id != res->req_id || p->tile_idx != tile_idx ) ) {
+    FD_LOG_ERR(( "unexpected simulation result %lu from rpcsim tile %lu", res->req_id, tile_idx ));
+  }
+  gctx->sim_inflight[tile_idx]--;
+  if( p->conn_id != ULONG_MAX ) sim_reply( gctx, p, res );
+  sim_release( gctx, idx );
+}
+
 // Top level method dispatch function
 void
 fd_webserver_method_generic(struct json_values* values, void * cb_arg) {
@@ -2293,6 +2700,26 @@ fd_rpc_create_ctx(fd_rpcserver_args_t * args, fd_rpc_ctx_t ** ctx_p) {
 
   gctx->history = fd_rpc_history_create(args);
 
+  mem = fd_valloc_malloc( valloc, fd_rpc_acct_cache_align(), fd_rpc_acct_cache_footprint( FD_RPC_ACCT_CACHE_ENT_MAX, FD_RPC_ACCT_CACHE_DATA_SZ ) );
+  gctx->acct_cache = fd_rpc_acct_cache_join( fd_rpc_acct_cache_new( mem, FD_RPC_ACCT_CACHE_ENT_MAX, FD_RPC_ACCT_CACHE_DATA_SZ, 0x5a3c0de1UL ) );
+  FD_TEST( gctx->acct_cache );
+
+  if( args->sim_tile_cnt > FD_TOPO_MAX_TILE_OUT_LINKS ) {
+    FD_LOG_ERR(( "too many rpcsim tiles %lu", args->sim_tile_cnt ));
+  }
+  gctx->sim_tile_cnt = args->sim_tile_cnt;
+  gctx->sim_timeout  = args->sim_timeout;
+  gctx->sim_pending  = (struct fd_rpc_sim_pending *)fd_valloc_malloc( valloc, alignof(struct fd_rpc_sim_pending), FD_RPC_SIM_PENDING_MAX*sizeof(struct fd_rpc_sim_pending) );
+  gctx->sim_free     = (ulong *)fd_valloc_malloc( valloc, alignof(ulong), FD_RPC_SIM_PENDING_MAX*sizeof(ulong) );
+  for( ulong i = 0; i < FD_RPC_SIM_PENDING_MAX; ++i ) {
+    gctx->sim_pending[i].state = FD_RPC_SIM_FREE;
+    gctx->sim_free[i] = FD_RPC_SIM_PENDING_MAX-1-i;
+  }
+  gctx->sim_free_cnt = FD_RPC_SIM_PENDING_MAX;
+  mem = fd_valloc_malloc( valloc, fd_rpc_sim_queue_align(), fd_rpc_sim_queue_footprint() );
+  gctx->sim_queue = fd_rpc_sim_queue_join( fd_rpc_sim_queue_new( mem ) );
+  FD_TEST( gctx->sim_queue );
+
   FD_LOG_NOTICE(( "starting web server on port %u", (uint)args->port ));
   if (fd_webserver_start(args->port, args->params, gctx->spad, &gctx->ws, ctx))
     FD_LOG_ERR(("fd_webserver_start failed"));
@@ -2331,6 +2758,18 @@ fd_webserver_ws_closed(ulong conn_id, void * cb_arg) {
   }
 }
 
+void
+fd_webserver_http_closed(ulong conn_id, void * cb_arg) {
+  fd_rpc_ctx_t * ctx = ( fd_rpc_ctx_t *)cb_arg;
+  fd_rpc_global_ctx_t * gctx = ctx->global;
+  if( gctx->sim_free_cnt == FD_RPC_SIM_PENDING_MAX ) return;
+  for( ulong i = 0; i < FD_RPC_SIM_PENDING_MAX; ++i ) {
+    if( gctx->sim_pending[i].state != FD_RPC_SIM_FREE && gctx->sim_pending[i].conn_id == conn_id ) {
+      gctx->sim_pending[i].conn_id = ULONG_MAX;
+    }
+  }
+}
+
 void
 fd_rpc_replay_during_frag( fd_rpc_ctx_t * ctx, fd_replay_notif_msg_t * state, void const * msg, int sz ) {
   (void)ctx;
@@ -2,6 +2,7 @@
 #define HEADER_fd_src_discof_rpcserver_fd_rpc_service_h
 
 #include "fd_block_to_json.h"
+#include "fd_rpcsim.h"
 #include "../replay/fd_replay_notif.h"
 
 #include "../../disco/topo/fd_topo.h"
@@ -27,6 +28,8 @@ struct fd_rpcserver_args {
   uint                       txn_index_max;
   uint                       acct_index_max;
   char                       history_file[ PATH_MAX ];
+  ulong                      sim_tile_cnt; /* Number of rpcsim tiles, 0 disables simulateTransaction */
+  long                       sim_timeout;  /* Nanoseconds a simulation may take, including queueing */
 
   /* Bump allocator */
   fd_spad_t                * spad;
@@ -49,4 +52,16 @@ void fd_rpc_stake_during_frag(fd_rpc_ctx_t * ctx, fd_multi_epoch_leaders_t * sta
 
 void fd_rpc_stake_after_frag(fd_rpc_ctx_t * ctx, fd_multi_epoch_leaders_t * state);
 
+/* fd_rpc_sim_next pops the next simulateTransaction request to send to
+   an rpcsim tile, if there is one and a tile has room for it.  Returns
+   the request, which stays valid until the next call into the service,
+   and stores the index of the tile to send it to in *tile_idx.  Returns
+   NULL if there is nothing to send.  Also answers requests that are
+   past their deadline, so it should be called frequently. */
+fd_rpcsim_req_t const * fd_rpc_sim_next(fd_rpc_ctx_t * ctx, ulong * tile_idx);
+
+/* fd_rpc_sim_result answers the simulateTransaction request with the
+   result received from rpcsim tile tile_idx. */
+void fd_rpc_sim_result(fd_rpc_ctx_t * ctx, ulong tile_idx, fd_rpcsim_res_t const * res);
+
 #endif /* HEADER_fd_src_discof_rpcserver_fd_rpc_service_h */
@@ -22,6 +22,15 @@
 
 #define REPLAY_NOTIF_IDX 0
 #define STAKE_IN_IDX     1
+#define SIM_IN_IDX       2 /* Results of rpcsim tile i are on in link SIM_IN_IDX+i */
+
+struct fd_rpcserv_sim_out {
+  fd_wksp_t * mem;
+  ulong       chunk0;
+  ulong       wmark;
+  ulong       chunk;
+};
+typedef struct fd_rpcserv_sim_out fd_rpcserv_sim_out_t;
 
 struct fd_rpcserv_tile_ctx {
   fd_rpcserver_args_t args;
@@ -41,6 +50,14 @@ struct fd_rpcserv_tile_ctx {
 
   int blockstore_fd;
 
+  /* Requests to rpcsim tile i are on out link i */
+  ulong                sim_cnt;
+  fd_rpcserv_sim_out_t sim_out[ FD_TOPO_MAX_TILE_OUT_LINKS ];
+  fd_wksp_t *          sim_in_mem   [ FD_TOPO_MAX_TILE_OUT_LINKS ];
+  ulong                sim_in_chunk0[ FD_TOPO_MAX_TILE_OUT_LINKS ];
+  ulong                sim_in_wmark [ FD_TOPO_MAX_TILE_OUT_LINKS ];
+  fd_rpcsim_res_t      sim_res;
+
   uchar __attribute__((aligned(FD_MULTI_EPOCH_LEADERS_ALIGN))) mleaders_mem[ FD_MULTI_EPOCH_LEADERS_FOOTPRINT ];
 };
 typedef struct fd_rpcserv_tile_ctx fd_rpcserv_tile_ctx_t;
@@ -82,6 +99,27 @@ before_credit( fd_rpcserv_tile_ctx_t * ctx,
   *charge_busy = fd_rpc_ws_poll( ctx->ctx );
 }
 
+static inline void
+after_credit( fd_rpcserv_tile_ctx_t * ctx,
+              fd_stem_context_t *     stem,
+              int *                   opt_poll_in,
+              int *                   charge_busy ) {
+  (void)opt_poll_in;
+  if( FD_LIKELY( !ctx->sim_cnt ) ) return;
+
+  /* At most one request per call, as the stem burst is one */
+  ulong tile_idx;
+  fd_rpcsim_req_t const * req = fd_rpc_sim_next( ctx->ctx, &tile_idx );
+  if( FD_LIKELY( !req ) ) return;
+
+  fd_rpcserv_sim_out_t * out = &ctx->sim_out[ tile_idx ];
+  fd_memcpy( fd_chunk_to_laddr( out->mem, out->chunk ), req, sizeof(fd_rpcsim_req_t) );
+  ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
+  fd_stem_publish( stem, tile_idx, req->req_id, out->chunk, sizeof(fd_rpcsim_req_t), 0UL, 0UL, tspub );
+  out->chunk = fd_dcache_compact_next( out->chunk, sizeof(fd_rpcsim_req_t), out->chunk0, out->wmark );
+  *charge_busy = 1;
+}
+
 static void
 during_frag( fd_rpcserv_tile_ctx_t * ctx,
              ulong                   in_idx,
@@ -105,6 +143,14 @@ during_frag( fd_rpcserv_tile_ctx_t * ctx,
     }
     fd_rpc_stake_during_frag( ctx->ctx, ctx->args.leaders, fd_chunk_to_laddr_const( ctx->stake_in_mem, chunk ), (int)sz );
 
+  } else if( FD_LIKELY( in_idx-SIM_IN_IDX<ctx->sim_cnt ) ) {
+    ulong i = in_idx-SIM_IN_IDX;
+    if( FD_UNLIKELY( chunk<ctx->sim_in_chunk0[ i ] || chunk>ctx->sim_in_wmark[ i ] || sz>sizeof(fd_rpcsim_res_t) ) ) {
+      FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz,
+                   ctx->sim_in_chunk0[ i ], ctx->sim_in_wmark[ i ] ));
+    }
+    fd_memcpy( &ctx->sim_res, fd_chunk_to_laddr_const( ctx->sim_in_mem[ i ], chunk ), sz );
+
   } else {
     FD_LOG_ERR(("Unknown in_idx %lu for rpc", in_idx));
   }
@@ -130,6 +176,8 @@ after_frag( fd_rpcserv_tile_ctx_t * ctx,
     fd_rpc_replay_after_frag( ctx->ctx, &ctx->replay_notif_in_state );
   } else if( FD_UNLIKELY( in_idx==STAKE_IN_IDX ) ) {
     fd_rpc_stake_after_frag( ctx->ctx, ctx->args.leaders );
+  } else if( FD_LIKELY( in_idx-SIM_IN_IDX<ctx->sim_cnt ) ) {
+    fd_rpc_sim_result( ctx->ctx, in_idx-SIM_IN_IDX, &ctx->sim_res );
   } else {
     FD_LOG_ERR(("Unknown in_idx %lu for rpc", in_idx));
   }
@@ -183,6 +231,9 @@ privileged_init( fd_topo_t *      topo,
   args->acct_index_max = tile->rpcserv.acct_index_max;
   strncpy( args->history_file, tile->rpcserv.history_file, sizeof(args->history_file) );
 
+  args->sim_tile_cnt = tile->out_cnt;
+  args->sim_timeout  = (long)tile->rpcserv.sim_timeout_millis * 1000000L;
+
   fd_spad_push( args->spad ); /* We close this out when we stop the server */
   fd_rpc_create_ctx( args, &ctx->ctx );
 
@@ -195,16 +246,18 @@ unprivileged_init( fd_topo_t *      topo,
                    fd_topo_tile_t * tile ) {
   void * scratch = fd_topo_obj_laddr( topo, tile->tile_obj_id );
 
-  if( FD_UNLIKELY( tile->in_cnt != 2 ||
+  if( FD_UNLIKELY( tile->in_cnt != 2+tile->out_cnt ||
                    strcmp( topo->links[ tile->in_link_id[ REPLAY_NOTIF_IDX ] ].name, "replay_notif") ||
                    strcmp( topo->links[ tile->in_link_id[ STAKE_IN_IDX ] ].name, "stake_out" ) ) ) {
     FD_LOG_ERR(( "repair tile has none or unexpected input links %lu %s %s",
                  tile->in_cnt, topo->links[ tile->in_link_id[ 0 ] ].name, topo->links[ tile->in_link_id[ 1 ] ].name ));
   }
 
-  if( FD_UNLIKELY( tile->out_cnt != 0 ) ) {
-    FD_LOG_ERR(( "repair tile has none or unexpected output links %lu %s %s",
-                 tile->out_cnt, topo->links[ tile->out_link_id[ 0 ] ].name, topo->links[ tile->out_link_id[ 1 ] ].name ));
+  for( ulong i=0UL; i<tile->out_cnt; i++ ) {
+    if( FD_UNLIKELY( fd_topo_find_tile_out_link( topo, tile, "rpc_sim", i )!=i ||
+                     fd_topo_find_tile_in_link ( topo, tile, "sim_rpc", i )!=SIM_IN_IDX+i ) ) {
+      FD_LOG_ERR(( "rpcsrv tile has unexpected links for rpcsim tile %lu", i ));
+    }
   }
 
   /* Scratch mem setup */
@@ -226,6 +279,21 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->stake_in_chunk0 = fd_dcache_compact_chunk0( ctx->stake_in_mem, stake_in_link->dcache );
   ctx->stake_in_wmark  = fd_dcache_compact_wmark ( ctx->stake_in_mem, stake_in_link->dcache, stake_in_link->mtu );
 
+  ctx->sim_cnt = tile->out_cnt;
+  for( ulong i=0UL; i<ctx->sim_cnt; i++ ) {
+    fd_topo_link_t * sim_in_link = &topo->links[ tile->in_link_id[ SIM_IN_IDX+i ] ];
+    ctx->sim_in_mem[ i ]    = topo->workspaces[ topo->objs[ sim_in_link->dcache_obj_id ].wksp_id ].wksp;
+    ctx->sim_in_chunk0[ i ] = fd_dcache_compact_chunk0( ctx->sim_in_mem[ i ], sim_in_link->dcache );
+    ctx->sim_in_wmark[ i ]  = fd_dcache_compact_wmark ( ctx->sim_in_mem[ i ], sim_in_link->dcache, sim_in_link->mtu );
+
+    fd_topo_link_t * sim_out_link = &topo->links[ tile->out_link_id[ i ] ];
+    fd_rpcserv_sim_out_t * out = &ctx->sim_out[ i ];
+    out->mem    = topo->workspaces[ topo->objs[ sim_out_link->dcache_obj_id ].wksp_id ].wksp;
+    out->chunk0 = fd_dcache_compact_chunk0( out->mem, sim_out_link->dcache );
+    out->wmark  = fd_dcache_compact_wmark ( out->mem, sim_out_link->dcache, sim_out_link->mtu );
+    out->chunk  = out->chunk0;
+  }
+
   fd_rpcserver_args_t * args = &ctx->args;
   if( FD_UNLIKELY( !fd_funk_join( args->funk, fd_topo_obj_laddr( topo, tile->rpcserv.funk_obj_id ) ) ) ) {
     FD_LOG_ERR(( "Failed to join database cache" ));
@@ -273,6 +341,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 #define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_rpcserv_tile_ctx_t)
 
 #define STEM_CALLBACK_BEFORE_CREDIT before_credit
+#define STEM_CALLBACK_AFTER_CREDIT  after_credit
 #define STEM_CALLBACK_DURING_FRAG   during_frag
 #define STEM_CALLBACK_AFTER_FRAG    after_frag
 
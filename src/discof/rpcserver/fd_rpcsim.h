@@ -0,0 +1,67 @@
+#ifndef HEADER_fd_src_discof_rpcserver_fd_rpcsim_h
+#define HEADER_fd_src_discof_rpcserver_fd_rpcsim_h
+
+#include "../../ballet/txn/fd_txn.h"
+#include "../../flamenco/types/fd_types_custom.h"
+#include "../../flamenco/log_collector/fd_log_collector_base.h"
+
+/* Messages exchanged between the rpcsrv tile and the rpcsim tiles,
+   which execute simulateTransaction requests.  Each rpcsim tile has an
+   rpc_sim link carrying requests from rpcsrv and a sim_rpc link
+   carrying results back.  Every request gets exactly one result,
+   matched by req_id.  The rpcsrv tile never has more than
+   FD_RPCSIM_INFLIGHT_MAX requests outstanding on a tile, well below the
+   depth of the links, so it is never backpressured by a busy rpcsim
+   tile. */
+
+#define FD_RPCSIM_FLAG_SIG_VERIFY        (1U) /* Verify the signatures of the transaction */
+#define FD_RPCSIM_FLAG_REPLACE_BLOCKHASH (2U) /* Replace the recent blockhash with the latest one of the bank */
+
+#define FD_RPCSIM_STATUS_OK      (0) /* Simulated, see txn_err for the outcome */
+#define FD_RPCSIM_STATUS_EXPIRED (1) /* Deadline passed before the request was executed */
+#define FD_RPCSIM_STATUS_NO_SLOT (2) /* No bank or funk transaction for the slot */
+#define FD_RPCSIM_STATUS_PRUNED  (3) /* The slot was pruned while the transaction was executing */
+#define FD_RPCSIM_STATUS_PARSE   (4) /* The transaction could not be parsed */
+
+#define FD_RPCSIM_LINK_DEPTH   (128UL)
+#define FD_RPCSIM_INFLIGHT_MAX (FD_RPCSIM_LINK_DEPTH/2UL)
+
+struct __attribute__((aligned(64UL))) fd_rpcsim_req {
+  ulong  req_id;
+  ulong  slot;     /* Slot whose bank and funk transaction to execute against */
+  long   deadline; /* Wallclock after which the request is not started */
+  uint   flags;    /* FD_RPCSIM_FLAG_* */
+  ushort payload_sz;
+  uchar  payload[ FD_TXN_MTU ];
+};
+typedef struct fd_rpcsim_req fd_rpcsim_req_t;
+
+#define FD_RPCSIM_REQ_MTU sizeof(fd_rpcsim_req_t)
+
+struct __attribute__((aligned(64UL))) fd_rpcsim_res {
+  ulong       req_id;
+  ulong       slot;
+  int         status;        /* FD_RPCSIM_STATUS_* */
+  int         txn_err;       /* FD_RUNTIME_EXECUTE_SUCCESS or FD_RUNTIME_TXN_ERR_* */
+  int         instr_err;     /* FD_EXECUTOR_INSTR_ERR_* if txn_err is an instruction error */
+  int         instr_err_idx;
+  uint        custom_err;
+  ulong       cu_consumed;
+  fd_hash_t   blockhash;     /* Replacement blockhash, if requested */
+  ulong       last_valid_block_height;
+  fd_pubkey_t return_program_id;
+  ulong       return_data_sz;
+  uchar       return_data[ 1024 ];
+  ulong       logs_sz;
+  uchar       logs[ FD_LOG_COLLECTOR_MAX + FD_LOG_COLLECTOR_EXTRA ]; /* Rendered by fd_log_collector_render */
+};
+typedef struct fd_rpcsim_res fd_rpcsim_res_t;
+
+#define FD_RPCSIM_RES_MTU sizeof(fd_rpcsim_res_t)
+
+/* FD_RPCSIM_RES_SZ is the number of bytes of a result with logs_sz
+   bytes of logs, which is all that is published. */
+
+#define FD_RPCSIM_RES_SZ(logs_sz) (offsetof(fd_rpcsim_res_t, logs) + (logs_sz))
+
+#endif /* HEADER_fd_src_discof_rpcserver_fd_rpcsim_h */
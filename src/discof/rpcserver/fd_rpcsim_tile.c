@@ -0,0 +1,381 @@
+/* The rpcsim tile executes simulateTransaction requests on behalf of
+   the rpcsrv tile.  Each request names a slot, and the transaction is
+   executed against a private copy of that slot's bank and a read-only
+   view of its funk transaction.  Nothing is ever written back: accounts
+   modified by the transaction only live in the spad frame of the
+   request.
+
+   The bank is copied under a brief banks lock and the pool elements of
+   its CoW fields are pinned by reference count for the duration of the
+   execution (see fd_banks_snapshot_bank).  Funk is read with its usual
+   lock-free queries.  No lock is held while executing, so replay never
+   waits for a simulation: pinned elements that replay modifies, clears
+   or prunes are copied or released later instead.  Since a publish can
+   prune the slot out from under us, the bank and funk transaction are
+   validated again once execution is done, and the request is retried
+   once if either went away.
+
+   Execution time is bounded by the compute unit limit of the request,
+   which is clamped to the cu_max of the tile.  Requests whose deadline
+   passed while they were queued are not executed at all. */
+
+#include "fd_rpcsim.h"
+#include "generated/fd_rpcsim_tile_seccomp.h"
+
+#include "../../disco/tiles.h"
+#include "../../util/pod/fd_pod_format.h"
+#include "../../flamenco/runtime/fd_runtime.h"
+#include "../../flamenco/runtime/fd_executor.h"
+#include "../../flamenco/runtime/fd_blockhashes.h"
+#include "../../funk/fd_funk.h"
+
+#define IN_IDX  (0UL)
+#define OUT_IDX (0UL)
+
+/* Transactions are valid for this many blocks after their blockhash */
+#define FD_RPCSIM_MAX_PROCESSING_AGE (150UL)
+
+struct fd_rpcsim_tile_ctx {
+  fd_wksp_t *         in_mem;
+  ulong               in_chunk0;
+  ulong               in_wmark;
+
+  fd_wksp_t *         out_mem;
+  ulong               out_chunk0;
+  ulong               out_wmark;
+  ulong               out_chunk;
+
+  ulong               cu_max;
+
+  fd_funk_t           funk[1];
+  fd_banks_t *        banks;
+  fd_bank_t *         bank;    /* Snapshot of the bank being executed against, in scratch */
+
+  fd_spad_t *         spad;
+  fd_wksp_t *         spad_wksp;
+  fd_exec_txn_ctx_t * txn_ctx;
+
+  fd_rpcsim_req_t     req;
+  fd_txn_p_t          txn;
+};
+typedef struct fd_rpcsim_tile_ctx fd_rpcsim_tile_ctx_t;
+
+FD_FN_CONST static inline ulong
+scratch_align( void ) {
+  return 128UL;
+}
+
+FD_FN_PURE static inline ulong
+scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
+  ulong l = FD_LAYOUT_INIT;
+  l       = FD_LAYOUT_APPEND( l, alignof(fd_rpcsim_tile_ctx_t), sizeof(fd_rpcsim_tile_ctx_t) );
+  l       = FD_LAYOUT_APPEND( l, fd_bank_align(),               fd_bank_footprint()          );
+  return FD_LAYOUT_FINI( l, scratch_align() );
+}
+
+/* simulate_slot executes ctx->txn against the bank and funk
+   transaction of the requested slot and fills in the outcome in res.
+   Returns an FD_RPCSIM_STATUS_* code. */
+
+static int
+simulate_slot( fd_rpcsim_tile_ctx_t * ctx,
+               fd_rpcsim_res_t *      res ) {
+  fd_rpcsim_req_t const * req = &ctx->req;
+
+  fd_funk_txn_xid_t xid          = { .ul = { req->slot, req->slot } };
+  fd_funk_txn_xid_t last_publish = *fd_funk_last_publish( ctx->funk );
+  fd_funk_txn_t *   funk_txn     = NULL;
+  if( !fd_funk_txn_xid_eq( &xid, &last_publish ) ) {
+    fd_funk_txn_start_read( ctx->funk );
+    funk_txn = fd_funk_txn_query( &xid, fd_funk_txn_map( ctx->funk ) );
+    fd_funk_txn_end_read( ctx->funk );
+    if( FD_UNLIKELY( !funk_txn ) ) return FD_RPCSIM_STATUS_NO_SLOT;
+  }
+
+  ulong         bank_idx;
+  fd_bank_pin_t pin[1];
+  fd_bank_t *   bank = fd_banks_snapshot_bank( ctx->banks, req->slot, ctx->bank, pin, &bank_idx );
+  if( FD_UNLIKELY( !bank ) ) return FD_RPCSIM_STATUS_NO_SLOT;
+
+  fd_txn_p_t * txn = &ctx->txn;
+  if( req->flags & FD_RPCSIM_FLAG_REPLACE_BLOCKHASH ) {
+    fd_hash_t const * blockhash = fd_blockhashes_peek_last( fd_bank_block_hash_queue_query( bank ) );
+    if( FD_LIKELY( blockhash ) ) {
+      fd_memcpy( txn->payload + TXN( txn )->recent_blockhash_off, blockhash, sizeof(fd_hash_t) );
+      res->blockhash = *blockhash;
+    }
+    res->last_valid_block_height = fd_bank_block_height_get( bank ) + FD_RPCSIM_MAX_PROCESSING_AGE;
+  }
+
+  fd_exec_txn_ctx_t * txn_ctx = ctx->txn_ctx;
+
+  FD_SPAD_FRAME_BEGIN( ctx->spad ) {
+
+  txn_ctx->funk_txn = funk_txn;
+  txn_ctx->bank     = bank;
+  txn_ctx->slot     = req->slot;
+  txn_ctx->features = fd_bank_features_get( bank );
+
+  fd_execute_txn_task_info_t task_info = {
+    .txn_ctx  = txn_ctx,
+    .exec_res = 0,
+    .txn      = txn,
+  };
+
+  fd_rawtxn_b_t raw_txn = {
+    .raw    = txn->payload,
+    .txn_sz = (ushort)txn->payload_sz
+  };
+
+  txn->flags = FD_TXN_P_FLAGS_SANITIZE_SUCCESS;
+
+  fd_exec_txn_ctx_setup( txn_ctx, TXN( txn ), &raw_txn );
+  txn_ctx->enable_exec_recording = 1;
+  fd_log_collector_init( &txn_ctx->log_collector, 1 );
+
+  fd_executor_setup_txn_account_keys( txn_ctx );
+
+  int   err      = FD_RUNTIME_EXECUTE_SUCCESS;
+  ulong cu_start = 0UL;
+  if( (req->flags & FD_RPCSIM_FLAG_SIG_VERIFY) && fd_executor_txn_verify( txn_ctx ) ) {
+    err = FD_RUNTIME_TXN_ERR_SIGNATURE_FAILURE;
+  }
+
+  if( FD_LIKELY( !err ) ) {
+    fd_runtime_pre_execute_check( &task_info );
+    err = task_info.exec_res;
+  }
+
+  if( FD_LIKELY( !err ) ) {
+    /* The compute meter is set from the requested limit by the
+       pre-execute check, so it can only be clamped afterwards. */
+    ulong * meter = &txn_ctx->compute_budget_details.compute_meter;
+    *meter   = fd_ulong_min( *meter, ctx->cu_max );
+    cu_start = *meter;
+
+    txn->flags |= FD_TXN_P_FLAGS_EXECUTE_SUCCESS;
+    err = fd_execute_txn( &task_info );
+    res->cu_consumed = cu_start - txn_ctx->compute_budget_details.compute_meter;
+  }
+
+  res->txn_err = err;
+  if( err==FD_RUNTIME_TXN_ERR_INSTRUCTION_ERROR ) {
+    res->instr_err     = txn_ctx->exec_err;
+    res->instr_err_idx = txn_ctx->instr_err_idx;
+    res->custom_err    = txn_ctx->custom_err;
+  }
+
+  res->return_program_id = txn_ctx->return_data.program_id;
+  res->return_data_sz    = fd_ulong_min( txn_ctx->return_data.len, sizeof(res->return_data) );
+  fd_memcpy( res->return_data, txn_ctx->return_data.data, res->return_data_sz );
+
+  res->logs_sz = fd_log_collector_render( &txn_ctx->log_collector, res->logs );
+
+  } FD_SPAD_FRAME_END;
+
+  /* Unpin as soon as execution is done, pinned elements dropped by
+     replay in the meantime are only released by the next publish. */
+  fd_banks_snapshot_release( pin );
+
+  /* The funk transaction was only valid if neither it nor the bank was
+     pruned while executing. */
+
+  int valid = fd_funk_txn_xid_eq( fd_funk_last_publish( ctx->funk ), &last_publish ) &&
+              fd_banks_bank_idx( ctx->banks, req->slot )==bank_idx;
+  if( valid && funk_txn ) {
+    fd_funk_txn_start_read( ctx->funk );
+    valid = fd_funk_txn_query( &xid, fd_funk_txn_map( ctx->funk ) )==funk_txn;
+    fd_funk_txn_end_read( ctx->funk );
+  }
+  return valid ? FD_RPCSIM_STATUS_OK : FD_RPCSIM_STATUS_PRUNED;
+}
+
+static void
+simulate( fd_rpcsim_tile_ctx_t * ctx,
+          fd_rpcsim_res_t *      res ) {
+  fd_rpcsim_req_t const * req = &ctx->req;
+
+  memset( res, 0, offsetof(fd_rpcsim_res_t, return_data) );
+  res->req_id  = req->req_id;
+  res->slot    = req->slot;
+  res->logs_sz = 0UL;
+
+  fd_txn_p_t * txn = &ctx->txn;
+  fd_memcpy( txn->payload, req->payload, req->payload_sz );
+  txn->payload_sz = req->payload_sz;
+  if( FD_UNLIKELY( !fd_txn_parse( txn->payload, txn->payload_sz, TXN( txn ), NULL ) ) ) {
+    res->status = FD_RPCSIM_STATUS_PARSE;
+    return;
+  }
+
+  for( ulong attempt=0UL; attempt<2UL; attempt++ ) {
+    if( FD_UNLIKELY( fd_log_wallclock()>req->deadline ) ) {
+      res->status = FD_RPCSIM_STATUS_EXPIRED;
+      return;
+    }
+    res->status = simulate_slot( ctx, res );
+    if( FD_LIKELY( res->status!=FD_RPCSIM_STATUS_PRUNED ) ) break;
+    res->cu_consumed    = 0UL;
+    res->return_data_sz = 0UL;
+    res->logs_sz        = 0UL;
+  }
+}
+
+static void
+during_frag( fd_rpcsim_tile_ctx_t * ctx,
+             ulong                  in_idx FD_PARAM_UNUSED,
+             ulong                  seq    FD_PARAM_UNUSED,
+             ulong                  sig    FD_PARAM_UNUSED,
+             ulong                  chunk,
+             ulong                  sz,
+             ulong                  ctl    FD_PARAM_UNUSED ) {
+  if( FD_UNLIKELY( chunk<ctx->in_chunk0 || chunk>ctx->in_wmark || sz!=sizeof(fd_rpcsim_req_t) ) ) {
+    FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in_chunk0, ctx->in_wmark ));
+  }
+  fd_memcpy( &ctx->req, fd_chunk_to_laddr_const( ctx->in_mem, chunk ), sizeof(fd_rpcsim_req_t) );
+  if( FD_UNLIKELY( ctx->req.payload_sz>FD_TXN_MTU ) ) {
+    FD_LOG_ERR(( "payload_sz %u corrupt", (uint)ctx->req.payload_sz ));
+  }
+}
+
+static void
+after_frag( fd_rpcsim_tile_ctx_t * ctx,
+            ulong                  in_idx FD_PARAM_UNUSED,
+            ulong                  seq    FD_PARAM_UNUSED,
+            ulong                  sig    FD_PARAM_UNUSED,
+            ulong                  sz     FD_PARAM_UNUSED,
+            ulong                  tsorig,
+            ulong                  tspub  FD_PARAM_UNUSED,
+            fd_stem_context_t *    stem ) {
+  fd_rpcsim_res_t * res = fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
+  simulate( ctx, res );
+
+  ulong res_sz = FD_RPCSIM_RES_SZ( res->logs_sz );
+  ulong tspub_ = fd_frag_meta_ts_comp( fd_tickcount() );
+  fd_stem_publish( stem, OUT_IDX, res->req_id, ctx->out_chunk, res_sz, 0UL, tsorig, tspub_ );
+  ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, res_sz, ctx->out_chunk0, ctx->out_wmark );
+}
+
+static void
+privileged_init( fd_topo_t *      topo FD_PARAM_UNUSED,
+                 fd_topo_tile_t * tile FD_PARAM_UNUSED ) {
+}
+
+static void
+unprivileged_init( fd_topo_t *      topo,
+                   fd_topo_tile_t * tile ) {
+  void * scratch = fd_topo_obj_laddr( topo, tile->tile_obj_id );
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_rpcsim_tile_ctx_t * ctx      = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_rpcsim_tile_ctx_t), sizeof(fd_rpcsim_tile_ctx_t) );
+  void *                 bank_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_bank_align(),               fd_bank_footprint()          );
+  ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, scratch_align() );
+  if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) ) {
+    FD_LOG_ERR(( "scratch overflow %lu %lu %lu", scratch_top - (ulong)scratch - scratch_footprint( tile ), scratch_top, (ulong)scratch + scratch_footprint( tile ) ));
+  }
+  ctx->bank = bank_mem;
+
+  if( FD_UNLIKELY( tile->in_cnt!=1UL || strcmp( topo->links[ tile->in_link_id[ IN_IDX ] ].name, "rpc_sim" ) ) ) {
+    FD_LOG_ERR(( "rpcsim tile has unexpected in links" ));
+  }
+  if( FD_UNLIKELY( tile->out_cnt!=1UL || strcmp( topo->links[ tile->out_link_id[ OUT_IDX ] ].name, "sim_rpc" ) ) ) {
+    FD_LOG_ERR(( "rpcsim tile has unexpected out links" ));
+  }
+
+  fd_topo_link_t const * in_link = &topo->links[ tile->in_link_id[ IN_IDX ] ];
+  ctx->in_mem    = topo->workspaces[ topo->objs[ in_link->dcache_obj_id ].wksp_id ].wksp;
+  ctx->in_chunk0 = fd_dcache_compact_chunk0( ctx->in_mem, in_link->dcache );
+  ctx->in_wmark  = fd_dcache_compact_wmark ( ctx->in_mem, in_link->dcache, in_link->mtu );
+
+  fd_topo_link_t const * out_link = &topo->links[ tile->out_link_id[ OUT_IDX ] ];
+  ctx->out_mem    = topo->workspaces[ topo->objs[ out_link->dcache_obj_id ].wksp_id ].wksp;
+  ctx->out_chunk0 = fd_dcache_compact_chunk0( ctx->out_mem, out_link->dcache );
+  ctx->out_wmark  = fd_dcache_compact_wmark ( ctx->out_mem, out_link->dcache, out_link->mtu );
+  ctx->out_chunk  = ctx->out_chunk0;
+
+  ctx->cu_max = tile->rpcsim.cu_max;
+
+  ulong banks_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "banks" );
+  if( FD_UNLIKELY( banks_obj_id==ULONG_MAX ) ) {
+    FD_LOG_ERR(( "Could not find topology object for banks" ));
+  }
+  ctx->banks = fd_banks_join( fd_topo_obj_laddr( topo, banks_obj_id ) );
+  if( FD_UNLIKELY( !ctx->banks ) ) {
+    FD_LOG_ERR(( "Failed to join banks" ));
+  }
+
+  ulong spad_obj_id = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "rpcsim_spad.%lu", tile->kind_id );
+  if( FD_UNLIKELY( spad_obj_id==ULONG_MAX ) ) {
+    FD_LOG_ERR(( "Could not find topology object for rpcsim spad" ));
+  }
+  ctx->spad = fd_spad_join( fd_topo_obj_laddr( topo, spad_obj_id ) );
+  if( FD_UNLIKELY( !ctx->spad ) ) {
+    FD_LOG_ERR(( "Failed to join rpcsim spad" ));
+  }
+  ctx->spad_wksp = fd_wksp_containing( ctx->spad );
+
+  if( FD_UNLIKELY( !fd_funk_join( ctx->funk, fd_topo_obj_laddr( topo, tile->rpcsim.funk_obj_id ) ) ) ) {
+    FD_LOG_ERR(( "Failed to join database cache" ));
+  }
+
+  /* The status cache is not checked (simulated transactions may be
+     duplicates) and no bank hashes are compared. */
+
+  fd_spad_push( ctx->spad );
+  uchar * txn_ctx_mem = fd_spad_alloc_check( ctx->spad, FD_EXEC_TXN_CTX_ALIGN, FD_EXEC_TXN_CTX_FOOTPRINT );
+  ctx->txn_ctx        = fd_exec_txn_ctx_join( fd_exec_txn_ctx_new( txn_ctx_mem ), ctx->spad, ctx->spad_wksp );
+  *ctx->txn_ctx->funk = *ctx->funk;
+  ctx->txn_ctx->status_cache     = NULL;
+  ctx->txn_ctx->bank_hash_cmp    = NULL;
+  ctx->txn_ctx->runtime_pub_wksp = NULL;
+}
+
+static ulong
+populate_allowed_seccomp( fd_topo_t const *      topo,
+                          fd_topo_tile_t const * tile,
+                          ulong                  out_cnt,
+                          struct sock_filter *   out ) {
+  (void)topo;
+  (void)tile;
+
+  populate_sock_filter_policy_fd_rpcsim_tile( out_cnt, out, (uint)fd_log_private_logfile_fd() );
+  return sock_filter_policy_fd_rpcsim_tile_instr_cnt;
+}
+
+static ulong
+populate_allowed_fds( fd_topo_t const *      topo,
+                      fd_topo_tile_t const * tile,
+                      ulong                  out_fds_cnt,
+                      int *                  out_fds ) {
+  (void)topo;
+  (void)tile;
+
+  if( FD_UNLIKELY( out_fds_cnt<2UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
+
+  ulong out_cnt = 0UL;
+  out_fds[ out_cnt++ ] = 2; /* stderr */
+  if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
+    out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
+  return out_cnt;
+}
+
+#define STEM_BURST (1UL)
+
+#define STEM_CALLBACK_CONTEXT_TYPE  fd_rpcsim_tile_ctx_t
+#define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_rpcsim_tile_ctx_t)
+
+#define STEM_CALLBACK_DURING_FRAG during_frag
+#define STEM_CALLBACK_AFTER_FRAG  after_frag
+
+#include "../../disco/stem/fd_stem.c"
+
+fd_topo_run_tile_t fd_tile_rpcsim = {
+  .name                     = "rpcsim",
+  .populate_allowed_seccomp = populate_allowed_seccomp,
+  .populate_allowed_fds     = populate_allowed_fds,
+  .scratch_align            = scratch_align,
+  .scratch_footprint        = scratch_footprint,
+  .privileged_init          = privileged_init,
+  .unprivileged_init        = unprivileged_init,
+  .run                      = stem_run,
+};
@@ -20,10 +20,27 @@ struct fd_websocket_ctx {
   ulong connection_id;
 };
 
+/* Appends text to the HTTP stage, or to the scratch buffer while the
+   reply is redirected there. */
+static void
+fd_web_reply_stage( fd_webserver_t * ws, const char * text, ulong text_sz ) {
+  if( FD_LIKELY( !ws->scratch ) ) {
+    fd_http_server_memcpy( ws->server, (const uchar*)text, text_sz );
+    return;
+  }
+  if( FD_UNLIKELY( ws->scratch_len==ULONG_MAX ) ) return;
+  if( FD_UNLIKELY( text_sz > ws->scratch_max - ws->scratch_len ) ) {
+    ws->scratch_len = ULONG_MAX;
+    return;
+  }
+  memcpy( ws->scratch + ws->scratch_len, text, text_sz );
+  ws->scratch_len += text_sz;
+}
+
 static void
 fd_web_reply_flush( fd_webserver_t * ws ) {
   if( ws->quick_size ) {
-    fd_http_server_memcpy(ws->server, (const uchar*)ws->quick_buf, ws->quick_size);
+    fd_web_reply_stage( ws, ws->quick_buf, ws->quick_size );
     ws->quick_size = 0;
   }
 }
@@ -42,6 +59,7 @@ json_parse_root(fd_webserver_t * ws, json_lex_state_t* lex) {
   struct json_path path;
   if (json_lex_next_token(lex) == JSON_TOKEN_LBRACKET) {
     /* We have an array of requests */
+    ws->in_batch = 1;
     fd_web_reply_append(ws, "[", 1);
     while(1) {
       fd_web_reply_flush( ws );
@@ -77,6 +95,7 @@ json_parse_root(fd_webserver_t * ws, json_lex_state_t* lex) {
       }
     }
     fd_web_reply_append(ws, "]", 1);
+    ws->in_batch = 0;
 
   } else {
     /* Go back to the first token */
@@ -181,6 +200,8 @@ request( fd_http_server_request_t const * request ) {
       fwrite("\n", 1, 1, stdout);
       fflush(stdout);
 #endif
+      ws->conn_id = request->connection_id;
+      ws->defer   = 0;
       FD_SPAD_FRAME_BEGIN( ws->spad ) {
         json_lex_state_t lex;
         json_lex_state_new(&lex, (const char*)request->post.body, request->post.body_len, ws->spad);
@@ -188,6 +209,13 @@ request( fd_http_server_request_t const * request ) {
         json_lex_state_delete(&lex);
         fd_web_reply_flush( ws );
       } FD_SPAD_FRAME_END;
+      ws->conn_id = ULONG_MAX;
+
+      if( ws->defer ) {
+        fd_http_server_unstage( ws->server );
+        fd_http_server_response_t response = { .defer = 1 };
+        return response;
+      }
     }
 
     fd_http_server_response_t response = {
@@ -227,9 +255,9 @@ http_open( ulong connection_id, int sockfd, void * ctx ) {
 
 static void
 http_close( ulong connection_id, int reason, void * ctx ) {
-  (void)connection_id;
   (void)reason;
-  (void)ctx;
+  fd_webserver_t * ws = (fd_webserver_t *)ctx;
+  fd_webserver_http_closed( connection_id, ws->cb_arg );
 }
 
 static void
@@ -284,11 +312,40 @@ void fd_web_ws_send( fd_webserver_t * ws, ulong conn_id ) {
   fd_http_server_ws_send( ws->server, conn_id );
 }
 
+ulong
+fd_web_reply_defer( fd_webserver_t * ws ) {
+  if( ws->in_batch || ws->conn_id==ULONG_MAX ) return ULONG_MAX;
+  ws->defer = 1;
+  return ws->conn_id;
+}
+
+int
+fd_web_reply_deferred( fd_webserver_t * ws, ulong conn_id ) {
+  fd_web_reply_flush( ws );
+  fd_http_server_response_t response = {
+    .status                      = ws->status_code,
+    .upgrade_websocket           = 0,
+    .content_type                = "application/json",
+    .access_control_allow_origin = "*",
+  };
+  if( FD_UNLIKELY( fd_http_server_stage_body( ws->server, &response ) ) ) {
+    FD_LOG_WARNING(( "fd_http_server_stage_body failed" ));
+    response = (fd_http_server_response_t){
+      .status                      = 500,
+      .upgrade_websocket           = 0,
+      .content_type                = "text/html",
+      .access_control_allow_origin = "*",
+    };
+  }
+  return fd_http_server_respond( ws->server, conn_id, &response );
+}
+
 int fd_webserver_start( ushort portno, fd_http_server_params_t params, fd_spad_t * spad, fd_webserver_t * ws, void * cb_arg ) {
   memset(ws, 0, sizeof(fd_webserver_t));
 
   ws->cb_arg = cb_arg;
   ws->spad = spad;
+  ws->conn_id = ULONG_MAX;
 
   fd_http_server_callbacks_t callbacks = {
     .request    = request,
@@ -330,12 +387,48 @@ fd_web_reply_append( fd_webserver_t * ws,
       memcpy( ws->quick_buf, text, text_sz );
       ws->quick_size = text_sz;
     } else {
-      fd_http_server_memcpy( ws->server, (const uchar*)text, text_sz );
+      fd_web_reply_stage( ws, text, text_sz );
     }
   }
   return 0;
 }
 
+ulong
+fd_web_reply_mark( fd_webserver_t * ws ) {
+  fd_web_reply_flush( ws );
+  return fd_http_server_stage_len( ws->server );
+}
+
+const char *
+fd_web_reply_since( fd_webserver_t * ws, ulong mark, ulong * sz ) {
+  fd_web_reply_flush( ws );
+  uchar const * stage = fd_http_server_stage_peek( ws->server );
+  if( FD_UNLIKELY( !stage ) ) return NULL;
+  *sz = fd_http_server_stage_len( ws->server ) - mark;
+  return (const char *)stage + mark;
+}
+
+void
+fd_web_reply_trunc( fd_webserver_t * ws, ulong mark ) {
+  fd_web_reply_flush( ws );
+  fd_http_server_stage_trunc( ws->server, mark );
+}
+
+void
+fd_web_reply_scratch_begin( fd_webserver_t * ws, char * buf, ulong buf_max ) {
+  fd_web_reply_flush( ws );
+  ws->scratch     = buf;
+  ws->scratch_max = buf_max;
+  ws->scratch_len = 0UL;
+}
+
+ulong
+fd_web_reply_scratch_end( fd_webserver_t * ws ) {
+  fd_web_reply_flush( ws );
+  ws->scratch = NULL;
+  return ws->scratch_len;
+}
+
 static const char b58digits_ordered[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
 int
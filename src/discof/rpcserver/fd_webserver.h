@@ -13,6 +13,12 @@ struct fd_webserver {
   unsigned int       status_code;
   ulong              prev_reply_len;
   ulong              quick_size;
+  ulong              conn_id;  /* Connection of the HTTP request being handled, ULONG_MAX if none */
+  int                in_batch; /* Handling an element of a batch request */
+  int                defer;    /* The reply to the current request was deferred */
+  char *             scratch;     /* If non-NULL, the reply is rendered here, see fd_web_reply_scratch_begin */
+  ulong              scratch_max;
+  ulong              scratch_len; /* ULONG_MAX if the rendered text did not fit */
 #define FD_WEBSERVER_QUICK_MAX (1U<<14U)
   char               quick_buf[FD_WEBSERVER_QUICK_MAX];
 };
@@ -36,6 +42,8 @@ int fd_webserver_ws_subscribe(struct json_values* values, ulong conn_id, void *
 
 void fd_webserver_ws_closed(ulong conn_id, void * cb_arg);
 
+void fd_webserver_http_closed(ulong conn_id, void * cb_arg);
+
 void fd_web_ws_send( fd_webserver_t * ws, ulong conn_id );
 
 void fd_web_reply_new( fd_webserver_t * ws );
@@ -63,4 +71,37 @@ int fd_web_reply_sprintf( fd_webserver_t * ws, const char* format, ... )
 
 int fd_web_reply_encode_json_string( fd_webserver_t * ws, const char* str );
 
+/* fd_web_reply_mark returns a mark for the current end of the reply.
+   fd_web_reply_since returns the text appended to the reply since mark
+   and stores its size in *sz, or returns NULL if the reply is in an
+   error state.  The text is valid until the reply is next appended to.
+   fd_web_reply_trunc discards everything appended since mark. */
+ulong fd_web_reply_mark( fd_webserver_t * ws );
+
+const char * fd_web_reply_since( fd_webserver_t * ws, ulong mark, ulong * sz );
+
+void fd_web_reply_trunc( fd_webserver_t * ws, ulong mark );
+
+/* fd_web_reply_scratch_begin redirects everything appended to the
+   reply into the buffer buf of buf_max bytes, leaving the reply staged
+   so far untouched.  fd_web_reply_scratch_end ends the redirection and
+   returns the number of bytes rendered into buf, or ULONG_MAX if they
+   did not fit.  Redirections do not nest. */
+void fd_web_reply_scratch_begin( fd_webserver_t * ws, char * buf, ulong buf_max );
+
+ulong fd_web_reply_scratch_end( fd_webserver_t * ws );
+
+/* fd_web_reply_defer is called by a method handler that will answer
+   the current HTTP request later.  Nothing is sent for the request
+   when the handler returns.  Returns the connection id to later pass
+   to fd_web_reply_deferred, or ULONG_MAX if the request cannot be
+   deferred (it is part of a batch or arrived over a websocket), in
+   which case the handler must reply immediately. */
+ulong fd_web_reply_defer( fd_webserver_t * ws );
+
+/* fd_web_reply_deferred sends the reply built since the last
+   fd_web_reply_new as the response to a deferred request.  Returns 0
+   on success, or -1 if the connection has closed in the meantime. */
+int fd_web_reply_deferred( fd_webserver_t * ws, ulong conn_id );
+
 #endif /* HEADER_fd_src_discof_rpcserver_fd_webserver_h */
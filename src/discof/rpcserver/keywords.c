@@ -163,6 +163,11 @@ long fd_webserver_json_keyword(const char* keyw, unsigned long keyw_sz) {
         return KEYW_JSON_PROGRAMID; // "programId"
       }
       break;
+    case 's':
+      if (*(unsigned long*)&keyw[1] == 0x7966697265566769UL) {
+        return KEYW_JSON_SIGVERIFY; // "sigVerify"
+      }
+      break;
     }
   break;
   case 10:
@@ -193,6 +198,11 @@ long fd_webserver_json_keyword(const char* keyw, unsigned long keyw_sz) {
         return KEYW_JSON_MAXRETRIES; // "maxRetries"
       }
       break;
+    case 'p':
+      if (*(unsigned long*)&keyw[1] == 0x6C69746E65637265UL && keyw[9] == 'e') {
+        return KEYW_JSON_PERCENTILE; // "percentile"
+      }
+      break;
     case 'v':
       if (*(unsigned long*)&keyw[1] == 0x656B62755065746FUL && keyw[9] == 'y') {
         return KEYW_JSON_VOTEPUBKEY; // "votePubkey"
@@ -650,6 +660,11 @@ long fd_webserver_json_keyword(const char* keyw, unsigned long keyw_sz) {
         }
       }
       break;
+    case 'r':
+      if (*(unsigned long*)&keyw[1] == 0x65526563616C7065UL && *(unsigned long*)&keyw[9] == 0x636F6C42746E6563UL && (*(unsigned long*)&keyw[17] & 0xFFFFFFFFFFUL) == 0x687361686BUL) {
+        return KEYW_JSON_REPLACERECENTBLOCKHASH; // "replaceRecentBlockhash"
+      }
+      break;
     }
   break;
   case 23:
@@ -812,6 +827,9 @@ const char* un_fd_webserver_json_keyword(long id) {
   case KEYW_JSON_TRANSACTIONDETAILS: return "transactionDetails";
   case KEYW_JSON_VOTEPUBKEY: return "votePubkey";
   case KEYW_JSON_EXCLUDENONCIRCULATINGACCOUNTSLIST: return "excludeNonCirculatingAccountsList";
+  case KEYW_JSON_REPLACERECENTBLOCKHASH: return "replaceRecentBlockhash";
+  case KEYW_JSON_SIGVERIFY: return "sigVerify";
+  case KEYW_JSON_PERCENTILE: return "percentile";
   case KEYW_RPCMETHOD_GETACCOUNTINFO: return "getAccountInfo";
   case KEYW_RPCMETHOD_GETBALANCE: return "getBalance";
   case KEYW_RPCMETHOD_GETBLOCK: return "getBlock";
@@ -31,87 +31,90 @@
 #define KEYW_JSON_TRANSACTIONDETAILS 29L
 #define KEYW_JSON_VOTEPUBKEY 30L
 #define KEYW_JSON_EXCLUDENONCIRCULATINGACCOUNTSLIST 31L
-#define KEYW_RPCMETHOD_GETACCOUNTINFO 32L
-#define KEYW_RPCMETHOD_GETBALANCE 33L
-#define KEYW_RPCMETHOD_GETBLOCK 34L
-#define KEYW_RPCMETHOD_GETBLOCKCOMMITMENT 35L
-#define KEYW_RPCMETHOD_GETBLOCKHEIGHT 36L
-#define KEYW_RPCMETHOD_GETBLOCKPRODUCTION 37L
-#define KEYW_RPCMETHOD_GETBLOCKS 38L
-#define KEYW_RPCMETHOD_GETBLOCKSWITHLIMIT 39L
-#define KEYW_RPCMETHOD_GETBLOCKTIME 40L
-#define KEYW_RPCMETHOD_GETCLUSTERNODES 41L
-#define KEYW_RPCMETHOD_GETCONFIRMEDBLOCK 42L
-#define KEYW_RPCMETHOD_GETCONFIRMEDBLOCKS 43L
-#define KEYW_RPCMETHOD_GETCONFIRMEDBLOCKSWITHLIMIT 44L
-#define KEYW_RPCMETHOD_GETCONFIRMEDSIGNATURESFORADDRESS2 45L
-#define KEYW_RPCMETHOD_GETCONFIRMEDTRANSACTION 46L
-#define KEYW_RPCMETHOD_GETEPOCHINFO 47L
-#define KEYW_RPCMETHOD_GETEPOCHSCHEDULE 48L
-#define KEYW_RPCMETHOD_GETFEECALCULATORFORBLOCKHASH 49L
-#define KEYW_RPCMETHOD_GETFEEFORMESSAGE 50L
-#define KEYW_RPCMETHOD_GETFEERATEGOVERNOR 51L
-#define KEYW_RPCMETHOD_GETFEES 52L
-#define KEYW_RPCMETHOD_GETFIRSTAVAILABLEBLOCK 53L
-#define KEYW_RPCMETHOD_GETGENESISHASH 54L
-#define KEYW_RPCMETHOD_GETHEALTH 55L
-#define KEYW_RPCMETHOD_GETHIGHESTSNAPSHOTSLOT 56L
-#define KEYW_RPCMETHOD_GETIDENTITY 57L
-#define KEYW_RPCMETHOD_GETINFLATIONGOVERNOR 58L
-#define KEYW_RPCMETHOD_GETINFLATIONRATE 59L
-#define KEYW_RPCMETHOD_GETINFLATIONREWARD 60L
-#define KEYW_RPCMETHOD_GETLARGESTACCOUNTS 61L
-#define KEYW_RPCMETHOD_GETLATESTBLOCKHASH 62L
-#define KEYW_RPCMETHOD_GETLEADERSCHEDULE 63L
-#define KEYW_RPCMETHOD_GETMAXRETRANSMITSLOT 64L
-#define KEYW_RPCMETHOD_GETMAXSHREDINSERTSLOT 65L
-#define KEYW_RPCMETHOD_GETMINIMUMBALANCEFORRENTEXEMPTION 66L
-#define KEYW_RPCMETHOD_GETMULTIPLEACCOUNTS 67L
-#define KEYW_RPCMETHOD_GETPROGRAMACCOUNTS 68L
-#define KEYW_RPCMETHOD_GETRECENTBLOCKHASH 69L
-#define KEYW_RPCMETHOD_GETRECENTPERFORMANCESAMPLES 70L
-#define KEYW_RPCMETHOD_GETRECENTPRIORITIZATIONFEES 71L
-#define KEYW_RPCMETHOD_GETSIGNATURESFORADDRESS 72L
-#define KEYW_RPCMETHOD_GETSIGNATURESTATUSES 73L
-#define KEYW_RPCMETHOD_GETSLOT 74L
-#define KEYW_RPCMETHOD_GETSLOTLEADER 75L
-#define KEYW_RPCMETHOD_GETSLOTLEADERS 76L
-#define KEYW_RPCMETHOD_GETSNAPSHOTSLOT 77L
-#define KEYW_RPCMETHOD_GETSTAKEACTIVATION 78L
-#define KEYW_RPCMETHOD_GETSTAKEMINIMUMDELEGATION 79L
-#define KEYW_RPCMETHOD_GETSUPPLY 80L
-#define KEYW_RPCMETHOD_GETTOKENACCOUNTBALANCE 81L
-#define KEYW_RPCMETHOD_GETTOKENACCOUNTSBYDELEGATE 82L
-#define KEYW_RPCMETHOD_GETTOKENACCOUNTSBYOWNER 83L
-#define KEYW_RPCMETHOD_GETTOKENLARGESTACCOUNTS 84L
-#define KEYW_RPCMETHOD_GETTOKENSUPPLY 85L
-#define KEYW_RPCMETHOD_GETTRANSACTION 86L
-#define KEYW_RPCMETHOD_GETTRANSACTIONCOUNT 87L
-#define KEYW_RPCMETHOD_GETVERSION 88L
-#define KEYW_RPCMETHOD_GETVOTEACCOUNTS 89L
-#define KEYW_RPCMETHOD_ISBLOCKHASHVALID 90L
-#define KEYW_RPCMETHOD_MINIMUMLEDGERSLOT 91L
-#define KEYW_RPCMETHOD_REQUESTAIRDROP 92L
-#define KEYW_RPCMETHOD_SENDTRANSACTION 93L
-#define KEYW_RPCMETHOD_SIMULATETRANSACTION 94L
-#define KEYW_WS_METHOD_ACCOUNTSUBSCRIBE 95L
-#define KEYW_WS_METHOD_ACCOUNTUNSUBSCRIBE 96L
-#define KEYW_WS_METHOD_BLOCKSUBSCRIBE 97L
-#define KEYW_WS_METHOD_BLOCKUNSUBSCRIBE 98L
-#define KEYW_WS_METHOD_LOGSSUBSCRIBE 99L
-#define KEYW_WS_METHOD_LOGSUNSUBSCRIBE 100L
-#define KEYW_WS_METHOD_PROGRAMSUBSCRIBE 101L
-#define KEYW_WS_METHOD_PROGRAMUNSUBSCRIBE 102L
-#define KEYW_WS_METHOD_ROOTSUBSCRIBE 103L
-#define KEYW_WS_METHOD_ROOTUNSUBSCRIBE 104L
-#define KEYW_WS_METHOD_SIGNATURESUBSCRIBE 105L
-#define KEYW_WS_METHOD_SIGNATUREUNSUBSCRIBE 106L
-#define KEYW_WS_METHOD_SLOTSUBSCRIBE 107L
-#define KEYW_WS_METHOD_SLOTUNSUBSCRIBE 108L
-#define KEYW_WS_METHOD_SLOTSUPDATESSUBSCRIBE 109L
-#define KEYW_WS_METHOD_SLOTSUPDATESUNSUBSCRIBE 110L
-#define KEYW_WS_METHOD_VOTESUBSCRIBE 111L
-#define KEYW_WS_METHOD_VOTEUNSUBSCRIBE 112L
+#define KEYW_JSON_REPLACERECENTBLOCKHASH 32L
+#define KEYW_JSON_SIGVERIFY 33L
+#define KEYW_JSON_PERCENTILE 34L
+#define KEYW_RPCMETHOD_GETACCOUNTINFO 35L
+#define KEYW_RPCMETHOD_GETBALANCE 36L
+#define KEYW_RPCMETHOD_GETBLOCK 37L
+#define KEYW_RPCMETHOD_GETBLOCKCOMMITMENT 38L
+#define KEYW_RPCMETHOD_GETBLOCKHEIGHT 39L
+#define KEYW_RPCMETHOD_GETBLOCKPRODUCTION 40L
+#define KEYW_RPCMETHOD_GETBLOCKS 41L
+#define KEYW_RPCMETHOD_GETBLOCKSWITHLIMIT 42L
+#define KEYW_RPCMETHOD_GETBLOCKTIME 43L
+#define KEYW_RPCMETHOD_GETCLUSTERNODES 44L
+#define KEYW_RPCMETHOD_GETCONFIRMEDBLOCK 45L
+#define KEYW_RPCMETHOD_GETCONFIRMEDBLOCKS 46L
+#define KEYW_RPCMETHOD_GETCONFIRMEDBLOCKSWITHLIMIT 47L
+#define KEYW_RPCMETHOD_GETCONFIRMEDSIGNATURESFORADDRESS2 48L
+#define KEYW_RPCMETHOD_GETCONFIRMEDTRANSACTION 49L
+#define KEYW_RPCMETHOD_GETEPOCHINFO 50L
+#define KEYW_RPCMETHOD_GETEPOCHSCHEDULE 51L
+#define KEYW_RPCMETHOD_GETFEECALCULATORFORBLOCKHASH 52L
+#define KEYW_RPCMETHOD_GETFEEFORMESSAGE 53L
+#define KEYW_RPCMETHOD_GETFEERATEGOVERNOR 54L
+#define KEYW_RPCMETHOD_GETFEES 55L
+#define KEYW_RPCMETHOD_GETFIRSTAVAILABLEBLOCK 56L
+#define KEYW_RPCMETHOD_GETGENESISHASH 57L
+#define KEYW_RPCMETHOD_GETHEALTH 58L
+#define KEYW_RPCMETHOD_GETHIGHESTSNAPSHOTSLOT 59L
+#define KEYW_RPCMETHOD_GETIDENTITY 60L
+#define KEYW_RPCMETHOD_GETINFLATIONGOVERNOR 61L
+#define KEYW_RPCMETHOD_GETINFLATIONRATE 62L
+#define KEYW_RPCMETHOD_GETINFLATIONREWARD 63L
+#define KEYW_RPCMETHOD_GETLARGESTACCOUNTS 64L
+#define KEYW_RPCMETHOD_GETLATESTBLOCKHASH 65L
+#define KEYW_RPCMETHOD_GETLEADERSCHEDULE 66L
+#define KEYW_RPCMETHOD_GETMAXRETRANSMITSLOT 67L
+#define KEYW_RPCMETHOD_GETMAXSHREDINSERTSLOT 68L
+#define KEYW_RPCMETHOD_GETMINIMUMBALANCEFORRENTEXEMPTION 69L
+#define KEYW_RPCMETHOD_GETMULTIPLEACCOUNTS 70L
+#define KEYW_RPCMETHOD_GETPROGRAMACCOUNTS 71L
+#define KEYW_RPCMETHOD_GETRECENTBLOCKHASH 72L
+#define KEYW_RPCMETHOD_GETRECENTPERFORMANCESAMPLES 73L
+#define KEYW_RPCMETHOD_GETRECENTPRIORITIZATIONFEES 74L
+#define KEYW_RPCMETHOD_GETSIGNATURESFORADDRESS 75L
+#define KEYW_RPCMETHOD_GETSIGNATURESTATUSES 76L
+#define KEYW_RPCMETHOD_GETSLOT 77L
+#define KEYW_RPCMETHOD_GETSLOTLEADER 78L
+#define KEYW_RPCMETHOD_GETSLOTLEADERS 79L
+#define KEYW_RPCMETHOD_GETSNAPSHOTSLOT 80L
+#define KEYW_RPCMETHOD_GETSTAKEACTIVATION 81L
+#define KEYW_RPCMETHOD_GETSTAKEMINIMUMDELEGATION 82L
+#define KEYW_RPCMETHOD_GETSUPPLY 83L
+#define KEYW_RPCMETHOD_GETTOKENACCOUNTBALANCE 84L
+#define KEYW_RPCMETHOD_GETTOKENACCOUNTSBYDELEGATE 85L
+#define KEYW_RPCMETHOD_GETTOKENACCOUNTSBYOWNER 86L
+#define KEYW_RPCMETHOD_GETTOKENLARGESTACCOUNTS 87L
+#define KEYW_RPCMETHOD_GETTOKENSUPPLY 88L
+#define KEYW_RPCMETHOD_GETTRANSACTION 89L
+#define KEYW_RPCMETHOD_GETTRANSACTIONCOUNT 90L
+#define KEYW_RPCMETHOD_GETVERSION 91L
+#define KEYW_RPCMETHOD_GETVOTEACCOUNTS 92L
+#define KEYW_RPCMETHOD_ISBLOCKHASHVALID 93L
+#define KEYW_RPCMETHOD_MINIMUMLEDGERSLOT 94L
+#define KEYW_RPCMETHOD_REQUESTAIRDROP 95L
+#define KEYW_RPCMETHOD_SENDTRANSACTION 96L
+#define KEYW_RPCMETHOD_SIMULATETRANSACTION 97L
+#define KEYW_WS_METHOD_ACCOUNTSUBSCRIBE 98L
+#define KEYW_WS_METHOD_ACCOUNTUNSUBSCRIBE 99L
+#define KEYW_WS_METHOD_BLOCKSUBSCRIBE 100L
+#define KEYW_WS_METHOD_BLOCKUNSUBSCRIBE 101L
+#define KEYW_WS_METHOD_LOGSSUBSCRIBE 102L
+#define KEYW_WS_METHOD_LOGSUNSUBSCRIBE 103L
+#define KEYW_WS_METHOD_PROGRAMSUBSCRIBE 104L
+#define KEYW_WS_METHOD_PROGRAMUNSUBSCRIBE 105L
+#define KEYW_WS_METHOD_ROOTSUBSCRIBE 106L
+#define KEYW_WS_METHOD_ROOTUNSUBSCRIBE 107L
+#define KEYW_WS_METHOD_SIGNATURESUBSCRIBE 108L
+#define KEYW_WS_METHOD_SIGNATUREUNSUBSCRIBE 109L
+#define KEYW_WS_METHOD_SLOTSUBSCRIBE 110L
+#define KEYW_WS_METHOD_SLOTUNSUBSCRIBE 111L
+#define KEYW_WS_METHOD_SLOTSUPDATESSUBSCRIBE 112L
+#define KEYW_WS_METHOD_SLOTSUPDATESUNSUBSCRIBE 113L
+#define KEYW_WS_METHOD_VOTESUBSCRIBE 114L
+#define KEYW_WS_METHOD_VOTEUNSUBSCRIBE 115L
 #ifndef KEYW_UNKNOWN
 #define KEYW_UNKNOWN -1L
 #endif
@@ -456,6 +456,56 @@ void test_fd_webserver_json_keyword(void) {
   assert(fd_webserver_json_keyword("excludeNonCirculatingAccountsL|st\0\0\0\0\0\0\0", 33) == KEYW_UNKNOWN);
   assert(fd_webserver_json_keyword("excludeNonCirculatingAccountsLi|t\0\0\0\0\0\0\0", 33) == KEYW_UNKNOWN);
   assert(fd_webserver_json_keyword("excludeNonCirculatingAccountsLis|\0\0\0\0\0\0\0", 33) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_JSON_REPLACERECENTBLOCKHASH);
+  assert(fd_webserver_json_keyword("replaceRecentBlockhashx\0\0\0\0\0\0\0", 23) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlockhas\0\0\0\0\0\0\0", 21) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("|eplaceRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("r|placeRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("re|laceRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("rep|aceRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("repl|ceRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("repla|eRecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replac|RecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replace|ecentBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceR|centBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRe|entBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRec|ntBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRece|tBlockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecen|Blockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecent|lockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentB|ockhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBl|ckhash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlo|khash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBloc|hash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlock|ash\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlockh|sh\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlockha|h\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("replaceRecentBlockhas|\0\0\0\0\0\0\0", 22) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigVerify\0\0\0\0\0\0\0", 9) == KEYW_JSON_SIGVERIFY);
+  assert(fd_webserver_json_keyword("sigVerifyx\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigVerif\0\0\0\0\0\0\0", 8) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("|igVerify\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("s|gVerify\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("si|Verify\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sig|erify\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigV|rify\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigVe|ify\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigVer|fy\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigVeri|y\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("sigVerif|\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("percentile\0\0\0\0\0\0\0", 10) == KEYW_JSON_PERCENTILE);
+  assert(fd_webserver_json_keyword("percentilex\0\0\0\0\0\0\0", 11) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("percentil\0\0\0\0\0\0\0", 9) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("|ercentile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("p|rcentile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("pe|centile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("per|entile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("perc|ntile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("perce|tile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("percen|ile\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("percent|le\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("percenti|e\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
+  assert(fd_webserver_json_keyword("percentil|\0\0\0\0\0\0\0", 10) == KEYW_UNKNOWN);
   assert(fd_webserver_json_keyword("getAccountInfo\0\0\0\0\0\0\0", 14) == KEYW_RPCMETHOD_GETACCOUNTINFO);
   assert(fd_webserver_json_keyword("getAccountInfox\0\0\0\0\0\0\0", 15) == KEYW_UNKNOWN);
   assert(fd_webserver_json_keyword("getAccountInf\0\0\0\0\0\0\0", 13) == KEYW_UNKNOWN);
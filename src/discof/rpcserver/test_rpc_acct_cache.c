@@ -0,0 +1,107 @@
+#include "fd_rpc_acct_cache.h"
+
+#define ENT_MAX (8UL)
+#define DATA_SZ (1000UL)
+
+static uchar mem[ 1UL<<16 ] __attribute__((aligned(128UL)));
+
+static fd_rpc_acct_cache_key_t
+test_key( uchar b,
+          ulong enc ) {
+  fd_rpc_acct_cache_key_t key;
+  memset( &key, 0, sizeof(key) );
+  memset( key.acct.uc, b, sizeof(fd_pubkey_t) );
+  key.off = LONG_MIN; /* FD_LONG_UNSET */
+  key.len = LONG_MIN;
+  key.enc = enc;
+  return key;
+}
+
+static fd_rpc_acct_cache_ver_t
+test_ver( ulong slot ) {
+  fd_rpc_acct_cache_ver_t ver = { .rec = 0x1000UL+slot, .val_gaddr = 0x2000UL+slot, .val_sz = 100UL, .slot = slot };
+  return ver;
+}
+
+static int
+test_hit( fd_rpc_acct_cache_t *           cache,
+          fd_rpc_acct_cache_key_t const * key,
+          fd_rpc_acct_cache_ver_t const * ver,
+          char const *                    data,
+          ulong                           data_sz ) {
+  ulong        sz  = 0UL;
+  char const * res = fd_rpc_acct_cache_query( cache, key, ver, &sz );
+  return res && sz==data_sz && !memcmp( res, data, sz );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_rpc_acct_cache_footprint( ENT_MAX, DATA_SZ )<=sizeof(mem) );
+  fd_rpc_acct_cache_t * cache = fd_rpc_acct_cache_join( fd_rpc_acct_cache_new( mem, ENT_MAX, DATA_SZ, 1234UL ) );
+  FD_TEST( cache );
+
+  char buf[ DATA_SZ ];
+  for( ulong i=0UL; i<DATA_SZ; i++ ) buf[ i ] = (char)( 'a' + (i % 26UL) );
+
+  fd_rpc_acct_cache_key_t a58 = test_key( 1, 0UL );
+  fd_rpc_acct_cache_key_t a64 = test_key( 1, 1UL );
+  fd_rpc_acct_cache_key_t b58 = test_key( 2, 0UL );
+  fd_rpc_acct_cache_ver_t v1  = test_ver( 1UL );
+  fd_rpc_acct_cache_ver_t v2  = test_ver( 2UL );
+
+  /* Hits are per key and version */
+  FD_TEST( !test_hit( cache, &a58, &v1, buf, 10UL ) );
+  fd_rpc_acct_cache_insert( cache, &a58, &v1, buf,     10UL );
+  fd_rpc_acct_cache_insert( cache, &a64, &v1, buf+10,  20UL );
+  FD_TEST(  test_hit( cache, &a58, &v1, buf,    10UL ) );
+  FD_TEST(  test_hit( cache, &a64, &v1, buf+10, 20UL ) );
+  FD_TEST( !test_hit( cache, &b58, &v1, buf,    10UL ) );
+  fd_rpc_acct_cache_key_t sliced = a58;
+  sliced.off = 0L; sliced.len = 4L;
+  FD_TEST( !test_hit( cache, &sliced, &v1, buf, 10UL ) );
+
+  /* A new version of the account drops the entry */
+  FD_TEST( !test_hit( cache, &a58, &v2, buf, 10UL ) );
+  FD_TEST( !test_hit( cache, &a58, &v1, buf, 10UL ) );
+  FD_TEST(  test_hit( cache, &a64, &v1, buf+10, 20UL ) );
+  fd_rpc_acct_cache_insert( cache, &a58, &v2, buf+5, 10UL );
+  FD_TEST(  test_hit( cache, &a58, &v2, buf+5, 10UL ) );
+
+  /* Inserting again replaces the entry */
+  fd_rpc_acct_cache_insert( cache, &a58, &v2, buf+7, 11UL );
+  FD_TEST(  test_hit( cache, &a58, &v2, buf+7, 11UL ) );
+
+  /* Too large to cache */
+  fd_rpc_acct_cache_insert( cache, &b58, &v1, buf, DATA_SZ/4UL+1UL );
+  FD_TEST( !test_hit( cache, &b58, &v1, buf, DATA_SZ/4UL+1UL ) );
+
+  /* Wrapping around the ring evicts the oldest entries first */
+  for( uchar i=0; i<40; i++ ) {
+    fd_rpc_acct_cache_key_t key = test_key( (uchar)(10+i), 0UL );
+    fd_rpc_acct_cache_insert( cache, &key, &v1, buf+i, 200UL );
+    FD_TEST( test_hit( cache, &key, &v1, buf+i, 200UL ) );
+    if( i ) {
+      fd_rpc_acct_cache_key_t prev = test_key( (uchar)(10+i-1), 0UL );
+      FD_TEST( test_hit( cache, &prev, &v1, buf+i-1, 200UL ) );
+    }
+  }
+  FD_TEST( !test_hit( cache, &a64, &v1, buf+10, 20UL ) );
+  FD_TEST( !test_hit( cache, &a58, &v2, buf+7,  11UL ) );
+
+  /* Running out of entries evicts the oldest too */
+  for( uchar i=0; i<ENT_MAX+2UL; i++ ) {
+    fd_rpc_acct_cache_key_t key = test_key( (uchar)(100+i), 1UL );
+    fd_rpc_acct_cache_insert( cache, &key, &v2, buf+i, 1UL );
+  }
+  for( uchar i=0; i<ENT_MAX+2UL; i++ ) {
+    fd_rpc_acct_cache_key_t key = test_key( (uchar)(100+i), 1UL );
+    FD_TEST( test_hit( cache, &key, &v2, buf+i, 1UL )==( i>=2 ) );
+  }
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
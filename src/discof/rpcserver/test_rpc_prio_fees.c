@@ -0,0 +1,106 @@
+#include "fd_rpc_prio_fees.h"
+
+#define ACCT_MAX (4UL)
+
+static uchar mem[ 1UL<<20 ] __attribute__((aligned(128UL)));
+
+static fd_pubkey_t
+test_key( uchar b ) {
+  fd_pubkey_t key;
+  memset( key.uc, b, sizeof(fd_pubkey_t) );
+  return key;
+}
+
+static void
+test_query( fd_rpc_prio_fees_t * fees ) {
+  fd_pubkey_t a = test_key( 1 );
+  fd_pubkey_t b = test_key( 2 );
+  fd_pubkey_t c = test_key( 3 );
+
+  ulong                   txn_fee[ 3 ] = { 5UL, 1UL, 3UL };
+  fd_rpc_prio_fees_acct_t acct_fee[ 4 ] = { { a, 20UL }, { b, 1UL }, { a, 10UL }, { c, 3UL } };
+  fd_rpc_prio_fees_add_slot( fees, 1000UL, txn_fee, 3UL, acct_fee, 4UL );
+
+  ulong out_slot[ FD_RPC_PRIO_FEES_SLOT_MAX ];
+  ulong out_fee [ FD_RPC_PRIO_FEES_SLOT_MAX ];
+
+  /* The minimum over the slot, raised by the accounts */
+  FD_TEST( fd_rpc_prio_fees_query( fees, NULL, 0UL, 0UL, out_slot, out_fee )==1UL );
+  FD_TEST( out_slot[ 0 ]==1000UL && out_fee[ 0 ]==1UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, &a, 1UL, 0UL, out_slot, out_fee )==1UL );
+  FD_TEST( out_fee[ 0 ]==10UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, &b, 1UL, 0UL, out_slot, out_fee )==1UL );
+  FD_TEST( out_fee[ 0 ]==1UL );
+  fd_pubkey_t ac[ 2 ] = { a, c };
+  FD_TEST( fd_rpc_prio_fees_query( fees, ac, 2UL, 0UL, out_slot, out_fee )==1UL );
+  FD_TEST( out_fee[ 0 ]==10UL );
+
+  /* Other rungs of the ladder */
+  FD_TEST( fd_rpc_prio_fees_pctl_idx( 0UL     )==0UL );
+  FD_TEST( fd_rpc_prio_fees_pctl_idx( 5000UL  )==2UL );
+  FD_TEST( fd_rpc_prio_fees_pctl_idx( 8000UL  )==4UL );
+  FD_TEST( fd_rpc_prio_fees_pctl_idx( 20000UL )==FD_RPC_PRIO_FEES_PCTL_CNT-1UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, NULL, 0UL, fd_rpc_prio_fees_pctl_idx( 5000UL ), out_slot, out_fee )==1UL );
+  FD_TEST( out_fee[ 0 ]==3UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, &a, 1UL, fd_rpc_prio_fees_pctl_idx( 10000UL ), out_slot, out_fee )==1UL );
+  FD_TEST( out_fee[ 0 ]==20UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, &c, 1UL, fd_rpc_prio_fees_pctl_idx( 10000UL ), out_slot, out_fee )==1UL );
+  FD_TEST( out_fee[ 0 ]==5UL );
+
+  /* A slot without transactions, and one replacing its summary */
+  fd_rpc_prio_fees_add_slot( fees, 1002UL, NULL, 0UL, NULL, 0UL );
+  txn_fee[ 0 ] = 7UL;
+  fd_rpc_prio_fees_add_slot( fees, 1000UL, txn_fee, 1UL, NULL, 0UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, &a, 1UL, 0UL, out_slot, out_fee )==2UL );
+  FD_TEST( out_slot[ 0 ]==1000UL && out_fee[ 0 ]==7UL );
+  FD_TEST( out_slot[ 1 ]==1002UL && out_fee[ 1 ]==0UL );
+}
+
+static void
+test_window( fd_rpc_prio_fees_t * fees ) {
+  fd_pubkey_t a = test_key( 1 );
+  ulong out_slot[ FD_RPC_PRIO_FEES_SLOT_MAX ];
+  ulong out_fee [ FD_RPC_PRIO_FEES_SLOT_MAX ];
+
+  /* Every slot has a ladder for a, but only ACCT_MAX fit */
+  for( ulong slot=2000UL; slot<2400UL; slot++ ) {
+    ulong                   txn_fee[ 2 ]  = { slot, slot+1UL };
+    fd_rpc_prio_fees_acct_t acct_fee[ 1 ] = { { a, slot+1UL } };
+    fd_rpc_prio_fees_add_slot( fees, slot, txn_fee, 2UL, acct_fee, 1UL );
+  }
+
+  FD_TEST( fd_rpc_prio_fees_query( fees, &a, 1UL, 0UL, out_slot, out_fee )==FD_RPC_PRIO_FEES_SLOT_MAX );
+  for( ulong i=0UL; i<FD_RPC_PRIO_FEES_SLOT_MAX; i++ ) {
+    ulong slot = 2400UL-FD_RPC_PRIO_FEES_SLOT_MAX+i;
+    FD_TEST( out_slot[ i ]==slot );
+    FD_TEST( out_fee[ i ]==( i>=FD_RPC_PRIO_FEES_SLOT_MAX-ACCT_MAX ? slot+1UL : slot ) );
+  }
+
+  /* Slots behind the window are ignored */
+  ulong txn_fee[ 1 ] = { 99UL };
+  fd_rpc_prio_fees_add_slot( fees, 2000UL, txn_fee, 1UL, NULL, 0UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, NULL, 0UL, 0UL, out_slot, out_fee )==FD_RPC_PRIO_FEES_SLOT_MAX );
+  FD_TEST( out_slot[ 0 ]==2400UL-FD_RPC_PRIO_FEES_SLOT_MAX );
+
+  /* Jumping past the window evicts everything */
+  fd_rpc_prio_fees_add_slot( fees, 2600UL, txn_fee, 1UL, NULL, 0UL );
+  FD_TEST( fd_rpc_prio_fees_query( fees, &a, 1UL, 0UL, out_slot, out_fee )==1UL );
+  FD_TEST( out_slot[ 0 ]==2600UL && out_fee[ 0 ]==99UL );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_rpc_prio_fees_footprint( ACCT_MAX )<=sizeof(mem) );
+  fd_rpc_prio_fees_t * fees = fd_rpc_prio_fees_join( fd_rpc_prio_fees_new( mem, ACCT_MAX, 1234UL ) );
+  FD_TEST( fees );
+
+  test_query( fees );
+  test_window( fees );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
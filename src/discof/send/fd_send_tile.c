@@ -500,6 +500,7 @@ unprivileged_init( fd_topo_t *      topo,
   quic->config.idle_timeout  = QUIC_IDLE_TIMEOUT_NS;
   quic->config.ack_delay     = QUIC_ACK_DELAY_NS;
   quic->config.keep_alive    = 1;
+  quic->config.session_ticket_ttl = (ulong)QUIC_SESSION_TTL_NS;
   quic->config.sign          = quic_tls_cv_sign;
   quic->config.sign_ctx      = ctx;
   fd_memcpy( quic->config.identity_public_key, ctx->identity_key, sizeof(ctx->identity_key) );
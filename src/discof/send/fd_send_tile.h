@@ -28,6 +28,7 @@
 
 #define QUIC_IDLE_TIMEOUT_NS (2e9)  /* 2 seconds */
 #define QUIC_ACK_DELAY_NS    (25e6) /* 25ms */
+#define QUIC_SESSION_TTL_NS  (3600e9) /* 1 hour */
 
 struct fd_send_link_in {
   fd_wksp_t *  mem;
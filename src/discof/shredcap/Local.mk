@@ -1,3 +1,9 @@
 ifdef FD_HAS_INT128
-$(call add-objs,fd_shredcap_tile,fd_discof)
+$(call add-hdrs,fd_shredcap.h)
+$(call add-objs,fd_shredcap_tile fd_shredcap,fd_discof)
+ifdef FD_HAS_HOSTED
+$(call make-bin,fd_shredcap_convert,fd_shredcap_convert,fd_discof fd_flamenco fd_ballet fd_util)
+$(call make-unit-test,test_shredcap,test_shredcap,fd_discof fd_util)
+$(call run-unit-test,test_shredcap)
+endif
 endif
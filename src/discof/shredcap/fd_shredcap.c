@@ -0,0 +1,210 @@
+#define _GNU_SOURCE
+#include "fd_shredcap.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+/* The ring holds the bytes at file offsets [write_off,data_off), at
+   ring position offset%buf_sz.  At most buf_sz-FD_SHREDCAP_WRITE_ALIGN
+   bytes are buffered at any time, such that the page holding data_off
+   can be written out zero padded without clobbering any unwritten
+   bytes. */
+
+static inline ulong
+ring_free( fd_shredcap_writer_t const * w ) {
+  return w->buf_sz - FD_SHREDCAP_WRITE_ALIGN - (w->data_off - w->write_off);
+}
+
+/* write_range writes the file range [off,off+sz) from the ring.  off
+   and sz are multiples of FD_SHREDCAP_WRITE_ALIGN and the range is
+   buffered.  The range may wrap around the end of the ring. */
+
+static int
+write_range( fd_shredcap_writer_t * w,
+             ulong                  off,
+             ulong                  sz ) {
+  while( sz ) {
+    ulong pos = off % w->buf_sz;
+    ulong len = fd_ulong_min( sz, w->buf_sz-pos );
+    long  res = pwrite( w->fd, w->buf+pos, len, (long)off );
+    if( FD_UNLIKELY( res<=0L ) ) {
+      if( FD_LIKELY( res<0L && errno==EINTR ) ) continue;
+      return res<0L ? errno : EIO;
+    }
+    w->metrics.write_cnt++;
+    off += (ulong)res;
+    sz  -= (ulong)res;
+  }
+  return 0;
+}
+
+/* write_aligned writes up to max_sz bytes of the complete pages
+   buffered and advances write_off. */
+
+static int
+write_aligned( fd_shredcap_writer_t * w,
+               ulong                  max_sz ) {
+  ulong sz = fd_ulong_min( fd_ulong_align_dn( w->data_off, FD_SHREDCAP_WRITE_ALIGN ) - w->write_off, max_sz );
+  if( FD_UNLIKELY( !sz ) ) return 0;
+  int err = write_range( w, w->write_off, sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  w->write_off += sz;
+  return 0;
+}
+
+static int
+write_idx( fd_shredcap_writer_t * w ) {
+  uchar const * src = (uchar const *)w->idx_buf;
+  ulong         sz  = w->idx_cnt*sizeof(fd_shredcap_idx_t);
+  while( sz ) {
+    long res = write( w->idx_fd, src, sz );
+    if( FD_UNLIKELY( res<=0L ) ) {
+      if( FD_LIKELY( res<0L && errno==EINTR ) ) continue;
+      return res<0L ? errno : EIO;
+    }
+    src += (ulong)res;
+    sz  -= (ulong)res;
+  }
+  w->idx_cnt = 0UL;
+  return 0;
+}
+
+/* ring_append copies [src,src+sz) into the ring, or zeros if src is
+   NULL.  If the ring is full, it synchronously writes out a chunk to
+   make room. */
+
+static int
+ring_append( fd_shredcap_writer_t * w,
+             void const *           src,
+             ulong                  sz ) {
+  uchar const * p = (uchar const *)src;
+  while( sz ) {
+    ulong free = ring_free( w );
+    if( FD_UNLIKELY( !free ) ) {
+      w->metrics.stall_cnt++;
+      int err = write_aligned( w, w->chunk_sz );
+      if( FD_UNLIKELY( err ) ) return err;
+      continue;
+    }
+    ulong pos = w->data_off % w->buf_sz;
+    ulong cp  = fd_ulong_min( fd_ulong_min( sz, free ), w->buf_sz-pos );
+    if( FD_LIKELY( p ) ) { fd_memcpy( w->buf+pos, p, cp ); p += cp; }
+    else                 fd_memset( w->buf+pos, 0,  cp );
+    w->data_off += cp;
+    sz          -= cp;
+  }
+  return 0;
+}
+
+fd_shredcap_writer_t *
+fd_shredcap_writer_init( fd_shredcap_writer_t * w,
+                         int                    fd,
+                         int                    idx_fd,
+                         void *                 buf,
+                         ulong                  buf_sz,
+                         ulong                  chunk_sz,
+                         fd_shredcap_idx_t *    idx_buf,
+                         ulong                  idx_max,
+                         long                   ts ) {
+  if( FD_UNLIKELY( !w ) ) {
+    FD_LOG_WARNING(( "NULL w" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)buf, FD_SHREDCAP_WRITE_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned buf" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !chunk_sz || !fd_ulong_is_aligned( chunk_sz, FD_SHREDCAP_WRITE_ALIGN ) ||
+                   !fd_ulong_is_aligned( buf_sz, FD_SHREDCAP_WRITE_ALIGN ) ||
+                   buf_sz<fd_ulong_max( 2UL*chunk_sz, 4UL*FD_SHREDCAP_WRITE_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "bad buf_sz (%lu) or chunk_sz (%lu)", buf_sz, chunk_sz ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !idx_buf || !idx_max ) ) {
+    FD_LOG_WARNING(( "bad idx_buf" ));
+    return NULL;
+  }
+
+  memset( w, 0, sizeof(fd_shredcap_writer_t) );
+  w->fd       = fd;
+  w->idx_fd   = idx_fd;
+  w->buf      = (uchar *)buf;
+  w->buf_sz   = buf_sz;
+  w->chunk_sz = chunk_sz;
+  w->idx_buf  = idx_buf;
+  w->idx_max  = idx_max;
+
+  fd_shredcap_file_hdr_t hdr = {
+    .magic   = FD_SHREDCAP_MAGIC,
+    .version = FD_SHREDCAP_VERSION,
+    .ts      = ts,
+  };
+  if( FD_UNLIKELY( ring_append( w, &hdr, sizeof(fd_shredcap_file_hdr_t) ) ) ) return NULL; /* Cannot fail, ring is empty */
+  return w;
+}
+
+int
+fd_shredcap_writer_append( fd_shredcap_writer_t * w,
+                           uint                   type,
+                           long                   ts,
+                           ulong                  slot,
+                           void const *           payload,
+                           ulong                  sz ) {
+  if( FD_UNLIKELY( slot!=FD_SHREDCAP_SLOT_NONE ) ) {
+    if( FD_UNLIKELY( w->idx_cnt==w->idx_max ) ) {
+      int err = write_idx( w );
+      if( FD_UNLIKELY( err ) ) return err;
+    }
+    w->idx_buf[ w->idx_cnt++ ] = (fd_shredcap_idx_t){
+      .slot = slot,
+      .off  = w->data_off,
+      .ts   = ts,
+      .type = type,
+      .sz   = (uint)sz,
+    };
+  }
+
+  fd_shredcap_frame_t frame = { .type = type, .sz = (uint)sz, .ts = ts };
+  int err = ring_append( w, &frame, sizeof(fd_shredcap_frame_t) );
+  if( FD_LIKELY( !err ) ) err = ring_append( w, payload, sz );
+  if( FD_LIKELY( !err ) ) err = ring_append( w, NULL, fd_ulong_align_up( sz, FD_SHREDCAP_FRAME_ALIGN )-sz );
+  if( FD_UNLIKELY( err ) ) return err;
+
+  w->metrics.frame_cnt++;
+  w->metrics.byte_cnt += fd_shredcap_frame_footprint( sz );
+  return 0;
+}
+
+int
+fd_shredcap_writer_poll( fd_shredcap_writer_t * w ) {
+  if( FD_LIKELY( fd_ulong_align_dn( w->data_off, FD_SHREDCAP_WRITE_ALIGN ) - w->write_off<w->chunk_sz ) ) return 0;
+  return write_aligned( w, w->chunk_sz );
+}
+
+int
+fd_shredcap_writer_flush( fd_shredcap_writer_t * w ) {
+  int err = write_aligned( w, ULONG_MAX );
+  if( FD_UNLIKELY( err ) ) return err;
+
+  /* Write the last, partially filled page zero padded.  write_off is
+     not advanced, so the page is written again once it fills up. */
+
+  if( FD_LIKELY( w->data_off>w->write_off ) ) {
+    ulong end = fd_ulong_align_up( w->data_off, FD_SHREDCAP_WRITE_ALIGN );
+    fd_memset( w->buf + w->data_off%w->buf_sz, 0, end-w->data_off );
+    err = write_range( w, w->write_off, FD_SHREDCAP_WRITE_ALIGN );
+    if( FD_UNLIKELY( err ) ) return err;
+  }
+
+  return write_idx( w );
+}
+
+int
+fd_shredcap_writer_fini( fd_shredcap_writer_t * w ) {
+  int err = fd_shredcap_writer_flush( w );
+  w->fd      = -1;
+  w->idx_fd  = -1;
+  w->buf     = NULL;
+  w->idx_buf = NULL;
+  return err;
+}
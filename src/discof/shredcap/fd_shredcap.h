@@ -0,0 +1,254 @@
+#ifndef HEADER_fd_src_discof_shredcap_fd_shredcap_h
+#define HEADER_fd_src_discof_shredcap_fd_shredcap_h
+
+/* fd_shredcap provides the capture format written by the shredcap tile
+   and a writer for it.
+
+   A capture is a single file holding every kind of record the tile
+   observes (turbine and repair shreds, repair requests, FEC set
+   completions, peers, slices handed to replay and bank hashes), so
+   that ordering across record kinds is preserved and the tile only
+   has to keep one stream.  It is laid out as
+
+     [ fd_shredcap_file_hdr_t ]
+     [ frame ][ frame ] ...
+
+   where each frame is a fd_shredcap_frame_t followed by sz payload
+   bytes, padded with zeros to a multiple of FD_SHREDCAP_FRAME_ALIGN.
+   The file may end with zero padding (the writer writes whole pages),
+   so a frame with type FD_SHREDCAP_FRAME_TYPE_NONE marks the end of
+   the capture.  Fixed size records are in host byte order.
+
+   Every slice and bank hash frame additionally gets an entry in a
+   per-file index, which is a separate file of fd_shredcap_idx_t
+   records in capture order.  This allows seeking a capture to a slot
+   without scanning all the shreds in front of it.
+
+   The legacy per-stream files (csv streams, slices.bin and
+   bank_hashes.bin) can be regenerated from a capture with
+   fd_shredcap_convert. */
+
+#include "../../util/fd_util.h"
+
+#define FD_SHREDCAP_MAGIC   (0xf17eda2c5c4bca95UL)
+#define FD_SHREDCAP_VERSION (1UL)
+
+/* FD_SHREDCAP_WRITE_ALIGN is the alignment of writes to the capture
+   file, such that it can be opened with O_DIRECT. */
+
+#define FD_SHREDCAP_WRITE_ALIGN (4096UL)
+
+#define FD_SHREDCAP_FRAME_ALIGN (8UL)
+
+#define FD_SHREDCAP_FRAME_TYPE_NONE      (0U) /* end of capture */
+#define FD_SHREDCAP_FRAME_TYPE_SHRED     (1U) /* fd_shredcap_shred_t, a shred snooped from net_shred */
+#define FD_SHREDCAP_FRAME_TYPE_REQUEST   (2U) /* fd_shredcap_request_t, a repair request sent */
+#define FD_SHREDCAP_FRAME_TYPE_FEC       (3U) /* fd_shredcap_fec_t, a FEC set completed */
+#define FD_SHREDCAP_FRAME_TYPE_PEER      (4U) /* fd_shredcap_peer_t, a turbine or repair peer */
+#define FD_SHREDCAP_FRAME_TYPE_SLICE     (5U) /* The data shreds of a slice handed to replay, back to back */
+#define FD_SHREDCAP_FRAME_TYPE_BANK_HASH (6U) /* fd_shredcap_bank_hash_t */
+#define FD_SHREDCAP_FRAME_TYPE_MAX       (7U)
+
+/* FD_SHREDCAP_SLOT_NONE is passed as the slot of frames that should
+   not be indexed. */
+
+#define FD_SHREDCAP_SLOT_NONE (ULONG_MAX)
+
+struct fd_shredcap_file_hdr {
+  ulong magic;      /* ==FD_SHREDCAP_MAGIC */
+  ulong version;    /* ==FD_SHREDCAP_VERSION */
+  long  ts;         /* Wallclock when the capture was started */
+  ulong reserved[5];
+};
+
+typedef struct fd_shredcap_file_hdr fd_shredcap_file_hdr_t;
+
+struct fd_shredcap_frame {
+  uint type; /* FD_SHREDCAP_FRAME_TYPE_* */
+  uint sz;   /* Payload size in bytes, excluding padding */
+  long ts;   /* Wallclock when the record was captured */
+};
+
+typedef struct fd_shredcap_frame fd_shredcap_frame_t;
+
+struct fd_shredcap_shred {
+  uint   src_ip4;     /* Network byte order */
+  ushort src_port;    /* Network byte order */
+  uchar  is_turbine;
+  uchar  is_data;
+  ulong  slot;
+  uint   idx;
+  uint   fec_set_idx;
+  uint   nonce;       /* 0 for turbine shreds */
+  uint   ref_tick;    /* 65 if unknown */
+};
+
+typedef struct fd_shredcap_shred fd_shredcap_shred_t;
+
+struct fd_shredcap_request {
+  uint   dst_ip4;   /* Network byte order */
+  ushort dst_port;  /* Network byte order */
+  ushort reserved;
+  uint   nonce;
+  ulong  slot;
+  ulong  shred_idx; /* UINT_MAX for orphan requests */
+};
+
+typedef struct fd_shredcap_request fd_shredcap_request_t;
+
+struct fd_shredcap_fec {
+  ulong slot;
+  uint  ref_tick;
+  uint  fec_set_idx;
+  uint  data_cnt;
+  uint  reserved;
+};
+
+typedef struct fd_shredcap_fec fd_shredcap_fec_t;
+
+struct fd_shredcap_peer {
+  uint   ip4_addr;
+  ushort udp_port;
+  uchar  is_turbine;
+  uchar  reserved;
+  uchar  pubkey[ 32 ];
+};
+
+typedef struct fd_shredcap_peer fd_shredcap_peer_t;
+
+struct fd_shredcap_bank_hash {
+  ulong slot;
+  uchar bank_hash[ 32 ];
+};
+
+typedef struct fd_shredcap_bank_hash fd_shredcap_bank_hash_t;
+
+struct fd_shredcap_idx {
+  ulong slot;
+  ulong off;  /* File offset of the frame */
+  long  ts;   /* Timestamp of the frame */
+  uint  type; /* Type of the frame */
+  uint  sz;   /* Payload size of the frame */
+};
+
+typedef struct fd_shredcap_idx fd_shredcap_idx_t;
+
+/* fd_shredcap_writer_t writes a capture.  Frames are appended to a
+   large ring buffer in memory and the ring is drained to the capture
+   file in FD_SHREDCAP_WRITE_ALIGN aligned writes of chunk_sz bytes
+   from the caller's idle loop (fd_shredcap_writer_poll), so appending
+   a frame is just a copy.  Appends only block on the file when the
+   ring is full.  It is a local object owned by a single thread. */
+
+struct fd_shredcap_writer {
+  int     fd;        /* Capture file, written with pwrite */
+  int     idx_fd;    /* Index file, written with write */
+  uchar * buf;       /* Ring, aligned FD_SHREDCAP_WRITE_ALIGN, indexed [0,buf_sz) */
+  ulong   buf_sz;    /* Multiple of FD_SHREDCAP_WRITE_ALIGN */
+  ulong   chunk_sz;  /* Multiple of FD_SHREDCAP_WRITE_ALIGN, size of a write during poll */
+  ulong   data_off;  /* File offset of the next byte to append */
+  ulong   write_off; /* File offset of the first byte not yet written (aligned) */
+
+  fd_shredcap_idx_t * idx_buf; /* Pending index entries, indexed [0,idx_cnt) */
+  ulong               idx_max;
+  ulong               idx_cnt;
+
+  struct {
+    ulong frame_cnt;
+    ulong byte_cnt;
+    ulong write_cnt;
+    ulong stall_cnt; /* Appends that had to wait for the file */
+  } metrics;
+};
+
+typedef struct fd_shredcap_writer fd_shredcap_writer_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_shredcap_frame_footprint returns the number of bytes a frame with
+   a payload of sz bytes occupies in a capture. */
+
+FD_FN_CONST static inline ulong
+fd_shredcap_frame_footprint( ulong sz ) {
+  return sizeof(fd_shredcap_frame_t) + fd_ulong_align_up( sz, FD_SHREDCAP_FRAME_ALIGN );
+}
+
+/* fd_shredcap_frame_next returns the frame at offset *off of a capture
+   held in memory at [data,data+data_sz) and advances *off past it.
+   Returns NULL at the end of the capture or if the frame is truncated
+   or malformed. */
+
+FD_FN_PURE static inline fd_shredcap_frame_t const *
+fd_shredcap_frame_next( uchar const * data,
+                        ulong         data_sz,
+                        ulong *       off ) {
+  ulong o = *off;
+  if( FD_UNLIKELY( o>data_sz || data_sz-o<sizeof(fd_shredcap_frame_t) ) ) return NULL;
+  fd_shredcap_frame_t const * frame = (fd_shredcap_frame_t const *)(data+o);
+  if( FD_UNLIKELY( frame->type==FD_SHREDCAP_FRAME_TYPE_NONE || frame->type>=FD_SHREDCAP_FRAME_TYPE_MAX ) ) return NULL;
+  ulong footprint = fd_shredcap_frame_footprint( frame->sz );
+  if( FD_UNLIKELY( footprint>data_sz-o ) ) return NULL;
+  *off = o + footprint;
+  return frame;
+}
+
+/* fd_shredcap_writer_init starts a capture in the file fd (which should
+   be empty and open for writing, possibly with O_DIRECT) and its index
+   in the file idx_fd.  buf is a ring of buf_sz bytes and idx_buf a
+   buffer for idx_max index entries.  buf and buf_sz must be multiples
+   of FD_SHREDCAP_WRITE_ALIGN and buf_sz must hold at least two chunks
+   of chunk_sz bytes.  The writer has ownership of the fds and buffers
+   until fini.  Returns w on success or NULL on failure (logs details). */
+
+fd_shredcap_writer_t *
+fd_shredcap_writer_init( fd_shredcap_writer_t * w,
+                         int                    fd,
+                         int                    idx_fd,
+                         void *                 buf,
+                         ulong                  buf_sz,
+                         ulong                  chunk_sz,
+                         fd_shredcap_idx_t *    idx_buf,
+                         ulong                  idx_max,
+                         long                   ts );
+
+/* fd_shredcap_writer_append appends a frame of the given type, with
+   timestamp ts and payload [payload,payload+sz).  If slot is not
+   FD_SHREDCAP_SLOT_NONE, the frame is indexed under slot.  Returns 0
+   on success or an errno compatible error code if the ring was full and
+   writing to the file failed, in which case the writer should be
+   considered failed. */
+
+int
+fd_shredcap_writer_append( fd_shredcap_writer_t * w,
+                           uint                   type,
+                           long                   ts,
+                           ulong                  slot,
+                           void const *           payload,
+                           ulong                  sz );
+
+/* fd_shredcap_writer_poll does a bounded amount of background work: if
+   at least chunk_sz bytes are buffered, it writes one chunk to the
+   file.  It should be called from the owner's idle loop.  Returns 0 on
+   success or an errno compatible error code. */
+
+int
+fd_shredcap_writer_poll( fd_shredcap_writer_t * w );
+
+/* fd_shredcap_writer_flush writes everything buffered, including a
+   partially filled last page (padded with zeros, it will be rewritten
+   as more frames are appended) and the pending index entries, such
+   that the capture can be read back up to the last appended frame.
+   Returns 0 on success or an errno compatible error code. */
+
+int
+fd_shredcap_writer_flush( fd_shredcap_writer_t * w );
+
+/* fd_shredcap_writer_fini flushes and releases ownership of the fds
+   and buffers.  Returns the result of the flush. */
+
+int
+fd_shredcap_writer_fini( fd_shredcap_writer_t * w );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_shredcap_fd_shredcap_h */
@@ -0,0 +1,206 @@
+#define _GNU_SOURCE
+
+/* fd_shredcap_convert converts a capture written by the shredcap tile
+   (see fd_shredcap.h) into the per-stream files the shredcap tile used
+   to write, which are what contrib/repair-analysis/report.py and the
+   backtest tile consume:
+
+     shred_data.csv, request_data.csv, fec_complete.csv, peers.csv
+     slices.bin, bank_hashes.bin
+
+   Usage:
+
+     fd_shredcap_convert --capture <folder>/capture.bin --out <folder>
+                         [--start-slot <slot>]
+
+   With --start-slot, the capture index (<capture>.idx) is used to skip
+   to the first slice or bank hash at or after the given slot, and
+   slices and bank hashes for earlier slots are not converted. */
+
+#include "fd_shredcap.h"
+#include "../fd_discof.h"
+#include "../../ballet/base58/fd_base58.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uchar const *
+map_file( char const * path,
+          ulong *      sz_out ) {
+  int fd = open( path, O_RDONLY );
+  if( FD_UNLIKELY( fd<0 ) ) FD_LOG_ERR(( "open(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  struct stat st;
+  if( FD_UNLIKELY( fstat( fd, &st ) ) ) FD_LOG_ERR(( "fstat(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  ulong sz = (ulong)st.st_size;
+  uchar const * data = NULL;
+  if( FD_LIKELY( sz ) ) {
+    data = mmap( NULL, sz, PROT_READ, MAP_PRIVATE, fd, 0 );
+    if( FD_UNLIKELY( data==MAP_FAILED ) ) FD_LOG_ERR(( "mmap(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  }
+  FD_TEST( !close( fd ) );
+  *sz_out = sz;
+  return data;
+}
+
+static FILE *
+open_out( char const * folder,
+          char const * name,
+          char const * csv_header ) {
+  char path[ PATH_MAX ];
+  FD_TEST( fd_cstr_printf_check( path, sizeof(path), NULL, "%s/%s", folder, name ) );
+  FILE * file = fopen( path, "w" );
+  if( FD_UNLIKELY( !file ) ) FD_LOG_ERR(( "fopen(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  if( csv_header ) fputs( csv_header, file );
+  return file;
+}
+
+/* start_off returns the offset of the first frame to convert for
+   --start-slot. */
+
+static ulong
+start_off( char const * capture_path,
+           ulong        start_slot ) {
+  char idx_path[ PATH_MAX ];
+  FD_TEST( fd_cstr_printf_check( idx_path, sizeof(idx_path), NULL, "%s.idx", capture_path ) );
+  ulong idx_sz;
+  fd_shredcap_idx_t const * idx = (fd_shredcap_idx_t const *)map_file( idx_path, &idx_sz );
+  ulong idx_cnt = idx_sz / sizeof(fd_shredcap_idx_t);
+
+  /* Slices arrive out of slot order (repair can finish an older slot
+     after a newer one), so this is a scan rather than a search. */
+
+  ulong off = ULONG_MAX;
+  for( ulong i=0UL; i<idx_cnt; i++ ) {
+    if( idx[ i ].slot>=start_slot ) { off = idx[ i ].off; break; }
+  }
+  if( FD_LIKELY( idx ) ) FD_TEST( !munmap( (void *)idx, idx_sz ) );
+  FD_LOG_NOTICE(( "index has %lu entries, starting at offset %lu", idx_cnt, off ));
+  return off;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * capture_path = fd_env_strip_cmdline_cstr ( &argc, &argv, "--capture",    NULL, NULL      );
+  char const * out_path     = fd_env_strip_cmdline_cstr ( &argc, &argv, "--out",        NULL, NULL      );
+  ulong        start_slot   = fd_env_strip_cmdline_ulong( &argc, &argv, "--start-slot", NULL, 0UL       );
+
+  if( FD_UNLIKELY( !capture_path ) ) FD_LOG_ERR(( "--capture not specified" ));
+  if( FD_UNLIKELY( !out_path     ) ) FD_LOG_ERR(( "--out not specified" ));
+
+  ulong         data_sz;
+  uchar const * data = map_file( capture_path, &data_sz );
+
+  fd_shredcap_file_hdr_t const * hdr = (fd_shredcap_file_hdr_t const *)data;
+  if( FD_UNLIKELY( data_sz<sizeof(fd_shredcap_file_hdr_t) || hdr->magic!=FD_SHREDCAP_MAGIC ) ) {
+    FD_LOG_ERR(( "%s is not a shredcap capture", capture_path ));
+  }
+  if( FD_UNLIKELY( hdr->version!=FD_SHREDCAP_VERSION ) ) {
+    FD_LOG_ERR(( "%s has unsupported version %lu", capture_path, hdr->version ));
+  }
+
+  ulong off = sizeof(fd_shredcap_file_hdr_t);
+  if( start_slot ) off = start_off( capture_path, start_slot );
+
+  FILE * shreds      = open_out( out_path, "shred_data.csv",   "src_ip,src_port,timestamp,slot,ref_tick,fec_set_idx,idx,is_turbine,is_data,nonce\n" );
+  FILE * requests    = open_out( out_path, "request_data.csv", "dst_ip,dst_port,timestamp,nonce,slot,idx\n" );
+  FILE * fecs        = open_out( out_path, "fec_complete.csv", "timestamp,slot,ref_tick,fec_set_idx,data_cnt\n" );
+  FILE * peers       = open_out( out_path, "peers.csv",        "peer_ip4_addr,peer_port,pubkey,turbine\n" );
+  FILE * slices      = open_out( out_path, "slices.bin",       NULL );
+  FILE * bank_hashes = open_out( out_path, "bank_hashes.bin",  NULL );
+
+  ulong frame_cnt[ FD_SHREDCAP_FRAME_TYPE_MAX ] = {0};
+  ulong bad_cnt = 0UL;
+
+  fd_shredcap_frame_t const * frame;
+  while( (frame = fd_shredcap_frame_next( data, data_sz, &off )) ) {
+    void const * payload = frame+1;
+    ulong        sz      = frame->sz;
+    switch( frame->type ) {
+    case FD_SHREDCAP_FRAME_TYPE_SHRED: {
+      if( FD_UNLIKELY( sz<sizeof(fd_shredcap_shred_t) ) ) { bad_cnt++; continue; }
+      fd_shredcap_shred_t const * r = payload;
+      fprintf( shreds, "%u,%u,%ld,%lu,%u,%u,%u,%d,%d,%u\n",
+               r->src_ip4, (uint)r->src_port, frame->ts, r->slot, r->ref_tick, r->fec_set_idx, r->idx,
+               (int)r->is_turbine, (int)r->is_data, r->nonce );
+      break;
+    }
+    case FD_SHREDCAP_FRAME_TYPE_REQUEST: {
+      if( FD_UNLIKELY( sz<sizeof(fd_shredcap_request_t) ) ) { bad_cnt++; continue; }
+      fd_shredcap_request_t const * r = payload;
+      fprintf( requests, "%u,%u,%ld,%u,%lu,%lu\n",
+               r->dst_ip4, (uint)r->dst_port, frame->ts, r->nonce, r->slot, r->shred_idx );
+      break;
+    }
+    case FD_SHREDCAP_FRAME_TYPE_FEC: {
+      if( FD_UNLIKELY( sz<sizeof(fd_shredcap_fec_t) ) ) { bad_cnt++; continue; }
+      fd_shredcap_fec_t const * r = payload;
+      fprintf( fecs, "%ld,%lu,%u,%u,%u\n", frame->ts, r->slot, r->ref_tick, r->fec_set_idx, r->data_cnt );
+      break;
+    }
+    case FD_SHREDCAP_FRAME_TYPE_PEER: {
+      if( FD_UNLIKELY( sz<sizeof(fd_shredcap_peer_t) ) ) { bad_cnt++; continue; }
+      fd_shredcap_peer_t const * r = payload;
+      fprintf( peers, "%u,%u,%s,%d\n", r->ip4_addr, (uint)r->udp_port, FD_BASE58_ENC_32_ALLOCA( r->pubkey ), (int)r->is_turbine );
+      break;
+    }
+    case FD_SHREDCAP_FRAME_TYPE_SLICE: {
+      if( FD_UNLIKELY( sz>=FD_SHRED_DATA_HEADER_SZ && ((fd_shred_t const *)payload)->slot<start_slot ) ) continue;
+      fd_shredcap_slice_header_msg_t header = {
+        .magic      = FD_SHREDCAP_SLICE_HEADER_MAGIC,
+        .version    = FD_SHREDCAP_SLICE_HEADER_V1,
+        .payload_sz = sz,
+      };
+      fd_shredcap_slice_trailer_msg_t trailer = {
+        .magic   = FD_SHREDCAP_SLICE_TRAILER_MAGIC,
+        .version = FD_SHREDCAP_SLICE_TRAILER_V1,
+      };
+      fwrite( &header,  FD_SHREDCAP_SLICE_HEADER_FOOTPRINT,  1UL, slices );
+      fwrite( payload,  sz,                                  1UL, slices );
+      fwrite( &trailer, FD_SHREDCAP_SLICE_TRAILER_FOOTPRINT, 1UL, slices );
+      break;
+    }
+    case FD_SHREDCAP_FRAME_TYPE_BANK_HASH: {
+      if( FD_UNLIKELY( sz<sizeof(fd_shredcap_bank_hash_t) ) ) { bad_cnt++; continue; }
+      fd_shredcap_bank_hash_t const * r = payload;
+      if( FD_UNLIKELY( r->slot<start_slot ) ) continue;
+      fd_shredcap_bank_hash_msg_t msg = {
+        .magic   = FD_SHREDCAP_BANK_HASH_MAGIC,
+        .version = FD_SHREDCAP_BANK_HASH_V1,
+        .slot    = r->slot,
+      };
+      memcpy( msg.bank_hash.uc, r->bank_hash, sizeof(fd_hash_t) );
+      fwrite( &msg, FD_SHREDCAP_BANK_HASH_FOOTPRINT, 1UL, bank_hashes );
+      break;
+    }
+    default:
+      break;
+    }
+    frame_cnt[ frame->type ]++;
+  }
+
+  if( FD_UNLIKELY( off<data_sz && data[ off ] ) ) {
+    FD_LOG_WARNING(( "capture is corrupt or truncated at offset %lu", off ));
+  }
+
+  FILE * outs[] = { shreds, requests, fecs, peers, slices, bank_hashes };
+  for( ulong i=0UL; i<sizeof(outs)/sizeof(outs[0]); i++ ) {
+    if( FD_UNLIKELY( ferror( outs[ i ] ) || fclose( outs[ i ] ) ) ) FD_LOG_ERR(( "failed to write output in %s", out_path ));
+  }
+  if( FD_LIKELY( data ) ) FD_TEST( !munmap( (void *)data, data_sz ) );
+
+  FD_LOG_NOTICE(( "converted %lu shreds, %lu requests, %lu fec sets, %lu peers, %lu slices, %lu bank hashes (%lu malformed)",
+                  frame_cnt[ FD_SHREDCAP_FRAME_TYPE_SHRED ],     frame_cnt[ FD_SHREDCAP_FRAME_TYPE_REQUEST ],
+                  frame_cnt[ FD_SHREDCAP_FRAME_TYPE_FEC ],       frame_cnt[ FD_SHREDCAP_FRAME_TYPE_PEER ],
+                  frame_cnt[ FD_SHREDCAP_FRAME_TYPE_SLICE ],     frame_cnt[ FD_SHREDCAP_FRAME_TYPE_BANK_HASH ],
+                  bad_cnt ));
+
+  fd_halt();
+  return 0;
+}
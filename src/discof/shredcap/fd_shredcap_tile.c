@@ -6,6 +6,7 @@
 #include "../../util/pod/fd_pod_format.h"
 #include "../../disco/fd_disco.h"
 #include "../../discof/fd_discof.h"
+#include "fd_shredcap.h"
 
 #include <errno.h>
 #include <fcntl.h>
@@ -23,14 +24,26 @@
 /* This tile currently has two functionalities.
 
    The first is spying on the net_shred, repair_net, and shred_repair
-   links and currently outputs to a csv that can analyze repair
-   performance in post.
+   links to record shreds, repair requests and FEC set completions,
+   which can be used to analyze repair performance in post.
 
    The second is to capture the bank hashes from the replay tile and
-   slices of shreds from the repair tile.  These are outputted to binary
-   files that can be used to reproduce a live replay execution. */
-
-#define FD_SHREDCAP_DEFAULT_WRITER_BUF_SZ  (4096UL)  /* local filesystem block size */
+   slices of shreds from the repair tile, which can be used to reproduce
+   a live replay execution.
+
+   Everything is written as binary frames to a single capture file (see
+   fd_shredcap.h), capture.bin in the configured folder, along with its
+   index capture.bin.idx.  Records are copied into a large ring buffer
+   in the frag callbacks and the ring is drained to the file with large
+   aligned O_DIRECT writes while the tile is otherwise idle, so the
+   capture does not slow down the links it is spying on.  Use
+   fd_shredcap_convert to turn a capture into the csv and binary files
+   expected by the repair analysis scripts and the backtest tile. */
+
+#define FD_SHREDCAP_DEFAULT_WRITER_BUF_SZ  (64UL<<20) /* capture ring size */
+#define FD_SHREDCAP_WRITER_CHUNK_SZ        (1UL<<20)  /* size of a write to the capture file */
+#define FD_SHREDCAP_IDX_MAX                (4096UL)   /* index entries buffered */
+#define FD_SHREDCAP_FLUSH_INTERVAL_NS      (1000000000L)
 #define FD_SHREDCAP_ALLOC_TAG              (4UL)
 #define MAX_BUFFER_SIZE                    (20000UL * sizeof(fd_shred_dest_wire_t))
 
@@ -70,28 +83,9 @@ struct fd_capture_tile_ctx {
   ulong  last_packet_ns;
   double tick_per_ns;
 
-  fd_io_buffered_ostream_t shred_ostream;
-  fd_io_buffered_ostream_t repair_ostream;
-  fd_io_buffered_ostream_t fecs_ostream;
-  fd_io_buffered_ostream_t peers_ostream;
-  fd_io_buffered_ostream_t slices_ostream;
-  fd_io_buffered_ostream_t bank_hashes_ostream;
-
-  int shreds_fd; /* shreds snooped from net_shred */
-  int requests_fd;
-  int fecs_fd;
-  int peers_fd;
-  int slices_fd; /* all shreds in slices from repair tile */
-  int bank_hashes_fd; /* bank hashes from writer tile */
-
-  ulong write_buf_sz;
-
-  uchar * shreds_buf;
-  uchar * requests_buf;
-  uchar * fecs_buf;
-  uchar * peers_buf;
-  uchar * slices_buf;
-  uchar * bank_hashes_buf;
+  fd_shredcap_writer_t writer[1];
+  ulong                write_buf_sz;
+  long                 next_flush;
 
   fd_alloc_t * alloc;
   uchar contact_info_buffer[ MAX_BUFFER_SIZE ];
@@ -114,12 +108,10 @@ populate_allowed_seccomp( fd_topo_t const *      topo FD_PARAM_UNUSED,
                           ulong                  out_cnt,
                           struct sock_filter *   out ) {
   populate_sock_filter_policy_fd_shredcap_tile( out_cnt,
-                                             out,
-                                             (uint)fd_log_private_logfile_fd(),
-                                             (uint)tile->shredcap.shreds_fd,
-                                             (uint)tile->shredcap.requests_fd,
-                                             (uint)tile->shredcap.fecs_fd,
-                                             (uint)tile->shredcap.peers_fd );
+                                                out,
+                                                (uint)fd_log_private_logfile_fd(),
+                                                (uint)tile->shredcap.capture_fd,
+                                                (uint)tile->shredcap.index_fd );
   return sock_filter_policy_fd_shredcap_tile_instr_cnt;
 }
 
@@ -133,6 +125,59 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
+/* append_frame appends a frame to the capture.  Capture write errors
+   are fatal, as a capture with holes in it cannot be used to reproduce
+   a replay. */
+
+static inline void
+append_frame( fd_capture_tile_ctx_t * ctx,
+              uint                    type,
+              ulong                   slot,
+              void const *            payload,
+              ulong                   sz ) {
+  int err = fd_shredcap_writer_append( ctx->writer, type, fd_log_wallclock(), slot, payload, sz );
+  if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "failed to write to capture (%i-%s)", err, fd_io_strerror( err ) ));
+}
+
+static inline void
+append_peers( fd_capture_tile_ctx_t *      ctx,
+              fd_shred_dest_wire_t const * dests,
+              ulong                        dest_cnt,
+              int                          is_turbine ) {
+  for( ulong i=0UL; i<dest_cnt; i++ ) {
+    fd_shredcap_peer_t peer = {
+      .ip4_addr   = dests[ i ].ip4_addr,
+      .udp_port   = dests[ i ].udp_port,
+      .is_turbine = (uchar)is_turbine,
+    };
+    memcpy( peer.pubkey, dests[ i ].pubkey, 32UL );
+    append_frame( ctx, FD_SHREDCAP_FRAME_TYPE_PEER, FD_SHREDCAP_SLOT_NONE, &peer, sizeof(fd_shredcap_peer_t) );
+  }
+}
+
+static inline void
+after_credit( fd_capture_tile_ctx_t * ctx,
+              fd_stem_context_t *     stem        FD_PARAM_UNUSED,
+              int *                   opt_poll_in FD_PARAM_UNUSED,
+              int *                   charge_busy ) {
+  /* Drain at most one chunk of the capture ring per loop iteration so
+     the tile keeps up with its inputs. */
+  ulong write_cnt = ctx->writer->metrics.write_cnt;
+  int err = fd_shredcap_writer_poll( ctx->writer );
+  if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "failed to write to capture (%i-%s)", err, fd_io_strerror( err ) ));
+  *charge_busy = ctx->writer->metrics.write_cnt!=write_cnt;
+}
+
+static inline void
+during_housekeeping( fd_capture_tile_ctx_t * ctx ) {
+  long now = fd_log_wallclock();
+  if( FD_UNLIKELY( now>=ctx->next_flush ) ) {
+    int err = fd_shredcap_writer_flush( ctx->writer );
+    if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "failed to flush capture (%i-%s)", err, fd_io_strerror( err ) ));
+    ctx->next_flush = now + FD_SHREDCAP_FLUSH_INTERVAL_NS;
+  }
+}
+
 static inline int
 before_frag( fd_capture_tile_ctx_t * ctx,
              ulong            in_idx,
@@ -152,16 +197,7 @@ handle_new_turbine_contact_info( fd_capture_tile_ctx_t * ctx,
 
   fd_shred_dest_wire_t const * in_dests = fd_type_pun_const( header+1UL );
 
-  for( ulong i=0UL; i<dest_cnt; i++ ) {
-    // need to bswap the port
-    //ushort port = fd_ushort_bswap( in_dests[i].udp_port );
-    char peers_buf[1024];
-    snprintf( peers_buf, sizeof(peers_buf),
-              "%u,%u,%s,%d\n",
-              in_dests[i].ip4_addr, in_dests[i].udp_port, FD_BASE58_ENC_32_ALLOCA(in_dests[i].pubkey), 1);
-    int err = fd_io_buffered_ostream_write( &ctx->peers_ostream, peers_buf, strlen(peers_buf) );
-    FD_TEST( err==0 );
-  }
+  append_peers( ctx, in_dests, dest_cnt, 1 );
 }
 
 
@@ -224,43 +260,21 @@ during_frag( fd_capture_tile_ctx_t * ctx,
   } else if( ctx->in_kind[ in_idx ] == REPAIR_SHRED_CAP ) {
 
     uchar const * dcache_entry = fd_chunk_to_laddr_const( ctx->in_links[ in_idx ].mem, chunk );
-    /* We expect to get all of the data shreds in a batch at once.  When
-       we do we will write the header, the shreds, and a trailer. */
+    /* We expect to get all of the data shreds in a batch at once, and
+       write them out as one frame, indexed by the slot of the slice. */
     ulong payload_sz = sig;
-    fd_shredcap_slice_header_msg_t header = {
-      .magic      = FD_SHREDCAP_SLICE_HEADER_MAGIC,
-      .version    = FD_SHREDCAP_SLICE_HEADER_V1,
-      .payload_sz = payload_sz,
-    };
-    int err;
-    err = fd_io_buffered_ostream_write( &ctx->slices_ostream, &header, FD_SHREDCAP_SLICE_HEADER_FOOTPRINT );
-    if( FD_UNLIKELY( err != 0 ) ) {
-      FD_LOG_CRIT(( "failed to write slice header %d", err ));
-    }
-    err = fd_io_buffered_ostream_write( &ctx->slices_ostream, dcache_entry, payload_sz );
-    if( FD_UNLIKELY( err != 0 ) ) {
-      FD_LOG_CRIT(( "failed to write slice data %d", err ));
-    }
-    fd_shredcap_slice_trailer_msg_t trailer = {
-      .magic   = FD_SHREDCAP_SLICE_TRAILER_MAGIC,
-      .version = FD_SHREDCAP_SLICE_TRAILER_V1,
-    };
-    err = fd_io_buffered_ostream_write( &ctx->slices_ostream, &trailer, FD_SHREDCAP_SLICE_TRAILER_FOOTPRINT );
-    if( FD_UNLIKELY( err != 0 ) ) {
-      FD_LOG_CRIT(( "failed to write slice trailer %d", err ));
-    }
+    ulong slot       = FD_SHREDCAP_SLOT_NONE;
+    if( FD_LIKELY( payload_sz>=FD_SHRED_DATA_HEADER_SZ ) ) slot = ((fd_shred_t const *)fd_type_pun_const( dcache_entry ))->slot;
+    append_frame( ctx, FD_SHREDCAP_FRAME_TYPE_SLICE, slot, dcache_entry, payload_sz );
 
   } else if( ctx->in_kind[ in_idx ] == REPLAY_SHRED_CAP ) {
 
    uchar const * dcache_entry = fd_chunk_to_laddr_const( ctx->in_links[ in_idx ].mem, chunk );
-   fd_shredcap_bank_hash_msg_t bank_hash_msg = {
-     .magic   = FD_SHREDCAP_BANK_HASH_MAGIC,
-     .version = FD_SHREDCAP_BANK_HASH_V1
-   };
-   fd_memcpy( &bank_hash_msg.bank_hash, dcache_entry, sizeof(fd_hash_t) );
-   fd_memcpy( &bank_hash_msg.slot, dcache_entry+sizeof(fd_hash_t), sizeof(ulong) );
+   fd_shredcap_bank_hash_t bank_hash;
+   fd_memcpy( bank_hash.bank_hash, dcache_entry, sizeof(fd_hash_t) );
+   fd_memcpy( &bank_hash.slot, dcache_entry+sizeof(fd_hash_t), sizeof(ulong) );
 
-   fd_io_buffered_ostream_write( &ctx->bank_hashes_ostream, &bank_hash_msg, FD_SHREDCAP_BANK_HASH_FOOTPRINT );
+   append_frame( ctx, FD_SHREDCAP_FRAME_TYPE_BANK_HASH, bank_hash.slot, &bank_hash, sizeof(fd_shredcap_bank_hash_t) );
 
   } else {
     // contact infos can be copied into a buffer
@@ -289,18 +303,16 @@ after_frag( fd_capture_tile_ctx_t * ctx,
        it takes to complete a fec */
 
     fd_shred_t const * shred = (fd_shred_t *)fd_type_pun( ctx->shred_buffer );
-    uint data_cnt = fd_disco_shred_repair_fec_sig_data_cnt( sig );
-    uint ref_tick = shred->data.flags & FD_SHRED_DATA_REF_TICK_MASK;
-    char fec_complete[1024];
-    snprintf( fec_complete, sizeof(fec_complete),
-             "%ld,%lu,%u,%u,%u\n",
-              fd_log_wallclock(), shred->slot, ref_tick, shred->fec_set_idx, data_cnt );
 
     // Last shred is guaranteed to be a data shred
 
-
-    int err = fd_io_buffered_ostream_write( &ctx->fecs_ostream, fec_complete, strlen(fec_complete) );
-    FD_TEST( err==0 );
+    fd_shredcap_fec_t fec = {
+      .slot        = shred->slot,
+      .ref_tick    = shred->data.flags & FD_SHRED_DATA_REF_TICK_MASK,
+      .fec_set_idx = shred->fec_set_idx,
+      .data_cnt    = fd_disco_shred_repair_fec_sig_data_cnt( sig ),
+    };
+    append_frame( ctx, FD_SHREDCAP_FRAME_TYPE_FEC, FD_SHREDCAP_SLOT_NONE, &fec, sizeof(fd_shredcap_fec_t) );
   } else if( ctx->in_kind[ in_idx ] == NET_SHRED ) {
     /* TODO: leader schedule early exits in shred tile right around
        startup, which discards some turbine shreds, but there is a
@@ -327,13 +339,18 @@ after_frag( fd_capture_tile_ctx_t * ctx,
       ref_tick = shred->data.flags & FD_SHRED_DATA_REF_TICK_MASK;
     }
 
-    char repair_data_buf[1024];
-    snprintf( repair_data_buf, sizeof(repair_data_buf),
-             "%u,%u,%ld,%lu,%u,%u,%u,%d,%d,%u\n",
-              src_ip4_addr, src_port, fd_log_wallclock(), slot, ref_tick, fec_idx, idx, is_turbine, is_data, nonce );
-
-    int err = fd_io_buffered_ostream_write( &ctx->shred_ostream, repair_data_buf, strlen(repair_data_buf) );
-    FD_TEST( err==0 );
+    fd_shredcap_shred_t rec = {
+      .src_ip4     = src_ip4_addr,
+      .src_port    = src_port,
+      .is_turbine  = (uchar)is_turbine,
+      .is_data     = (uchar)is_data,
+      .slot        = slot,
+      .idx         = idx,
+      .fec_set_idx = fec_idx,
+      .nonce       = nonce,
+      .ref_tick    = ref_tick,
+    };
+    append_frame( ctx, FD_SHREDCAP_FRAME_TYPE_SHRED, FD_SHREDCAP_SLOT_NONE, &rec, sizeof(fd_shredcap_shred_t) );
   } else if( ctx->in_kind[ in_idx ] == REPAIR_NET ) {
     /* We have a valid repair request that we can finally decode.
        Unfortunately we actually have to decode because we cant cast
@@ -374,23 +391,17 @@ after_frag( fd_capture_tile_ctx_t * ctx,
         break;
     }
 
-    char repair_data_buf[1024];
-    snprintf( repair_data_buf, sizeof(repair_data_buf),
-              "%u,%u,%ld,%u,%lu,%lu\n",
-              peer_ip4_addr, peer_port, fd_log_wallclock(), nonce, slot, shred_index );
-    int err = fd_io_buffered_ostream_write( &ctx->repair_ostream, repair_data_buf, strlen(repair_data_buf) );
-    FD_TEST( err==0 );
+    fd_shredcap_request_t rec = {
+      .dst_ip4   = peer_ip4_addr,
+      .dst_port  = peer_port,
+      .nonce     = nonce,
+      .slot      = slot,
+      .shred_idx = shred_index,
+    };
+    append_frame( ctx, FD_SHREDCAP_FRAME_TYPE_REQUEST, FD_SHREDCAP_SLOT_NONE, &rec, sizeof(fd_shredcap_request_t) );
   } else if( ctx->in_kind[ in_idx ] == GOSSIP_REPAIR ) {
     fd_shred_dest_wire_t const * in_dests = (fd_shred_dest_wire_t const *)fd_type_pun_const( ctx->contact_info_buffer );
-    ulong dest_cnt = sz;
-    for( ulong i=0UL; i<dest_cnt; i++ ) {
-      char peers_buf[1024];
-      snprintf( peers_buf, sizeof(peers_buf),
-                "%u,%u,%s,%d\n",
-                 in_dests[i].ip4_addr, in_dests[i].udp_port, FD_BASE58_ENC_32_ALLOCA(in_dests[i].pubkey), 0);
-      int err = fd_io_buffered_ostream_write( &ctx->peers_ostream, peers_buf, strlen(peers_buf) );
-      FD_TEST( err==0 );
-    }
+    append_peers( ctx, in_dests, sz, 0 );
   } else if( ctx->in_kind[ in_idx ] == GOSSIP_SHRED ) { // crds_shred contact infos
     handle_new_turbine_contact_info( ctx, ctx->contact_info_buffer );
   }
@@ -406,18 +417,10 @@ populate_allowed_fds( fd_topo_t const      * topo        FD_PARAM_UNUSED,
   out_fds[ out_cnt++ ] = 2; /* stderr */
   if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
     out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
-  if( FD_LIKELY( -1!=tile->shredcap.shreds_fd ) )
-    out_fds[ out_cnt++ ] = tile->shredcap.shreds_fd; /* shred file */
-  if( FD_LIKELY( -1!=tile->shredcap.requests_fd ) )
-    out_fds[ out_cnt++ ] = tile->shredcap.requests_fd; /* request file */
-  if( FD_LIKELY( -1!=tile->shredcap.fecs_fd ) )
-    out_fds[ out_cnt++ ] = tile->shredcap.fecs_fd; /* fec complete file */
-  if( FD_LIKELY( -1!=tile->shredcap.peers_fd ) )
-    out_fds[ out_cnt++ ] = tile->shredcap.peers_fd; /* peers file */
-  if( FD_LIKELY( -1!=tile->shredcap.slices_fd ) )
-    out_fds[ out_cnt++ ] = tile->shredcap.slices_fd; /* slices file */
-  if( FD_LIKELY( -1!=tile->shredcap.bank_hashes_fd ) )
-    out_fds[ out_cnt++ ] = tile->shredcap.bank_hashes_fd; /* bank hashes file */
+  if( FD_LIKELY( -1!=tile->shredcap.capture_fd ) )
+    out_fds[ out_cnt++ ] = tile->shredcap.capture_fd; /* capture file */
+  if( FD_LIKELY( -1!=tile->shredcap.index_fd ) )
+    out_fds[ out_cnt++ ] = tile->shredcap.index_fd; /* capture index file */
 
   return out_cnt;
 }
@@ -426,84 +429,33 @@ static void
 privileged_init( fd_topo_t *      topo FD_PARAM_UNUSED,
                  fd_topo_tile_t * tile ) {
   char file_path[PATH_MAX];
-  strcpy( file_path, tile->shredcap.folder_path );
-  strcat( file_path, "/shred_data.csv" );
-  tile->shredcap.shreds_fd = open( file_path, O_WRONLY|O_CREAT|O_APPEND /*| O_DIRECT*/, 0644 );
-  if ( FD_UNLIKELY( tile->shredcap.shreds_fd == -1 ) ) {
-    FD_LOG_ERR(( "failed to open or create shred csv dump file %s %d %s", file_path, errno, strerror(errno) ));
-  }
-
-  strcpy( file_path, tile->shredcap.folder_path );
-  strcat( file_path, "/request_data.csv" );
-  tile->shredcap.requests_fd = open( file_path, O_WRONLY|O_CREAT|O_APPEND /*| O_DIRECT*/, 0644 );
-  if ( FD_UNLIKELY( tile->shredcap.requests_fd == -1 ) ) {
-    FD_LOG_ERR(( "failed to open or create request csv dump file %s %d %s", file_path, errno, strerror(errno) ));
-  }
-
-  strcpy( file_path, tile->shredcap.folder_path );
-  strcat( file_path, "/fec_complete.csv" );
-  tile->shredcap.fecs_fd = open( file_path, O_WRONLY|O_CREAT|O_APPEND /*| O_DIRECT*/, 0644 );
-  if ( FD_UNLIKELY( tile->shredcap.fecs_fd == -1 ) ) {
-    FD_LOG_ERR(( "failed to open or create fec complete csv dump file %s %d %s", file_path, errno, strerror(errno) ));
-  }
-  FD_LOG_NOTICE(( "Opening shred csv dump file at %s", file_path ));
-
-  strcpy( file_path, tile->shredcap.folder_path );
-  strcat( file_path, "/peers.csv" );
-  tile->shredcap.peers_fd = open( file_path, O_WRONLY|O_CREAT|O_APPEND /*| O_DIRECT*/, 0644 );
-  if ( FD_UNLIKELY( tile->shredcap.peers_fd == -1 ) ) {
-    FD_LOG_ERR(( "failed to open or create peers csv dump file %s %d %s", file_path, errno, strerror(errno) ));
-  }
-
-  strcpy( file_path, tile->shredcap.folder_path );
-  strcat( file_path, "/slices.bin" );
-  tile->shredcap.slices_fd = open( file_path, O_WRONLY|O_CREAT|O_APPEND /*| O_DIRECT*/, 0644 );
-  if ( FD_UNLIKELY( tile->shredcap.slices_fd == -1 ) ) {
-    FD_LOG_ERR(( "failed to open or create slices csv dump file %s %d %s", file_path, errno, strerror(errno) ));
+  if( FD_UNLIKELY( !fd_cstr_printf_check( file_path, sizeof(file_path), NULL, "%s/capture.bin", tile->shredcap.folder_path ) ) ) {
+    FD_LOG_ERR(( "shredcap folder path too long: %s", tile->shredcap.folder_path ));
   }
-  FD_LOG_NOTICE(( "Opening val_shreds binary dump file at %s", file_path ));
-
-  strcpy( file_path, tile->shredcap.folder_path );
-  strcat( file_path, "/bank_hashes.bin" );
-  tile->shredcap.bank_hashes_fd = open( file_path, O_WRONLY|O_CREAT|O_APPEND /*| O_DIRECT*/, 0644 );
-  if ( FD_UNLIKELY( tile->shredcap.bank_hashes_fd == -1 ) ) {
-    FD_LOG_ERR(( "failed to open or create bank_hashes csv dump file %s %d %s", file_path, errno, strerror(errno) ));
-  }
-  FD_LOG_NOTICE(( "Opening bank_hashes binary dump file at %s", file_path ));
-}
 
-static void
-init_file_handlers( fd_capture_tile_ctx_t    * ctx,
-                    int                      * ctx_file,
-                    int                        tile_file,
-                    uchar                   ** ctx_buf,
-                    fd_io_buffered_ostream_t * ctx_ostream ) {
-  *ctx_file =  tile_file ;
-
-  int err = ftruncate( *ctx_file, 0UL );
-  if( FD_UNLIKELY( err ) ) {
-    FD_LOG_ERR(( "failed to truncate file (%i-%s)", errno, fd_io_strerror( errno ) ));
+  /* The capture is written with page aligned writes from a page aligned
+     buffer, so it can bypass the page cache.  Not every filesystem
+     supports O_DIRECT (tmpfs does not), in which case fall back to
+     buffered writes. */
+  tile->shredcap.capture_fd = open( file_path, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC|O_DIRECT, 0644 );
+  if( FD_UNLIKELY( tile->shredcap.capture_fd==-1 && errno==EINVAL ) ) {
+    FD_LOG_NOTICE(( "O_DIRECT not supported for %s, using buffered writes", file_path ));
+    tile->shredcap.capture_fd = open( file_path, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0644 );
   }
-  long seek = lseek( *ctx_file, 0UL, SEEK_SET );
-  if( FD_UNLIKELY( seek!=0L ) ) {
-    FD_LOG_ERR(( "failed to seek to the beginning of file" ));
+  if( FD_UNLIKELY( tile->shredcap.capture_fd==-1 ) ) {
+    FD_LOG_ERR(( "failed to open or create capture file %s %d %s", file_path, errno, strerror(errno) ));
   }
+  FD_LOG_NOTICE(( "Opening shredcap capture file at %s", file_path ));
 
-  *ctx_buf = fd_alloc_malloc( ctx->alloc, 4096, ctx->write_buf_sz );
-  if( FD_UNLIKELY( *ctx_buf == NULL ) ) {
-    FD_LOG_ERR(( "failed to allocate ostream buffer" ));
+  if( FD_UNLIKELY( !fd_cstr_printf_check( file_path, sizeof(file_path), NULL, "%s/capture.bin.idx", tile->shredcap.folder_path ) ) ) {
+    FD_LOG_ERR(( "shredcap folder path too long: %s", tile->shredcap.folder_path ));
   }
-
-  if( FD_UNLIKELY( !fd_io_buffered_ostream_init(
-    ctx_ostream,
-    *ctx_file,
-    *ctx_buf,
-    ctx->write_buf_sz ) ) ) {
-    FD_LOG_ERR(( "failed to initialize ostream" ));
+  tile->shredcap.index_fd = open( file_path, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0644 );
+  if( FD_UNLIKELY( tile->shredcap.index_fd==-1 ) ) {
+    FD_LOG_ERR(( "failed to open or create capture index file %s %d %s", file_path, errno, strerror(errno) ));
   }
 }
 
-
 static void
 unprivileged_init( fd_topo_t *      topo,
                    fd_topo_tile_t * tile ) {
@@ -545,6 +497,7 @@ unprivileged_init( fd_topo_t *      topo,
 
   ctx->repair_intake_listen_port = tile->shredcap.repair_intake_listen_port;
   ctx->write_buf_sz = tile->shredcap.write_buffer_size ? tile->shredcap.write_buffer_size : FD_SHREDCAP_DEFAULT_WRITER_BUF_SZ;
+  ctx->write_buf_sz = fd_ulong_max( fd_ulong_align_up( ctx->write_buf_sz, FD_SHREDCAP_WRITE_ALIGN ), 2UL*FD_SHREDCAP_WRITER_CHUNK_SZ );
 
   /* Allocate the write buffers */
   ctx->alloc = fd_alloc_join( fd_alloc_new( alloc_mem, FD_SHREDCAP_ALLOC_TAG ), fd_tile_idx() );
@@ -552,26 +505,20 @@ unprivileged_init( fd_topo_t *      topo,
     FD_LOG_ERR( ( "fd_alloc_join failed" ) );
   }
 
-  /* Setup the csv files to be in the expected state */
+  /* Setup the capture */
 
-  init_file_handlers( ctx, &ctx->shreds_fd,      tile->shredcap.shreds_fd,      &ctx->shreds_buf,      &ctx->shred_ostream );
-  init_file_handlers( ctx, &ctx->requests_fd,    tile->shredcap.requests_fd,    &ctx->requests_buf,    &ctx->repair_ostream );
-  init_file_handlers( ctx, &ctx->fecs_fd,        tile->shredcap.fecs_fd,        &ctx->fecs_buf,        &ctx->fecs_ostream );
-  init_file_handlers( ctx, &ctx->peers_fd,       tile->shredcap.peers_fd,       &ctx->peers_buf,       &ctx->peers_ostream );
-
-  int err = fd_io_buffered_ostream_write( &ctx->shred_ostream,  "src_ip,src_port,timestamp,slot,ref_tick,fec_set_idx,idx,is_turbine,is_data,nonce\n", 81UL );
-  err    |= fd_io_buffered_ostream_write( &ctx->repair_ostream, "dst_ip,dst_port,timestamp,nonce,slot,idx\n", 41UL );
-  err    |= fd_io_buffered_ostream_write( &ctx->fecs_ostream,   "timestamp,slot,ref_tick,fec_set_idx,data_cnt\n", 45UL );
-  err    |= fd_io_buffered_ostream_write( &ctx->peers_ostream,  "peer_ip4_addr,peer_port,pubkey,turbine\n", 48UL );
-
-  if( FD_UNLIKELY( err ) ) {
-    FD_LOG_ERR(( "failed to write header to any of the 4 csv files (%i-%s)", errno, fd_io_strerror( errno ) ));
+  void *              write_buf = fd_alloc_malloc( ctx->alloc, FD_SHREDCAP_WRITE_ALIGN, ctx->write_buf_sz );
+  fd_shredcap_idx_t * idx_buf   = fd_alloc_malloc( ctx->alloc, alignof(fd_shredcap_idx_t), FD_SHREDCAP_IDX_MAX*sizeof(fd_shredcap_idx_t) );
+  if( FD_UNLIKELY( !write_buf || !idx_buf ) ) {
+    FD_LOG_ERR(( "failed to allocate capture buffers" ));
   }
 
-  /* Setup the binary files to be in the expected state. These files are
-     not csv, so we don't need headers. */
-  init_file_handlers( ctx, &ctx->slices_fd,      tile->shredcap.slices_fd,      &ctx->slices_buf,      &ctx->slices_ostream );
-  init_file_handlers( ctx, &ctx->bank_hashes_fd, tile->shredcap.bank_hashes_fd, &ctx->bank_hashes_buf, &ctx->bank_hashes_ostream );
+  if( FD_UNLIKELY( !fd_shredcap_writer_init( ctx->writer, tile->shredcap.capture_fd, tile->shredcap.index_fd,
+                                             write_buf, ctx->write_buf_sz, FD_SHREDCAP_WRITER_CHUNK_SZ,
+                                             idx_buf, FD_SHREDCAP_IDX_MAX, fd_log_wallclock() ) ) ) {
+    FD_LOG_ERR(( "failed to initialize capture writer" ));
+  }
+  ctx->next_flush = fd_log_wallclock() + FD_SHREDCAP_FLUSH_INTERVAL_NS;
 }
 
 #define STEM_BURST (1UL)
@@ -580,9 +527,11 @@ unprivileged_init( fd_topo_t *      topo,
 #define STEM_CALLBACK_CONTEXT_TYPE  fd_capture_tile_ctx_t
 #define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_capture_tile_ctx_t)
 
-#define STEM_CALLBACK_DURING_FRAG during_frag
-#define STEM_CALLBACK_AFTER_FRAG  after_frag
-#define STEM_CALLBACK_BEFORE_FRAG before_frag
+#define STEM_CALLBACK_DURING_HOUSEKEEPING during_housekeeping
+#define STEM_CALLBACK_AFTER_CREDIT        after_credit
+#define STEM_CALLBACK_DURING_FRAG         during_frag
+#define STEM_CALLBACK_AFTER_FRAG          after_frag
+#define STEM_CALLBACK_BEFORE_FRAG         before_frag
 
 #include "../../disco/stem/fd_stem.c"
 
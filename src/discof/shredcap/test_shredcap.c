@@ -0,0 +1,182 @@
+#include "fd_shredcap.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define RING_SZ   (16UL*FD_SHREDCAP_WRITE_ALIGN)
+#define CHUNK_SZ  ( 4UL*FD_SHREDCAP_WRITE_ALIGN)
+#define IDX_MAX   (7UL)
+#define FRAME_CNT (20000UL)
+#define FILE_MAX  (64UL<<20)
+
+static uchar             ring   [ RING_SZ ] __attribute__((aligned(FD_SHREDCAP_WRITE_ALIGN)));
+static fd_shredcap_idx_t idx_buf[ IDX_MAX ];
+static uchar             payload[ 3UL*RING_SZ ];
+static uchar             file   [ FILE_MAX ];
+static fd_shredcap_idx_t idx    [ FRAME_CNT ];
+
+static int
+tmp_file( void ) {
+  char path[] = "/tmp/test_shredcap.XXXXXX";
+  int fd = mkstemp( path );
+  FD_TEST( fd>=0 );
+  FD_TEST( !unlink( path ) );
+  return fd;
+}
+
+static ulong
+read_all( int     fd,
+          void *  buf,
+          ulong   buf_sz ) {
+  long res = pread( fd, buf, buf_sz, 0L );
+  FD_TEST( res>=0L );
+  return (ulong)res;
+}
+
+/* frame_sz gives the payload size of frame i, mostly small records,
+   sometimes slices larger than the whole ring. */
+
+static ulong
+frame_sz( fd_rng_t * rng ) {
+  uint r = fd_rng_uint_roll( rng, 100U );
+  if( r<90U ) return fd_rng_ulong_roll( rng, 64UL );
+  if( r<99U ) return fd_rng_ulong_roll( rng, 8192UL );
+  return fd_rng_ulong_roll( rng, sizeof(payload) );
+}
+
+static void
+verify( int        fd,
+        int        idx_fd,
+        ulong      seed,
+        ulong      frame_cnt,
+        ulong      idx_cnt ) {
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)seed, 0UL ) );
+
+  ulong file_sz = read_all( fd, file, sizeof(file) );
+  FD_TEST( file_sz<sizeof(file) );
+  fd_shredcap_file_hdr_t const * hdr = (fd_shredcap_file_hdr_t const *)file;
+  FD_TEST( hdr->magic==FD_SHREDCAP_MAGIC );
+  FD_TEST( hdr->version==FD_SHREDCAP_VERSION );
+  FD_TEST( hdr->ts==1234L );
+
+  FD_TEST( read_all( idx_fd, idx, sizeof(idx) )==idx_cnt*sizeof(fd_shredcap_idx_t) );
+
+  ulong off = sizeof(fd_shredcap_file_hdr_t);
+  ulong j   = 0UL;
+  for( ulong i=0UL; i<frame_cnt; i++ ) {
+    uint  type = 1U + fd_rng_uint_roll( rng, FD_SHREDCAP_FRAME_TYPE_MAX-1U );
+    ulong sz   = frame_sz( rng );
+    ulong frame_off = off;
+    fd_shredcap_frame_t const * frame = fd_shredcap_frame_next( file, file_sz, &off );
+    FD_TEST( frame );
+    FD_TEST( frame->type==type );
+    FD_TEST( frame->sz==sz );
+    FD_TEST( frame->ts==(long)i );
+    uchar const * p = (uchar const *)(frame+1);
+    for( ulong b=0UL; b<sz; b++ ) FD_TEST( p[ b ]==(uchar)(i+b) );
+    for( ulong b=sz; b<fd_ulong_align_up( sz, FD_SHREDCAP_FRAME_ALIGN ); b++ ) FD_TEST( !p[ b ] );
+    if( type==FD_SHREDCAP_FRAME_TYPE_SLICE || type==FD_SHREDCAP_FRAME_TYPE_BANK_HASH ) {
+      FD_TEST( j<idx_cnt );
+      FD_TEST( idx[ j ].slot==i/4UL );
+      FD_TEST( idx[ j ].off==frame_off );
+      FD_TEST( idx[ j ].type==type );
+      FD_TEST( idx[ j ].sz==sz );
+      j++;
+    }
+  }
+  FD_TEST( j==idx_cnt );
+  FD_TEST( !fd_shredcap_frame_next( file, file_sz, &off ) ); /* zero padding or eof */
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+}
+
+static void
+test_writer( fd_rng_t * rng ) {
+  int fd     = tmp_file();
+  int idx_fd = tmp_file();
+
+  fd_shredcap_writer_t w[1];
+  FD_TEST( fd_shredcap_writer_init( w, fd, idx_fd, ring, RING_SZ, CHUNK_SZ, idx_buf, IDX_MAX, 1234L )==w );
+
+  ulong seed = fd_rng_ulong( rng );
+  fd_rng_t _wrng[1]; fd_rng_t * wrng = fd_rng_join( fd_rng_new( _wrng, (uint)seed, 0UL ) );
+
+  ulong idx_cnt = 0UL;
+  for( ulong i=0UL; i<FRAME_CNT; i++ ) {
+    uint  type = 1U + fd_rng_uint_roll( wrng, FD_SHREDCAP_FRAME_TYPE_MAX-1U );
+    ulong sz   = frame_sz( wrng );
+    for( ulong b=0UL; b<sz; b++ ) payload[ b ] = (uchar)(i+b);
+    int indexed = type==FD_SHREDCAP_FRAME_TYPE_SLICE || type==FD_SHREDCAP_FRAME_TYPE_BANK_HASH;
+    idx_cnt += (ulong)indexed;
+    FD_TEST( !fd_shredcap_writer_append( w, type, (long)i, indexed ? i/4UL : FD_SHREDCAP_SLOT_NONE, payload, sz ) );
+
+    switch( fd_rng_uint_roll( rng, 16U ) ) {
+    case 0U: FD_TEST( !fd_shredcap_writer_flush( w ) ); break;
+    case 1U: case 2U: case 3U: FD_TEST( !fd_shredcap_writer_poll( w ) ); break;
+    default: break;
+    }
+
+    /* Whatever has been flushed can be read back at any point */
+    if( FD_UNLIKELY( i==FRAME_CNT/2UL ) ) {
+      FD_TEST( !fd_shredcap_writer_flush( w ) );
+      verify( fd, idx_fd, seed, i+1UL, idx_cnt );
+    }
+  }
+  FD_TEST( w->metrics.frame_cnt==FRAME_CNT );
+  FD_TEST( w->metrics.stall_cnt );
+  FD_TEST( !fd_shredcap_writer_fini( w ) );
+
+  verify( fd, idx_fd, seed, FRAME_CNT, idx_cnt );
+
+  fd_rng_delete( fd_rng_leave( wrng ) );
+  FD_TEST( !close( fd ) );
+  FD_TEST( !close( idx_fd ) );
+}
+
+static void
+test_frame_next( void ) {
+  static uchar buf[ 256 ] __attribute__((aligned(8)));
+  memset( buf, 0, sizeof(buf) );
+  fd_shredcap_frame_t * frame = (fd_shredcap_frame_t *)buf;
+  ulong off = 0UL;
+  FD_TEST( !fd_shredcap_frame_next( buf, sizeof(buf), &off ) ); /* type none */
+  frame->type = FD_SHREDCAP_FRAME_TYPE_MAX;
+  FD_TEST( !fd_shredcap_frame_next( buf, sizeof(buf), &off ) ); /* bad type */
+  frame->type = FD_SHREDCAP_FRAME_TYPE_FEC;
+  frame->sz   = (uint)(sizeof(buf)-sizeof(fd_shredcap_frame_t)+1UL);
+  FD_TEST( !fd_shredcap_frame_next( buf, sizeof(buf), &off ) ); /* truncated */
+  frame->sz   = 3U;
+  FD_TEST( fd_shredcap_frame_next( buf, sizeof(buf), &off )==frame );
+  FD_TEST( off==sizeof(fd_shredcap_frame_t)+8UL );
+  off = sizeof(buf)-8UL;
+  FD_TEST( !fd_shredcap_frame_next( buf, sizeof(buf), &off ) ); /* header truncated */
+  off = sizeof(buf)+1UL;
+  FD_TEST( !fd_shredcap_frame_next( buf, sizeof(buf), &off ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Bad arguments */
+  fd_shredcap_writer_t w[1];
+  FD_TEST( !fd_shredcap_writer_init( NULL, 0, 0, ring,     RING_SZ,      CHUNK_SZ,   idx_buf, IDX_MAX, 0L ) );
+  FD_TEST( !fd_shredcap_writer_init( w,    0, 0, ring+1UL, RING_SZ,      CHUNK_SZ,   idx_buf, IDX_MAX, 0L ) );
+  FD_TEST( !fd_shredcap_writer_init( w,    0, 0, ring,     RING_SZ-1UL,  CHUNK_SZ,   idx_buf, IDX_MAX, 0L ) );
+  FD_TEST( !fd_shredcap_writer_init( w,    0, 0, ring,     RING_SZ,      RING_SZ,    idx_buf, IDX_MAX, 0L ) );
+  FD_TEST( !fd_shredcap_writer_init( w,    0, 0, ring,     RING_SZ,      0UL,        idx_buf, IDX_MAX, 0L ) );
+  FD_TEST( !fd_shredcap_writer_init( w,    0, 0, ring,     RING_SZ,      CHUNK_SZ,   NULL,    IDX_MAX, 0L ) );
+
+  test_frame_next();
+  test_writer( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
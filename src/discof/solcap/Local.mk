@@ -0,0 +1,3 @@
+ifdef FD_HAS_INT128
+$(call add-objs,fd_solcap_tile,fd_discof)
+endif
@@ -0,0 +1,224 @@
+#define _GNU_SOURCE  /* Enable GNU and POSIX extensions */
+#include "../../disco/topo/fd_topo.h"
+#include "../../disco/metrics/fd_metrics.h"
+#include "../../flamenco/capture/fd_solcap_ring.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "generated/fd_solcap_tile_seccomp.h"
+
+/* The solcap tile writes the runtime capture (see fd_solcap_proto.h)
+   to disk on behalf of the replay tile.
+
+   The replay tile serializes capture chunks into a shared memory ring
+   (fd_solcap_ring_t) and never blocks on capture I/O.  This tile drains
+   the ring with large sequential writes while otherwise idle, and
+   rewrites the file header whenever the replay tile posts a new one.
+   The resulting file is a regular solcap file readable with
+   fd_solcap_reader (fd_solcap_diff, fd_solcap_yaml).
+
+   If the tile falls behind, the replay tile drops whole chunks instead
+   of stalling.  Dropped accounts are left out of the slot's account
+   table.  Drops are reported in the log and in the solcap tile
+   metrics.
+
+   On a halt request (fd_solcap_ring_halt), the tile writes out the
+   rest of the ring and the latest file header immediately, such that
+   the capture is complete before the topology is torn down. */
+
+#define FD_SOLCAP_TILE_WRITE_MIN         (1UL<<20)  /* smallest write while busy */
+#define FD_SOLCAP_TILE_WRITE_MAX         (16UL<<20) /* largest single write */
+#define FD_SOLCAP_TILE_FLUSH_INTERVAL_NS (1000000000L)
+
+struct fd_solcap_tile_ctx {
+  fd_solcap_ring_t * ring;
+  int                fd;
+  ulong              file_off;
+
+  ulong fhdr_ver;
+  uchar fhdr[ FD_SOLCAP_FHDR_SZ ];
+
+  ulong drop_cnt;
+  long  next_flush;
+};
+typedef struct fd_solcap_tile_ctx fd_solcap_tile_ctx_t;
+
+FD_FN_CONST static inline ulong
+scratch_align( void ) {
+  return alignof(fd_solcap_tile_ctx_t);
+}
+
+FD_FN_PURE static inline ulong
+scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_solcap_tile_ctx_t), sizeof(fd_solcap_tile_ctx_t) );
+  return FD_LAYOUT_FINI( l, scratch_align() );
+}
+
+static ulong
+populate_allowed_seccomp( fd_topo_t const *      topo FD_PARAM_UNUSED,
+                          fd_topo_tile_t const * tile,
+                          ulong                  out_cnt,
+                          struct sock_filter *   out ) {
+  populate_sock_filter_policy_fd_solcap_tile( out_cnt,
+                                              out,
+                                              (uint)fd_log_private_logfile_fd(),
+                                              (uint)tile->solcap.fd );
+  return sock_filter_policy_fd_solcap_tile_instr_cnt;
+}
+
+static ulong
+populate_allowed_fds( fd_topo_t const      * topo        FD_PARAM_UNUSED,
+                      fd_topo_tile_t const * tile,
+                      ulong                  out_fds_cnt FD_PARAM_UNUSED,
+                      int *                  out_fds ) {
+  ulong out_cnt = 0UL;
+
+  out_fds[ out_cnt++ ] = 2; /* stderr */
+  if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
+    out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
+  if( FD_LIKELY( -1!=tile->solcap.fd ) )
+    out_fds[ out_cnt++ ] = tile->solcap.fd; /* capture file */
+
+  return out_cnt;
+}
+
+/* write_all writes sz bytes at file offset off.  Capture write errors
+   are fatal, as a capture with holes in it is useless. */
+
+static void
+write_all( fd_solcap_tile_ctx_t * ctx,
+           uchar const *          data,
+           ulong                  sz,
+           ulong                  off ) {
+  while( sz ) {
+    long n = pwrite( ctx->fd, data, sz, (long)off );
+    if( FD_UNLIKELY( n<0L ) ) {
+      if( errno==EINTR ) continue;
+      FD_LOG_ERR(( "pwrite to solcap capture failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+    }
+    data += (ulong)n;
+    sz   -= (ulong)n;
+    off  += (ulong)n;
+  }
+}
+
+/* drain writes out up to one contiguous run of ring contents.  Returns
+   the number of bytes written. */
+
+static ulong
+drain( fd_solcap_tile_ctx_t * ctx,
+       ulong                  min_sz ) {
+  uchar const * data;
+  ulong sz = fd_solcap_ring_peek( ctx->ring, &data, FD_SOLCAP_TILE_WRITE_MAX );
+  if( sz<min_sz || !sz ) return 0UL;
+  write_all( ctx, data, sz, ctx->file_off );
+  ctx->file_off += sz;
+  fd_solcap_ring_consume( ctx->ring, sz );
+  return sz;
+}
+
+/* flush writes out everything published so far (at most two runs if
+   the ring wrapped around), then the matching file header. */
+
+static void
+flush( fd_solcap_tile_ctx_t * ctx ) {
+  while( drain( ctx, 1UL ) );
+  if( fd_solcap_ring_fhdr_query( ctx->ring, &ctx->fhdr_ver, ctx->fhdr ) ) {
+    write_all( ctx, ctx->fhdr, FD_SOLCAP_FHDR_SZ, 0UL );
+  }
+
+  ulong drop_cnt = FD_VOLATILE_CONST( ctx->ring->drop_cnt );
+  if( FD_UNLIKELY( drop_cnt!=ctx->drop_cnt ) ) {
+    FD_LOG_WARNING(( "solcap capture dropped %lu chunks (%lu total, %lu bytes) due to backpressure, consider a larger [capture.solcap_ring_sz]",
+                     drop_cnt-ctx->drop_cnt, drop_cnt, FD_VOLATILE_CONST( ctx->ring->drop_sz ) ));
+    ctx->drop_cnt = drop_cnt;
+  }
+}
+
+static inline void
+after_credit( fd_solcap_tile_ctx_t * ctx,
+              fd_stem_context_t *    stem        FD_PARAM_UNUSED,
+              int *                  opt_poll_in FD_PARAM_UNUSED,
+              int *                  charge_busy ) {
+  ulong halt_req = fd_solcap_ring_halt_query( ctx->ring );
+  if( FD_UNLIKELY( halt_req ) ) {
+    flush( ctx );
+    fd_solcap_ring_halt_ack( ctx->ring, halt_req );
+    FD_LOG_NOTICE(( "solcap capture written out (%lu bytes)", ctx->file_off ));
+    *charge_busy = 1;
+    return;
+  }
+
+  *charge_busy = !!drain( ctx, FD_SOLCAP_TILE_WRITE_MIN );
+}
+
+static inline void
+during_housekeeping( fd_solcap_tile_ctx_t * ctx ) {
+  long now = fd_log_wallclock();
+  if( FD_LIKELY( now<ctx->next_flush ) ) return;
+  ctx->next_flush = now + FD_SOLCAP_TILE_FLUSH_INTERVAL_NS;
+  flush( ctx );
+}
+
+static inline void
+metrics_write( fd_solcap_tile_ctx_t * ctx ) {
+  FD_MCNT_SET( SOLCAP, BYTES_WRITTEN,  ctx->file_off );
+  FD_MCNT_SET( SOLCAP, CHUNKS_DROPPED, FD_VOLATILE_CONST( ctx->ring->drop_cnt ) );
+  FD_MCNT_SET( SOLCAP, BYTES_DROPPED,  FD_VOLATILE_CONST( ctx->ring->drop_sz  ) );
+}
+
+static void
+privileged_init( fd_topo_t *      topo FD_PARAM_UNUSED,
+                 fd_topo_tile_t * tile ) {
+  tile->solcap.fd = open( tile->solcap.path, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0644 );
+  if( FD_UNLIKELY( tile->solcap.fd==-1 ) ) {
+    FD_LOG_ERR(( "failed to open or create solcap capture %s (%i-%s)", tile->solcap.path, errno, fd_io_strerror( errno ) ));
+  }
+  FD_LOG_NOTICE(( "Writing solcap capture to %s", tile->solcap.path ));
+}
+
+static void
+unprivileged_init( fd_topo_t *      topo,
+                   fd_topo_tile_t * tile ) {
+  void * scratch = fd_topo_obj_laddr( topo, tile->tile_obj_id );
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_solcap_tile_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_solcap_tile_ctx_t), sizeof(fd_solcap_tile_ctx_t) );
+  FD_SCRATCH_ALLOC_FINI( l, scratch_align() );
+  memset( ctx, 0, sizeof(fd_solcap_tile_ctx_t) );
+
+  ctx->ring = fd_solcap_ring_join( fd_topo_obj_laddr( topo, tile->solcap.ring_obj_id ) );
+  if( FD_UNLIKELY( !ctx->ring ) ) FD_LOG_ERR(( "failed to join solcap ring" ));
+  ctx->fd = tile->solcap.fd;
+
+  /* Reserve space for the file header, the stream follows it */
+
+  write_all( ctx, ctx->fhdr, FD_SOLCAP_FHDR_SZ, 0UL );
+  ctx->file_off   = FD_SOLCAP_FHDR_SZ;
+  ctx->next_flush = fd_log_wallclock() + FD_SOLCAP_TILE_FLUSH_INTERVAL_NS;
+}
+
+#define STEM_BURST (1UL)
+#define STEM_LAZY  (50UL)
+
+#define STEM_CALLBACK_CONTEXT_TYPE  fd_solcap_tile_ctx_t
+#define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_solcap_tile_ctx_t)
+
+#define STEM_CALLBACK_DURING_HOUSEKEEPING during_housekeeping
+#define STEM_CALLBACK_METRICS_WRITE       metrics_write
+#define STEM_CALLBACK_AFTER_CREDIT        after_credit
+
+#include "../../disco/stem/fd_stem.c"
+
+fd_topo_run_tile_t fd_tile_solcap = {
+  .name                     = "solcap",
+  .populate_allowed_seccomp = populate_allowed_seccomp,
+  .populate_allowed_fds     = populate_allowed_fds,
+  .scratch_align            = scratch_align,
+  .scratch_footprint        = scratch_footprint,
+  .privileged_init          = privileged_init,
+  .unprivileged_init        = unprivileged_init,
+  .run                      = stem_run,
+};
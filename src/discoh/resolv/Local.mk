@@ -1,3 +1,7 @@
+$(call add-hdrs,fd_resolv_cache.h)
+$(call add-objs,fd_resolv_cache,fd_discoh)
+$(call make-unit-test,test_resolv_cache,test_resolv_cache,fd_discoh fd_util)
+$(call run-unit-test,test_resolv_cache)
 ifdef FD_HAS_ALLOCA
 $(call add-objs,fd_resolv_tile,fd_discoh)
 endif
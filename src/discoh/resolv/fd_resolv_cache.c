@@ -0,0 +1,433 @@
+#include "fd_resolv_cache.h"
+
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+
+#define FD_BLOCKHASH_CACHE_MAGIC (0xf17eda2ce5b1c4c0UL) /* firedancer bhcache version 0 */
+#define FD_NONCE_CACHE_MAGIC     (0xf17eda2ce50ce0c0UL) /* firedancer ncache version 0 */
+
+/* Tags are the first 8 bytes of a hash, which are uniformly random for
+   real blockhashes and nonce values.  The low bit is forced so 0 can
+   be used as the null tag. */
+
+FD_FN_PURE static inline ulong
+tag( uchar const * hash ) {
+  return fd_ulong_load_8( hash ) | 1UL;
+}
+
+struct blockhash {
+  uchar b[ 32 ];
+};
+
+typedef struct blockhash blockhash_t;
+
+static const blockhash_t null_blockhash = { 0 };
+
+FD_FN_PURE static inline int
+blockhash_eq( uchar const * a,
+              uchar const * b ) {
+  return !( (fd_ulong_load_8( a     )^fd_ulong_load_8( b     )) | (fd_ulong_load_8( a+ 8UL )^fd_ulong_load_8( b+ 8UL )) |
+            (fd_ulong_load_8( a+16UL)^fd_ulong_load_8( b+16UL)) | (fd_ulong_load_8( a+24UL )^fd_ulong_load_8( b+24UL )) );
+}
+
+struct recent_map {
+  blockhash_t key;
+  ulong       slot;
+};
+
+typedef struct recent_map recent_map_t;
+
+#define RECENT_LG_SLOT_CNT (10)
+FD_STATIC_ASSERT( (1UL<<RECENT_LG_SLOT_CNT)==2UL*FD_BLOCKHASH_CACHE_RECENT_CNT, recent_map );
+
+#define MAP_NAME              recent_map
+#define MAP_T                 recent_map_t
+#define MAP_KEY_T             blockhash_t
+#define MAP_LG_SLOT_CNT       RECENT_LG_SLOT_CNT
+#define MAP_KEY_NULL          null_blockhash
+#if FD_HAS_AVX
+# define MAP_KEY_INVAL(k)     _mm256_testz_si256( wb_ldu( (k).b ), wb_ldu( (k).b ) )
+#else
+# define MAP_KEY_INVAL(k)     MAP_KEY_EQUAL(k, null_blockhash)
+#endif
+#define MAP_KEY_EQUAL(k0,k1)  blockhash_eq( (k0).b, (k1).b )
+#define MAP_MEMOIZE           0
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_KEY_HASH(key)     fd_uint_load_4( (key).b )
+#define MAP_QUERY_OPT         1
+
+#include "../../util/tmpl/fd_map.c"
+
+struct history_map {
+  ulong tag;
+  ulong slot;
+};
+
+typedef struct history_map history_map_t;
+
+#define MAP_NAME              history_map
+#define MAP_T                 history_map_t
+#define MAP_KEY               tag
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)((key)>>32))
+#define MAP_QUERY_OPT         1
+
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+struct __attribute__((aligned(FD_BLOCKHASH_CACHE_ALIGN))) fd_blockhash_cache_private {
+  ulong magic;
+  ulong lg_history_cnt;
+  ulong recent_cnt;       /* Number of blockhashes ever inserted in the recent index */
+  ulong history_cnt;      /* Number of tags ever inserted in the history */
+  ulong history_ring_off; /* Offset of the history ring, indexed [0,2^lg_history_cnt) */
+  ulong history_map_off;  /* Offset of the history map join */
+
+  blockhash_t  recent_ring[ FD_BLOCKHASH_CACHE_RECENT_CNT ] __attribute__((aligned(FD_BLOCKHASH_CACHE_ALIGN)));
+  recent_map_t recent_map [ 1UL<<RECENT_LG_SLOT_CNT       ] __attribute__((aligned(FD_BLOCKHASH_CACHE_ALIGN)));
+};
+
+FD_FN_CONST ulong
+fd_blockhash_cache_align( void ) {
+  return FD_BLOCKHASH_CACHE_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_blockhash_cache_footprint( ulong lg_history_cnt ) {
+  if( FD_UNLIKELY( (lg_history_cnt<1UL) | (lg_history_cnt>30UL) ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_BLOCKHASH_CACHE_ALIGN, sizeof(fd_blockhash_cache_t)                );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),           sizeof(ulong)<<lg_history_cnt                );
+  l = FD_LAYOUT_APPEND( l, history_map_align(),      history_map_footprint( (int)lg_history_cnt+1 ) );
+  return FD_LAYOUT_FINI( l, FD_BLOCKHASH_CACHE_ALIGN );
+}
+
+void *
+fd_blockhash_cache_new( void * shmem,
+                        ulong  lg_history_cnt ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_blockhash_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_blockhash_cache_footprint( lg_history_cnt ) ) ) {
+    FD_LOG_WARNING(( "bad lg_history_cnt" ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_blockhash_cache_t * cache = FD_SCRATCH_ALLOC_APPEND( l, FD_BLOCKHASH_CACHE_ALIGN, sizeof(fd_blockhash_cache_t)                );
+  ulong *                ring  = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),           sizeof(ulong)<<lg_history_cnt                );
+  void *                 map   = FD_SCRATCH_ALLOC_APPEND( l, history_map_align(),      history_map_footprint( (int)lg_history_cnt+1 ) );
+
+  memset( cache->recent_ring, 0, sizeof(cache->recent_ring) );
+  FD_TEST( recent_map_new( cache->recent_map )==cache->recent_map );
+  memset( ring, 0, sizeof(ulong)<<lg_history_cnt );
+  history_map_t * history = history_map_join( history_map_new( map, (int)lg_history_cnt+1 ) );
+  FD_TEST( history );
+
+  cache->lg_history_cnt   = lg_history_cnt;
+  cache->recent_cnt       = 0UL;
+  cache->history_cnt      = 0UL;
+  cache->history_ring_off = (ulong)ring    - (ulong)cache;
+  cache->history_map_off  = (ulong)history - (ulong)cache;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_BLOCKHASH_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_blockhash_cache_t *
+fd_blockhash_cache_join( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  fd_blockhash_cache_t * cache = (fd_blockhash_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_BLOCKHASH_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_blockhash_cache_leave( fd_blockhash_cache_t * cache ) {
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+  return (void *)cache;
+}
+
+void *
+fd_blockhash_cache_delete( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  fd_blockhash_cache_t * cache = (fd_blockhash_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_BLOCKHASH_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
+
+static inline ulong *
+history_ring( fd_blockhash_cache_t const * cache ) {
+  return (ulong *)((ulong)cache + cache->history_ring_off);
+}
+
+static inline history_map_t *
+history_map( fd_blockhash_cache_t const * cache ) {
+  return (history_map_t *)((ulong)cache + cache->history_map_off);
+}
+
+static void
+history_insert( fd_blockhash_cache_t * cache,
+                uchar const *          hash,
+                ulong                  slot ) {
+  ulong *         ring = history_ring( cache );
+  history_map_t * map  = history_map ( cache );
+  ulong           mask = (1UL<<cache->lg_history_cnt)-1UL;
+
+  /* Tags that are already in the history (a 64-bit collision or the
+     same blockhash completing on two forks) are not inserted again, so
+     every ring entry owns exactly one map entry. */
+
+  ulong t = tag( hash );
+  if( FD_UNLIKELY( history_map_query( map, t, NULL ) ) ) return;
+
+  ulong * evict = ring + (cache->history_cnt & mask);
+  if( FD_LIKELY( *evict ) ) history_map_remove( map, history_map_query( map, *evict, NULL ) );
+
+  history_map_insert( map, t )->slot = slot;
+  *evict = t;
+  cache->history_cnt++;
+}
+
+void
+fd_blockhash_cache_insert( fd_blockhash_cache_t * cache,
+                           uchar const *          hash,
+                           ulong                  slot ) {
+  blockhash_t const * key = (blockhash_t const *)hash;
+  if( FD_UNLIKELY( recent_map_key_inval( *key ) ) ) return;
+  if( FD_UNLIKELY( recent_map_query( cache->recent_map, *key, NULL ) ) ) return;
+
+  blockhash_t * evict = cache->recent_ring + (cache->recent_cnt & (FD_BLOCKHASH_CACHE_RECENT_CNT-1UL));
+  if( FD_LIKELY( cache->recent_cnt>=FD_BLOCKHASH_CACHE_RECENT_CNT ) ) {
+    recent_map_t * entry = recent_map_query( cache->recent_map, *evict, NULL );
+    history_insert( cache, evict->b, entry->slot );
+    recent_map_remove( cache->recent_map, entry );
+  }
+
+  *evict = *key;
+  recent_map_insert( cache->recent_map, *key )->slot = slot;
+  cache->recent_cnt++;
+}
+
+FD_FN_PURE ulong
+fd_blockhash_cache_query_recent( fd_blockhash_cache_t const * cache,
+                                 uchar const *                hash ) {
+  blockhash_t const * key = (blockhash_t const *)hash;
+  if( FD_UNLIKELY( recent_map_key_inval( *key ) ) ) return FD_BLOCKHASH_CACHE_SLOT_NONE;
+  recent_map_t const * entry = recent_map_query_const( cache->recent_map, *key, NULL );
+  return entry ? entry->slot : FD_BLOCKHASH_CACHE_SLOT_NONE;
+}
+
+FD_FN_PURE ulong
+fd_blockhash_cache_query_history( fd_blockhash_cache_t const * cache,
+                                  uchar const *                hash ) {
+  history_map_t const * entry = history_map_query( history_map( cache ), tag( hash ), NULL );
+  return entry ? entry->slot : FD_BLOCKHASH_CACHE_SLOT_NONE;
+}
+
+/* NONCE_TAG_INVALID is the nonce_tag of accounts that did not hold an
+   initialized durable nonce as of slot.  Real tags are odd, so it never
+   matches the tag of a nonce value. */
+
+#define NONCE_TAG_INVALID (2UL)
+
+struct __attribute__((aligned(64UL))) nonce_ent {
+  uchar acct[ 32 ];
+  ulong nonce_tag; /* Tag of the nonce value as of slot, NONCE_TAG_INVALID if none, 0 if the entry is empty */
+  ulong prev_tag;  /* Tag of the last nonce value it replaced, 0 if unknown */
+  ulong slot;
+};
+
+typedef struct nonce_ent nonce_ent_t;
+
+struct __attribute__((aligned(FD_NONCE_CACHE_ALIGN))) fd_nonce_cache_private {
+  ulong magic;
+  ulong lg_ent_cnt;
+  nonce_ent_t ent[] __attribute__((aligned(FD_NONCE_CACHE_ALIGN)));
+};
+
+FD_FN_CONST ulong
+fd_nonce_cache_align( void ) {
+  return FD_NONCE_CACHE_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_nonce_cache_footprint( ulong lg_ent_cnt ) {
+  if( FD_UNLIKELY( lg_ent_cnt>24UL ) ) return 0UL;
+  return fd_ulong_align_up( sizeof(fd_nonce_cache_t) + (sizeof(nonce_ent_t)<<lg_ent_cnt), FD_NONCE_CACHE_ALIGN );
+}
+
+void *
+fd_nonce_cache_new( void * shmem,
+                    ulong  lg_ent_cnt ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_nonce_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_nonce_cache_footprint( lg_ent_cnt ) ) ) {
+    FD_LOG_WARNING(( "bad lg_ent_cnt" ));
+    return NULL;
+  }
+
+  fd_nonce_cache_t * cache = (fd_nonce_cache_t *)shmem;
+  cache->lg_ent_cnt = lg_ent_cnt;
+  memset( cache->ent, 0, sizeof(nonce_ent_t)<<lg_ent_cnt );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_NONCE_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_nonce_cache_t *
+fd_nonce_cache_join( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  fd_nonce_cache_t * cache = (fd_nonce_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_NONCE_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_nonce_cache_leave( fd_nonce_cache_t * cache ) {
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+  return (void *)cache;
+}
+
+void *
+fd_nonce_cache_delete( void * shcache ) {
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  fd_nonce_cache_t * cache = (fd_nonce_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_NONCE_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
+
+static inline nonce_ent_t *
+nonce_ent( fd_nonce_cache_t const * cache,
+           uchar const *            acct ) {
+  ulong idx = fd_ulong_hash( fd_ulong_load_8( acct ) ) & ((1UL<<cache->lg_ent_cnt)-1UL);
+  return (nonce_ent_t *)(cache->ent + idx);
+}
+
+static void
+nonce_ent_update( fd_nonce_cache_t * cache,
+                  uchar const *      acct,
+                  ulong              t,
+                  ulong              slot ) {
+  nonce_ent_t * ent = nonce_ent( cache, acct );
+
+  if( FD_LIKELY( ent->nonce_tag && !memcmp( ent->acct, acct, 32UL ) ) ) {
+    if( FD_UNLIKELY( slot<ent->slot ) ) return;
+    if( FD_LIKELY( t!=ent->nonce_tag ) ) {
+      /* Keep the last real nonce value across invalid periods, it can
+         still never be used again */
+      if( FD_LIKELY( ent->nonce_tag!=NONCE_TAG_INVALID ) ) ent->prev_tag = ent->nonce_tag;
+      ent->nonce_tag = t;
+    }
+    ent->slot = slot;
+    return;
+  }
+
+  memcpy( ent->acct, acct, 32UL );
+  ent->nonce_tag = t;
+  ent->prev_tag  = 0UL;
+  ent->slot      = slot;
+}
+
+void
+fd_nonce_cache_update( fd_nonce_cache_t * cache,
+                       uchar const *      acct,
+                       uchar const *      nonce,
+                       ulong              slot ) {
+  nonce_ent_update( cache, acct, tag( nonce ), slot );
+}
+
+void
+fd_nonce_cache_update_invalid( fd_nonce_cache_t * cache,
+                               uchar const *      acct,
+                               ulong              slot ) {
+  nonce_ent_update( cache, acct, NONCE_TAG_INVALID, slot );
+}
+
+FD_FN_PURE int
+fd_nonce_cache_query( fd_nonce_cache_t const * cache,
+                      uchar const *            acct,
+                      uchar const *            nonce ) {
+  nonce_ent_t const * ent = nonce_ent( cache, acct );
+  if( FD_UNLIKELY( !ent->nonce_tag || memcmp( ent->acct, acct, 32UL ) ) ) return FD_NONCE_CACHE_UNKNOWN;
+
+  ulong t = tag( nonce );
+  if( FD_LIKELY  ( t==ent->nonce_tag ) ) return FD_NONCE_CACHE_CURRENT;
+  if( FD_UNLIKELY( t==ent->prev_tag  ) ) return FD_NONCE_CACHE_STALE;
+  return FD_NONCE_CACHE_UNKNOWN;
+}
+
+FD_FN_PURE ulong
+fd_nonce_cache_slot( fd_nonce_cache_t const * cache,
+                     uchar const *            acct ) {
+  nonce_ent_t const * ent = nonce_ent( cache, acct );
+  if( FD_UNLIKELY( !ent->nonce_tag || memcmp( ent->acct, acct, 32UL ) ) ) return FD_NONCE_CACHE_SLOT_NONE;
+  return ent->slot;
+}
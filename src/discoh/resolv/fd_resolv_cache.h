@@ -0,0 +1,180 @@
+#ifndef HEADER_fd_src_discoh_resolv_fd_resolv_cache_h
+#define HEADER_fd_src_discoh_resolv_fd_resolv_cache_h
+
+/* The resolv tile keeps two caches to decide, before a transaction
+   reaches pack, whether it could still execute.
+
+   fd_blockhash_cache_t maps blockhashes of completed banks to their
+   slot.  The blockhashes of the most recent FD_BLOCKHASH_CACHE_RECENT_CNT
+   banks, which covers the 150 slot validity window with plenty of room
+   for forks, are kept in a small index (about 56 KiB) that stays in
+   cache, and this is where every transaction that can still execute is
+   resolved.  Blockhashes that age out of the recent index move to a
+   large history keyed by a 64-bit tag of the hash, which is only
+   consulted for transactions that are expired (or bogus), so they can
+   be dropped at resolv rather than stashed as unknown.  Poorly written
+   senders reference blockhashes from millions of slots ago, so the
+   history is sized to days of slots.
+
+   fd_nonce_cache_t remembers, for durable nonce accounts used by
+   recent transactions, the nonce value stored in the account as of the
+   root and the value it replaced.  The resolv tile fills it by loading
+   the account from the rooted bank.  Accounts that are not usable
+   nonce accounts are cached too, so they are loaded at most once per
+   root.  Durable nonce values are derived from
+   blockhashes and never repeat, so once the root has replaced a value,
+   a transaction using it can never execute again.  The cache is direct
+   mapped, a conflict just forgets the replaced account.
+
+   Both are local objects owned by a single thread. */
+
+#include "../../util/fd_util.h"
+
+/* FD_BLOCKHASH_CACHE_RECENT_CNT is the number of most recently inserted
+   blockhashes kept in the recent index.  Power of two. */
+
+#define FD_BLOCKHASH_CACHE_RECENT_CNT (512UL)
+
+#define FD_BLOCKHASH_CACHE_ALIGN (128UL)
+
+/* FD_BLOCKHASH_CACHE_SLOT_NONE is returned by queries for blockhashes
+   that are not in the cache. */
+
+#define FD_BLOCKHASH_CACHE_SLOT_NONE (ULONG_MAX)
+
+#define FD_NONCE_CACHE_ALIGN (128UL)
+
+/* FD_NONCE_CACHE_SLOT_NONE is returned by fd_nonce_cache_slot for
+   accounts that are not in the cache. */
+
+#define FD_NONCE_CACHE_SLOT_NONE (ULONG_MAX)
+
+/* Results of fd_nonce_cache_query */
+
+#define FD_NONCE_CACHE_UNKNOWN (0) /* Account not in the cache, or nonce value never seen */
+#define FD_NONCE_CACHE_CURRENT (1) /* Nonce value is the one stored in the account as of the last update */
+#define FD_NONCE_CACHE_STALE   (2) /* Nonce value was replaced, the transaction can never execute */
+
+struct fd_blockhash_cache_private;
+typedef struct fd_blockhash_cache_private fd_blockhash_cache_t;
+
+struct fd_nonce_cache_private;
+typedef struct fd_nonce_cache_private fd_nonce_cache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_blockhash_cache_{align,footprint,new,join,leave,delete} are the
+   usual object lifecycle functions.  The history holds up to
+   2^lg_history_cnt blockhashes, lg_history_cnt in [1,30]. */
+
+FD_FN_CONST ulong
+fd_blockhash_cache_align( void );
+
+FD_FN_CONST ulong
+fd_blockhash_cache_footprint( ulong lg_history_cnt );
+
+void *
+fd_blockhash_cache_new( void * shmem,
+                        ulong  lg_history_cnt );
+
+fd_blockhash_cache_t *
+fd_blockhash_cache_join( void * shcache );
+
+void *
+fd_blockhash_cache_leave( fd_blockhash_cache_t * cache );
+
+void *
+fd_blockhash_cache_delete( void * shcache );
+
+/* fd_blockhash_cache_insert records that the bank for slot completed
+   with the given 32 byte blockhash.  If the recent index is full, the
+   oldest blockhash moves to the history (evicting the oldest history
+   entry if needed).  Inserting a blockhash that is already in the
+   recent index is a no-op. */
+
+void
+fd_blockhash_cache_insert( fd_blockhash_cache_t * cache,
+                           uchar const *          hash,
+                           ulong                  slot );
+
+/* fd_blockhash_cache_query_recent returns the slot of the blockhash if
+   it is in the recent index and FD_BLOCKHASH_CACHE_SLOT_NONE otherwise.
+   fd_blockhash_cache_query_history is the same for the history, which
+   matches on a 64-bit tag of the hash, so may (rarely) return a slot
+   for a bogus hash.  Callers should query the recent index first. */
+
+FD_FN_PURE ulong
+fd_blockhash_cache_query_recent( fd_blockhash_cache_t const * cache,
+                                 uchar const *                hash );
+
+FD_FN_PURE ulong
+fd_blockhash_cache_query_history( fd_blockhash_cache_t const * cache,
+                                  uchar const *                hash );
+
+/* fd_nonce_cache_{align,footprint,new,join,leave,delete} are the usual
+   object lifecycle functions.  The cache has 2^lg_ent_cnt entries,
+   lg_ent_cnt in [0,24]. */
+
+FD_FN_CONST ulong
+fd_nonce_cache_align( void );
+
+FD_FN_CONST ulong
+fd_nonce_cache_footprint( ulong lg_ent_cnt );
+
+void *
+fd_nonce_cache_new( void * shmem,
+                    ulong  lg_ent_cnt );
+
+fd_nonce_cache_t *
+fd_nonce_cache_join( void * shcache );
+
+void *
+fd_nonce_cache_leave( fd_nonce_cache_t * cache );
+
+void *
+fd_nonce_cache_delete( void * shcache );
+
+/* fd_nonce_cache_update records that, as of the rooted bank for slot,
+   the 32 byte durable nonce account acct stores the 32 byte durable
+   nonce value nonce.  Updates must be for non-decreasing slots per
+   account, older updates are ignored. */
+
+void
+fd_nonce_cache_update( fd_nonce_cache_t * cache,
+                       uchar const *      acct,
+                       uchar const *      nonce,
+                       ulong              slot );
+
+/* fd_nonce_cache_update_invalid records that, as of the rooted bank
+   for slot, acct does not exist or does not hold an initialized durable
+   nonce.  Queries for the account return FD_NONCE_CACHE_UNKNOWN (or
+   FD_NONCE_CACHE_STALE for a nonce value it held before), but its slot
+   is remembered so callers don't load it again until the root moves.
+   Same ordering rules as fd_nonce_cache_update. */
+
+void
+fd_nonce_cache_update_invalid( fd_nonce_cache_t * cache,
+                               uchar const *      acct,
+                               ulong              slot );
+
+/* fd_nonce_cache_query returns one of FD_NONCE_CACHE_{UNKNOWN,CURRENT,
+   STALE} for a transaction advancing durable nonce account acct with
+   the 32 byte nonce value nonce (the transaction's recent blockhash). */
+
+FD_FN_PURE int
+fd_nonce_cache_query( fd_nonce_cache_t const * cache,
+                      uchar const *            acct,
+                      uchar const *            nonce );
+
+/* fd_nonce_cache_slot returns the slot of the last update of durable
+   nonce account acct, or FD_NONCE_CACHE_SLOT_NONE if the account is not
+   in the cache.  Callers use this to refresh an account at most once
+   per rooted bank. */
+
+FD_FN_PURE ulong
+fd_nonce_cache_slot( fd_nonce_cache_t const * cache,
+                     uchar const *            acct );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discoh_resolv_fd_resolv_cache_h */
@@ -1,13 +1,11 @@
+#include "fd_resolv_cache.h"
 #include "../bank/fd_bank_abi.h"
 
 #include "../../disco/tiles.h"
 #include "../../disco/metrics/fd_metrics.h"
 #include "../../flamenco/runtime/fd_system_ids.h"
 #include "../../flamenco/runtime/fd_system_ids_pp.h"
-
-#if FD_HAS_AVX
-#include "../../util/simd/fd_avx.h"
-#endif
+#include "../../flamenco/types/fd_types.h"
 
 #define FD_RESOLV_IN_KIND_FRAGMENT (0)
 #define FD_RESOLV_IN_KIND_BANK     (1)
@@ -18,47 +16,26 @@ struct blockhash {
 
 typedef struct blockhash blockhash_t;
 
-struct blockhash_map {
-  blockhash_t key;
-  ulong       slot;
-};
+/* Completed blockhashes are kept in a blockhash cache (see
+   fd_resolv_cache.h), so we can identify when a transaction arrives,
+   what slot it will expire (and can no longer be packed) in.  This is
+   useful so we don't send transactions to pack that are no longer
+   packable.
 
-typedef struct blockhash_map blockhash_map_t;
+   Unfortunately, poorly written transaction senders frequently send
+   transactions from millions of slots ago, so the history of the cache
+   needs to be large to be able to determine and evict these.  The
+   highest practically useful value here is around 22, which works out
+   to 19 days of blockhash history.  Beyond this, the validator is
+   likely to be restarted, and lose the history anyway. */
 
-static const blockhash_t null_blockhash = { 0 };
+#define BLOCKHASH_LG_HISTORY_CNT 22UL
 
-/* The blockhash ring holds recent blockhashes, so we can identify when
-   a transaction arrives, what slot it will expire (and can no longer be
-   packed) in.  This is useful so we don't send transactions to pack
-   that are no longer packable.
+/* The stored nonce values of durable nonce accounts used by incoming
+   transactions are loaded from the rooted bank into a nonce cache of
+   2^NONCE_LG_CACHE_CNT entries, at most once per account per root. */
 
-   Unfortunately, poorly written transaction senders frequently send
-   transactions from millions of slots ago, so we need a large ring to
-   be able to determine and evict these.  The highest practically useful
-   value here is around 22, which works out to 19 days of blockhash
-   history.  Beyond this, the validator is likely to be restarted, and
-   lose the history anyway. */
-
-#define BLOCKHASH_LG_RING_CNT 22UL
-#define BLOCKHASH_RING_LEN   (1UL<<BLOCKHASH_LG_RING_CNT)
-
-#define MAP_NAME              map
-#define MAP_T                 blockhash_map_t
-#define MAP_KEY_T             blockhash_t
-#define MAP_LG_SLOT_CNT       (BLOCKHASH_LG_RING_CNT+1UL)
-#define MAP_KEY_NULL          null_blockhash
-#if FD_HAS_AVX
-# define MAP_KEY_INVAL(k)     _mm256_testz_si256( wb_ldu( (k).b ), wb_ldu( (k).b ) )
-#else
-# define MAP_KEY_INVAL(k)     MAP_KEY_EQUAL(k, null_blockhash)
-#endif
-#define MAP_KEY_EQUAL(k0,k1)  (!memcmp((k0).b,(k1).b, 32UL))
-#define MAP_MEMOIZE           0
-#define MAP_KEY_EQUAL_IS_SLOW 1
-#define MAP_KEY_HASH(key)     fd_uint_load_4( (key).b )
-#define MAP_QUERY_OPT         1
-
-#include "../../util/tmpl/fd_map.c"
+#define NONCE_LG_CACHE_CNT 13UL
 
 typedef struct {
   union {
@@ -122,7 +99,8 @@ typedef struct {
   void * root_bank;
   ulong  root_slot;
 
-  blockhash_map_t * blockhash_map;
+  fd_blockhash_cache_t * blockhash_cache;
+  fd_nonce_cache_t *     nonce_cache;
 
   ulong flushing_slot;
   ulong flush_pool_idx;
@@ -132,15 +110,17 @@ typedef struct {
   lru_list_t           lru_list[1];
 
   ulong completed_slot;
-  ulong blockhash_ring_idx;
-  blockhash_t blockhash_ring[ BLOCKHASH_RING_LEN ];
 
-  uchar _bank_msg[ sizeof(fd_completed_bank_t) ];
+  union {
+    fd_rooted_bank_t    rooted_bank;
+    fd_completed_bank_t completed_bank;
+  } _bank_msg;
 
   struct {
     ulong lut[ FD_METRICS_COUNTER_RESOLV_LUT_RESOLVED_CNT ];
     ulong blockhash_expired;
-    ulong blockhash_unknown;
+    ulong blockhash_lookup[ FD_METRICS_COUNTER_RESOLV_BLOCKHASH_LOOKUP_CNT ];
+    ulong nonce_lookup[ FD_METRICS_COUNTER_RESOLV_NONCE_LOOKUP_CNT ];
     ulong bundle_peer_failure_cnt;
     ulong stash[ FD_METRICS_COUNTER_RESOLV_STASH_OPERATION_CNT ];
   } metrics;
@@ -162,15 +142,24 @@ FD_FN_PURE static inline ulong
 scratch_footprint( fd_topo_tile_t const * tile ) {
   (void)tile;
   ulong l = FD_LAYOUT_INIT;
-  l = FD_LAYOUT_APPEND( l, alignof( fd_resolv_ctx_t ), sizeof( fd_resolv_ctx_t )        );
-  l = FD_LAYOUT_APPEND( l, pool_align(),               pool_footprint     ( 1UL<<16UL ) );
-  l = FD_LAYOUT_APPEND( l, map_chain_align(),          map_chain_footprint( 8192UL    ) );
-  l = FD_LAYOUT_APPEND( l, map_align(),                map_footprint()                  );
+  l = FD_LAYOUT_APPEND( l, alignof( fd_resolv_ctx_t ),  sizeof( fd_resolv_ctx_t )                                 );
+  l = FD_LAYOUT_APPEND( l, pool_align(),                pool_footprint     ( 1UL<<16UL )                          );
+  l = FD_LAYOUT_APPEND( l, map_chain_align(),           map_chain_footprint( 8192UL    )                          );
+  l = FD_LAYOUT_APPEND( l, fd_blockhash_cache_align(),  fd_blockhash_cache_footprint( BLOCKHASH_LG_HISTORY_CNT )  );
+  l = FD_LAYOUT_APPEND( l, fd_nonce_cache_align(),      fd_nonce_cache_footprint    ( NONCE_LG_CACHE_CNT       )  );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
 extern void fd_ext_bank_release( void const * bank );
 
+extern int
+fd_ext_bank_load_account( void const *  bank,
+                          int           fixed_root,
+                          uchar const * addr,
+                          uchar *       owner,
+                          uchar *       data,
+                          ulong *       data_sz );
+
 static ulong _fd_ext_resolv_tile_cnt;
 
 ulong
@@ -182,6 +171,8 @@ fd_ext_resolv_tile_cnt( void ) {
 static inline void
 metrics_write( fd_resolv_ctx_t * ctx ) {
   FD_MCNT_SET( RESOLV, BLOCKHASH_EXPIRED, ctx->metrics.blockhash_expired );
+  FD_MCNT_ENUM_COPY( RESOLV, BLOCKHASH_LOOKUP, ctx->metrics.blockhash_lookup );
+  FD_MCNT_ENUM_COPY( RESOLV, NONCE_LOOKUP, ctx->metrics.nonce_lookup );
   FD_MCNT_ENUM_COPY( RESOLV, LUT_RESOLVED, ctx->metrics.lut );
   FD_MCNT_ENUM_COPY( RESOLV, STASH_OPERATION, ctx->metrics.stash );
   FD_MCNT_SET( RESOLV, TRANSACTION_BUNDLE_PEER_FAILURE, ctx->metrics.bundle_peer_failure_cnt );
@@ -213,7 +204,7 @@ during_frag( fd_resolv_ctx_t * ctx,
 
   switch( ctx->in[in_idx].kind ) {
     case FD_RESOLV_IN_KIND_BANK:
-      fd_memcpy( ctx->_bank_msg, fd_chunk_to_laddr_const( ctx->in[in_idx].mem, chunk ), sz );
+      fd_memcpy( &ctx->_bank_msg, fd_chunk_to_laddr_const( ctx->in[in_idx].mem, chunk ), sz );
       break;
     case FD_RESOLV_IN_KIND_FRAGMENT: {
       uchar * src = (uchar *)fd_chunk_to_laddr( ctx->in[in_idx].mem, chunk );
@@ -301,6 +292,52 @@ fd_resolv_is_durable_nonce( fd_txn_t const * txn,
   return fd_uint_load_4( payload + ix0->data_off )==4U;
 }
 
+/* Returns the address of the nonce account advanced by a (possible)
+   durable nonce transaction, or NULL if the nonce account is loaded
+   from an address lookup table. */
+
+FD_FN_PURE static inline uchar const *
+fd_resolv_nonce_account( fd_txn_t const * txn,
+                         uchar    const * payload ) {
+  ulong acct_idx = payload[ txn->instr[ 0 ].acct_off ];
+  if( FD_UNLIKELY( acct_idx>=txn->acct_addr_cnt ) ) return NULL;
+  return payload + txn->acct_addr_off + 32UL*acct_idx;
+}
+
+/* refresh_nonce records the nonce value stored in durable nonce
+   account acct as of the rooted bank in the nonce cache, unless the
+   account was already loaded from the current root.  Accounts that
+   don't exist or are not initialized nonce accounts are cached as
+   invalid, so transactions naming them don't load them again until the
+   root moves. */
+
+static void
+refresh_nonce( fd_resolv_ctx_t * ctx,
+               uchar const *     acct ) {
+  if( FD_UNLIKELY( !ctx->root_bank ) ) return;
+
+  ulong slot = fd_nonce_cache_slot( ctx->nonce_cache, acct );
+  if( FD_LIKELY( slot!=FD_NONCE_CACHE_SLOT_NONE && slot>=ctx->root_slot ) ) return;
+
+  uchar owner[ 32UL ];
+  uchar data[ 80UL ]; /* FD_SYSTEM_PROGRAM_NONCE_DLEN */
+  ulong data_sz = sizeof(data);
+  if( FD_UNLIKELY( fd_ext_bank_load_account( ctx->root_bank, 0, acct, owner, data, &data_sz ) ) ) goto invalid;
+  if( FD_UNLIKELY( memcmp( owner, fd_solana_system_program_id.uc, 32UL ) || data_sz!=sizeof(data) ) ) goto invalid;
+
+  fd_nonce_state_versions_t versions[1];
+  if( FD_UNLIKELY( !fd_bincode_decode_static( nonce_state_versions, versions, data, data_sz, NULL ) ) ) goto invalid;
+
+  fd_nonce_state_t const * state = fd_nonce_state_versions_is_current( versions ) ? &versions->inner.current : &versions->inner.legacy;
+  if( FD_UNLIKELY( !fd_nonce_state_is_initialized( state ) ) ) goto invalid;
+
+  fd_nonce_cache_update( ctx->nonce_cache, acct, state->inner.initialized.durable_nonce.uc, ctx->root_slot );
+  return;
+
+invalid:
+  fd_nonce_cache_update_invalid( ctx->nonce_cache, acct, ctx->root_slot );
+}
+
 static inline void
 after_frag( fd_resolv_ctx_t *   ctx,
             ulong               in_idx,
@@ -317,7 +354,7 @@ after_frag( fd_resolv_ctx_t *   ctx,
   if( FD_UNLIKELY( ctx->in[in_idx].kind==FD_RESOLV_IN_KIND_BANK ) ) {
     switch( sig ) {
       case 0: {
-        fd_rooted_bank_t * frag = (fd_rooted_bank_t *)ctx->_bank_msg;
+        fd_rooted_bank_t * frag = &ctx->_bank_msg.rooted_bank;
         if( FD_LIKELY( ctx->root_bank ) ) fd_ext_bank_release( ctx->root_bank );
 
         ctx->root_bank = frag->bank;
@@ -325,16 +362,9 @@ after_frag( fd_resolv_ctx_t *   ctx,
         break;
       }
       case 1: {
-        fd_completed_bank_t * frag = (fd_completed_bank_t *)ctx->_bank_msg;
-
-        blockhash_map_t * entry = map_query( ctx->blockhash_map, ctx->blockhash_ring[ ctx->blockhash_ring_idx%BLOCKHASH_RING_LEN ], NULL );
-        if( FD_LIKELY( entry ) ) map_remove( ctx->blockhash_map, entry );
-
-        memcpy( ctx->blockhash_ring[ ctx->blockhash_ring_idx%BLOCKHASH_RING_LEN ].b, frag->hash, 32UL );
-        ctx->blockhash_ring_idx++;
+        fd_completed_bank_t * frag = &ctx->_bank_msg.completed_bank;
 
-        blockhash_map_t * blockhash = map_insert( ctx->blockhash_map, *(blockhash_t *)frag->hash );
-        blockhash->slot = frag->slot;
+        fd_blockhash_cache_insert( ctx->blockhash_cache, frag->hash, frag->slot );
 
         blockhash_t * hash = (blockhash_t *)frag->hash;
         ctx->flush_pool_idx  = map_chain_idx_query_const( ctx->map_chain, &hash, ULONG_MAX, ctx->pool );
@@ -361,16 +391,19 @@ after_frag( fd_resolv_ctx_t *   ctx,
      If we can't find the recent blockhash ... it means one of four
      things,
 
-     (1) The blockhash is really old (more than 19 days) or just
-         non-existent.
+     (1) The blockhash is really old (older than the history of the
+         blockhash cache, around 19 days) or just non-existent.
      (2) The blockhash is not that old, but was created before this
          validator was started.
      (3) It's really new (we haven't seen the bank yet).
      (4) It's a durable nonce transaction, or part of a bundle (just let
          it pass).
 
-    For durable nonce transactions, there isn't much we can do except
-    pass them along and see if they execute.
+    For durable nonce transactions, the recent blockhash is the nonce
+    value the transaction expects in the nonce account.  If the rooted
+    bank already replaced that value, the transaction can never execute
+    and is dropped.  Otherwise there isn't much we can do except pass
+    them along and see if they execute.
 
     For the other three cases ... we don't want to flood pack with what
     might be junk transactions, so we accumulate them into a local
@@ -387,10 +420,21 @@ after_frag( fd_resolv_ctx_t *   ctx,
     return;
   }
 
+  uchar const * recent_blockhash = fd_txn_m_payload( txnm )+txnt->recent_blockhash_off;
+
   txnm->reference_slot = ctx->completed_slot;
-  blockhash_map_t const * blockhash = map_query_const( ctx->blockhash_map, *(blockhash_t*)( fd_txn_m_payload( txnm )+txnt->recent_blockhash_off ), NULL );
+  ulong blockhash_slot = fd_blockhash_cache_query_recent( ctx->blockhash_cache, recent_blockhash );
+  if( FD_LIKELY( blockhash_slot!=FD_BLOCKHASH_CACHE_SLOT_NONE ) ) {
+    ctx->metrics.blockhash_lookup[ FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_RECENT_IDX ]++;
+  } else {
+    blockhash_slot = fd_blockhash_cache_query_history( ctx->blockhash_cache, recent_blockhash );
+    if( FD_LIKELY( blockhash_slot==FD_BLOCKHASH_CACHE_SLOT_NONE ) ) ctx->metrics.blockhash_lookup[ FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_UNKNOWN_IDX ]++;
+    else                                                           ctx->metrics.blockhash_lookup[ FD_METRICS_ENUM_RESOLVE_BLOCKHASH_LOOKUP_V_HISTORY_IDX ]++;
+  }
+
+  int blockhash = blockhash_slot!=FD_BLOCKHASH_CACHE_SLOT_NONE;
   if( FD_LIKELY( blockhash ) ) {
-    txnm->reference_slot = blockhash->slot;
+    txnm->reference_slot = blockhash_slot;
     if( FD_UNLIKELY( txnm->reference_slot+151UL<ctx->completed_slot ) ) {
       if( FD_UNLIKELY( txnm->block_engine.bundle_id ) ) ctx->bundle_failed = 1;
       ctx->metrics.blockhash_expired++;
@@ -401,6 +445,27 @@ after_frag( fd_resolv_ctx_t *   ctx,
   int is_bundle_member = !!txnm->block_engine.bundle_id;
   int is_durable_nonce = fd_resolv_is_durable_nonce( txnt, fd_txn_m_payload( txnm ) );
 
+  if( FD_UNLIKELY( is_durable_nonce && !blockhash ) ) {
+    uchar const * nonce_account = fd_resolv_nonce_account( txnt, fd_txn_m_payload( txnm ) );
+    int nonce = FD_NONCE_CACHE_UNKNOWN;
+    if( FD_LIKELY( nonce_account ) ) {
+      refresh_nonce( ctx, nonce_account );
+      nonce = fd_nonce_cache_query( ctx->nonce_cache, nonce_account, recent_blockhash );
+    }
+    switch( nonce ) {
+      case FD_NONCE_CACHE_CURRENT:
+        ctx->metrics.nonce_lookup[ FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_CURRENT_IDX ]++;
+        break;
+      case FD_NONCE_CACHE_STALE:
+        ctx->metrics.nonce_lookup[ FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_STALE_IDX ]++;
+        if( FD_UNLIKELY( txnm->block_engine.bundle_id ) ) ctx->bundle_failed = 1;
+        return;
+      default:
+        ctx->metrics.nonce_lookup[ FD_METRICS_ENUM_RESOLVE_NONCE_LOOKUP_V_UNKNOWN_IDX ]++;
+        break;
+    }
+  }
+
   if( FD_UNLIKELY( !is_bundle_member && !is_durable_nonce && !blockhash ) ) {
     ulong pool_idx;
     if( FD_UNLIKELY( !pool_free( ctx->pool ) ) ) {
@@ -469,7 +534,6 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->bundle_id     = 0UL;
 
   ctx->completed_slot = 0UL;
-  ctx->blockhash_ring_idx = 0UL;
 
   ctx->flush_pool_idx = ULONG_MAX;
 
@@ -485,11 +549,13 @@ unprivileged_init( fd_topo_t *      topo,
 
   ctx->root_bank = NULL;
 
-  memset( ctx->blockhash_ring, 0, sizeof( ctx->blockhash_ring ) );
   memset( &ctx->metrics, 0, sizeof( ctx->metrics ) );
 
-  ctx->blockhash_map = map_join( map_new( FD_SCRATCH_ALLOC_APPEND( l, map_align(), map_footprint() ) ) );
-  FD_TEST( ctx->blockhash_map );
+  ctx->blockhash_cache = fd_blockhash_cache_join( fd_blockhash_cache_new( FD_SCRATCH_ALLOC_APPEND( l, fd_blockhash_cache_align(), fd_blockhash_cache_footprint( BLOCKHASH_LG_HISTORY_CNT ) ), BLOCKHASH_LG_HISTORY_CNT ) );
+  FD_TEST( ctx->blockhash_cache );
+
+  ctx->nonce_cache = fd_nonce_cache_join( fd_nonce_cache_new( FD_SCRATCH_ALLOC_APPEND( l, fd_nonce_cache_align(), fd_nonce_cache_footprint( NONCE_LG_CACHE_CNT ) ), NONCE_LG_CACHE_CNT ) );
+  FD_TEST( ctx->nonce_cache );
 
   FD_TEST( tile->in_cnt<=sizeof( ctx->in )/sizeof( ctx->in[ 0 ] ) );
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
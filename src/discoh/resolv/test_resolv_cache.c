@@ -0,0 +1,217 @@
+#include "fd_resolv_cache.h"
+
+#define LG_HISTORY_CNT (12UL)
+#define LG_NONCE_CNT   (10UL)
+
+static uchar blockhash_mem[ 1UL<<20 ] __attribute__((aligned(FD_BLOCKHASH_CACHE_ALIGN)));
+static uchar nonce_mem    [ 1UL<<17 ] __attribute__((aligned(FD_NONCE_CACHE_ALIGN)));
+
+/* make_hash deterministically derives a pseudo random 32 byte hash from
+   (seed,i). */
+
+static void
+make_hash( uchar * hash,
+           ulong   seed,
+           ulong   i ) {
+  for( ulong j=0UL; j<4UL; j++ ) FD_STORE( ulong, hash+8UL*j, fd_ulong_hash( seed ^ (i<<2) ^ j ) );
+}
+
+static void
+test_blockhash_cache( fd_blockhash_cache_t * cache ) {
+  ulong history_cnt = 1UL<<LG_HISTORY_CNT;
+  ulong recent_cnt  = FD_BLOCKHASH_CACHE_RECENT_CNT;
+  uchar hash[ 32 ];
+
+  make_hash( hash, 1UL, 0UL );
+  FD_TEST( fd_blockhash_cache_query_recent ( cache, hash )==FD_BLOCKHASH_CACHE_SLOT_NONE );
+  FD_TEST( fd_blockhash_cache_query_history( cache, hash )==FD_BLOCKHASH_CACHE_SLOT_NONE );
+
+  /* The null hash is never inserted */
+
+  uchar zero[ 32 ] = {0};
+  fd_blockhash_cache_insert( cache, zero, 7UL );
+  FD_TEST( fd_blockhash_cache_query_recent( cache, zero )==FD_BLOCKHASH_CACHE_SLOT_NONE );
+
+  /* Insert enough blockhashes to wrap the history twice, blockhash i
+     completing slot 1000+i */
+
+  ulong total = 2UL*history_cnt + recent_cnt + 17UL;
+  for( ulong i=0UL; i<total; i++ ) {
+    make_hash( hash, 1UL, i );
+    fd_blockhash_cache_insert( cache, hash, 1000UL+i );
+    fd_blockhash_cache_insert( cache, hash, 5UL ); /* duplicate ignored */
+    FD_TEST( fd_blockhash_cache_query_recent( cache, hash )==1000UL+i );
+  }
+
+  for( ulong i=0UL; i<total; i++ ) {
+    make_hash( hash, 1UL, i );
+    ulong recent  = fd_blockhash_cache_query_recent ( cache, hash );
+    ulong history = fd_blockhash_cache_query_history( cache, hash );
+    if( i>=total-recent_cnt ) {
+      FD_TEST( recent==1000UL+i );
+    } else if( i>=total-recent_cnt-history_cnt ) {
+      FD_TEST( recent==FD_BLOCKHASH_CACHE_SLOT_NONE );
+      FD_TEST( history==1000UL+i );
+    } else {
+      FD_TEST( recent ==FD_BLOCKHASH_CACHE_SLOT_NONE );
+      FD_TEST( history==FD_BLOCKHASH_CACHE_SLOT_NONE );
+    }
+  }
+
+  /* Hashes that were never inserted */
+
+  for( ulong i=0UL; i<1000UL; i++ ) {
+    make_hash( hash, 2UL, i );
+    FD_TEST( fd_blockhash_cache_query_recent ( cache, hash )==FD_BLOCKHASH_CACHE_SLOT_NONE );
+    FD_TEST( fd_blockhash_cache_query_history( cache, hash )==FD_BLOCKHASH_CACHE_SLOT_NONE );
+  }
+}
+
+static void
+test_nonce_cache( fd_nonce_cache_t * cache ) {
+  uchar acct[ 32 ], nonce0[ 32 ], nonce1[ 32 ], nonce2[ 32 ];
+  make_hash( acct,   3UL, 0UL );
+  make_hash( nonce0, 4UL, 0UL );
+  make_hash( nonce1, 4UL, 1UL );
+  make_hash( nonce2, 4UL, 2UL );
+
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce0 )==FD_NONCE_CACHE_UNKNOWN );
+  FD_TEST( fd_nonce_cache_slot ( cache, acct         )==FD_NONCE_CACHE_SLOT_NONE );
+
+  fd_nonce_cache_update( cache, acct, nonce0, 10UL );
+  FD_TEST( fd_nonce_cache_slot ( cache, acct         )==10UL );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce0 )==FD_NONCE_CACHE_CURRENT );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce1 )==FD_NONCE_CACHE_UNKNOWN );
+
+  fd_nonce_cache_update( cache, acct, nonce1, 11UL );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce0 )==FD_NONCE_CACHE_STALE   );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce1 )==FD_NONCE_CACHE_CURRENT );
+
+  /* Repeated and older updates don't lose the replaced value */
+
+  fd_nonce_cache_update( cache, acct, nonce1, 12UL );
+  fd_nonce_cache_update( cache, acct, nonce2, 9UL  );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce0 )==FD_NONCE_CACHE_STALE   );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce1 )==FD_NONCE_CACHE_CURRENT );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce2 )==FD_NONCE_CACHE_UNKNOWN );
+  FD_TEST( fd_nonce_cache_slot ( cache, acct         )==12UL );
+
+  /* Other accounts with the same nonce are unrelated */
+
+  uchar other[ 32 ];
+  make_hash( other, 3UL, 1UL );
+  FD_TEST( fd_nonce_cache_query( cache, other, nonce0 )==FD_NONCE_CACHE_UNKNOWN );
+  FD_TEST( fd_nonce_cache_slot ( cache, other         )==FD_NONCE_CACHE_SLOT_NONE );
+
+  /* Accounts that are not nonce accounts are remembered per slot, and
+     replaced values stay stale while an account is invalid */
+
+  fd_nonce_cache_update_invalid( cache, other, 12UL );
+  FD_TEST( fd_nonce_cache_slot ( cache, other         )==12UL );
+  FD_TEST( fd_nonce_cache_query( cache, other, nonce0 )==FD_NONCE_CACHE_UNKNOWN );
+
+  fd_nonce_cache_update_invalid( cache, acct, 13UL );
+  FD_TEST( fd_nonce_cache_slot ( cache, acct         )==13UL );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce0 )==FD_NONCE_CACHE_UNKNOWN );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce1 )==FD_NONCE_CACHE_STALE   );
+
+  fd_nonce_cache_update( cache, acct, nonce2, 14UL );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce1 )==FD_NONCE_CACHE_STALE   );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce2 )==FD_NONCE_CACHE_CURRENT );
+  FD_TEST( fd_nonce_cache_slot ( cache, acct         )==14UL );
+
+  fd_nonce_cache_update_invalid( cache, acct, 13UL );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce2 )==FD_NONCE_CACHE_CURRENT );
+
+  /* Conflicting accounts evict each other, which only loses
+     information */
+
+  ulong ent_cnt = 1UL<<LG_NONCE_CNT;
+  for( ulong i=0UL; i<8UL*ent_cnt; i++ ) {
+    make_hash( other, 5UL, i );
+    fd_nonce_cache_update( cache, other, nonce2, 20UL );
+  }
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce2 )!=FD_NONCE_CACHE_CURRENT );
+  FD_TEST( fd_nonce_cache_query( cache, acct, nonce1 )!=FD_NONCE_CACHE_STALE   );
+}
+
+static void
+bench( fd_blockhash_cache_t * cache,
+       fd_nonce_cache_t *     nonce_cache ) {
+  ulong const query_cnt = 1UL<<20;
+  static uchar hashes[ 1024 ][ 32 ];
+
+  /* Recent hits: a steady state where transactions reference the last
+     150 blockhashes. */
+
+  for( ulong i=0UL; i<1024UL; i++ ) make_hash( hashes[ i ], 6UL, i );
+  for( ulong i=0UL; i<1024UL; i++ ) fd_blockhash_cache_insert( cache, hashes[ i ], i );
+
+  ulong sum = 0UL;
+  long  dt  = -fd_log_wallclock();
+  for( ulong i=0UL; i<query_cnt; i++ ) sum += fd_blockhash_cache_query_recent( cache, hashes[ 1023UL-(i%150UL) ] );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "blockhash recent hit:   %.3f ns/query", (double)dt/(double)query_cnt ));
+
+  /* Expired: found in the history after missing the recent index */
+
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<query_cnt; i++ ) {
+    uchar const * hash = hashes[ i%(1024UL-FD_BLOCKHASH_CACHE_RECENT_CNT) ];
+    if( fd_blockhash_cache_query_recent( cache, hash )==FD_BLOCKHASH_CACHE_SLOT_NONE ) sum += fd_blockhash_cache_query_history( cache, hash );
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "blockhash history hit:  %.3f ns/query", (double)dt/(double)query_cnt ));
+
+  /* Bogus: misses both */
+
+  for( ulong i=0UL; i<1024UL; i++ ) make_hash( hashes[ i ], 7UL, i );
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<query_cnt; i++ ) {
+    uchar const * hash = hashes[ i%1024UL ];
+    if( fd_blockhash_cache_query_recent( cache, hash )==FD_BLOCKHASH_CACHE_SLOT_NONE ) sum += fd_blockhash_cache_query_history( cache, hash );
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "blockhash miss:         %.3f ns/query", (double)dt/(double)query_cnt ));
+
+  /* Nonce lookups of stale nonces */
+
+  for( ulong i=0UL; i<512UL; i++ ) {
+    fd_nonce_cache_update( nonce_cache, hashes[ i ], hashes[ 512UL+i ], 1UL );
+    fd_nonce_cache_update( nonce_cache, hashes[ i ], hashes[ (513UL+i)%1024UL ], 2UL );
+  }
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<query_cnt; i++ ) sum += (ulong)fd_nonce_cache_query( nonce_cache, hashes[ i%512UL ], hashes[ 512UL+(i%512UL) ] );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "nonce lookup:           %.3f ns/query", (double)dt/(double)query_cnt ));
+
+  FD_COMPILER_FORGET( sum );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_blockhash_cache_footprint( LG_HISTORY_CNT )<=sizeof(blockhash_mem) );
+  FD_TEST( fd_nonce_cache_footprint( LG_NONCE_CNT )<=sizeof(nonce_mem) );
+  FD_TEST( !fd_blockhash_cache_footprint( 0UL  ) );
+  FD_TEST( !fd_blockhash_cache_footprint( 31UL ) );
+  FD_TEST( !fd_nonce_cache_footprint( 25UL ) );
+
+  fd_blockhash_cache_t * cache = fd_blockhash_cache_join( fd_blockhash_cache_new( blockhash_mem, LG_HISTORY_CNT ) );
+  FD_TEST( cache );
+  fd_nonce_cache_t * nonce_cache = fd_nonce_cache_join( fd_nonce_cache_new( nonce_mem, LG_NONCE_CNT ) );
+  FD_TEST( nonce_cache );
+
+  test_blockhash_cache( cache );
+  test_nonce_cache( nonce_cache );
+  bench( cache, nonce_cache );
+
+  FD_TEST( fd_blockhash_cache_delete( fd_blockhash_cache_leave( cache ) )==blockhash_mem );
+  FD_TEST( fd_nonce_cache_delete( fd_nonce_cache_leave( nonce_cache ) )==nonce_mem );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
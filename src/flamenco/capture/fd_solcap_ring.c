@@ -0,0 +1,163 @@
+#include "fd_solcap_ring.h"
+
+void *
+fd_solcap_ring_new( void * mem,
+                    ulong  depth ) {
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, fd_solcap_ring_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+  ulong footprint = fd_solcap_ring_footprint( depth );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "invalid depth %lu", depth ));
+    return NULL;
+  }
+
+  fd_solcap_ring_t * ring = mem;
+  memset( ring, 0, sizeof(fd_solcap_ring_t) );
+  ring->depth = depth;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->magic ) = FD_SOLCAP_RING_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+fd_solcap_ring_t *
+fd_solcap_ring_join( void * shring ) {
+
+  if( FD_UNLIKELY( !shring ) ) {
+    FD_LOG_WARNING(( "NULL shring" ));
+    return NULL;
+  }
+  fd_solcap_ring_t * ring = shring;
+  if( FD_UNLIKELY( ring->magic!=FD_SOLCAP_RING_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+  return ring;
+}
+
+void *
+fd_solcap_ring_leave( fd_solcap_ring_t * ring ) {
+  return (void *)ring;
+}
+
+void *
+fd_solcap_ring_delete( void * shring ) {
+
+  if( FD_UNLIKELY( !shring ) ) {
+    FD_LOG_WARNING(( "NULL shring" ));
+    return NULL;
+  }
+  fd_solcap_ring_t * ring = shring;
+  if( FD_UNLIKELY( ring->magic!=FD_SOLCAP_RING_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shring;
+}
+
+int
+fd_solcap_ring_publish( fd_solcap_ring_t *      ring,
+                        fd_solcap_iov_t const * iov,
+                        ulong                   iov_cnt ) {
+
+  ulong sz = 0UL;
+  for( ulong i=0UL; i<iov_cnt; i++ ) sz += iov[i].sz;
+
+  ulong depth = ring->depth;
+  ulong prod  = ring->prod;
+  ulong cons  = FD_VOLATILE_CONST( ring->cons );
+  FD_COMPILER_MFENCE();
+
+  if( FD_UNLIKELY( sz > depth-(prod-cons) ) ) {
+    ring->drop_cnt++;
+    ring->drop_sz += sz;
+    return 0;
+  }
+
+  uchar * data = fd_solcap_ring_data( ring );
+  ulong   seq  = prod;
+  for( ulong i=0UL; i<iov_cnt; i++ ) {
+    uchar const * src = iov[i].buf;
+    ulong         rem = iov[i].sz;
+    while( rem ) {
+      ulong off = seq & (depth-1UL);
+      ulong cpy = fd_ulong_min( rem, depth-off );
+      fd_memcpy( data+off, src, cpy );
+      src += cpy;
+      rem -= cpy;
+      seq += cpy;
+    }
+  }
+
+  ring->pub_cnt++;
+  ring->pub_sz += sz;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->prod ) = seq;
+  return 1;
+}
+
+void
+fd_solcap_ring_fhdr_post( fd_solcap_ring_t * ring,
+                          uchar const *      fhdr ) {
+  ulong ver = ring->fhdr_ver;
+  FD_VOLATILE( ring->fhdr_ver ) = ver+1UL;
+  FD_COMPILER_MFENCE();
+  fd_memcpy( ring->fhdr, fhdr, FD_SOLCAP_FHDR_SZ );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->fhdr_ver ) = ver+2UL;
+}
+
+int
+fd_solcap_ring_fhdr_query( fd_solcap_ring_t const * ring,
+                           ulong *                  ver,
+                           uchar *                  out ) {
+  for(;;) {
+    ulong ver0 = FD_VOLATILE_CONST( ring->fhdr_ver );
+    if( FD_LIKELY( ver0==*ver ) ) return 0;
+    if( FD_UNLIKELY( ver0&1UL ) ) { FD_SPIN_PAUSE(); continue; }
+    FD_COMPILER_MFENCE();
+    fd_memcpy( out, ring->fhdr, FD_SOLCAP_FHDR_SZ );
+    FD_COMPILER_MFENCE();
+    ulong ver1 = FD_VOLATILE_CONST( ring->fhdr_ver );
+    if( FD_LIKELY( ver0==ver1 ) ) {
+      *ver = ver0;
+      return 1;
+    }
+  }
+}
+
+int
+fd_solcap_ring_halt( fd_solcap_ring_t * ring,
+                     long               timeout_ns ) {
+
+  ulong req = ring->halt_req + 1UL;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->halt_req ) = req;
+  FD_COMPILER_MFENCE();
+
+  long deadline = fd_log_wallclock() + timeout_ns;
+  while( FD_VOLATILE_CONST( ring->halt_ack )!=req ) {
+    if( FD_UNLIKELY( fd_log_wallclock()>deadline ) ) {
+      FD_LOG_WARNING(( "timed out waiting for solcap capture to be written out (%lu bytes pending)",
+                       FD_VOLATILE_CONST( ring->prod ) - FD_VOLATILE_CONST( ring->cons ) ));
+      return 0;
+    }
+    FD_SPIN_PAUSE();
+  }
+  return 1;
+}
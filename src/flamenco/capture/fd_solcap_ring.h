@@ -0,0 +1,209 @@
+#ifndef HEADER_fd_src_flamenco_capture_fd_solcap_ring_h
+#define HEADER_fd_src_flamenco_capture_fd_solcap_ring_h
+
+#include "fd_solcap_proto.h"
+
+/* fd_solcap_ring_t is a single-producer single-consumer byte ring in
+   shared memory that carries a solcap stream from the runtime to a
+   separate writer (typically the solcap tile).
+
+   The producer (fd_solcap_writer) publishes whole chunks.  A chunk
+   that does not fit into the free space of the ring is dropped in its
+   entirety and counted, such that the runtime never blocks on capture
+   I/O and the consumer only ever sees complete chunks.  The ring
+   contents are the exact byte sequence that follows the file header in
+   a solcap file, so the consumer can append them to the file as-is
+   with large sequential writes.
+
+   The file header (fd_solcap_fhdr_t and the FileMeta Protobuf) changes
+   as the capture progresses (slot bounds) and is thus not part of the
+   byte stream.  Instead, the producer posts the latest version out of
+   band, and the consumer rewrites it at the start of the file whenever
+   it changes.
+
+   Before the process is torn down, fd_solcap_ring_halt asks the
+   consumer to write out everything published so far together with the
+   latest file header, and waits for it to finish.
+
+   Sequence numbers are byte counts since the start of the stream and
+   never wrap in practice. */
+
+#define FD_SOLCAP_RING_MAGIC (0xf17eda2ce5017ca9UL) /* firedancer solcap ring version 0 */
+#define FD_SOLCAP_RING_ALIGN (128UL)
+
+/* fd_solcap_iov_t describes one contiguous piece of a chunk to
+   publish. */
+
+struct fd_solcap_iov {
+  void const * buf;
+  ulong        sz;
+};
+
+typedef struct fd_solcap_iov fd_solcap_iov_t;
+
+struct __attribute__((aligned(FD_SOLCAP_RING_ALIGN))) fd_solcap_ring_private {
+  ulong magic;    /* ==FD_SOLCAP_RING_MAGIC */
+  ulong depth;    /* Data region size in bytes, power of two */
+
+  /* File header, seqlock protected by fhdr_ver (odd while the producer
+     is writing). */
+
+  ulong fhdr_ver;
+  uchar fhdr[ FD_SOLCAP_FHDR_SZ ];
+
+  /* Producer diagnostics */
+
+  ulong pub_cnt;  /* Chunks published */
+  ulong pub_sz;   /* Bytes published */
+  ulong drop_cnt; /* Chunks dropped due to backpressure */
+  ulong drop_sz;  /* Bytes dropped due to backpressure */
+
+  /* Halt handshake, see fd_solcap_ring_halt */
+
+  ulong halt_req;
+  ulong halt_ack;
+
+  /* Producer and consumer cursors live on their own cache lines */
+
+  __attribute__((aligned(FD_SOLCAP_RING_ALIGN))) ulong prod;
+  __attribute__((aligned(FD_SOLCAP_RING_ALIGN))) ulong cons;
+
+  /* Data region of depth bytes follows */
+};
+
+typedef struct fd_solcap_ring_private fd_solcap_ring_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_solcap_ring_{align,footprint} return the memory requirements for
+   a ring with the given data region size in bytes.  depth must be a
+   power of two of at least FD_SOLCAP_FHDR_SZ.  footprint returns 0 if
+   depth is invalid. */
+
+FD_FN_CONST static inline ulong
+fd_solcap_ring_align( void ) {
+  return FD_SOLCAP_RING_ALIGN;
+}
+
+FD_FN_CONST static inline ulong
+fd_solcap_ring_footprint( ulong depth ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( depth ) || depth<FD_SOLCAP_FHDR_SZ || depth>(1UL<<40) ) ) return 0UL;
+  return sizeof(fd_solcap_ring_t) + depth;
+}
+
+/* fd_solcap_ring_new formats an unused memory region for use as a
+   solcap ring.  Returns mem on success and NULL on failure (logs
+   details).  fd_solcap_ring_join joins the caller to the ring.
+   fd_solcap_ring_leave and fd_solcap_ring_delete do the inverse. */
+
+void *
+fd_solcap_ring_new( void * mem,
+                    ulong  depth );
+
+fd_solcap_ring_t *
+fd_solcap_ring_join( void * shring );
+
+void *
+fd_solcap_ring_leave( fd_solcap_ring_t * ring );
+
+void *
+fd_solcap_ring_delete( void * shring );
+
+FD_FN_CONST static inline uchar *
+fd_solcap_ring_data( fd_solcap_ring_t * ring ) {
+  return (uchar *)( ring+1 );
+}
+
+/* Producer API *******************************************************/
+
+/* fd_solcap_ring_publish appends the concatenation of iov[0,iov_cnt)
+   to the ring as one unit.  Returns 1 on success.  If the ring does
+   not have enough free space, nothing is written, the drop counters
+   are incremented and returns 0.  Never blocks. */
+
+int
+fd_solcap_ring_publish( fd_solcap_ring_t *      ring,
+                        fd_solcap_iov_t const * iov,
+                        ulong                   iov_cnt );
+
+/* fd_solcap_ring_fhdr_post replaces the file header posted to the
+   consumer.  fhdr points to FD_SOLCAP_FHDR_SZ bytes. */
+
+void
+fd_solcap_ring_fhdr_post( fd_solcap_ring_t * ring,
+                          uchar const *      fhdr );
+
+/* Consumer API *******************************************************/
+
+/* fd_solcap_ring_peek returns the number of contiguous bytes ready to
+   be consumed and sets *data to the first such byte.  At most max
+   bytes are returned.  Returns 0 if the ring is empty.  Bytes stay
+   valid until released with fd_solcap_ring_consume. */
+
+static inline ulong
+fd_solcap_ring_peek( fd_solcap_ring_t * ring,
+                     uchar const **     data,
+                     ulong              max ) {
+  ulong cons = ring->cons;
+  ulong prod = FD_VOLATILE_CONST( ring->prod );
+  FD_COMPILER_MFENCE();
+  ulong off  = cons & (ring->depth-1UL);
+  ulong sz   = fd_ulong_min( fd_ulong_min( prod-cons, ring->depth-off ), max );
+  *data = fd_solcap_ring_data( ring ) + off;
+  return sz;
+}
+
+/* fd_solcap_ring_consume releases sz bytes previously returned by
+   fd_solcap_ring_peek back to the producer. */
+
+static inline void
+fd_solcap_ring_consume( fd_solcap_ring_t * ring,
+                        ulong              sz ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->cons ) = ring->cons + sz;
+}
+
+/* fd_solcap_ring_fhdr_query copies out the latest file header if it
+   is newer than *ver.  Returns 1 and updates *ver if a new header was
+   copied to out (FD_SOLCAP_FHDR_SZ bytes), 0 otherwise. */
+
+int
+fd_solcap_ring_fhdr_query( fd_solcap_ring_t const * ring,
+                           ulong *                  ver,
+                           uchar *                  out );
+
+/* Halt API ***********************************************************/
+
+/* fd_solcap_ring_halt asks the consumer to write out everything
+   published so far and the latest posted file header, then waits up to
+   timeout_ns for it to finish.  Called on shutdown paths before the
+   producer or the consumer go away.  Any joiner of the ring may call
+   it, but at most one at a time.  Returns 1 once the capture is
+   complete on disk and 0 on timeout (logs details).  The ring remains
+   usable afterwards. */
+
+int
+fd_solcap_ring_halt( fd_solcap_ring_t * ring,
+                     long               timeout_ns );
+
+/* fd_solcap_ring_halt_query returns the pending halt request, or 0 if
+   there is none.  fd_solcap_ring_halt_ack completes the halt request
+   req.  The consumer drains the ring and writes the file header in
+   between. */
+
+static inline ulong
+fd_solcap_ring_halt_query( fd_solcap_ring_t const * ring ) {
+  ulong req = FD_VOLATILE_CONST( ring->halt_req );
+  return fd_ulong_if( req!=FD_VOLATILE_CONST( ring->halt_ack ), req, 0UL );
+}
+
+static inline void
+fd_solcap_ring_halt_ack( fd_solcap_ring_t * ring,
+                         ulong              req ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->halt_ack ) = req;
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_capture_fd_solcap_ring_h */
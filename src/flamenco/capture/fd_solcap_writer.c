@@ -29,110 +29,80 @@
      entry for the accounts table.
    - fd_solcap_write_bank_preimage flushes the buffered accounts table
      and writes the preimage chunk.  Slot is finished and ready for
-     next iteration. */
+     next iteration.
+
+   Every chunk is fully laid out in memory (header, Protobuf metadata,
+   padding) before it is emitted, such that the stream is produced
+   strictly sequentially.  The only seek is the file header rewrite in
+   fd_solcap_writer_flush.  Chunks are emitted to either a stdio stream
+   (synchronous) or a fd_solcap_ring_t (asynchronous, drained by
+   another thread).  In ring mode, chunks that do not fit into the ring
+   are dropped whole. */
 
 struct fd_solcap_writer {
-  FILE * file;
+  FILE *             file;
+  fd_solcap_ring_t * ring;
 
   /* Number of bytes between start of file and start of stream.
      Usually 0.  Non-zero if the bank capture is contained in some
      other file format. */
   ulong stream_goff;
 
+  /* Stream offset of the next chunk */
+  ulong foff;
+
   /* In-flight write of accounts table.
      account_idx==0UL implies no chunk header has been written yet.
      account_idx>=0UL implies AccountTable chunk write is pending.
      account_idx>=FD_SOLCAP_ACC_TBL_CNT implies that AccountTable is
-     unable to fit records.  Table record will be skipped. */
+     unable to fit records.  Table record will be skipped.
+     account_table_foff==0UL implies that no account table was written
+     for the current slot. */
 
   ulong                   slot;
   fd_solcap_account_tbl_t accounts[ FD_SOLCAP_ACC_TBL_CNT ];
   uint                    account_idx;
-  ulong                   account_table_goff;
+  ulong                   account_table_foff;
 
   ulong first_slot;
 };
 
-/* FTELL_BAIL calls ftell on the given file, and bails the current
-   function with return code EIO if it fails. */
-
-#define FTELL_BAIL( file )                      \
-  (__extension__({                              \
-    long n = ftell( (file) );                   \
-    if( FD_UNLIKELY( n<0L ) ) {                 \
-      FD_LOG_WARNING(( "ftell failed (%d-%s)",  \
-        errno, strerror( errno ) ));            \
-      return EIO;                               \
-    }                                           \
-    (ulong)n;                                   \
-  }))
-
-/* FSEEK_BAIL calls fseek on the given file, and bails the current
-   function with return code EIO if it fails. */
-
-#define FSEEK_BAIL( file, off, whence )         \
-  (__extension__({                              \
-    int err = fseek( (file), (off), (whence) ); \
-    if( FD_UNLIKELY( err<0L ) ) {               \
-      FD_LOG_WARNING(( "fseek failed (%d-%s)",  \
-        errno, strerror( errno ) ));            \
-      return EIO;                               \
-    }                                           \
-    0;                                          \
-  }))
-
-/* FWRITE_BAIL calls fwrite on the given file, and bails the current
-   function with return code EIO if it fails. */
-
-#define FWRITE_BAIL( ptr, sz, cnt, file )          \
-  (__extension__({                                 \
-    ulong _cnt = (cnt);                            \
-    ulong n = fwrite( (ptr), (sz), _cnt, (file) ); \
-    if( FD_UNLIKELY( n!=_cnt ) ) {                 \
-      FD_LOG_WARNING(( "fwrite failed (%d-%s)",    \
-        errno, strerror( errno ) ));               \
-      return EIO;                                  \
-    }                                              \
-    0;                                             \
-  }))
-
-/* _skip_file writes zeros to the file */
+static uchar const fd_solcap_writer_zero[ 8UL ] = {0};
 
-static int
-_skip_file( FILE * file,
-            ulong  skip ) {
-  if (skip == 0) return 0;
+/* fd_solcap_writer_emit appends a chunk consisting of the given pieces
+   to the stream.  The pieces must add up to a multiple of 8 bytes.
+   Returns 0 on success and advances the stream offset.  Returns
+   ENOBUFS if the chunk was dropped due to ring backpressure (stream
+   offset unchanged).  Returns EIO on stream I/O error. */
 
-  uchar zero[ skip ];
-  fd_memset( zero, 0, skip );
+static int
+fd_solcap_writer_emit( fd_solcap_writer_t *    writer,
+                       fd_solcap_iov_t const * iov,
+                       ulong                   iov_cnt ) {
+
+  ulong sz = 0UL;
+  for( ulong i=0UL; i<iov_cnt; i++ ) sz += iov[i].sz;
+
+  if( writer->ring ) {
+    if( FD_UNLIKELY( !fd_solcap_ring_publish( writer->ring, iov, iov_cnt ) ) ) return ENOBUFS;
+  } else {
+    for( ulong i=0UL; i<iov_cnt; i++ ) {
+      if( !iov[i].sz ) continue;
+      if( FD_UNLIKELY( 1UL!=fwrite( iov[i].buf, iov[i].sz, 1UL, writer->file ) ) ) {
+        FD_LOG_WARNING(( "fwrite failed (%d-%s)", errno, strerror( errno ) ));
+        return EIO;
+      }
+    }
+  }
 
-  FWRITE_BAIL( zero, 1UL, skip, file );
+  writer->foff += sz;
   return 0;
 }
 
-#define FSKIP_BAIL( file, skip )            \
-  do {                                      \
-    int err = _skip_file( (file), (skip) ); \
-    if( FD_UNLIKELY( err!=0 ) ) return err; \
-  } while(0)
-
-/* _align_file pads file with zero up to meet given align requirement.
-   align is a positive power of two. */
-
-static int
-_align_file( FILE * file,
-             ulong  align ) {
-  ulong pos  = FTELL_BAIL( file );
-  ulong skip = fd_ulong_align_up( pos, align ) - pos;
-  return _skip_file( file, skip );
-}
-
-#define FALIGN_BAIL( file, align )            \
-  do {                                        \
-    int err = _align_file( (file), (align) ); \
-    if( FD_UNLIKELY( err!=0 ) ) return err;   \
-  } while(0)
+/* FD_SOLCAP_PAD returns the number of zero bytes needed to pad sz to a
+   multiple of 8. */
 
+#define FD_SOLCAP_PAD( sz ) ( fd_ulong_align_up( (sz), 8UL ) - (sz) )
 
 ulong
 fd_solcap_writer_align( void ) {
@@ -162,6 +132,7 @@ fd_solcap_writer_delete( fd_solcap_writer_t * writer ) {
   if( FD_UNLIKELY( !writer ) ) return NULL;
 
   writer->file = NULL;
+  writer->ring = NULL;
   return writer;
 }
 
@@ -197,7 +168,33 @@ fd_solcap_writer_init( fd_solcap_writer_t * writer,
 
   /* Init writer */
   writer->file        = file;
+  writer->ring        = NULL;
   writer->stream_goff = stream_goff;
+  writer->foff        = FD_SOLCAP_FHDR_SZ;
+
+  return writer;
+}
+
+fd_solcap_writer_t *
+fd_solcap_writer_init_ring( fd_solcap_writer_t * writer,
+                            fd_solcap_ring_t *   ring ) {
+
+  if( FD_UNLIKELY( !writer ) ) {
+    FD_LOG_WARNING(( "NULL writer" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !ring ) ) {
+    FD_LOG_WARNING(( "NULL ring" ));
+    return NULL;
+  }
+
+  /* The consumer reserves space for the file header, the ring only
+     carries the stream that follows it. */
+
+  writer->file        = NULL;
+  writer->ring        = ring;
+  writer->stream_goff = 0UL;
+  writer->foff        = FD_SOLCAP_FHDR_SZ;
 
   return writer;
 }
@@ -209,17 +206,6 @@ fd_solcap_writer_flush( fd_solcap_writer_t * writer ) {
 
   if( FD_LIKELY( !writer ) ) return NULL;
 
-  /* Flush stream */
-  fflush( writer->file );
-
-  /* Remember stream cursor */
-
-  long cursor = ftell( writer->file );
-  if( FD_UNLIKELY( cursor<0L ) ) {
-    FD_LOG_WARNING(( "ftell failed (%d-%s)", errno, strerror( errno ) ));
-    return NULL;
-  }
-
   /* Construct file header */
 
   fd_solcap_FileMeta fmeta = {
@@ -228,39 +214,40 @@ fd_solcap_writer_flush( fd_solcap_writer_t * writer ) {
     .main_block_magic = FD_SOLCAP_V1_BANK_MAGIC,
   };
 
-  uchar meta[ 128UL ];
-  pb_ostream_t stream = pb_ostream_from_buffer( meta, sizeof(meta) );
+  uchar hdr[ FD_SOLCAP_FHDR_SZ ] __attribute__((aligned(8))) = {0};
+  uchar * meta = hdr + sizeof(fd_solcap_fhdr_t);
+  pb_ostream_t stream = pb_ostream_from_buffer( meta, FD_SOLCAP_FHDR_SZ - sizeof(fd_solcap_fhdr_t) );
   if( FD_UNLIKELY( !pb_encode( &stream, fd_solcap_FileMeta_fields, &fmeta ) ) ) {
     FD_LOG_WARNING(( "pb_encode failed (%s)", PB_GET_ERROR(&stream) ));
     return NULL;
   }
 
-  fd_solcap_fhdr_t fhdr = {
-    .magic       = FD_SOLCAP_V1_FILE_MAGIC,
-    .chunk0_foff = FD_SOLCAP_FHDR_SZ,
-    .meta_sz     = (uint)stream.bytes_written,
-  };
+  fd_solcap_fhdr_t * fhdr = (fd_solcap_fhdr_t *)hdr;
+  fhdr->magic       = FD_SOLCAP_V1_FILE_MAGIC;
+  fhdr->chunk0_foff = FD_SOLCAP_FHDR_SZ;
+  fhdr->meta_sz     = (uint)stream.bytes_written;
+
+  if( writer->ring ) {
+    fd_solcap_ring_fhdr_post( writer->ring, hdr );
+    return writer;
+  }
 
-  /* Write out file headers */
+  /* Write out file headers, then restore stream cursor */
+
+  fflush( writer->file );
 
   if( FD_UNLIKELY( 0!=fseek( writer->file, (long)writer->stream_goff, SEEK_SET ) ) ) {
     FD_LOG_WARNING(( "fseek failed (%d-%s)", errno, strerror( errno ) ));
     return NULL;
   }
 
-  if( FD_UNLIKELY( 1UL!=fwrite( &fhdr, sizeof(fd_solcap_fhdr_t), 1UL, writer->file ) ) ) {
+  ulong hdr_sz = sizeof(fd_solcap_fhdr_t) + stream.bytes_written;
+  if( FD_UNLIKELY( 1UL!=fwrite( hdr, hdr_sz, 1UL, writer->file ) ) ) {
     FD_LOG_WARNING(( "fwrite file header failed (%d-%s)", errno, strerror( errno ) ));
     return NULL;
   }
 
-  if( FD_UNLIKELY( stream.bytes_written != fwrite( meta, 1UL, stream.bytes_written, writer->file ) ) ) {
-    FD_LOG_WARNING(( "fwrite file meta failed (%d-%s)", ferror( writer->file ), strerror( ferror( writer->file ) ) ));
-    return NULL;
-  }
-
-  /* Restore stream cursor */
-
-  if( FD_UNLIKELY( 0!=fseek( writer->file, cursor, SEEK_SET ) ) ) {
+  if( FD_UNLIKELY( 0!=fseek( writer->file, (long)( writer->stream_goff + writer->foff ), SEEK_SET ) ) ) {
     FD_LOG_WARNING(( "fseek failed (%d-%s)", errno, strerror( errno ) ));
     return NULL;
   }
@@ -287,29 +274,22 @@ fd_solcap_flush_account_table( fd_solcap_writer_t * writer ) {
     return 0;
   }
 
-  /* Leave space for header */
-
-  ulong chunk_goff = FTELL_BAIL( writer->file );
-  FSKIP_BAIL( writer->file, sizeof(fd_solcap_chunk_t) );
+  ulong chunk_foff = writer->foff;
 
   /* Translate account table to chunk-relative addressing */
 
   for( uint i=0U; i<writer->account_idx; i++ )
-    writer->accounts[i].acc_coff -= (long)chunk_goff;
+    writer->accounts[i].acc_coff -= (long)chunk_foff;
 
-  /* Write account table (at beginning of chunk) */
+  /* Account table goes at beginning of chunk */
 
   ulong account_table_coff = sizeof(fd_solcap_chunk_t);
   ulong account_table_cnt  = writer->account_idx;
-
-  FWRITE_BAIL( writer->accounts,
-               sizeof(fd_solcap_account_tbl_t),
-               account_table_cnt,
-               writer->file );
+  ulong account_table_sz   = account_table_cnt * sizeof(fd_solcap_account_tbl_t);
 
   /* Serialize account chunk metadata */
 
-  ulong meta_goff = FTELL_BAIL( writer->file );
+  ulong meta_coff = account_table_coff + account_table_sz;
   fd_solcap_AccountTableMeta meta = {
     .slot               = writer->slot,
     .account_table_coff = account_table_coff,
@@ -322,33 +302,30 @@ fd_solcap_flush_account_table( fd_solcap_writer_t * writer ) {
     FD_LOG_WARNING(( "pb_encode failed (%s)", PB_GET_ERROR(&stream) ));
     return EPROTO;
   }
+  ulong meta_sz = stream.bytes_written;
 
-  FWRITE_BAIL( encoded, 1UL,  stream.bytes_written, writer->file );
-  FALIGN_BAIL( writer->file, 8UL );
-
-  /* Serialize chunk header */
-
-  ulong chunk_end_goff = FTELL_BAIL( writer->file );
+  /* Write out chunk */
 
   fd_solcap_chunk_t chunk = {
     .magic     = FD_SOLCAP_V1_ACTB_MAGIC,
-    .meta_coff = (uint)( meta_goff - chunk_goff ),
-    .meta_sz   = (uint)stream.bytes_written,
-    .total_sz  = chunk_end_goff - chunk_goff
+    .meta_coff = (uint)meta_coff,
+    .meta_sz   = (uint)meta_sz,
+    .total_sz  = fd_ulong_align_up( meta_coff + meta_sz, 8UL )
   };
 
-  /* Write out chunk */
-
-  FSEEK_BAIL( writer->file, (long)chunk_goff, SEEK_SET );
-  FWRITE_BAIL( &chunk,  sizeof(fd_solcap_chunk_t), 1UL, writer->file );
-
-  /* Restore stream cursor */
+  fd_solcap_iov_t iov[4] = {
+    { &chunk,                sizeof(fd_solcap_chunk_t)            },
+    { writer->accounts,      account_table_sz                     },
+    { encoded,               meta_sz                              },
+    { fd_solcap_writer_zero, FD_SOLCAP_PAD( meta_coff + meta_sz ) }
+  };
+  int err = fd_solcap_writer_emit( writer, iov, 4UL );
+  if( FD_UNLIKELY( err==EIO ) ) return err;
 
-  FSEEK_BAIL( writer->file, (long)chunk_end_goff, SEEK_SET );
+  /* Wind up for next iteration.  A dropped table leaves the preimage
+     without an account table reference. */
 
-  /* Wind up for next iteration */
-
-  writer->account_table_goff = chunk_goff;
+  writer->account_table_foff = err ? 0UL : chunk_foff;
   writer->account_idx        = 0U;
 
   return 0;
@@ -389,21 +366,15 @@ fd_solcap_write_account2( fd_solcap_writer_t *             writer,
 
   if( FD_LIKELY( !writer ) ) return 0;
 
-  /* Locate chunk */
-
-  ulong chunk_goff = FTELL_BAIL( writer->file );
+  ulong chunk_foff = writer->foff;
 
-  /* Write data */
+  /* Data goes right after the chunk header, followed by metadata */
 
   ulong data_coff = sizeof(fd_solcap_chunk_t);
-  FSKIP_BAIL ( writer->file, data_coff );
-  FWRITE_BAIL( data, 1UL, data_sz, writer->file );
-  FALIGN_BAIL( writer->file, 8UL );
+  ulong meta_coff = fd_ulong_align_up( data_coff + data_sz, 8UL );
 
   /* Serialize account meta */
 
-  ulong meta_goff = FTELL_BAIL( writer->file );
-
   meta_pb->slot      = writer->slot;
   meta_pb->data_coff = (long)data_coff;
   meta_pb->data_sz   = data_sz;
@@ -411,12 +382,27 @@ fd_solcap_write_account2( fd_solcap_writer_t *             writer,
   uchar meta_pb_enc[ FD_SOLCAP_ACCOUNT_META_FOOTPRINT ];
   pb_ostream_t stream = pb_ostream_from_buffer( meta_pb_enc, sizeof(meta_pb_enc) );
   FD_TEST( pb_encode( &stream, fd_solcap_AccountMeta_fields, meta_pb ) );
+  ulong meta_sz = stream.bytes_written;
 
-  /* Write account meta */
+  /* Write out chunk */
 
-  ulong meta_coff = meta_goff - chunk_goff;
-  FWRITE_BAIL( meta_pb_enc, 1UL, stream.bytes_written, writer->file );
-  FALIGN_BAIL( writer->file, 8UL );
+  fd_solcap_chunk_t chunk = {
+    .magic     = FD_SOLCAP_V1_ACCT_MAGIC,
+    .meta_coff = (uint)meta_coff,
+    .meta_sz   = (uint)meta_sz,
+    .total_sz  = fd_ulong_align_up( meta_coff + meta_sz, 8UL )
+  };
+
+  fd_solcap_iov_t iov[5] = {
+    { &chunk,                sizeof(fd_solcap_chunk_t)            },
+    { data,                  data_sz                              },
+    { fd_solcap_writer_zero, FD_SOLCAP_PAD( data_coff + data_sz ) },
+    { meta_pb_enc,           meta_sz                              },
+    { fd_solcap_writer_zero, FD_SOLCAP_PAD( meta_coff + meta_sz ) }
+  };
+  int err = fd_solcap_writer_emit( writer, iov, 5UL );
+  if( FD_UNLIKELY( err==ENOBUFS ) ) return 0;  /* dropped, not in table */
+  if( FD_UNLIKELY( err ) ) return err;
 
   /* Remember account table entry */
 
@@ -425,31 +411,11 @@ fd_solcap_write_account2( fd_solcap_writer_t *             writer,
     *account = *tbl;
 
     /* Since we don't yet know the final position of the account table,
-       we temporarily store a global offset.  This will later get
+       we temporarily store a stream offset.  This will later get
        converted into a chunk offset. */
-    account->acc_coff = (long)chunk_goff;
+    account->acc_coff = (long)chunk_foff;
   }
 
-  /* Serialize chunk header */
-
-  ulong chunk_end_goff = FTELL_BAIL( writer->file );
-
-  fd_solcap_chunk_t chunk = {
-    .magic     = FD_SOLCAP_V1_ACCT_MAGIC,
-    .meta_coff = (uint)meta_coff,
-    .meta_sz   = (uint)stream.bytes_written,
-    .total_sz  = chunk_end_goff - chunk_goff
-  };
-
-  /* Write out chunk */
-
-  FSEEK_BAIL( writer->file, (long)chunk_goff, SEEK_SET );
-  FWRITE_BAIL( &chunk, sizeof(fd_solcap_chunk_t), 1UL, writer->file );
-
-  /* Restore stream cursor */
-
-  FSEEK_BAIL( writer->file, (long)chunk_end_goff, SEEK_SET );
-
   /* Wind up for next iteration */
 
   writer->account_idx += 1U;
@@ -464,7 +430,7 @@ fd_solcap_writer_set_slot( fd_solcap_writer_t * writer,
   if( FD_LIKELY( !writer ) ) return;
 
   /* Discard account table buffer */
-  writer->account_table_goff = 0UL;
+  writer->account_table_foff = 0UL;
   writer->account_idx        = 0UL;
   writer->slot               = slot;
 }
@@ -508,17 +474,14 @@ fd_solcap_write_bank_preimage2( fd_solcap_writer_t *     writer,
   int err = fd_solcap_flush_account_table( writer );
   if( FD_UNLIKELY( err!=0 ) ) return err;
 
-  /* Leave space for header */
-
-  ulong chunk_goff = FTELL_BAIL( writer->file );
-  FSKIP_BAIL( writer->file, sizeof(fd_solcap_chunk_t) );
+  ulong chunk_foff = writer->foff;
 
   /* Fixup predefined entries */
 
   preimage_pb->slot               = writer->slot;
-  if( writer->account_table_goff ) {
+  if( writer->account_table_foff ) {
     preimage_pb->account_cnt        = writer->account_idx;
-    preimage_pb->account_table_coff = (long)writer->account_table_goff - (long)chunk_goff;
+    preimage_pb->account_table_coff = (long)writer->account_table_foff - (long)chunk_foff;
   }
 
   /* Serialize bank preimage */
@@ -528,29 +491,22 @@ fd_solcap_write_bank_preimage2( fd_solcap_writer_t *     writer,
   FD_TEST( pb_encode( &stream, fd_solcap_BankPreimage_fields, preimage_pb ) );
   ulong meta_sz = stream.bytes_written;
 
-  FWRITE_BAIL( preimage_pb_enc, 1UL, meta_sz, writer->file );
-  FALIGN_BAIL( writer->file, 8UL );
-  ulong chunk_end_goff = FTELL_BAIL( writer->file );
-
-  /* Serialize chunk header */
+  /* Write out chunk */
 
   fd_solcap_chunk_t chunk = {
     .magic     = FD_SOLCAP_V1_BANK_MAGIC,
     .meta_coff = (uint)sizeof(fd_solcap_chunk_t),
     .meta_sz   = (uint)meta_sz,
-    .total_sz  = chunk_end_goff - chunk_goff
+    .total_sz  = sizeof(fd_solcap_chunk_t) + fd_ulong_align_up( meta_sz, 8UL )
   };
 
-  /* Write out chunk */
-
-  FSEEK_BAIL( writer->file, (long)chunk_goff, SEEK_SET );
-  FWRITE_BAIL( &chunk, sizeof(fd_solcap_chunk_t), 1UL, writer->file );
-
-  /* Restore stream cursor */
-
-  FSEEK_BAIL( writer->file, (long)chunk_end_goff, SEEK_SET );
-
-  return 0;
+  fd_solcap_iov_t iov[3] = {
+    { &chunk,                sizeof(fd_solcap_chunk_t) },
+    { preimage_pb_enc,       meta_sz                   },
+    { fd_solcap_writer_zero, FD_SOLCAP_PAD( meta_sz )  }
+  };
+  err = fd_solcap_writer_emit( writer, iov, 3UL );
+  return err==ENOBUFS ? 0 : err;
 }
 
 int fd_solcap_write_transaction2( fd_solcap_writer_t *    writer,
@@ -558,34 +514,25 @@ int fd_solcap_write_transaction2( fd_solcap_writer_t *    writer,
 
   if( FD_LIKELY( !writer ) ) return 0;
 
-  /* Locate chunk */
-  ulong chunk_goff = FTELL_BAIL( writer->file );
-  FSKIP_BAIL( writer->file, sizeof(fd_solcap_chunk_t) );
-
-  /* Serialize and write transaction */
+  /* Serialize transaction */
   uchar txn_pb_enc[ FD_SOLCAP_TRANSACTION_FOOTPRINT ];
   pb_ostream_t stream = pb_ostream_from_buffer( txn_pb_enc, sizeof(txn_pb_enc) );
   FD_TEST( pb_encode( &stream, fd_solcap_Transaction_fields, txn ) );
+  ulong meta_sz = stream.bytes_written;
 
-  FWRITE_BAIL( txn_pb_enc, 1UL, stream.bytes_written, writer->file );
-  FALIGN_BAIL( writer->file, 8UL );
-  ulong chunk_end_goff = FTELL_BAIL( writer->file );
-
-  /* Serialize chunk header */
+  /* Write out chunk */
   fd_solcap_chunk_t chunk = {
     .magic     = FD_SOLCAP_V1_TRXN_MAGIC,
     .meta_coff = (uint)sizeof(fd_solcap_chunk_t),
-    .meta_sz   = (uint)stream.bytes_written,
-    .total_sz  = chunk_end_goff - chunk_goff
+    .meta_sz   = (uint)meta_sz,
+    .total_sz  = sizeof(fd_solcap_chunk_t) + fd_ulong_align_up( meta_sz, 8UL )
   };
 
-  /* Write out chunk */
-  FSEEK_BAIL( writer->file, (long)chunk_goff, SEEK_SET );
-  FWRITE_BAIL( &chunk, sizeof(fd_solcap_chunk_t), 1UL, writer->file );
-
-  /* Restore stream cursor */
-
-  FSEEK_BAIL( writer->file, (long)chunk_end_goff, SEEK_SET );
-
-  return 0;
+  fd_solcap_iov_t iov[3] = {
+    { &chunk,                sizeof(fd_solcap_chunk_t) },
+    { txn_pb_enc,            meta_sz                   },
+    { fd_solcap_writer_zero, FD_SOLCAP_PAD( meta_sz )  }
+  };
+  int err = fd_solcap_writer_emit( writer, iov, 3UL );
+  return err==ENOBUFS ? 0 : err;
 }
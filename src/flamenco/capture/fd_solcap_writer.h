@@ -2,6 +2,7 @@
 #define HEADER_fd_src_flamenco_capture_fd_solcap_writer_h
 
 #include "fd_solcap_proto.h"
+#include "fd_solcap_ring.h"
 #include "fd_solcap.pb.h"
 #include "../types/fd_types.h"
 
@@ -62,6 +63,19 @@ fd_solcap_writer_t *
 fd_solcap_writer_init( fd_solcap_writer_t * writer,
                        void *               stream );
 
+/* fd_solcap_writer_init_ring initializes writer to publish a new
+   stream into the given ring instead of writing to a file.  Writes do
+   not block: chunks that do not fit into the ring are dropped (see
+   fd_solcap_ring_t), and dropped accounts are left out of the
+   slot's account table.  The consumer of the ring is responsible for
+   writing the file header (posted to the ring by
+   fd_solcap_writer_flush) and the stream.  Returns writer on success.
+   On failure, logs reason and returns NULL. */
+
+fd_solcap_writer_t *
+fd_solcap_writer_init_ring( fd_solcap_writer_t * writer,
+                            fd_solcap_ring_t *   ring );
+
 /* fd_solcap_writer_flush finishes any outstanding writes and yields
    ownership of the stream handle back to the caller of init. Always returns
    writer for convenience. If an error occurs, writes reason to log. */
@@ -33,6 +33,12 @@ fd_solcap_writer_init( fd_solcap_writer_t * writer,
   return writer;
 }
 
+fd_solcap_writer_t *
+fd_solcap_writer_init_ring( fd_solcap_writer_t * writer,
+                            fd_solcap_ring_t *   ring FD_PARAM_UNUSED ) {
+  return writer;
+}
+
 fd_solcap_writer_t *
 fd_solcap_writer_flush( fd_solcap_writer_t * writer ) {
   return writer;
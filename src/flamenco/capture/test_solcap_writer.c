@@ -0,0 +1,286 @@
+#include "fd_solcap_writer.h"
+#include "fd_solcap_reader.h"
+#include "../../ballet/nanopb/pb_decode.h"
+
+#include <stdio.h>
+#if FD_HAS_THREADS
+#include <pthread.h>
+#endif
+
+static uchar writer_mem[ 1UL<<20 ] __attribute__((aligned(64)));
+static uchar ring_mem  [ 1UL<<16 ] __attribute__((aligned(FD_SOLCAP_RING_ALIGN)));
+
+#define SLOT     (1000UL)
+#define ACCT_CNT (3UL)
+
+static uchar acct_data[ ACCT_CNT ][ 3008 ];
+
+/* write_slot captures one slot with ACCT_CNT accounts.  Account i has
+   i*1500+5 bytes of data. */
+
+static void
+write_slot( fd_solcap_writer_t * writer ) {
+  fd_solcap_writer_set_slot( writer, SLOT );
+  for( ulong i=0UL; i<ACCT_CNT; i++ ) {
+    uchar key [ 32 ]; memset( key,  (int)i,      32UL );
+    uchar hash[ 32 ]; memset( hash, (int)(i+16), 32UL );
+    fd_solana_account_meta_t meta = { .lamports = i+1UL, .rent_epoch = ULONG_MAX };
+    memset( meta.owner, 0x42, 32UL );
+    FD_TEST( !fd_solcap_write_account( writer, key, &meta, acct_data[ i ], i*1500UL+5UL, hash ) );
+  }
+  uchar bank_hash[ 32 ]; memset( bank_hash, 0xbb, 32UL );
+  uchar zero     [ 32 ] = {0};
+  FD_TEST( !fd_solcap_write_bank_preimage( writer, bank_hash, zero, NULL, zero, zero, 7UL ) );
+  FD_TEST( fd_solcap_writer_flush( writer ) );
+}
+
+/* drain emulates the solcap tile: reserve the file header, append the
+   ring contents, then rewrite the posted file header. */
+
+static void
+drain( fd_solcap_ring_t * ring,
+       FILE *             file,
+       ulong *            fhdr_ver ) {
+  uchar const * data;
+  ulong         sz;
+  while( (sz = fd_solcap_ring_peek( ring, &data, ULONG_MAX )) ) {
+    FD_TEST( 1UL==fwrite( data, sz, 1UL, file ) );
+    fd_solcap_ring_consume( ring, sz );
+  }
+  uchar fhdr[ FD_SOLCAP_FHDR_SZ ];
+  if( fd_solcap_ring_fhdr_query( ring, fhdr_ver, fhdr ) ) {
+    long cursor = ftell( file );
+    FD_TEST( !fseek( file, 0L, SEEK_SET ) );
+    FD_TEST( 1UL==fwrite( fhdr, FD_SOLCAP_FHDR_SZ, 1UL, file ) );
+    FD_TEST( !fseek( file, cursor, SEEK_SET ) );
+  }
+}
+
+/* verify reads back the capture using fd_solcap_reader and returns the
+   number of accounts in the account table.  Every account in the table
+   must have matching contents. */
+
+static ulong
+verify( FILE * file ) {
+  FD_TEST( !fflush( file ) );
+  FD_TEST( !fseek( file, 0L, SEEK_SET ) );
+
+  fd_solcap_fhdr_t fhdr[1];
+  FD_TEST( 1UL==fread( fhdr, sizeof(fd_solcap_fhdr_t), 1UL, file ) );
+  FD_TEST( fhdr->magic==FD_SOLCAP_V1_FILE_MAGIC );
+  FD_TEST( fhdr->chunk0_foff==FD_SOLCAP_FHDR_SZ );
+
+  uchar meta_buf[ FD_SOLCAP_FHDR_SZ ];
+  FD_TEST( fhdr->meta_sz<=sizeof(meta_buf) );
+  FD_TEST( fhdr->meta_sz==fread( meta_buf, 1UL, fhdr->meta_sz, file ) );
+  fd_solcap_FileMeta fmeta = fd_solcap_FileMeta_init_zero;
+  pb_istream_t stream = pb_istream_from_buffer( meta_buf, fhdr->meta_sz );
+  FD_TEST( pb_decode( &stream, fd_solcap_FileMeta_fields, &fmeta ) );
+  FD_TEST( fmeta.main_block_magic==FD_SOLCAP_V1_BANK_MAGIC );
+
+  FD_TEST( !fseek( file, (long)fhdr->chunk0_foff, SEEK_SET ) );
+  fd_solcap_chunk_iter_t iter[1];
+  fd_solcap_chunk_iter_new( iter, file );
+  long chunk_goff = fd_solcap_chunk_iter_find( iter, FD_SOLCAP_V1_BANK_MAGIC );
+  FD_TEST( chunk_goff>=0L );
+
+  fd_solcap_BankPreimage preimage[1] = {{0}};
+  FD_TEST( !fd_solcap_read_bank_preimage( file, (ulong)chunk_goff, preimage, fd_solcap_chunk_iter_item( iter ) ) );
+  FD_TEST( preimage->slot==SLOT );
+  FD_TEST( preimage->signature_cnt==7UL );
+  FD_TEST( preimage->bank_hash[0]==0xbb );
+  if( !preimage->account_table_coff ) return 0UL;
+
+  ulong tbl_goff = (ulong)( chunk_goff + preimage->account_table_coff );
+  fd_solcap_AccountTableMeta tbl_meta[1];
+  FD_TEST( !fd_solcap_find_account_table( file, tbl_meta, tbl_goff ) );
+  FD_TEST( tbl_meta->slot==SLOT );
+
+  fd_solcap_account_tbl_t tbl[ ACCT_CNT ];
+  FD_TEST( tbl_meta->account_table_cnt<=ACCT_CNT );
+  FD_TEST( tbl_meta->account_table_cnt==fread( tbl, sizeof(fd_solcap_account_tbl_t), tbl_meta->account_table_cnt, file ) );
+
+  for( ulong j=0UL; j<tbl_meta->account_table_cnt; j++ ) {
+    ulong i = tbl[ j ].key[ 0 ];
+    FD_TEST( i<ACCT_CNT );
+    FD_TEST( tbl[ j ].hash[ 0 ]==i+16UL );
+
+    fd_solcap_AccountMeta meta[1];
+    ulong data_off = 0UL;
+    FD_TEST( !fd_solcap_find_account( file, meta, &data_off, &tbl[ j ], tbl_goff ) );
+    FD_TEST( meta->slot==SLOT );
+    FD_TEST( meta->lamports==i+1UL );
+    FD_TEST( meta->data_sz==i*1500UL+5UL );
+    FD_TEST( fd_solcap_includes_account_data( meta ) );
+
+    uchar data[ 3008 ];
+    FD_TEST( !fseek( file, (long)data_off, SEEK_SET ) );
+    FD_TEST( meta->data_sz==fread( data, 1UL, meta->data_sz, file ) );
+    FD_TEST( fd_memeq( data, acct_data[ i ], meta->data_sz ) );
+  }
+  return tbl_meta->account_table_cnt;
+}
+
+#if FD_HAS_THREADS
+
+/* halt_consumer emulates the solcap tile's halt path: only write out
+   the ring when asked to, then acknowledge. */
+
+struct halt_consumer_args {
+  fd_solcap_ring_t * ring;
+  FILE *             file;
+  ulong              fhdr_ver;
+  int                stop;
+};
+
+static void *
+halt_consumer( void * _args ) {
+  struct halt_consumer_args * args = _args;
+  while( !FD_VOLATILE_CONST( args->stop ) ) {
+    ulong req = fd_solcap_ring_halt_query( args->ring );
+    if( !req ) { FD_SPIN_PAUSE(); continue; }
+    drain( args->ring, args->file, &args->fhdr_ver );
+    fd_solcap_ring_halt_ack( args->ring, req );
+  }
+  return NULL;
+}
+
+#endif /* FD_HAS_THREADS */
+
+static ulong
+file_sz( FILE * file ) {
+  FD_TEST( !fseek( file, 0L, SEEK_END ) );
+  return (ulong)ftell( file );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong i=0UL; i<ACCT_CNT; i++ )
+    for( ulong j=0UL; j<sizeof(acct_data[i]); j++ ) acct_data[ i ][ j ] = fd_rng_uchar( rng );
+
+  FD_TEST( fd_solcap_writer_footprint()<=sizeof(writer_mem) );
+
+  /* Synchronous stdio writer */
+
+  FILE * sync_file = tmpfile();
+  FD_TEST( sync_file );
+  fd_solcap_writer_t * writer = fd_solcap_writer_new( writer_mem );
+  FD_TEST( fd_solcap_writer_init( writer, sync_file ) );
+  write_slot( writer );
+  FD_TEST( verify( sync_file )==ACCT_CNT );
+  fd_solcap_writer_delete( writer );
+
+  /* Ring writer produces the same bytes */
+
+  FD_TEST( !fd_solcap_ring_footprint( 1000UL ) );
+  FD_TEST( !fd_solcap_ring_footprint( 128UL  ) );
+
+  ulong depth = 1UL<<15;
+  FD_TEST( fd_solcap_ring_footprint( depth )<=sizeof(ring_mem) );
+  fd_solcap_ring_t * ring = fd_solcap_ring_join( fd_solcap_ring_new( ring_mem, depth ) );
+  FD_TEST( ring );
+
+  FILE * ring_file = tmpfile();
+  FD_TEST( ring_file );
+  uchar zero[ FD_SOLCAP_FHDR_SZ ] = {0};
+  FD_TEST( 1UL==fwrite( zero, FD_SOLCAP_FHDR_SZ, 1UL, ring_file ) );
+  ulong fhdr_ver = 0UL;
+
+  writer = fd_solcap_writer_new( writer_mem );
+  FD_TEST( fd_solcap_writer_init_ring( writer, ring ) );
+  write_slot( writer );
+  FD_TEST( ring->drop_cnt==0UL );
+  FD_TEST( ring->pub_cnt==ACCT_CNT+2UL );
+  drain( ring, ring_file, &fhdr_ver );
+  FD_TEST( fhdr_ver==2UL );
+  FD_TEST( verify( ring_file )==ACCT_CNT );
+
+  ulong sz = file_sz( sync_file );
+  FD_TEST( file_sz( ring_file )==sz );
+  FD_TEST( !fseek( sync_file, 0L, SEEK_SET ) );
+  FD_TEST( !fseek( ring_file, 0L, SEEK_SET ) );
+  for( ulong off=0UL; off<sz; off++ ) FD_TEST( fgetc( sync_file )==fgetc( ring_file ) );
+  fd_solcap_writer_delete( writer );
+  fclose( ring_file );
+
+  /* Backpressure: account 2 (3005 bytes) does not fit behind accounts
+     0 and 1 in a 4 KiB ring.  It is dropped, counted and left out of
+     the account table, while the rest of the capture stays intact. */
+
+  depth = 1UL<<12;
+  ring = fd_solcap_ring_join( fd_solcap_ring_new( fd_solcap_ring_delete( fd_solcap_ring_leave( ring ) ), depth ) );
+  FD_TEST( ring );
+  ring_file = tmpfile();
+  FD_TEST( ring_file );
+  FD_TEST( 1UL==fwrite( zero, FD_SOLCAP_FHDR_SZ, 1UL, ring_file ) );
+  fhdr_ver = 0UL;
+
+  writer = fd_solcap_writer_new( writer_mem );
+  FD_TEST( fd_solcap_writer_init_ring( writer, ring ) );
+  write_slot( writer );
+  FD_TEST( ring->drop_cnt==1UL );
+  FD_TEST( ring->pub_cnt==ACCT_CNT+1UL );
+  drain( ring, ring_file, &fhdr_ver );
+  FD_TEST( verify( ring_file )==ACCT_CNT-1UL );
+
+  /* Ring wraps around once drained */
+
+  write_slot( writer );
+  drain( ring, ring_file, &fhdr_ver );
+  FD_TEST( ring->prod>depth );
+  FD_TEST( ring->prod==ring->cons );
+
+  fd_solcap_writer_delete( writer );
+  fclose( ring_file );
+
+  /* Halt: the capture is complete on disk once fd_solcap_ring_halt
+     returns, without waiting for the consumer's periodic flush */
+
+# if FD_HAS_THREADS
+  depth = 1UL<<15;
+  ring = fd_solcap_ring_join( fd_solcap_ring_new( fd_solcap_ring_delete( fd_solcap_ring_leave( ring ) ), depth ) );
+  FD_TEST( ring );
+  FD_TEST( !fd_solcap_ring_halt_query( ring ) );
+  FD_TEST( !fd_solcap_ring_halt( ring, 0L ) ); /* no consumer, times out */
+  FD_TEST( fd_solcap_ring_halt_query( ring )==1UL );
+  fd_solcap_ring_halt_ack( ring, 1UL );
+  FD_TEST( !fd_solcap_ring_halt_query( ring ) );
+
+  ring_file = tmpfile();
+  FD_TEST( ring_file );
+  FD_TEST( 1UL==fwrite( zero, FD_SOLCAP_FHDR_SZ, 1UL, ring_file ) );
+
+  struct halt_consumer_args args = { .ring = ring, .file = ring_file };
+  pthread_t consumer;
+  FD_TEST( !pthread_create( &consumer, NULL, halt_consumer, &args ) );
+
+  writer = fd_solcap_writer_new( writer_mem );
+  FD_TEST( fd_solcap_writer_init_ring( writer, ring ) );
+  write_slot( writer );
+  FD_TEST( fd_solcap_ring_halt( ring, (long)5e9 ) );
+  FD_TEST( ring->prod==ring->cons );
+  FD_TEST( !fd_solcap_ring_halt_query( ring ) );
+
+  FD_VOLATILE( args.stop ) = 1;
+  FD_TEST( !pthread_join( consumer, NULL ) );
+  FD_TEST( args.fhdr_ver==2UL );
+  FD_TEST( verify( ring_file )==ACCT_CNT );
+  FD_TEST( file_sz( ring_file )==sz );
+
+  fd_solcap_writer_delete( writer );
+  fclose( ring_file );
+# endif
+
+  fclose( sync_file );
+  FD_TEST( fd_solcap_ring_delete( fd_solcap_ring_leave( ring ) )==ring_mem );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,376 @@
+#define FD_SCRATCH_USE_HANDHOLDING 1
+#include "fd_genesis_synth.h"
+
+#include "../runtime/fd_system_ids.h"
+#include "../runtime/program/fd_stake_program.h"
+#include "../runtime/program/fd_vote_program.h"
+#include "../runtime/sysvar/fd_sysvar_rent.h"
+#include "../../ballet/sha256/fd_sha256.h"
+
+#include <math.h>
+
+/* Synthetic addresses are derived from (seed,kind,j).  Besides the
+   account kinds, a few kinds of addresses are only referenced. */
+
+#define KEY_IDENTITY (16UL) /* node identity of synthetic vote account j */
+#define KEY_OWNER    (17UL) /* synthetic program j owning data accounts */
+#define KEY_WALLET   (18UL) /* token account owner / stake authority j */
+
+#define ACCT_HDR_SZ   (32UL+8UL+8UL)     /* key, lamports, data_len */
+#define ACCT_TRL_SZ   (32UL+1UL+8UL)     /* owner, executable, rent_epoch */
+#define SPL_MINT_SZ   (82UL)
+#define SPL_TOKEN_SZ  (165UL)
+
+/* VOTERS_MEM_SZ bounds the memory used to encode the (single entry)
+   authorized voters of a vote account. */
+
+#define VOTERS_MEM_SZ (1024UL)
+
+static void
+synth_key( fd_genesis_synth_t const * synth,
+           ulong                      kind,
+           ulong                      j,
+           fd_pubkey_t *              key ) {
+  ulong msg[ 3 ] = { synth->opts.seed, kind, j };
+  fd_sha256_hash( msg, sizeof(msg), key->uc );
+}
+
+static void
+wallet_key( fd_genesis_synth_t const * synth,
+            ulong                      j,
+            fd_pubkey_t *              key ) {
+  /* Prefer funded system accounts as owners, like real wallets */
+  if( synth->opts.system_cnt ) synth_key( synth, FD_GENESIS_SYNTH_KIND_SYSTEM, j % synth->opts.system_cnt, key );
+  else                         synth_key( synth, KEY_WALLET,                   j,                          key );
+}
+
+static inline fd_rng_t *
+acct_rng( fd_genesis_synth_t const * synth,
+          ulong                      idx,
+          fd_rng_t *                 _rng ) {
+  /* Every account gets its own 2^32 long stream */
+  return fd_rng_join( fd_rng_new( _rng, (uint)fd_ulong_hash( synth->opts.seed ), idx<<32 ) );
+}
+
+/* skew_roll returns a value in [0,n) where small values are much more
+   likely than large ones, such that a few validators hold most of the
+   stake and a few mints most of the token accounts. */
+
+static inline ulong
+skew_roll( fd_rng_t * rng,
+           ulong      n ) {
+  double u = fd_rng_double_c0( rng );
+  return fd_ulong_min( (ulong)( (double)n * u*u*u ), n-1UL );
+}
+
+static inline ulong
+acct_kind( fd_genesis_synth_t const * synth,
+           ulong                      idx ) {
+  ulong kind = 0UL;
+  while( idx>=synth->kind_idx0[ kind+1UL ] ) kind++;
+  return kind;
+}
+
+/* data_sz returns the data size of the data account with the given
+   rng (it must be the first draw of the account's stream). */
+
+static ulong
+data_sz( fd_genesis_synth_t const * synth,
+         fd_rng_t *                 rng ) {
+  double lo = log( (double)synth->opts.data_sz_min + 1.0 );
+  double hi = log( (double)synth->opts.data_sz_max + 1.0 );
+  ulong  sz = (ulong)exp( lo + (hi-lo)*fd_rng_double_c0( rng ) ) - 1UL;
+  return fd_ulong_min( fd_ulong_max( sz, synth->opts.data_sz_min ), synth->opts.data_sz_max );
+}
+
+static ulong
+kind_data_sz( fd_genesis_synth_t const * synth,
+              ulong                      kind,
+              ulong                      idx ) {
+  switch( kind ) {
+  case FD_GENESIS_SYNTH_KIND_VOTE:  return FD_VOTE_STATE_V3_SZ;
+  case FD_GENESIS_SYNTH_KIND_STAKE: return FD_STAKE_STATE_V2_SZ;
+  case FD_GENESIS_SYNTH_KIND_MINT:  return SPL_MINT_SZ;
+  case FD_GENESIS_SYNTH_KIND_TOKEN: return SPL_TOKEN_SZ;
+  case FD_GENESIS_SYNTH_KIND_DATA: {
+    fd_rng_t _rng[1];
+    return data_sz( synth, acct_rng( synth, idx, _rng ) );
+  }
+  default: return 0UL;
+  }
+}
+
+fd_genesis_synth_t *
+fd_genesis_synth_init( fd_genesis_synth_t *               synth,
+                       fd_genesis_synth_options_t const * opts,
+                       uchar const *                      base,
+                       ulong                              base_sz ) {
+  if( FD_UNLIKELY( !synth || !opts || !base ) ) {
+    FD_LOG_WARNING(( "NULL synth, opts or base" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( opts->validator_cnt>FD_GENESIS_SYNTH_VALIDATOR_MAX ) ) {
+    FD_LOG_WARNING(( "too many validators (%lu), the genesis loader supports at most %lu", opts->validator_cnt, FD_GENESIS_SYNTH_VALIDATOR_MAX ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( opts->stake_cnt>FD_GENESIS_SYNTH_STAKE_MAX ) ) {
+    FD_LOG_WARNING(( "too many stake accounts (%lu), the genesis loader supports at most %lu", opts->stake_cnt, FD_GENESIS_SYNTH_STAKE_MAX ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( opts->stake_cnt && (!opts->validator_cnt || !opts->stake_lamports) ) ) {
+    FD_LOG_WARNING(( "stake accounts need validators and a non-zero stake" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( opts->token_cnt && !opts->mint_cnt ) ) {
+    FD_LOG_WARNING(( "token accounts need mints" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( opts->data_cnt && ( !opts->owner_cnt ||
+                                       opts->data_sz_min>opts->data_sz_max ||
+                                       opts->data_sz_max>FD_GENESIS_SYNTH_DATA_SZ_MAX ) ) ) {
+    FD_LOG_WARNING(( "bad data account options (owner_cnt=%lu data_sz_min=%lu data_sz_max=%lu)",
+                     opts->owner_cnt, opts->data_sz_min, opts->data_sz_max ));
+    return NULL;
+  }
+
+  memset( synth, 0, sizeof(fd_genesis_synth_t) );
+  synth->opts    = *opts;
+  synth->base_sz = base_sz;
+
+  /* Decode the base genesis to find its accounts vector and rent */
+
+  int ok = 0;
+  FD_SCRATCH_SCOPE_BEGIN {
+    int err;
+    fd_genesis_solana_t * genesis = fd_bincode_decode_scratch( genesis_solana, base, base_sz, &err );
+    if( FD_LIKELY( genesis ) ) {
+      ulong off = sizeof(ulong); /* creation_time */
+      synth->cnt_off = off;
+      off += sizeof(ulong);
+      for( ulong i=0UL; i<genesis->accounts_len; i++ ) off += fd_pubkey_account_pair_size( &genesis->accounts[ i ] );
+      synth->acct_end_off  = off;
+      synth->base_acct_cnt = genesis->accounts_len;
+      synth->rent          = genesis->rent;
+      ok = 1;
+    } else {
+      FD_LOG_WARNING(( "failed to decode base genesis (%d)", err ));
+    }
+  } FD_SCRATCH_SCOPE_END;
+  if( FD_UNLIKELY( !ok ) ) return NULL;
+  FD_TEST( synth->acct_end_off<=base_sz && FD_LOAD( ulong, base+synth->cnt_off )==synth->base_acct_cnt );
+
+  ulong kind_cnt[ FD_GENESIS_SYNTH_KIND_CNT ] = {
+    [ FD_GENESIS_SYNTH_KIND_VOTE   ] = opts->validator_cnt,
+    [ FD_GENESIS_SYNTH_KIND_STAKE  ] = opts->stake_cnt,
+    [ FD_GENESIS_SYNTH_KIND_MINT   ] = opts->mint_cnt,
+    [ FD_GENESIS_SYNTH_KIND_TOKEN  ] = opts->token_cnt,
+    [ FD_GENESIS_SYNTH_KIND_DATA   ] = opts->data_cnt,
+    [ FD_GENESIS_SYNTH_KIND_SYSTEM ] = opts->system_cnt,
+  };
+  for( ulong kind=0UL; kind<FD_GENESIS_SYNTH_KIND_CNT; kind++ ) {
+    synth->kind_idx0[ kind+1UL ] = synth->kind_idx0[ kind ] + kind_cnt[ kind ];
+  }
+  synth->acct_cnt = synth->kind_idx0[ FD_GENESIS_SYNTH_KIND_CNT ];
+
+  FD_TEST( fd_ulong_align_up( fd_vote_authorized_voters_pool_footprint( 1UL ), fd_vote_authorized_voters_treap_align() ) +
+           fd_vote_authorized_voters_treap_footprint( 1UL )<=VOTERS_MEM_SZ );
+  return synth;
+}
+
+ulong
+fd_genesis_synth_acct_sz_max( fd_genesis_synth_t const * synth ) {
+  ulong sz = fd_ulong_max( fd_ulong_max( FD_VOTE_STATE_V3_SZ, FD_STAKE_STATE_V2_SZ ), SPL_TOKEN_SZ );
+  if( synth->opts.data_cnt ) sz = fd_ulong_max( sz, synth->opts.data_sz_max );
+  return ACCT_HDR_SZ + sz + ACCT_TRL_SZ;
+}
+
+ulong
+fd_genesis_synth_acct_sz( fd_genesis_synth_t const * synth,
+                          ulong                      idx ) {
+  return ACCT_HDR_SZ + kind_data_sz( synth, acct_kind( synth, idx ), idx ) + ACCT_TRL_SZ;
+}
+
+ulong
+fd_genesis_synth_range_sz( fd_genesis_synth_t const * synth,
+                           ulong                      idx0,
+                           ulong                      idx1 ) {
+  ulong sz = 0UL;
+  for( ulong kind=0UL; kind<FD_GENESIS_SYNTH_KIND_CNT; kind++ ) {
+    ulong i0 = fd_ulong_max( idx0, synth->kind_idx0[ kind     ] );
+    ulong i1 = fd_ulong_min( idx1, synth->kind_idx0[ kind+1UL ] );
+    if( i0>=i1 ) continue;
+    sz += (i1-i0)*(ACCT_HDR_SZ+ACCT_TRL_SZ);
+    if( kind==FD_GENESIS_SYNTH_KIND_DATA ) for( ulong i=i0; i<i1; i++ ) sz += kind_data_sz( synth, kind, i );
+    else                                   sz += (i1-i0)*kind_data_sz( synth, kind, i0 );
+  }
+  return sz;
+}
+
+ulong
+fd_genesis_synth_blob_sz( fd_genesis_synth_t const * synth ) {
+  return synth->base_sz + fd_genesis_synth_range_sz( synth, 0UL, synth->acct_cnt );
+}
+
+static void
+vote_data( fd_genesis_synth_t const * synth,
+           ulong                      j,
+           uchar *                    data ) {
+  fd_pubkey_t identity;
+  synth_key( synth, KEY_IDENTITY, j, &identity );
+
+  fd_vote_state_versioned_t vsv[1];
+  fd_vote_state_versioned_new_disc( vsv, fd_vote_state_versioned_enum_current );
+
+  fd_vote_state_t * vs = &vsv->inner.current;
+  vs->node_pubkey           = identity;
+  vs->authorized_withdrawer = identity;
+  vs->commission            = (uchar)( j%11UL ? 5 : 100 );
+
+  uchar voters_mem[ VOTERS_MEM_SZ ] __attribute__((aligned(128)));
+  uchar * treap_mem = (uchar *)fd_ulong_align_up( (ulong)voters_mem + fd_vote_authorized_voters_pool_footprint( 1UL ),
+                                                  fd_vote_authorized_voters_treap_align() );
+  vs->authorized_voters.pool  = fd_vote_authorized_voters_pool_join( fd_vote_authorized_voters_pool_new( voters_mem, 1UL ) );
+  vs->authorized_voters.treap = fd_vote_authorized_voters_treap_join( fd_vote_authorized_voters_treap_new( treap_mem, 1UL ) );
+
+  fd_vote_authorized_voter_t * ele = fd_vote_authorized_voters_pool_ele_acquire( vs->authorized_voters.pool );
+  *ele = (fd_vote_authorized_voter_t) {
+    .epoch  = 0UL,
+    .pubkey = identity,
+    .prio   = identity.ul[0],
+  };
+  fd_vote_authorized_voters_treap_ele_insert( vs->authorized_voters.treap, ele, vs->authorized_voters.pool );
+
+  fd_bincode_encode_ctx_t encode = { .data = data, .dataend = data + FD_VOTE_STATE_V3_SZ };
+  FD_TEST( fd_vote_state_versioned_encode( vsv, &encode )==FD_BINCODE_SUCCESS );
+}
+
+static void
+stake_data( fd_genesis_synth_t const * synth,
+            fd_rng_t *                 rng,
+            uchar *                    data ) {
+  fd_pubkey_t authority;
+  wallet_key( synth, fd_rng_ulong( rng ), &authority );
+
+  fd_stake_state_v2_t state[1];
+  fd_stake_state_v2_new_disc( state, fd_stake_state_v2_enum_stake );
+  fd_stake_state_v2_stake_t * stake = &state->inner.stake;
+  stake->meta = (fd_stake_meta_t) {
+    .rent_exempt_reserve = fd_rent_exempt_minimum_balance( &synth->rent, FD_STAKE_STATE_V2_SZ ),
+    .authorized = {
+      .staker     = authority,
+      .withdrawer = authority,
+    }
+  };
+  fd_pubkey_t voter;
+  synth_key( synth, FD_GENESIS_SYNTH_KIND_VOTE, skew_roll( rng, synth->opts.validator_cnt ), &voter );
+  stake->stake = (fd_stake_t) {
+    .delegation = (fd_delegation_t) {
+      .voter_pubkey       = voter,
+      .stake              = synth->opts.stake_lamports,
+      .activation_epoch   = ULONG_MAX, /* active at genesis, like the bootstrap stake */
+      .deactivation_epoch = ULONG_MAX
+    }
+  };
+
+  fd_bincode_encode_ctx_t encode = { .data = data, .dataend = data + FD_STAKE_STATE_V2_SZ };
+  FD_TEST( fd_stake_state_v2_encode( state, &encode )==FD_BINCODE_SUCCESS );
+}
+
+/* mint_data and token_data write SPL token Mint and Account states. */
+
+static void
+mint_data( fd_genesis_synth_t const * synth,
+           fd_rng_t *                 rng,
+           uchar *                    data ) {
+  fd_pubkey_t authority;
+  wallet_key( synth, fd_rng_ulong( rng ), &authority );
+  FD_STORE( uint,  data,      1U                         ); /* mint_authority: Some */
+  memcpy(          data+4UL,  authority.uc, 32UL         );
+  FD_STORE( ulong, data+36UL, fd_rng_ulong( rng )>>8     ); /* supply */
+  data[ 44 ] = (uchar)( fd_rng_uint_roll( rng, 2U ) ? 6 : 9 ); /* decimals */
+  data[ 45 ] = 1;                                           /* is_initialized */
+  FD_STORE( uint,  data+46UL, 0U                         ); /* freeze_authority: None */
+}
+
+static void
+token_data( fd_genesis_synth_t const * synth,
+            fd_rng_t *                 rng,
+            uchar *                    data ) {
+  fd_pubkey_t mint, owner;
+  synth_key( synth, FD_GENESIS_SYNTH_KIND_MINT, skew_roll( rng, synth->opts.mint_cnt ), &mint );
+  wallet_key( synth, fd_rng_ulong( rng ), &owner );
+  memcpy(          data,       mint.uc,  32UL             );
+  memcpy(          data+32UL,  owner.uc, 32UL             );
+  FD_STORE( ulong, data+64UL,  fd_rng_ulong( rng )>>24    ); /* amount */
+  FD_STORE( uint,  data+72UL,  0U                         ); /* delegate: None */
+  data[ 108 ] = 1;                                           /* state: Initialized */
+  FD_STORE( uint,  data+109UL, 0U                         ); /* is_native: None */
+  FD_STORE( ulong, data+121UL, 0UL                        ); /* delegated_amount */
+  FD_STORE( uint,  data+129UL, 0U                         ); /* close_authority: None */
+}
+
+ulong
+fd_genesis_synth_acct( fd_genesis_synth_t const * synth,
+                       ulong                      idx,
+                       uchar *                    buf ) {
+  ulong kind = acct_kind( synth, idx );
+  ulong j    = idx - synth->kind_idx0[ kind ];
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = acct_rng( synth, idx, _rng );
+
+  /* data_sz must be the first draw for data accounts (see
+     kind_data_sz) */
+
+  ulong sz = kind==FD_GENESIS_SYNTH_KIND_DATA ? data_sz( synth, rng ) : kind_data_sz( synth, kind, idx );
+
+  uchar * data = buf + ACCT_HDR_SZ;
+  fd_memset( data, 0, sz );
+
+  fd_pubkey_t owner;
+  ulong       lamports = fd_rent_exempt_minimum_balance( &synth->rent, sz );
+  switch( kind ) {
+  case FD_GENESIS_SYNTH_KIND_VOTE:
+    vote_data( synth, j, data );
+    owner = fd_solana_vote_program_id;
+    break;
+  case FD_GENESIS_SYNTH_KIND_STAKE:
+    stake_data( synth, rng, data );
+    owner     = fd_solana_stake_program_id;
+    lamports += synth->opts.stake_lamports;
+    break;
+  case FD_GENESIS_SYNTH_KIND_MINT:
+    mint_data( synth, rng, data );
+    owner = fd_solana_spl_token_id;
+    break;
+  case FD_GENESIS_SYNTH_KIND_TOKEN:
+    token_data( synth, rng, data );
+    owner = fd_solana_spl_token_id;
+    break;
+  case FD_GENESIS_SYNTH_KIND_DATA: {
+    synth_key( synth, KEY_OWNER, skew_roll( rng, synth->opts.owner_cnt ), &owner );
+    ulong i = 0UL;
+    for( ; i+8UL<=sz; i+=8UL ) FD_STORE( ulong, data+i, fd_rng_ulong( rng ) );
+    for( ; i<sz;      i++    ) data[ i ] = fd_rng_uchar( rng );
+    break;
+  }
+  default:
+    owner    = fd_solana_system_program_id;
+    lamports = 1000000000UL*( 1UL+fd_rng_ulong_roll( rng, 1000UL ) ); /* 1 to 1000 SOL */
+    break;
+  }
+
+  /* Bincode encoding of fd_pubkey_account_pair_t */
+
+  fd_pubkey_t key;
+  synth_key( synth, kind, j, &key );
+  memcpy(          buf,          key.uc,   32UL );
+  FD_STORE( ulong, buf+32UL,     lamports       );
+  FD_STORE( ulong, buf+40UL,     sz             );
+  uchar * trl = data + sz;
+  memcpy(          trl,          owner.uc, 32UL );
+  trl[ 32 ] = 0;                                  /* executable */
+  FD_STORE( ulong, trl+33UL,     0UL            ); /* rent_epoch */
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return ACCT_HDR_SZ + sz + ACCT_TRL_SZ;
+}
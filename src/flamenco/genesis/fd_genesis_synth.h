@@ -0,0 +1,147 @@
+#ifndef HEADER_fd_src_flamenco_genesis_fd_genesis_synth_h
+#define HEADER_fd_src_flamenco_genesis_fd_genesis_synth_h
+
+/* fd_genesis_synth extends a genesis blob created by fd_genesis_create
+   with a large synthetic account state, such that benchmarks of a
+   development cluster run against an account database that is closer
+   in size and shape to mainnet than a handful of funded accounts.
+
+   The synthetic accounts are appended to the accounts vector of the
+   genesis blob.  They are generated deterministically from a seed and
+   their index, so that any range of accounts can be generated
+   independently of the others, e.g. by multiple threads writing
+   disjoint regions of the output file.  The synthetic accounts are
+   numbered [0,acct_cnt) and ordered by kind:
+
+     vote    validator_cnt vote accounts, with synthetic node identities
+     stake   stake_cnt stake accounts, delegated to the synthetic vote
+             accounts with a skewed (few large, many small) distribution
+     mint    mint_cnt SPL token mints
+     token   token_cnt SPL token accounts over the mints (skewed)
+     data    data_cnt accounts of random data owned by one of owner_cnt
+             synthetic programs, with sizes log-uniformly distributed
+             in [data_sz_min,data_sz_max]
+     system  system_cnt funded system accounts without data
+
+   Addresses are hashes, not ed25519 public keys, so the synthetic
+   accounts cannot sign transactions.
+
+   THIS IS NOT SAFE FOR PRODUCTION USE.  It is intended for development
+   only. */
+
+#include "../fd_flamenco_base.h"
+#include "../types/fd_types.h"
+
+/* The genesis loader (fd_runtime_init_bank_from_genesis) sizes its vote
+   account and stake delegation maps for 5000 entries each, including
+   the accounts of the bootstrap validator. */
+
+#define FD_GENESIS_SYNTH_VALIDATOR_MAX (4096UL)
+#define FD_GENESIS_SYNTH_STAKE_MAX     (4096UL)
+
+/* FD_GENESIS_SYNTH_DATA_SZ_MAX is the largest data account size, the
+   maximum permitted data length of an account. */
+
+#define FD_GENESIS_SYNTH_DATA_SZ_MAX (10UL<<20)
+
+#define FD_GENESIS_SYNTH_KIND_VOTE   (0UL)
+#define FD_GENESIS_SYNTH_KIND_STAKE  (1UL)
+#define FD_GENESIS_SYNTH_KIND_MINT   (2UL)
+#define FD_GENESIS_SYNTH_KIND_TOKEN  (3UL)
+#define FD_GENESIS_SYNTH_KIND_DATA   (4UL)
+#define FD_GENESIS_SYNTH_KIND_SYSTEM (5UL)
+#define FD_GENESIS_SYNTH_KIND_CNT    (6UL)
+
+struct fd_genesis_synth_options {
+  ulong seed;
+
+  ulong validator_cnt;
+  ulong stake_cnt;
+  ulong stake_lamports;  /* delegated stake of each stake account */
+  ulong mint_cnt;
+  ulong token_cnt;
+  ulong data_cnt;
+  ulong data_sz_min;
+  ulong data_sz_max;
+  ulong owner_cnt;
+  ulong system_cnt;
+};
+
+typedef struct fd_genesis_synth_options fd_genesis_synth_options_t;
+
+/* fd_genesis_synth_t describes how the synthetic accounts are spliced
+   into a base genesis blob.  The output blob is
+
+     [0,cnt_off) of the base blob
+     ulong base_acct_cnt+acct_cnt
+     [cnt_off+8,acct_end_off) of the base blob
+     the encoded synthetic accounts [0,acct_cnt)
+     [acct_end_off,base_sz) of the base blob */
+
+struct fd_genesis_synth {
+  fd_genesis_synth_options_t opts;
+  fd_rent_t                  rent;
+
+  ulong base_sz;
+  ulong base_acct_cnt;
+  ulong cnt_off;       /* offset of the accounts vector length in the base blob */
+  ulong acct_end_off;  /* offset of the end of the accounts vector in the base blob */
+
+  ulong acct_cnt;                               /* number of synthetic accounts */
+  ulong kind_idx0[ FD_GENESIS_SYNTH_KIND_CNT+1UL ]; /* first account index of each kind */
+};
+
+typedef struct fd_genesis_synth fd_genesis_synth_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_genesis_synth_init prepares synth for extending the genesis blob
+   [base,base+base_sz) with the synthetic accounts described by opts.
+   Validates the options against the base genesis (e.g. the loader
+   limits above).  Assumes the caller is attached to an fd_scratch with
+   room to decode the base blob.  Returns synth on success and NULL on
+   failure (logs details). */
+
+fd_genesis_synth_t *
+fd_genesis_synth_init( fd_genesis_synth_t *               synth,
+                       fd_genesis_synth_options_t const * opts,
+                       uchar const *                      base,
+                       ulong                              base_sz );
+
+/* fd_genesis_synth_acct_sz_max returns an upper bound on the encoded
+   size of one synthetic account. */
+
+FD_FN_PURE ulong
+fd_genesis_synth_acct_sz_max( fd_genesis_synth_t const * synth );
+
+/* fd_genesis_synth_acct_sz returns the encoded size of synthetic
+   account idx.  fd_genesis_synth_range_sz returns the sum over accounts
+   [idx0,idx1). */
+
+FD_FN_PURE ulong
+fd_genesis_synth_acct_sz( fd_genesis_synth_t const * synth,
+                          ulong                      idx );
+
+FD_FN_PURE ulong
+fd_genesis_synth_range_sz( fd_genesis_synth_t const * synth,
+                           ulong                      idx0,
+                           ulong                      idx1 );
+
+/* fd_genesis_synth_acct writes synthetic account idx, bincode encoded
+   as a fd_pubkey_account_pair_t, to buf, which must have room for
+   fd_genesis_synth_acct_sz_max bytes.  Returns the encoded size.  Safe
+   to call concurrently from multiple threads. */
+
+ulong
+fd_genesis_synth_acct( fd_genesis_synth_t const * synth,
+                       ulong                      idx,
+                       uchar *                    buf );
+
+/* fd_genesis_synth_blob_sz returns the size of the output blob. */
+
+FD_FN_PURE ulong
+fd_genesis_synth_blob_sz( fd_genesis_synth_t const * synth );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_genesis_fd_genesis_synth_h */
@@ -0,0 +1,205 @@
+#include "fd_genesis_synth.h"
+#include "fd_genesis_create.h"
+#include "../runtime/fd_system_ids.h"
+#include "../runtime/program/fd_stake_program.h"
+#include "../runtime/program/fd_vote_program.h"
+
+#define BASE_MAX (32768UL)
+#define BLOB_MAX (64UL<<20)
+
+static uchar scratch_smem[ 64UL<<20 ] __attribute__((aligned(FD_SCRATCH_SMEM_ALIGN)));
+static ulong scratch_fmem[ 4 ];
+static uchar base[ BASE_MAX ];
+static uchar blob[ BLOB_MAX ];
+
+static ulong
+create_base( void ) {
+  fd_genesis_options_t options[1] = {{
+    .identity_pubkey             = { .ul = { 0, 0, 0, 1 } },
+    .faucet_pubkey               = { .ul = { 0, 0, 0, 2 } },
+    .stake_pubkey                = { .ul = { 0, 0, 0, 3 } },
+    .vote_pubkey                 = { .ul = { 0, 0, 0, 4 } },
+    .creation_time               = 123UL,
+    .ticks_per_slot              = 64UL,
+    .target_tick_duration_micros = 6250UL,
+    .fund_initial_accounts       = 4UL,
+  }};
+  ulong base_sz = fd_genesis_create( base, sizeof(base), options );
+  FD_TEST( base_sz );
+  return base_sz;
+}
+
+/* splice builds the output blob the way the genesis configure stage
+   does, with the accounts generated in a few independent ranges. */
+
+static ulong
+splice( fd_genesis_synth_t const * synth ) {
+  ulong blob_sz = fd_genesis_synth_blob_sz( synth );
+  FD_TEST( blob_sz<=BLOB_MAX );
+  memcpy( blob, base, synth->acct_end_off );
+  FD_STORE( ulong, blob+synth->cnt_off, synth->base_acct_cnt+synth->acct_cnt );
+
+  ulong off = synth->acct_end_off;
+  ulong part_cnt = 3UL;
+  for( ulong p=0UL; p<part_cnt; p++ ) {
+    ulong idx0 = synth->acct_cnt* p      /part_cnt;
+    ulong idx1 = synth->acct_cnt*(p+1UL)/part_cnt;
+    FD_TEST( off==synth->acct_end_off+fd_genesis_synth_range_sz( synth, 0UL, idx0 ) );
+    for( ulong i=idx0; i<idx1; i++ ) {
+      ulong sz = fd_genesis_synth_acct( synth, i, blob+off );
+      FD_TEST( sz==fd_genesis_synth_acct_sz( synth, i ) );
+      FD_TEST( sz<=fd_genesis_synth_acct_sz_max( synth ) );
+      off += sz;
+    }
+  }
+  memcpy( blob+off, base+synth->acct_end_off, synth->base_sz-synth->acct_end_off );
+  off += synth->base_sz-synth->acct_end_off;
+  FD_TEST( off==blob_sz );
+  return blob_sz;
+}
+
+static void
+test_synth( ulong base_sz ) {
+  fd_genesis_synth_options_t opts = {
+    .seed           = 42UL,
+    .validator_cnt  = 16UL,
+    .stake_cnt      = 100UL,
+    .stake_lamports = 1000000000UL,
+    .mint_cnt       = 8UL,
+    .token_cnt      = 500UL,
+    .data_cnt       = 300UL,
+    .data_sz_min    = 0UL,
+    .data_sz_max    = 100000UL,
+    .owner_cnt      = 4UL,
+    .system_cnt     = 1000UL,
+  };
+
+  fd_genesis_synth_t synth[1];
+  FD_TEST( fd_genesis_synth_init( synth, &opts, base, base_sz )==synth );
+  FD_TEST( synth->acct_cnt==1924UL );
+  FD_TEST( synth->base_acct_cnt==9UL );
+
+  /* Accounts are a function of (seed,idx) only */
+
+  static uchar a[ 200000 ], b[ 200000 ];
+  FD_TEST( fd_genesis_synth_acct_sz_max( synth )<=sizeof(a) );
+  for( ulong i=0UL; i<synth->acct_cnt; i+=37UL ) {
+    ulong sz = fd_genesis_synth_acct( synth, i, a );
+    FD_TEST( fd_genesis_synth_acct( synth, i, b )==sz );
+    FD_TEST( !memcmp( a, b, sz ) );
+  }
+
+  ulong blob_sz = splice( synth );
+
+  ulong kind_cnt[ 8 ] = {0};
+  ulong data_sz_sum   = 0UL;
+  FD_SCRATCH_SCOPE_BEGIN {
+    int err;
+    fd_genesis_solana_t * genesis = fd_bincode_decode_scratch( genesis_solana, blob, blob_sz, &err );
+    FD_TEST( genesis );
+    FD_TEST( genesis->accounts_len==synth->base_acct_cnt+synth->acct_cnt );
+    FD_TEST( genesis->ticks_per_slot==64UL );
+    FD_TEST( genesis->creation_time==123UL );
+
+    for( ulong i=synth->base_acct_cnt; i<genesis->accounts_len; i++ ) {
+      fd_solana_account_t const * acct = &genesis->accounts[ i ].account;
+      if( !memcmp( &acct->owner, &fd_solana_vote_program_id, sizeof(fd_pubkey_t) ) ) {
+        kind_cnt[ FD_GENESIS_SYNTH_KIND_VOTE ]++;
+        FD_TEST( acct->data_len==FD_VOTE_STATE_V3_SZ );
+        fd_vote_state_versioned_t * vsv = fd_bincode_decode_scratch( vote_state_versioned, acct->data, acct->data_len, &err );
+        FD_TEST( vsv );
+        FD_TEST( vsv->discriminant==fd_vote_state_versioned_enum_current );
+      } else if( !memcmp( &acct->owner, &fd_solana_stake_program_id, sizeof(fd_pubkey_t) ) ) {
+        kind_cnt[ FD_GENESIS_SYNTH_KIND_STAKE ]++;
+        fd_stake_state_v2_t * state = fd_bincode_decode_scratch( stake_state_v2, acct->data, acct->data_len, &err );
+        FD_TEST( state );
+        FD_TEST( state->discriminant==fd_stake_state_v2_enum_stake );
+        FD_TEST( state->inner.stake.stake.delegation.stake==opts.stake_lamports );
+        FD_TEST( acct->lamports==opts.stake_lamports+state->inner.stake.meta.rent_exempt_reserve );
+
+        /* Delegated to a synthetic vote account */
+        fd_pubkey_t const * voter = &state->inner.stake.stake.delegation.voter_pubkey;
+        int found = 0;
+        for( ulong k=synth->base_acct_cnt; k<synth->base_acct_cnt+opts.validator_cnt; k++ ) {
+          found |= !memcmp( &genesis->accounts[ k ].key, voter, sizeof(fd_pubkey_t) );
+        }
+        FD_TEST( found );
+      } else if( !memcmp( &acct->owner, &fd_solana_spl_token_id, sizeof(fd_pubkey_t) ) ) {
+        FD_TEST( acct->data_len==82UL || acct->data_len==165UL );
+        kind_cnt[ acct->data_len==82UL ? FD_GENESIS_SYNTH_KIND_MINT : FD_GENESIS_SYNTH_KIND_TOKEN ]++;
+      } else if( !memcmp( &acct->owner, &fd_solana_system_program_id, sizeof(fd_pubkey_t) ) ) {
+        kind_cnt[ FD_GENESIS_SYNTH_KIND_SYSTEM ]++;
+        FD_TEST( !acct->data_len );
+        FD_TEST( acct->lamports );
+      } else {
+        kind_cnt[ FD_GENESIS_SYNTH_KIND_DATA ]++;
+        FD_TEST( acct->data_len<=opts.data_sz_max );
+        data_sz_sum += acct->data_len;
+      }
+    }
+
+    /* Addresses are unique */
+
+    for( ulong i=0UL; i<genesis->accounts_len; i++ ) {
+      for( ulong k=i+1UL; k<genesis->accounts_len; k++ ) {
+        FD_TEST( memcmp( &genesis->accounts[ i ].key, &genesis->accounts[ k ].key, sizeof(fd_pubkey_t) ) );
+      }
+    }
+  } FD_SCRATCH_SCOPE_END;
+
+  FD_TEST( kind_cnt[ FD_GENESIS_SYNTH_KIND_VOTE   ]==opts.validator_cnt );
+  FD_TEST( kind_cnt[ FD_GENESIS_SYNTH_KIND_STAKE  ]==opts.stake_cnt     );
+  FD_TEST( kind_cnt[ FD_GENESIS_SYNTH_KIND_MINT   ]==opts.mint_cnt      );
+  FD_TEST( kind_cnt[ FD_GENESIS_SYNTH_KIND_TOKEN  ]==opts.token_cnt     );
+  FD_TEST( kind_cnt[ FD_GENESIS_SYNTH_KIND_DATA   ]==opts.data_cnt      );
+  FD_TEST( kind_cnt[ FD_GENESIS_SYNTH_KIND_SYSTEM ]==opts.system_cnt    );
+
+  /* Log-uniform sizes: far below the mean of a uniform distribution */
+  FD_TEST( data_sz_sum/opts.data_cnt<opts.data_sz_max/4UL );
+  FD_LOG_NOTICE(( "%lu synthetic accounts, %lu bytes, mean data account size %lu", synth->acct_cnt, blob_sz, data_sz_sum/opts.data_cnt ));
+}
+
+static void
+test_bad_opts( ulong base_sz ) {
+  fd_genesis_synth_t synth[1];
+  fd_genesis_synth_options_t opts = { .token_cnt = 1UL };
+  FD_TEST( !fd_genesis_synth_init( synth, &opts, base, base_sz ) ); /* no mints */
+  opts = (fd_genesis_synth_options_t){ .stake_cnt = 1UL, .stake_lamports = 1UL };
+  FD_TEST( !fd_genesis_synth_init( synth, &opts, base, base_sz ) ); /* no validators */
+  opts = (fd_genesis_synth_options_t){ .validator_cnt = FD_GENESIS_SYNTH_VALIDATOR_MAX+1UL };
+  FD_TEST( !fd_genesis_synth_init( synth, &opts, base, base_sz ) );
+  opts = (fd_genesis_synth_options_t){ .data_cnt = 1UL, .owner_cnt = 1UL, .data_sz_min = 2UL, .data_sz_max = 1UL };
+  FD_TEST( !fd_genesis_synth_init( synth, &opts, base, base_sz ) );
+  opts = (fd_genesis_synth_options_t){ .data_cnt = 1UL, .data_sz_max = 1UL };
+  FD_TEST( !fd_genesis_synth_init( synth, &opts, base, base_sz ) ); /* no owners */
+  opts = (fd_genesis_synth_options_t){ 0 };
+  FD_TEST( !fd_genesis_synth_init( synth, &opts, base, base_sz-1UL ) ); /* truncated base */
+
+  /* Nothing to add */
+  FD_TEST( fd_genesis_synth_init( synth, &opts, base, base_sz )==synth );
+  FD_TEST( !synth->acct_cnt );
+  FD_TEST( fd_genesis_synth_blob_sz( synth )==base_sz );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_scratch_attach( scratch_smem, scratch_fmem, sizeof(scratch_smem), sizeof(scratch_fmem)/sizeof(ulong) );
+
+  ulong base_sz = create_base();
+
+  int log_level = fd_log_level_logfile();
+  fd_log_level_logfile_set( fd_int_max( log_level, 4 ) );
+  test_bad_opts( base_sz );
+  fd_log_level_logfile_set( log_level );
+
+  test_synth( base_sz );
+
+  fd_scratch_detach( NULL );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,205 @@
+#include "fd_log_collector.h"
+
+void
+fd_log_collector_private_settle( fd_log_collector_t * log ) {
+  if( FD_LIKELY( !log->b58_cnt ) ) return;
+
+  ulong         log_sz = log->log_sz;
+  uchar *       cur    = log->buf + log->b58_off;
+  uchar const * end    = log->buf + log->buf_sz;
+  while( cur<end ) {
+    uchar kind = cur[0];
+    ulong sz   = fd_log_collector_debug_get_msg_sz( (uchar const **)&cur );
+    if( fd_log_collector_private_rec_has_b58( kind ) && !cur[ FD_LOG_COLLECTOR_REC_B58_OFF ] ) {
+      char  b58[ FD_BASE58_ENCODED_32_SZ ];
+      ulong b58_sz;
+      fd_base58_encode_32( cur, &b58_sz, b58 );
+      cur[ FD_LOG_COLLECTOR_REC_B58_OFF ] = (uchar)b58_sz;
+      log_sz += b58_sz;
+    }
+    cur += sz;
+  }
+
+  /* All deferred records were accepted with an upper bound below
+     FD_LOG_COLLECTOR_MAX, so this can't overflow. */
+  log->log_sz  = (ushort)log_sz;
+  log->b58_cnt = 0;
+  log->b58_off = log->buf_sz;
+}
+
+static char *
+fd_log_collector_private_append_b58( char * p, uchar const * pubkey ) {
+  ulong b58_sz;
+  fd_base58_encode_32( pubkey, &b58_sz, p );
+  return p + b58_sz;
+}
+
+ulong
+fd_log_collector_render_msg( uchar         kind,
+                             uchar const * payload,
+                             ulong         payload_sz,
+                             char *        out ) {
+  /* Formats must match exactly what we used to log eagerly, see
+     the corresponding fd_log_collector_program_* and Agave's
+     stable_log.rs.  Output sizes are all bounded by the msg_sz checks
+     done when the record was inserted. */
+  char * p = out;
+  switch( kind ) {
+
+  case FD_LOG_COLLECTOR_PROTO_TAG:
+    fd_memcpy( out, payload, payload_sz );
+    return payload_sz;
+
+  case FD_LOG_COLLECTOR_REC_INVOKE:
+    p = fd_cstr_append_text( p, "Program ", 8UL );
+    p = fd_log_collector_private_append_b58( p, payload );
+    p += sprintf( p, " invoke [%u]", (uint)payload[ 33 ] );
+    break;
+
+  case FD_LOG_COLLECTOR_REC_SUCCESS:
+    p = fd_cstr_append_text( p, "Program ", 8UL );
+    p = fd_log_collector_private_append_b58( p, payload );
+    p = fd_cstr_append_text( p, " success", 8UL );
+    break;
+
+  case FD_LOG_COLLECTOR_REC_CONSUMED:
+    p = fd_cstr_append_text( p, "Program ", 8UL );
+    p = fd_log_collector_private_append_b58( p, payload );
+    p += sprintf( p, " consumed %lu of %lu compute units", FD_LOAD( ulong, payload+33UL ), FD_LOAD( ulong, payload+41UL ) );
+    break;
+
+  case FD_LOG_COLLECTOR_REC_RETURN:
+    p = fd_cstr_append_text( p, "Program return: ", 16UL );
+    p = fd_log_collector_private_append_b58( p, payload );
+    *p++ = ' ';
+    p += fd_base64_encode( p, payload+33UL, payload_sz-33UL );
+    break;
+
+  case FD_LOG_COLLECTOR_REC_LOG_PUBKEY:
+    p = fd_cstr_append_text( p, "Program log: ", 13UL );
+    p = fd_log_collector_private_append_b58( p, payload );
+    break;
+
+  case FD_LOG_COLLECTOR_REC_LOG_64: {
+    ulong r[5]; fd_memcpy( r, payload, sizeof(r) );
+    p += sprintf( p, "Program log: 0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx", r[0], r[1], r[2], r[3], r[4] );
+    break;
+  }
+
+  case FD_LOG_COLLECTOR_REC_LOG_CU:
+    p += sprintf( p, "Program consumption: %lu units remaining", FD_LOAD( ulong, payload ) );
+    break;
+
+  case FD_LOG_COLLECTOR_REC_DATA: {
+    p = fd_cstr_append_text( p, "Program data: ", 14UL );
+    uchar const * cur = payload;
+    uchar const * end = payload + payload_sz;
+    for( ulong i=0UL; cur<end; i++ ) {
+      int   needs_2b = (cur[0]>0x7F);
+      ulong sz       = fd_ulong_if( needs_2b, ((ulong)cur[1]<<7) | (cur[0]&0x7FUL), cur[0] );
+      cur += 1UL + (ulong)needs_2b;
+      if( i ) *p++ = ' ';
+      p   += fd_base64_encode( p, cur, sz );
+      cur += sz;
+    }
+    break;
+  }
+
+  default:
+    FD_LOG_CRIT(( "corrupt log collector record (kind %u)", (uint)kind ));
+  }
+
+  return (ulong)(p - out);
+}
+
+ulong
+fd_log_collector_render( fd_log_collector_t const * log,
+                         uchar *                    out ) {
+  char  msg[ FD_LOG_COLLECTOR_MAX ];
+  ulong out_sz = 0UL;
+  for( uchar const * cur = log->buf; cur < log->buf + log->buf_sz; ) {
+    uchar kind   = cur[0];
+    ulong sz     = fd_log_collector_debug_get_msg_sz( &cur );
+    ulong msg_sz = fd_log_collector_render_msg( kind, cur, sz, msg );
+    out_sz += fd_log_collector_private_hdr( out+out_sz, FD_LOG_COLLECTOR_PROTO_TAG, msg_sz );
+    fd_memcpy( out+out_sz, msg, msg_sz );
+    out_sz += msg_sz;
+    cur    += sz;
+  }
+  return out_sz;
+}
+
+/* DEBUG */
+
+static FD_TL char fd_log_collector_private_debug_msg[ FD_LOG_COLLECTOR_MAX ];
+
+uchar const *
+fd_log_collector_debug_get( fd_log_collector_t const * log,
+                            ulong                      log_num,
+                            uchar const **             msg,
+                            ulong *                    msg_sz ) {
+  uchar const * cur    = log->buf;
+  uchar         kind   = cur[0];
+  ushort        cur_sz = fd_log_collector_debug_get_msg_sz( &cur );
+  while( log_num>0 ) {
+    cur   += cur_sz;
+    kind   = cur[0];
+    cur_sz = fd_log_collector_debug_get_msg_sz( &cur );
+    --log_num;
+  }
+
+  ulong sz = cur_sz;
+  if( kind!=FD_LOG_COLLECTOR_PROTO_TAG ) {
+    sz  = fd_log_collector_render_msg( kind, cur, cur_sz, fd_log_collector_private_debug_msg );
+    cur = (uchar const *)fd_log_collector_private_debug_msg;
+  }
+  if( msg )    *msg    = cur;
+  if( msg_sz ) *msg_sz = sz;
+  return cur;
+}
+
+ulong
+fd_log_collector_debug_sprintf( fd_log_collector_t const * log,
+                                char *                     out,
+                                int                        filter_zero ) {
+  ulong out_sz = 0;
+
+  char msg[ FD_LOG_COLLECTOR_MAX ];
+  for( uchar const * buf = log->buf; buf < log->buf + log->buf_sz; ) {
+    /* Read and render cur msg */
+    uchar  kind   = buf[0];
+    ushort cur_sz = fd_log_collector_debug_get_msg_sz( &buf );
+    ulong  msg_sz = fd_log_collector_render_msg( kind, buf, cur_sz, msg );
+
+    /* Copy string and add \n.
+       Slow version of memcpy that skips \0, because a \0 can be in logs.
+       Equivalent to:
+       fd_memcpy( out + out_sz, msg, msg_sz ); out_sz += msg_sz; */
+    if( filter_zero ) {
+      for( ulong i=0; i<msg_sz; i++ ) {
+        if( msg[i] ) {
+          out[ out_sz++ ] = msg[i];
+        }
+      }
+    } else {
+      fd_memcpy( out+out_sz, msg, msg_sz );
+      out_sz += msg_sz;
+    }
+    out[ out_sz++ ] = '\n';
+
+    /* Move to next str */
+    buf += cur_sz;
+  }
+
+  /* Remove the last \n, or return empty cstr */
+  out_sz = out_sz ? out_sz-1 : 0;
+  out[ out_sz ] = '\0';
+  return out_sz;
+}
+
+void
+fd_log_collector_private_debug( fd_log_collector_t const * log ) {
+  char out[FD_LOG_COLLECTOR_MAX + FD_LOG_COLLECTOR_EXTRA];
+  fd_log_collector_debug_sprintf( log, out, 1 );
+  FD_LOG_WARNING(( "\n-----\n%s\n-----", out ));
+}
@@ -51,12 +51,69 @@ fd_log_collector_private_push( fd_log_collector_t * log,
   log->buf_sz = (ushort)( msg_start + msg_sz );
 }
 
-/* fd_log_collector_private_debug prints all logs (internal, don't use directly). */
-static inline void
-fd_log_collector_private_debug( fd_log_collector_t const * log );
+/* Deferred records.
+
+   Formatting the most frequent logs (base58 program ids, base64 data,
+   printf of integers) is a significant cost of executing a txn with
+   logs enabled, and most logs are never read.  These logs are stored
+   as deferred binary records instead: the same header as a text record
+   but a different tag, followed by the raw arguments.  They are only
+   rendered to text by fd_log_collector_render() (or the debug API),
+   which produces exactly the buffer we would have built eagerly.
+
+     |  kind  | payload_sz   |   payload    |
+     | 1-byte | 1-or-2 bytes | payload_sz   |
+
+   To match Agave's truncation, the size of the rendered text must be
+   known when a log is inserted.  This is cheap for integers and base64,
+   but not for base58.  Records holding a pubkey reserve a byte after it
+   for its base58 size, 0 while unknown.  Since a 32 byte pubkey is
+   32..44 base58 chars, we only need the exact sizes when the upper
+   bound may cross FD_LOG_COLLECTOR_MAX.  fd_log_collector_private_settle
+   then computes them for all pending records. */
+
+#define FD_LOG_COLLECTOR_REC_INVOKE     (0x01) /* pubkey, b58_sz, uchar stack height  */
+#define FD_LOG_COLLECTOR_REC_SUCCESS    (0x02) /* pubkey, b58_sz                      */
+#define FD_LOG_COLLECTOR_REC_CONSUMED   (0x03) /* pubkey, b58_sz, ulong used, ulong total */
+#define FD_LOG_COLLECTOR_REC_RETURN     (0x04) /* pubkey, b58_sz, return data         */
+#define FD_LOG_COLLECTOR_REC_LOG_PUBKEY (0x05) /* pubkey, b58_sz                      */
+#define FD_LOG_COLLECTOR_REC_LOG_64     (0x06) /* ulong[5]                            */
+#define FD_LOG_COLLECTOR_REC_LOG_CU     (0x07) /* ulong remaining                     */
+#define FD_LOG_COLLECTOR_REC_DATA       (0x08) /* (1-or-2 bytes sz, bytes)*           */
+
+#define FD_LOG_COLLECTOR_REC_B58_OFF    (32UL) /* Offset of b58_sz in payload */
+
+FD_FN_CONST static inline int
+fd_log_collector_private_rec_has_b58( uchar kind ) {
+  return (kind>=FD_LOG_COLLECTOR_REC_INVOKE) & (kind<=FD_LOG_COLLECTOR_REC_LOG_PUBKEY);
+}
+
+/* fd_log_collector_private_hdr writes a record header with the given
+   kind and sz at buf, and returns the header size.  Like
+   fd_log_collector_private_push, it writes 3 bytes. */
+static inline ulong
+fd_log_collector_private_hdr( uchar * buf,
+                              uchar   kind,
+                              ulong   sz ) {
+  ulong needs_2b = (sz>0x7F);
+  buf[ 0 ] = kind;
+  buf[ 1 ] = (uchar)( (sz&0x7F) | (needs_2b<<7) );
+  buf[ 2 ] = (uchar)( (sz>>7) & 0x7F ); /* This gets overwritten if 0 */
+  return 2UL + needs_2b;
+}
 
 FD_PROTOTYPES_BEGIN
 
+/* fd_log_collector_private_settle accounts the base58 sizes of all
+   pending deferred records in log->log_sz (internal, don't use
+   directly). */
+void
+fd_log_collector_private_settle( fd_log_collector_t * log );
+
+/* fd_log_collector_private_debug prints all logs (internal, don't use directly). */
+void
+fd_log_collector_private_debug( fd_log_collector_t const * log );
+
 /* LOG COLLECTOR API
    Init, delete... */
 
@@ -65,6 +122,8 @@ static inline void
 fd_log_collector_init( fd_log_collector_t * log, int enabled ) {
   log->buf_sz = 0;
   log->log_sz = 0;
+  log->b58_cnt = 0;
+  log->b58_off = 0;
   log->warn = 0;
   log->disabled = !enabled;
 }
@@ -72,6 +131,13 @@ fd_log_collector_init( fd_log_collector_t * log, int enabled ) {
 static inline ulong
 fd_log_collector_check_and_truncate( fd_log_collector_t * log,
                                      ulong                msg_sz ) {
+  /* Deferred base58 strings are at most FD_BASE58_ENCODED_32_LEN
+     chars, we only need their exact size if they could matter. */
+  ulong b58_max = (ulong)log->b58_cnt * FD_BASE58_ENCODED_32_LEN;
+  if( FD_UNLIKELY( fd_ulong_sat_add( (ulong)log->log_sz + b58_max, msg_sz ) >= FD_LOG_COLLECTOR_MAX ) ) {
+    fd_log_collector_private_settle( log );
+  }
+
   ulong bytes_written = fd_ulong_sat_add( log->log_sz, msg_sz );
   int ret = bytes_written >= FD_LOG_COLLECTOR_MAX;
   if( FD_UNLIKELY( ret ) ) {
@@ -84,6 +150,63 @@ fd_log_collector_check_and_truncate( fd_log_collector_t * log,
   return bytes_written;
 }
 
+/* fd_log_collector_private_defer reserves a deferred record of the
+   given kind with payload_sz bytes of payload (internal, don't use
+   directly).  msg_sz is the size of the rendered text, excluding the
+   base58 of pubkey for records that have one (pubkey!=NULL).  Returns
+   a pointer to the payload to be filled by the caller, with pubkey and
+   its b58_sz already stored, or NULL if the log was truncated. */
+static inline uchar *
+fd_log_collector_private_defer( fd_log_collector_t * log,
+                                uchar                kind,
+                                ulong                payload_sz,
+                                ulong                msg_sz,
+                                uchar const *        pubkey ) {
+  ulong b58_sz  = 0UL;
+  ulong b58_max = ( (ulong)log->b58_cnt + !!pubkey ) * FD_BASE58_ENCODED_32_LEN;
+  if( FD_LIKELY( fd_ulong_sat_add( (ulong)log->log_sz + b58_max, msg_sz ) < FD_LOG_COLLECTOR_MAX ) ) {
+    /* Fast path: no truncation possible, size the base58 later. */
+    log->log_sz = (ushort)( log->log_sz + msg_sz );
+    if( pubkey ) {
+      if( !log->b58_cnt ) log->b58_off = log->buf_sz;
+      log->b58_cnt++;
+    }
+  } else {
+    if( pubkey ) {
+      char b58[ FD_BASE58_ENCODED_32_SZ ];
+      fd_base58_encode_32( pubkey, &b58_sz, b58 );
+    }
+    ulong bytes_written = fd_log_collector_check_and_truncate( log, msg_sz+b58_sz );
+    if( FD_UNLIKELY( bytes_written==ULONG_MAX ) ) return NULL;
+    log->log_sz = (ushort)bytes_written;
+  }
+
+  uchar * buf     = log->buf + log->buf_sz;
+  uchar * payload = buf + fd_log_collector_private_hdr( buf, kind, payload_sz );
+  if( pubkey ) {
+    fd_memcpy( payload, pubkey, 32UL );
+    payload[ FD_LOG_COLLECTOR_REC_B58_OFF ] = (uchar)b58_sz;
+  }
+  log->buf_sz = (ushort)( (ulong)(payload - log->buf) + payload_sz );
+  return payload;
+}
+
+/* fd_log_collector_private_program_id returns the program id of the
+   current instruction, and fd_log_collector_private_program_id_base58
+   its base58 encoding, computed on first use and cached in ctx. */
+static inline uchar const *
+fd_log_collector_private_program_id( fd_exec_instr_ctx_t const * ctx ) {
+  return ctx->txn_ctx->account_keys[ ctx->instr->program_id ].uc;
+}
+
+static inline char const *
+fd_log_collector_private_program_id_base58( fd_exec_instr_ctx_t * ctx ) {
+  if( FD_UNLIKELY( !ctx->program_id_base58[0] ) ) {
+    fd_base58_encode_32( fd_log_collector_private_program_id( ctx ), NULL, ctx->program_id_base58 );
+  }
+  return ctx->program_id_base58;
+}
+
 /* fd_log_collector_delete deletes a log collector. */
 static inline void
 fd_log_collector_delete( fd_log_collector_t const * log ) {
@@ -373,19 +496,20 @@ fd_log_collector_printf_inefficient_max_512( fd_exec_instr_ctx_t * ctx,
      "Program <ProgramIdBase58> invoke [<n>]"
 
    This function is called at the beginning of every instruction.
-   Other logs (notably success/failure) also write <ProgramIdBase58>,
-   so this function precomputes it and stores it inside the instr_ctx. */
+   The log is deferred, it only stores the program id and n. */
 static inline void
 fd_log_collector_program_invoke( fd_exec_instr_ctx_t * ctx ) {
-  if( FD_LIKELY( ctx->txn_ctx->log_collector.disabled ) ) {
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
     return;
   }
 
-  fd_pubkey_t const * program_id_pubkey = &ctx->txn_ctx->account_keys[ ctx->instr->program_id ];
-  /* Cache ctx->program_id_base58 */
-  fd_base58_encode_32( program_id_pubkey->uc, NULL, ctx->program_id_base58 );
-  /* Max msg_sz: 22 - 4 + 44 + 10 = 72 < 127 => we can use printf */
-  fd_log_collector_printf_dangerous_max_127( ctx, "Program %s invoke [%u]", ctx->program_id_base58, ctx->txn_ctx->instr_stack_sz );
+  /* msg_sz: 22 - 4 + b58 + digits(n) */
+  uchar n = ctx->txn_ctx->instr_stack_sz;
+  uchar * payload = fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_INVOKE, 34UL,
+                                                    18UL + fd_uchar_base10_dig_cnt( n ),
+                                                    fd_log_collector_private_program_id( ctx ) );
+  if( FD_LIKELY( payload ) ) payload[ 33 ] = n;
 }
 
 /* fd_log_collector_program_log logs:
@@ -398,40 +522,132 @@ fd_log_collector_program_log( fd_exec_instr_ctx_t * ctx, char const * msg, ulong
   fd_log_collector_msg_many( ctx, 2, "Program log: ", 13UL, msg, msg_sz );
 }
 
+/* fd_log_collector_program_log_pubkey logs:
+     "Program log: <PubkeyBase58>"
+
+   This is the implementation underlying sol_log_pubkey() syscall. */
+static inline void
+fd_log_collector_program_log_pubkey( fd_exec_instr_ctx_t * ctx, uchar const pubkey[ static 32 ] ) {
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
+    return;
+  }
+
+  /* msg_sz: 13 + b58 */
+  fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_LOG_PUBKEY, 33UL, 13UL, pubkey );
+}
+
+/* fd_log_collector_program_log_64 logs:
+     "Program log: 0x<r1>, 0x<r2>, 0x<r3>, 0x<r4>, 0x<r5>"
+
+   This is the implementation underlying sol_log_64_() syscall. */
+static inline void
+fd_log_collector_program_log_64( fd_exec_instr_ctx_t * ctx,
+                                 ulong r1, ulong r2, ulong r3, ulong r4, ulong r5 ) {
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
+    return;
+  }
+
+  ulong r[5] = { r1, r2, r3, r4, r5 };
+
+  /* msg_sz: 46 - 15 + hex digits */
+  ulong msg_sz = 31UL;
+  for( ulong i=0UL; i<5UL; i++ ) msg_sz += ((ulong)fd_ulong_find_msb_w_default( r[i], 0 )>>2) + 1UL;
+
+  uchar * payload = fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_LOG_64, sizeof(r), msg_sz, NULL );
+  if( FD_LIKELY( payload ) ) fd_memcpy( payload, r, sizeof(r) );
+}
+
+/* fd_log_collector_program_consumption logs:
+     "Program consumption: <remaining> units remaining"
+
+   This is the implementation underlying sol_log_compute_units_() syscall. */
+static inline void
+fd_log_collector_program_consumption( fd_exec_instr_ctx_t * ctx, ulong remaining ) {
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
+    return;
+  }
+
+  /* msg_sz: 40 - 3 + digits(remaining) */
+  uchar * payload = fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_LOG_CU, sizeof(ulong),
+                                                    37UL + fd_ulong_base10_dig_cnt( remaining ), NULL );
+  if( FD_LIKELY( payload ) ) FD_STORE( ulong, payload, remaining );
+}
+
+/* fd_log_collector_program_data_prepare and _slice log:
+     "Program data: <slice0AsBase64> <slice1AsBase64> ..."
+
+   This is the implementation underlying sol_log_data() syscall, which
+   needs to translate each slice before logging it.  The caller computes
+   msg_sz, the size of the rendered msg, and payload_sz, the sum of
+   fd_log_collector_program_data_slice_sz() of all slices.  If prepare
+   returns non-NULL, the caller appends all slices in order with
+   fd_log_collector_program_data_slice().  If it returns NULL, logs are
+   disabled or the msg was truncated, and there's nothing else to do. */
+FD_FN_CONST static inline ulong
+fd_log_collector_program_data_slice_sz( ulong sz ) {
+  return fd_ulong_sat_add( sz, 1UL + (sz>0x7F) );
+}
+
+static inline uchar *
+fd_log_collector_program_data_prepare( fd_exec_instr_ctx_t * ctx,
+                                       ulong                 msg_sz,
+                                       ulong                 payload_sz ) {
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
+    return NULL;
+  }
+  return fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_DATA, payload_sz, msg_sz, NULL );
+}
+
+static inline uchar *
+fd_log_collector_program_data_slice( uchar *      p,
+                                     void const * data,
+                                     ulong        sz ) {
+  /* A slice is at most FD_LOG_COLLECTOR_MAX*3/4 bytes, sz fits in 2 bytes */
+  ulong needs_2b = (sz>0x7F);
+  p[ 0 ] = (uchar)( (sz&0x7F) | (needs_2b<<7) );
+  if( needs_2b ) p[ 1 ] = (uchar)( (sz>>7) & 0x7F );
+  p += 1UL + needs_2b;
+  fd_memcpy( p, data, sz );
+  return p + sz;
+}
+
 /* fd_log_collector_program_return logs:
      "Program return: <ProgramIdBase58> <dataAsBase64>"
 
-   Since return data is at most 1024 bytes, it's base64 representation is
-   at most 1368 bytes and msg_sz is known in advance, thus we can use
-   fd_log_collector_printf_*.
-
-   TODO: implement based on fd_log_collector_msg_many(). */
+   Return data is at most 1024 bytes, and it's copied into the deferred
+   record as is. */
 static inline void
 fd_log_collector_program_return( fd_exec_instr_ctx_t * ctx ) {
-  if( FD_LIKELY( ctx->txn_ctx->log_collector.disabled ) ) {
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
     return;
   }
 
-  /* ctx->txn_ctx->return_data is 1024 bytes max, so its base64 repr
-     is at most (1024+2)/3*4 bytes, plus we use 1 byte for \0. */
-  char return_base64[ (sizeof(ctx->txn_ctx->return_data.data)+2)/3*4+1 ];
-  ulong sz = fd_base64_encode( return_base64, ctx->txn_ctx->return_data.data, ctx->txn_ctx->return_data.len );
-  return_base64[ sz ] = 0;
-  /* Max msg_sz: 21 - 4 + 44 + 1368 = 1429 < 1500 => we can use printf, but have to handle sz */
-  ulong msg_sz = 17 + strlen(ctx->program_id_base58) + sz;
-  if( msg_sz<=127 ) {
-    fd_log_collector_printf_dangerous_max_127( ctx, "Program return: %s %s", ctx->program_id_base58, return_base64 );
-  } else {
-    fd_log_collector_printf_dangerous_128_to_2k( ctx, "Program return: %s %s", ctx->program_id_base58, return_base64 );
-  }
+  ulong data_sz = ctx->txn_ctx->return_data.len;
+
+  /* msg_sz: 21 - 4 + b58 + base64(data) */
+  uchar * payload = fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_RETURN, 33UL + data_sz,
+                                                    17UL + FD_BASE64_ENC_SZ( data_sz ),
+                                                    fd_log_collector_private_program_id( ctx ) );
+  if( FD_LIKELY( payload ) ) fd_memcpy( payload + 33UL, ctx->txn_ctx->return_data.data, data_sz );
 }
 
 /* fd_log_collector_program_success logs:
      "Program <ProgramIdBase58> success" */
 static inline void
 fd_log_collector_program_success( fd_exec_instr_ctx_t * ctx ) {
-  /* Max msg_sz: 18 - 2 + 44 = 60 < 127 => we can use printf */
-  fd_log_collector_printf_dangerous_max_127( ctx, "Program %s success", ctx->program_id_base58 );
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
+    return;
+  }
+
+  /* msg_sz: 18 - 2 + b58 */
+  fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_SUCCESS, 33UL, 16UL,
+                                  fd_log_collector_private_program_id( ctx ) );
 }
 
 /* fd_log_collector_program_success logs:
@@ -477,7 +693,7 @@ fd_log_collector_program_failure( fd_exec_instr_ctx_t * ctx ) {
   /* Skip empty string, this means that the msg has already been logged. */
   if( FD_LIKELY( err[0] ) ) {
     char err_prefix[ 17+FD_BASE58_ENCODED_32_SZ ]; // 17==strlen("Program  failed: ")
-    int err_prefix_len = sprintf( err_prefix, "Program %s failed: ", ctx->program_id_base58 );
+    int err_prefix_len = sprintf( err_prefix, "Program %s failed: ", fd_log_collector_private_program_id_base58( ctx ) );
     if( err_prefix_len > 0 ) {
       /* Equivalent to: "Program %s failed: %s" */
       fd_log_collector_msg_many( ctx, 2, err_prefix, (ulong)err_prefix_len, err, (ulong)strlen(err) );
@@ -489,10 +705,44 @@ fd_log_collector_program_failure( fd_exec_instr_ctx_t * ctx ) {
      "Program <ProgramIdBase58> consumed <consumed> of <tota> compute units" */
 static inline void
 fd_log_collector_program_consumed( fd_exec_instr_ctx_t * ctx, ulong consumed, ulong total ) {
-  /* Max msg_sz: 44 - 8 + 44 + 20 + 20 = 120 < 127 => we can use printf */
-  fd_log_collector_printf_dangerous_max_127( ctx, "Program %s consumed %lu of %lu compute units", ctx->program_id_base58, consumed, total );
+  fd_log_collector_t * log = &ctx->txn_ctx->log_collector;
+  if( FD_LIKELY( log->disabled ) ) {
+    return;
+  }
+
+  /* msg_sz: 44 - 8 + b58 + digits(consumed) + digits(total) */
+  uchar * payload = fd_log_collector_private_defer( log, FD_LOG_COLLECTOR_REC_CONSUMED, 49UL,
+                                                    36UL + fd_ulong_base10_dig_cnt( consumed ) + fd_ulong_base10_dig_cnt( total ),
+                                                    fd_log_collector_private_program_id( ctx ) );
+  if( FD_LIKELY( payload ) ) {
+    FD_STORE( ulong, payload+33UL, consumed );
+    FD_STORE( ulong, payload+41UL, total    );
+  }
 }
 
+/* RENDER
+
+   fd_log_collector_render renders all logs into out, in the same
+   serialized format that text records use (protobuf, see
+   fd_log_collector_private_push), and returns the number of bytes
+   written.  out must have space for FD_LOG_COLLECTOR_MAX +
+   FD_LOG_COLLECTOR_EXTRA bytes.  This is what to store in txn
+   metadata, or to send to RPC clients.
+
+   fd_log_collector_render_msg renders the log msg of the record with
+   the given kind and payload into out, and returns its size.  out must
+   have space for FD_LOG_COLLECTOR_MAX bytes. */
+
+ulong
+fd_log_collector_render( fd_log_collector_t const * log,
+                         uchar *                    out );
+
+ulong
+fd_log_collector_render_msg( uchar         kind,
+                             uchar const * payload,
+                             ulong         payload_sz,
+                             char *        out );
+
 /* DEBUG
    Only used for testing (inefficient but ok). */
 
@@ -517,70 +767,22 @@ fd_log_collector_debug_len( fd_log_collector_t const * log ) {
   return len;
 }
 
-static inline uchar const *
+/* fd_log_collector_debug_get returns the log_num-th log msg.  Deferred
+   records are rendered into a thread local buffer, so the returned
+   pointer is only valid until the next call. */
+uchar const *
 fd_log_collector_debug_get( fd_log_collector_t const * log,
                             ulong                      log_num,
                             uchar const **             msg,
-                            ulong *                    msg_sz ) {
-  uchar const * cur = log->buf;
-  ushort cur_sz = 0;
+                            ulong *                    msg_sz );
 
-  cur_sz = fd_log_collector_debug_get_msg_sz( &cur );
-  while( log_num>0 ) {
-    cur += cur_sz;
-    cur_sz = fd_log_collector_debug_get_msg_sz( &cur );
-    --log_num;
-  }
-  if( msg )    *msg    = cur;
-  if( msg_sz ) *msg_sz = cur_sz;
-  return cur;
-}
-
-static inline ulong
+/* fd_log_collector_debug_sprintf writes all logs into out, separated by
+   \n, and returns the length of the resulting cstr.  If filter_zero,
+   \0 chars within logs are skipped. */
+ulong
 fd_log_collector_debug_sprintf( fd_log_collector_t const * log,
                                 char *                     out,
-                                int                        filter_zero ) {
-  ulong out_sz = 0;
-
-  ulong pos = 0;
-  uchar const * buf = log->buf;
-  while( pos < log->buf_sz ) {
-    /* Read cur string sz */
-    ushort cur_sz = fd_log_collector_debug_get_msg_sz( &buf );
-
-    /* Copy string and add \n.
-       Slow version of memcpy that skips \0, because a \0 can be in logs.
-       Equivalent to:
-       fd_memcpy( out + out_sz, buf, cur_sz ); out_sz += cur_sz; */
-    if( filter_zero ) {
-      for( ulong i=0; i<cur_sz; i++ ) {
-        if( buf[i] ) {
-          out[ out_sz++ ] = (char)buf[i];
-        }
-      }
-    } else {
-      fd_memcpy( out+out_sz, buf, cur_sz );
-      out_sz += cur_sz;
-    }
-    out[ out_sz++ ] = '\n';
-
-    /* Move to next str */
-    buf += cur_sz;
-    pos = (ulong)(buf - log->buf);
-  }
-
-  /* Remove the last \n, or return empty cstr */
-  out_sz = out_sz ? out_sz-1 : 0;
-  out[ out_sz ] = '\0';
-  return out_sz;
-}
-
-static inline void
-fd_log_collector_private_debug( fd_log_collector_t const * log ) {
-  char out[FD_LOG_COLLECTOR_MAX + FD_LOG_COLLECTOR_EXTRA];
-  fd_log_collector_debug_sprintf( log, out, 1 );
-  FD_LOG_WARNING(( "\n-----\n%s\n-----", out ));
-}
+                                int                        filter_zero );
 
 FD_PROTOTYPES_END
 
@@ -11,8 +11,11 @@
 #define FD_LOG_COLLECTOR_EXTRA (4000UL)   /* Large enough to cover worst cases:
                                              The serialization overhead is 2-3 bytes/log message,
                                              and realistically there can only be <800 messages.
+                                             Deferred records are never larger than their
+                                             rendered text, except sol_log_64 (+4 bytes, but
+                                             these are >=36 bytes long so there are <280).
                                              Moreover, we need extra space for possibly large
-                                             vsnprintf, e.g. program_return().
+                                             vsnprintf, e.g. printf_dangerous_128_to_2k().
                                              So, roughly, 2000 + 2000 = 4000 extra bytes. */
 #define FD_LOG_COLLECTOR_PROTO_TAG (0x32) /* Tag for protobuf serialization */
 
@@ -24,14 +27,24 @@ struct fd_log_collector {
   ushort log_sz;   /* The total bytes count of logs inserted, up to
                       FD_LOG_COLLECTOR_MAX.
                       This is only used to match Agave's behavior and
-                      truncate logs when necessary. */
+                      truncate logs when necessary.
+                      Excludes the base58 strings of the b58_cnt deferred
+                      records that haven't been sized yet. */
+
+  ushort b58_cnt;  /* Number of deferred base58 pubkeys whose rendered
+                      size is not yet accounted in log_sz. */
+
+  ushort b58_off;  /* Offset in buf of the first record that may hold
+                      one of them. */
 
   uchar  warn;     /* Whether we truncated or not logs, to match Agave's
                       behavior. */
 
   uchar  disabled; /* Whether txn logs are disabled (1) or enabled (0). */
 
-  /* Log buffer, serialized. */
+  /* Log buffer, serialized.  Text records are stored in their final
+     protobuf form, while frequent formatted messages are stored as
+     deferred binary records (see fd_log_collector.h). */
   uchar  buf[ FD_LOG_COLLECTOR_MAX + FD_LOG_COLLECTOR_EXTRA ];
 };
 typedef struct fd_log_collector fd_log_collector_t;
@@ -126,6 +126,129 @@ test_log_messages_equivalences( void ) {
   FD_TEST( fd_memeq( fd_log_collector_debug_get( log, 555, NULL, NULL ), FD_EXEC_LITERAL("Log truncated") ) );
 }
 
+/* test_log_messages_deferred logs random sequences of deferred and text
+   logs, and checks that the rendered logs are identical to logging the
+   formatted text eagerly, including which logs are truncated.  Program
+   ids with leading zero bytes exercise the whole 32..44 range of base58
+   sizes. */
+static fd_exec_txn_ctx_t test_txn[2];
+
+static void
+test_log_messages_deferred( fd_rng_t * rng ) {
+  fd_instr_info_t instr[1]; instr->program_id = 0;
+  fd_exec_instr_ctx_t ctx[1]; ctx->txn_ctx = &test_txn[0]; ctx->instr = instr;
+  fd_exec_instr_ctx_t ref[1]; ref->txn_ctx = &test_txn[1]; ref->instr = instr;
+  fd_log_collector_t * log     = &test_txn[0].log_collector;
+  fd_log_collector_t * ref_log = &test_txn[1].log_collector;
+
+  static uchar rendered[ FD_LOG_COLLECTOR_MAX + FD_LOG_COLLECTOR_EXTRA ];
+  char  msg[ FD_LOG_COLLECTOR_MAX ];
+  uchar data[ 1024 ];
+  for( ulong i=0UL; i<sizeof(data); i++ ) data[i] = fd_rng_uchar( rng );
+
+  for( ulong iter=0UL; iter<256UL; iter++ ) {
+    fd_log_collector_init( log,     1 );
+    fd_log_collector_init( ref_log, 1 );
+
+    ulong op_cnt = 16UL + fd_rng_ulong_roll( rng, 512UL );
+    for( ulong op=0UL; op<op_cnt; op++ ) {
+      fd_pubkey_t * program_id = &test_txn[0].account_keys[0];
+      for( ulong i=0UL; i<32UL; i++ ) program_id->uc[i] = fd_rng_uchar( rng );
+      ulong zero_cnt = fd_rng_ulong_roll( rng, 4UL ) ? 0UL : fd_rng_ulong_roll( rng, 33UL );
+      memset( program_id->uc, 0, zero_cnt );
+      test_txn[1].account_keys[0] = *program_id;
+      ctx->program_id_base58[0] = '\0';
+      char b58[ FD_BASE58_ENCODED_32_SZ ]; fd_base58_encode_32( program_id->uc, NULL, b58 );
+
+      ulong r[5]; for( ulong i=0UL; i<5UL; i++ ) r[i] = fd_rng_ulong( rng ) >> fd_rng_uint_roll( rng, 64U );
+      int   msg_sz = 0;
+
+      switch( fd_rng_uint_roll( rng, 9U ) ) {
+      case 0:
+        test_txn[0].instr_stack_sz = (uchar)fd_rng_uint_roll( rng, 12U );
+        fd_log_collector_program_invoke( ctx );
+        msg_sz = sprintf( msg, "Program %s invoke [%u]", b58, test_txn[0].instr_stack_sz );
+        break;
+      case 1:
+        fd_log_collector_program_success( ctx );
+        msg_sz = sprintf( msg, "Program %s success", b58 );
+        break;
+      case 2:
+        fd_log_collector_program_consumed( ctx, r[0], r[1] );
+        msg_sz = sprintf( msg, "Program %s consumed %lu of %lu compute units", b58, r[0], r[1] );
+        break;
+      case 3:
+        fd_log_collector_program_log_pubkey( ctx, program_id->uc );
+        msg_sz = sprintf( msg, "Program log: %s", b58 );
+        break;
+      case 4:
+        fd_log_collector_program_log_64( ctx, r[0], r[1], r[2], r[3], r[4] );
+        msg_sz = sprintf( msg, "Program log: 0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx", r[0], r[1], r[2], r[3], r[4] );
+        break;
+      case 5:
+        fd_log_collector_program_consumption( ctx, r[0] );
+        msg_sz = sprintf( msg, "Program consumption: %lu units remaining", r[0] );
+        break;
+      case 6: {
+        ulong data_sz = fd_rng_ulong_roll( rng, sizeof(data)+1UL );
+        test_txn[0].return_data.len = data_sz;
+        fd_memcpy( test_txn[0].return_data.data, data, data_sz );
+        fd_log_collector_program_return( ctx );
+        msg_sz  = sprintf( msg, "Program return: %s ", b58 );
+        msg_sz += (int)fd_base64_encode( msg+msg_sz, data, data_sz );
+        break;
+      }
+      case 7: {
+        ulong slice_cnt = fd_rng_ulong_roll( rng, 4UL );
+        ulong slice_sz[3];
+        ulong data_msg_sz = 14UL;
+        ulong payload_sz  = 0UL;
+        msg_sz = sprintf( msg, "Program data: " );
+        for( ulong i=0UL; i<slice_cnt; i++ ) {
+          slice_sz[i]  = fd_rng_ulong_roll( rng, 300UL );
+          data_msg_sz += FD_BASE64_ENC_SZ( slice_sz[i] ) + (i>0UL);
+          payload_sz  += fd_log_collector_program_data_slice_sz( slice_sz[i] );
+          if( i ) msg[ msg_sz++ ] = ' ';
+          msg_sz += (int)fd_base64_encode( msg+msg_sz, data, slice_sz[i] );
+        }
+        FD_TEST( data_msg_sz==(ulong)msg_sz );
+        uchar * p = fd_log_collector_program_data_prepare( ctx, data_msg_sz, payload_sz );
+        if( p ) {
+          uchar * p0 = p;
+          for( ulong i=0UL; i<slice_cnt; i++ ) p = fd_log_collector_program_data_slice( p, data, slice_sz[i] );
+          FD_TEST( (ulong)(p-p0)==payload_sz );
+        }
+        break;
+      }
+      default:
+        msg_sz = (int)fd_rng_ulong_roll( rng, 200UL );
+        for( int i=0; i<msg_sz; i++ ) msg[i] = (char)( 'a' + fd_rng_uint_roll( rng, 26U ) );
+        fd_log_collector_msg( ctx, msg, (ulong)msg_sz );
+      }
+      fd_log_collector_msg( ref, msg, (ulong)msg_sz );
+
+      /* Occasionally, the log sizes must agree once settled */
+      if( !fd_rng_uint_roll( rng, 64U ) ) {
+        fd_log_collector_private_settle( log );
+        FD_TEST( log->log_sz==ref_log->log_sz );
+      }
+    }
+
+    ulong rendered_sz = fd_log_collector_render( log, rendered );
+    FD_TEST( rendered_sz==ref_log->buf_sz );
+    FD_TEST( fd_memeq( rendered, ref_log->buf, rendered_sz ) );
+    FD_TEST( log->warn==ref_log->warn );
+    FD_TEST( fd_log_collector_debug_len( log )==fd_log_collector_debug_len( ref_log ) );
+
+    ulong last = fd_log_collector_debug_len( log )-1UL;
+    uchar const * msg0; ulong msg0_sz;
+    uchar const * msg1; ulong msg1_sz;
+    fd_log_collector_debug_get( ref_log, last, &msg1, &msg1_sz );
+    fd_log_collector_debug_get( log,     last, &msg0, &msg0_sz );
+    FD_TEST( msg0_sz==msg1_sz && fd_memeq( msg0, msg1, msg0_sz ) );
+  }
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -136,6 +259,11 @@ main( int     argc,
   test_log_messages_single_log_limit();
   test_log_messages_weird_behavior();
   test_log_messages_equivalences();
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  test_log_messages_deferred( rng );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   FD_LOG_NOTICE(( "pass" ));
 
   fd_halt();
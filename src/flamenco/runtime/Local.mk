@@ -16,6 +16,8 @@ $(call run-unit-test,test_blockhashes)
 $(call add-hdrs,fd_blockstore.h fd_rwseq_lock.h)
 $(call add-objs,fd_blockstore,fd_flamenco)
 $(call make-unit-test,test_blockstore,test_blockstore, fd_flamenco fd_util fd_ballet,$(SECP256K1_LIBS))
+$(call make-unit-test,test_blockstore_concur,test_blockstore_concur,fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_blockstore_concur)
 
 $(call add-hdrs,fd_executor.h)
 $(call add-objs,fd_executor,fd_flamenco)
@@ -46,10 +48,16 @@ $(call add-objs, tests/fd_dump_pb,fd_flamenco)
 
 $(call add-hdrs,fd_rent_lists.h)
 
+$(call add-hdrs,fd_bank_keys.h)
+$(call add-objs,fd_bank_keys,fd_flamenco)
+$(call make-unit-test,test_bank_keys,test_bank_keys,fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_bank_keys,)
+
 $(call add-hdrs,fd_bank.h)
 $(call add-objs,fd_bank,fd_flamenco)
 $(call make-unit-test,test_bank,test_bank,fd_flamenco fd_ballet fd_util)
 $(call run-unit-test,test_bank,)
+$(call make-unit-test,bench_bank,bench_bank,fd_flamenco fd_ballet fd_util)
 
 $(call make-unit-test,test_txncache,test_txncache,fd_flamenco fd_ballet fd_util)
 
@@ -0,0 +1,122 @@
+#include "fd_bank.h"
+
+/* bench_bank measures the cost of creating a fork and modifying its
+   stake account keys, for sets of 1K to 90K keys.  Each iteration
+   clones a child of the root bank, inserts a key into the child's set
+   (the first modification of the set in the fork) and publishes the
+   child, which prunes the old root.  For reference, also reports the
+   cost of copying the whole field like a CoW field does on its first
+   modification. */
+
+#define COW_FOOTPRINT (100000000UL) /* former stake_account_keys CoW footprint */
+
+static void
+rand_key( fd_rng_t *    rng,
+          fd_pubkey_t * key ) {
+  for( ulong j=0UL; j<4UL; j++ ) key->ul[ j ] = fd_rng_ulong( rng );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL,      "gigantic" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL,             4UL );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id() );
+  ulong        iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL,          1024UL );
+  uint         rng_seed = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed", NULL,           1234U );
+
+  if( FD_UNLIKELY( !iter_cnt || iter_cnt>8192UL ) ) FD_LOG_ERR(( "--iter-cnt must be in [1,8192]" ));
+
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, rng_seed, 0UL ) );
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to create wksp" ));
+
+  /* Two banks: the root and the fork being created */
+
+  void * banks_mem = fd_wksp_alloc_laddr( wksp, fd_banks_align(), fd_banks_footprint( 2UL ), 1UL );
+  if( FD_UNLIKELY( !banks_mem ) ) FD_LOG_ERR(( "Unable to allocate banks (%lu bytes)", fd_banks_footprint( 2UL ) ));
+  uchar * cow_mem = fd_wksp_alloc_laddr( wksp, 128UL, 2UL*COW_FOOTPRINT, 1UL );
+  if( FD_UNLIKELY( !cow_mem ) ) FD_LOG_ERR(( "Unable to allocate CoW reference buffers" ));
+  memset( cow_mem, 0, 2UL*COW_FOOTPRINT );
+
+  FD_LOG_NOTICE(( "keys    clone ns  modify ns  publish ns  CoW copy ns" ));
+
+  static ulong const key_cnts[] = { 1000UL, 10000UL, 90000UL };
+  for( ulong k=0UL; k<sizeof(key_cnts)/sizeof(ulong); k++ ) {
+    ulong key_cnt = key_cnts[ k ];
+    if( FD_UNLIKELY( key_cnt+iter_cnt>FD_BANK_KEYS_MAX ) ) continue;
+
+    fd_banks_t * banks = fd_banks_join( fd_banks_new( banks_mem, 2UL ) );
+    FD_TEST( banks );
+
+    ulong       slot = 1UL;
+    fd_bank_t * root = fd_banks_init_bank( banks, slot );
+    FD_TEST( root );
+
+    fd_bank_keys_t * keys = fd_bank_stake_account_keys_locking_modify( root );
+    for( ulong i=0UL; i<key_cnt; i++ ) {
+      fd_pubkey_t key; rand_key( rng, &key );
+      fd_bank_keys_insert( keys, &key );
+    }
+    fd_bank_stake_account_keys_end_locking_modify( root );
+
+    long clone_ns   = 0L;
+    long modify_ns  = 0L;
+    long publish_ns = 0L;
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+      fd_pubkey_t key; rand_key( rng, &key );
+
+      long t0 = fd_log_wallclock();
+      fd_bank_t * child = fd_banks_clone_from_parent( banks, slot+1UL, slot );
+      long t1 = fd_log_wallclock();
+      keys = fd_bank_stake_account_keys_locking_modify( child );
+      fd_bank_keys_insert( keys, &key );
+      fd_bank_stake_account_keys_end_locking_modify( child );
+      long t2 = fd_log_wallclock();
+      FD_TEST( fd_banks_publish( banks, slot+1UL )==child );
+      long t3 = fd_log_wallclock();
+
+      clone_ns   += t1-t0;
+      modify_ns  += t2-t1;
+      publish_ns += t3-t2;
+      slot++;
+    }
+
+    keys = fd_bank_stake_account_keys_locking_modify( fd_banks_get_bank( banks, slot ) );
+    FD_TEST( fd_bank_keys_cnt( keys )==key_cnt+iter_cnt );
+    fd_bank_keys_release( keys );
+    fd_bank_stake_account_keys_end_locking_modify( fd_banks_get_bank( banks, slot ) );
+
+    /* The CoW copy does not depend on the number of keys */
+
+    ulong cow_iter = fd_ulong_min( iter_cnt, 16UL );
+    long  cow_ns   = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<cow_iter; iter++ ) {
+      fd_memcpy( cow_mem + ((iter+1UL)&1UL)*COW_FOOTPRINT, cow_mem + (iter&1UL)*COW_FOOTPRINT, COW_FOOTPRINT );
+      FD_COMPILER_MFENCE();
+    }
+    cow_ns += fd_log_wallclock();
+
+    FD_LOG_NOTICE(( "%5lu  %9.1f  %9.1f  %10.1f  %11.1f",
+                    key_cnt,
+                    (double)clone_ns  /(double)iter_cnt,
+                    (double)modify_ns /(double)iter_cnt,
+                    (double)publish_ns/(double)iter_cnt,
+                    (double)cow_ns    /(double)cow_iter ));
+
+    FD_TEST( fd_banks_delete( fd_banks_leave( banks ) )==banks_mem );
+  }
+
+  fd_wksp_free_laddr( cow_mem );
+  fd_wksp_free_laddr( banks_mem );
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -16,8 +16,10 @@ struct fd_exec_instr_ctx {
   fd_instr_info_t const * instr;   /* The instruction info for this instruction */
   fd_exec_txn_ctx_t *     txn_ctx; /* The transaction context for this instruction */
 
-  /* Most instructions log the base58 program id multiple times, so it's
-     convenient to compute it once and reuse it. */
+  /* Base58 program id, for text logs that need it.  Most logs of the
+     program id are deferred, so this is computed on first use by
+     fd_log_collector_private_program_id_base58() (empty cstr until
+     then). */
   char program_id_base58[ FD_BASE58_ENCODED_32_SZ ];
 };
 
@@ -202,6 +202,7 @@ fd_exec_txn_ctx_setup_basic( fd_exec_txn_ctx_t * ctx ) {
   ctx->exec_err          = 0;
   ctx->exec_err_kind     = FD_EXECUTOR_ERR_KIND_NONE;
   ctx->current_instr_idx = 0;
+  ctx->zksdk_preverified = 0UL;
 }
 
 void
@@ -167,6 +167,10 @@ struct fd_exec_txn_ctx {
 
    /* The current instruction index being executed */
   int current_instr_idx;
+
+  /* Bit i is set if the ZK ElGamal proof of top-level instruction i was
+     already verified in a batch (see fd_zksdk_txn_preverify). */
+  ulong zksdk_preverified;
 };
 
 #define FD_EXEC_TXN_CTX_ALIGN     (alignof(fd_exec_txn_ctx_t))
@@ -13,6 +13,43 @@ fd_bank_footprint( void ) {
   return FD_LAYOUT_FINI( l, fd_bank_align() );
 }
 
+/* CoW pool element release.  Elements may be pinned by bank snapshots
+   (see fd_banks_snapshot_bank) that are read concurrently on other
+   tiles.  Pins are only ever taken on elements that are reachable from
+   a bank, and with the field lock of the owning bank held, so an
+   unpinned element that its owner drops cannot be pinned again.  A
+   pinned element is marked deferred instead, and released by a later
+   sweep once the pins are gone.  Only the replay side, which owns the
+   pools, drops and sweeps elements. */
+
+#define HAS_COW_1(name)                                                                \
+  static void                                                                          \
+  fd_bank_##name##_pool_drop( fd_bank_##name##_t * name##_pool, ulong idx ) {          \
+    fd_bank_##name##_t * ele = fd_bank_##name##_pool_ele( name##_pool, idx );          \
+    if( FD_VOLATILE_CONST( ele->pin_cnt ) ) {                                          \
+      ele->deferred = 1UL;                                                             \
+      return;                                                                          \
+    }                                                                                  \
+    fd_bank_##name##_pool_idx_release( name##_pool, idx );                             \
+  }                                                                                    \
+  static void                                                                          \
+  fd_bank_##name##_pool_sweep( fd_bank_##name##_t * name##_pool ) {                    \
+    ulong ele_max = fd_bank_##name##_pool_max( name##_pool );                          \
+    for( ulong idx=0UL; idx<ele_max; idx++ ) {                                         \
+      fd_bank_##name##_t * ele = fd_bank_##name##_pool_ele( name##_pool, idx );        \
+      if( FD_LIKELY( !ele->deferred ) || FD_VOLATILE_CONST( ele->pin_cnt ) ) continue; \
+      ele->deferred = 0UL;                                                             \
+      fd_bank_##name##_pool_idx_release( name##_pool, idx );                           \
+    }                                                                                  \
+  }
+#define HAS_COW_0(name)
+#define X(type, name, footprint, align, cow, has_lock) \
+  HAS_COW_##cow(name)
+FD_BANKS_ITER(X)
+#undef X
+#undef HAS_COW_0
+#undef HAS_COW_1
+
 /* Bank accesssors */
 
 #define HAS_COW_1(type, name, footprint, align, has_lock)                                                          \
@@ -44,9 +81,15 @@ fd_bank_footprint( void ) {
     if( FD_UNLIKELY( name##_pool==NULL ) ) {                                                                       \
       FD_LOG_CRIT(( "NULL " #name " pool" ));                                                                      \
     }                                                                                                              \
+    /* A snapshot pinning the element must not see it change, so a */                                             \
+    /* pinned element is copied like an inherited one and dropped.   */                                            \
     if( bank->name##_dirty ) {                                                                                     \
       fd_bank_##name##_t * bank_##name = fd_bank_##name##_pool_ele( name##_pool, bank->name##_pool_idx );          \
-      return (type *)bank_##name->data;                                                                            \
+      if( FD_LIKELY( !FD_VOLATILE_CONST( bank_##name->pin_cnt ) ) ) return (type *)bank_##name->data;              \
+    }                                                                                                              \
+    if( FD_UNLIKELY( !fd_bank_##name##_pool_free( name##_pool ) ) ) {                                              \
+      /* Elements dropped while pinned may have been unpinned since. */                                            \
+      fd_bank_##name##_pool_sweep( name##_pool );                                                                  \
     }                                                                                                              \
     if( FD_UNLIKELY( !fd_bank_##name##_pool_free( name##_pool ) ) ) {                                              \
       FD_LOG_CRIT(( "Failed to acquire " #name " pool element: pool is full" ));                                   \
@@ -59,9 +102,12 @@ fd_bank_footprint( void ) {
     /* new pool element and copy over the data from the parent idx.   */                                           \
     /* We also need to mark the dirty flag. */                                                                     \
     ulong child_idx = fd_bank_##name##_pool_idx( name##_pool, child_##name );                                      \
+    child_##name->pin_cnt  = 0UL;                                                                                  \
+    child_##name->deferred = 0UL;                                                                                  \
     if( bank->name##_pool_idx!=fd_bank_##name##_pool_idx_null( name##_pool ) ) {                                   \
       fd_bank_##name##_t * parent_##name = fd_bank_##name##_pool_ele( name##_pool, bank->name##_pool_idx );        \
       fd_memcpy( child_##name->data, parent_##name->data, fd_bank_##name##_footprint );                            \
+      if( bank->name##_dirty ) fd_bank_##name##_pool_drop( name##_pool, bank->name##_pool_idx );                   \
     }                                                                                                              \
     bank->name##_pool_idx = child_idx;                                                                             \
     bank->name##_dirty    = 1;                                                                                     \
@@ -124,8 +170,50 @@ FD_BANKS_ITER(X)
 #undef HAS_LOCK_0
 #undef HAS_LOCK_1
 
+/* Key set accessors.  Modifying a key set does not copy it, writes
+   only path copy the modified nodes (see fd_bank_keys.h). */
+
+#define X(name)                                             \
+  fd_bank_keys_t const *                                    \
+  fd_bank_##name##_locking_query( fd_bank_t * bank ) {      \
+    fd_rwlock_read( &bank->name##_lock );                   \
+    return &bank->name;                                     \
+  }                                                         \
+  void                                                      \
+  fd_bank_##name##_end_locking_query( fd_bank_t * bank ) {  \
+    fd_rwlock_unread( &bank->name##_lock );                 \
+  }                                                         \
+  fd_bank_keys_t *                                          \
+  fd_bank_##name##_locking_modify( fd_bank_t * bank ) {     \
+    fd_rwlock_write( &bank->name##_lock );                  \
+    return &bank->name;                                     \
+  }                                                         \
+  void                                                      \
+  fd_bank_##name##_end_locking_modify( fd_bank_t * bank ) { \
+    fd_rwlock_unwrite( &bank->name##_lock );                \
+  }
+FD_BANKS_KEYS_ITER(X)
+#undef X
+
 /**********************************************************************/
 
+/* fd_banks_keys_node_max returns the number of nodes in the key set
+   store.  Every bank holds one version of each key set and a version
+   never has more than FD_BANK_KEYS_MAX live nodes that are not shared
+   with another version.  An insert or remove temporarily holds up to
+   FD_BANK_KEYS_DEPTH_MAX extra nodes. */
+
+#define X(name) +1UL
+#define FD_BANKS_KEYS_CNT (0UL FD_BANKS_KEYS_ITER(X))
+
+static ulong
+fd_banks_keys_node_max( ulong max_banks ) {
+  return max_banks*FD_BANKS_KEYS_CNT*FD_BANK_KEYS_MAX + FD_BANK_KEYS_DEPTH_MAX;
+}
+
+#undef FD_BANKS_KEYS_CNT
+#undef X
+
 ulong
 fd_banks_align( void ) {
   /* TODO: The magic number here can probably be removed. */
@@ -156,6 +244,8 @@ fd_banks_footprint( ulong max_banks ) {
   #undef HAS_COW_0
   #undef HAS_COW_1
 
+  l = FD_LAYOUT_APPEND( l, fd_bank_keys_store_align(), fd_bank_keys_store_footprint( fd_banks_keys_node_max( max_banks ) ) );
+
   return FD_LAYOUT_FINI( l, fd_banks_align() );
 }
 
@@ -200,6 +290,9 @@ fd_banks_new( void * shmem, ulong max_banks ) {
   #undef HAS_COW_0
   #undef HAS_COW_1
 
+  ulong  keys_node_max  = fd_banks_keys_node_max( max_banks );
+  void * keys_store_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_bank_keys_store_align(), fd_bank_keys_store_footprint( keys_node_max ) );
+
   if( FD_UNLIKELY( FD_SCRATCH_ALLOC_FINI( l, fd_banks_align() ) != (ulong)banks + fd_banks_footprint( max_banks ) ) ) {
     FD_LOG_WARNING(( "fd_banks_new: bad layout" ));
     return NULL;
@@ -257,6 +350,23 @@ fd_banks_new( void * shmem, ulong max_banks ) {
   #undef HAS_COW_0
   #undef HAS_COW_1
 
+  /* The key set store seeds the treap priorities of the key sets.  The
+     seed must not be predictable by whoever creates accounts, or the
+     sets could be made arbitrarily deep. */
+
+  ulong keys_seed;
+  if( FD_UNLIKELY( !fd_rng_secure( &keys_seed, sizeof(ulong) ) ) ) {
+    FD_LOG_WARNING(( "fd_rng_secure failed, seeding key set store from the tick counter" ));
+    keys_seed = fd_ulong_hash( (ulong)fd_tickcount() );
+  }
+
+  fd_bank_keys_store_t * keys_store = fd_bank_keys_store_join( fd_bank_keys_store_new( keys_store_mem, keys_node_max, keys_seed ) );
+  if( FD_UNLIKELY( !keys_store ) ) {
+    FD_LOG_WARNING(( "Failed to create key set store" ));
+    return NULL;
+  }
+  banks->keys_store_offset = (ulong)keys_store - (ulong)banks;
+
   banks->max_banks = max_banks;
   banks->magic     = FD_BANKS_MAGIC;
 
@@ -303,6 +413,8 @@ fd_banks_join( void * mem ) {
   #undef HAS_COW_0
   #undef HAS_COW_1
 
+  void * keys_store_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_bank_keys_store_align(), fd_bank_keys_store_footprint( fd_banks_keys_node_max( banks->max_banks ) ) );
+
   FD_SCRATCH_ALLOC_FINI( l, fd_banks_align() );
 
   fd_bank_t * banks_pool = fd_banks_get_bank_pool( banks );
@@ -349,6 +461,11 @@ fd_banks_join( void * mem ) {
   #undef HAS_COW_0
   #undef HAS_COW_1
 
+  fd_bank_keys_store_t * keys_store = fd_banks_get_keys_store( banks );
+  if( FD_UNLIKELY( !keys_store || (void *)keys_store!=keys_store_mem ) ) {
+    FD_LOG_WARNING(( "Failed to join key set store" ));
+    return NULL;
+  }
 
   return banks;
 }
@@ -430,6 +547,14 @@ fd_banks_init_bank( fd_banks_t * banks, ulong slot ) {
   #undef HAS_LOCK_0
   #undef HAS_LOCK_1
 
+  /* All key sets start out empty. */
+  fd_bank_keys_store_t * keys_store = fd_banks_get_keys_store( banks );
+  #define X(name)                                   \
+    fd_bank_keys_init( &bank->name, keys_store );   \
+    fd_rwlock_unwrite( &bank->name##_lock );
+  FD_BANKS_KEYS_ITER(X)
+  #undef X
+
   fd_banks_map_ele_insert( bank_map, bank, bank_pool );
 
   /* Now that the node is inserted, update the root */
@@ -461,6 +586,117 @@ fd_banks_get_bank( fd_banks_t * banks, ulong slot ) {
   return bank;
 }
 
+ulong
+fd_banks_bank_idx( fd_banks_t * banks, ulong slot ) {
+  fd_banks_lock( banks );
+  fd_bank_t *      bank_pool = fd_banks_get_bank_pool( banks );
+  fd_banks_map_t * bank_map  = fd_banks_get_bank_map( banks );
+  ulong idx = fd_banks_map_idx_query_const( bank_map, &slot, ULONG_MAX, bank_pool );
+  fd_banks_unlock( banks );
+  return idx;
+}
+
+fd_bank_t *
+fd_banks_snapshot_bank( fd_banks_t *    banks,
+                        ulong           slot,
+                        void *          snap,
+                        fd_bank_pin_t * pin,
+                        ulong *         opt_pool_idx ) {
+
+  fd_banks_lock( banks );
+
+  fd_bank_t *      bank_pool = fd_banks_get_bank_pool( banks );
+  fd_banks_map_t * bank_map  = fd_banks_get_bank_map( banks );
+
+  ulong idx = fd_banks_map_idx_query_const( bank_map, &slot, ULONG_MAX, bank_pool );
+  if( FD_UNLIKELY( idx==ULONG_MAX ) ) {
+    fd_banks_unlock( banks );
+    return NULL;
+  }
+
+  fd_bank_t * bank     = fd_banks_pool_ele( bank_pool, idx );
+  fd_bank_t * snapshot = (fd_bank_t *)snap;
+  fd_memcpy( snapshot, bank, sizeof(fd_bank_t) );
+
+  /* Pin the pool element of each CoW field.  The element is owned by
+     the bank itself if it modified the field, and otherwise by the
+     closest ancestor that did (the only dirty bank with that pool idx).
+     The field lock of the bank keeps its pool idx stable while the
+     owner is looked up, and the field lock of the owner keeps it from
+     dropping the element while it is pinned.  Ancestors have children,
+     so they cannot be cleared, and the banks lock keeps them from being
+     pruned.  No lock is held once the element is pinned.
+
+     The CoW pool offsets are relative to the bank, so point them from
+     the snapshot back at the same pools.  The snapshot does not own
+     its elements. */
+
+  #define HAS_COW_1(name) {                                                              \
+    fd_bank_##name##_t * name##_pool = fd_banks_get_##name##_pool( banks );              \
+    fd_rwlock_read( &bank->name##_lock );                                                \
+    ulong                pool_idx = bank->name##_pool_idx;                               \
+    fd_bank_##name##_t * ele      = NULL;                                                \
+    if( pool_idx!=fd_bank_##name##_pool_idx_null( name##_pool ) ) {                      \
+      fd_bank_t * owner = bank;                                                          \
+      while( !owner->name##_dirty || owner->name##_pool_idx!=pool_idx ) {                \
+        owner = fd_banks_pool_ele( bank_pool, owner->parent_idx );                       \
+        if( FD_UNLIKELY( !owner ) ) FD_LOG_CRIT(( "No owner of " #name ));               \
+      }                                                                                  \
+      if( owner!=bank ) fd_rwlock_read( &owner->name##_lock );                           \
+      ele = fd_bank_##name##_pool_ele( name##_pool, pool_idx );                          \
+      FD_ATOMIC_FETCH_AND_ADD( &ele->pin_cnt, 1UL );                                     \
+      if( owner!=bank ) fd_rwlock_unread( &owner->name##_lock );                         \
+    }                                                                                    \
+    fd_rwlock_unread( &bank->name##_lock );                                              \
+    pin->name##_ele           = ele;                                                     \
+    snapshot->name##_pool_idx = pool_idx;                                                \
+    snapshot->name##_dirty    = 0;                                                       \
+    fd_bank_set_##name##_pool( snapshot, name##_pool );                                  \
+  }
+  #define HAS_COW_0(name)
+
+  #define HAS_LOCK_1(name) fd_rwlock_unwrite( &snapshot->name##_lock );
+  #define HAS_LOCK_0(name)
+
+  #define X(type, name, footprint, align, cow, has_lock) \
+    HAS_COW_##cow(name);                                 \
+    HAS_LOCK_##has_lock(name)
+  FD_BANKS_ITER(X)
+  #undef X
+  #undef HAS_COW_0
+  #undef HAS_COW_1
+  #undef HAS_LOCK_0
+  #undef HAS_LOCK_1
+
+  /* Key set nodes are reference counted, so do not share them */
+
+  fd_bank_keys_store_t * keys_store = fd_banks_get_keys_store( banks );
+  #define X(name)                                     \
+    fd_bank_keys_init( &snapshot->name, keys_store ); \
+    fd_rwlock_unwrite( &snapshot->name##_lock );
+  FD_BANKS_KEYS_ITER(X)
+  #undef X
+
+  fd_banks_unlock( banks );
+
+  if( opt_pool_idx ) *opt_pool_idx = idx;
+  return snapshot;
+}
+
+void
+fd_banks_snapshot_release( fd_bank_pin_t * pin ) {
+  #define HAS_COW_1(name)                                                        \
+    if( pin->name##_ele ) FD_ATOMIC_FETCH_AND_SUB( &pin->name##_ele->pin_cnt, 1UL ); \
+    pin->name##_ele = NULL;
+  #define HAS_COW_0(name)
+  #define X(type, name, footprint, align, cow, has_lock) \
+    HAS_COW_##cow(name)
+  FD_BANKS_ITER(X)
+  #undef X
+  #undef HAS_COW_0
+  #undef HAS_COW_1
+}
+
 
 fd_bank_t *
 fd_banks_clone_from_parent( fd_banks_t * banks,
@@ -499,7 +735,7 @@ fd_banks_clone_from_parent( fd_banks_t * banks,
 
   /* Now acquire a new bank */
 
-  FD_LOG_NOTICE(( "slot: %lu, fd_banks_pool_max: %lu, fd_banks_pool_free: %lu", slot, fd_banks_pool_max( bank_pool ), fd_banks_pool_free( bank_pool ) ));
+  FD_LOG_DEBUG(( "slot: %lu, fd_banks_pool_max: %lu, fd_banks_pool_free: %lu", slot, fd_banks_pool_max( bank_pool ), fd_banks_pool_free( bank_pool ) ));
 
   if( FD_UNLIKELY( !fd_banks_pool_free( bank_pool ) ) ) {
     FD_LOG_WARNING(( "No free banks" ));
@@ -584,6 +820,14 @@ fd_banks_clone_from_parent( fd_banks_t * banks,
   #undef HAS_LOCK_0
   #undef HAS_LOCK_1
 
+  /* Share the key sets of the parent.  The memcpy above copied the
+     parent's handles, which are replaced by new versions here. */
+  #define X(name)                                              \
+    fd_bank_keys_share( &new_bank->name, &parent_bank->name ); \
+    fd_rwlock_unwrite( &new_bank->name##_lock );
+  FD_BANKS_KEYS_ITER(X)
+  #undef X
+
   fd_rwlock_unwrite( &banks->rwlock );
 
   return new_bank;
@@ -647,11 +891,13 @@ fd_banks_publish( fd_banks_t * banks, ulong slot ) {
 
     /* Decide if we need to free any CoW fields. We free a CoW member
        from its pool if the dirty flag is set unless it is the same
-       pool that the new root uses. */
+       pool that the new root uses.  Members pinned by a snapshot are
+       released by a later publish instead (see
+       fd_banks_snapshot_bank). */
     #define HAS_COW_1(name)                                                          \
       if( head->name##_dirty && head->name##_pool_idx!=new_root->name##_pool_idx ) { \
         fd_bank_##name##_t * name##_pool = fd_banks_get_##name##_pool( banks );      \
-        fd_bank_##name##_pool_idx_release( name##_pool, head->name##_pool_idx );     \
+        fd_bank_##name##_pool_drop( name##_pool, head->name##_pool_idx );            \
       }
     /* Do nothing for these. */
     #define HAS_COW_0(name)
@@ -663,17 +909,26 @@ fd_banks_publish( fd_banks_t * banks, ulong slot ) {
     #undef HAS_COW_0
     #undef HAS_COW_1
 
+    /* Nodes of the key sets that are still shared with the surviving
+       banks are kept alive by their reference counts. */
+    #define X(name) \
+      fd_bank_keys_release( &head->name );
+    FD_BANKS_KEYS_ITER(X)
+    #undef X
+
     fd_banks_pool_ele_release( bank_pool, head );
     head = next;
   }
 
   /* If the new root did not have the dirty bit set, that means the node
-     didn't own the pool index. Change the ownership to the new root. */
+     didn't own the pool index. Change the ownership to the new root.
+     Also release the members that were waiting for their pins. */
   #define HAS_COW_1(name)                                                            \
     fd_bank_##name##_t * name##_pool = fd_banks_get_##name##_pool( banks );          \
     if( new_root->name##_pool_idx!=fd_bank_##name##_pool_idx_null( name##_pool ) ) { \
       new_root->name##_dirty = 1;                                                    \
-    }
+    }                                                                                \
+    fd_bank_##name##_pool_sweep( name##_pool );
   /* Do nothing if not CoW. */
   #define HAS_COW_0(name)
 
@@ -705,9 +960,12 @@ fd_banks_clear_bank( fd_banks_t * banks, fd_bank_t * bank ) {
       /* If the dirty flag is set, then we have a pool allocated for */                                                     \
       /* this specific bank. We need to release the pool index and   */                                                     \
       /* assign the bank to the idx corresponding to the parent.     */                                                     \
-      fd_bank_##name##_pool_idx_release( name##_pool, bank->name##_pool_idx );                                              \
+      /* A pinned element is released by a later publish.            */                                                     \
+      fd_rwlock_write( &bank->name##_lock );                                                                                \
+      fd_bank_##name##_pool_drop( name##_pool, bank->name##_pool_idx );                                                     \
       bank->name##_dirty    = 0;                                                                                            \
       bank->name##_pool_idx = !!parent_bank ? parent_bank->name##_pool_idx : fd_bank_##name##_pool_idx_null( name##_pool ); \
+      fd_rwlock_unwrite( &bank->name##_lock );                                                                              \
     }
 
   #define HAS_COW_0(type, name, footprint) \
@@ -719,4 +977,13 @@ fd_banks_clear_bank( fd_banks_t * banks, fd_bank_t * bank ) {
   #undef X
   #undef HAS_COW_0
   #undef HAS_COW_1
+
+  /* Reset the key sets to the parent's version. */
+  fd_bank_keys_store_t * keys_store = fd_banks_get_keys_store( banks );
+  #define X(name)                                                             \
+    fd_bank_keys_release( &bank->name );                                      \
+    if( parent_bank ) fd_bank_keys_share( &bank->name, &parent_bank->name ); \
+    else              fd_bank_keys_init( &bank->name, keys_store );
+  FD_BANKS_KEYS_ITER(X)
+  #undef X
 }
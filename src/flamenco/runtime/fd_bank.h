@@ -8,6 +8,7 @@
 #include "../fd_rwlock.h"
 #include "fd_runtime_const.h"
 #include "fd_blockhashes.h"
+#include "fd_bank_keys.h"
 
 FD_PROTOTYPES_BEGIN
 
@@ -81,6 +82,13 @@ FD_PROTOTYPES_BEGIN
   is modified, then the dirty flag is set, and an element of the pool
   is acquired and the data is copied over from the parent pool idx.
 
+  CoW still copies the whole field the first time a fork modifies it.
+  The account key sets are modified by most forks, so they are instead
+  persistent sets that share structure between banks (fd_bank_keys.h).
+  All of their nodes live in a single store owned by fd_banks_t and a
+  bank only holds a small handle for each set.  Cloning a bank shares
+  the parent's sets and modifying a set copies O(log n) nodes.
+
   fd_bank_t also holds all of the rw-locks for the fields that have
   rw-locks.
 
@@ -130,8 +138,6 @@ FD_PROTOTYPES_BEGIN
 #define FD_BANKS_ITER(X)                                                                                                                                                                                                             \
   /* type,                             name,                        footprint,                                 align,                                      CoW, has lock */                                                          \
   X(fd_clock_timestamp_votes_global_t, clock_timestamp_votes,       5000000UL,                                 128UL,                                      1,   1    )  /* TODO: This needs to get sized out */                      \
-  X(fd_account_keys_global_t,          stake_account_keys,          100000000UL,                               128UL,                                      1,   1    )  /* Supports roughly 3M stake accounts */                     \
-  X(fd_account_keys_global_t,          vote_account_keys,           3200000UL,                                 128UL,                                      1,   1    )  /* Supports roughly 100k vote accounts */                    \
   X(fd_blockhashes_t,                  block_hash_queue,            sizeof(fd_blockhashes_t),                  alignof(fd_blockhashes_t),                  0,   0    )  /* Block hash queue */                                       \
   X(fd_fee_rate_governor_t,            fee_rate_governor,           sizeof(fd_fee_rate_governor_t),            alignof(fd_fee_rate_governor_t),            0,   0    )  /* Fee rate governor */                                      \
   X(ulong,                             capitalization,              sizeof(ulong),                             alignof(ulong),                             0,   0    )  /* Capitalization */                                         \
@@ -193,6 +199,19 @@ FD_PROTOTYPES_BEGIN
   X(ulong,                             shred_cnt,                   sizeof(ulong),                             alignof(ulong),                             0,   0    )  /* Shred count */                                            \
   X(int,                               enable_exec_recording,       sizeof(int),                               alignof(int),                               0,   0    )  /* Enable exec recording */
 
+/* The account key sets of the bank are modified by ordinary stake and
+   vote program transactions, so most forks modify them.  Instead of
+   being CoW, they are persistent sets (see fd_bank_keys.h) that share
+   nodes with the sets of the parent bank.  Cloning a bank does not copy
+   them and a modification only copies O(log n) nodes.  Every key set
+   has a rw-lock. */
+
+#define FD_BANKS_KEYS_ITER(X)                                                                                             \
+  /* name */                                                                                                              \
+  X(stake_account_keys)         /* Stake accounts modified since the last epoch boundary */                            \
+  X(vote_account_keys)          /* Vote accounts modified since the last epoch boundary */                             \
+  X(removed_vote_account_keys)  /* Vote accounts in stakes closed since the last epoch boundary */
+
 /* Invariant Every CoW field must have a rw-lock */
 #define X(type, name, footprint, align, cow, has_lock) \
   FD_STATIC_ASSERT( (cow == 1 && has_lock == 1) || (cow == 0), CoW fields must have a rw-lock );
@@ -203,13 +222,20 @@ FD_PROTOTYPES_BEGIN
    which is defined here. If a type if not a CoW then it does not need
    to be in a pool and is laid out contigiously in the bank struct. */
 
-/* Declare a pool object wrapper for all CoW fields. */
+/* Declare a pool object wrapper for all CoW fields.  pin_cnt is the
+   number of bank snapshots referring to the element (see
+   fd_banks_snapshot_bank), it is updated atomically.  An element that
+   is dropped by its bank while pinned is marked deferred instead of
+   being released, and is released by a later fd_banks_publish once it
+   is no longer pinned. */
 #define HAS_COW_1(name, footprint, align)                    \
   static const ulong fd_bank_##name##_align     = align;     \
   static const ulong fd_bank_##name##_footprint = footprint; \
                                                              \
   struct fd_bank_##name {                                    \
     ulong next;                                              \
+    ulong pin_cnt;                                           \
+    ulong deferred;                                          \
     uchar data[footprint]__attribute__((aligned(align)));    \
   };                                                         \
   typedef struct fd_bank_##name fd_bank_##name##_t;
@@ -231,18 +257,6 @@ FD_PROTOTYPES_BEGIN
 #undef POOL_NAME
 #undef POOL_T
 
-#define POOL_NAME fd_bank_stake_account_keys_pool
-#define POOL_T    fd_bank_stake_account_keys_t
-#include "../../util/tmpl/fd_pool.c"
-#undef POOL_NAME
-#undef POOL_T
-
-#define POOL_NAME fd_bank_vote_account_keys_pool
-#define POOL_T    fd_bank_vote_account_keys_t
-#include "../../util/tmpl/fd_pool.c"
-#undef POOL_NAME
-#undef POOL_T
-
 #define POOL_NAME fd_bank_next_epoch_stakes_pool
 #define POOL_T    fd_bank_next_epoch_stakes_t
 #include "../../util/tmpl/fd_pool.c"
@@ -278,6 +292,8 @@ FD_PROTOTYPES_BEGIN
    - Non-Cow fields
    - CoW fields
    - Locks for CoW fields
+   - Key set handles
+   - Locks for key sets
 
    The CoW fields are laid out contiguously in the bank struct.
    The locks for the CoW fields are laid out contiguously after the
@@ -329,6 +345,13 @@ struct fd_bank {
   #undef HAS_COW_0
   #undef HAS_COW_1
 
+  /* Key sets are handles into the key store of fd_banks_t. */
+
+  #define X(name) \
+    fd_bank_keys_t name;
+  FD_BANKS_KEYS_ITER(X)
+  #undef X
+
   /* Now emit locks for all fields that need a rwlock. */
 
   #define HAS_LOCK_1(type, name, footprint, align) \
@@ -343,6 +366,11 @@ struct fd_bank {
   #undef HAS_LOCK_0
   #undef HAS_LOCK_1
 
+  #define X(name) \
+    fd_rwlock_t name##_lock;
+  FD_BANKS_KEYS_ITER(X)
+  #undef X
+
 };
 typedef struct fd_bank fd_bank_t;
 
@@ -427,6 +455,8 @@ struct fd_banks {
   #undef X
   #undef HAS_COW_0
   #undef HAS_COW_1
+
+  ulong             keys_store_offset; /* offset of the key set store from banks */
 };
 typedef struct fd_banks fd_banks_t;
 
@@ -453,6 +483,18 @@ FD_BANKS_ITER(X)
 #undef HAS_LOCK_0
 #undef HAS_LOCK_1
 
+/* Key set accessors.  The set returned by locking_modify can be
+   modified with fd_bank_keys_{insert,remove,release} until the
+   matching end_locking_modify. */
+
+#define X(name)                                                               \
+  fd_bank_keys_t const * fd_bank_##name##_locking_query( fd_bank_t * bank ); \
+  void fd_bank_##name##_end_locking_query( fd_bank_t * bank );               \
+  fd_bank_keys_t * fd_bank_##name##_locking_modify( fd_bank_t * bank );      \
+  void fd_bank_##name##_end_locking_modify( fd_bank_t * bank );
+FD_BANKS_KEYS_ITER(X)
+#undef X
+
 static inline ulong
 fd_bank_slot_get( fd_bank_t const * bank ) {
   return bank->slot_;
@@ -514,6 +556,11 @@ FD_BANKS_ITER(X)
 #undef HAS_COW_0
 #undef HAS_COW_1
 
+static inline fd_bank_keys_store_t *
+fd_banks_get_keys_store( fd_banks_t * banks ) {
+  return fd_bank_keys_store_join( (uchar *)banks + banks->keys_store_offset );
+}
+
 /* fd_banks_lock() and fd_banks_unlock() are locks to be acquired and
    freed around accessing or modifying a specific bank. This is only
    required if there is concurrent access to a bank while operations on
@@ -584,6 +631,70 @@ fd_banks_init_bank( fd_banks_t * banks, ulong slot );
 fd_bank_t *
 fd_banks_get_bank( fd_banks_t * banks, ulong slot );
 
+/* fd_banks_bank_idx() returns the index in the bank pool of the bank
+   for the given slot, or ULONG_MAX if there is no such bank.  Unlike
+   fd_banks_get_bank, this takes the banks lock and does not log when
+   the bank is missing, so it is suitable for queries on behalf of
+   clients. */
+
+ulong
+fd_banks_bank_idx( fd_banks_t * banks, ulong slot );
+
+/* fd_bank_pin_t holds the CoW fields of a bank snapshot in place, see
+   fd_banks_snapshot_bank.  For each CoW field, it records the pool
+   element the snapshot refers to (NULL if the field was never set),
+   whose pin count it holds a reference on. */
+
+struct fd_bank_pin {
+  #define HAS_COW_1(name) fd_bank_##name##_t * name##_ele;
+  #define HAS_COW_0(name)
+  #define X(type, name, footprint, align, cow, has_lock) HAS_COW_##cow(name)
+  FD_BANKS_ITER(X)
+  #undef X
+  #undef HAS_COW_0
+  #undef HAS_COW_1
+};
+typedef struct fd_bank_pin fd_bank_pin_t;
+
+/* fd_banks_snapshot_bank() copies the bank for the given slot into
+   snap, which must be aligned to fd_bank_align() and have room for
+   fd_bank_footprint() bytes.  Returns the snapshot on success and NULL
+   (without logging) if there is no bank for the slot.  On success, the
+   pool index of the bank is stored in *opt_pool_idx if non-NULL.
+
+   The banks lock is only held for the duration of the copy, so the
+   caller can execute against the snapshot for as long as it likes
+   without delaying clones.  The snapshot is read-only: non-CoW fields
+   are a private copy, taken without field locks, so the bank should be
+   frozen.  CoW fields alias the pool elements of the original bank and
+   may only be queried.  These elements are pinned in pin, such that
+   they are neither modified nor released until the caller releases the
+   pin with fd_banks_snapshot_release.  No lock is held while pinned:
+   modifying a pinned field copies it to a new element first, and
+   releasing a pinned element (fd_banks_clear_bank, fd_banks_publish)
+   is deferred until it is unpinned, so replay never waits for the
+   caller.  Deferred elements still count against the pool, so the
+   caller should release the pin promptly.  Key sets are empty and must
+   not be used.
+
+   Whether the slot was pruned in the meantime can be checked by
+   comparing fd_banks_bank_idx with the pool index. */
+
+fd_bank_t *
+fd_banks_snapshot_bank( fd_banks_t *    banks,
+                        ulong           slot,
+                        void *          snap,
+                        fd_bank_pin_t * pin,
+                        ulong *         opt_pool_idx );
+
+/* fd_banks_snapshot_release() releases a pin acquired by
+   fd_banks_snapshot_bank.  Never blocks and does not touch the pools,
+   so it is safe to call concurrently with any banks operation.  The
+   CoW fields of the snapshot must not be queried afterwards. */
+
+void
+fd_banks_snapshot_release( fd_bank_pin_t * pin );
+
 /* fd_banks_clone_from_parent() clones a bank from a parent bank.
    If the bank corresponding to the parent slot does not exist,
    NULL is returned. If a bank is not able to be created, NULL is
@@ -607,7 +718,10 @@ fd_banks_clone_from_parent( fd_banks_t * banks,
    bank.
 
    All banks that are ancestors or siblings of the slot will be
-   cancelled and their resources will be released back to the pool. */
+   cancelled and their resources will be released back to the pool.
+   CoW elements of pruned banks that are pinned by a snapshot are
+   released by a later publish once unpinned (see
+   fd_banks_snapshot_bank). */
 
 fd_bank_t const *
 fd_banks_publish( fd_banks_t * banks, ulong slot );
@@ -617,7 +731,10 @@ fd_banks_publish( fd_banks_t * banks, ulong slot );
 
    This function will memset all non-CoW fields to 0.
 
-   For all non-CoW fields, we will reset the indices to its parent. */
+   For all CoW fields and key sets, we will reset them to its parent.
+   CoW elements of the bank that are pinned by a snapshot are released
+   by a later fd_banks_publish once unpinned (see
+   fd_banks_snapshot_bank). */
 
 void
 fd_banks_clear_bank( fd_banks_t * banks, fd_bank_t * bank );
@@ -0,0 +1,348 @@
+#include "fd_bank_keys.h"
+
+#define IDX_NULL ((ulong)UINT_MAX)
+
+static inline fd_bank_keys_node_t *
+fd_bank_keys_store_pool( fd_bank_keys_store_t * store ) {
+  return fd_bank_keys_pool_join( (uchar *)store + sizeof(fd_bank_keys_store_t) );
+}
+
+ulong
+fd_bank_keys_store_align( void ) {
+  return fd_ulong_max( alignof(fd_bank_keys_store_t), fd_bank_keys_pool_align() );
+}
+
+ulong
+fd_bank_keys_store_footprint( ulong node_max ) {
+  if( FD_UNLIKELY( !node_max ) ) return 0UL;
+  ulong pool_footprint = fd_bank_keys_pool_footprint( node_max );
+  if( FD_UNLIKELY( !pool_footprint ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_bank_keys_store_t), sizeof(fd_bank_keys_store_t) );
+  l = FD_LAYOUT_APPEND( l, fd_bank_keys_pool_align(),     pool_footprint               );
+  return FD_LAYOUT_FINI( l, fd_bank_keys_store_align() );
+}
+
+void *
+fd_bank_keys_store_new( void * shmem,
+                        ulong  node_max,
+                        ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_bank_keys_store_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_bank_keys_store_footprint( node_max ) ) ) {
+    FD_LOG_WARNING(( "invalid node_max %lu", node_max ));
+    return NULL;
+  }
+
+  /* The pool directly follows the header, see fd_bank_keys_store_pool */
+  FD_STATIC_ASSERT( sizeof(fd_bank_keys_store_t)%128UL==0UL, layout );
+
+  fd_bank_keys_store_t * store = (fd_bank_keys_store_t *)shmem;
+  memset( store, 0, sizeof(fd_bank_keys_store_t) );
+  store->seed     = seed;
+  store->node_max = node_max;
+  fd_rwlock_unwrite( &store->lock );
+
+  if( FD_UNLIKELY( !fd_bank_keys_pool_new( (uchar *)store + sizeof(fd_bank_keys_store_t), node_max ) ) ) {
+    FD_LOG_WARNING(( "Failed to create bank keys pool" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( store->magic ) = FD_BANK_KEYS_STORE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_bank_keys_store_t *
+fd_bank_keys_store_join( void * shstore ) {
+
+  if( FD_UNLIKELY( !shstore ) ) {
+    FD_LOG_WARNING(( "NULL shstore" ));
+    return NULL;
+  }
+
+  fd_bank_keys_store_t * store = (fd_bank_keys_store_t *)shstore;
+  if( FD_UNLIKELY( store->magic!=FD_BANK_KEYS_STORE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return store;
+}
+
+void *
+fd_bank_keys_store_leave( fd_bank_keys_store_t * store ) {
+  return (void *)store;
+}
+
+void *
+fd_bank_keys_store_delete( void * shstore ) {
+
+  if( FD_UNLIKELY( !shstore ) ) {
+    FD_LOG_WARNING(( "NULL shstore" ));
+    return NULL;
+  }
+
+  fd_bank_keys_store_t * store = (fd_bank_keys_store_t *)shstore;
+  if( FD_UNLIKELY( store->magic!=FD_BANK_KEYS_STORE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( store->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shstore;
+}
+
+ulong
+fd_bank_keys_store_node_free( fd_bank_keys_store_t * store ) {
+  fd_rwlock_write( &store->lock );
+  ulong free = fd_bank_keys_pool_free( fd_bank_keys_store_pool( store ) );
+  fd_rwlock_unwrite( &store->lock );
+  return free;
+}
+
+/* Node management.  These must be called with the store lock held.
+   Functions that return a node idx return a new reference to it, owned
+   by the caller.  Node idx arguments are borrowed unless documented
+   otherwise. */
+
+static inline ulong
+node_ref( fd_bank_keys_node_t * pool,
+          ulong                 idx ) {
+  if( FD_LIKELY( idx!=IDX_NULL ) ) pool[ idx ].refcnt++;
+  return idx;
+}
+
+static void
+node_unref( fd_bank_keys_node_t * pool,
+            ulong                 idx ) {
+  while( idx!=IDX_NULL ) {
+    fd_bank_keys_node_t * node = pool + idx;
+    if( FD_LIKELY( --node->refcnt ) ) return;
+    ulong left  = node->left;
+    ulong right = node->right;
+    fd_bank_keys_pool_idx_release( pool, idx );
+    node_unref( pool, left );
+    idx = right;
+  }
+}
+
+/* node_new returns a new node.  Takes ownership of the references to
+   left and right. */
+
+static ulong
+node_new( fd_bank_keys_node_t * pool,
+          fd_pubkey_t const *   key,
+          uint                  prio,
+          ulong                 left,
+          ulong                 right ) {
+  if( FD_UNLIKELY( !fd_bank_keys_pool_free( pool ) ) ) {
+    FD_LOG_ERR(( "bank keys store full (%lu nodes)", fd_bank_keys_pool_max( pool ) ));
+  }
+  ulong                 idx  = fd_bank_keys_pool_idx_acquire( pool );
+  fd_bank_keys_node_t * node = pool + idx;
+  node->key    = *key;
+  node->prio   = prio;
+  node->left   = (uint)left;
+  node->right  = (uint)right;
+  node->refcnt = 1U;
+  return idx;
+}
+
+/* node_insert returns a copy of subtree t with key added.  key must not
+   be in t.  Every node on the path to key is copied, so all nodes on
+   the path of the result are only referenced by the result and can be
+   rotated in place. */
+
+static ulong
+node_insert( fd_bank_keys_node_t * pool,
+             ulong                 t,
+             fd_pubkey_t const *   key,
+             uint                  prio ) {
+  if( t==IDX_NULL ) return node_new( pool, key, prio, IDX_NULL, IDX_NULL );
+
+  fd_bank_keys_node_t const * node = pool + t;
+  if( memcmp( key, &node->key, sizeof(fd_pubkey_t) )<0 ) {
+    ulong l = node_insert( pool, node->left, key, prio );
+    if( pool[ l ].prio > node->prio ) { /* rotate right */
+      pool[ l ].right = (uint)node_new( pool, &node->key, node->prio, pool[ l ].right, node_ref( pool, node->right ) );
+      return l;
+    }
+    return node_new( pool, &node->key, node->prio, l, node_ref( pool, node->right ) );
+  } else {
+    ulong r = node_insert( pool, node->right, key, prio );
+    if( pool[ r ].prio > node->prio ) { /* rotate left */
+      pool[ r ].left = (uint)node_new( pool, &node->key, node->prio, node_ref( pool, node->left ), pool[ r ].left );
+      return r;
+    }
+    return node_new( pool, &node->key, node->prio, node_ref( pool, node->left ), r );
+  }
+}
+
+/* node_merge returns the union of subtrees a and b.  All keys in a must
+   be less than all keys in b. */
+
+static ulong
+node_merge( fd_bank_keys_node_t * pool,
+            ulong                 a,
+            ulong                 b ) {
+  if( a==IDX_NULL ) return node_ref( pool, b );
+  if( b==IDX_NULL ) return node_ref( pool, a );
+  fd_bank_keys_node_t const * na = pool + a;
+  fd_bank_keys_node_t const * nb = pool + b;
+  if( na->prio >= nb->prio ) {
+    return node_new( pool, &na->key, na->prio, node_ref( pool, na->left ), node_merge( pool, na->right, b ) );
+  } else {
+    return node_new( pool, &nb->key, nb->prio, node_merge( pool, a, nb->left ), node_ref( pool, nb->right ) );
+  }
+}
+
+/* node_remove returns a copy of subtree t without key.  key must be in
+   t. */
+
+static ulong
+node_remove( fd_bank_keys_node_t * pool,
+             ulong                 t,
+             fd_pubkey_t const *   key ) {
+  fd_bank_keys_node_t const * node = pool + t;
+  int cmp = memcmp( key, &node->key, sizeof(fd_pubkey_t) );
+  if( cmp<0 ) return node_new( pool, &node->key, node->prio, node_remove( pool, node->left, key ), node_ref( pool, node->right ) );
+  if( cmp>0 ) return node_new( pool, &node->key, node->prio, node_ref( pool, node->left ), node_remove( pool, node->right, key ) );
+  return node_merge( pool, node->left, node->right );
+}
+
+/* Set API */
+
+void
+fd_bank_keys_init( fd_bank_keys_t *       keys,
+                   fd_bank_keys_store_t * store ) {
+  keys->store_off = (long)( (ulong)store - (ulong)keys );
+  keys->root      = IDX_NULL;
+  keys->cnt       = 0UL;
+}
+
+void
+fd_bank_keys_share( fd_bank_keys_t *       dst,
+                    fd_bank_keys_t const * src ) {
+  fd_bank_keys_store_t * store = fd_bank_keys_store( src );
+  ulong                  root  = src->root;
+  ulong                  cnt   = src->cnt;
+
+  fd_rwlock_write( &store->lock );
+  node_ref( fd_bank_keys_store_pool( store ), root );
+  fd_rwlock_unwrite( &store->lock );
+
+  fd_bank_keys_init( dst, store );
+  dst->root = root;
+  dst->cnt  = cnt;
+}
+
+void
+fd_bank_keys_release( fd_bank_keys_t * keys ) {
+  fd_bank_keys_store_t * store = fd_bank_keys_store( keys );
+
+  fd_rwlock_write( &store->lock );
+  node_unref( fd_bank_keys_store_pool( store ), keys->root );
+  fd_rwlock_unwrite( &store->lock );
+
+  keys->root = IDX_NULL;
+  keys->cnt  = 0UL;
+}
+
+int
+fd_bank_keys_test( fd_bank_keys_t const * keys,
+                   fd_pubkey_t const *    key ) {
+  fd_bank_keys_node_t const * pool = fd_bank_keys_store_pool( fd_bank_keys_store( keys ) );
+  ulong idx = keys->root;
+  while( idx!=IDX_NULL ) {
+    fd_bank_keys_node_t const * node = pool + idx;
+    int cmp = memcmp( key, &node->key, sizeof(fd_pubkey_t) );
+    if( !cmp ) return 1;
+    idx = cmp<0 ? node->left : node->right;
+  }
+  return 0;
+}
+
+int
+fd_bank_keys_insert( fd_bank_keys_t *    keys,
+                     fd_pubkey_t const * key ) {
+  if( fd_bank_keys_test( keys, key ) ) return 0;
+  if( FD_UNLIKELY( keys->cnt>=FD_BANK_KEYS_MAX ) ) {
+    FD_LOG_ERR(( "bank keys set full (%lu keys)", keys->cnt ));
+  }
+
+  fd_bank_keys_store_t * store = fd_bank_keys_store( keys );
+  fd_bank_keys_node_t *  pool  = fd_bank_keys_store_pool( store );
+  uint                   prio  = (uint)fd_hash( store->seed, key, sizeof(fd_pubkey_t) );
+
+  fd_rwlock_write( &store->lock );
+  ulong root = node_insert( pool, keys->root, key, prio );
+  node_unref( pool, keys->root );
+  fd_rwlock_unwrite( &store->lock );
+
+  keys->root = root;
+  keys->cnt++;
+  return 1;
+}
+
+int
+fd_bank_keys_remove( fd_bank_keys_t *    keys,
+                     fd_pubkey_t const * key ) {
+  if( !fd_bank_keys_test( keys, key ) ) return 0;
+
+  fd_bank_keys_store_t * store = fd_bank_keys_store( keys );
+  fd_bank_keys_node_t *  pool  = fd_bank_keys_store_pool( store );
+
+  fd_rwlock_write( &store->lock );
+  ulong root = node_remove( pool, keys->root, key );
+  node_unref( pool, keys->root );
+  fd_rwlock_unwrite( &store->lock );
+
+  keys->root = root;
+  keys->cnt--;
+  return 1;
+}
+
+/* Iteration */
+
+static void
+iter_push_left( fd_bank_keys_iter_t * iter,
+                ulong                 idx ) {
+  while( idx!=IDX_NULL ) {
+    if( FD_UNLIKELY( iter->depth>=FD_BANK_KEYS_DEPTH_MAX ) ) {
+      FD_LOG_CRIT(( "bank keys set deeper than %lu", FD_BANK_KEYS_DEPTH_MAX ));
+    }
+    iter->stack[ iter->depth++ ] = (uint)idx;
+    idx = iter->pool[ idx ].left;
+  }
+}
+
+void
+fd_bank_keys_iter_init( fd_bank_keys_iter_t *  iter,
+                        fd_bank_keys_t const * keys ) {
+  iter->pool  = fd_bank_keys_store_pool( fd_bank_keys_store( keys ) );
+  iter->depth = 0UL;
+  iter_push_left( iter, keys->root );
+}
+
+void
+fd_bank_keys_iter_next( fd_bank_keys_iter_t * iter ) {
+  ulong idx = iter->stack[ --iter->depth ];
+  iter_push_left( iter, iter->pool[ idx ].right );
+}
+
+#undef IDX_NULL
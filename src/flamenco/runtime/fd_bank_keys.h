@@ -0,0 +1,212 @@
+#ifndef HEADER_fd_src_flamenco_runtime_fd_bank_keys_h
+#define HEADER_fd_src_flamenco_runtime_fd_bank_keys_h
+
+#include "../types/fd_types.h"
+#include "../fd_rwlock.h"
+
+/* fd_bank_keys.h provides the account key sets of the bank (the stake
+   and vote accounts touched since the last epoch boundary).
+
+   Every bank holds its own version of each set, and most banks are
+   clones of their parent with a handful of keys added.  Instead of
+   copying the whole set when a fork first modifies it, all versions are
+   persistent treaps that share nodes.  Nodes are immutable once
+   reachable from a set.  An insert or remove copies the O(log n) nodes
+   on the path to the key, the rest of the tree stays shared with the
+   other versions.  Cloning a set is O(1).
+
+   Nodes live in a single pool (fd_bank_keys_store_t) shared by all
+   banks and are reference counted.  A node is freed when the last set
+   or node referring to it goes away.  Treap priorities are a seeded
+   hash of the key, so the shape of a set does not depend on the order
+   keys were inserted in and cannot be steered by choosing keys.  Sets
+   iterate in memcmp order of the keys, like the fd_account_keys_t map
+   they replace.
+
+   Concurrency: readers never write to nodes and need no store lock.
+   Writers to the same set must be serialized by the caller (the bank
+   field rwlock).  Writers to different sets may run concurrently and
+   with readers of any set, the store serializes node allocation and
+   reference counting internally. */
+
+#define FD_BANK_KEYS_STORE_MAGIC (0xf17eda2ce7b0c5e0UL) /* firedancer bank keys version 0 */
+
+/* FD_BANK_KEYS_MAX is the maximum number of keys in a set. */
+
+#define FD_BANK_KEYS_MAX (100000UL)
+
+/* FD_BANK_KEYS_DEPTH_MAX bounds the depth of a set.  The expected depth
+   of a treap with FD_BANK_KEYS_MAX keys is about 35. */
+
+#define FD_BANK_KEYS_DEPTH_MAX (128UL)
+
+struct fd_bank_keys_node {
+  fd_pubkey_t key;
+  uint        prio;   /* treap priority, a parent's prio is >= its children's */
+  uint        left;   /* subtree with keys < key, idx_null if empty */
+  uint        right;  /* subtree with keys > key, idx_null if empty */
+  uint        refcnt; /* number of sets and nodes referring to this node */
+  uint        next;   /* reserved for the pool */
+};
+
+typedef struct fd_bank_keys_node fd_bank_keys_node_t;
+
+#define POOL_NAME  fd_bank_keys_pool
+#define POOL_T     fd_bank_keys_node_t
+#define POOL_IDX_T uint
+#include "../../util/tmpl/fd_pool.c"
+
+struct __attribute__((aligned(128UL))) fd_bank_keys_store {
+  ulong       magic;    /* ==FD_BANK_KEYS_STORE_MAGIC */
+  ulong       seed;     /* treap priority seed */
+  ulong       node_max;
+  fd_rwlock_t lock;     /* serializes node allocation and reference counting */
+  /* node pool follows */
+};
+
+typedef struct fd_bank_keys_store fd_bank_keys_store_t;
+
+/* fd_bank_keys_t is a version of a set.  It is a small handle held by
+   value (e.g. in a fd_bank_t) that refers to nodes in a store.  Copying
+   a handle by value does not create a new version, use
+   fd_bank_keys_share. */
+
+struct fd_bank_keys {
+  long  store_off; /* byte offset of the store relative to this handle */
+  ulong root;      /* pool idx of the root node, idx_null if empty */
+  ulong cnt;       /* number of keys */
+};
+
+typedef struct fd_bank_keys fd_bank_keys_t;
+
+/* fd_bank_keys_iter_t iterates over the keys of a set in increasing
+   order.  The set must not be modified during iteration. */
+
+struct fd_bank_keys_iter {
+  fd_bank_keys_node_t const * pool;
+  ulong                       depth;
+  uint                        stack[ FD_BANK_KEYS_DEPTH_MAX ];
+};
+
+typedef struct fd_bank_keys_iter fd_bank_keys_iter_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_bank_keys_store_{align,footprint,new,join,leave,delete} are the
+   usual object lifecycle functions.  node_max is the number of nodes in
+   the store and should be at least FD_BANK_KEYS_MAX times the number of
+   sets that can exist at the same time, plus FD_BANK_KEYS_DEPTH_MAX.
+   seed is the treap priority seed and should be unpredictable to
+   whoever chooses the keys. */
+
+FD_FN_CONST ulong
+fd_bank_keys_store_align( void );
+
+FD_FN_CONST ulong
+fd_bank_keys_store_footprint( ulong node_max );
+
+void *
+fd_bank_keys_store_new( void * shmem,
+                        ulong  node_max,
+                        ulong  seed );
+
+fd_bank_keys_store_t *
+fd_bank_keys_store_join( void * shstore );
+
+void *
+fd_bank_keys_store_leave( fd_bank_keys_store_t * store );
+
+void *
+fd_bank_keys_store_delete( void * shstore );
+
+/* fd_bank_keys_store_node_free returns the number of free nodes in the
+   store. */
+
+ulong
+fd_bank_keys_store_node_free( fd_bank_keys_store_t * store );
+
+/* fd_bank_keys_store returns the store of keys. */
+
+FD_FN_PURE static inline fd_bank_keys_store_t *
+fd_bank_keys_store( fd_bank_keys_t const * keys ) {
+  return (fd_bank_keys_store_t *)( (ulong)keys + (ulong)keys->store_off );
+}
+
+/* fd_bank_keys_init makes keys an empty set in store.  Any set
+   previously held by keys is leaked, see fd_bank_keys_release. */
+
+void
+fd_bank_keys_init( fd_bank_keys_t *       keys,
+                   fd_bank_keys_store_t * store );
+
+/* fd_bank_keys_share makes dst a new version of the set src in O(1).
+   Subsequent modifications to either set are not visible in the other.
+   Any set previously held by dst is leaked, see fd_bank_keys_release. */
+
+void
+fd_bank_keys_share( fd_bank_keys_t *       dst,
+                    fd_bank_keys_t const * src );
+
+/* fd_bank_keys_release empties keys, freeing the nodes that are not
+   shared with other sets. */
+
+void
+fd_bank_keys_release( fd_bank_keys_t * keys );
+
+/* fd_bank_keys_cnt returns the number of keys in the set. */
+
+FD_FN_PURE static inline ulong
+fd_bank_keys_cnt( fd_bank_keys_t const * keys ) {
+  return keys->cnt;
+}
+
+/* fd_bank_keys_test returns 1 if key is in the set and 0 otherwise. */
+
+FD_FN_PURE int
+fd_bank_keys_test( fd_bank_keys_t const * keys,
+                   fd_pubkey_t const *    key );
+
+/* fd_bank_keys_insert adds key to the set.  Returns 1 if key was added
+   and 0 if it was already in the set.  Logs an error and terminates the
+   process if the set already holds FD_BANK_KEYS_MAX keys (like the map
+   this replaces) or if the store is out of nodes. */
+
+int
+fd_bank_keys_insert( fd_bank_keys_t *    keys,
+                     fd_pubkey_t const * key );
+
+/* fd_bank_keys_remove removes key from the set.  Returns 1 if key was
+   removed and 0 if it was not in the set. */
+
+int
+fd_bank_keys_remove( fd_bank_keys_t *    keys,
+                     fd_pubkey_t const * key );
+
+/* Iteration, e.g.
+
+     fd_bank_keys_iter_t iter[1];
+     for( fd_bank_keys_iter_init( iter, keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
+       fd_pubkey_t const * key = fd_bank_keys_iter_key( iter );
+       ...
+     } */
+
+void
+fd_bank_keys_iter_init( fd_bank_keys_iter_t *  iter,
+                        fd_bank_keys_t const * keys );
+
+static inline int
+fd_bank_keys_iter_done( fd_bank_keys_iter_t const * iter ) {
+  return !iter->depth;
+}
+
+void
+fd_bank_keys_iter_next( fd_bank_keys_iter_t * iter );
+
+static inline fd_pubkey_t const *
+fd_bank_keys_iter_key( fd_bank_keys_iter_t const * iter ) {
+  return &iter->pool[ iter->stack[ iter->depth-1UL ] ].key;
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_fd_bank_keys_h */
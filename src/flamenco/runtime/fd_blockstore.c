@@ -290,6 +290,7 @@ fd_blockstore_init( fd_blockstore_t *      blockstore,
   ele->ticks_consumed        = 0;
   ele->tick_hash_count_accum = 0;
   fd_block_set_null( ele->data_complete_idxs );
+  ele->data_gaddr            = 0;
 
   /* Set all fields to 0. Caller's responsibility to check gaddr and sz != 0. */
 
@@ -311,6 +312,86 @@ fd_blockstore_fini( fd_blockstore_t * blockstore ) {
   }
 }
 
+/* block_data_retire frees the fd_block_data_t at data_gaddr.  The
+   block data must no longer be reachable from the block map.  seq is
+   zeroed first so that concurrent readers still copying it discard
+   their copy. */
+
+static void
+block_data_retire( fd_blockstore_t * blockstore, ulong data_gaddr ) {
+  fd_block_data_t * block_data = fd_wksp_laddr_fast( fd_blockstore_wksp( blockstore ), data_gaddr );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( block_data->seq ) = 0UL;
+  FD_COMPILER_MFENCE();
+  fd_alloc_free( fd_blockstore_alloc( blockstore ), block_data );
+}
+
+/* block_data_publish copies the payloads of the data shreds [0,
+   shred_cnt) of slot, which must all be buffered, into a new
+   fd_block_data_t and publishes it in slot's block_info.  This happens
+   once per slot, when its last shred is buffered, and only if block
+   data publishing is enabled.  If the blockstore alloc is out of
+   memory, the block data is not published and readers fall back to the
+   shred map. */
+
+static void
+block_data_publish( fd_blockstore_t * blockstore, ulong slot, uint shred_cnt ) {
+  ulong data_sz = 0UL;
+  for( uint idx = 0; idx < shred_cnt; idx++ ) {
+    fd_shred_key_t key = { slot, idx };
+    for(;;) { /* speculate */
+      fd_buf_shred_map_query_t query[1] = { 0 };
+      int err = fd_buf_shred_map_query_try( blockstore->shred_map, &key, NULL, query, 0 );
+      if( FD_UNLIKELY( err == FD_MAP_ERR_CORRUPT ) ) FD_LOG_ERR(( "[%s] map corrupt. shred %lu %u", __func__, slot, idx ));
+      if( FD_UNLIKELY( err == FD_MAP_ERR_KEY ) ) return; /* slot is being removed */
+      if( FD_UNLIKELY( err == FD_MAP_ERR_AGAIN ) ) continue;
+      ulong payload_sz = fd_shred_payload_sz( &fd_buf_shred_map_query_ele_const( query )->hdr );
+      if( FD_LIKELY( fd_buf_shred_map_query_test( query ) == FD_MAP_SUCCESS ) ) {
+        data_sz += payload_sz;
+        break;
+      }
+    }
+  }
+
+  fd_wksp_t *       wksp       = fd_blockstore_wksp( blockstore );
+  fd_alloc_t *      alloc      = fd_blockstore_alloc( blockstore );
+  fd_block_data_t * block_data = fd_alloc_malloc( alloc, alignof(fd_block_data_t), sizeof(fd_block_data_t) + data_sz );
+  if( FD_UNLIKELY( !block_data ) ) {
+    FD_LOG_DEBUG(( "[%s] no memory to publish slot %lu block data (%lu bytes)", __func__, slot, data_sz ));
+    return;
+  }
+
+  ulong copy_sz = 0UL;
+  int   err     = fd_blockstore_slice_query( blockstore, slot, 0U, shred_cnt - 1U, data_sz, fd_block_data_payload( block_data ), &copy_sz );
+  if( FD_UNLIKELY( err || copy_sz != data_sz ) ) {
+    fd_alloc_free( alloc, block_data );
+    return;
+  }
+  block_data->slot      = slot;
+  block_data->data_sz   = data_sz;
+  block_data->shred_cnt = shred_cnt;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( block_data->seq ) = FD_ATOMIC_FETCH_AND_ADD( &blockstore->shmem->data_seq, 1UL ) + 1UL;
+  FD_COMPILER_MFENCE();
+
+  /* Publish, unless the slot was removed (or its block data published)
+     in the meantime. */
+
+  fd_block_map_query_t query[1] = { 0 };
+  err = fd_block_map_prepare( blockstore->block_map, &slot, NULL, query, FD_MAP_FLAG_BLOCKING );
+  fd_block_info_t * block_info = fd_block_map_query_ele( query );
+  if( FD_LIKELY( err == FD_MAP_SUCCESS && block_info->slot == slot && !block_info->data_gaddr ) ) {
+    block_info->data_gaddr = fd_wksp_gaddr_fast( wksp, block_data );
+    fd_block_map_publish( query );
+    return;
+  }
+  if( FD_LIKELY( err == FD_MAP_SUCCESS ) ) fd_block_map_cancel( query );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( block_data->seq ) = 0UL;
+  FD_COMPILER_MFENCE();
+  fd_alloc_free( alloc, block_data );
+}
+
 /* Remove a slot from blockstore */
 void
 fd_blockstore_slot_remove( fd_blockstore_t * blockstore, ulong slot ) {
@@ -320,6 +401,7 @@ fd_blockstore_slot_remove( fd_blockstore_t * blockstore, ulong slot ) {
   fd_block_map_query_t query[1] = { 0 };
   ulong parent_slot  = FD_SLOT_NULL;
   ulong received_idx = 0;
+  ulong data_gaddr   = 0;
   int    err  = FD_MAP_ERR_AGAIN;
   while( err == FD_MAP_ERR_AGAIN ) {
     err = fd_block_map_query_try( blockstore->block_map, &slot, NULL, query, 0 );
@@ -332,6 +414,7 @@ fd_blockstore_slot_remove( fd_blockstore_t * blockstore, ulong slot ) {
     }
     parent_slot  = block_info->parent_slot;
     received_idx = block_info->received_idx;
+    data_gaddr   = block_info->data_gaddr;
     err = fd_block_map_query_test( query );
   }
 
@@ -357,6 +440,12 @@ fd_blockstore_slot_remove( fd_blockstore_t * blockstore, ulong slot ) {
     fd_blockstore_shred_remove( blockstore, slot, idx );
   }
 
+  /* Retire the block data.  It is no longer reachable from the block
+     map, but readers that found it before the remove may still be
+     copying it. */
+
+  if( FD_LIKELY( data_gaddr ) ) block_data_retire( blockstore, data_gaddr );
+
   return;
 }
 
@@ -567,6 +656,7 @@ fd_blockstore_shred_insert( fd_blockstore_t * blockstore, fd_shred_t const * shr
     fd_block_set_null( block_info->data_complete_idxs );
 
     block_info->block_gaddr    = 0;
+    block_info->data_gaddr     = 0;
 
     fd_block_map_publish( query );
 
@@ -605,6 +695,11 @@ fd_blockstore_shred_insert( fd_blockstore_t * blockstore, fd_shred_t const * shr
   }
 
   ulong parent_slot       = block_info->parent_slot;
+  uint  slot_complete_idx = block_info->slot_complete_idx;
+  int   publish_data      = FD_VOLATILE_CONST( blockstore->shmem->data_enabled ) &&
+                            slot_complete_idx != FD_SHRED_IDX_NULL &&
+                            block_info->buffered_idx == slot_complete_idx &&
+                            !block_info->data_gaddr;
 
   // FD_LOG_DEBUG(( "shred: (%lu, %u). consumed: %u, received: %u, complete: %u",
   //              slot,
@@ -614,6 +709,11 @@ fd_blockstore_shred_insert( fd_blockstore_t * blockstore, fd_shred_t const * shr
   //              block_info->slot_complete_idx ));
   fd_block_map_publish( query );
 
+  /* Publish the block data as soon as the slot is complete, outside of
+     the block map lock. */
+
+  if( FD_UNLIKELY( publish_data ) ) block_data_publish( blockstore, slot, slot_complete_idx + 1U );
+
   /* Update ancestry metadata: parent_slot, is_connected, next_slot.
 
      If the parent_slot happens to be very old, there's a chance that
@@ -822,6 +922,72 @@ fd_blockstore_slice_query( fd_blockstore_t * blockstore,
   return FD_BLOCKSTORE_SUCCESS;
 }
 
+/* block_data_gaddr_query returns the data_gaddr of slot's block_info,
+   0 if the slot is not in the block map. */
+
+static ulong
+block_data_gaddr_query( fd_blockstore_t * blockstore, ulong slot ) {
+  for(;;) { /* speculate */
+    fd_block_map_query_t query[1] = { 0 };
+    int err = fd_block_map_query_try( blockstore->block_map, &slot, NULL, query, 0 );
+    if( FD_UNLIKELY( err == FD_MAP_ERR_KEY ) )   return 0UL;
+    if( FD_UNLIKELY( err == FD_MAP_ERR_AGAIN ) ) continue;
+    ulong data_gaddr = fd_block_map_query_ele_const( query )->data_gaddr;
+    if( FD_LIKELY( fd_block_map_query_test( query ) == FD_MAP_SUCCESS ) ) return data_gaddr;
+  }
+}
+
+int
+fd_blockstore_block_data_query( fd_blockstore_t * blockstore,
+                                ulong             slot,
+                                ulong             max,
+                                uchar *           buf,
+                                ulong *           buf_sz ) {
+  fd_wksp_t * wksp = fd_blockstore_wksp( blockstore );
+  for(;;) { /* speculative copy of the block data */
+    ulong data_gaddr = 0UL;
+    ulong data_max   = 0UL;
+    for(;;) {
+      fd_block_map_query_t query[1] = { 0 };
+      int err = fd_block_map_query_try( blockstore->block_map, &slot, NULL, query, 0 );
+      if( FD_UNLIKELY( err == FD_MAP_ERR_KEY ) )   return FD_BLOCKSTORE_ERR_KEY;
+      if( FD_UNLIKELY( err == FD_MAP_ERR_AGAIN ) ) continue;
+      fd_block_info_t const * block_info = fd_block_map_query_ele_const( query );
+      data_gaddr = block_info->data_gaddr;
+      data_max   = block_info->slot_complete_idx == FD_SHRED_IDX_NULL ? 0UL : ( (ulong)block_info->slot_complete_idx + 1UL ) * FD_SHRED_MAX_SZ;
+      if( FD_LIKELY( fd_block_map_query_test( query ) == FD_MAP_SUCCESS ) ) break;
+    }
+    if( FD_UNLIKELY( !data_gaddr ) ) return FD_BLOCKSTORE_ERR_EMPTY;
+
+    /* The block data is immutable while seq is unchanged, but it can be
+       retired (and its memory reused) at any point after data_gaddr was
+       read.  So nothing read from it is trusted until the copy has been
+       validated: data_sz is bounded by the slot's own limit and the
+       workspace before it is used, and after the copy both seq and
+       data_gaddr are checked again. */
+
+    fd_block_data_t const * block_data = fd_wksp_laddr_fast( wksp, data_gaddr );
+    ulong seq = FD_VOLATILE_CONST( block_data->seq );
+    FD_COMPILER_MFENCE();
+    ulong data_slot = block_data->slot;
+    ulong data_sz   = block_data->data_sz;
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( !seq || FD_VOLATILE_CONST( block_data->seq ) != seq || data_slot != slot ) ) continue;
+    if( FD_UNLIKELY( data_sz > data_max ) ) continue;
+    if( FD_UNLIKELY( data_sz && !fd_wksp_laddr( wksp, data_gaddr + sizeof(fd_block_data_t) + data_sz - 1UL ) ) ) continue;
+
+    ulong copy_sz = fd_ulong_min( data_sz, max );
+    fd_memcpy( buf, fd_block_data_payload_const( block_data ), copy_sz );
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( block_data->seq ) != seq ) ) continue;
+    if( FD_UNLIKELY( block_data_gaddr_query( blockstore, slot ) != data_gaddr ) ) continue;
+
+    if( FD_UNLIKELY( data_sz > max ) ) return FD_BLOCKSTORE_ERR_NO_MEM;
+    *buf_sz = data_sz;
+    return FD_BLOCKSTORE_SUCCESS;
+  }
+}
+
 int
 fd_blockstore_shreds_complete( fd_blockstore_t * blockstore, ulong slot ){
   //fd_block_t * block_exists = fd_blockstore_block_query( blockstore,  slot );
@@ -212,6 +212,41 @@ struct fd_block_micro {
 };
 typedef struct fd_block_micro fd_block_micro_t;
 
+/* fd_block_data_t is the immutable copy of a completed block.  Once
+   every data shred of a slot has been buffered, the shred inserter
+   copies the shred payloads (ie. the block's entry batches, back to
+   back) into a single allocation from the blockstore alloc and
+   publishes it in the slot's block_info (data_gaddr).  It is never
+   modified afterwards, so readers copy it out without taking any lock
+   and without touching the shred map, see
+   fd_blockstore_block_data_query.
+
+   seq is a seqlock-style version.  It is unique and nonzero while the
+   block data is published and is zeroed before the block data is freed
+   (ie. when the slot is removed).  Readers sample seq, copy, and check
+   seq did not change to detect a concurrent removal.  The payload
+   immediately follows the header. */
+
+#define FD_BLOCK_DATA_ALIGN (128UL)
+
+struct __attribute__((aligned(FD_BLOCK_DATA_ALIGN))) fd_block_data {
+  ulong seq;       /* publication sequence number, 0 if retired */
+  ulong slot;
+  ulong data_sz;   /* payload size in bytes */
+  ulong shred_cnt; /* number of data shreds in the block */
+};
+typedef struct fd_block_data fd_block_data_t;
+
+FD_FN_CONST static inline uchar *
+fd_block_data_payload( fd_block_data_t * block_data ) {
+  return (uchar *)( block_data+1 );
+}
+
+FD_FN_CONST static inline uchar const *
+fd_block_data_payload_const( fd_block_data_t const * block_data ) {
+  return (uchar const *)( block_data+1 );
+}
+
 /* If the 0th bit is set, this indicates the block is preparing, which
    means it might be partially executed e.g. a subset of the microblocks
    have been executed.  It is not safe to remove, relocate, or modify
@@ -313,6 +348,7 @@ struct fd_block_info {
   /* Block */
 
   ulong block_gaddr; /* global address to the start of the allocated fd_block_t */
+  ulong data_gaddr;  /* global address of the published fd_block_data_t, 0 if not published */
 };
 typedef struct fd_block_info fd_block_info_t;
 
@@ -423,6 +459,9 @@ struct __attribute__((aligned(FD_BLOCKSTORE_ALIGN))) fd_blockstore_shmem {
   ulong slot_deque_gaddr; /* deque of slot numbers */
 
   ulong alloc_gaddr;
+
+  ulong data_seq;      /* seq of the most recently published fd_block_data_t */
+  int   data_enabled;  /* non-zero if completed slots publish their block data */
 };
 typedef struct fd_blockstore_shmem fd_blockstore_shmem_t;
 
@@ -770,6 +809,10 @@ fd_blockstore_slot_remove( fd_blockstore_t * blockstore, ulong slot );
    Reasons for error include this shred is already in the blockstore or
    the blockstore is full.
 
+   When the inserted shred completes its slot (all data shreds up to
+   the slot complete shred are buffered), the slot's block data is
+   published, see fd_block_data_t.
+
    fd_blockstore_shred_insert will manage locking, so the caller
    should NOT be acquiring the blockstore read/write lock before
    calling this function. */
@@ -805,6 +848,46 @@ fd_blockstore_slice_query( fd_blockstore_t * blockstore,
                            uchar *           buf,
                            ulong *           buf_sz );
 
+/* fd_blockstore_block_data_query copies the payload of the completed
+   block at slot (the same bytes as a slice query over all of the
+   slot's shreds) into buf, which has room for max bytes.
+
+   Returns FD_BLOCKSTORE_SUCCESS on success, in which case `buf` is
+   populated and `buf_sz` contains the number of bytes copied.  Returns
+   FD_BLOCKSTORE_ERR_KEY if slot is not in the blockstore,
+   FD_BLOCKSTORE_ERR_EMPTY if the slot has no published block data (the
+   slot is not complete yet, block data publishing is disabled or the
+   blockstore alloc was out of memory when it completed; callers can
+   fall back to fd_blockstore_slice_query)
+   and FD_BLOCKSTORE_ERR_NO_MEM if max is too small (buf is clobbered).
+
+   Implementation is lockfree: it reads the published fd_block_data_t
+   optimistically and retries if the slot is removed concurrently.  The
+   block data can be freed while it is being read, so its size is
+   bounded by the slot's shred count before it is used and the copy is
+   only returned once the block map still points at the same block
+   data.  It never writes to the blockstore, so it is safe on read-only
+   joins and does not slow down concurrent shred insertion. */
+
+int
+fd_blockstore_block_data_query( fd_blockstore_t * blockstore,
+                                ulong             slot,
+                                ulong             max,
+                                uchar *           buf,
+                                ulong *           buf_sz );
+
+/* fd_blockstore_block_data_enable sets whether slots that complete
+   from now on publish their block data for
+   fd_blockstore_block_data_query.  Publishing is disabled on a new
+   blockstore: the copies come out of the blockstore alloc, which is
+   shared with deshredding, so it should only be enabled when something
+   reads the block data (i.e. the topology has an RPC server). */
+
+static inline void
+fd_blockstore_block_data_enable( fd_blockstore_t * blockstore, int enable ) {
+  FD_VOLATILE( blockstore->shmem->data_enabled ) = !!enable;
+}
+
 /* fd_blockstore_shreds_complete should be a replacement for anywhere that is
    querying for an fd_block_t * for existence but not actually using the block data.
    Semantically equivalent to query_block( slot ) != NULL.
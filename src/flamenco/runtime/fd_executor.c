@@ -21,6 +21,7 @@
 #include "program/fd_builtin_programs.h"
 #include "program/fd_vote_program.h"
 #include "program/fd_zk_elgamal_proof_program.h"
+#include "program/zksdk/fd_zksdk.h"
 #include "program/fd_bpf_program_util.h"
 #include "sysvar/fd_sysvar_slot_history.h"
 #include "sysvar/fd_sysvar_epoch_schedule.h"
@@ -1323,7 +1324,6 @@ fd_execute_instr( fd_exec_txn_ctx_t * txn_ctx,
       .instr     = instr,
       .txn_ctx   = txn_ctx,
     };
-    fd_base58_encode_32( txn_ctx->accounts[ instr->program_id ].pubkey->uc, NULL, ctx->program_id_base58 );
 
     txn_ctx->instr_trace[ txn_ctx->instr_trace_length - 1 ] = (fd_exec_instr_trace_entry_t) {
       .instr_info = instr,
@@ -1620,6 +1620,9 @@ fd_execute_txn( fd_execute_txn_task_info_t * task_info ) {
   /* Initialize log collection */
   fd_log_collector_init( &txn_ctx->log_collector, txn_ctx->enable_exec_recording );
 
+  /* Verify all the ZK ElGamal proofs of the transaction at once */
+  fd_zksdk_txn_preverify( txn_ctx );
+
   for( ushort i = 0; i < txn_ctx->txn_descriptor->instr_cnt; i++ ) {
     txn_ctx->current_instr_idx = i;
     if( FD_UNLIKELY( dump_insn ) ) {
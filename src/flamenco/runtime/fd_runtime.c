@@ -1534,15 +1534,8 @@ fd_update_stake_delegations( fd_exec_slot_ctx_t * slot_ctx,
   /* At the epoch boundary, release all of the stake account keys
      because at this point all of the changes have been applied to the
      stakes. */
-  fd_account_keys_global_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( slot_ctx->bank );
-  fd_account_keys_pair_t_mapnode_t * account_keys_pool = fd_account_keys_account_keys_pool_join( stake_account_keys );
-  fd_account_keys_pair_t_mapnode_t * account_keys_root = fd_account_keys_account_keys_root_join( stake_account_keys );
-
-  fd_account_keys_pair_t_map_release_tree( account_keys_pool, account_keys_root );
-  account_keys_root = NULL;
-
-  fd_account_keys_account_keys_pool_update( stake_account_keys, account_keys_pool );
-  fd_account_keys_account_keys_root_update( stake_account_keys, account_keys_root );
+  fd_bank_keys_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( stake_account_keys );
   fd_bank_stake_account_keys_end_locking_modify( slot_ctx->bank );
 }
 
@@ -2727,24 +2720,17 @@ fd_runtime_read_genesis( fd_exec_slot_ctx_t * slot_ctx,
   }
 
 
-  fd_account_keys_global_t *         stake_account_keys      = fd_bank_stake_account_keys_locking_modify( slot_ctx->bank );
-  uchar *                            pool_mem                = (uchar *)fd_ulong_align_up( (ulong)stake_account_keys + sizeof(fd_account_keys_global_t), fd_account_keys_pair_t_map_align() );
-  fd_account_keys_pair_t_mapnode_t * stake_account_keys_pool = fd_account_keys_pair_t_map_join( fd_account_keys_pair_t_map_new( pool_mem, 100000UL ) );
-  fd_account_keys_pair_t_mapnode_t * stake_account_keys_root = NULL;
-
-  fd_account_keys_account_keys_pool_update( stake_account_keys, stake_account_keys_pool );
-  fd_account_keys_account_keys_root_update( stake_account_keys, stake_account_keys_root );
+  fd_bank_keys_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( stake_account_keys );
   fd_bank_stake_account_keys_end_locking_modify( slot_ctx->bank );
 
-  fd_account_keys_global_t *         vote_account_keys      = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
-                                     pool_mem               = (uchar *)fd_ulong_align_up( (ulong)vote_account_keys + sizeof(fd_account_keys_global_t), fd_account_keys_pair_t_map_align() );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool = fd_account_keys_pair_t_map_join( fd_account_keys_pair_t_map_new( pool_mem, 100000UL ) );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root = NULL;
-
-  fd_account_keys_account_keys_pool_update( vote_account_keys, vote_account_keys_pool );
-  fd_account_keys_account_keys_root_update( vote_account_keys, vote_account_keys_root );
-
+  fd_bank_keys_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( vote_account_keys );
   fd_bank_vote_account_keys_end_locking_modify( slot_ctx->bank );
+
+  fd_bank_keys_t * removed_vote_account_keys = fd_bank_removed_vote_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( removed_vote_account_keys );
+  fd_bank_removed_vote_account_keys_end_locking_modify( slot_ctx->bank );
 }
 
 /******************************************************************************/
@@ -155,6 +155,15 @@ FD_STATIC_ASSERT( FD_BPF_ALIGN_OF_U128==FD_ACCOUNT_REC_DATA_ALIGN, input_data_al
                                              ((FD_MAX_INSTRUCTION_STACK_DEPTH*FD_RUNTIME_INPUT_REGION_INSN_FOOTPRINT(account_lock_limit, direct_mapping)) + \
                                               ((FD_TXN_MTU-FD_TXN_MIN_SERIALIZED_SZ-account_lock_limit)*8UL)) /* We can have roughly this much duplicate offsets */
 
+/* Without direct mapping, each instruction also allocates a dirty
+   bitmap for its input region, with one bit per 64 bytes of input
+   region (FD_VM_INPUT_DIRTY_LG_CHUNK) rounded up to whole ulongs, plus
+   alignment padding. */
+#define FD_RUNTIME_INPUT_DIRTY_TXN_FOOTPRINT(account_lock_limit, direct_mapping)                                                  \
+                                            ((direct_mapping) ? 0UL :                                                            \
+                                             ((FD_RUNTIME_INPUT_REGION_TXN_FOOTPRINT(account_lock_limit, direct_mapping)>>12) + \
+                                              3UL*FD_MAX_INSTRUCTION_STACK_DEPTH)*sizeof(ulong))
+
 /* Bincode valloc footprint over the execution of a single transaction.
    As well as other footprint specific to each native program type.
 
@@ -189,7 +198,8 @@ FD_STATIC_ASSERT( FD_BPF_ALIGN_OF_U128==FD_ACCOUNT_REC_DATA_ALIGN, input_data_al
      - The instruction with the largest footprint is compact vote state update
        - During instruction decode, this is 9*lockouts_len bytes, MTU bounded
        - During execution, this is vote account get_state() + vote convert_to_current() + 12*lockouts_len bytes + lockouts_len ulong + deq_fd_landed_vote_t_alloc(lockouts_len)
-   Zk Elgamal (0 allocations)
+   Zk Elgamal (0 allocations, the batch for fd_zksdk_txn_preverify is
+     popped before any instruction executes)
 
    The largest footprint is hence deactivate_delinquent, in which the
    two get_state() calls dominate the footprint.  In particular, the
@@ -215,6 +225,7 @@ FD_STATIC_ASSERT( FD_BPF_ALIGN_OF_U128==FD_ACCOUNT_REC_DATA_ALIGN, input_data_al
 #define FD_RUNTIME_TRANSACTION_EXECUTION_FOOTPRINT(account_lock_limit, direct_mapping)                                         \
                                                   (FD_RUNTIME_BORROWED_ACCOUNT_FOOTPRINT                                     + \
                                                    FD_RUNTIME_INPUT_REGION_TXN_FOOTPRINT(account_lock_limit, direct_mapping) + \
+                                                   FD_RUNTIME_INPUT_DIRTY_TXN_FOOTPRINT(account_lock_limit, direct_mapping)  + \
                                                    FD_RUNTIME_BINCODE_AND_NATIVE_FOOTPRINT                                   + \
                                                    FD_RUNTIME_MISC_FOOTPRINT)
 
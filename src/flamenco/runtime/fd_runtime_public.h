@@ -5,6 +5,7 @@
 #include "../types/fd_types.h"
 #include "../../disco/pack/fd_microblock.h"
 #include "../../disco/fd_disco_base.h"
+#include "../../funk/fd_funk_base.h"
 
 /* FIXME: Everything in this file should be migrated to fd_exec.h */
 
@@ -15,6 +16,7 @@
 #define EXEC_HASH_ACCS_SIG             (0x888888UL)
 #define EXEC_SNAP_HASH_ACCS_CNT_SIG    (0x191992UL)
 #define EXEC_SNAP_HASH_ACCS_GATHER_SIG (0x193992UL)
+#define EXEC_BPF_PREWARM_SIG           (0x1b9f77UL)
 
 #define FD_WRITER_BOOT_SIG             (0xAABB0011UL)
 #define FD_WRITER_SLOT_SIG             (0xBBBB1122UL)
@@ -25,6 +27,7 @@
 #define FD_EXEC_STATE_HASH_DONE        (1<<6UL      )
 #define FD_EXEC_STATE_SNAP_CNT_DONE    (1<<8UL      )
 #define FD_EXEC_STATE_SNAP_GATHER_DONE (1<<9UL      )
+#define FD_EXEC_STATE_BPF_PREWARM_DONE (1<<10UL     )
 
 #define FD_WRITER_STATE_NOT_BOOTED     (0UL         )
 #define FD_WRITER_STATE_READY          (1UL         )
@@ -136,6 +139,13 @@ fd_exec_fseq_set_snap_hash_gather_done( void ) {
   return FD_EXEC_STATE_SNAP_GATHER_DONE;
 }
 
+static ulong FD_FN_UNUSED
+fd_exec_fseq_set_bpf_prewarm_done( ulong slot ) {
+  ulong state = ((ulong)slot << 32UL);
+  state      |= FD_EXEC_STATE_BPF_PREWARM_DONE;
+  return state;
+}
+
 static inline int
 fd_exec_fseq_is_not_joined( ulong fseq ) {
   return fseq==ULONG_MAX;
@@ -201,6 +211,22 @@ struct fd_runtime_public_snap_hash_msg {
 };
 typedef struct fd_runtime_public_snap_hash_msg fd_runtime_public_snap_hash_msg_t;
 
+/* fd_runtime_public_bpf_prewarm_msg_t asks an exec tile to help
+   prewarm the program cache, see fd_bpf_program_cache_prewarm.  The
+   tile prewarms the programs in range worker_idx of worker_cnt of the
+   funk record map (see fd_bpf_prewarm_range) until the wallclock
+   reaches deadline, and cache entries are created in the funk txn xid
+   of the root bank. */
+
+struct fd_runtime_public_bpf_prewarm_msg {
+  ulong             worker_idx;
+  ulong             worker_cnt;
+  fd_funk_txn_xid_t xid;
+  ulong             slot;
+  long              deadline;
+};
+typedef struct fd_runtime_public_bpf_prewarm_msg fd_runtime_public_bpf_prewarm_msg_t;
+
 struct fd_runtime_public_exec_writer_boot_msg {
   uint txn_ctx_offset;
 };
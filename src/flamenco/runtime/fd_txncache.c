@@ -111,7 +111,8 @@ typedef struct fd_txncache_private_slotcache fd_txncache_private_slotcache_t;
 struct __attribute__((aligned(FD_TXNCACHE_ALIGN))) fd_txncache_private {
   fd_rwlock_t lock[ 1 ]; /* The txncache is a concurrent structure and will be accessed by multiple threads
                             concurrently.  Insertion and querying only take a read lock as they can be done
-                            lockless but all other operations will take a write lock internally. */
+                            lockless but all other operations will take a write lock internally, except
+                            for snapshot iteration (see below). */
 
   ulong  root_slots_max;
   ulong  live_slots_max;
@@ -154,6 +155,31 @@ struct __attribute__((aligned(FD_TXNCACHE_ALIGN))) fd_txncache_private {
                                Overflow for index i is defined as every entry j > i where j should have
                                been inserted at k < i. */
 
+  ulong snapshot_epoch; /* Incremented when a snapshot iteration begins and again when it ends, so it is
+                           odd while one is in progress.  Snapshot iteration reads the slotcaches of the
+                           root slots without holding the lock.  This is safe because rooted slots are
+                           not modified, and while the epoch is odd nothing is removed from the cache:
+                           purging is the only operation that frees blockcaches, slotcaches and txnpages,
+                           and it is deferred until the iteration ends.  Insertion and query are not
+                           affected and proceed concurrently with the iteration. */
+
+  ulong purge_deferred_slot; /* The highest slot whose purge was deferred because a snapshot iteration
+                                was in progress, or ULONG_MAX if none.  Purging a slot purges all older
+                                slots too, so only the highest one needs to be remembered. */
+
+  ulong purge_deferred_cnt; /* The number of purges deferred by the current snapshot iteration.  Every
+                               deferred purge keeps (at least) one more slot alive in the blockcache and
+                               slotcache, so this is capped at purge_deferred_max, leaving the rest of the
+                               live slots beyond the roots for unrooted forks.  A root registration that
+                               exceeds the cap asks the iteration to stop (snapshot_abort) and waits for it
+                               to end, so it can purge. */
+  ulong purge_deferred_max;
+  int   snapshot_abort;
+
+  ulong snapshot_root_slots_cnt; /* The root slots as of the start of the snapshot iteration.  These are */
+  ulong snapshot_root_slots_off; /* the slots that are serialized, even if newer roots are registered
+                                    while the iteration is in progress. */
+
   ulong magic; /* ==FD_TXNCACHE_MAGIC */
 };
 
@@ -162,6 +188,11 @@ fd_txncache_get_root_slots( fd_txncache_t * tc ) {
   return (ulong *)( (uchar *)tc + tc->root_slots_off );
 }
 
+FD_FN_PURE static ulong *
+fd_txncache_get_snapshot_root_slots( fd_txncache_t * tc ) {
+  return (ulong *)( (uchar *)tc + tc->snapshot_root_slots_off );
+}
+
 FD_FN_PURE static fd_txncache_private_blockcache_t *
 fd_txncache_get_blockcache( fd_txncache_t * tc ) {
   return (fd_txncache_private_blockcache_t *)( (uchar *)tc + tc->blockcache_off );
@@ -279,6 +310,7 @@ fd_txncache_footprint( ulong max_rooted_slots,
   l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, FD_TXNCACHE_ALIGN,                         sizeof(fd_txncache_t)                                   );
   l = FD_LAYOUT_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                          ); /* root_slots */
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                          ); /* snapshot_root_slots */
   l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_blockcache_t), max_live_slots*sizeof(fd_txncache_private_blockcache_t) ); /* blockcache */
   l = FD_LAYOUT_APPEND( l, alignof(uint),                             max_live_slots*max_txnpages_per_blockhash*sizeof(uint)  ); /* blockcache->pages */
   l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_slotcache_t),  max_live_slots*sizeof(fd_txncache_private_slotcache_t ) ); /* slotcache */
@@ -320,6 +352,7 @@ fd_txncache_new( void * shmem,
   FD_SCRATCH_ALLOC_INIT( l, shmem );
   fd_txncache_t * txncache  = FD_SCRATCH_ALLOC_APPEND( l,  FD_TXNCACHE_ALIGN,                        sizeof(fd_txncache_t)                                   );
   void * _root_slots        = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                          );
+  void * _snap_root_slots   = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                          );
   void * _blockcache        = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_blockcache_t), max_live_slots*sizeof(fd_txncache_private_blockcache_t) );
   void * _blockcache_pages  = FD_SCRATCH_ALLOC_APPEND( l, alignof(uint),                             max_live_slots*max_txnpages_per_blockhash*sizeof(uint)  );
   void * _slotcache         = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_slotcache_t),  max_live_slots*sizeof(fd_txncache_private_slotcache_t ) );
@@ -329,6 +362,7 @@ fd_txncache_new( void * shmem,
 
   /* We calculate and store the offsets for these allocations. */
   txncache->root_slots_off        = (ulong)_root_slots - (ulong)txncache;
+  txncache->snapshot_root_slots_off = (ulong)_snap_root_slots - (ulong)txncache;
   txncache->blockcache_off        = (ulong)_blockcache - (ulong)txncache;
   txncache->slotcache_off         = (ulong)_slotcache - (ulong)txncache;
   txncache->txnpages_free_off     = (ulong)_txnpages_free - (ulong)txncache;
@@ -339,6 +373,13 @@ fd_txncache_new( void * shmem,
   tc->lock->value           = 0;
   tc->root_slots_cnt        = 0UL;
 
+  tc->snapshot_epoch          = 0UL;
+  tc->purge_deferred_slot     = ULONG_MAX;
+  tc->purge_deferred_cnt      = 0UL;
+  tc->purge_deferred_max      = (max_live_slots-max_rooted_slots)/2UL;
+  tc->snapshot_abort          = 0;
+  tc->snapshot_root_slots_cnt = 0UL;
+
   tc->root_slots_max             = max_rooted_slots;
   tc->live_slots_max             = max_live_slots;
   tc->txnpages_per_blockhash_max = max_txnpages_per_blockhash;
@@ -508,6 +549,21 @@ fd_txncache_purge_slot( fd_txncache_t * tc,
   }
 }
 
+/* fd_txncache_purge_slot_or_defer purges slot, or if a snapshot
+   iteration is in progress, remembers to purge it once the iteration
+   ends.  Assumes the caller holds the write lock. */
+
+static void
+fd_txncache_purge_slot_or_defer( fd_txncache_t * tc,
+                                 ulong           slot ) {
+  if( FD_UNLIKELY( tc->snapshot_epoch & 1UL ) ) {
+    if( tc->purge_deferred_slot==ULONG_MAX || slot>tc->purge_deferred_slot ) tc->purge_deferred_slot = slot;
+    tc->purge_deferred_cnt++;
+    return;
+  }
+  fd_txncache_purge_slot( tc, slot );
+}
+
 /* fd_txncache_register_root_slot_private is a helper function that
    actually registers the root. This function assumes that the
    caller has already obtained a lock to the status cache. */
@@ -525,11 +581,11 @@ fd_txncache_register_root_slot_private( fd_txncache_t * tc,
 
   if( FD_UNLIKELY( tc->root_slots_cnt>=tc->root_slots_max ) ) {
     if( FD_LIKELY( idx ) ) {
-      fd_txncache_purge_slot( tc, root_slots[ 0 ] );
+      fd_txncache_purge_slot_or_defer( tc, root_slots[ 0 ] );
       memmove( root_slots, root_slots+1UL, (idx-1UL)*sizeof(ulong) );
       root_slots[ (idx-1UL) ] = slot;
     } else {
-      fd_txncache_purge_slot( tc, slot );
+      fd_txncache_purge_slot_or_defer( tc, slot );
     }
   } else {
     if( FD_UNLIKELY( idx<tc->root_slots_cnt ) ) {
@@ -548,16 +604,28 @@ fd_txncache_register_root_slot( fd_txncache_t * tc,
 
   fd_txncache_register_root_slot_private( tc, slot );
 
+  /* Too many purges were deferred by a snapshot iteration, stop it
+     before the cache runs out of live slots.  The iteration reads the
+     cache without the lock, so wait for it to end (which runs the
+     deferred purge) before returning. */
+
+  while( FD_UNLIKELY( (tc->snapshot_epoch & 1UL) && tc->purge_deferred_cnt>tc->purge_deferred_max ) ) {
+    FD_VOLATILE( tc->snapshot_abort ) = 1;
+    fd_rwlock_unwrite( tc->lock );
+    FD_SPIN_PAUSE();
+    fd_rwlock_write( tc->lock );
+  }
+
   fd_rwlock_unwrite( tc->lock );
 }
 
 void
 fd_txncache_root_slots( fd_txncache_t * tc,
                         ulong *         out_slots ) {
-  fd_rwlock_write( tc->lock );
+  fd_rwlock_read( tc->lock );
   ulong * root_slots = fd_txncache_get_root_slots( tc );
   memcpy( out_slots, root_slots, tc->root_slots_max*sizeof(ulong) );
-  fd_rwlock_unwrite( tc->lock );
+  fd_rwlock_unread( tc->lock );
 }
 
 #define FD_TXNCACHE_FIND_FOUND      (0)
@@ -842,6 +910,41 @@ fd_txncache_insert_txn( fd_txncache_t *                        tc,
   }
 }
 
+/* fd_txncache_insert_private inserts a single transaction result.
+   Assumes the caller holds the read lock.  Returns 1 on success and 0
+   if the txn cache is full. */
+
+static int
+fd_txncache_insert_private( fd_txncache_t *              tc,
+                            fd_txncache_insert_t const * txn ) {
+  fd_txncache_private_blockcache_t * blockcache;
+  if( FD_UNLIKELY( !fd_txncache_ensure_blockcache( tc, txn->blockhash, &blockcache ) ) ) {
+    FD_LOG_WARNING(( "no blockcache found" ));
+    return 0;
+  }
+
+  fd_txncache_private_slotcache_t * slotcache;
+  if( FD_UNLIKELY( !fd_txncache_ensure_slotcache( tc, txn->slot, &slotcache ) ) ) {
+    FD_LOG_WARNING(( "no slotcache found" ));
+    return 0;
+  }
+
+  fd_txncache_private_slotblockcache_t * slotblockcache;
+  if( FD_UNLIKELY( !fd_txncache_ensure_slotblockcache( slotcache, txn->blockhash, &slotblockcache ) ) ) {
+    FD_LOG_WARNING(( "no slotblockcache found" ));
+    return 0;
+  }
+
+  for(;;) {
+    fd_txncache_private_txnpage_t * txnpage = fd_txncache_ensure_txnpage( tc, blockcache );
+    if( FD_UNLIKELY( !txnpage ) ) return 0;
+
+    int success = fd_txncache_insert_txn( tc, blockcache, slotblockcache, txnpage, txn );
+    if( FD_LIKELY( success ) ) return 1;
+    FD_SPIN_PAUSE();
+  }
+}
+
 int
 fd_txncache_insert_batch( fd_txncache_t *              tc,
                           fd_txncache_insert_t const * txns,
@@ -849,43 +952,14 @@ fd_txncache_insert_batch( fd_txncache_t *              tc,
   fd_rwlock_read( tc->lock );
 
   for( ulong i=0UL; i<txns_cnt; i++ ) {
-    fd_txncache_private_blockcache_t * blockcache;
-    if( FD_UNLIKELY( !fd_txncache_ensure_blockcache( tc, txns[ i ].blockhash, &blockcache ) ) ) {
-      FD_LOG_WARNING(( "no blockcache found" ));
-      goto unlock_fail;
-    }
-
-    fd_txncache_private_slotcache_t * slotcache;
-    if( FD_UNLIKELY( !fd_txncache_ensure_slotcache( tc, txns[ i ].slot, &slotcache ) ) ) {
-      FD_LOG_WARNING(( "no slotcache found" ));
-      goto unlock_fail;
-    }
-
-    fd_txncache_private_slotblockcache_t * slotblockcache;
-    if( FD_UNLIKELY( !fd_txncache_ensure_slotblockcache( slotcache, txns[ i ].blockhash, &slotblockcache ) ) ) {
-      FD_LOG_WARNING(( "no slotblockcache found" ));
-      goto unlock_fail;
-    }
-
-    for(;;) {
-      fd_txncache_private_txnpage_t * txnpage = fd_txncache_ensure_txnpage( tc, blockcache );
-      if( FD_UNLIKELY( !txnpage ) ) {
-        goto unlock_fail;
-        FD_LOG_WARNING(( "no txnpage found" ));
-      }
-
-      int success = fd_txncache_insert_txn( tc, blockcache, slotblockcache, txnpage, &txns[ i ] );
-      if( FD_LIKELY( success ) ) break;
-      FD_SPIN_PAUSE();
+    if( FD_UNLIKELY( !fd_txncache_insert_private( tc, &txns[ i ] ) ) ) {
+      fd_rwlock_unread( tc->lock );
+      return 0;
     }
   }
 
   fd_rwlock_unread( tc->lock );
   return 1;
-
-unlock_fail:
-  fd_rwlock_unread( tc->lock );
-  return 0;
 }
 
 void
@@ -924,6 +998,49 @@ fd_txncache_query_batch( fd_txncache_t *             tc,
   fd_rwlock_unread( tc->lock );
 }
 
+/* fd_txncache_snapshot_begin starts a snapshot iteration.  It takes
+   the write lock just long enough to flip the epoch and copy the root
+   slots, so the iteration sees the roots as of this point, and the
+   caller then reads their slotcaches without holding the lock.  Only
+   one snapshot iteration can be in progress at a time, others wait for
+   it to end.  Returns the number of root slots. */
+
+static ulong
+fd_txncache_snapshot_begin( fd_txncache_t * tc ) {
+  for(;;) {
+    fd_rwlock_write( tc->lock );
+    if( FD_LIKELY( !(tc->snapshot_epoch & 1UL) ) ) break;
+    fd_rwlock_unwrite( tc->lock );
+    FD_SPIN_PAUSE();
+  }
+
+  tc->snapshot_epoch++;
+  tc->snapshot_abort = 0;
+  memcpy( fd_txncache_get_snapshot_root_slots( tc ), fd_txncache_get_root_slots( tc ), tc->root_slots_cnt*sizeof(ulong) );
+  tc->snapshot_root_slots_cnt = tc->root_slots_cnt;
+
+  fd_rwlock_unwrite( tc->lock );
+  return tc->snapshot_root_slots_cnt;
+}
+
+/* fd_txncache_snapshot_end ends a snapshot iteration and runs the purge
+   of roots that were registered while it was in progress. */
+
+static void
+fd_txncache_snapshot_end( fd_txncache_t * tc ) {
+  fd_rwlock_write( tc->lock );
+
+  tc->snapshot_epoch++;
+  tc->snapshot_abort     = 0;
+  tc->purge_deferred_cnt = 0UL;
+  if( FD_UNLIKELY( tc->purge_deferred_slot!=ULONG_MAX ) ) {
+    fd_txncache_purge_slot( tc, tc->purge_deferred_slot );
+    tc->purge_deferred_slot = ULONG_MAX;
+  }
+
+  fd_rwlock_unwrite( tc->lock );
+}
+
 int
 fd_txncache_snapshot( fd_txncache_t * tc,
                       void *          ctx,
@@ -932,11 +1049,12 @@ fd_txncache_snapshot( fd_txncache_t * tc,
     FD_LOG_WARNING(("No write method provided to snapshotter"));
     return 1;
   }
-  fd_rwlock_read( tc->lock );
+
+  ulong root_slots_cnt = fd_txncache_snapshot_begin( tc );
 
   fd_txncache_private_txnpage_t * txnpages = fd_txncache_get_txnpages( tc );
-  ulong * root_slots = fd_txncache_get_root_slots( tc );
-  for( ulong i=0UL; i<tc->root_slots_cnt; i++ ) {
+  ulong * root_slots = fd_txncache_get_snapshot_root_slots( tc );
+  for( ulong i=0UL; i<root_slots_cnt; i++ ) {
     ulong slot = root_slots[ i ];
 
     fd_txncache_private_slotcache_t * slotcache;
@@ -960,15 +1078,20 @@ fd_txncache_snapshot( fd_txncache_t * tc,
           fd_memcpy( entry.txnhash, txn->txnhash, 20 );
           int err = write( (uchar*)&entry, sizeof(fd_txncache_snapshot_entry_t), ctx );
           if( err ) {
-            fd_rwlock_unread( tc->lock );
+            fd_txncache_snapshot_end( tc );
             return err;
           }
+          if( FD_UNLIKELY( FD_VOLATILE_CONST( tc->snapshot_abort ) ) ) {
+            FD_LOG_WARNING(( "snapshot aborted, too many roots were registered while it was being written" ));
+            fd_txncache_snapshot_end( tc );
+            return -1;
+          }
         }
       }
     }
   }
 
-  fd_rwlock_unread( tc->lock );
+  fd_txncache_snapshot_end( tc );
   return 0;
 }
 
@@ -1020,17 +1143,24 @@ fd_txncache_get_entries( fd_txncache_t *         tc,
                          fd_bank_slot_deltas_t * slot_deltas,
                          fd_spad_t *             spad ) {
 
-  fd_rwlock_read( tc->lock );
+  ulong root_slots_cnt = fd_txncache_snapshot_begin( tc );
 
-  slot_deltas->slot_deltas_len = tc->root_slots_cnt;
-  slot_deltas->slot_deltas     = fd_spad_alloc( spad, FD_SLOT_DELTA_ALIGN, tc->root_slots_cnt * sizeof(fd_slot_delta_t) );
+  slot_deltas->slot_deltas_len = root_slots_cnt;
+  slot_deltas->slot_deltas     = fd_spad_alloc( spad, FD_SLOT_DELTA_ALIGN, root_slots_cnt * sizeof(fd_slot_delta_t) );
 
   fd_txncache_private_txnpage_t * txnpages   = fd_txncache_get_txnpages( tc );
-  ulong                         * root_slots = fd_txncache_get_root_slots( tc );
+  ulong                         * root_slots = fd_txncache_get_snapshot_root_slots( tc );
 
-  for( ulong i=0UL; i<tc->root_slots_cnt; i++ ) {
+  for( ulong i=0UL; i<root_slots_cnt; i++ ) {
     ulong slot = root_slots[ i ];
 
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( tc->snapshot_abort ) ) ) {
+      FD_LOG_WARNING(( "snapshot aborted, too many roots were registered while it was being written" ));
+      slot_deltas->slot_deltas_len = i;
+      fd_txncache_snapshot_end( tc );
+      return 1;
+    }
+
     slot_deltas->slot_deltas[ i ].slot               = slot;
     slot_deltas->slot_deltas[ i ].is_root            = 1;
     slot_deltas->slot_deltas[ i ].slot_delta_vec     = fd_spad_alloc( spad, FD_STATUS_PAIR_ALIGN, FD_TXNCACHE_DEFAULT_MAX_ROOTED_SLOTS * sizeof(fd_status_pair_t) );
@@ -1081,7 +1211,7 @@ fd_txncache_get_entries( fd_txncache_t *         tc,
     slot_deltas->slot_deltas[ i ].slot_delta_vec_len = slot_delta_vec_len;
   }
 
-  fd_rwlock_unread( tc->lock );
+  fd_txncache_snapshot_end( tc );
 
   return 0;
 
@@ -25,7 +25,11 @@
    Both of these operations are concurrent and lockless, assuming there
    are no other (non-insert/query) operations occuring on the txn cache.
    Most other operations lock the entire structure and will prevent both
-   insertion and query from proceeding.
+   insertion and query from proceeding.  The exception is serializing
+   the root slots for a snapshot, which takes the lock only momentarily
+   at the start and end, and defers purging of old roots until it is
+   done, so that it can iterate the rooted slots while inserts and
+   queries continue.
 
    The txn cache is both CPU and memory sensitive.  A transaction result
    is 1 byte, and the stored transaction hashes are 20 bytes, so
@@ -294,7 +298,13 @@ fd_txncache_delete( void * shtc );
 
    This is neither cheap or expensive, it will pause all insertion and
    query operations but only momentarily until any old slots can be
-   purged from the cache. */
+   purged from the cache.  If a snapshot is being serialized, the purge
+   is deferred until serialization completes, and transactions that
+   would have been purged remain queryable until then.  Deferred purges
+   keep slots alive, so once more than half of the live slots beyond
+   the roots, (max_live_slots-max_rooted_slots)/2, have been deferred,
+   this stops the snapshot and waits for it to end, after which the
+   purge runs. */
 
 void
 fd_txncache_register_root_slot( fd_txncache_t * tc,
@@ -308,8 +318,8 @@ fd_txncache_register_root_slot( fd_txncache_t * tc,
    in the cache, the front part of out_slots will be filled in, and all
    the remaining slots will be set to ULONG_MAX.
 
-   This is a fast operation, but it will lock the whole structure and
-   cause a temporary pause in insert and query operations. */
+   This is a fast operation and will not pause insert and query
+   operations. */
 
 void
 fd_txncache_root_slots( fd_txncache_t * tc,
@@ -324,6 +334,16 @@ fd_txncache_root_slots( fd_txncache_t * tc,
    the caller immediately, so this function also returns 0 on success
    and -1 on failure.
 
+   The snapshot contains the root slots as of the start of the call.
+   Roots registered while the snapshot is being written are not
+   included, and purging of old roots is deferred until the snapshot is
+   written, so the output is a consistent view of the root set.  If too
+   many roots are registered while the snapshot is being written (see
+   fd_txncache_register_root_slot), the snapshot is stopped and this
+   returns -1.  Only one snapshot (or fd_txncache_get_entries) can be in
+   progress at a time, concurrent callers wait for the previous one to
+   finish.
+
    IMPORTANT!  THIS ASSUMES THERE ARE NO CONCURRENT INSERTS OCCURING ON
    THE TXN CACHE AT THE ROOT SLOTS DURING SNAPSHOTTING.  OTHERWISE THE
    SNAPSHOT MIGHT BE NOT CONTAIN ALL OF THE DATA, ALTHOUGH IT WILL NOT
@@ -331,7 +351,8 @@ fd_txncache_root_slots( fd_txncache_t * tc,
    ROOTED SLOT.
 
    This is a cheap operation and will not cause any pause in insertion
-   or query operations. */
+   or query operations.  Root registration is only blocked when it has
+   to stop the snapshot, until the write in progress returns. */
 
 int
 fd_txncache_snapshot( fd_txncache_t * tc,
@@ -401,7 +422,10 @@ fd_txncache_is_rooted_slot( fd_txncache_t * tc,
 /* fd_txncache_get_entries is responsible for converting the rooted state of
    the status cache back into fd_bank_slot_deltas_t, which is the decoded
    format used by Agave. This is a helper method used to generate Agave-
-   compatible snapshots. */
+   compatible snapshots.  Like fd_txncache_snapshot, it does not pause
+   insertion and query operations, and it is stopped (returning 1 with
+   slot_deltas holding only the slots done so far) if too many roots are
+   registered while it is in progress.  Returns 0 on success. */
 
 int
 fd_txncache_get_entries( fd_txncache_t *         tc,
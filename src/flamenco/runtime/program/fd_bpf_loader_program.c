@@ -16,6 +16,9 @@
 
 #include <stdlib.h>
 
+/* FD_RUNTIME_INPUT_DIRTY_TXN_FOOTPRINT assumes 64 byte chunks */
+FD_STATIC_ASSERT( FD_VM_INPUT_DIRTY_LG_CHUNK==6UL, input_dirty_footprint );
+
 static char * trace_buf;
 
 static void __attribute__((constructor)) make_buf(void) {
@@ -494,6 +497,17 @@ fd_bpf_execute( fd_exec_instr_ctx_t * instr_ctx, fd_sbpf_validated_program_t con
     return FD_EXECUTOR_INSTR_ERR_PROGRAM_ENVIRONMENT_SETUP_FAILURE;
   }
 
+  /* Without direct mapping, track writes to the input region so that
+     deserialization only has to look at account data the program
+     possibly modified. */
+  ulong * input_dirty = NULL;
+  if( !direct_mapping ) {
+    ulong input_dirty_sz = fd_vm_input_dirty_footprint( input_sz );
+    input_dirty = fd_spad_alloc( instr_ctx->txn_ctx->spad, alignof(ulong), input_dirty_sz );
+    fd_memset( input_dirty, 0, input_dirty_sz );
+    vm->input_dirty = input_dirty;
+  }
+
 #ifdef FD_DEBUG_SBPF_TRACES
   uchar * signature = (uchar*)vm->instr_ctx->txn_ctx->_txn_raw->raw + vm->instr_ctx->txn_ctx->txn_descriptor->signature_off;
   uchar sig[64];
@@ -633,7 +647,7 @@ fd_bpf_execute( fd_exec_instr_ctx_t * instr_ctx, fd_sbpf_validated_program_t con
     return FD_EXECUTOR_INSTR_ERR_PROGRAM_FAILED_TO_COMPLETE;
   }
 
-  err = fd_bpf_loader_input_deserialize_parameters( instr_ctx, pre_lens, input, input_sz, direct_mapping, is_deprecated );
+  err = fd_bpf_loader_input_deserialize_parameters( instr_ctx, pre_lens, input, input_sz, input_dirty, direct_mapping, is_deprecated );
   if( FD_UNLIKELY( err ) ) {
     return err;
   }
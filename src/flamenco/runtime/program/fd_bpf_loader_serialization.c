@@ -59,6 +59,85 @@ new_input_mem_region( fd_vm_input_region_t * input_mem_regions,
   (*input_mem_regions_cnt)++;
 }
 
+/* When direct mapping is not enabled, the vm tracks which chunks of the
+   input region were possibly written during execution (see
+   FD_VM_INPUT_DIRTY_LG_CHUNK).  Clean chunks of an account's serialized
+   data are still equal to the account's data: nothing but the program
+   writes to the input region, and the only other writer of the
+   account's data during execution is a CPI, which marks the whole
+   serialized entry of every account it passes on dirty (the AccountInfo
+   data pointer is not checked without direct mapping, so the callee's
+   changes are not necessarily written through the input region
+   translation).  So copying out or comparing the serialized data only
+   needs to look at dirty chunks.  input_dirty is NULL if writes were not
+   tracked, in which case all serialized data is treated as dirty. */
+
+/* set_data_from_input sets the data of acc to the post_len bytes of
+   serialized data at input+data_off.  Equivalent to
+   fd_borrowed_account_set_data_from_slice. */
+static int
+set_data_from_input( fd_borrowed_account_t * acc,
+                     uchar const *           input,
+                     ulong const *           input_dirty,
+                     ulong                   data_off,
+                     ulong                   post_len ) {
+  if( !input_dirty ) {
+    return fd_borrowed_account_set_data_from_slice( acc, input+data_off, post_len );
+  }
+
+  /* Same checks and resize delta as set_data_from_slice, bytes gained
+     by the resize are zeroed here and overwritten below. */
+  ulong cur_len = fd_borrowed_account_get_data_len( acc );
+  int err = fd_borrowed_account_set_data_length( acc, post_len );
+  if( FD_UNLIKELY( err ) ) {
+    return err;
+  }
+
+  uchar * data = NULL;
+  err = fd_borrowed_account_get_data_mut( acc, &data, NULL );
+  if( FD_UNLIKELY( err ) ) {
+    return err;
+  }
+
+  /* Bytes that were in the account before are only stale if dirty, the
+     rest comes from the realloc area and is copied unconditionally. */
+  ulong clean_end = data_off + fd_ulong_min( cur_len, post_len );
+  ulong lo        = fd_vm_input_dirty_find( input_dirty, data_off, clean_end, 1 );
+  while( lo<clean_end ) {
+    ulong hi = fd_vm_input_dirty_find( input_dirty, lo, clean_end, 0 );
+    fd_memcpy( data+(lo-data_off), input+lo, hi-lo );
+    lo = fd_vm_input_dirty_find( input_dirty, hi, clean_end, 1 );
+  }
+  if( post_len>cur_len ) {
+    fd_memcpy( data+cur_len, input+data_off+cur_len, post_len-cur_len );
+  }
+  return FD_EXECUTOR_INSTR_SUCCESS;
+}
+
+/* data_differs_from_input returns 0 if the len bytes of serialized data
+   at input+data_off are equal to the data of acc and non-zero
+   otherwise.  Assumes the data of acc is at least len bytes. */
+static int
+data_differs_from_input( fd_borrowed_account_t const * acc,
+                         uchar const *                 input,
+                         ulong const *                 input_dirty,
+                         ulong                         data_off,
+                         ulong                         len ) {
+  uchar const * data = fd_borrowed_account_get_data( acc );
+  if( !input_dirty ) {
+    return memcmp( data, input+data_off, len );
+  }
+
+  ulong end = data_off + len;
+  ulong lo  = fd_vm_input_dirty_find( input_dirty, data_off, end, 1 );
+  while( lo<end ) {
+    ulong hi = fd_vm_input_dirty_find( input_dirty, lo, end, 0 );
+    if( memcmp( data+(lo-data_off), input+lo, hi-lo ) ) return 1;
+    lo = fd_vm_input_dirty_find( input_dirty, hi, end, 1 );
+  }
+  return 0;
+}
+
 /* https://github.com/anza-xyz/agave/blob/b5f5c3cdd3f9a5859c49ebc27221dc27e143d760/programs/bpf_loader/src/serialization.rs#L93-L130 */
 /* This function handles casing for direct mapping being enabled as well as if
    the alignment is being stored. In the case where direct mapping is not
@@ -326,6 +405,7 @@ fd_bpf_loader_input_deserialize_aligned( fd_exec_instr_ctx_t * ctx,
                                          ulong const *         pre_lens,
                                          uchar *               buffer,
                                          ulong FD_FN_UNUSED    buffer_sz,
+                                         ulong const *         input_dirty,
                                          int                   copy_account_data ) {
   /* TODO: An optimization would be to skip ahead through non-writable accounts */
   /* https://github.com/anza-xyz/agave/blob/b5f5c3cdd3f9a5859c49ebc27221dc27e143d760/programs/bpf_loader/src/serialization.rs#L507 */
@@ -377,8 +457,6 @@ fd_bpf_loader_input_deserialize_aligned( fd_exec_instr_ctx_t * ctx,
       ulong pre_len = pre_lens[i];
       ulong alignment_offset = fd_ulong_align_up( pre_len, FD_BPF_ALIGN_OF_U128 ) - pre_len;
 
-      uchar * post_data = buffer+start;
-
       fd_account_meta_t const * metadata_check = fd_borrowed_account_get_acc_meta( &view_acc );
       if( FD_UNLIKELY( fd_ulong_sat_sub( post_len, metadata_check->dlen )>MAX_PERMITTED_DATA_INCREASE ||
                        post_len>MAX_PERMITTED_DATA_LENGTH ) ) {
@@ -391,13 +469,13 @@ fd_bpf_loader_input_deserialize_aligned( fd_exec_instr_ctx_t * ctx,
         if( fd_borrowed_account_can_data_be_resized( &view_acc, post_len, &err ) &&
             fd_borrowed_account_can_data_be_changed( &view_acc, &err ) ) {
 
-          int err = fd_borrowed_account_set_data_from_slice( &view_acc, post_data, post_len );
+          int err = set_data_from_input( &view_acc, buffer, input_dirty, start, post_len );
           if( FD_UNLIKELY( err ) ) {
             return err;
           }
 
         } else if( FD_UNLIKELY( fd_borrowed_account_get_data_len( &view_acc )!=post_len ||
-                                memcmp( fd_borrowed_account_get_data( &view_acc ), post_data, post_len ) ) ) {
+                                data_differs_from_input( &view_acc, buffer, input_dirty, start, post_len ) ) ) {
           return err;
         }
         start += pre_len;
@@ -605,6 +683,7 @@ fd_bpf_loader_input_deserialize_unaligned( fd_exec_instr_ctx_t * ctx,
                                            ulong const *         pre_lens,
                                            uchar *               input,
                                            ulong                 input_sz,
+                                           ulong const *         input_dirty,
                                            int                   copy_account_data ) {
   uchar *       input_cursor      = input;
   uchar         acc_idx_seen[256] = {0};
@@ -639,18 +718,18 @@ fd_bpf_loader_input_deserialize_unaligned( fd_exec_instr_ctx_t * ctx,
       input_cursor += sizeof(ulong); /* data length */
 
       if( copy_account_data ) {
-        ulong   pre_len   = pre_lens[i];
-        uchar * post_data = input_cursor;
+        ulong pre_len  = pre_lens[i];
+        ulong data_off = (ulong)(input_cursor - input);
         if( fd_borrowed_account_get_acc_meta( &view_acc ) ) {
           int err = 0;
           if( fd_borrowed_account_can_data_be_resized( &view_acc, pre_len, &err ) &&
               fd_borrowed_account_can_data_be_changed( &view_acc, &err ) ) {
-            err = fd_borrowed_account_set_data_from_slice( &view_acc, post_data, pre_len );
+            err = set_data_from_input( &view_acc, input, input_dirty, data_off, pre_len );
             if( FD_UNLIKELY( err ) ) {
               return err;
             }
           } else if( fd_borrowed_account_get_data_len( &view_acc ) != pre_len ||
-                     memcmp( post_data, fd_borrowed_account_get_data( &view_acc ), pre_len ) ) {
+                     data_differs_from_input( &view_acc, input, input_dirty, data_off, pre_len ) ) {
             return err;
           }
         }
@@ -712,11 +791,12 @@ fd_bpf_loader_input_deserialize_parameters( fd_exec_instr_ctx_t * ctx,
                                             ulong const *         pre_lens,
                                             uchar *               input,
                                             ulong                 input_sz,
+                                            ulong const *         input_dirty,
                                             int                   direct_mapping,
                                             uchar                 is_deprecated ) {
   if( FD_UNLIKELY( is_deprecated ) ) {
-    return fd_bpf_loader_input_deserialize_unaligned( ctx, pre_lens, input, input_sz, !direct_mapping );
+    return fd_bpf_loader_input_deserialize_unaligned( ctx, pre_lens, input, input_sz, input_dirty, !direct_mapping );
   } else {
-    return fd_bpf_loader_input_deserialize_aligned( ctx, pre_lens, input, input_sz, !direct_mapping );
+    return fd_bpf_loader_input_deserialize_aligned( ctx, pre_lens, input, input_sz, input_dirty, !direct_mapping );
   }
 }
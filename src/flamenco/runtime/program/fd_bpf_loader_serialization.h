@@ -20,11 +20,19 @@ fd_bpf_loader_input_serialize_parameters( fd_exec_instr_ctx_t *     instr_ctx,
                                           uchar                     is_deprecated,
                                           uchar **                  out /* output */ );
 
+/* fd_bpf_loader_input_deserialize_parameters applies the changes a
+   program made to the input region to the instruction's accounts.
+   input_dirty is the vm's input region dirty bitmap (see
+   FD_VM_INPUT_DIRTY_LG_CHUNK) if writes were tracked during execution
+   and NULL otherwise.  The result does not depend on input_dirty, it
+   only limits the account data that is copied out or compared. */
+
 int
 fd_bpf_loader_input_deserialize_parameters( fd_exec_instr_ctx_t * ctx,
                                             ulong const *         pre_lens,
                                             uchar *               input,
                                             ulong                 input_sz,
+                                            ulong const *         input_dirty,
                                             int                   direct_mapping,
                                             uchar                 is_deprecated );
 
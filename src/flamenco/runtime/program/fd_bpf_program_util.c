@@ -5,6 +5,12 @@
 
 #include <assert.h>
 
+/* Rank programs for prewarming, largest first */
+#define SORT_NAME        fd_bpf_prewarm_sort
+#define SORT_KEY_T       fd_bpf_prewarm_task_info_t
+#define SORT_BEFORE(a,b) ((a).programdata_sz>(b).programdata_sz)
+#include "../../../util/tmpl/fd_sort.c"
+
 fd_sbpf_validated_program_t *
 fd_sbpf_validated_program_new( void * mem, fd_sbpf_elf_info_t const * elf_info ) {
   fd_sbpf_validated_program_t * validated_prog = (fd_sbpf_validated_program_t *)mem;
@@ -609,3 +615,213 @@ FD_SPAD_FRAME_BEGIN( runtime_spad ) {
 
 } FD_SPAD_FRAME_END;
 }
+
+/* Returns the size of the programdata of a program, without decoding
+   or validating anything.  Only used to rank programs. */
+static ulong
+fd_bpf_prewarm_programdata_sz( fd_funk_t *               funk,
+                               fd_account_meta_t const * meta ) {
+  uchar const * data = (uchar const *)meta + meta->hlen;
+  if( !memcmp( meta->info.owner, fd_solana_bpf_loader_upgradeable_program_id.key, sizeof(fd_pubkey_t) ) ) {
+    /* The program account holds the address of the programdata account */
+    if( FD_UNLIKELY( meta->dlen<sizeof(uint)+sizeof(fd_pubkey_t) ||
+                     FD_LOAD( uint, data )!=fd_bpf_upgradeable_loader_state_enum_program ) ) {
+      return 0UL;
+    }
+    fd_account_meta_t const * programdata_meta = fd_funk_get_acc_meta_readonly( funk, NULL, (fd_pubkey_t const *)( data+sizeof(uint) ), NULL, NULL, NULL );
+    return programdata_meta ? programdata_meta->dlen : 0UL;
+  }
+  return meta->dlen;
+}
+
+ulong
+fd_bpf_prewarm_collect( fd_funk_t *                  funk,
+                        ulong                        range_idx,
+                        ulong                        range_cnt,
+                        fd_bpf_prewarm_task_info_t * tasks,
+                        ulong                        task_max,
+                        long                         deadline ) {
+  fd_wksp_t *         wksp      = fd_funk_wksp( funk );
+  fd_funk_rec_map_t * rec_map   = fd_funk_rec_map( funk );
+  ulong               chain_cnt = fd_funk_rec_map_chain_cnt( rec_map );
+  ulong               chain0    = (chain_cnt* range_idx     )/range_cnt;
+  ulong               chain1    = (chain_cnt*(range_idx+1UL))/range_cnt;
+  ulong               task_cnt  = 0UL;
+
+  /* Other workers may insert cache entries while we scan, so each chain
+     is locked while it is walked.  Finding the programdata of a program
+     needs a query, which can't nest in a chain lock, so sizes are only
+     filled in once the scan is done. */
+
+  for( ulong chain_idx=chain0; chain_idx<chain1 && task_cnt<task_max; chain_idx++ ) {
+    if( FD_UNLIKELY( !((chain_idx-chain0) & 1023UL) && fd_log_wallclock()>=deadline ) ) break;
+    ulong lock_seq[1] = { chain_idx };
+    fd_funk_rec_map_iter_lock( rec_map, lock_seq, 1UL, FD_MAP_FLAG_BLOCKING );
+    for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter( rec_map, chain_idx );
+         !fd_funk_rec_map_iter_done( iter );
+         iter = fd_funk_rec_map_iter_next( iter ) ) {
+      fd_funk_rec_t const * rec = fd_funk_rec_map_iter_ele_const( iter );
+      if( !fd_funk_txn_xid_eq_root( rec->pair.xid ) || !fd_funk_key_is_acc( rec->pair.key ) ||
+          ( rec->flags & FD_FUNK_REC_FLAG_ERASE ) || rec->val_sz<sizeof(fd_account_meta_t) ) {
+        continue;
+      }
+
+      fd_account_meta_t const * meta = fd_funk_val_const( rec, wksp );
+      if( !meta->info.executable || !meta->info.lamports ||
+          !fd_executor_pubkey_is_bpf_loader( (fd_pubkey_t const *)meta->info.owner ) ) {
+        continue;
+      }
+
+      if( FD_UNLIKELY( task_cnt==task_max ) ) {
+        FD_LOG_WARNING(( "more than %lu programs in range %lu of %lu, the rest will be loaded on first use", task_max, range_idx, range_cnt ));
+        break;
+      }
+      memcpy( tasks[ task_cnt++ ].program_pubkey.uc, rec->pair.key->uc, sizeof(fd_pubkey_t) );
+    }
+    fd_funk_rec_map_iter_unlock( rec_map, lock_seq, 1UL );
+  }
+
+  for( ulong i=0UL; i<task_cnt; i++ ) {
+    fd_account_meta_t const * meta = fd_funk_get_acc_meta_readonly( funk, NULL, &tasks[ i ].program_pubkey, NULL, NULL, NULL );
+    tasks[ i ].programdata_sz = meta ? fd_bpf_prewarm_programdata_sz( funk, meta ) : 0UL;
+  }
+
+  fd_bpf_prewarm_sort_inplace( tasks, task_cnt );
+  return task_cnt;
+}
+
+ulong
+fd_bpf_prewarm_load( fd_exec_slot_ctx_t *               slot_ctx,
+                     fd_bpf_prewarm_task_info_t const * tasks,
+                     ulong                              task_cnt,
+                     fd_spad_t *                        spad,
+                     long                               deadline ) {
+  ulong cnt = 0UL;
+  for( ulong i=0UL; i<task_cnt; i++ ) {
+    if( FD_UNLIKELY( fd_log_wallclock()>=deadline ) ) break;
+    fd_pubkey_t const *                 pubkey = &tasks[ i ].program_pubkey;
+    fd_sbpf_validated_program_t const * prog   = NULL;
+    if( !fd_bpf_load_cache_entry( slot_ctx->funk, slot_ctx->funk_txn, pubkey, &prog ) ) continue;
+
+    FD_SPAD_FRAME_BEGIN( spad ) {
+      if( !fd_bpf_check_and_create_bpf_program_cache_entry( slot_ctx, pubkey, spad ) ) cnt++;
+    } FD_SPAD_FRAME_END;
+  }
+  return cnt;
+}
+
+ulong
+fd_bpf_prewarm_range( fd_exec_slot_ctx_t * slot_ctx,
+                      ulong                range_idx,
+                      ulong                range_cnt,
+                      fd_spad_t *          spad,
+                      long                 deadline ) {
+  ulong cnt;
+  FD_SPAD_FRAME_BEGIN( spad ) {
+    fd_bpf_prewarm_task_info_t * tasks = fd_spad_alloc_check( spad, alignof(fd_bpf_prewarm_task_info_t), FD_BPF_PREWARM_PROGRAM_MAX*sizeof(fd_bpf_prewarm_task_info_t) );
+    ulong task_cnt = fd_bpf_prewarm_collect( slot_ctx->funk, range_idx, range_cnt, tasks, FD_BPF_PREWARM_PROGRAM_MAX, deadline );
+    cnt = fd_bpf_prewarm_load( slot_ctx, tasks, task_cnt, spad, deadline );
+  } FD_SPAD_FRAME_END;
+  return cnt;
+}
+
+struct fd_bpf_prewarm_task_args {
+  fd_exec_slot_ctx_t * slot_ctx;
+  ulong                range_cnt;
+  fd_spad_t * *        spads;
+  long                 deadline;
+};
+typedef struct fd_bpf_prewarm_task_args fd_bpf_prewarm_task_args_t;
+
+static void
+fd_bpf_prewarm_task( void *tpool,
+                     ulong t0 FD_PARAM_UNUSED, ulong t1 FD_PARAM_UNUSED,
+                     void *args FD_PARAM_UNUSED,
+                     void *reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                     ulong l0 FD_PARAM_UNUSED, ulong l1 FD_PARAM_UNUSED,
+                     ulong m0, ulong m1 FD_PARAM_UNUSED,
+                     ulong n0 FD_PARAM_UNUSED, ulong n1 FD_PARAM_UNUSED ) {
+  fd_bpf_prewarm_task_args_t * task_args = (fd_bpf_prewarm_task_args_t *)tpool;
+  fd_bpf_prewarm_range( task_args->slot_ctx, m0-1UL, task_args->range_cnt, task_args->spads[ m0 ], task_args->deadline );
+}
+
+void
+fd_bpf_prewarm_tpool_cb( void * para_arg_1,
+                         void * para_arg_2,
+                         void * fn_arg_1,
+                         void * fn_arg_2,
+                         void * fn_arg_3 FD_PARAM_UNUSED,
+                         void * fn_arg_4 FD_PARAM_UNUSED ) {
+  fd_tpool_t *               tpool      = (fd_tpool_t *)para_arg_1;
+  ulong                      worker_cnt = fd_tpool_worker_cnt( tpool );
+  fd_bpf_prewarm_task_args_t task_args  = {
+    .spads     = (fd_spad_t * *)para_arg_2,
+    .slot_ctx  = (fd_exec_slot_ctx_t *)fn_arg_1,
+    .range_cnt = worker_cnt-1UL,
+    .deadline  = *(long const *)fn_arg_2
+  };
+
+  if( FD_UNLIKELY( worker_cnt<2UL ) ) {
+    fd_bpf_prewarm_range( task_args.slot_ctx, 0UL, 1UL, task_args.spads[ 0 ], task_args.deadline );
+    return;
+  }
+
+  for( ulong worker_idx=1UL; worker_idx<worker_cnt; worker_idx++ ) {
+    fd_tpool_exec( tpool, worker_idx, fd_bpf_prewarm_task, &task_args, 0UL,
+                   0UL, NULL, NULL, 0UL, 0UL, 0UL, worker_idx, 0UL, 0UL, 0UL );
+  }
+
+  for( ulong worker_idx=1UL; worker_idx<worker_cnt; worker_idx++ ) {
+    fd_tpool_wait( tpool, worker_idx );
+  }
+}
+
+void
+fd_bpf_program_cache_prewarm( fd_exec_slot_ctx_t *    slot_ctx,
+                              fd_spad_t *             runtime_spad,
+                              fd_exec_para_cb_ctx_t * exec_para_ctx,
+                              long                    budget_ns ) {
+  fd_funk_t * funk     = slot_ctx->funk;
+  long        start    = fd_log_wallclock();
+  long        deadline = fd_long_sat_add( start, budget_ns );
+
+  /* Use random-ish xid to avoid concurrency issues */
+  fd_funk_txn_xid_t cache_xid = fd_funk_generate_xid();
+
+  fd_funk_txn_start_write( funk );
+  fd_funk_txn_t * cache_txn = fd_funk_txn_prepare( funk, slot_ctx->funk_txn, &cache_xid, 1 );
+  if( FD_UNLIKELY( !cache_txn ) ) {
+    FD_LOG_ERR(( "fd_funk_txn_prepare() failed" ));
+  }
+  fd_funk_txn_end_write( funk );
+
+  fd_funk_txn_t * funk_txn = slot_ctx->funk_txn;
+  slot_ctx->funk_txn = cache_txn;
+
+  if( fd_exec_para_cb_is_single_threaded( exec_para_ctx ) ) {
+    fd_bpf_prewarm_range( slot_ctx, 0UL, 1UL, runtime_spad, deadline );
+  } else {
+    exec_para_ctx->fn_arg_1 = slot_ctx;
+    exec_para_ctx->fn_arg_2 = &deadline;
+    exec_para_ctx->fn_arg_3 = NULL;
+    exec_para_ctx->fn_arg_4 = NULL;
+    fd_exec_para_call_func( exec_para_ctx );
+  }
+
+  ulong cnt = 0UL;
+  for( fd_funk_rec_t const * rec = fd_funk_txn_first_rec( funk, cache_txn ); rec; rec = fd_funk_txn_next_rec( funk, rec ) ) cnt++;
+
+  fd_funk_txn_start_write( funk );
+  if( FD_UNLIKELY( fd_funk_txn_publish_into_parent( funk, cache_txn, 1 )!=FD_FUNK_SUCCESS ) ) {
+    FD_LOG_ERR(( "fd_funk_txn_publish_into_parent() failed" ));
+  }
+  fd_funk_txn_end_write( funk );
+
+  slot_ctx->funk_txn = funk_txn;
+
+  long now = fd_log_wallclock();
+  FD_LOG_NOTICE(( "prewarmed program cache with %lu programs in %ld ms", cnt, (now-start)/1000000L ));
+  if( FD_UNLIKELY( now>=deadline ) ) {
+    FD_LOG_NOTICE(( "program cache prewarm ran out of its %ld ms budget, the remaining programs will be loaded on first use", budget_ns/1000000L ));
+  }
+}
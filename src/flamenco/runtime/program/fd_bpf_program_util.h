@@ -107,6 +107,121 @@ fd_bpf_program_update_program_cache( fd_exec_slot_ctx_t * slot_ctx,
                                      fd_pubkey_t const *  program_pubkey,
                                      fd_spad_t *          runtime_spad );
 
+/* Program cache prewarming ************************************************
+
+   Programs are otherwise only added to the cache the first time a
+   transaction references them, so the first slots replayed after a
+   snapshot is loaded pay for parsing, relocating and validating every
+   popular program inline.  fd_bpf_program_cache_prewarm adds every
+   program in the last published state to the cache up front, spread
+   across workers.
+
+   Worker i of n scans the i-th of n contiguous ranges of record map
+   chains for programs, so finding the programs is spread across the
+   workers as well, and no writable state is shared between them.
+   Record keys hash uniformly across chains, so the workers get
+   statistically even shares.  Snapshots carry no usage history, so each
+   worker ranks the programs it found by the size of their programdata
+   and loads the largest first.  Load and validation time grows with
+   program size, so the most expensive programs are started early.
+
+   Replay can't start until prewarming is done, so prewarming is bounded
+   by a wallclock deadline.  Workers stop scanning and loading once it
+   has passed, and the remaining programs are loaded on first use. */
+
+struct fd_bpf_prewarm_task_info {
+  fd_pubkey_t program_pubkey;
+  ulong       programdata_sz;
+};
+typedef struct fd_bpf_prewarm_task_info fd_bpf_prewarm_task_info_t;
+
+/* FD_BPF_PREWARM_PROGRAM_MAX is the max number of programs prewarmed by
+   a worker.  Programs beyond it are added to the cache lazily, as
+   before. */
+
+#define FD_BPF_PREWARM_PROGRAM_MAX (1UL<<18)
+
+/* FD_BPF_PREWARM_BUDGET_NS is the default time budget of
+   fd_bpf_program_cache_prewarm.  Programs that don't make it are loaded
+   on first use, so the budget only trades startup delay against the
+   cost of the first slots replayed. */
+
+#define FD_BPF_PREWARM_BUDGET_NS (10L*1000L*1000L*1000L) /* 10 s */
+
+/* fd_bpf_prewarm_collect stores up to task_max programs (executable
+   accounts owned by a BPF loader) in the last published state of funk
+   whose records are in range range_idx of range_cnt of the record map
+   chains into tasks, ranked for prewarming.  range_idx is in
+   [0,range_cnt).  The scan stops early once the wallclock reaches
+   deadline (LONG_MAX for no deadline).  Safe to call while other
+   threads create cache entries.  Returns the number stored. */
+
+ulong
+fd_bpf_prewarm_collect( fd_funk_t *                  funk,
+                        ulong                        range_idx,
+                        ulong                        range_cnt,
+                        fd_bpf_prewarm_task_info_t * tasks,
+                        ulong                        task_max,
+                        long                         deadline );
+
+/* fd_bpf_prewarm_load adds the programs in tasks[i] for i in
+   [0,task_cnt) to the program cache in slot_ctx->funk_txn, in order.
+   Programs already in the cache are skipped.  No program is started
+   once the wallclock reaches deadline.  Uses spad for scratch.  Returns
+   the number of cache entries created. */
+
+ulong
+fd_bpf_prewarm_load( fd_exec_slot_ctx_t *               slot_ctx,
+                     fd_bpf_prewarm_task_info_t const * tasks,
+                     ulong                              task_cnt,
+                     fd_spad_t *                        spad,
+                     long                               deadline );
+
+/* fd_bpf_prewarm_range collects the programs of range range_idx of
+   range_cnt (see fd_bpf_prewarm_collect) and loads them into the
+   program cache in slot_ctx->funk_txn.  This is the work of one
+   prewarming worker.  Stops at deadline, see above.  Uses spad for the
+   ranking and for scratch.  Returns the number of cache entries
+   created. */
+
+ulong
+fd_bpf_prewarm_range( fd_exec_slot_ctx_t * slot_ctx,
+                      ulong                range_idx,
+                      ulong                range_cnt,
+                      fd_spad_t *          spad,
+                      long                 deadline );
+
+/* fd_bpf_prewarm_tpool_cb runs fd_bpf_prewarm_range on every worker of
+   the tpool in para_arg_1.  para_arg_2 is an array of spads indexed by
+   worker, fn_arg_1 is the slot_ctx and fn_arg_2 points to the
+   deadline (a long).  The other arguments are unused.  Worker 0 is left
+   idle unless it is the only worker. */
+
+void
+fd_bpf_prewarm_tpool_cb( void * para_arg_1,
+                         void * para_arg_2,
+                         void * fn_arg_1,
+                         void * fn_arg_2,
+                         void * fn_arg_3,
+                         void * fn_arg_4 );
+
+/* fd_bpf_program_cache_prewarm adds every program in the last published
+   state to the program cache.  It is meant to run once at startup,
+   after the snapshot is loaded and before replay starts.  Entries are
+   created in a child of slot_ctx->funk_txn that is published into it
+   once all workers are done.  exec_para_ctx distributes the work, see
+   fd_bpf_prewarm_tpool_cb for the arguments it is given; if it is
+   single threaded, the whole map is prewarmed inline with
+   runtime_spad.  Workers stop budget_ns after the call (typically
+   FD_BPF_PREWARM_BUDGET_NS), so it returns shortly after that even if
+   not every program was loaded. */
+
+void
+fd_bpf_program_cache_prewarm( fd_exec_slot_ctx_t *    slot_ctx,
+                              fd_spad_t *             runtime_spad,
+                              fd_exec_para_cb_ctx_t * exec_para_ctx,
+                              long                    budget_ns );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_flamenco_runtime_program_fd_bpf_program_util_h */
@@ -3261,27 +3261,8 @@ static void
 fd_stakes_remove_stake_delegation( fd_txn_account_t *   stake_account,
                                    fd_bank_t *          bank ) {
 
-  fd_account_keys_global_t *         stake_account_keys = fd_bank_stake_account_keys_locking_modify( bank );
-  fd_account_keys_pair_t_mapnode_t * account_keys_pool  = fd_account_keys_account_keys_pool_join( stake_account_keys );
-  fd_account_keys_pair_t_mapnode_t * account_keys_root  = fd_account_keys_account_keys_root_join( stake_account_keys );
-
-  fd_account_keys_pair_t_mapnode_t key;
-  fd_memcpy( key.elem.key.uc, stake_account->pubkey->uc, sizeof(fd_pubkey_t) );
-  if( FD_UNLIKELY( account_keys_pool==NULL ) ) {
-    /* TODO: Should this be a LOG_ERR/LOG_CRIT? */
-    fd_bank_stake_account_keys_end_locking_modify( bank );
-    FD_LOG_DEBUG(("Stake accounts pool does not exist"));
-    return;
-  }
-  fd_account_keys_pair_t_mapnode_t * entry = fd_account_keys_pair_t_map_find( account_keys_pool, account_keys_root, &key );
-  if( FD_UNLIKELY( entry ) ) {
-    fd_account_keys_pair_t_map_remove( account_keys_pool, &account_keys_root, entry );
-    // TODO: do we need a release here?
-  }
-
-  fd_account_keys_account_keys_pool_update( stake_account_keys, account_keys_pool );
-  fd_account_keys_account_keys_root_update( stake_account_keys, account_keys_root );
-
+  fd_bank_keys_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( bank );
+  fd_bank_keys_remove( stake_account_keys, stake_account->pubkey );
   fd_bank_stake_account_keys_end_locking_modify( bank );
 }
 
@@ -3304,50 +3285,13 @@ fd_stakes_upsert_stake_delegation( fd_txn_account_t *   stake_account,
     return;
   }
 
-  fd_account_keys_global_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( bank );
-
-  fd_account_keys_pair_t_mapnode_t * account_keys_pool = NULL;
-  fd_account_keys_pair_t_mapnode_t * account_keys_root = NULL;
-  if( stake_account_keys->account_keys_pool_offset==0 ) {
-    uchar * pool_mem = (uchar *)fd_ulong_align_up( (ulong)stake_account_keys + sizeof(fd_account_keys_global_t), fd_account_keys_pair_t_map_align() );
-    account_keys_pool = fd_account_keys_pair_t_map_join( fd_account_keys_pair_t_map_new( pool_mem, 100000UL ) );
-    account_keys_root = NULL;
-  } else {
-    account_keys_pool = fd_account_keys_account_keys_pool_join( stake_account_keys );
-    account_keys_root = fd_account_keys_account_keys_root_join( stake_account_keys );
-  }
-
   fd_delegation_pair_t_mapnode_t * entry = fd_delegation_pair_t_map_find( stake_delegations_pool, stake_delegations_root, &key );
   if( FD_UNLIKELY( !entry ) ) {
-    fd_account_keys_pair_t_mapnode_t key;
-    fd_memcpy( key.elem.key.uc, stake_account->pubkey->uc, sizeof(fd_pubkey_t) );
-    if( account_keys_pool==NULL ) {
-      FD_LOG_DEBUG(( "Stake accounts pool does not exist" ));
-      fd_bank_stake_account_keys_end_locking_modify( bank );
-      fd_bank_stakes_end_locking_query( bank );
-      return;
-    }
-    fd_account_keys_pair_t_mapnode_t * stake_entry = fd_account_keys_pair_t_map_find( account_keys_pool, account_keys_root, &key );
-    if( stake_entry ) {
-      stake_entry->elem.exists = 1;
-    } else {
-      fd_account_keys_pair_t_mapnode_t * new_node = fd_account_keys_pair_t_map_acquire( account_keys_pool );
-      ulong size = fd_account_keys_pair_t_map_size( account_keys_pool, account_keys_root );
-      FD_LOG_DEBUG(("Curr stake account size %lu %p", size, (void *)account_keys_pool));
-      if( new_node==NULL ) {
-        FD_LOG_ERR(("Stake accounts keys map full %lu", size));
-      }
-      new_node->elem.exists = 1;
-      fd_memcpy( new_node->elem.key.uc, stake_account->pubkey->uc, sizeof(fd_pubkey_t) );
-      fd_account_keys_pair_t_map_insert( account_keys_pool, &account_keys_root, new_node );
-    }
+    fd_bank_keys_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( bank );
+    fd_bank_keys_insert( stake_account_keys, stake_account->pubkey );
+    fd_bank_stake_account_keys_end_locking_modify( bank );
   }
 
-  fd_account_keys_account_keys_pool_update( stake_account_keys, account_keys_pool );
-  fd_account_keys_account_keys_root_update( stake_account_keys, account_keys_root );
-
-  fd_bank_stake_account_keys_end_locking_modify( bank );
-
   fd_bank_stakes_end_locking_query( bank );
 }
 
@@ -2877,52 +2877,36 @@ fd_vote_convert_to_current( fd_vote_state_versioned_t * self,
   convert_to_current( self, spad );
 }
 
+/* remove_vote_account drops a closed or uninitialized vote account from
+   the stakes cache.  Modifying the stakes bank field would copy all of
+   it for this fork, so the key is only recorded in the (structurally
+   shared) removed_vote_account_keys set.  fd_refresh_vote_accounts
+   applies the removals at the epoch boundary, before the stakes cache
+   is used for rewards and epoch stakes.  Within the epoch it is only
+   read for bank hash comparison, which does not affect consensus. */
+
 static void
 remove_vote_account( fd_txn_account_t *   vote_account,
                      fd_bank_t *          bank ) {
 
-  fd_stakes_global_t * stakes = fd_bank_stakes_locking_modify( bank );
-  fd_vote_accounts_global_t * epoch_vote_accounts = &stakes->vote_accounts;
-  fd_vote_accounts_pair_global_t_mapnode_t * epoch_vote_accounts_pool = fd_vote_accounts_vote_accounts_pool_join( epoch_vote_accounts );
-  fd_vote_accounts_pair_global_t_mapnode_t * epoch_vote_accounts_root = fd_vote_accounts_vote_accounts_root_join( epoch_vote_accounts );
-
-  if( FD_UNLIKELY( epoch_vote_accounts_pool==NULL ) ) {
-    FD_LOG_DEBUG(("Vote accounts pool does not exist"));
-    fd_bank_stakes_end_locking_modify( bank );
-    return;
-  }
-
+  fd_stakes_global_t const * stakes = fd_bank_stakes_locking_query( bank );
+  fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_pool = fd_vote_accounts_vote_accounts_pool_join( &stakes->vote_accounts );
+  fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_root = fd_vote_accounts_vote_accounts_root_join( &stakes->vote_accounts );
 
   fd_vote_accounts_pair_global_t_mapnode_t vote_acc;
   fd_memcpy( vote_acc.elem.key.uc, vote_account->pubkey->uc, sizeof(fd_pubkey_t) );
-  fd_vote_accounts_pair_global_t_mapnode_t * vote_account_entry = fd_vote_accounts_pair_global_t_map_find( epoch_vote_accounts_pool, epoch_vote_accounts_root, &vote_acc );
-  if( FD_LIKELY( vote_account_entry ) ) {
-    fd_vote_accounts_pair_global_t_map_remove( epoch_vote_accounts_pool, &epoch_vote_accounts_root, vote_account_entry);
-  }
+  int in_stakes = !!stakes_vote_accounts_pool &&
+                  !!fd_vote_accounts_pair_global_t_map_find( stakes_vote_accounts_pool, stakes_vote_accounts_root, &vote_acc );
+  fd_bank_stakes_end_locking_query( bank );
 
-  fd_vote_accounts_vote_accounts_pool_update( epoch_vote_accounts, epoch_vote_accounts_pool );
-  fd_vote_accounts_vote_accounts_root_update( epoch_vote_accounts, epoch_vote_accounts_root );
-  fd_bank_stakes_end_locking_modify( bank );
-
-  fd_account_keys_global_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( bank );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool = fd_account_keys_account_keys_pool_join( vote_account_keys );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root = fd_account_keys_account_keys_root_join( vote_account_keys );
-
-  if( FD_UNLIKELY( vote_account_keys_pool==NULL ) ) {
-    fd_bank_vote_account_keys_end_locking_modify( bank );
-    FD_LOG_DEBUG(("Vote accounts pool does not exist"));
-    return;
-  }
-
-  fd_account_keys_pair_t_mapnode_t account_key;
-  fd_memcpy( account_key.elem.key.uc, vote_account->pubkey->uc, sizeof(fd_pubkey_t) );
-  fd_account_keys_pair_t_mapnode_t * account_key_entry = fd_account_keys_pair_t_map_find( vote_account_keys_pool, vote_account_keys_root, &account_key );
-  if( account_key_entry ) {
-    fd_account_keys_pair_t_map_remove( vote_account_keys_pool, &vote_account_keys_root, account_key_entry );
+  if( FD_LIKELY( in_stakes ) ) {
+    fd_bank_keys_t * removed_vote_account_keys = fd_bank_removed_vote_account_keys_locking_modify( bank );
+    fd_bank_keys_insert( removed_vote_account_keys, vote_account->pubkey );
+    fd_bank_removed_vote_account_keys_end_locking_modify( bank );
   }
 
-  fd_account_keys_account_keys_pool_update( vote_account_keys, vote_account_keys_pool );
-
+  fd_bank_keys_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( bank );
+  fd_bank_keys_remove( vote_account_keys, vote_account->pubkey );
   fd_bank_vote_account_keys_end_locking_modify( bank );
 }
 
@@ -2930,50 +2914,37 @@ static void
 upsert_vote_account( fd_txn_account_t *   vote_account,
                      fd_bank_t *          bank ) {
 
-  fd_stakes_global_t const * stakes = fd_bank_stakes_locking_query( bank );
-  fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_pool = fd_vote_accounts_vote_accounts_pool_join( &stakes->vote_accounts );
-  fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_root = fd_vote_accounts_vote_accounts_root_join( &stakes->vote_accounts );
-
-  fd_account_keys_global_t *         vote_account_keys      = fd_bank_vote_account_keys_locking_modify( bank );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool = fd_account_keys_account_keys_pool_join( vote_account_keys );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root = fd_account_keys_account_keys_root_join( vote_account_keys );
-
-  if( FD_UNLIKELY( vote_account_keys_pool==NULL ) ) {
-    fd_bank_vote_account_keys_end_locking_modify( bank );
-    fd_bank_stakes_end_locking_query( bank );
-    FD_LOG_DEBUG(( "Vote accounts pool does not exist" ));
+  if( !fd_vote_state_versions_is_correct_and_initialized( vote_account ) ) {
+    remove_vote_account( vote_account, bank );
     return;
   }
 
-  if( fd_vote_state_versions_is_correct_and_initialized( vote_account ) ) {
-    fd_account_keys_pair_t_mapnode_t key;
-    fd_memcpy( &key.elem.key, vote_account->pubkey->uc, sizeof(fd_pubkey_t) );
+  /* Undo a pending removal if the account was closed and reopened
+     within the epoch. */
+  fd_bank_keys_t const * removed_vote_account_keys = fd_bank_removed_vote_account_keys_locking_query( bank );
+  int removed = fd_bank_keys_test( removed_vote_account_keys, vote_account->pubkey );
+  fd_bank_removed_vote_account_keys_end_locking_query( bank );
+  if( FD_UNLIKELY( removed ) ) {
+    fd_bank_keys_t * keys = fd_bank_removed_vote_account_keys_locking_modify( bank );
+    fd_bank_keys_remove( keys, vote_account->pubkey );
+    fd_bank_removed_vote_account_keys_end_locking_modify( bank );
+  }
 
-    fd_vote_accounts_pair_global_t_mapnode_t vote_acc;
-    fd_memcpy( &vote_acc.elem.key, vote_account->pubkey->uc, sizeof(fd_pubkey_t) );
+  fd_stakes_global_t const * stakes = fd_bank_stakes_locking_query( bank );
+  fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_pool = fd_vote_accounts_vote_accounts_pool_join( &stakes->vote_accounts );
+  fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_root = fd_vote_accounts_vote_accounts_root_join( &stakes->vote_accounts );
 
-    // Skip duplicates
-    if( FD_LIKELY( fd_account_keys_pair_t_map_find( vote_account_keys_pool, vote_account_keys_root, &key ) ||
-                   fd_vote_accounts_pair_global_t_map_find( stakes_vote_accounts_pool, stakes_vote_accounts_root, &vote_acc )  ) ) {
-      fd_bank_vote_account_keys_end_locking_modify( bank );
-      fd_bank_stakes_end_locking_query( bank );
-      return;
-    }
-    fd_bank_stakes_end_locking_query( bank );
+  fd_vote_accounts_pair_global_t_mapnode_t vote_acc;
+  fd_memcpy( &vote_acc.elem.key, vote_account->pubkey->uc, sizeof(fd_pubkey_t) );
 
-    fd_account_keys_pair_t_mapnode_t * new_node = fd_account_keys_pair_t_map_acquire( vote_account_keys_pool );
-    if( FD_UNLIKELY( !new_node ) ) {
-      FD_LOG_ERR(("Map full"));
-    }
+  // Skip duplicates
+  int in_stakes = !!fd_vote_accounts_pair_global_t_map_find( stakes_vote_accounts_pool, stakes_vote_accounts_root, &vote_acc );
+  fd_bank_stakes_end_locking_query( bank );
+  if( FD_LIKELY( in_stakes ) ) return;
 
-    fd_memcpy( &new_node->elem.key, vote_account->pubkey, sizeof(fd_pubkey_t));
-    fd_account_keys_pair_t_map_insert( vote_account_keys_pool, &vote_account_keys_root, new_node );
-    fd_bank_vote_account_keys_end_locking_modify( bank );
-  } else {
-    fd_bank_vote_account_keys_end_locking_modify( bank );
-    fd_bank_stakes_end_locking_query( bank );
-    remove_vote_account( vote_account, bank );
-  }
+  fd_bank_keys_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( bank );
+  fd_bank_keys_insert( vote_account_keys, vote_account->pubkey );
+  fd_bank_vote_account_keys_end_locking_modify( bank );
 }
 
 void
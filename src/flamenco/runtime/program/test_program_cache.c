@@ -242,6 +242,178 @@ test_program_in_cache_needs_reverification( void ) {
   fd_funk_txn_cancel( test_funk, funk_txn, 0 );
 }
 
+/* Test 6: Prewarming ranks published programs by size and adds them to
+   the cache */
+static void
+test_prewarm( void ) {
+  FD_LOG_NOTICE(( "Testing: Prewarming the cache with published programs" ));
+
+  static fd_pubkey_t const small_program_pubkey = { .uc = { 0x01 } };
+  static fd_pubkey_t const data_account_pubkey  = { .uc = { 0x02 } };
+
+  fd_funk_txn_t * funk_txn = create_test_funk_txn();
+  test_slot_ctx->funk_txn = funk_txn;
+
+  create_test_account( &small_program_pubkey,
+                       &fd_solana_bpf_loader_program_id,
+                       invalid_program_data,
+                       sizeof(invalid_program_data),
+                       1 );
+  create_test_account( &test_program_pubkey,
+                       &fd_solana_bpf_loader_program_id,
+                       valid_program_data,
+                       valid_program_data_sz,
+                       1 );
+  create_test_account( &data_account_pubkey,
+                       &fd_solana_bpf_loader_program_id,
+                       valid_program_data,
+                       valid_program_data_sz,
+                       0 );
+
+  /* Only published programs are prewarmed */
+  fd_bpf_prewarm_task_info_t tasks[ 4 ];
+  FD_TEST( fd_bpf_prewarm_collect( test_funk, 0UL, 1UL, tasks, 4UL, LONG_MAX )==0UL );
+
+  fd_funk_txn_start_write( test_funk );
+  FD_TEST( fd_funk_txn_publish( test_funk, funk_txn, 0 )==1UL );
+  fd_funk_txn_end_write( test_funk );
+  test_slot_ctx->funk_txn = NULL;
+
+  /* Largest programs first, non-executable accounts are skipped */
+  FD_TEST( fd_bpf_prewarm_collect( test_funk, 0UL, 1UL, tasks, 4UL, LONG_MAX )==2UL );
+  FD_TEST( fd_memeq( &tasks[0].program_pubkey, &test_program_pubkey, sizeof(fd_pubkey_t) ) );
+  FD_TEST( tasks[0].programdata_sz==valid_program_data_sz );
+  FD_TEST( fd_memeq( &tasks[1].program_pubkey, &small_program_pubkey, sizeof(fd_pubkey_t) ) );
+  FD_TEST( tasks[1].programdata_sz==sizeof(invalid_program_data) );
+
+  /* Truncated to task_max */
+  FD_TEST( fd_bpf_prewarm_collect( test_funk, 0UL, 1UL, tasks, 1UL, LONG_MAX )==1UL );
+
+  fd_exec_para_cb_ctx_t exec_para_ctx = { .func = fd_bpf_prewarm_tpool_cb };
+  fd_bpf_program_cache_prewarm( test_slot_ctx, test_spad, &exec_para_ctx, FD_BPF_PREWARM_BUDGET_NS );
+  FD_TEST( !test_slot_ctx->funk_txn );
+
+  fd_sbpf_validated_program_t const * valid_prog = NULL;
+  FD_TEST( !fd_bpf_load_cache_entry( test_funk, NULL, &test_program_pubkey, &valid_prog ) );
+  FD_TEST( valid_prog->magic==FD_SBPF_VALIDATED_PROGRAM_MAGIC );
+  FD_TEST( !valid_prog->failed_verification );
+  FD_TEST( !fd_bpf_load_cache_entry( test_funk, NULL, &small_program_pubkey, &valid_prog ) );
+  FD_TEST( valid_prog->failed_verification );
+  FD_TEST( fd_bpf_load_cache_entry( test_funk, NULL, &data_account_pubkey, &valid_prog ) );
+
+  /* Programs already in the cache are not loaded again */
+  fd_funk_txn_t * cache_txn = create_test_funk_txn();
+  test_slot_ctx->funk_txn = cache_txn;
+  FD_TEST( fd_bpf_prewarm_collect( test_funk, 0UL, 1UL, tasks, 4UL, LONG_MAX )==2UL );
+  FD_TEST( fd_bpf_prewarm_load( test_slot_ctx, tasks, 2UL, test_spad, LONG_MAX )==0UL );
+  fd_funk_txn_cancel( test_funk, cache_txn, 0 );
+  test_slot_ctx->funk_txn = NULL;
+}
+
+#define TEST_PREWARM_PROGRAM_CNT (5UL)
+
+/* Test 7: Finding and prewarming programs is split between workers */
+static void
+test_prewarm_workers( void ) {
+  FD_LOG_NOTICE(( "Testing: Prewarming the cache with multiple workers" ));
+
+  fd_pubkey_t pubkeys[ TEST_PREWARM_PROGRAM_CNT ];
+  fd_funk_txn_t * funk_txn = create_test_funk_txn();
+  test_slot_ctx->funk_txn = funk_txn;
+  for( ulong i=0UL; i<TEST_PREWARM_PROGRAM_CNT; i++ ) {
+    memset( &pubkeys[ i ], 0, sizeof(fd_pubkey_t) );
+    pubkeys[ i ].uc[ 0 ] = 0x10;
+    pubkeys[ i ].uc[ 1 ] = (uchar)i;
+    create_test_account( &pubkeys[ i ], &fd_solana_bpf_loader_program_id, valid_program_data, valid_program_data_sz, 1 );
+  }
+  fd_funk_txn_start_write( test_funk );
+  FD_TEST( fd_funk_txn_publish( test_funk, funk_txn, 0 )==1UL );
+  fd_funk_txn_end_write( test_funk );
+  test_slot_ctx->funk_txn = NULL;
+
+  /* Two programs were published by test_prewarm */
+  fd_bpf_prewarm_task_info_t tasks[ TEST_PREWARM_PROGRAM_CNT+2UL ];
+  ulong task_cnt = fd_bpf_prewarm_collect( test_funk, 0UL, 1UL, tasks, TEST_PREWARM_PROGRAM_CNT+2UL, LONG_MAX );
+  FD_TEST( task_cnt==TEST_PREWARM_PROGRAM_CNT+2UL );
+
+  /* The ranges of the workers cover every program exactly once */
+  for( ulong range_cnt=1UL; range_cnt<=8UL; range_cnt++ ) {
+    ulong found[ TEST_PREWARM_PROGRAM_CNT+2UL ] = {0};
+    for( ulong range_idx=0UL; range_idx<range_cnt; range_idx++ ) {
+      fd_bpf_prewarm_task_info_t range_tasks[ TEST_PREWARM_PROGRAM_CNT+2UL ];
+      ulong range_task_cnt = fd_bpf_prewarm_collect( test_funk, range_idx, range_cnt, range_tasks, TEST_PREWARM_PROGRAM_CNT+2UL, LONG_MAX );
+      for( ulong i=0UL; i<range_task_cnt; i++ ) {
+        if( i ) FD_TEST( range_tasks[ i-1UL ].programdata_sz>=range_tasks[ i ].programdata_sz );
+        ulong j;
+        for( j=0UL; j<task_cnt; j++ ) if( fd_memeq( &tasks[ j ].program_pubkey, &range_tasks[ i ].program_pubkey, sizeof(fd_pubkey_t) ) ) break;
+        FD_TEST( j<task_cnt );
+        found[ j ]++;
+      }
+    }
+    for( ulong j=0UL; j<task_cnt; j++ ) FD_TEST( found[ j ]==1UL );
+
+    fd_funk_txn_t * cache_txn = create_test_funk_txn();
+    test_slot_ctx->funk_txn = cache_txn;
+    ulong cnt = 0UL;
+    for( ulong range_idx=0UL; range_idx<range_cnt; range_idx++ ) {
+      cnt += fd_bpf_prewarm_range( test_slot_ctx, range_idx, range_cnt, test_spad, LONG_MAX );
+    }
+    FD_TEST( cnt==TEST_PREWARM_PROGRAM_CNT );
+    fd_funk_txn_cancel( test_funk, cache_txn, 0 );
+    test_slot_ctx->funk_txn = NULL;
+  }
+
+  /* Nothing is prewarmed once the deadline has passed */
+  fd_funk_txn_t * cache_txn = create_test_funk_txn();
+  test_slot_ctx->funk_txn = cache_txn;
+  FD_TEST( fd_bpf_prewarm_collect( test_funk, 0UL, 1UL, tasks, TEST_PREWARM_PROGRAM_CNT+2UL, 0L )==0UL );
+  FD_TEST( fd_bpf_prewarm_load( test_slot_ctx, tasks, task_cnt, test_spad, 0L )==0UL );
+  FD_TEST( fd_bpf_prewarm_range( test_slot_ctx, 0UL, 1UL, test_spad, 0L )==0UL );
+  fd_funk_txn_cancel( test_funk, cache_txn, 0 );
+  test_slot_ctx->funk_txn = NULL;
+
+  /* Prewarm with a tpool when there are tiles for it */
+  ulong worker_cnt = fd_ulong_min( fd_tile_cnt(), 4UL );
+  if( FD_UNLIKELY( worker_cnt<3UL ) ) {
+    FD_LOG_WARNING(( "skip: tpool prewarm needs --tile-cpus with at least 3 tiles" ));
+    return;
+  }
+
+  static uchar tpool_mem[ FD_TPOOL_FOOTPRINT( 4UL ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  fd_tpool_t * tpool = fd_tpool_init( tpool_mem, worker_cnt, 0UL );
+  FD_TEST( tpool );
+  fd_spad_t * spads[ 4 ] = { test_spad };
+  for( ulong worker_idx=1UL; worker_idx<worker_cnt; worker_idx++ ) {
+    FD_TEST( fd_tpool_worker_push( tpool, worker_idx ) );
+    void * spad_mem = fd_wksp_alloc_laddr( test_wksp, fd_spad_align(), fd_spad_footprint( SPAD_MEM_MAX ), TEST_WKSP_TAG );
+    FD_TEST( spad_mem );
+    spads[ worker_idx ] = fd_spad_join( fd_spad_new( spad_mem, SPAD_MEM_MAX ) );
+    FD_TEST( spads[ worker_idx ] );
+  }
+
+  fd_exec_para_cb_ctx_t exec_para_ctx = {
+    .func       = fd_bpf_prewarm_tpool_cb,
+    .para_arg_1 = tpool,
+    .para_arg_2 = spads
+  };
+  fd_bpf_program_cache_prewarm( test_slot_ctx, test_spad, &exec_para_ctx, FD_BPF_PREWARM_BUDGET_NS );
+  FD_TEST( !test_slot_ctx->funk_txn );
+
+  for( ulong i=0UL; i<TEST_PREWARM_PROGRAM_CNT; i++ ) {
+    fd_sbpf_validated_program_t const * valid_prog = NULL;
+    FD_TEST( !fd_bpf_load_cache_entry( test_funk, NULL, &pubkeys[ i ], &valid_prog ) );
+    FD_TEST( valid_prog->magic==FD_SBPF_VALIDATED_PROGRAM_MAGIC );
+    FD_TEST( !valid_prog->failed_verification );
+  }
+
+  for( ulong worker_idx=1UL; worker_idx<worker_cnt; worker_idx++ ) {
+    fd_wksp_free_laddr( fd_spad_delete( fd_spad_leave( spads[ worker_idx ] ) ) );
+  }
+  FD_TEST( fd_tpool_fini( tpool ) );
+}
+
+#undef TEST_PREWARM_PROGRAM_CNT
+
 int
 main( int     argc,
       char ** argv ) {
@@ -314,6 +486,8 @@ main( int     argc,
     test_invalid_program_not_in_cache_first_time();
     test_valid_program_not_in_cache_first_time();
     test_program_in_cache_needs_reverification();
+    test_prewarm();
+    test_prewarm_workers();
   } FD_SPAD_FRAME_END;
 
   test_teardown();
@@ -1,6 +1,6 @@
 ifdef FD_HAS_INT128
-$(call add-hdrs,fd_zksdk.h)
-$(call add-objs,fd_zksdk,fd_flamenco)
+$(call add-hdrs,fd_zksdk.h fd_zksdk_batch.h)
+$(call add-objs,fd_zksdk fd_zksdk_batch,fd_flamenco)
 ifdef FD_HAS_HOSTED
 $(call make-unit-test,test_zksdk,test_zksdk,fd_flamenco fd_ballet fd_util)
 $(call run-unit-test,test_zksdk)
@@ -92,6 +92,55 @@ fd_zksdk_process_close_context_state( fd_exec_instr_ctx_t * ctx ) {
   return FD_EXECUTOR_INSTR_SUCCESS;
 }
 
+/* fd_zksdk_verify_proof_fn returns the function that verifies the ZKP
+   of the verify_proof instruction instr_id, or NULL if instr_id is not
+   a verify_proof instruction. */
+static fd_zksdk_instr_verify_proof_fn_t
+fd_zksdk_verify_proof_fn( uchar instr_id ) {
+  switch( instr_id ) {
+  case FD_ZKSDK_INSTR_VERIFY_ZERO_CIPHERTEXT:
+    return &fd_zksdk_instr_verify_proof_zero_ciphertext;
+  case FD_ZKSDK_INSTR_VERIFY_CIPHERTEXT_CIPHERTEXT_EQUALITY:
+    return &fd_zksdk_instr_verify_proof_ciphertext_ciphertext_equality;
+  case FD_ZKSDK_INSTR_VERIFY_CIPHERTEXT_COMMITMENT_EQUALITY:
+    return &fd_zksdk_instr_verify_proof_ciphertext_commitment_equality;
+  case FD_ZKSDK_INSTR_VERIFY_PUBKEY_VALIDITY:
+    return &fd_zksdk_instr_verify_proof_pubkey_validity;
+  case FD_ZKSDK_INSTR_VERIFY_PERCENTAGE_WITH_CAP:
+    return &fd_zksdk_instr_verify_proof_percentage_with_cap;
+  case FD_ZKSDK_INSTR_VERIFY_BATCHED_RANGE_PROOF_U64:
+    return &fd_zksdk_instr_verify_proof_batched_range_proof_u64;
+  case FD_ZKSDK_INSTR_VERIFY_BATCHED_RANGE_PROOF_U128:
+    return &fd_zksdk_instr_verify_proof_batched_range_proof_u128;
+  case FD_ZKSDK_INSTR_VERIFY_BATCHED_RANGE_PROOF_U256:
+    return &fd_zksdk_instr_verify_proof_batched_range_proof_u256;
+  case FD_ZKSDK_INSTR_VERIFY_GROUPED_CIPHERTEXT_2_HANDLES_VALIDITY:
+    return &fd_zksdk_instr_verify_proof_grouped_ciphertext_2_handles_validity;
+  case FD_ZKSDK_INSTR_VERIFY_BATCHED_GROUPED_CIPHERTEXT_2_HANDLES_VALIDITY:
+    return &fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_2_handles_validity;
+  case FD_ZKSDK_INSTR_VERIFY_GROUPED_CIPHERTEXT_3_HANDLES_VALIDITY:
+    return &fd_zksdk_instr_verify_proof_grouped_ciphertext_3_handles_validity;
+  case FD_ZKSDK_INSTR_VERIFY_BATCHED_GROUPED_CIPHERTEXT_3_HANDLES_VALIDITY:
+    return &fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_3_handles_validity;
+  default:
+    return NULL;
+  }
+}
+
+/* fd_zksdk_instr_is_preverified returns 1 if the instruction is a
+   top-level instruction with proof data in instruction data, whose
+   proof was verified by fd_zksdk_txn_preverify. */
+static inline int
+fd_zksdk_instr_is_preverified( fd_exec_instr_ctx_t const * ctx ) {
+  fd_exec_txn_ctx_t const * txn_ctx = ctx->txn_ctx;
+  ulong                     idx     = (ulong)txn_ctx->current_instr_idx;
+  return txn_ctx->instr_stack_sz==1 &&
+         idx<txn_ctx->instr_info_cnt &&
+         ctx->instr==&txn_ctx->instr_infos[ idx ] &&
+         ctx->instr->data_sz!=5UL &&
+         fd_ulong_extract_bit( txn_ctx->zksdk_preverified, (int)idx );
+}
+
 /* fd_zksdk_process_verify_proof is equivalent to process_verify_proof()
    and calls specific functions inside instructions/ to verify each
    individual ZKP.
@@ -117,45 +166,8 @@ fd_zksdk_process_verify_proof( fd_exec_instr_ctx_t * ctx ) {
   uchar buffer[ CTX_HEAD_SZ+MAX_SZ ];
 
   /* Specific instruction function */
-  int (*fd_zksdk_instr_verify_proof)( void const *, void const * ) = NULL;
-  switch( instr_id ) {
-  case FD_ZKSDK_INSTR_VERIFY_ZERO_CIPHERTEXT:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_zero_ciphertext;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_CIPHERTEXT_CIPHERTEXT_EQUALITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_ciphertext_ciphertext_equality;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_CIPHERTEXT_COMMITMENT_EQUALITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_ciphertext_commitment_equality;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_PUBKEY_VALIDITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_pubkey_validity;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_PERCENTAGE_WITH_CAP:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_percentage_with_cap;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_BATCHED_RANGE_PROOF_U64:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_batched_range_proof_u64;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_BATCHED_RANGE_PROOF_U128:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_batched_range_proof_u128;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_BATCHED_RANGE_PROOF_U256:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_batched_range_proof_u256;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_GROUPED_CIPHERTEXT_2_HANDLES_VALIDITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_grouped_ciphertext_2_handles_validity;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_BATCHED_GROUPED_CIPHERTEXT_2_HANDLES_VALIDITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_2_handles_validity;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_GROUPED_CIPHERTEXT_3_HANDLES_VALIDITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_grouped_ciphertext_3_handles_validity;
-    break;
-  case FD_ZKSDK_INSTR_VERIFY_BATCHED_GROUPED_CIPHERTEXT_3_HANDLES_VALIDITY:
-    fd_zksdk_instr_verify_proof = &fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_3_handles_validity;
-    break;
-  default:
+  fd_zksdk_instr_verify_proof_fn_t fd_zksdk_instr_verify_proof = fd_zksdk_verify_proof_fn( instr_id );
+  if( FD_UNLIKELY( !fd_zksdk_instr_verify_proof ) ) {
     return FD_EXECUTOR_INSTR_ERR_INVALID_INSTR_DATA;
   }
 
@@ -202,13 +214,17 @@ fd_zksdk_process_verify_proof( fd_exec_instr_ctx_t * ctx ) {
   }
 
   /* Verify individual ZKP
-     https://github.com/anza-xyz/agave/blob/v2.0.1/programs/zk-elgamal-proof/src/lib.rs#L83-L86 */
+     https://github.com/anza-xyz/agave/blob/v2.0.1/programs/zk-elgamal-proof/src/lib.rs#L83-L86
+     Skipped if the proof was already verified in a batch, see
+     fd_zksdk_txn_preverify. */
   void const * proof = context + fd_zksdk_context_sz[instr_id];
-  err = (*fd_zksdk_instr_verify_proof)( context, proof );
-  if( FD_UNLIKELY( err ) ) {
-    //TODO: full log, including err
-    fd_log_collector_msg_literal( ctx, "proof_verification failed" );
-    return FD_EXECUTOR_INSTR_ERR_INVALID_INSTR_DATA;
+  if( FD_LIKELY( !fd_zksdk_instr_is_preverified( ctx ) ) ) {
+    err = (*fd_zksdk_instr_verify_proof)( context, proof, NULL );
+    if( FD_UNLIKELY( err ) ) {
+      //TODO: full log, including err
+      fd_log_collector_msg_literal( ctx, "proof_verification failed" );
+      return FD_EXECUTOR_INSTR_ERR_INVALID_INSTR_DATA;
+    }
   }
 
   /* Create context state if accounts are provided with the instruction
@@ -262,3 +278,57 @@ fd_zksdk_process_verify_proof( fd_exec_instr_ctx_t * ctx ) {
 
   return FD_EXECUTOR_INSTR_SUCCESS;
 }
+
+ulong
+fd_zksdk_txn_batch_add( fd_exec_txn_ctx_t const * txn_ctx,
+                        fd_zksdk_batch_t *        batch ) {
+  ulong mask = 0UL;
+  for( ulong i=0UL; i<txn_ctx->instr_info_cnt; i++ ) {
+    fd_instr_info_t const * instr = &txn_ctx->instr_infos[ i ];
+    if( !fd_memeq( &txn_ctx->account_keys[ instr->program_id ], &fd_solana_zk_elgamal_proof_program_id, sizeof(fd_pubkey_t) ) ) {
+      continue;
+    }
+
+    /* Only proofs in instruction data, with the exact size that
+       fd_zksdk_process_verify_proof expects. */
+    if( instr->data_sz<1UL || instr->data_sz==5UL ) continue;
+    uchar instr_id = instr->data[0];
+    fd_zksdk_instr_verify_proof_fn_t fn = fd_zksdk_verify_proof_fn( instr_id );
+    if( !fn ) continue;
+    ulong context_sz = fd_zksdk_context_sz[ instr_id ];
+    if( instr->data_sz!=1UL+context_sz+fd_zksdk_proof_sz[ instr_id ] ) continue;
+
+    /* The instruction data (proof type, context and proof) determines
+       every point and scalar of the proof's equation. */
+    fd_zksdk_batch_append( batch, instr->data, instr->data_sz );
+    uchar const * context = instr->data + 1;
+    if( (*fn)( context, context+context_sz, batch )==FD_EXECUTOR_INSTR_SUCCESS ) {
+      mask = fd_ulong_set_bit( mask, (int)i );
+    }
+  }
+  return mask;
+}
+
+void
+fd_zksdk_txn_preverify( fd_exec_txn_ctx_t * txn_ctx ) {
+  txn_ctx->zksdk_preverified = 0UL;
+
+  /* Batching a single proof only adds work. */
+  ulong cnt = 0UL;
+  for( ulong i=0UL; i<txn_ctx->instr_info_cnt; i++ ) {
+    fd_instr_info_t const * instr = &txn_ctx->instr_infos[ i ];
+    cnt += fd_memeq( &txn_ctx->account_keys[ instr->program_id ], &fd_solana_zk_elgamal_proof_program_id, sizeof(fd_pubkey_t) ) &&
+           instr->data_sz>5UL;
+  }
+  if( FD_LIKELY( cnt<2UL ) ) return;
+
+  FD_SPAD_FRAME_BEGIN( txn_ctx->spad ) {
+    fd_zksdk_batch_t * batch = fd_zksdk_batch_init( fd_spad_alloc( txn_ctx->spad, FD_ZKSDK_BATCH_ALIGN, sizeof(fd_zksdk_batch_t) ) );
+    ulong mask = fd_zksdk_txn_batch_add( txn_ctx, batch );
+    /* If the batch fails, each proof is verified on its own when its
+       instruction executes, which pinpoints the invalid ones. */
+    if( FD_LIKELY( fd_zksdk_batch_verify( batch ) ) ) {
+      txn_ctx->zksdk_preverified = mask;
+    }
+  } FD_SPAD_FRAME_END;
+}
@@ -3,6 +3,7 @@
 
 #include "../../../fd_flamenco_base.h"
 #include "../../context/fd_exec_instr_ctx.h"
+#include "fd_zksdk_batch.h"
 
 FD_PROTOTYPES_BEGIN
 
@@ -17,5 +18,29 @@ fd_zksdk_process_close_context_state( fd_exec_instr_ctx_t * ctx );
 int
 fd_zksdk_process_verify_proof( fd_exec_instr_ctx_t * ctx );
 
+/* fd_zksdk_txn_batch_add adds the proofs of all the top-level
+   verify_proof instructions of a transaction that carry their proof in
+   instruction data to batch.  Returns a bit mask of the instructions
+   whose proof was added (bit i for instruction i).  Proofs that fail
+   any check other than the final MSM are not added.
+
+   A batch can hold the proofs of many transactions, e.g. a whole
+   block.  If fd_zksdk_batch_verify succeeds, the caller sets each
+   transaction's txn_ctx->zksdk_preverified to the returned mask, and
+   fd_zksdk_process_verify_proof skips verifying those proofs again.
+   Otherwise, the masks are discarded and each proof is verified on its
+   own, so the result of every instruction is the same as without
+   batching. */
+ulong
+fd_zksdk_txn_batch_add( fd_exec_txn_ctx_t const * txn_ctx,
+                        fd_zksdk_batch_t *        batch );
+
+/* fd_zksdk_txn_preverify batch verifies the proofs of a transaction
+   (see fd_zksdk_txn_batch_add) and sets txn_ctx->zksdk_preverified.
+   Does nothing if the transaction has fewer than 2 proofs.  Uses
+   txn_ctx->spad for the batch. */
+void
+fd_zksdk_txn_preverify( fd_exec_txn_ctx_t * txn_ctx );
+
 FD_PROTOTYPES_END
 #endif /* HEADER_fd_src_flamenco_runtime_program_zksdk_fd_zksdk_h */
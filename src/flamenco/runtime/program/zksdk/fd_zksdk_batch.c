@@ -0,0 +1,133 @@
+#include "fd_zksdk_batch.h"
+#include "rangeproofs/fd_rangeproofs.h"
+
+fd_zksdk_batch_t *
+fd_zksdk_batch_init( fd_zksdk_batch_t * batch ) {
+  batch->proof_cnt = 0UL;
+  batch->data_cnt  = 0UL;
+  batch->range_cnt = 0UL;
+  batch->point_cnt = 0UL;
+  batch->gens_n    = 0UL;
+  fd_merlin_transcript_init( batch->transcript, FD_MERLIN_LITERAL("zksdk-batch") );
+  return batch;
+}
+
+void
+fd_zksdk_batch_append( fd_zksdk_batch_t * batch,
+                       uchar const *      data,
+                       ulong              data_sz ) {
+  fd_merlin_transcript_append_message( batch->transcript, FD_MERLIN_LITERAL("proof"), data, (uint)data_sz );
+  batch->data_cnt++;
+}
+
+int
+fd_zksdk_batch_msm_eq( fd_zksdk_batch_t *              batch,
+                       uchar const *                   scalars,
+                       fd_ristretto255_point_t const * points,
+                       ulong                           cnt,
+                       int                             base,
+                       ulong                           gens_n,
+                       fd_ristretto255_point_t *       expected,
+                       int                             neg ) {
+  ulong base_cnt = (ulong)base; /* FD_ZKSDK_BATCH_BASE_* is the number of basepoints */
+  ulong dyn_cnt  = cnt - base_cnt - 2UL*gens_n;
+
+  if( !batch ||
+      batch->proof_cnt >= batch->data_cnt ||
+      batch->proof_cnt >= FD_ZKSDK_BATCH_PROOF_MAX ||
+      batch->point_cnt+dyn_cnt+1UL > FD_ZKSDK_BATCH_POINT_MAX ||
+      ( gens_n && batch->range_cnt >= FD_ZKSDK_BATCH_RANGE_PROOF_MAX ) ) {
+    fd_ristretto255_point_t res[1];
+    fd_ristretto255_multi_scalar_mul( res, scalars, points, cnt );
+    return neg ? fd_ristretto255_point_eq_neg( res, expected ) : fd_ristretto255_point_eq( res, expected );
+  }
+
+  /* Store the equation unweighted, as:
+       sum_i s_i P_i - Y == 0   (or + Y when checking against -Y) */
+
+  fd_zksdk_batch_proof_t * proof = &batch->proofs[ batch->proof_cnt ];
+  proof->point_off = batch->point_cnt;
+  proof->point_cnt = dyn_cnt+1UL;
+  proof->gens_n    = gens_n;
+  proof->gens_idx  = batch->range_cnt;
+
+  uchar const * s = scalars;
+  fd_memset( proof->g, 0, 32 );
+  fd_memset( proof->h, 0, 32 );
+  if( base==FD_ZKSDK_BATCH_BASE_GH ) {
+    fd_curve25519_scalar_set( proof->g, s ); s += 32;
+  }
+  if( base!=FD_ZKSDK_BATCH_BASE_NONE ) {
+    fd_curve25519_scalar_set( proof->h, s ); s += 32;
+  }
+
+  ulong idx = batch->point_cnt;
+  fd_memcpy( &batch->scalars[ idx*32 ], s, dyn_cnt*32 );
+  fd_memcpy( &batch->points[ idx ], &points[ base_cnt ], dyn_cnt*sizeof(fd_ristretto255_point_t) );
+  idx += dyn_cnt; s += dyn_cnt*32;
+
+  fd_curve25519_scalar_set( &batch->scalars[ idx*32 ], neg ? fd_curve25519_scalar_one : fd_curve25519_scalar_minus_one );
+  fd_ristretto255_point_set( &batch->points[ idx ], expected );
+  idx++;
+
+  if( gens_n ) {
+    fd_memcpy( batch->gens[ batch->range_cnt ], s, 2UL*gens_n*32 );
+    batch->range_cnt++;
+  }
+
+  batch->point_cnt = idx;
+  batch->gens_n    = fd_ulong_max( batch->gens_n, gens_n );
+  batch->proof_cnt++;
+  return 1;
+}
+
+int
+fd_zksdk_batch_verify( fd_zksdk_batch_t * batch ) {
+  if( FD_UNLIKELY( !batch->proof_cnt ) ) return 1;
+
+  /* Every proof is fixed by now, draw a 128-bit weight for each of
+     them and apply it. */
+  ulong n = batch->gens_n;
+  fd_memset( batch->g,      0, 32 );
+  fd_memset( batch->h,      0, 32 );
+  fd_memset( batch->gens_h, 0, n*32 );
+  fd_memset( batch->gens_g, 0, n*32 );
+  for( ulong j=0UL; j<batch->proof_cnt; j++ ) {
+    fd_zksdk_batch_proof_t const * proof = &batch->proofs[ j ];
+    uchar w[ 32 ] = {0};
+    fd_merlin_transcript_challenge_bytes( batch->transcript, FD_MERLIN_LITERAL("batch-weight"), w, 16 );
+
+    fd_curve25519_scalar_muladd( batch->g, w, proof->g, batch->g );
+    fd_curve25519_scalar_muladd( batch->h, w, proof->h, batch->h );
+    for( ulong i=proof->point_off; i<proof->point_off+proof->point_cnt; i++ ) {
+      fd_curve25519_scalar_mul( &batch->scalars[ i*32 ], w, &batch->scalars[ i*32 ] );
+    }
+    uchar const * gens = batch->gens[ proof->gens_idx ];
+    for( ulong k=0UL; k<proof->gens_n; k++ ) {
+      fd_curve25519_scalar_muladd( &batch->gens_h[ k*32 ], w, &gens[ k*32 ], &batch->gens_h[ k*32 ] );
+    }
+    for( ulong k=0UL; k<proof->gens_n; k++ ) {
+      fd_curve25519_scalar_muladd( &batch->gens_g[ k*32 ], w, &gens[ (proof->gens_n+k)*32 ], &batch->gens_g[ k*32 ] );
+    }
+  }
+
+  /* Append the shared points after the per-proof points. */
+  ulong idx = batch->point_cnt;
+  fd_curve25519_scalar_set( &batch->scalars[ idx*32 ], batch->g );
+  fd_ristretto255_point_set( &batch->points[ idx ], fd_rangeproofs_basepoint_G );
+  idx++;
+  fd_curve25519_scalar_set( &batch->scalars[ idx*32 ], batch->h );
+  fd_ristretto255_point_set( &batch->points[ idx ], fd_rangeproofs_basepoint_H );
+  idx++;
+  fd_memcpy( &batch->scalars[ idx*32 ],     batch->gens_h, n*32 );
+  fd_memcpy( &batch->scalars[ (idx+n)*32 ], batch->gens_g, n*32 );
+  fd_memcpy( &batch->points[ idx ],   fd_rangeproofs_generators_H, n*sizeof(fd_ristretto255_point_t) );
+  fd_memcpy( &batch->points[ idx+n ], fd_rangeproofs_generators_G, n*sizeof(fd_ristretto255_point_t) );
+  idx += 2UL*n;
+
+  fd_ristretto255_point_t res [1];
+  fd_ristretto255_point_t zero[1];
+  fd_ristretto255_multi_scalar_mul( res, batch->scalars, batch->points, idx );
+  fd_ristretto255_point_set_zero( zero );
+  return fd_ristretto255_point_eq( res, zero );
+}
@@ -0,0 +1,167 @@
+#ifndef HEADER_fd_src_flamenco_runtime_program_zksdk_fd_zksdk_batch_h
+#define HEADER_fd_src_flamenco_runtime_program_zksdk_fd_zksdk_batch_h
+
+/* Batched verification of ZK ElGamal proofs.
+
+   Every ZKP verifier ends with a single check of the form:
+
+     sum_i s_i P_i == Y       (or == -Y for range proofs)
+
+   fd_zksdk_batch_t accumulates the checks of many independent proofs,
+   each multiplied by a random 128-bit weight r_j, into one equation:
+
+     sum_j r_j ( sum_i s_ji P_ji - Y_j ) == 0
+
+   which is then verified with a single MSM.  The basepoints G, H and
+   the range proof generators are shared by all proofs, so their scalars
+   are summed instead of appended, and the MSM cost is paid once rather
+   than once per proof (most proofs are only a handful of points, where
+   the fixed cost of an MSM dominates).
+
+   The weights must not be known before every proof in the batch is
+   fixed, otherwise the errors of two invalid proofs can be chosen to
+   cancel out.  So equations are stored unweighted, and the weights are
+   only drawn by fd_zksdk_batch_verify, from a transcript that has
+   absorbed the full data of every proof in the batch (see
+   fd_zksdk_batch_append).  All the points and scalars of an equation
+   are a function of its proof data, so a set of proofs that contains
+   an invalid one passes the batch check with negligible probability.
+
+   The batch check only says whether all proofs are valid.  When it
+   fails, callers must verify each proof individually (with batch==NULL)
+   to find which ones are invalid, so that results stay identical to
+   verifying proofs one at a time. */
+
+#include "../../../../ballet/ed25519/fd_ristretto255.h"
+#include "merlin/fd_merlin.h"
+
+/* FD_ZKSDK_BATCH_POINT_MAX is the max number of per-proof points
+   (i.e. excluding the shared G, H and generators) in a batch.  The
+   largest proof (batched range proof u256 with 8 commitments) has 30. */
+
+#define FD_ZKSDK_BATCH_POINT_MAX (512UL)
+
+/* FD_ZKSDK_BATCH_GENERATORS_MAX is the max number of range proof
+   generators, i.e. the size of fd_rangeproofs_generators_{G,H}. */
+
+#define FD_ZKSDK_BATCH_GENERATORS_MAX (256UL)
+
+/* FD_ZKSDK_BATCH_PROOF_MAX is the max number of proofs in a batch, and
+   FD_ZKSDK_BATCH_RANGE_PROOF_MAX the max number of range proofs among
+   them (each keeps its own generator scalars until the batch is
+   verified).  A transaction fits at most one range proof in its
+   instruction data. */
+
+#define FD_ZKSDK_BATCH_PROOF_MAX       (64UL)
+#define FD_ZKSDK_BATCH_RANGE_PROOF_MAX (4UL)
+
+/* Shared basepoints at the start of the points passed to
+   fd_zksdk_batch_msm_eq. */
+
+#define FD_ZKSDK_BATCH_BASE_NONE (0) /* no shared basepoints */
+#define FD_ZKSDK_BATCH_BASE_H    (1) /* points[0]==H */
+#define FD_ZKSDK_BATCH_BASE_GH   (2) /* points[0]==G, points[1]==H */
+
+#define FD_ZKSDK_BATCH_ALIGN (64UL)
+
+#define FD_ZKSDK_BATCH_MSM_MAX (FD_ZKSDK_BATCH_POINT_MAX + 2UL + 2UL*FD_ZKSDK_BATCH_GENERATORS_MAX)
+
+/* fd_zksdk_batch_proof_t is a deferred equation.  Its per-proof points
+   are points[point_off,point_off+point_cnt) (the last one is the
+   expected point), and its scalars are not weighted yet. */
+
+struct fd_zksdk_batch_proof {
+  ulong point_off;
+  ulong point_cnt;
+  ulong gens_n;     /* number of generators, 0 if not a range proof */
+  ulong gens_idx;   /* index in gens if gens_n>0 */
+  uchar g[ 32 ];
+  uchar h[ 32 ];
+};
+typedef struct fd_zksdk_batch_proof fd_zksdk_batch_proof_t;
+
+struct __attribute__((aligned(FD_ZKSDK_BATCH_ALIGN))) fd_zksdk_batch {
+  ulong proof_cnt;  /* number of proofs accumulated, in [0,FD_ZKSDK_BATCH_PROOF_MAX] */
+  ulong data_cnt;   /* number of proofs whose data was appended */
+  ulong range_cnt;  /* number of range proofs, in [0,FD_ZKSDK_BATCH_RANGE_PROOF_MAX] */
+  ulong point_cnt;  /* number of per-proof points, in [0,FD_ZKSDK_BATCH_POINT_MAX] */
+  ulong gens_n;     /* number of generators used by the largest range proof */
+
+  /* Absorbs the data of every proof, the weights are drawn from it. */
+  fd_merlin_transcript_t transcript[1];
+
+  fd_zksdk_batch_proof_t proofs[ FD_ZKSDK_BATCH_PROOF_MAX ];
+  uchar                  gens  [ FD_ZKSDK_BATCH_RANGE_PROOF_MAX ][ 2UL*FD_ZKSDK_BATCH_GENERATORS_MAX*32 ];
+
+  /* Summed weighted scalars of the shared points, computed by
+     fd_zksdk_batch_verify. */
+  uchar g     [ 32 ];
+  uchar h     [ 32 ];
+  uchar gens_h[ FD_ZKSDK_BATCH_GENERATORS_MAX*32 ];
+  uchar gens_g[ FD_ZKSDK_BATCH_GENERATORS_MAX*32 ];
+
+  /* Per-proof points and their scalars.  The tail is filled with the
+     shared points by fd_zksdk_batch_verify, so that the MSM runs over a
+     single contiguous array. */
+  uchar                   scalars[ FD_ZKSDK_BATCH_MSM_MAX*32 ];
+  fd_ristretto255_point_t points [ FD_ZKSDK_BATCH_MSM_MAX ];
+};
+typedef struct fd_zksdk_batch fd_zksdk_batch_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_zksdk_batch_init initializes an empty batch.  Returns batch. */
+
+fd_zksdk_batch_t *
+fd_zksdk_batch_init( fd_zksdk_batch_t * batch );
+
+/* fd_zksdk_batch_append absorbs the data of the next proof (e.g. the
+   verify_proof instruction data, which includes the proof type, the
+   context and the proof) into batch.  It must be called before the
+   proof's equation is added with fd_zksdk_batch_msm_eq.  Equations
+   whose data was not appended are checked immediately. */
+
+void
+fd_zksdk_batch_append( fd_zksdk_batch_t * batch,
+                       uchar const *      data,
+                       ulong              data_sz );
+
+/* fd_zksdk_batch_msm_eq is the final check of a ZKP verifier.  It
+   checks that:
+
+     sum_{i in [0,cnt)} scalars[i] points[i] == expected   (neg==0)
+     sum_{i in [0,cnt)} scalars[i] points[i] == -expected  (neg==1)
+
+   base is one of FD_ZKSDK_BATCH_BASE_*, and says which basepoints are
+   at the start of points.  For range proofs, the last 2*gens_n points
+   are fd_rangeproofs_generators_H[0,gens_n) followed by
+   fd_rangeproofs_generators_G[0,gens_n), otherwise gens_n is 0.
+
+   If batch is NULL, the check is done immediately.  Otherwise, the
+   check is deferred to fd_zksdk_batch_verify.  If the batch is full,
+   or the proof data was not appended to it, the check is done
+   immediately.
+
+   Returns 1 if the check passed or was deferred, 0 otherwise. */
+
+int
+fd_zksdk_batch_msm_eq( fd_zksdk_batch_t *              batch,
+                       uchar const *                   scalars,
+                       fd_ristretto255_point_t const * points,
+                       ulong                           cnt,
+                       int                             base,
+                       ulong                           gens_n,
+                       fd_ristretto255_point_t *       expected,
+                       int                             neg );
+
+/* fd_zksdk_batch_verify draws the weights of all the deferred equations
+   in the batch and checks them with a single MSM.  Returns 1 if all the equations hold (or the batch
+   is empty), 0 if at least one proof is invalid.  The batch must be
+   reinitialized before it is reused. */
+
+int
+fd_zksdk_batch_verify( fd_zksdk_batch_t * batch );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_program_zksdk_fd_zksdk_batch_h */
@@ -2,6 +2,7 @@
 #define HEADER_fd_src_flamenco_runtime_program_zksdk_fd_zksdk_private_h
 
 #include "fd_zksdk.h"
+#include "fd_zksdk_batch.h"
 #include "transcript/fd_zksdk_transcript.h"
 #include "rangeproofs/fd_rangeproofs.h"
 #include "../fd_zk_elgamal_proof_program.h"
@@ -69,11 +70,15 @@ struct __attribute__((packed)) fd_zksdk_proof_ctx_state_meta {
 typedef struct fd_zksdk_proof_ctx_state_meta fd_zksdk_proof_ctx_state_meta_t;
 
 /* Define all the fd_zksdk_instr_verify_proof_* functions with a macro
-   so it's easy to keep the interface. */
-#define DEFINE_VERIFY_PROOF(name)                                \
-    int                                                          \
-    fd_zksdk_instr_verify_proof_ ## name( void const * context,  \
-                                          void const * proof );
+   so it's easy to keep the interface.  batch is NULL to verify the
+   proof immediately, otherwise see fd_zksdk_batch_msm_eq. */
+#define DEFINE_VERIFY_PROOF(name)                                      \
+    int                                                                \
+    fd_zksdk_instr_verify_proof_ ## name( void const *       context,  \
+                                          void const *       proof,    \
+                                          fd_zksdk_batch_t * batch );
+
+typedef int (* fd_zksdk_instr_verify_proof_fn_t)( void const *, void const *, fd_zksdk_batch_t * );
 
 FD_PROTOTYPES_BEGIN
 
@@ -23,7 +23,8 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_2_handles_validity(
   uchar const                              handle1_hi [ 32 ],
   uchar const                              handle2_hi [ 32 ],
   bool const                               batched,
-  fd_zksdk_transcript_t *                  transcript ) {
+  fd_zksdk_transcript_t *                  transcript,
+  fd_zksdk_batch_t *                       batch ) {
   /*
     We need to verify the 3 following equivalences.
     Instead of verifying them one by one, it's more efficient to pack
@@ -79,7 +80,6 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_2_handles_validity(
   uchar scalars[ 12 * 32 ];
   fd_ristretto255_point_t points[12];
   fd_ristretto255_point_t y0[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->zr )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -182,16 +182,14 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_2_handles_validity(
   }
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, idx );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y0 ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, idx, FD_ZKSDK_BATCH_BASE_GH, 0UL, y0, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
 }
 
 int
-fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_2_handles_validity( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_2_handles_validity( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_batched_grp_ciph_2h_val_context_t const * context = _context;
   fd_zksdk_batched_grp_ciph_2h_val_proof_t const *   proof   = _proof;
@@ -208,6 +206,7 @@ fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_2_handles_validity( void
     context->grouped_ciphertext_hi.handles[0].handle,
     context->grouped_ciphertext_hi.handles[1].handle,
     true,
-    transcript
+    transcript,
+    batch
   );
 }
@@ -27,7 +27,8 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_3_handles_validity(
   uchar const                              handle2_hi [ 32 ],
   uchar const                              handle3_hi [ 32 ],
   bool const                               batched,
-  fd_zksdk_transcript_t *                  transcript ) {
+  fd_zksdk_transcript_t *                  transcript,
+  fd_zksdk_batch_t *                       batch ) {
   /*
     When batched==false, C, h1, h2 are given and C_hi, h1_hi, h2_hi, h3_hi are NULL.
     When batched==true, they are computed as C = C_lo + t C_hi.
@@ -59,7 +60,6 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_3_handles_validity(
   uchar scalars[ 16 * 32 ];
   fd_ristretto255_point_t points[16];
   fd_ristretto255_point_t y0[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->zr )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -167,16 +167,14 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_3_handles_validity(
   }
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, batched ? 16 : 12 );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y0 ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, batched ? 16 : 12, FD_ZKSDK_BATCH_BASE_GH, 0UL, y0, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
 }
 
 int
-fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_3_handles_validity( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_3_handles_validity( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_batched_grp_ciph_3h_val_context_t const * context = _context;
   fd_zksdk_batched_grp_ciph_3h_val_proof_t const *   proof   = _proof;
@@ -196,6 +194,7 @@ fd_zksdk_instr_verify_proof_batched_grouped_ciphertext_3_handles_validity( void
     context->grouped_ciphertext_hi.handles[1].handle,
     context->grouped_ciphertext_hi.handles[2].handle,
     true,
-    transcript
+    transcript,
+    batch
   );
 }
@@ -100,7 +100,8 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_2_handles_validity(
   uchar const                              handle1_hi [ 32 ],
   uchar const                              handle2_hi [ 32 ],
   bool const                               batched,
-  fd_zksdk_transcript_t *                  transcript );
+  fd_zksdk_transcript_t *                  transcript,
+  fd_zksdk_batch_t *                       batch );
 
 int
 fd_zksdk_verify_proof_batched_grouped_ciphertext_3_handles_validity(
@@ -117,6 +118,7 @@ fd_zksdk_verify_proof_batched_grouped_ciphertext_3_handles_validity(
   uchar const                              handle2_hi [ 32 ],
   uchar const                              handle3_hi [ 32 ],
   bool const                               batched,
-  fd_zksdk_transcript_t *                  transcript );
+  fd_zksdk_transcript_t *                  transcript,
+  fd_zksdk_batch_t *                       batch );
 
 #endif /* HEADER_fd_zksdk_batched_grouped_ciphertext_validity_h */
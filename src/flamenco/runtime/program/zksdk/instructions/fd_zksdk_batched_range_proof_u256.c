@@ -6,7 +6,8 @@ fd_zksdk_verify_proof_range_u256(
   uchar const                               commitments [ 32 ],
   uchar const                               bit_lengths [ 1 ],
   uchar const                               batch_len,
-  fd_zksdk_transcript_t *                   transcript ) {
+  fd_zksdk_transcript_t *                   transcript,
+  fd_zksdk_batch_t *                        batch ) {
 
   const fd_rangeproofs_ipp_proof_t ipp_proof = {
     8,
@@ -20,7 +21,8 @@ fd_zksdk_verify_proof_range_u256(
     commitments,
     bit_lengths,
     batch_len,
-    transcript
+    transcript,
+    batch
   );
 
   if( FD_LIKELY( res == FD_RANGEPROOFS_SUCCESS ) ) {
@@ -30,7 +32,7 @@ fd_zksdk_verify_proof_range_u256(
 }
 
 int
-fd_zksdk_instr_verify_proof_batched_range_proof_u256( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_batched_range_proof_u256( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_batched_range_proof_context_t const * context = _context;
   fd_zksdk_range_proof_u256_proof_t const *      proof   = _proof;
@@ -43,5 +45,5 @@ fd_zksdk_instr_verify_proof_batched_range_proof_u256( void const * _context, voi
   }
 
   /* https://github.com/anza-xyz/agave/blob/v2.0.1/zk-sdk/src/zk_elgamal_proof_program/proof_data/batched_range_proof/batched_range_proof_u64.rs#L93-L95 */
-  return fd_zksdk_verify_proof_range_u256( proof, context->commitments, context->bit_lengths, batch_len, transcript );
+  return fd_zksdk_verify_proof_range_u256( proof, context->commitments, context->bit_lengths, batch_len, transcript, batch );
 }
@@ -18,7 +18,8 @@ fd_zksdk_verify_proof_ciphertext_ciphertext_equality(
   uchar const                           pubkey2    [ 32 ],
   uchar const                           ciphertext1[ 64 ],
   uchar const                           ciphertext2[ 64 ],
-  fd_zksdk_transcript_t *               transcript ) {
+  fd_zksdk_transcript_t *               transcript,
+  fd_zksdk_batch_t *                    batch ) {
   /*
     We store points and scalars in the following arrays:
 
@@ -42,7 +43,6 @@ fd_zksdk_verify_proof_ciphertext_ciphertext_equality(
   uchar scalars[ 11 * 32 ];
   fd_ristretto255_point_t points[11];
   fd_ristretto255_point_t y0[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->zs )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -128,9 +128,7 @@ fd_zksdk_verify_proof_ciphertext_ciphertext_equality(
   fd_curve25519_scalar_mul( &scalars[ 10*32 ], proof->zr, ww );        //  www z_r
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, 11 );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y0 ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, 11, FD_ZKSDK_BATCH_BASE_GH, 0UL, y0, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -138,7 +136,7 @@ fd_zksdk_verify_proof_ciphertext_ciphertext_equality(
 
 /* https://github.com/anza-xyz/agave/blob/v2.0.1/zk-sdk/src/zk_elgamal_proof_program/proof_data/ciphertext_ciphertext_equality.rs#L105 */
 int
-fd_zksdk_instr_verify_proof_ciphertext_ciphertext_equality( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_ciphertext_ciphertext_equality( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_ciph_ciph_eq_context_t const * context = _context;
   fd_zksdk_ciph_ciph_eq_proof_t const *   proof   = _proof;
@@ -150,6 +148,7 @@ fd_zksdk_instr_verify_proof_ciphertext_ciphertext_equality( void const * _contex
     context->pubkey2,
     context->ciphertext1,
     context->ciphertext2,
-    transcript
+    transcript,
+    batch
   );
 }
@@ -15,7 +15,8 @@ fd_zksdk_verify_proof_ciphertext_commitment_equality(
   uchar const                           pubkey     [ 32 ],
   uchar const                           ciphertext [ 64 ],
   uchar const                           commitment [ 32 ],
-  fd_zksdk_transcript_t *               transcript ) {
+  fd_zksdk_transcript_t *               transcript,
+  fd_zksdk_batch_t *                    batch ) {
   /*
     We need to verify the 3 following equivalences.
     Instead of verifying them one by one, it's more efficient to pack
@@ -44,7 +45,6 @@ fd_zksdk_verify_proof_ciphertext_commitment_equality(
   uchar scalars[ 8 * 32 ];
   fd_ristretto255_point_t points[8];
   fd_ristretto255_point_t y2[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->zs )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -111,16 +111,14 @@ fd_zksdk_verify_proof_ciphertext_commitment_equality(
   fd_curve25519_scalar_muladd( &scalars[ 0*32 ], proof->zx, w, proof->zx );        // z_x w + z_x
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, 8 );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y2 ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, 8, FD_ZKSDK_BATCH_BASE_GH, 0UL, y2, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
 }
 
 int
-fd_zksdk_instr_verify_proof_ciphertext_commitment_equality( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_ciphertext_commitment_equality( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_ciph_comm_eq_context_t const * context = _context;
   fd_zksdk_ciph_comm_eq_proof_t const *   proof   = _proof;
@@ -131,6 +129,7 @@ fd_zksdk_instr_verify_proof_ciphertext_commitment_equality( void const * _contex
     context->pubkey,
     context->ciphertext,
     context->commitment,
-    transcript
+    transcript,
+    batch
   );
 }
@@ -26,6 +26,7 @@ fd_zksdk_verify_proof_ciphertext_commitment_equality(
   uchar const                           pubkey     [ 32 ],
   uchar const                           ciphertext [ 64 ],
   uchar const                           commitment [ 32 ],
-  fd_zksdk_transcript_t *               transcript );
+  fd_zksdk_transcript_t *               transcript,
+  fd_zksdk_batch_t *                    batch );
 
 #endif /* HEADER_fd_zksdk_ciphertext_commitment_equality_h */
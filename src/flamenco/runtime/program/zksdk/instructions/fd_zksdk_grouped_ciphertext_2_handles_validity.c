@@ -11,7 +11,7 @@ grouped_ciphertext_validity_transcript_init(
 }
 
 int
-fd_zksdk_instr_verify_proof_grouped_ciphertext_2_handles_validity( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_grouped_ciphertext_2_handles_validity( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_grp_ciph_2h_val_context_t const * context = _context;
   fd_zksdk_grp_ciph_2h_val_proof_t const *   proof   = _proof;
@@ -29,6 +29,7 @@ fd_zksdk_instr_verify_proof_grouped_ciphertext_2_handles_validity( void const *
     NULL,
     NULL,
     false,
-    transcript
+    transcript,
+    batch
   );
 }
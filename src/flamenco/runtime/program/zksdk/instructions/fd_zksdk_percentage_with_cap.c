@@ -18,7 +18,8 @@ fd_zksdk_verify_proof_percentage_with_cap(
   uchar const                                  delta_commitment     [ 32 ],
   uchar const                                  claimed_commitment   [ 32 ],
   ulong const                                  max_value,
-  fd_zksdk_transcript_t *                      transcript ) {
+  fd_zksdk_transcript_t *                      transcript,
+  fd_zksdk_batch_t *                           batch ) {
   /*
     We store points and scalars in the following arrays:
 
@@ -38,7 +39,6 @@ fd_zksdk_verify_proof_percentage_with_cap(
   uchar scalars[ 7 * 32 ];
   fd_ristretto255_point_t points[7];
   fd_ristretto255_point_t y[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->percentage_max_proof.z_max )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -129,9 +129,7 @@ fd_zksdk_verify_proof_percentage_with_cap(
   fd_curve25519_scalar_mul( &scalars[ 6*32 ], &scalars[ 5*32 ], c_eq ); //  ww c_eq
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, 7 );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, 7, FD_ZKSDK_BATCH_BASE_GH, 0UL, y, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -139,7 +137,7 @@ fd_zksdk_verify_proof_percentage_with_cap(
 
 /* https://github.com/anza-xyz/agave/blob/v2.0.1/zk-sdk/src/zk_elgamal_proof_program/proof_data/percentage_with_cap.rs#L118 */
 int
-fd_zksdk_instr_verify_proof_percentage_with_cap( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_percentage_with_cap( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_percentage_with_cap_context_t const * context = _context;
   fd_zksdk_percentage_with_cap_proof_t const *   proof   = _proof;
@@ -151,6 +149,7 @@ fd_zksdk_instr_verify_proof_percentage_with_cap( void const * _context, void con
     context->delta_commitment,
     context->claimed_commitment,
     context->max_value,
-    transcript
+    transcript,
+    batch
   );
 }
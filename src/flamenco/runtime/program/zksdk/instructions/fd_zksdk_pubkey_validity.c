@@ -12,7 +12,8 @@ static inline int
 fd_zksdk_verify_proof_pubkey_validity(
   fd_zksdk_pubkey_validity_proof_t const * proof,
   uchar const                              pubkey[ 32 ],
-  fd_zksdk_transcript_t *                  transcript ) {
+  fd_zksdk_transcript_t *                  transcript,
+  fd_zksdk_batch_t *                       batch ) {
   /*
     We need to verify the following equivalence:
         z H =?= c P + Y
@@ -24,7 +25,6 @@ fd_zksdk_verify_proof_pubkey_validity(
   uchar scalars[ 2 * 32 ];
   fd_ristretto255_point_t points[2];
   fd_ristretto255_point_t y[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->z )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -54,9 +54,7 @@ fd_zksdk_verify_proof_pubkey_validity(
   fd_curve25519_scalar_neg( &scalars[ 1*32 ], c );        // -c
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, 2 );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, 2, FD_ZKSDK_BATCH_BASE_H, 0UL, y, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -64,7 +62,7 @@ fd_zksdk_verify_proof_pubkey_validity(
 
 /* https://github.com/anza-xyz/agave/blob/v2.0.1/zk-sdk/src/zk_elgamal_proof_program/proof_data/pubkey_validity.rs#L73 */
 int
-fd_zksdk_instr_verify_proof_pubkey_validity( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_pubkey_validity( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_pubkey_validity_context_t const * context = _context;
   fd_zksdk_pubkey_validity_proof_t const *   proof   = _proof;
@@ -73,6 +71,7 @@ fd_zksdk_instr_verify_proof_pubkey_validity( void const * _context, void const *
   return fd_zksdk_verify_proof_pubkey_validity(
     proof,
     context->pubkey,
-    transcript
+    transcript,
+    batch
   );
 }
@@ -14,7 +14,8 @@ fd_zksdk_verify_proof_zero_ciphertext(
   fd_zksdk_zero_ciphertext_proof_t const * proof,
   uchar const                              pubkey    [ 32 ],
   uchar const                              ciphertext[ 64 ],
-  fd_zksdk_transcript_t *                  transcript ) {
+  fd_zksdk_transcript_t *                  transcript,
+  fd_zksdk_batch_t *                       batch ) {
   /*
     We need to verify the 2 following equivalences.
     Instead of verifying them one by one, it's more efficient to pack
@@ -39,7 +40,6 @@ fd_zksdk_verify_proof_zero_ciphertext(
   uchar scalars[ 5 * 32 ];
   fd_ristretto255_point_t points[5];
   fd_ristretto255_point_t y[1];
-  fd_ristretto255_point_t res[1];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( proof->z )==NULL ) ) {
     return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -87,9 +87,7 @@ fd_zksdk_verify_proof_zero_ciphertext(
   fd_curve25519_scalar_neg( &scalars[ 4*32 ], w );                   // -w
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, 5 );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq( res, y ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, 5, FD_ZKSDK_BATCH_BASE_H, 0UL, y, 0 ) ) ) {
     return FD_EXECUTOR_INSTR_SUCCESS;
   }
   return FD_ZKSDK_VERIFY_PROOF_ERROR;
@@ -97,7 +95,7 @@ fd_zksdk_verify_proof_zero_ciphertext(
 
 /* https://github.com/anza-xyz/agave/blob/v2.0.1/zk-sdk/src/zk_elgamal_proof_program/proof_data/zero_ciphertext.rs#L81 */
 int
-fd_zksdk_instr_verify_proof_zero_ciphertext( void const * _context, void const * _proof ) {
+fd_zksdk_instr_verify_proof_zero_ciphertext( void const * _context, void const * _proof, fd_zksdk_batch_t * batch ) {
   fd_zksdk_transcript_t transcript[1];
   fd_zksdk_zero_ciphertext_context_t const * context = _context;
   fd_zksdk_zero_ciphertext_proof_t const *   proof   = _proof;
@@ -107,6 +105,7 @@ fd_zksdk_instr_verify_proof_zero_ciphertext( void const * _context, void const *
     proof,
     context->pubkey,
     context->ciphertext,
-    transcript
+    transcript,
+    batch
   );
 }
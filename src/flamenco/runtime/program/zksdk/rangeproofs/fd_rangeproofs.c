@@ -51,7 +51,8 @@ fd_rangeproofs_verify(
   uchar const                          commitments [ 32 ],
   uchar const                          bit_lengths [ 1 ],
   uchar const                          batch_len,
-  fd_merlin_transcript_t *             transcript ) {
+  fd_merlin_transcript_t *             transcript,
+  fd_zksdk_batch_t *                   batch ) {
 
   /* https://github.com/anza-xyz/agave/blob/v2.0.1/zk-sdk/src/range_proof/mod.rs#L288
 
@@ -150,7 +151,6 @@ fd_rangeproofs_verify(
   uchar scalars[ MAX*32 ];
   fd_ristretto255_point_t points[ MAX ];
   fd_ristretto255_point_t a_res[ 1 ];
-  fd_ristretto255_point_t res[ 1 ];
 
   if( FD_UNLIKELY( fd_curve25519_scalar_validate( range_proof->tx )==NULL ) ) {
     return FD_RANGEPROOFS_ERROR;
@@ -348,9 +348,7 @@ fd_rangeproofs_verify(
   fd_curve25519_scalar_muladd(  &scalars[ 0 ], &scalars[ 0 ], w, delta );
 
   /* Compute the final MSM */
-  fd_ristretto255_multi_scalar_mul( res, scalars, points, idx );
-
-  if( FD_LIKELY( fd_ristretto255_point_eq_neg( res, a_res ) ) ) {
+  if( FD_LIKELY( fd_zksdk_batch_msm_eq( batch, scalars, points, idx, FD_ZKSDK_BATCH_BASE_GH, n, a_res, 1 ) ) ) {
     return FD_RANGEPROOFS_SUCCESS;
   }
 
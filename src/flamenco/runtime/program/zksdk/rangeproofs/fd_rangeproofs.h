@@ -3,6 +3,7 @@
 
 #include "../../../../fd_flamenco_base.h"
 #include "./fd_rangeproofs_transcript.h"
+#include "../fd_zksdk_batch.h"
 
 #if FD_HAS_AVX512
 #include "./fd_rangeproofs_table_avx512.c"
@@ -50,6 +51,10 @@ typedef struct fd_rangeproofs_ipp_proof fd_rangeproofs_ipp_proof_t;
 
 FD_PROTOTYPES_BEGIN
 
+/* fd_rangeproofs_verify verifies a (batched) range proof.  If batch is
+   not NULL, the final MSM check is deferred to the batch (see
+   fd_zksdk_batch.h). */
+
 int
 fd_rangeproofs_verify(
   fd_rangeproofs_range_proof_t const * range_proof,
@@ -57,7 +62,8 @@ fd_rangeproofs_verify(
   uchar const                          commitments [ 32 ],
   uchar const                          bit_lengths [ 1 ],
   uchar const                          batch_len,
-  fd_merlin_transcript_t *             transcript );
+  fd_merlin_transcript_t *             transcript,
+  fd_zksdk_batch_t *                   batch );
 
 FD_PROTOTYPES_END
 #endif /* HEADER_fd_src_flamenco_runtime_program_zksdk_fd_rangeproofs_h */
@@ -1,9 +1,11 @@
 /* Tests are run through `make run-test-vectors` and are available at:
    https://github.com/firedancer-io/test-vectors/tree/main/instr/fixtures/zk_sdk
 
-   This unit test just runs an instance of pubkey_validity. */
+   This unit test just runs an instance of pubkey_validity, and checks
+   batch verification. */
 #include "fd_zksdk_private.h"
 #include "../../../../ballet/hex/fd_hex.h"
+#include "../../fd_system_ids.h"
 
 #include "instructions/test_fd_zksdk_pubkey_validity.h"
 
@@ -79,13 +81,13 @@ test_pubkey_validity( FD_FN_UNUSED fd_rng_t * rng ) {
   void const * proof = tx + proof_offset;
 
   // valid
-  FD_TEST( fd_zksdk_instr_verify_proof_pubkey_validity( context, proof )==FD_EXECUTOR_INSTR_SUCCESS );
+  FD_TEST( fd_zksdk_instr_verify_proof_pubkey_validity( context, proof, NULL )==FD_EXECUTOR_INSTR_SUCCESS );
   FD_TEST( fd_zksdk_process_verify_proof( &ctx )==FD_EXECUTOR_INSTR_SUCCESS );
   FD_TEST( fd_executor_zk_elgamal_proof_program_execute( &ctx )==FD_EXECUTOR_INSTR_SUCCESS );
 
   // invalid proof
   tx[1 + proof_offset] ^= 0xff;
-  FD_TEST( fd_zksdk_instr_verify_proof_pubkey_validity( context, proof )==FD_ZKSDK_VERIFY_PROOF_ERROR );
+  FD_TEST( fd_zksdk_instr_verify_proof_pubkey_validity( context, proof, NULL )==FD_ZKSDK_VERIFY_PROOF_ERROR );
   FD_TEST( fd_zksdk_process_verify_proof( &ctx )==FD_EXECUTOR_INSTR_ERR_INVALID_INSTR_DATA );
   tx[1 + proof_offset] ^= 0xff;
 
@@ -100,7 +102,7 @@ test_pubkey_validity( FD_FN_UNUSED fd_rng_t * rng ) {
   long dt = fd_log_wallclock();
   for( ulong rem=iter; rem; rem-- ) {
     FD_COMPILER_FORGET( proof ); FD_COMPILER_FORGET( context );
-    fd_zksdk_instr_verify_proof_pubkey_validity( context, proof );
+    fd_zksdk_instr_verify_proof_pubkey_validity( context, proof, NULL );
   }
   dt = fd_log_wallclock() - dt;
   log_bench( "fd_zksdk_instr_verify_proof_pubkey_validity", iter, dt );
@@ -108,6 +110,211 @@ test_pubkey_validity( FD_FN_UNUSED fd_rng_t * rng ) {
   free(tx);
 }
 
+static void
+rand_scalar( uchar s[ 32 ], fd_rng_t * rng ) {
+  uchar buf[ 64 ];
+  for( ulong i=0UL; i<64UL; i++ ) buf[ i ] = fd_rng_uchar( rng );
+  fd_curve25519_scalar_reduce( s, buf );
+}
+
+static void
+rand_point( fd_ristretto255_point_t * p, fd_rng_t * rng ) {
+  uchar buf[ 64 ];
+  for( ulong i=0UL; i<64UL; i++ ) buf[ i ] = fd_rng_uchar( rng );
+  fd_ristretto255_hash_to_curve( p, buf );
+}
+
+/* add_rand_eq adds a random equation with the given layout to batch
+   (and checks it on its own).  If bad, the equation doesn't hold.  If
+   err is not NULL, the expected point is off by err.  Unless unbound,
+   a random proof data is appended to the batch first. */
+
+static void
+add_rand_eq( fd_zksdk_batch_t *              batch,
+             fd_rng_t *                      rng,
+             int                             base,
+             ulong                           dyn_cnt,
+             ulong                           gens_n,
+             int                             neg,
+             int                             bad,
+             fd_ristretto255_point_t const * err,
+             int                             unbound ) {
+  static uchar scalars[ FD_ZKSDK_BATCH_MSM_MAX*32 ];
+  static fd_ristretto255_point_t points[ FD_ZKSDK_BATCH_MSM_MAX ];
+  ulong base_cnt = (ulong)base;
+  ulong cnt      = base_cnt + dyn_cnt + 2UL*gens_n;
+
+  if( base==FD_ZKSDK_BATCH_BASE_GH ) fd_ristretto255_point_set( &points[ 0 ], fd_zksdk_basepoint_G );
+  if( base!=FD_ZKSDK_BATCH_BASE_NONE ) fd_ristretto255_point_set( &points[ base_cnt-1UL ], fd_zksdk_basepoint_H );
+  for( ulong i=base_cnt; i<base_cnt+dyn_cnt; i++ ) rand_point( &points[ i ], rng );
+  fd_memcpy( &points[ cnt-2UL*gens_n ], fd_rangeproofs_generators_H, gens_n*sizeof(fd_ristretto255_point_t) );
+  fd_memcpy( &points[ cnt-gens_n ],     fd_rangeproofs_generators_G, gens_n*sizeof(fd_ristretto255_point_t) );
+  for( ulong i=0UL; i<cnt; i++ ) rand_scalar( &scalars[ i*32 ], rng );
+
+  fd_ristretto255_point_t y[1];
+  fd_ristretto255_multi_scalar_mul( y, scalars, points, cnt );
+  if( err ) fd_ristretto255_point_add( y, y, err );
+  if( neg ) fd_ed25519_point_neg( y, y );
+  if( bad ) scalars[ fd_rng_ulong_roll( rng, cnt )*32 ] ^= 1;
+
+  uchar data[ 32 ];
+  for( ulong i=0UL; i<32UL; i++ ) data[ i ] = fd_rng_uchar( rng );
+  if( !unbound ) fd_zksdk_batch_append( batch, data, 32UL );
+
+  FD_TEST( fd_zksdk_batch_msm_eq( NULL, scalars, points, cnt, base, gens_n, y, neg )==( !bad && !err ) );
+  FD_TEST( fd_zksdk_batch_msm_eq( batch, scalars, points, cnt, base, gens_n, y, neg )==( !unbound || ( !bad && !err ) ) );
+}
+
+static void
+test_batch_msm( fd_rng_t * rng ) {
+  static fd_zksdk_batch_t batch[1];
+
+  FD_TEST( fd_zksdk_batch_verify( fd_zksdk_batch_init( batch ) ) );
+
+  for( int bad=0; bad<2; bad++ ) {
+    fd_zksdk_batch_init( batch );
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH,   6UL,   0UL, 0, 0,   NULL, 0 );
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_H,    1UL,   0UL, 0, 0,   NULL, 0 );
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH,  17UL,  64UL, 1, 0,   NULL, 0 );
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_NONE, 3UL,   0UL, 0, 0,   NULL, 0 );
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH,  21UL, 128UL, 1, bad, NULL, 0 );
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH,   8UL,   0UL, 0, 0,   NULL, 0 );
+    FD_TEST( batch->proof_cnt==6UL );
+    FD_TEST( batch->gens_n==128UL );
+    FD_TEST( fd_zksdk_batch_verify( batch )==!bad );
+  }
+
+  /* Two invalid equations whose errors cancel out when summed (or
+     with any weights chosen before both are fixed) fail the batch */
+  fd_ristretto255_point_t err[1], err_neg[1];
+  rand_point( err, rng );
+  fd_ed25519_point_neg( err_neg, err );
+  fd_zksdk_batch_init( batch );
+  add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_H,  2UL, 0UL, 0, 0, err,     0 );
+  add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_H,  2UL, 0UL, 0, 0, err_neg, 0 );
+  add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH, 4UL, 0UL, 0, 0, NULL,    0 );
+  FD_TEST( !fd_zksdk_batch_verify( batch ) );
+
+  /* Equations whose proof data was not appended are checked
+     immediately */
+  fd_zksdk_batch_init( batch );
+  add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH, 4UL, 0UL, 0, 0, NULL, 0 );
+  add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH, 4UL, 0UL, 0, 0, NULL, 1 );
+  add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH, 4UL, 0UL, 0, 1, NULL, 1 );
+  FD_TEST( batch->proof_cnt==1UL );
+  FD_TEST( fd_zksdk_batch_verify( batch ) );
+
+  /* When full, equations are checked immediately */
+  fd_zksdk_batch_init( batch );
+  for( ulong i=0UL; i<FD_ZKSDK_BATCH_POINT_MAX/8UL+2UL; i++ ) {
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH, 7UL, 0UL, 0, 0, NULL, 0 );
+  }
+  FD_TEST( batch->proof_cnt==FD_ZKSDK_BATCH_POINT_MAX/8UL );
+  FD_TEST( fd_zksdk_batch_verify( batch ) );
+
+  fd_zksdk_batch_init( batch );
+  for( ulong i=0UL; i<FD_ZKSDK_BATCH_RANGE_PROOF_MAX+1UL; i++ ) {
+    add_rand_eq( batch, rng, FD_ZKSDK_BATCH_BASE_GH, 5UL, 8UL, 1, 0, NULL, 0 );
+  }
+  FD_TEST( batch->range_cnt==FD_ZKSDK_BATCH_RANGE_PROOF_MAX );
+  FD_TEST( batch->proof_cnt==FD_ZKSDK_BATCH_RANGE_PROOF_MAX );
+  FD_TEST( fd_zksdk_batch_verify( batch ) );
+}
+
+static void
+test_txn_preverify( fd_rng_t * rng ) {
+  static fd_exec_txn_ctx_t txn_ctx[1];
+  static uchar spad_mem[ FD_SPAD_FOOTPRINT( 1UL<<20 ) ] __attribute__((aligned(FD_SPAD_ALIGN)));
+  fd_spad_t * spad = fd_spad_join( fd_spad_new( spad_mem, 1UL<<20 ) );
+  FD_TEST( spad );
+
+  ulong hex_sz = sizeof(tx_pubkey_validity);
+  ulong offset = instr_offset_pubkey_validity;
+  ulong tx_len = 0;
+  uchar * tx = load_test_tx( tx_pubkey_validity, hex_sz, &tx_len );
+  ulong z_off = offset + 1 + fd_zksdk_context_sz[FD_ZKSDK_INSTR_VERIFY_PUBKEY_VALIDITY] + 32;
+
+  /* 3 copies of the same proof, one with a corrupted scalar */
+  ulong instr_cnt = 4UL;
+  uchar * data[ 4 ];
+  for( ulong i=0UL; i<instr_cnt; i++ ) {
+    data[ i ] = malloc( tx_len - offset );
+    fd_memcpy( data[ i ], tx + offset, tx_len - offset );
+  }
+  data[ 2 ][ z_off - offset ] ^= 1;
+
+  fd_exec_txn_ctx_setup_basic( txn_ctx );
+  txn_ctx->spad = spad;
+  txn_ctx->account_keys[ 0 ] = fd_solana_zk_elgamal_proof_program_id;
+  txn_ctx->account_keys[ 1 ] = fd_solana_system_program_id;
+  txn_ctx->instr_info_cnt = instr_cnt;
+  for( ulong i=0UL; i<instr_cnt; i++ ) {
+    txn_ctx->instr_infos[ i ] = (fd_instr_info_t){
+      .program_id = (uchar)( i==3UL ),
+      .data       = data[ i ],
+      .data_sz    = (ushort)( tx_len - offset ),
+    };
+  }
+
+  fd_spad_push( spad );
+
+  /* The batch fails, nothing is marked */
+  fd_zksdk_txn_preverify( txn_ctx );
+  FD_TEST( txn_ctx->zksdk_preverified==0UL );
+
+  fd_exec_instr_ctx_t ctx[1] = {{ .txn_ctx = txn_ctx, .instr = &txn_ctx->instr_infos[ 2 ] }};
+  fd_log_collector_init( &txn_ctx->log_collector, 1 );
+  txn_ctx->instr_stack_sz    = 1;
+  txn_ctx->current_instr_idx = 2;
+  FD_TEST( fd_zksdk_process_verify_proof( ctx )==FD_EXECUTOR_INSTR_ERR_INVALID_INSTR_DATA );
+  txn_ctx->instr_stack_sz    = 0;
+
+  /* All valid, the program instructions are marked */
+  data[ 2 ][ z_off - offset ] ^= 1;
+  fd_zksdk_txn_preverify( txn_ctx );
+  FD_TEST( txn_ctx->zksdk_preverified==7UL );
+
+  ctx->instr = &txn_ctx->instr_infos[ 1 ];
+  txn_ctx->instr_stack_sz    = 1;
+  txn_ctx->current_instr_idx = 1;
+  FD_TEST( fd_zksdk_process_verify_proof( ctx )==FD_EXECUTOR_INSTR_SUCCESS );
+  txn_ctx->instr_stack_sz    = 0;
+
+  /* Proofs in account data are never batched */
+  txn_ctx->instr_infos[ 0 ].data_sz = 5;
+  txn_ctx->instr_infos[ 2 ].data_sz = 5;
+  fd_zksdk_txn_preverify( txn_ctx );
+  FD_TEST( txn_ctx->zksdk_preverified==0UL );
+
+  fd_spad_pop( spad );
+
+#if BENCH
+  ulong iter = 1000UL;
+  txn_ctx->instr_infos[ 0 ].data_sz = txn_ctx->instr_infos[ 1 ].data_sz;
+  txn_ctx->instr_infos[ 2 ].data_sz = txn_ctx->instr_infos[ 1 ].data_sz;
+  long dt = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    for( ulong i=0UL; i<3UL; i++ ) fd_zksdk_instr_verify_proof_pubkey_validity( data[ i ]+1, data[ i ]+33, NULL );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "3x pubkey_validity (one by one)", iter, dt );
+
+  dt = fd_log_wallclock();
+  fd_spad_push( spad );
+  for( ulong rem=iter; rem; rem-- ) {
+    fd_zksdk_txn_preverify( txn_ctx );
+  }
+  fd_spad_pop( spad );
+  dt = fd_log_wallclock() - dt;
+  log_bench( "3x pubkey_validity (batched)", iter, dt );
+#endif
+
+  (void)rng;
+  for( ulong i=0UL; i<instr_cnt; i++ ) free( data[ i ] );
+  free( tx );
+  fd_spad_delete( fd_spad_leave( spad ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -116,6 +323,8 @@ main( int     argc,
   fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
 
   test_pubkey_validity( rng );
+  test_batch_msm( rng );
+  test_txn_preverify( rng );
 
   fd_rng_delete( fd_rng_leave( rng ) );
 
@@ -24,6 +24,10 @@ main( int argc, char ** argv ) {
   fd_banks_t * banks = fd_banks_join( mem );
   FD_TEST( banks );
 
+  fd_pubkey_t key_a = { .uc = { 1 } };
+  fd_pubkey_t key_b = { .uc = { 2 } };
+  fd_pubkey_t key_c = { .uc = { 3 } };
+
   fd_bank_t * bank = fd_banks_init_bank( banks, 1UL );
   FD_TEST( bank );
 
@@ -77,17 +81,20 @@ main( int argc, char ** argv ) {
   FD_TEST( bank9 );
   FD_TEST( fd_bank_capitalization_get( bank9 ) == 2100UL );
 
-  /* Set some CoW fields. */
-  fd_account_keys_global_t * keys = fd_bank_vote_account_keys_locking_modify( bank9 );
-  keys->account_keys_pool_offset = 100UL;
-  keys->account_keys_root_offset = 100UL;
+  /* Set some key sets. */
+  fd_bank_keys_t * keys = fd_bank_vote_account_keys_locking_modify( bank9 );
+  FD_TEST( fd_bank_keys_insert( keys, &key_a ) );
   fd_bank_vote_account_keys_end_locking_modify( bank9 );
 
-  fd_account_keys_global_t * keys2 = fd_bank_stake_account_keys_locking_modify( bank9 );
-  keys2->account_keys_pool_offset = 101UL;
-  keys2->account_keys_root_offset = 101UL;
+  fd_bank_keys_t * keys2 = fd_bank_stake_account_keys_locking_modify( bank9 );
+  FD_TEST( fd_bank_keys_insert( keys2, &key_b ) );
   fd_bank_stake_account_keys_end_locking_modify( bank9 );
 
+  /* Siblings do not see the modifications. */
+  fd_bank_keys_t const * keys_const = fd_bank_vote_account_keys_locking_query( bank8 );
+  FD_TEST( fd_bank_keys_cnt( keys_const )==0UL );
+  fd_bank_vote_account_keys_end_locking_query( bank8 );
+
   /* Verify that the bank is published and that it is indeed bank7 */
 
   fd_bank_t const * new_root = fd_banks_publish( banks, 7UL );
@@ -103,21 +110,24 @@ main( int argc, char ** argv ) {
   FD_TEST( bank11 );
   FD_TEST( fd_bank_capitalization_get( bank11 ) == 2100UL );
 
-  fd_account_keys_global_t const * keys3 = fd_bank_vote_account_keys_locking_query( bank11 );
-  FD_TEST( keys3->account_keys_pool_offset == 100UL );
-  FD_TEST( keys3->account_keys_root_offset == 100UL );
+  fd_bank_keys_t const * keys3 = fd_bank_vote_account_keys_locking_query( bank11 );
+  FD_TEST( fd_bank_keys_cnt( keys3 )==1UL && fd_bank_keys_test( keys3, &key_a ) );
   fd_bank_vote_account_keys_end_locking_query( bank11 );
 
-  fd_account_keys_global_t const * keys4 = fd_bank_stake_account_keys_locking_query( bank11 );
-  FD_TEST( keys4->account_keys_pool_offset == 101UL );
-  FD_TEST( keys4->account_keys_root_offset == 101UL );
+  fd_bank_keys_t const * keys4 = fd_bank_stake_account_keys_locking_query( bank11 );
+  FD_TEST( fd_bank_keys_cnt( keys4 )==1UL && fd_bank_keys_test( keys4, &key_b ) );
   fd_bank_stake_account_keys_end_locking_query( bank11 );
 
   keys = fd_bank_vote_account_keys_locking_modify( bank11 );
-  keys->account_keys_pool_offset = 200UL;
-  keys->account_keys_root_offset = 200UL;
+  FD_TEST( fd_bank_keys_insert( keys, &key_c ) );
+  FD_TEST( fd_bank_keys_remove( keys, &key_a ) );
   fd_bank_vote_account_keys_end_locking_modify( bank11 );
 
+  /* The parent does not see the child's modifications. */
+  keys_const = fd_bank_vote_account_keys_locking_query( bank9 );
+  FD_TEST( fd_bank_keys_cnt( keys_const )==1UL && fd_bank_keys_test( keys_const, &key_a ) );
+  fd_bank_vote_account_keys_end_locking_query( bank9 );
+
   fd_clock_timestamp_votes_global_t const * votes_const = fd_bank_clock_timestamp_votes_locking_query( bank11 );
   FD_TEST( !votes_const );
   fd_bank_clock_timestamp_votes_end_locking_query( bank11 );
@@ -145,13 +155,11 @@ main( int argc, char ** argv ) {
 
   /* Verify that the CoW fields are properly set for bank11 */
   keys3 = fd_bank_vote_account_keys_locking_query( bank11 );
-  FD_TEST( keys3->account_keys_pool_offset == 200UL );
-  FD_TEST( keys3->account_keys_root_offset == 200UL );
+  FD_TEST( fd_bank_keys_cnt( keys3 )==1UL && fd_bank_keys_test( keys3, &key_c ) );
   fd_bank_vote_account_keys_end_locking_query( bank11 );
 
   keys4 = fd_bank_stake_account_keys_locking_query( bank11 );
-  FD_TEST( keys4->account_keys_pool_offset == 101UL );
-  FD_TEST( keys4->account_keys_root_offset == 101UL );
+  FD_TEST( fd_bank_keys_cnt( keys4 )==1UL && fd_bank_keys_test( keys4, &key_b ) );
   fd_bank_stake_account_keys_end_locking_query( bank11 );
 
   votes_const = fd_bank_clock_timestamp_votes_locking_query( bank11 );
@@ -159,6 +167,78 @@ main( int argc, char ** argv ) {
   FD_TEST( votes->votes_root_offset == 102UL );
   fd_bank_clock_timestamp_votes_end_locking_query( bank11 );
 
+  /* A snapshot of bank11 copies the non-CoW fields and aliases the CoW
+     fields of bank11, whose pool elements are pinned until released.
+     No lock is held while pinned. */
+  void * snap_mem = fd_wksp_alloc_laddr( wksp, fd_bank_align(), fd_bank_footprint(), 1UL );
+  FD_TEST( snap_mem );
+  fd_bank_pin_t pin[1];
+  FD_TEST( !fd_banks_snapshot_bank( banks, 3UL, snap_mem, pin, NULL ) );
+  FD_TEST( fd_banks_bank_idx( banks, 3UL )==ULONG_MAX );
+
+  ulong       snap_idx = ULONG_MAX;
+  fd_bank_t * snap     = fd_banks_snapshot_bank( banks, 11UL, snap_mem, pin, &snap_idx );
+  FD_TEST( snap==snap_mem );
+  FD_TEST( snap_idx==fd_banks_bank_idx( banks, 11UL ) );
+  FD_TEST( fd_bank_slot_get( snap ) == 11UL );
+  FD_TEST( fd_bank_capitalization_get( snap ) == fd_bank_capitalization_get( bank11 ) );
+
+  fd_bank_clock_timestamp_votes_t * votes_ele = pin->clock_timestamp_votes_ele;
+  FD_TEST( votes_ele && votes_ele->pin_cnt==1UL );
+  FD_TEST( (void *)votes_ele->data==(void *)votes );
+  FD_TEST( !bank11->clock_timestamp_votes_lock.value );
+  FD_TEST( !pin->epoch_stakes_ele );
+  FD_TEST( !bank11->epoch_stakes_lock.value );
+  FD_TEST( !snap->clock_timestamp_votes_dirty );
+
+  votes_const = fd_bank_clock_timestamp_votes_locking_query( snap );
+  FD_TEST( votes_const==votes );
+  fd_bank_clock_timestamp_votes_end_locking_query( snap );
+
+  keys_const = fd_bank_vote_account_keys_locking_query( snap );
+  FD_TEST( !fd_bank_keys_cnt( keys_const ) );
+  fd_bank_vote_account_keys_end_locking_query( snap );
+
+  fd_bank_capitalization_set( snap, 4000UL );
+  FD_TEST( fd_bank_capitalization_get( bank11 ) != 4000UL );
+
+  /* Modifying a pinned field does not wait for the pin.  The bank gets
+     a copy and the pinned element is left alone until unpinned. */
+  fd_bank_clock_timestamp_votes_t * votes_pool = fd_banks_get_clock_timestamp_votes_pool( banks );
+  ulong votes_free = fd_bank_clock_timestamp_votes_pool_free( votes_pool );
+  votes = fd_bank_clock_timestamp_votes_locking_modify( bank11 );
+  FD_TEST( (void *)votes!=(void *)votes_ele->data );
+  FD_TEST( votes->votes_pool_offset==102UL );
+  votes->votes_pool_offset = 103UL;
+  fd_bank_clock_timestamp_votes_end_locking_modify( bank11 );
+  FD_TEST( votes_ele->deferred );
+  FD_TEST( fd_bank_clock_timestamp_votes_pool_free( votes_pool )==votes_free-1UL );
+  FD_TEST( fd_bank_clock_timestamp_votes_locking_query( snap )->votes_pool_offset==102UL );
+  fd_bank_clock_timestamp_votes_end_locking_query( snap );
+
+  fd_banks_snapshot_release( pin );
+  FD_TEST( !pin->clock_timestamp_votes_ele );
+  FD_TEST( !votes_ele->pin_cnt );
+
+  /* A field that the bank did not modify is pinned in the ancestor that
+     did. */
+  fd_vote_accounts_global_t * stakes = fd_bank_epoch_stakes_locking_modify( bank10 );
+  FD_TEST( stakes );
+  fd_bank_epoch_stakes_end_locking_modify( bank10 );
+
+  fd_bank_t * bank12 = fd_banks_clone_from_parent( banks, 12UL, 10UL );
+  FD_TEST( bank12 );
+  snap = fd_banks_snapshot_bank( banks, 12UL, snap_mem, pin, NULL );
+  FD_TEST( snap==snap_mem );
+  FD_TEST( (void *)pin->epoch_stakes_ele->data==(void *)stakes );
+  FD_TEST( pin->epoch_stakes_ele->pin_cnt==1UL );
+  FD_TEST( !bank10->epoch_stakes_lock.value );
+  FD_TEST( !bank12->epoch_stakes_lock.value );
+  FD_TEST( fd_bank_epoch_stakes_locking_query( snap )==stakes );
+  fd_bank_epoch_stakes_end_locking_query( snap );
+  fd_banks_snapshot_release( pin );
+  FD_TEST( !fd_bank_epoch_stakes_pool_ele( fd_banks_get_epoch_stakes_pool( banks ), bank10->epoch_stakes_pool_idx )->pin_cnt );
+
   /* Clear bank11, we need to make sure that the pool indices are
      cleared and properly released.
 
@@ -172,19 +252,57 @@ main( int argc, char ** argv ) {
   FD_TEST( fd_bank_capitalization_get( bank11 ) == 0UL );
 
   keys3 = fd_bank_vote_account_keys_locking_query( bank11 );
-  FD_TEST( keys3->account_keys_pool_offset == 100UL );
-  FD_TEST( keys3->account_keys_root_offset == 100UL );
+  FD_TEST( fd_bank_keys_cnt( keys3 )==1UL && fd_bank_keys_test( keys3, &key_a ) );
   fd_bank_vote_account_keys_end_locking_query( bank11 );
 
   keys4 = fd_bank_stake_account_keys_locking_query( bank11 );
-  FD_TEST( keys4->account_keys_pool_offset == 101UL );
-  FD_TEST( keys4->account_keys_root_offset == 101UL );
+  FD_TEST( fd_bank_keys_cnt( keys4 )==1UL && fd_bank_keys_test( keys4, &key_b ) );
   fd_bank_stake_account_keys_end_locking_query( bank11 );
 
+  /* bank11 shares the key set nodes of bank9 again and the nodes only
+     used by bank11 were freed. */
+  fd_bank_keys_store_t * keys_store = fd_banks_get_keys_store( banks );
+  FD_TEST( keys_store->node_max-fd_bank_keys_store_node_free( keys_store )==2UL );
+
   votes_const = fd_bank_clock_timestamp_votes_locking_query( bank11 );
   FD_TEST( !votes_const );
   fd_bank_clock_timestamp_votes_end_locking_query( bank11 );
 
+  /* Clearing a bank does not wait for pins on its fields either.  The
+     pinned element stays valid until a publish after the pin is
+     released puts it back into the pool.  The element bank11 dropped
+     above is not pinned anymore, so the next publish releases it. */
+  fd_bank_clock_timestamp_votes_t * votes_ele11 = votes_ele;
+  FD_TEST( votes_ele11->deferred );
+
+  votes = fd_bank_clock_timestamp_votes_locking_modify( bank12 );
+  votes->votes_pool_offset = 104UL;
+  fd_bank_clock_timestamp_votes_end_locking_modify( bank12 );
+  votes_free = fd_bank_clock_timestamp_votes_pool_free( votes_pool );
+
+  snap = fd_banks_snapshot_bank( banks, 12UL, snap_mem, pin, NULL );
+  FD_TEST( snap==snap_mem );
+  votes_ele = pin->clock_timestamp_votes_ele;
+  FD_TEST( votes_ele && votes_ele->pin_cnt==1UL );
+  fd_banks_clear_bank( banks, bank12 );
+  FD_TEST( votes_ele->deferred );
+  FD_TEST( fd_bank_clock_timestamp_votes_pool_free( votes_pool )==votes_free );
+  FD_TEST( fd_bank_clock_timestamp_votes_locking_query( snap )->votes_pool_offset==104UL );
+  fd_bank_clock_timestamp_votes_end_locking_query( snap );
+
+  FD_TEST( fd_banks_publish( banks, 10UL )==bank10 );
+  FD_TEST( !votes_ele11->deferred );
+  FD_TEST( votes_ele->deferred );
+  FD_TEST( fd_bank_clock_timestamp_votes_locking_query( snap )->votes_pool_offset==104UL );
+  fd_bank_clock_timestamp_votes_end_locking_query( snap );
+
+  fd_banks_snapshot_release( pin );
+  votes_free = fd_bank_clock_timestamp_votes_pool_free( votes_pool );
+  FD_TEST( fd_banks_publish( banks, 12UL )==bank12 );
+  FD_TEST( !votes_ele->deferred );
+  FD_TEST( fd_bank_clock_timestamp_votes_pool_free( votes_pool )==votes_free+1UL );
+  fd_wksp_free_laddr( snap_mem );
+
   FD_LOG_NOTICE(( "pass" ));
 
   fd_halt();
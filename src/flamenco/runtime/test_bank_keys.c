@@ -0,0 +1,161 @@
+#include "fd_bank_keys.h"
+
+#include <stdlib.h>
+
+#define NODE_MAX (1UL<<16)
+#define KEY_CNT  (512UL)
+#define SET_CNT  (8UL)
+
+static uchar store_mem[ 1UL<<22 ] __attribute__((aligned(128)));
+
+static fd_pubkey_t universe[ KEY_CNT ]; /* sorted by memcmp */
+
+static int
+key_cmp( void const * a,
+         void const * b ) {
+  return memcmp( a, b, sizeof(fd_pubkey_t) );
+}
+
+/* verify checks keys against the reference set ref (ref[i] is set if
+   universe[i] is in the set). */
+
+static void
+verify( fd_bank_keys_t const * keys,
+        uchar const *          ref ) {
+  ulong cnt = 0UL;
+  for( ulong i=0UL; i<KEY_CNT; i++ ) {
+    cnt += ref[ i ];
+    FD_TEST( fd_bank_keys_test( keys, &universe[ i ] )==ref[ i ] );
+  }
+  FD_TEST( fd_bank_keys_cnt( keys )==cnt );
+
+  fd_bank_keys_iter_t iter[1];
+  ulong i = 0UL;
+  for( fd_bank_keys_iter_init( iter, keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
+    while( i<KEY_CNT && !ref[ i ] ) i++;
+    FD_TEST( i<KEY_CNT );
+    FD_TEST( fd_memeq( fd_bank_keys_iter_key( iter ), &universe[ i ], sizeof(fd_pubkey_t) ) );
+    i++;
+  }
+  while( i<KEY_CNT ) FD_TEST( !ref[ i++ ] );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Keys share prefixes so memcmp has to look past the first bytes */
+  for( ulong i=0UL; i<KEY_CNT; i++ ) {
+    for( ulong j=0UL; j<32UL; j++ ) universe[ i ].uc[ j ] = fd_rng_uchar( rng );
+    universe[ i ].uc[ 0 ] &= 0x3;
+  }
+  qsort( universe, KEY_CNT, sizeof(fd_pubkey_t), key_cmp );
+
+  FD_TEST( !fd_bank_keys_store_footprint( 0UL ) );
+  FD_TEST( fd_bank_keys_store_footprint( NODE_MAX )<=sizeof(store_mem) );
+  FD_TEST( !fd_bank_keys_store_new( store_mem+1, NODE_MAX, 1234UL ) );
+  fd_bank_keys_store_t * store = fd_bank_keys_store_join( fd_bank_keys_store_new( store_mem, NODE_MAX, 1234UL ) );
+  FD_TEST( store );
+  FD_TEST( fd_bank_keys_store_node_free( store )==NODE_MAX );
+
+  fd_bank_keys_t keys[ SET_CNT ];
+  uchar          ref [ SET_CNT ][ KEY_CNT ];
+  memset( ref, 0, sizeof(ref) );
+  for( ulong s=0UL; s<SET_CNT; s++ ) {
+    fd_bank_keys_init( &keys[ s ], store );
+    verify( &keys[ s ], ref[ s ] );
+  }
+
+  /* An insert that rotates a new node to the root is kept.  The map
+     this replaces lost the key (and the subtree below it) when the
+     caller did not store the new root. */
+
+  for( ulong i=0UL; i<KEY_CNT; i++ ) {
+    FD_TEST( fd_bank_keys_insert( &keys[ 0 ], &universe[ i ] )==1 );
+    FD_TEST( fd_bank_keys_cnt( &keys[ 0 ] )==i+1UL );
+    for( ulong j=0UL; j<=i; j++ ) FD_TEST( fd_bank_keys_test( &keys[ 0 ], &universe[ j ] ) );
+  }
+  fd_bank_keys_release( &keys[ 0 ] );
+  verify( &keys[ 0 ], ref[ 0 ] );
+  FD_TEST( fd_bank_keys_store_node_free( store )==NODE_MAX );
+
+  /* Sharing is O(1) and versions are independent */
+
+  for( ulong i=0UL; i<KEY_CNT; i++ ) {
+    FD_TEST( fd_bank_keys_insert( &keys[ 0 ], &universe[ i ] )==1 );
+    ref[ 0 ][ i ] = 1;
+  }
+  FD_TEST( fd_bank_keys_insert( &keys[ 0 ], &universe[ 7 ] )==0 );
+  ulong free0 = fd_bank_keys_store_node_free( store );
+  FD_TEST( free0==NODE_MAX-KEY_CNT );
+
+  fd_bank_keys_share( &keys[ 1 ], &keys[ 0 ] );
+  memcpy( ref[ 1 ], ref[ 0 ], KEY_CNT );
+  FD_TEST( fd_bank_keys_store_node_free( store )==free0 );
+
+  FD_TEST( fd_bank_keys_remove( &keys[ 1 ], &universe[ 100 ] )==1 );
+  FD_TEST( fd_bank_keys_remove( &keys[ 1 ], &universe[ 100 ] )==0 );
+  ref[ 1 ][ 100 ] = 0;
+  verify( &keys[ 0 ], ref[ 0 ] );
+  verify( &keys[ 1 ], ref[ 1 ] );
+  FD_TEST( NODE_MAX-fd_bank_keys_store_node_free( store )-KEY_CNT<=FD_BANK_KEYS_DEPTH_MAX );
+
+  /* Releasing the original frees only the nodes it does not share */
+
+  fd_bank_keys_release( &keys[ 0 ] );
+  memset( ref[ 0 ], 0, KEY_CNT );
+  verify( &keys[ 0 ], ref[ 0 ] );
+  verify( &keys[ 1 ], ref[ 1 ] );
+  FD_TEST( fd_bank_keys_store_node_free( store )==NODE_MAX-(KEY_CNT-1UL) );
+
+  /* Random operations against a reference */
+
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong s = fd_rng_ulong_roll( rng, SET_CNT );
+    ulong k = fd_rng_ulong_roll( rng, KEY_CNT );
+    uint  r = fd_rng_uint_roll( rng, 100U );
+    if( r<55U ) {
+      FD_TEST( fd_bank_keys_insert( &keys[ s ], &universe[ k ] )==!ref[ s ][ k ] );
+      ref[ s ][ k ] = 1;
+    } else if( r<95U ) {
+      FD_TEST( fd_bank_keys_remove( &keys[ s ], &universe[ k ] )==ref[ s ][ k ] );
+      ref[ s ][ k ] = 0;
+    } else if( r<99U ) {
+      ulong d = fd_rng_ulong_roll( rng, SET_CNT );
+      if( d!=s ) {
+        fd_bank_keys_release( &keys[ d ] );
+        fd_bank_keys_share( &keys[ d ], &keys[ s ] );
+        memcpy( ref[ d ], ref[ s ], KEY_CNT );
+      }
+    } else {
+      fd_bank_keys_release( &keys[ s ] );
+      memset( ref[ s ], 0, KEY_CNT );
+    }
+    if( !(iter & 1023UL) ) {
+      for( ulong t=0UL; t<SET_CNT; t++ ) verify( &keys[ t ], ref[ t ] );
+    }
+  }
+  for( ulong s=0UL; s<SET_CNT; s++ ) verify( &keys[ s ], ref[ s ] );
+
+  /* Live nodes are bounded by the sum of set sizes */
+
+  ulong key_sum = 0UL;
+  for( ulong s=0UL; s<SET_CNT; s++ ) key_sum += fd_bank_keys_cnt( &keys[ s ] );
+  FD_TEST( NODE_MAX-fd_bank_keys_store_node_free( store )<=key_sum );
+
+  /* No leaks */
+
+  for( ulong s=0UL; s<SET_CNT; s++ ) fd_bank_keys_release( &keys[ s ] );
+  FD_TEST( fd_bank_keys_store_node_free( store )==NODE_MAX );
+
+  FD_TEST( fd_bank_keys_store_delete( fd_bank_keys_store_leave( store ) )==store_mem );
+  FD_TEST( !fd_bank_keys_store_join( store_mem ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,256 @@
+#include "fd_blockstore.h"
+
+/* Mixed reader / writer stress test for the blockstore block data.
+
+   Tile 0 plays the shred tile: it inserts the shreds of a stream of
+   slots (in random order within each slot) and periodically publishes
+   the watermark behind the tip, which removes old slots and frees
+   their block data.  The other tiles play RPC readers: they query the
+   block data of recent slots (some of which are being removed or are
+   still being received) and verify every copy they get.  Block
+   contents are a deterministic function of (slot, shred idx), so
+   readers can check copies without coordinating with the writer. */
+
+#define SHRED_CNT_MAX   (64UL)
+#define PAYLOAD_SZ_MAX  (FD_SHRED_MIN_SZ - FD_SHRED_DATA_HEADER_SZ)
+#define BLOCK_SZ_MAX    (SHRED_CNT_MAX*PAYLOAD_SZ_MAX)
+#define PUBLISH_DEPTH   (32UL)
+#define PUBLISH_STRIDE  (16UL)
+#define READ_WINDOW     (PUBLISH_DEPTH+PUBLISH_STRIDE+8UL)
+
+static fd_blockstore_t * blockstore;
+static ulong             slot_cnt;
+static ulong             tile_go;
+static ulong             tip; /* highest slot that is complete, 0 if none */
+
+static ulong
+test_shred_cnt( ulong slot ) {
+  return 1UL + fd_ulong_hash( slot ) % SHRED_CNT_MAX;
+}
+
+static ulong
+test_payload_sz( ulong slot, ulong idx ) {
+  return 1UL + fd_ulong_hash( (slot<<16) | idx ) % PAYLOAD_SZ_MAX;
+}
+
+static uchar
+test_payload_byte( ulong slot, ulong idx, ulong off ) {
+  return (uchar)( slot*31UL + idx*7UL + off );
+}
+
+static ulong
+test_block_sz( ulong slot ) {
+  ulong sz = 0UL;
+  for( ulong idx=0UL; idx<test_shred_cnt( slot ); idx++ ) sz += test_payload_sz( slot, idx );
+  return sz;
+}
+
+static void
+test_block_verify( ulong slot, uchar const * buf, ulong buf_sz ) {
+  FD_TEST( buf_sz==test_block_sz( slot ) );
+  ulong off = 0UL;
+  for( ulong idx=0UL; idx<test_shred_cnt( slot ); idx++ ) {
+    ulong payload_sz = test_payload_sz( slot, idx );
+    for( ulong j=0UL; j<payload_sz; j++ ) FD_TEST( buf[ off+j ]==test_payload_byte( slot, idx, j ) );
+    off += payload_sz;
+  }
+}
+
+static void
+test_shred_insert( ulong slot, ulong idx ) {
+  uchar buf[ FD_SHRED_MIN_SZ ] __attribute__((aligned(8UL))) = {0};
+  fd_shred_t * shred = (fd_shred_t *)buf;
+
+  ulong shred_cnt  = test_shred_cnt( slot );
+  ulong payload_sz = test_payload_sz( slot, idx );
+
+  shred->variant         = fd_shred_variant( FD_SHRED_TYPE_LEGACY_DATA, 0 );
+  shred->slot            = slot;
+  shred->idx             = (uint)idx;
+  shred->data.parent_off = 1;
+  shred->data.flags      = idx==shred_cnt-1UL ? FD_SHRED_DATA_FLAG_SLOT_COMPLETE | FD_SHRED_DATA_FLAG_DATA_COMPLETE : 0;
+  shred->data.size       = (ushort)( FD_SHRED_DATA_HEADER_SZ + payload_sz );
+  for( ulong j=0UL; j<payload_sz; j++ ) buf[ FD_SHRED_DATA_HEADER_SZ+j ] = test_payload_byte( slot, idx, j );
+
+  fd_blockstore_shred_insert( blockstore, shred );
+}
+
+/* test_slot_insert inserts all the shreds of slot in random order. */
+
+static void
+test_slot_insert( ulong slot, fd_rng_t * rng ) {
+  ulong shred_cnt = test_shred_cnt( slot );
+  ulong order[ SHRED_CNT_MAX ];
+  for( ulong i=0UL; i<shred_cnt; i++ ) order[ i ] = i;
+  for( ulong i=shred_cnt-1UL; i>0UL; i-- ) {
+    ulong j = fd_rng_ulong_roll( rng, i+1UL );
+    ulong t = order[ i ]; order[ i ] = order[ j ]; order[ j ] = t;
+  }
+  for( ulong i=0UL; i<shred_cnt; i++ ) test_shred_insert( slot, order[ i ] );
+}
+
+static void
+test_basic( uchar * buf, fd_rng_t * rng ) {
+  ulong buf_sz;
+
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 1UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_ERR_KEY );
+
+  /* Incomplete slots have no block data */
+
+  ulong shred_cnt = test_shred_cnt( 1UL );
+  FD_TEST( shred_cnt>1UL );
+  for( ulong idx=0UL; idx<shred_cnt-1UL; idx++ ) test_shred_insert( 1UL, idx );
+  FD_TEST( !fd_blockstore_shreds_complete( blockstore, 1UL ) );
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 1UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_ERR_EMPTY );
+
+  /* Completing the slot publishes the block data, which matches a
+     slice query over the whole slot */
+
+  test_shred_insert( 1UL, shred_cnt-1UL );
+  FD_TEST( fd_blockstore_shreds_complete( blockstore, 1UL ) );
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 1UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_SUCCESS );
+  test_block_verify( 1UL, buf, buf_sz );
+
+  ulong slice_sz;
+  FD_TEST( fd_blockstore_slice_query( blockstore, 1UL, 0U, (uint)(shred_cnt-1UL), BLOCK_SZ_MAX, buf, &slice_sz )==FD_BLOCKSTORE_SUCCESS );
+  FD_TEST( slice_sz==buf_sz );
+  test_block_verify( 1UL, buf, slice_sz );
+
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 1UL, buf_sz-1UL, buf, &buf_sz )==FD_BLOCKSTORE_ERR_NO_MEM );
+
+  /* Slots completed while publishing is disabled have no block data */
+
+  fd_blockstore_block_data_enable( blockstore, 0 );
+  test_slot_insert( 2UL, rng );
+  FD_TEST( fd_blockstore_shreds_complete( blockstore, 2UL ) );
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 2UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_ERR_EMPTY );
+  fd_blockstore_slot_remove( blockstore, 2UL );
+  fd_blockstore_block_data_enable( blockstore, 1 );
+
+  /* Removing the slot retires its block data */
+
+  test_slot_insert( 2UL, rng );
+  fd_blockstore_slot_remove( blockstore, 2UL );
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 2UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_ERR_KEY );
+}
+
+static int
+tile_main( int     argc,
+           char ** argv ) {
+  ulong tile_idx = (ulong)(uint)argc;
+  (void)argv;
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)tile_idx, 0UL ) );
+
+  while( !FD_VOLATILE_CONST( tile_go ) ) FD_SPIN_PAUSE();
+
+  if( !tile_idx ) {
+
+    /* Writer.  Slots 1 and 2 were used by test_basic. */
+
+    for( ulong slot=3UL; slot<slot_cnt; slot++ ) {
+      test_slot_insert( slot, rng );
+      FD_COMPILER_MFENCE();
+      FD_VOLATILE( tip ) = slot;
+      FD_COMPILER_MFENCE();
+      if( !(slot % PUBLISH_STRIDE) && slot>PUBLISH_DEPTH ) fd_blockstore_publish( blockstore, -1, slot-PUBLISH_DEPTH );
+    }
+    FD_COMPILER_MFENCE();
+    FD_VOLATILE( tile_go ) = 0UL;
+    FD_COMPILER_MFENCE();
+
+  } else {
+
+    /* Reader.  Queries recent slots, including slots being removed and
+       the slot being received. */
+
+    uchar * buf = fd_alloca_check( 128UL, BLOCK_SZ_MAX );
+    ulong   ok_cnt   = 0UL;
+    ulong   miss_cnt = 0UL;
+    while( FD_VOLATILE_CONST( tile_go ) ) {
+      ulong latest = FD_VOLATILE_CONST( tip );
+      if( FD_UNLIKELY( latest<3UL ) ) { FD_SPIN_PAUSE(); continue; }
+      ulong slot = fd_ulong_max( latest + 1UL - fd_rng_ulong_roll( rng, READ_WINDOW ), 3UL );
+
+      ulong buf_sz;
+      int   err = fd_blockstore_block_data_query( blockstore, slot, BLOCK_SZ_MAX, buf, &buf_sz );
+      if( err==FD_BLOCKSTORE_SUCCESS ) {
+        test_block_verify( slot, buf, buf_sz );
+        ok_cnt++;
+      } else {
+        /* Complete slots in the blockstore always have block data */
+        FD_TEST( err==FD_BLOCKSTORE_ERR_KEY || ( err==FD_BLOCKSTORE_ERR_EMPTY && slot>latest ) );
+        miss_cnt++;
+      }
+    }
+    FD_LOG_NOTICE(( "reader %lu: %lu blocks verified, %lu misses", tile_idx, ok_cnt, miss_cnt ));
+    FD_TEST( ok_cnt );
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL, "gigantic"      );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL, 1UL             );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        shred_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--shred-max", NULL, 1UL<<14         );
+  ulong        block_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--block-max", NULL, 256UL           );
+  /**/         slot_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--slot-cnt",  NULL, 2048UL          );
+
+  ulong tile_cnt = fd_tile_cnt();
+  if( FD_UNLIKELY( tile_cnt<2UL ) ) {
+    FD_LOG_WARNING(( "skip: test requires at least 2 tiles" ));
+    fd_halt();
+    return 0;
+  }
+
+  FD_LOG_NOTICE(( "Testing (--page-sz %s --page-cnt %lu --near-cpu %lu --shred-max %lu --block-max %lu --slot-cnt %lu) on %lu tiles",
+                  _page_sz, page_cnt, near_cpu, shred_max, block_max, slot_cnt, tile_cnt ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_alloc_align(), fd_blockstore_footprint( shred_max, block_max, block_max ), 1UL );
+  FD_TEST( mem );
+  fd_blockstore_t ljoin[1];
+  blockstore = fd_blockstore_join( ljoin, fd_blockstore_new( mem, 1UL, 42UL, shred_max, block_max, block_max ) );
+  FD_TEST( blockstore );
+  fd_buf_shred_pool_reset( blockstore->shred_pool, 0 );
+  FD_TEST( fd_blockstore_init( blockstore, -1, FD_BLOCKSTORE_ARCHIVE_MIN_SIZE, 0UL ) );
+  fd_blockstore_block_data_enable( blockstore, 1 );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  uchar * buf = fd_wksp_alloc_laddr( wksp, 128UL, BLOCK_SZ_MAX, 1UL );
+  FD_TEST( buf );
+  test_basic( buf, rng );
+
+  FD_VOLATILE( tile_go ) = 0UL;
+  for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) fd_tile_exec_new( tile_idx, tile_main, (int)(uint)tile_idx, NULL );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tile_go ) = 1UL;
+  FD_COMPILER_MFENCE();
+  tile_main( 0, NULL );
+  for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) fd_tile_exec_delete( fd_tile_exec( tile_idx ), NULL );
+
+  /* Everything below the watermark is gone, the tip is still readable */
+
+  ulong buf_sz;
+  FD_TEST( fd_blockstore_block_data_query( blockstore, 3UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_ERR_KEY );
+  FD_TEST( fd_blockstore_block_data_query( blockstore, slot_cnt-1UL, BLOCK_SZ_MAX, buf, &buf_sz )==FD_BLOCKSTORE_SUCCESS );
+  test_block_verify( slot_cnt-1UL, buf, buf_sz );
+
+  fd_wksp_free_laddr( buf );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_blockstore_fini( blockstore );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -622,6 +622,273 @@ test_cache_full( void ) {
   }
 }
 
+/* Snapshot tests use a smaller cache, with the 150 slot validity
+   window of roots and a mainnet-like number of transactions per slot. */
+
+#define SNAPSHOT_ROOTED_SLOTS (150UL)
+#define SNAPSHOT_LIVE_SLOTS   (256UL)
+#define SNAPSHOT_TXN_PER_SLOT (4096UL)
+
+struct snapshot_ctx {
+  ulong         cnt;
+  ulong         slot_max;
+  ulong         hold_cnt;  /* block in the write callback after this many entries ... */
+  volatile int  released;  /* ... until this is set */
+  volatile int  held;
+};
+
+typedef struct snapshot_ctx snapshot_ctx_t;
+
+static int
+snapshot_write( uchar const * data,
+                ulong         data_sz,
+                void *        _ctx ) {
+  snapshot_ctx_t * ctx = (snapshot_ctx_t *)_ctx;
+  FD_TEST( data_sz==sizeof(fd_txncache_snapshot_entry_t) );
+  fd_txncache_snapshot_entry_t const * entry = (fd_txncache_snapshot_entry_t const *)data;
+  FD_TEST( entry->slot<=ctx->slot_max );
+  FD_TEST( FD_LOAD( ulong, entry->blockhash )==entry->slot );
+  ctx->cnt++;
+  if( FD_UNLIKELY( ctx->cnt==ctx->hold_cnt ) ) {
+    ctx->held = 1;
+    while( !ctx->released ) FD_SPIN_PAUSE();
+  }
+  return 0;
+}
+
+static int
+snapshot_write_count( uchar const * data,
+                      ulong         data_sz,
+                      void *        ctx ) {
+  (void)data; (void)data_sz;
+  (*(ulong *)ctx)++;
+  return 0;
+}
+
+static void *
+snapshot_fn( void * arg ) {
+  FD_TEST( !fd_txncache_snapshot( (fd_txncache_t *)txncache_scratch, arg, snapshot_write ) );
+  return NULL;
+}
+
+void
+test_snapshot_concurrent( void ) {
+  FD_LOG_NOTICE(( "TEST SNAPSHOT CONCURRENT" ));
+
+  fd_txncache_t * tc = init_all( SNAPSHOT_ROOTED_SLOTS, SNAPSHOT_LIVE_SLOTS, SNAPSHOT_TXN_PER_SLOT );
+
+  for( ulong i=0UL; i<SNAPSHOT_ROOTED_SLOTS; i++ ) {
+    for( ulong j=0UL; j<16UL; j++ ) insert( i, j, i );
+    fd_txncache_register_root_slot( tc, i );
+  }
+
+  /* Hold the snapshot in the middle of serializing, and check that
+     inserts, queries and root registration still make progress (they
+     would deadlock if the snapshot held the lock).  Registering new
+     roots pushes out roots 0..49, but their purge is deferred. */
+
+  snapshot_ctx_t ctx = { .cnt = 0UL, .slot_max = SNAPSHOT_ROOTED_SLOTS-1UL, .hold_cnt = 100UL, .released = 0, .held = 0 };
+  pthread_t thread;
+  FD_TEST( !pthread_create( &thread, NULL, snapshot_fn, &ctx ) );
+  while( !ctx.held ) FD_SPIN_PAUSE();
+
+  for( ulong i=SNAPSHOT_ROOTED_SLOTS; i<SNAPSHOT_ROOTED_SLOTS+50UL; i++ ) {
+    for( ulong j=0UL; j<16UL; j++ ) insert( i, j, i );
+    fd_txncache_register_root_slot( tc, i );
+    contains( i, 0UL, i );
+  }
+  FD_TEST( fd_txncache_is_rooted_slot( tc, SNAPSHOT_ROOTED_SLOTS+49UL ) );
+  FD_TEST( !fd_txncache_is_rooted_slot( tc, 0UL ) );
+  contains( 0UL, 0UL, 0UL );
+  contains( 49UL, 15UL, 49UL );
+
+  ctx.released = 1;
+  FD_TEST( !pthread_join( thread, NULL ) );
+
+  /* The snapshot has exactly the roots as of when it started, and the
+     deferred purge ran when it finished. */
+
+  FD_TEST( ctx.cnt==SNAPSHOT_ROOTED_SLOTS*16UL );
+  for( ulong i=0UL; i<50UL; i++ ) no_contains( i, 0UL, i );
+  for( ulong i=50UL; i<SNAPSHOT_ROOTED_SLOTS+50UL; i++ ) contains( i, 15UL, i );
+
+  snapshot_ctx_t ctx2 = { .cnt = 0UL, .slot_max = SNAPSHOT_ROOTED_SLOTS+49UL, .hold_cnt = ULONG_MAX };
+  FD_TEST( !fd_txncache_snapshot( tc, &ctx2, snapshot_write ) );
+  FD_TEST( ctx2.cnt==SNAPSHOT_ROOTED_SLOTS*16UL );
+}
+
+struct snapshot_abort_args {
+  snapshot_ctx_t * ctx;
+  int              err;
+};
+
+typedef struct snapshot_abort_args snapshot_abort_args_t;
+
+static void *
+snapshot_abort_fn( void * _arg ) {
+  snapshot_abort_args_t * args = (snapshot_abort_args_t *)_arg;
+  args->err = fd_txncache_snapshot( (fd_txncache_t *)txncache_scratch, args->ctx, snapshot_write );
+  return NULL;
+}
+
+struct register_roots_args {
+  ulong slot0;
+  ulong slot1;
+};
+
+typedef struct register_roots_args register_roots_args_t;
+
+static void *
+register_roots_fn( void * _arg ) {
+  register_roots_args_t * args = (register_roots_args_t *)_arg;
+  for( ulong i=args->slot0; i<args->slot1; i++ ) {
+    for( ulong j=0UL; j<16UL; j++ ) insert( i, j, i );
+    fd_txncache_register_root_slot( (fd_txncache_t *)txncache_scratch, i );
+  }
+  return NULL;
+}
+
+void
+test_snapshot_abort( void ) {
+  FD_LOG_NOTICE(( "TEST SNAPSHOT ABORT" ));
+
+  fd_txncache_t * tc = init_all( SNAPSHOT_ROOTED_SLOTS, SNAPSHOT_LIVE_SLOTS, SNAPSHOT_TXN_PER_SLOT );
+
+  for( ulong i=0UL; i<SNAPSHOT_ROOTED_SLOTS; i++ ) {
+    for( ulong j=0UL; j<16UL; j++ ) insert( i, j, i );
+    fd_txncache_register_root_slot( tc, i );
+  }
+
+  /* Hold a snapshot and root more slots than there are live slots
+     beyond the roots.  Purges are deferred only up to half of that
+     headroom, then root registration stops the snapshot and waits for
+     it to end.  Without the cap, the inserts below would run out of
+     blockcache entries. */
+
+  ulong defer_max = (SNAPSHOT_LIVE_SLOTS-SNAPSHOT_ROOTED_SLOTS)/2UL;
+  ulong slot1     = SNAPSHOT_ROOTED_SLOTS+SNAPSHOT_ROOTED_SLOTS;
+  FD_TEST( slot1-SNAPSHOT_ROOTED_SLOTS>SNAPSHOT_LIVE_SLOTS-SNAPSHOT_ROOTED_SLOTS );
+
+  snapshot_ctx_t        ctx  = { .cnt = 0UL, .slot_max = SNAPSHOT_ROOTED_SLOTS-1UL, .hold_cnt = 100UL, .released = 0, .held = 0 };
+  snapshot_abort_args_t args = { .ctx = &ctx, .err = 0 };
+  pthread_t snapshot_thread;
+  FD_TEST( !pthread_create( &snapshot_thread, NULL, snapshot_abort_fn, &args ) );
+  while( !ctx.held ) FD_SPIN_PAUSE();
+
+  register_roots_args_t roots0 = { .slot0 = SNAPSHOT_ROOTED_SLOTS, .slot1 = SNAPSHOT_ROOTED_SLOTS+defer_max };
+  register_roots_fn( &roots0 );
+  contains( 0UL, 0UL, 0UL );
+
+  /* The next root goes over the cap.  It is registered, then waits for
+     the held snapshot to stop. */
+
+  register_roots_args_t roots1 = { .slot0 = SNAPSHOT_ROOTED_SLOTS+defer_max, .slot1 = slot1 };
+  pthread_t register_thread;
+  FD_TEST( !pthread_create( &register_thread, NULL, register_roots_fn, &roots1 ) );
+  while( !fd_txncache_is_rooted_slot( tc, SNAPSHOT_ROOTED_SLOTS+defer_max ) ) FD_SPIN_PAUSE();
+
+  ctx.released = 1;
+  FD_TEST( !pthread_join( snapshot_thread, NULL ) );
+  FD_TEST( !pthread_join( register_thread, NULL ) );
+
+  FD_TEST( args.err==-1 );
+  FD_TEST( ctx.cnt<SNAPSHOT_ROOTED_SLOTS*16UL );
+  for( ulong i=0UL; i<SNAPSHOT_ROOTED_SLOTS; i++ ) no_contains( i, 0UL, i );
+  for( ulong i=SNAPSHOT_ROOTED_SLOTS; i<slot1; i++ ) contains( i, 15UL, i );
+
+  snapshot_ctx_t ctx2 = { .cnt = 0UL, .slot_max = slot1-1UL, .hold_cnt = ULONG_MAX };
+  FD_TEST( !fd_txncache_snapshot( tc, &ctx2, snapshot_write ) );
+  FD_TEST( ctx2.cnt==SNAPSHOT_ROOTED_SLOTS*16UL );
+}
+
+/* restore_txns generates 150 full slots of transactions, each
+   referencing a random one of the blockhashes of the preceding 150
+   slots, like a status cache restored from a snapshot. */
+
+static fd_txncache_insert_t *
+restore_txns( fd_rng_t * rng,
+              ulong      slot_cnt,
+              ulong      txn_per_slot ) {
+  static uchar                blockhashes[ SNAPSHOT_ROOTED_SLOTS ][ 32 ];
+  static uchar                txnhashes  [ SNAPSHOT_ROOTED_SLOTS*SNAPSHOT_TXN_PER_SLOT ][ 32 ];
+  static fd_txncache_insert_t txns       [ SNAPSHOT_ROOTED_SLOTS*SNAPSHOT_TXN_PER_SLOT ];
+  static uchar                result     [ 1 ];
+  FD_TEST( slot_cnt<=SNAPSHOT_ROOTED_SLOTS && txn_per_slot<=SNAPSHOT_TXN_PER_SLOT );
+
+  for( ulong i=0UL; i<slot_cnt; i++ ) {
+    for( ulong k=0UL; k<32UL; k++ ) blockhashes[ i ][ k ] = fd_rng_uchar( rng );
+  }
+  for( ulong i=0UL; i<slot_cnt*txn_per_slot; i++ ) {
+    for( ulong k=0UL; k<32UL; k++ ) txnhashes[ i ][ k ] = fd_rng_uchar( rng );
+    ulong slot = i/txn_per_slot;
+    txns[ i ] = (fd_txncache_insert_t){
+      .blockhash = blockhashes[ fd_rng_ulong_roll( rng, slot+1UL ) ],
+      .txnhash   = txnhashes[ i ],
+      .slot      = slot,
+      .result    = result,
+    };
+  }
+  return txns;
+}
+
+struct bench_insert_args {
+  ulong        slot0;
+  volatile int stop;
+  ulong        cnt;
+};
+
+typedef struct bench_insert_args bench_insert_args_t;
+
+static void *
+bench_insert_fn( void * _arg ) {
+  bench_insert_args_t * arg = (bench_insert_args_t *)_arg;
+  while( !arg->stop && arg->cnt<64UL*SNAPSHOT_TXN_PER_SLOT ) {
+    ulong slot = arg->slot0 + arg->cnt/SNAPSHOT_TXN_PER_SLOT;
+    insert( slot, arg->cnt, slot );
+    arg->cnt++;
+  }
+  return NULL;
+}
+
+void
+bench_snapshot_restore( void ) {
+  FD_LOG_NOTICE(( "BENCH SNAPSHOT RESTORE" ));
+
+  fd_rng_t rng[1];
+  FD_TEST( fd_rng_join( fd_rng_new( rng, 2U, 0UL ) ) );
+
+  ulong txns_cnt = SNAPSHOT_ROOTED_SLOTS*SNAPSHOT_TXN_PER_SLOT;
+  fd_txncache_insert_t * txns = restore_txns( rng, SNAPSHOT_ROOTED_SLOTS, SNAPSHOT_TXN_PER_SLOT );
+
+  /* Restore */
+
+  fd_txncache_t * tc = init_all( SNAPSHOT_ROOTED_SLOTS, SNAPSHOT_LIVE_SLOTS, SNAPSHOT_TXN_PER_SLOT );
+  long dt = -fd_log_wallclock();
+  FD_TEST( fd_txncache_insert_batch( tc, txns, txns_cnt ) );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "restore %lu txns: %.3f ms (%.1f Mtxn/s)", txns_cnt, (double)dt/1e6, (double)txns_cnt*1e3/(double)dt ));
+
+  for( ulong i=0UL; i<SNAPSHOT_ROOTED_SLOTS; i++ ) fd_txncache_register_root_slot( tc, i );
+
+  /* Serialize the status cache while another thread keeps inserting */
+
+  bench_insert_args_t insert_args = { .slot0 = SNAPSHOT_ROOTED_SLOTS, .stop = 0, .cnt = 0UL };
+  pthread_t thread;
+  FD_TEST( !pthread_create( &thread, NULL, bench_insert_fn, &insert_args ) );
+
+  ulong cnt = 0UL;
+  dt = -fd_log_wallclock();
+  FD_TEST( !fd_txncache_snapshot( tc, &cnt, snapshot_write_count ) );
+  dt += fd_log_wallclock();
+
+  insert_args.stop = 1;
+  FD_TEST( !pthread_join( thread, NULL ) );
+  FD_TEST( cnt==txns_cnt );
+  FD_LOG_NOTICE(( "snapshot %lu txns: %.3f ms, %lu concurrent inserts", cnt, (double)dt/1e6, insert_args.cnt ));
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -648,6 +915,9 @@ main( int     argc,
   test_full_blockhash_concurrent();
   test_many_blockhashes_concurrent();
   test_cache_full();
+  test_snapshot_concurrent();
+  test_snapshot_abort();
+  bench_snapshot_restore();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
@@ -426,10 +426,7 @@ create_block_context_protobuf_from_block( fd_exec_test_block_context_t * block_c
   ulong num_sysvar_entries    = (sizeof(fd_relevant_sysvar_ids) / sizeof(fd_pubkey_t));
   ulong num_loaded_builtins   = (sizeof(loaded_builtins) / sizeof(fd_pubkey_t));
 
-  fd_account_keys_global_t const *   stake_account_keys      = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
-  fd_account_keys_pair_t_mapnode_t * stake_account_keys_pool = fd_account_keys_account_keys_pool_join( stake_account_keys );
-  fd_account_keys_pair_t_mapnode_t * stake_account_keys_root = fd_account_keys_account_keys_root_join( stake_account_keys );
-
+  fd_bank_keys_t const * stake_account_keys = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
 
   fd_stakes_global_t const * stakes = fd_bank_stakes_locking_query( slot_ctx->bank );
   fd_delegation_pair_t_mapnode_t * stake_delegations_pool = fd_stakes_stake_delegations_pool_join( stakes );
@@ -438,7 +435,7 @@ create_block_context_protobuf_from_block( fd_exec_test_block_context_t * block_c
   fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_pool = fd_vote_accounts_vote_accounts_pool_join( &stakes->vote_accounts );
   fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_root = fd_vote_accounts_vote_accounts_root_join( &stakes->vote_accounts );
 
-  ulong new_stake_account_cnt = fd_account_keys_pair_t_map_size( stake_account_keys_pool, stake_account_keys_root );
+  ulong new_stake_account_cnt = fd_bank_keys_cnt( stake_account_keys );
   ulong stake_account_cnt     = fd_delegation_pair_t_map_size( stake_delegations_pool,
                                                                stake_delegations_root );
 
@@ -543,16 +540,11 @@ create_block_context_protobuf_from_block( fd_exec_test_block_context_t * block_c
   fd_bank_stakes_end_locking_query( slot_ctx->bank );
 
   stake_account_keys = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
-  stake_account_keys_pool = fd_account_keys_account_keys_pool_join( stake_account_keys );
-  stake_account_keys_root = fd_account_keys_account_keys_root_join( stake_account_keys );
 
   /* Dump all new stake accounts */
-  for( fd_account_keys_pair_t_mapnode_t const * curr = fd_account_keys_pair_t_map_minimum_const(
-          stake_account_keys_pool,
-          stake_account_keys_root );
-       curr;
-       curr = fd_account_keys_pair_t_map_successor_const( stake_account_keys_pool, curr ) ) {
-    dump_account_if_not_already_dumped( slot_ctx->funk, slot_ctx->funk_txn, &curr->elem.key, spad, block_context->acct_states, &block_context->acct_states_count, NULL );
+  fd_bank_keys_iter_t iter[1];
+  for( fd_bank_keys_iter_init( iter, stake_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
+    dump_account_if_not_already_dumped( slot_ctx->funk, slot_ctx->funk_txn, fd_bank_keys_iter_key( iter ), spad, block_context->acct_states, &block_context->acct_states_count, NULL );
   }
 
   fd_bank_stake_account_keys_end_locking_query( slot_ctx->bank );
@@ -574,18 +566,11 @@ create_block_context_protobuf_from_block( fd_exec_test_block_context_t * block_c
 
   fd_bank_stakes_end_locking_query( slot_ctx->bank );
 
-  fd_account_keys_global_t const * vote_account_keys = fd_bank_vote_account_keys_locking_query( slot_ctx->bank );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool = fd_account_keys_account_keys_pool_join( vote_account_keys );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root = fd_account_keys_account_keys_root_join( vote_account_keys );
-
+  fd_bank_keys_t const * vote_account_keys = fd_bank_vote_account_keys_locking_query( slot_ctx->bank );
 
   /* Dump all new vote accounts */
-  for( fd_account_keys_pair_t_mapnode_t const * curr = fd_account_keys_pair_t_map_minimum_const(
-          vote_account_keys_pool,
-          vote_account_keys_root );
-       curr;
-       curr = fd_account_keys_pair_t_map_successor_const( vote_account_keys_pool, curr ) ) {
-    dump_account_if_not_already_dumped( slot_ctx->funk, slot_ctx->funk_txn, &curr->elem.key, spad, block_context->acct_states, &block_context->acct_states_count, NULL );
+  for( fd_bank_keys_iter_init( iter, vote_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
+    dump_account_if_not_already_dumped( slot_ctx->funk, slot_ctx->funk_txn, fd_bank_keys_iter_key( iter ), spad, block_context->acct_states, &block_context->acct_states_count, NULL );
   }
 
   fd_bank_vote_account_keys_end_locking_query( slot_ctx->bank );
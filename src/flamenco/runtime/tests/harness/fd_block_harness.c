@@ -281,23 +281,18 @@ fd_runtime_fuzz_block_ctx_create( fd_runtime_fuzz_runner_t *           runner,
 
   // /* Initialize the current running epoch stake and vote accounts */
 
-  /* TODO: should be stake account max */
-  fd_account_keys_global_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( slot_ctx->bank );
-  pool_mem = (uchar *)fd_ulong_align_up( (ulong)stake_account_keys + sizeof(fd_account_keys_global_t), fd_account_keys_pair_t_map_align() );
-  fd_account_keys_pair_t_mapnode_t * account_keys_pool = fd_account_keys_pair_t_map_join( fd_account_keys_pair_t_map_new( pool_mem, vote_acct_max ) );
-  fd_account_keys_pair_t_mapnode_t * account_keys_root = NULL;
-  fd_account_keys_account_keys_pool_update( stake_account_keys, account_keys_pool );
-  fd_account_keys_account_keys_root_update( stake_account_keys, account_keys_root );
+  fd_bank_keys_t * stake_account_keys = fd_bank_stake_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( stake_account_keys );
   fd_bank_stake_account_keys_end_locking_modify( slot_ctx->bank );
 
-  fd_account_keys_global_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
-  pool_mem = (uchar *)fd_ulong_align_up( (ulong)vote_account_keys + sizeof(fd_account_keys_global_t), fd_account_keys_pair_t_map_align() );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool = fd_account_keys_pair_t_map_join( fd_account_keys_pair_t_map_new( pool_mem, vote_acct_max ) );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root = NULL;
-  fd_account_keys_account_keys_pool_update( vote_account_keys, vote_account_keys_pool );
-  fd_account_keys_account_keys_root_update( vote_account_keys, vote_account_keys_root );
+  fd_bank_keys_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( vote_account_keys );
   fd_bank_vote_account_keys_end_locking_modify( slot_ctx->bank );
 
+  fd_bank_keys_t * removed_vote_account_keys = fd_bank_removed_vote_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_release( removed_vote_account_keys );
+  fd_bank_removed_vote_account_keys_end_locking_modify( slot_ctx->bank );
+
 
   /* SETUP STAKES HERE */
   fd_stakes_global_t * stakes = fd_bank_stakes_locking_modify( slot_ctx->bank );
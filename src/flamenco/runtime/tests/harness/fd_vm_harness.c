@@ -624,12 +624,16 @@ fd_runtime_fuzz_vm_syscall_run( fd_runtime_fuzz_runner_t * runner,
   /* Only collect log on valid errors (i.e., != -1). Follows
      https://github.com/firedancer-io/solfuzz-agave/blob/99758d3c4f3a342d56e2906936458d82326ae9a8/src/utils/err_map.rs#L148 */
   if( effects->error != -1 && log->buf_sz ) {
+    /* Deferred logs can render larger than buf_sz */
+    char  log_str[ FD_LOG_COLLECTOR_MAX + FD_LOG_COLLECTOR_EXTRA ];
+    ulong log_str_sz = fd_log_collector_debug_sprintf( log, log_str, 0 );
     effects->log = FD_SCRATCH_ALLOC_APPEND(
-      l, alignof(pb_bytes_array_t), PB_BYTES_ARRAY_T_ALLOCSIZE( log->buf_sz ) );
+      l, alignof(pb_bytes_array_t), PB_BYTES_ARRAY_T_ALLOCSIZE( log_str_sz ) );
     if( FD_UNLIKELY( _l > output_end ) ) {
       goto error;
     }
-    effects->log->size = (uint)fd_log_collector_debug_sprintf( log, (char *)effects->log->bytes, 0 );
+    effects->log->size = (uint)log_str_sz;
+    fd_memcpy( effects->log->bytes, log_str, log_str_sz );
   } else {
     effects->log = NULL;
   }
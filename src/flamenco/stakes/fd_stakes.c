@@ -288,10 +288,8 @@ fd_populate_vote_accounts( fd_exec_slot_ctx_t *       slot_ctx,
 
 
   /* Initialize a temporary vote states cache */
-  fd_account_keys_global_t *         vote_account_keys        = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool   = fd_account_keys_account_keys_pool_join( vote_account_keys );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root   = fd_account_keys_account_keys_root_join( vote_account_keys );
-  ulong                              vote_account_keys_map_sz = vote_account_keys_pool ? fd_account_keys_pair_t_map_size( vote_account_keys_pool, vote_account_keys_root ) : 0UL;
+  fd_bank_keys_t const * vote_account_keys        = fd_bank_vote_account_keys_locking_query( slot_ctx->bank );
+  ulong                  vote_account_keys_map_sz = fd_bank_keys_cnt( vote_account_keys );
 
   fd_stakes_global_t const *                 stakes                      = fd_bank_stakes_locking_query( slot_ctx->bank );
   fd_vote_accounts_global_t const *          vote_accounts               = &stakes->vote_accounts;
@@ -322,21 +320,20 @@ fd_populate_vote_accounts( fd_exec_slot_ctx_t *       slot_ctx,
 
   fd_bank_stakes_end_locking_query( slot_ctx->bank );
 
-  for( fd_account_keys_pair_t_mapnode_t * n = fd_account_keys_pair_t_map_minimum( vote_account_keys_pool, vote_account_keys_root );
-        n;
-        n = fd_account_keys_pair_t_map_successor( vote_account_keys_pool, n ) ) {
+  fd_bank_keys_iter_t iter[1];
+  for( fd_bank_keys_iter_init( iter, vote_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
     fd_stake_weight_t_mapnode_t temp;
-    temp.elem.key = n->elem.key;
+    temp.elem.key = *fd_bank_keys_iter_key( iter );
     fd_stake_weight_t_mapnode_t * entry = fd_stake_weight_t_map_find( pool, root, &temp );
     if( FD_LIKELY( entry==NULL ) ) {
       entry             = fd_stake_weight_t_map_acquire( pool );
-      entry->elem.key   = n->elem.key;
+      entry->elem.key   = temp.elem.key;
       entry->elem.stake = 0UL;
       fd_stake_weight_t_map_insert( pool, &root, entry );
     }
   }
 
-  fd_bank_vote_account_keys_end_locking_modify( slot_ctx->bank );
+  fd_bank_vote_account_keys_end_locking_query( slot_ctx->bank );
 
   fd_compute_stake_delegations_t task_args  = {
     .epoch                     = stakes->epoch,
@@ -416,11 +413,25 @@ fd_refresh_vote_accounts( fd_exec_slot_ctx_t *       slot_ctx,
   fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_pool = fd_vote_accounts_vote_accounts_pool_join( vote_accounts );
   fd_vote_accounts_pair_global_t_mapnode_t * stakes_vote_accounts_root = fd_vote_accounts_vote_accounts_root_join( vote_accounts );
 
-  fd_account_keys_global_t *         vote_account_keys      = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_pool = fd_account_keys_account_keys_pool_join( vote_account_keys );
-  fd_account_keys_pair_t_mapnode_t * vote_account_keys_root = fd_account_keys_account_keys_root_join( vote_account_keys );
+  /* Apply the removals of vote accounts closed during the epoch (see
+     remove_vote_account in fd_vote_program.c). */
+  fd_bank_keys_t * removed_vote_account_keys = fd_bank_removed_vote_account_keys_locking_modify( slot_ctx->bank );
+  fd_bank_keys_iter_t iter[1];
+  for( fd_bank_keys_iter_init( iter, removed_vote_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
+    fd_vote_accounts_pair_global_t_mapnode_t key;
+    key.elem.key = *fd_bank_keys_iter_key( iter );
+    fd_vote_accounts_pair_global_t_mapnode_t * entry = fd_vote_accounts_pair_global_t_map_find( stakes_vote_accounts_pool, stakes_vote_accounts_root, &key );
+    if( FD_LIKELY( entry ) ) {
+      fd_vote_accounts_pair_global_t_map_remove( stakes_vote_accounts_pool, &stakes_vote_accounts_root, entry );
+      fd_vote_accounts_pair_global_t_map_release( stakes_vote_accounts_pool, entry );
+    }
+  }
+  fd_bank_keys_release( removed_vote_account_keys );
+  fd_bank_removed_vote_account_keys_end_locking_modify( slot_ctx->bank );
+
+  fd_bank_keys_t * vote_account_keys = fd_bank_vote_account_keys_locking_modify( slot_ctx->bank );
 
-  ulong vote_account_keys_map_sz    = !!vote_account_keys_pool ? fd_account_keys_pair_t_map_size( vote_account_keys_pool, vote_account_keys_root ) : 0UL;
+  ulong vote_account_keys_map_sz    = fd_bank_keys_cnt( vote_account_keys );
   ulong vote_accounts_stakes_map_sz = !!stakes_vote_accounts_pool ? fd_vote_accounts_pair_global_t_map_size( stakes_vote_accounts_pool, stakes_vote_accounts_root ) : 0UL;
   ulong vote_states_pool_sz         = vote_accounts_stakes_map_sz + vote_account_keys_map_sz;
 
@@ -445,15 +456,13 @@ fd_refresh_vote_accounts( fd_exec_slot_ctx_t *       slot_ctx,
     fd_stake_weight_t_map_insert( pool, &root, entry );
   }
 
-  for( fd_account_keys_pair_t_mapnode_t * n = fd_account_keys_pair_t_map_minimum( vote_account_keys_pool, vote_account_keys_root );
-        n;
-        n = fd_account_keys_pair_t_map_successor( vote_account_keys_pool, n ) ) {
+  for( fd_bank_keys_iter_init( iter, vote_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
     fd_stake_weight_t_mapnode_t temp;
-    temp.elem.key = n->elem.key;
+    temp.elem.key = *fd_bank_keys_iter_key( iter );
     fd_stake_weight_t_mapnode_t * entry = fd_stake_weight_t_map_find( pool, root, &temp );
     if( FD_LIKELY( entry==NULL ) ) {
       entry             = fd_stake_weight_t_map_acquire( pool );
-      entry->elem.key   = n->elem.key;
+      entry->elem.key   = temp.elem.key;
       entry->elem.stake = 0UL;
       fd_stake_weight_t_map_insert( pool, &root, entry );
     }
@@ -500,11 +509,9 @@ fd_refresh_vote_accounts( fd_exec_slot_ctx_t *       slot_ctx,
   }
 
   // Update the epoch stakes cache with new vote accounts from the epoch
-  for( fd_account_keys_pair_t_mapnode_t * n = fd_account_keys_pair_t_map_minimum( vote_account_keys_pool, vote_account_keys_root );
-        n;
-        n = fd_account_keys_pair_t_map_successor( vote_account_keys_pool, n ) ) {
+  for( fd_bank_keys_iter_init( iter, vote_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
 
-    fd_pubkey_t const * vote_account_pubkey = &n->elem.key;
+    fd_pubkey_t const * vote_account_pubkey = fd_bank_keys_iter_key( iter );
     fd_vote_accounts_pair_global_t_mapnode_t key;
     key.elem.key = *vote_account_pubkey;
 
@@ -545,12 +552,7 @@ fd_refresh_vote_accounts( fd_exec_slot_ctx_t *       slot_ctx,
   fd_bank_total_epoch_stake_set( slot_ctx->bank, total_epoch_stake );
 
   /* At this point, we need to flush the vote account keys cache */
-  vote_account_keys_pool = fd_account_keys_account_keys_pool_join( vote_account_keys );
-  vote_account_keys_root = fd_account_keys_account_keys_root_join( vote_account_keys );
-  fd_account_keys_pair_t_map_release_tree( vote_account_keys_pool, vote_account_keys_root );
-  vote_account_keys_root = NULL;
-  fd_account_keys_account_keys_pool_update( vote_account_keys, vote_account_keys_pool );
-  fd_account_keys_account_keys_root_update( vote_account_keys, vote_account_keys_root );
+  fd_bank_keys_release( vote_account_keys );
   fd_bank_vote_account_keys_end_locking_modify( slot_ctx->bank );
 }
 
@@ -709,21 +711,14 @@ fd_accumulate_stake_infos( fd_exec_slot_ctx_t const * slot_ctx,
 
   temp_info->stake_infos_new_keys_start_idx = temp_info->stake_infos_len;
 
-  fd_account_keys_global_t const *   stake_account_keys = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
-  fd_account_keys_pair_t_mapnode_t * account_keys_pool  = fd_account_keys_account_keys_pool_join( stake_account_keys );
-  fd_account_keys_pair_t_mapnode_t * account_keys_root  = fd_account_keys_account_keys_root_join( stake_account_keys );
-
-  if( !account_keys_pool ) {
-    fd_bank_stake_account_keys_end_locking_query( slot_ctx->bank );
-    return;
-  }
+  fd_bank_keys_t const * stake_account_keys = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
 
   /* The number of account keys aggregated across the epoch is usually small, so there aren't much performance gains from tpooling here. */
-  for( fd_account_keys_pair_t_mapnode_t * n = fd_account_keys_pair_t_map_minimum( account_keys_pool, account_keys_root );
-       n;
-       n = fd_account_keys_pair_t_map_successor( account_keys_pool, n ) ) {
+  fd_bank_keys_iter_t iter[1];
+  for( fd_bank_keys_iter_init( iter, stake_account_keys ); !fd_bank_keys_iter_done( iter ); fd_bank_keys_iter_next( iter ) ) {
+    fd_pubkey_t const * key = fd_bank_keys_iter_key( iter );
     FD_TXN_ACCOUNT_DECL( acc );
-    int rc = fd_txn_account_init_from_funk_readonly(acc, &n->elem.key, slot_ctx->funk, slot_ctx->funk_txn );
+    int rc = fd_txn_account_init_from_funk_readonly(acc, key, slot_ctx->funk, slot_ctx->funk_txn );
     if( FD_UNLIKELY( rc!=FD_ACC_MGR_SUCCESS || acc->vt->get_lamports( acc )==0UL ) ) {
       continue;
     }
@@ -744,7 +739,7 @@ fd_accumulate_stake_infos( fd_exec_slot_ctx_t const * slot_ctx,
 
     fd_delegation_t * delegation = &stake_state.inner.stake.stake.delegation;
     temp_info->stake_infos[temp_info->stake_infos_len  ].stake    = stake_state.inner.stake.stake;
-    temp_info->stake_infos[temp_info->stake_infos_len++].account  = n->elem.key;
+    temp_info->stake_infos[temp_info->stake_infos_len++].account  = *key;
     fd_stake_history_entry_t new_entry = fd_stake_activating_and_deactivating( delegation, stakes->epoch, history, new_rate_activation_epoch );
     accumulator->effective    += new_entry.effective;
     accumulator->activating   += new_entry.activating;
@@ -769,15 +764,7 @@ fd_stakes_activate_epoch( fd_exec_slot_ctx_t *  slot_ctx,
   fd_delegation_pair_t_mapnode_t * stake_delegations_pool = fd_stakes_stake_delegations_pool_join( stakes );
   fd_delegation_pair_t_mapnode_t * stake_delegations_root = fd_stakes_stake_delegations_root_join( stakes );
 
-  fd_account_keys_global_t const * stake_account_keys = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
-
-  fd_account_keys_pair_t_mapnode_t * account_keys_pool = NULL;
-  fd_account_keys_pair_t_mapnode_t * account_keys_root = NULL;
-
-  if( stake_account_keys ) {
-    account_keys_pool = fd_account_keys_account_keys_pool_join( stake_account_keys );
-    account_keys_root = fd_account_keys_account_keys_root_join( stake_account_keys );
-  }
+  fd_bank_keys_t const * stake_account_keys = fd_bank_stake_account_keys_locking_query( slot_ctx->bank );
 
   /* Current stake delegations: list of all current delegations in stake_delegations
      https://github.com/solana-labs/solana/blob/88aeaa82a856fc807234e7da0b31b89f2dc0e091/runtime/src/stakes.rs#L180 */
@@ -790,7 +777,7 @@ fd_stakes_activate_epoch( fd_exec_slot_ctx_t *  slot_ctx,
   ulong stake_delegations_size = fd_delegation_pair_t_map_size(
     stake_delegations_pool, stake_delegations_root );
 
-  stake_delegations_size += !!account_keys_pool ? fd_account_keys_pair_t_map_size( account_keys_pool, account_keys_root ) : 0UL;
+  stake_delegations_size += fd_bank_keys_cnt( stake_account_keys );
 
   fd_bank_stake_account_keys_end_locking_query( slot_ctx->bank );
 
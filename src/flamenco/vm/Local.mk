@@ -14,11 +14,13 @@ $(call make-bin,fd_vm_tool,fd_vm_tool,fd_flamenco fd_funk fd_ballet fd_util fd_d
 $(call make-unit-test,test_vm_interp,test_vm_interp,fd_flamenco fd_funk fd_ballet fd_util fd_disco,$(SECP256K1_LIBS))
 
 $(call make-unit-test,test_vm_base,test_vm_base,fd_flamenco fd_ballet fd_util)
+$(call make-unit-test,test_vm_input_region,test_vm_input_region,fd_flamenco fd_ballet fd_util)
 
 $(call make-unit-test,test_vm_instr,test_vm_instr,fd_flamenco fd_funk fd_ballet fd_util,$(SECP256K1_LIBS))
 $(call run-unit-test,test_vm_instr)
 
 $(call run-unit-test,test_vm_base)
+$(call run-unit-test,test_vm_input_region)
 $(call run-unit-test,test_vm_interp)
 endif
 endif
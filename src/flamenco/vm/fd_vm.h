@@ -65,6 +65,38 @@ typedef struct fd_vm_acc_region_meta fd_vm_acc_region_meta_t;
     https://github.com/solana-labs/rbpf/blob/cd19a25c17ec474e6fa01a3cc3efa325f44cd111/src/ebpf.rs#L39-L40  */
 #define FD_VM_HOST_REGION_ALIGN                   (16UL)
 
+/* When direct mapping is enabled, the input region is fragmented into
+   many input memory regions (typically 2-3 per account) and every input
+   region access has to find the region holding the accessed offset.
+   To keep this from being a binary search over all regions, the vm
+   keeps a dense index over the input region: the input region is
+   divided into buckets of 2^input_region_idx_lg_sz bytes and
+   input_region_idx[b] holds the index of the region that holds the
+   byte at offset b<<input_region_idx_lg_sz.  The region holding any
+   offset in bucket b is then in [input_region_idx[b],input_region_idx[b+1]],
+   which usually has one or two regions in it.
+
+   FD_VM_INPUT_REGION_IDX_MAX is the maximum number of buckets.
+   FD_VM_INPUT_REGION_IDX_LG_MIN is the log2 of the minimum bucket size.
+   The index is only built if there are at least
+   FD_VM_INPUT_REGION_IDX_MIN_CNT input memory regions (below that, a
+   plain binary search is as fast). */
+#define FD_VM_INPUT_REGION_IDX_MAX                (1024UL)
+#define FD_VM_INPUT_REGION_IDX_LG_MIN             (8U)
+#define FD_VM_INPUT_REGION_IDX_MIN_CNT            (8U)
+
+/* When direct mapping is disabled, account data is copied into the
+   input region and has to be copied out (writable accounts) or
+   compared (read-only accounts) after execution.  To avoid doing this
+   for bytes the program never wrote, the vm can track writes to the
+   input region in a dirty bitmap: the input region is divided into
+   chunks of 2^FD_VM_INPUT_DIRTY_LG_CHUNK bytes and bit c of the bitmap
+   is set if any byte in chunk c was possibly written.  A byte is marked
+   when a store or a syscall translates a writable range holding it
+   (whether or not it is then actually written), so clean bytes are
+   guaranteed to be unmodified. */
+#define FD_VM_INPUT_DIRTY_LG_CHUNK                (6UL)
+
 struct __attribute__((aligned(FD_VM_HOST_REGION_ALIGN))) fd_vm {
 
   /* VM configuration */
@@ -187,6 +219,12 @@ struct __attribute__((aligned(FD_VM_HOST_REGION_ALIGN))) fd_vm {
                                                                 The virtual addresses of each region are contigiuous and
                                                                 strictly increasing. */
   uint                      input_mem_regions_cnt;
+  uint                      input_region_idx_lg_sz;          /* log2 of the size in bytes of an input region index bucket */
+  uint                      input_region_idx_cnt;            /* Number of input region index buckets, 0 if the index is not used */
+  uint                      input_region_idx[ FD_VM_INPUT_REGION_IDX_MAX+1UL ]; /* Input region index, indexed [0,input_region_idx_cnt].
+                                                                See FD_VM_INPUT_REGION_IDX_MAX above. */
+  ulong *                   input_dirty;                     /* Input region dirty bitmap, NULL if writes are not tracked.
+                                                                See FD_VM_INPUT_DIRTY_LG_CHUNK above. */
   fd_vm_acc_region_meta_t * acc_region_metas;                /* Represents a mapping from the instruction account indicies
                                                                 from the instruction context to the input memory region index
                                                                 of the account's data region in the input space. */
@@ -235,7 +273,7 @@ FD_PROTOTYPES_BEGIN
    integer power of 2.  FOOTPRINT is a multiple of align.
    These are provided to facilitate compile time declarations. */
 #define FD_VM_ALIGN     FD_VM_HOST_REGION_ALIGN
-#define FD_VM_FOOTPRINT (527824UL)
+#define FD_VM_FOOTPRINT (531936UL)
 
 /* fd_vm_{align,footprint} give the needed alignment and footprint
    of a memory region suitable to hold an fd_vm_t.
@@ -342,6 +380,78 @@ fd_vm_is_check_size_enabled( fd_vm_t const * vm ) {
    return !vm->is_deprecated;
 }
 
+/* fd_vm_input_dirty_footprint returns the footprint of an input region
+   dirty bitmap (see FD_VM_INPUT_DIRTY_LG_CHUNK) for an input region of
+   input_sz bytes.  The bitmap is an array of ulong and must be zeroed
+   before the vm is attached to it. */
+
+FD_FN_CONST static inline ulong
+fd_vm_input_dirty_footprint( ulong input_sz ) {
+  ulong chunk_cnt = (input_sz + (1UL<<FD_VM_INPUT_DIRTY_LG_CHUNK) - 1UL) >> FD_VM_INPUT_DIRTY_LG_CHUNK;
+  return ((chunk_cnt+63UL)>>6) * sizeof(ulong);
+}
+
+/* fd_vm_input_dirty_mark marks the input region bytes [off,off+sz) as
+   dirty.  Assumes the range is inside the input region covered by
+   dirty. */
+
+static inline void
+fd_vm_input_dirty_mark( ulong * dirty,
+                        ulong   off,
+                        ulong   sz ) {
+  if( FD_UNLIKELY( !sz ) ) return;
+  ulong c0 = off          >> FD_VM_INPUT_DIRTY_LG_CHUNK;
+  ulong c1 = (off+sz-1UL) >> FD_VM_INPUT_DIRTY_LG_CHUNK;
+  if( FD_LIKELY( c1-c0<=1UL ) ) { /* e.g. any sBPF store */
+    dirty[ c0>>6 ] |= 1UL << (c0&63UL);
+    dirty[ c1>>6 ] |= 1UL << (c1&63UL);
+    return;
+  }
+  ulong w0 = c0>>6;
+  ulong w1 = c1>>6;
+  ulong m0 = ~0UL << (c0&63UL);
+  ulong m1 = ~0UL >> (63UL-(c1&63UL));
+  if( w0==w1 ) {
+    dirty[ w0 ] |= m0 & m1;
+    return;
+  }
+  dirty[ w0 ] |= m0;
+  for( ulong w=w0+1UL; w<w1; w++ ) dirty[ w ] = ~0UL;
+  dirty[ w1 ] |= m1;
+}
+
+/* fd_vm_input_dirty_find returns the lowest offset in [off,end) whose
+   chunk is dirty (if dirty is non-zero) or clean (if dirty is zero),
+   and end if there is none.  Assumes [off,end) is inside the input
+   region covered by bitmap.  Dirty ranges are typically walked as:
+
+     ulong lo = fd_vm_input_dirty_find( bitmap, off, end, 1 );
+     while( lo<end ) {
+       ulong hi = fd_vm_input_dirty_find( bitmap, lo, end, 0 );
+       ... bytes [lo,hi) are possibly modified ...
+       lo = fd_vm_input_dirty_find( bitmap, hi, end, 1 );
+     } */
+
+FD_FN_PURE static inline ulong
+fd_vm_input_dirty_find( ulong const * bitmap,
+                        ulong         off,
+                        ulong         end,
+                        int           dirty ) {
+  if( FD_UNLIKELY( off>=end ) ) return end;
+  ulong flip = dirty ? 0UL : ~0UL;
+  ulong c    = off >> FD_VM_INPUT_DIRTY_LG_CHUNK;
+  ulong w    = (bitmap[ c>>6 ] ^ flip) & (~0UL << (c&63UL));
+  for(;;) {
+    if( w ) {
+      ulong o = ((c & ~63UL) + (ulong)fd_ulong_find_lsb( w )) << FD_VM_INPUT_DIRTY_LG_CHUNK;
+      return fd_ulong_min( fd_ulong_max( o, off ), end );
+    }
+    c = (c|63UL) + 1UL;
+    if( (c<<FD_VM_INPUT_DIRTY_LG_CHUNK)>=end ) return end;
+    w = bitmap[ c>>6 ] ^ flip;
+  }
+}
+
 /* FIXME: make this trace-aware, and move into fd_vm_init
    This is a temporary hack to make the fuzz harness work. */
 int
@@ -203,9 +203,52 @@ FD_FN_CONST static inline ulong fd_vm_instr_mem_opaddrmode( ulong instr ) { retu
    that Solana protocol limits are much smaller still), it is impossible
    for a valid virtual address range to span multiple regions. */
 
-/* fd_vm_mem_cfg configures the vm's tlb arrays.  Assumes vm is valid
-   and vm already has configured the rodata, stack, heap and input
-   regions.  Returns vm. */
+/* fd_vm_input_region_idx_cfg builds the vm's input region index (see
+   FD_VM_INPUT_REGION_IDX_MAX in fd_vm.h) from its input memory
+   regions.  The index is only used when direct mapping is enabled and
+   there are enough input memory regions to make it worthwhile.
+   Assumes the input memory regions are contiguous and in increasing
+   vaddr_offset order.  The cost is O(input_mem_regions_cnt +
+   FD_VM_INPUT_REGION_IDX_MAX) worst case. */
+
+static inline void
+fd_vm_input_region_idx_cfg( fd_vm_t * vm ) {
+  vm->input_region_idx_lg_sz = FD_VM_INPUT_REGION_IDX_LG_MIN;
+  vm->input_region_idx_cnt   = 0U;
+
+  ulong region_cnt = (ulong)vm->input_mem_regions_cnt;
+  if( !vm->direct_mapping || region_cnt<FD_VM_INPUT_REGION_IDX_MIN_CNT ) return;
+
+  fd_vm_input_region_t const * regions = vm->input_mem_regions;
+  ulong input_sz = regions[ region_cnt-1UL ].vaddr_offset + (ulong)regions[ region_cnt-1UL ].region_sz;
+
+  /* Pick the smallest bucket size such that every offset in
+     [0,input_sz) falls into one of at most FD_VM_INPUT_REGION_IDX_MAX
+     buckets. */
+
+  uint lg_sz = FD_VM_INPUT_REGION_IDX_LG_MIN;
+  while( (input_sz>>lg_sz)>=FD_VM_INPUT_REGION_IDX_MAX ) lg_sz++;
+  ulong bucket_cnt = (input_sz>>lg_sz) + 1UL;
+
+  /* input_region_idx[b] is what fd_vm_get_input_mem_region_idx would
+     return for the offset b<<lg_sz, i.e. the first region whose end is
+     past that offset (or the last region if there is none).  The extra
+     entry at bucket_cnt bounds lookups into the last bucket. */
+
+  ulong r = 0UL;
+  for( ulong b=0UL; b<=bucket_cnt; b++ ) {
+    ulong offset = b<<lg_sz;
+    while( r<region_cnt-1UL && offset>=regions[ r ].vaddr_offset+(ulong)regions[ r ].region_sz ) r++;
+    vm->input_region_idx[ b ] = (uint)r;
+  }
+
+  vm->input_region_idx_lg_sz = lg_sz;
+  vm->input_region_idx_cnt   = (uint)bucket_cnt;
+}
+
+/* fd_vm_mem_cfg configures the vm's tlb arrays and input region index.
+   Assumes vm is valid and vm already has configured the rodata, stack,
+   heap and input regions.  Returns vm. */
 
 static inline fd_vm_t *
 fd_vm_mem_cfg( fd_vm_t * vm ) {
@@ -225,6 +268,7 @@ fd_vm_mem_cfg( fd_vm_t * vm ) {
     vm->region_ld_sz[FD_VM_INPUT_REGION] = vm->input_mem_regions[0].region_sz;
     vm->region_st_sz[FD_VM_INPUT_REGION] = vm->input_mem_regions[0].region_sz;
   }
+  fd_vm_input_region_idx_cfg( vm );
   return vm;
 }
 
@@ -280,20 +324,33 @@ fd_vm_generate_access_violation( ulong vaddr, ulong sbpf_version ) {
    known that the vaddr region has a valid mapping.
 
    These assumptions don't hold if direct mapping is enabled since input
-   region lookups become O(log(n)). */
+   region lookups have to find the input memory region holding the
+   offset.  With the input region index, that is O(1) for typical
+   layouts and O(log(n)) worst case. */
 
 
 /* fd_vm_get_input_mem_region_idx returns the index into the input memory
    region array with the largest region offset that is <= the offset that
    is passed in.  This function makes NO guarantees about the input being
    a valid input region offset; the caller is responsible for safely handling
-   it. */
+   it.
+
+   If the vm has an input region index and offset is inside the input
+   region, the search is narrowed to the regions that overlap offset's
+   bucket.  As the search predicate is monotonic in the region index,
+   this gives exactly the same result as searching all regions. */
 static inline ulong
 fd_vm_get_input_mem_region_idx( fd_vm_t const * vm, ulong offset ) {
   uint left  = 0U;
   uint right = vm->input_mem_regions_cnt - 1U;
   uint mid   = 0U;
 
+  ulong bucket = offset >> vm->input_region_idx_lg_sz;
+  if( FD_LIKELY( bucket<(ulong)vm->input_region_idx_cnt ) ) {
+    left  = vm->input_region_idx[ bucket     ];
+    right = vm->input_region_idx[ bucket+1UL ];
+  }
+
   while( left<right ) {
     mid = (left+right) / 2U;
     if( offset>=vm->input_mem_regions[ mid ].vaddr_offset+vm->input_mem_regions[ mid ].region_sz ) {
@@ -354,6 +411,10 @@ fd_vm_find_input_mem_region( fd_vm_t const * vm,
     }
   }
 
+  /* Without direct mapping, the caller is about to write to the
+     serialized account data (see FD_VM_INPUT_DIRTY_LG_CHUNK). */
+  if( write && vm->input_dirty ) fd_vm_input_dirty_mark( vm->input_dirty, offset, sz );
+
   ulong adjusted_haddr = vm->input_mem_regions[ start_region_idx ].haddr + offset - vm->input_mem_regions[ start_region_idx ].vaddr_offset;
   return adjusted_haddr;
 }
@@ -386,9 +386,11 @@ fd_vm_syscall_cpi_check_authorized_program( fd_pubkey_t const *       program_id
 #define VM_SERIALIZED_PUBKEY_OFFSET   (8UL)
 #define VM_SERIALIZED_OWNER_OFFSET    (40UL)
 #define VM_SERIALIZED_LAMPORTS_OFFSET (72UL)
+#define VM_SERIALIZED_DATA_OFFSET     (88UL)
 
 #define VM_SERIALIZED_UNALIGNED_PUBKEY_OFFSET   (3UL)
 #define VM_SERIALIZED_UNALIGNED_LAMPORTS_OFFSET (35UL)
+#define VM_SERIALIZED_UNALIGNED_DATA_OFFSET     (51UL)
 
 static inline
 ulong serialized_pubkey_vaddr( fd_vm_t * vm, fd_vm_acc_region_meta_t * acc_region_meta ) {
@@ -419,6 +421,28 @@ ulong serialized_lamports_vaddr( fd_vm_t * vm, fd_vm_acc_region_meta_t * acc_reg
     (vm->is_deprecated ? VM_SERIALIZED_UNALIGNED_LAMPORTS_OFFSET : VM_SERIALIZED_LAMPORTS_OFFSET);
 }
 
+/* Without direct mapping, the AccountInfo data pointer handed to a CPI
+   is not checked against the serialized account: it can point anywhere
+   in the caller's writable memory (e.g. a copy on the heap), so writes
+   to the caller's serialized data during the CPI don't necessarily go
+   through the input region translation.  serialized_data_mark_dirty
+   marks the whole serialized entry of the account (metadata, data and,
+   for the aligned serializer, the realloc padding) dirty so that
+   deserialization doesn't skip any of it.  No-op if writes to the input
+   region are not being tracked. */
+
+static inline void
+serialized_data_mark_dirty( fd_vm_t * vm, fd_vm_acc_region_meta_t const * acc_region_meta ) {
+  if( FD_UNLIKELY( vm->direct_mapping || !vm->input_dirty || !vm->input_mem_regions_cnt ) ) return;
+  ulong input_sz = vm->input_mem_regions[0].region_sz;
+  ulong off      = acc_region_meta->metadata_region_offset;
+  if( FD_UNLIKELY( off>=input_sz ) ) return;
+  ulong sz = vm->is_deprecated ?
+             VM_SERIALIZED_UNALIGNED_DATA_OFFSET + acc_region_meta->original_data_len :
+             VM_SERIALIZED_DATA_OFFSET + acc_region_meta->original_data_len + MAX_PERMITTED_DATA_INCREASE + FD_BPF_ALIGN_OF_U128;
+  fd_vm_input_dirty_mark( vm->input_dirty, off, fd_ulong_min( sz, input_sz-off ) );
+}
+
 /* The data and lamports fields are in an Rc<Refcell<T>> in the Rust ABI AccountInfo.
    These macros perform the equivalent of Rc<Refcell<T>>.as_ptr() in Agave.
    This function doesn't actually touch any memory.
@@ -353,6 +353,7 @@ VM_SYSCALL_CPI_TRANSLATE_AND_UPDATE_ACCOUNTS_FUNC(
       ////// BEGIN from_account_info
 
       fd_vm_acc_region_meta_t * acc_region_meta = &vm->acc_region_metas[index_in_caller];
+      serialized_data_mark_dirty( vm, acc_region_meta );
       if( FD_LIKELY( vm->direct_mapping ) ) {
         /* https://github.com/anza-xyz/agave/blob/v2.1.7/programs/bpf_loader/src/syscalls/cpi.rs#L116
          */
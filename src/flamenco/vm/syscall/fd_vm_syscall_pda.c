@@ -2,29 +2,29 @@
 
 #include "../../../ballet/ed25519/fd_curve25519.h"
 
-/* fd_compute_pda derives a PDA given:
-   - the vm
-   - the program id, which should be provided through either program_id or program_id_vaddr
-      - This allows the user to pass in a program ID in either host address space or virtual address space.
-      - If both are passed in, the host address space pubkey will be used.
-   - the program_id pubkey in virtual address space. if the host address space pubkey is not given then the virtual address will be translated.
-   - the seeds array vaddr
-   - the seeds array count
-   - an optional bump seed
-   - out, the address in host address space where the PDA will be written to
-
-If the derived PDA was not a valid ed25519 point, then this function will return FD_VM_SYSCALL_ERR_INVALID_PDA.
-
-The derivation can also fail because of an out-of-bounds memory access, or an invalid seed list.
- */
-int
-fd_vm_derive_pda( fd_vm_t *           vm,
-                  fd_pubkey_t const * program_id,
-                  void const * *      seed_haddrs,
-                  ulong *             seed_szs,
-                  ulong               seeds_cnt,
-                  uchar *             bump_seed,
-                  fd_pubkey_t *       out ) {
+/* FD_VM_PDA_CAND_MAX is the number of candidate addresses
+   fd_vm_syscall_sol_try_find_program_address checks at once.  Pairing
+   candidates only pays off if fd_ed25519_point_validate_2x is well
+   below the cost of two fd_ed25519_point_validate (about 1.3x with
+   the avx512 field backend, about 1.45x with the ref backend, against
+   an expected 2 candidates per search), so only pair with avx512. */
+
+#if FD_HAS_AVX512
+#define FD_VM_PDA_CAND_MAX (2UL)
+#else
+#define FD_VM_PDA_CAND_MAX (1UL)
+#endif
+
+/* fd_vm_pda_check_seeds does the seed checks of fd_vm_derive_pda.
+   These only depend on the seed list and on the presence of a bump
+   seed, so they give the same result for every bump seed tried by
+   fd_vm_syscall_sol_try_find_program_address. */
+
+static int
+fd_vm_pda_check_seeds( fd_vm_t *     vm,
+                       ulong const * seed_szs,
+                       ulong         seeds_cnt,
+                       int           has_bump_seed ) {
 
   /* This is a preflight check that is performed in Agave before deriving PDAs but after checking the seeds vaddr.
      Weirdly they do two checks for seeds cnt - one before PDA derivation, and one during. The first check will
@@ -41,7 +41,7 @@ fd_vm_derive_pda( fd_vm_t *           vm,
      that if the user provides 16 seeds (excluding the bump) in the `try_find_program_address` syscall,
      this same check below will be hit 255 times and deduct that many CUs. Very strange...
      https://github.com/anza-xyz/agave/blob/v2.1.0/sdk/pubkey/src/lib.rs#L725-L727 */
-  if( FD_UNLIKELY( seeds_cnt+( !!bump_seed )>FD_VM_PDA_SEEDS_MAX ) ) {
+  if( FD_UNLIKELY( seeds_cnt+( !!has_bump_seed )>FD_VM_PDA_SEEDS_MAX ) ) {
     return FD_VM_SYSCALL_ERR_INVALID_PDA;
   }
 
@@ -55,7 +55,17 @@ fd_vm_derive_pda( fd_vm_t *           vm,
     }
   }
 
-  fd_sha256_init( vm->sha );
+  return FD_VM_SUCCESS;
+}
+
+/* fd_vm_pda_hash_seeds starts the PDA hash in sha with the seeds. */
+
+static void
+fd_vm_pda_hash_seeds( fd_sha256_t *  sha,
+                      void const * * seed_haddrs,
+                      ulong const *  seed_szs,
+                      ulong          seeds_cnt ) {
+  fd_sha256_init( sha );
   for( ulong i=0UL; i<seeds_cnt; i++ ) {
     ulong seed_sz = seed_szs[ i ];
 
@@ -66,23 +76,65 @@ fd_vm_derive_pda( fd_vm_t *           vm,
       continue;
     }
     void const * seed_haddr = seed_haddrs[ i ];
-    fd_sha256_append( vm->sha, seed_haddr, seed_sz );
+    fd_sha256_append( sha, seed_haddr, seed_sz );
   }
+}
+
+/* fd_vm_pda_hash_fini finishes the PDA hash in sha started by
+   fd_vm_pda_hash_seeds with the optional bump seed, the program id and
+   the PDA marker, and writes the resulting address to out. */
+
+static void
+fd_vm_pda_hash_fini( fd_sha256_t *       sha,
+                     uchar const *       bump_seed,
+                     fd_pubkey_t const * program_id,
+                     fd_pubkey_t *       out ) {
 
   /* https://github.com/anza-xyz/agave/blob/v2.1.0/sdk/pubkey/src/lib.rs#L738-L747 */
   if( bump_seed ) {
-    fd_sha256_append( vm->sha, bump_seed, 1UL );
+    fd_sha256_append( sha, bump_seed, 1UL );
   }
 
   if( FD_LIKELY( program_id )) {
-    fd_sha256_append( vm->sha, program_id, FD_PUBKEY_FOOTPRINT );
+    fd_sha256_append( sha, program_id, FD_PUBKEY_FOOTPRINT );
   } else {
     FD_LOG_ERR(( "No program id passed in" ));
   }
 
-  fd_sha256_append( vm->sha, "ProgramDerivedAddress", 21UL ); /* TODO: use marker constant */
+  fd_sha256_append( sha, "ProgramDerivedAddress", 21UL ); /* TODO: use marker constant */
+
+  fd_sha256_fini( sha, out );
+}
+
+/* fd_compute_pda derives a PDA given:
+   - the vm
+   - the program id, which should be provided through either program_id or program_id_vaddr
+      - This allows the user to pass in a program ID in either host address space or virtual address space.
+      - If both are passed in, the host address space pubkey will be used.
+   - the program_id pubkey in virtual address space. if the host address space pubkey is not given then the virtual address will be translated.
+   - the seeds array vaddr
+   - the seeds array count
+   - an optional bump seed
+   - out, the address in host address space where the PDA will be written to
 
-  fd_sha256_fini( vm->sha, out );
+If the derived PDA was not a valid ed25519 point, then this function will return FD_VM_SYSCALL_ERR_INVALID_PDA.
+
+The derivation can also fail because of an out-of-bounds memory access, or an invalid seed list.
+ */
+int
+fd_vm_derive_pda( fd_vm_t *           vm,
+                  fd_pubkey_t const * program_id,
+                  void const * *      seed_haddrs,
+                  ulong *             seed_szs,
+                  ulong               seeds_cnt,
+                  uchar *             bump_seed,
+                  fd_pubkey_t *       out ) {
+
+  int err = fd_vm_pda_check_seeds( vm, seed_szs, seeds_cnt, !!bump_seed );
+  if( FD_UNLIKELY( err ) ) return err;
+
+  fd_vm_pda_hash_seeds( vm->sha, seed_haddrs, seed_szs, seeds_cnt );
+  fd_vm_pda_hash_fini ( vm->sha, bump_seed, program_id, out );
 
   /* A PDA is valid if it is not a valid ed25519 curve point.
      In most cases the user will have derived the PDA off-chain, or the PDA is a known signer. */
@@ -266,12 +318,14 @@ fd_vm_syscall_sol_try_find_program_address( void *  _vm,
   /* Similar to create_program_address but appends a 1 byte nonce that
      decrements from 255 down to 1 until a valid PDA is found.
 
-     TODO: Solana Labs recomputes the SHA hash for each iteration here.  We
-     can leverage SHA's streaming properties to precompute all but the last
-     two blocks (1 data, 0 or 1 padding). PROBABLY NEED TO ADD CHECKPT / RESTORE
-     CALLS TO SHA TO SUPPORT THIS)*/
-
-  uchar bump_seed[1];
+     Solana Labs recomputes the SHA hash for each iteration here.  We
+     hash the seeds once and resume from that state for each bump seed
+     instead.  Roughly half of all candidate addresses are on the curve,
+     so the search typically ends after one or two bump seeds.  With
+     avx512 we derive candidates two at a time and check them with a
+     single 2-way square root (see FD_VM_PDA_CAND_MAX), then replay the
+     outcome of each bump seed in order, such that results and CU
+     charging are exactly those of the sequential search. */
 
   /* First we need to do the preflight checks */
   void const *        seed_haddrs[ FD_VM_PDA_SEEDS_MAX ];
@@ -291,43 +345,71 @@ fd_vm_syscall_sol_try_find_program_address( void *  _vm,
     return err;
   }
 
-  for( ulong i=0UL; i<255UL; i++ ) {
-    bump_seed[0] = (uchar)(255UL - i);
+  /* The seed checks of fd_vm_derive_pda give the same result for every
+     bump seed.  If they fail with INVALID_PDA (16 seeds), every bump
+     seed fails without hashing. */
+  err = fd_vm_pda_check_seeds( vm, seed_szs, seeds_cnt, 1 );
+  if( FD_UNLIKELY( err && err!=FD_VM_SYSCALL_ERR_INVALID_PDA ) ) return err;
+  int seeds_ok = !err;
+
+  fd_sha256_t * prefix = vm->sha;
+  if( FD_LIKELY( seeds_ok ) ) fd_vm_pda_hash_seeds( prefix, seed_haddrs, seed_szs, seeds_cnt );
+
+  for( ulong i=0UL; i<255UL; i+=FD_VM_PDA_CAND_MAX ) {
+    ulong cand_cnt = fd_ulong_min( 255UL-i, FD_VM_PDA_CAND_MAX );
+
+    uchar       bump_seed[ FD_VM_PDA_CAND_MAX ];
+    fd_pubkey_t derived  [ FD_VM_PDA_CAND_MAX ];
+    int         on_curve = (1<<FD_VM_PDA_CAND_MAX)-1; /* bit j set if candidate j is not a valid PDA */
+    for( ulong j=0UL; j<cand_cnt; j++ ) bump_seed[ j ] = (uchar)(255UL-i-j);
+
+    if( FD_LIKELY( seeds_ok ) ) {
+      for( ulong j=0UL; j<cand_cnt; j++ ) {
+        fd_sha256_t sha[1];
+        *sha = *prefix;
+        fd_vm_pda_hash_fini( sha, &bump_seed[ j ], program_id, &derived[ j ] );
+      }
+      /* A PDA is valid if it is not a valid ed25519 curve point */
+#     if FD_HAS_AVX512
+      if( FD_LIKELY( cand_cnt==2UL ) ) on_curve = fd_ed25519_point_validate_2x( derived[0].key, derived[1].key );
+      else                             on_curve = fd_ed25519_point_validate( derived[0].key );
+#     else
+      on_curve = fd_ed25519_point_validate( derived[0].key );
+#     endif
+    }
 
-    fd_pubkey_t derived[1];
-    err = fd_vm_derive_pda( vm, program_id, seed_haddrs, seed_szs, seeds_cnt, bump_seed, derived );
+    for( ulong j=0UL; j<cand_cnt; j++ ) {
 
-    /* Stop looking if we have found a valid PDA */
-    if( FD_LIKELY( err==FD_VM_SUCCESS ) ) {
+      /* Stop looking if we have found a valid PDA */
+      if( FD_LIKELY( !( on_curve & (1<<j) ) ) ) {
 
-      /* https://github.com/anza-xyz/agave/blob/v2.3.1/programs/bpf_loader/src/syscalls/mod.rs#L919-L924 */
-      fd_vm_haddr_query_t bump_seed_ref_query = {
-        .vaddr    = out_bump_seed_vaddr,
-        .align    = FD_VM_ALIGN_RUST_U8,
-        .sz       = 1UL,
-        .is_slice = 0,
-      };
+        /* https://github.com/anza-xyz/agave/blob/v2.3.1/programs/bpf_loader/src/syscalls/mod.rs#L919-L924 */
+        fd_vm_haddr_query_t bump_seed_ref_query = {
+          .vaddr    = out_bump_seed_vaddr,
+          .align    = FD_VM_ALIGN_RUST_U8,
+          .sz       = 1UL,
+          .is_slice = 0,
+        };
 
-      fd_vm_haddr_query_t address_query = {
-        .vaddr    = out_vaddr,
-        .align    = FD_VM_ALIGN_RUST_U8,
-        .sz       = FD_PUBKEY_FOOTPRINT,
-        .is_slice = 1,
-      };
+        fd_vm_haddr_query_t address_query = {
+          .vaddr    = out_vaddr,
+          .align    = FD_VM_ALIGN_RUST_U8,
+          .sz       = FD_PUBKEY_FOOTPRINT,
+          .is_slice = 1,
+        };
 
-      fd_vm_haddr_query_t * queries[] = { &bump_seed_ref_query, &address_query };
-      FD_VM_TRANSLATE_MUT( vm, queries );
+        fd_vm_haddr_query_t * queries[] = { &bump_seed_ref_query, &address_query };
+        FD_VM_TRANSLATE_MUT( vm, queries );
 
-      memcpy( address_query.haddr, derived->uc, sizeof(fd_pubkey_t) );
-      memcpy( bump_seed_ref_query.haddr, bump_seed, sizeof(uchar) );
+        memcpy( address_query.haddr, derived[ j ].uc, sizeof(fd_pubkey_t) );
+        memcpy( bump_seed_ref_query.haddr, &bump_seed[ j ], sizeof(uchar) );
 
-      *_ret = 0UL;
-      return FD_VM_SUCCESS;
-    } else if( FD_UNLIKELY( err!=FD_VM_SYSCALL_ERR_INVALID_PDA ) ) {
-      return err;
-    }
+        *_ret = 0UL;
+        return FD_VM_SUCCESS;
+      }
 
-    FD_VM_CU_UPDATE( vm, FD_VM_CREATE_PROGRAM_ADDRESS_UNITS );
+      FD_VM_CU_UPDATE( vm, FD_VM_CREATE_PROGRAM_ADDRESS_UNITS );
+    }
   }
 
   *_ret = 1UL;
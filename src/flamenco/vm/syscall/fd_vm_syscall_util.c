@@ -104,9 +104,7 @@ fd_vm_syscall_sol_log_64( void *  _vm,
 
   FD_VM_CU_UPDATE( vm, FD_VM_LOG_64_UNITS );
 
-  /* Max msg_sz: 46 - 15 + 16*5 = 111 < 127 => we can use printf */
-  fd_log_collector_printf_dangerous_max_127( vm->instr_ctx,
-    "Program log: 0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx", r1, r2, r3, r4, r5 );
+  fd_log_collector_program_log_64( vm->instr_ctx, r1, r2, r3, r4, r5 );
 
   *_ret = 0UL;
   return FD_VM_SUCCESS;
@@ -126,9 +124,7 @@ fd_vm_syscall_sol_log_compute_units( /**/            void *  _vm,
 
   FD_VM_CU_UPDATE( vm, FD_VM_SYSCALL_BASE_COST );
 
-  /* Max msg_sz: 40 - 3 + 20 = 57 < 127 => we can use printf */
-  fd_log_collector_printf_dangerous_max_127( vm->instr_ctx,
-    "Program consumption: %lu units remaining", vm->cu );
+  fd_log_collector_program_consumption( vm->instr_ctx, vm->cu );
 
   *_ret = 0UL;
   return FD_VM_SUCCESS;
@@ -150,12 +146,7 @@ fd_vm_syscall_sol_log_pubkey( /**/            void *  _vm,
 
   void const * pubkey = FD_VM_MEM_HADDR_LD( vm, pubkey_vaddr, FD_VM_ALIGN_RUST_PUBKEY, sizeof(fd_pubkey_t) );
 
-  char msg[ FD_BASE58_ENCODED_32_SZ ]; ulong msg_sz;
-  if( FD_UNLIKELY( fd_base58_encode_32( pubkey, &msg_sz, msg )==NULL ) ) {
-    return FD_VM_SYSCALL_ERR_INVALID_STRING;
-  }
-
-  fd_log_collector_program_log( vm->instr_ctx, msg, msg_sz );
+  fd_log_collector_program_log_pubkey( vm->instr_ctx, pubkey );
 
   *_ret = 0UL;
   return FD_VM_SUCCESS;
@@ -199,33 +190,29 @@ fd_vm_syscall_sol_log_data( /**/            void *  _vm,
 
   /* https://github.com/anza-xyz/agave/blob/v2.0.6/programs/bpf_loader/src/syscalls/logging.rs#L145-L152 */
 
-  ulong msg_sz = 14UL; /* "Program data: ", with space */
+  ulong msg_sz     = 14UL; /* "Program data: ", with space */
+  ulong payload_sz = 0UL;
   for( ulong i=0UL; i<slice_cnt; i++ ) {
     ulong cur_len = slice[i].len;
     /* This fails the syscall in case of memory mapping issues */
     FD_VM_MEM_SLICE_HADDR_LD( vm, slice[i].addr, FD_VM_ALIGN_RUST_U8, cur_len );
     /* Every buffer will be base64 encoded + space separated */
-    msg_sz += (slice[i].len + 2)/3*4 + (i > 0);
+    msg_sz     = fd_ulong_sat_add( msg_sz, (cur_len + 2)/3*4 + (i > 0) );
+    payload_sz = fd_ulong_sat_add( payload_sz, fd_log_collector_program_data_slice_sz( cur_len ) );
   }
 
-  /* https://github.com/anza-xyz/agave/blob/v2.0.6/programs/bpf_loader/src/syscalls/logging.rs#L156 */
+  /* https://github.com/anza-xyz/agave/blob/v2.0.6/programs/bpf_loader/src/syscalls/logging.rs#L156
 
-  char msg[ FD_LOG_COLLECTOR_MAX ];
-  ulong bytes_written = fd_log_collector_check_and_truncate( &vm->instr_ctx->txn_ctx->log_collector, msg_sz );
-  if( FD_LIKELY( bytes_written < ULONG_MAX ) ) {
-    fd_memcpy( msg, "Program data: ", 14 );
-    char * buf = msg + 14;
+     The slices are copied as is, base64 encoding is deferred until the
+     logs are rendered. */
 
+  uchar * buf = fd_log_collector_program_data_prepare( vm->instr_ctx, msg_sz, payload_sz );
+  if( FD_LIKELY( buf ) ) {
     for( ulong i=0UL; i<slice_cnt; i++ ) {
       ulong cur_len = slice[i].len;
       void const * bytes = FD_VM_MEM_SLICE_HADDR_LD( vm, slice[i].addr, FD_VM_ALIGN_RUST_U8, cur_len );
-
-      if( i ) { *buf = ' '; ++buf; } /* skip first */
-      buf += fd_base64_encode( buf, bytes, cur_len );
+      buf = fd_log_collector_program_data_slice( buf, bytes, cur_len );
     }
-    FD_TEST( (ulong)(buf-msg)==msg_sz );
-
-    fd_log_collector_msg( vm->instr_ctx, msg, msg_sz );
   }
 
   *_ret = 0;
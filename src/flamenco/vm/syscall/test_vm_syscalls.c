@@ -193,6 +193,77 @@ test_vm_syscall_sol_log_data( char const *            test_case_name,
   FD_LOG_NOTICE(( "Passed test program (%s)", test_case_name ));
 }
 
+/* test_vm_syscall_sol_try_find_program_address checks the bump seed
+   search against a sequential search with fd_vm_derive_pda, including
+   the CUs charged and the bump seed at which the CUs run out. */
+
+static void
+test_vm_syscall_sol_try_find_program_address( fd_vm_t *  vm,
+                                              fd_rng_t * rng,
+                                              ulong      seeds_cnt,
+                                              ulong      cu ) {
+  ulong const seeds_off = 0UL;    /* fd_vm_vec_t[ seeds_cnt ] */
+  ulong const data_off  = 512UL;  /* up to 32 bytes per seed */
+  ulong const prog_off  = 1024UL;
+  ulong const out_off   = 1056UL;
+  ulong const bump_off  = 1088UL;
+
+  void const * seed_haddrs[ FD_VM_PDA_SEEDS_MAX ];
+  ulong        seed_szs   [ FD_VM_PDA_SEEDS_MAX ];
+  for( ulong i=0UL; i<seeds_cnt; i++ ) {
+    ulong seed_sz = fd_rng_ulong_roll( rng, 33UL );
+    for( ulong j=0UL; j<seed_sz; j++ ) vm->heap[ data_off+32UL*i+j ] = fd_rng_uchar( rng );
+    fd_vm_vec_t seed = { .addr = FD_VM_MEM_MAP_HEAP_REGION_START+data_off+32UL*i, .len = seed_sz };
+    memcpy( &vm->heap[ seeds_off+i*sizeof(fd_vm_vec_t) ], &seed, sizeof(fd_vm_vec_t) );
+    seed_haddrs[ i ] = &vm->heap[ data_off+32UL*i ];
+    seed_szs   [ i ] = seed_sz;
+  }
+  for( ulong j=0UL; j<FD_PUBKEY_FOOTPRINT; j++ ) vm->heap[ prog_off+j ] = fd_rng_uchar( rng );
+  fd_pubkey_t const * program_id = (fd_pubkey_t const *)&vm->heap[ prog_off ];
+
+  /* Sequential search */
+  ulong       exp_cu   = cu;
+  int         exp_err  = FD_VM_SUCCESS;
+  ulong       exp_ret  = 1UL;
+  uchar       exp_bump = 0;
+  fd_pubkey_t exp_addr[1];
+  for( ulong i=0UL; i<=255UL; i++ ) {
+    if( exp_cu<FD_VM_CREATE_PROGRAM_ADDRESS_UNITS ) {
+      exp_cu  = 0UL;
+      exp_err = FD_VM_SYSCALL_ERR_COMPUTE_BUDGET_EXCEEDED;
+      break;
+    }
+    exp_cu -= FD_VM_CREATE_PROGRAM_ADDRESS_UNITS;
+    if( i==255UL ) break;
+    uchar bump_seed[1] = { (uchar)(255UL-i) };
+    int err = fd_vm_derive_pda( vm, program_id, seed_haddrs, seed_szs, seeds_cnt, bump_seed, exp_addr );
+    if( !err ) {
+      exp_ret  = 0UL;
+      exp_bump = bump_seed[0];
+      break;
+    }
+    FD_TEST( err==FD_VM_SYSCALL_ERR_INVALID_PDA );
+  }
+
+  memset( &vm->heap[ out_off ], 0, FD_PUBKEY_FOOTPRINT+8UL );
+  vm->cu = cu;
+  ulong ret = ULONG_MAX;
+  int   err = fd_vm_syscall_sol_try_find_program_address( vm,
+                                                          FD_VM_MEM_MAP_HEAP_REGION_START+seeds_off,
+                                                          seeds_cnt,
+                                                          FD_VM_MEM_MAP_HEAP_REGION_START+prog_off,
+                                                          FD_VM_MEM_MAP_HEAP_REGION_START+out_off,
+                                                          FD_VM_MEM_MAP_HEAP_REGION_START+bump_off,
+                                                          &ret );
+  FD_TEST( err==exp_err );
+  FD_TEST( vm->cu==exp_cu );
+  if( err ) return;
+  FD_TEST( ret==exp_ret );
+  if( ret ) return;
+  FD_TEST( vm->heap[ bump_off ]==exp_bump );
+  FD_TEST( fd_memeq( &vm->heap[ out_off ], exp_addr, FD_PUBKEY_FOOTPRINT ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -761,6 +832,15 @@ main( int     argc,
 
 # undef APPEND
 
+  for( ulong iter=0UL; iter<1024UL; iter++ ) {
+    ulong seeds_cnt = fd_rng_ulong_roll( rng, FD_VM_PDA_SEEDS_MAX );
+    ulong cu        = (iter&1UL) ? fd_rng_ulong_roll( rng, 8UL*FD_VM_CREATE_PROGRAM_ADDRESS_UNITS ) : FD_VM_COMPUTE_UNIT_LIMIT;
+    test_vm_syscall_sol_try_find_program_address( vm, rng, seeds_cnt, cu );
+  }
+  /* 16 seeds leave no room for the bump seed, so every bump seed fails */
+  test_vm_syscall_sol_try_find_program_address( vm, rng, FD_VM_PDA_SEEDS_MAX, FD_VM_COMPUTE_UNIT_LIMIT );
+  test_vm_syscall_sol_try_find_program_address( vm, rng, FD_VM_PDA_SEEDS_MAX, 100UL*FD_VM_CREATE_PROGRAM_ADDRESS_UNITS );
+
   fd_vm_delete    ( fd_vm_leave    ( vm  ) );
   fd_sha256_delete( fd_sha256_leave( sha ) );
   fd_rng_delete   ( fd_rng_leave   ( rng ) );
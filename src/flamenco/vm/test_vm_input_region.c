@@ -0,0 +1,389 @@
+#include "fd_vm_private.h"
+
+/* Tests and benchmarks the direct mapping input region lookup.  The
+   lookup with the input region index must give exactly the same
+   results as a binary search over all input memory regions.  Also
+   tests and benchmarks the input region dirty bitmap used without
+   direct mapping. */
+
+#define REGION_MAX (1024UL)
+
+static fd_vm_t              vm[1];
+static fd_vm_input_region_t regions[ REGION_MAX ];
+static uchar                input[ 1UL<<20 ] __attribute__((aligned(16UL)));
+
+#define BIG_SZ (10UL<<20) /* MAX_PERMITTED_DATA_LENGTH */
+
+static uchar big    [ BIG_SZ ] __attribute__((aligned(16UL))); /* serialized account data */
+static uchar big_acc[ BIG_SZ ] __attribute__((aligned(16UL))); /* account data */
+static ulong dirty  [ (BIG_SZ>>(FD_VM_INPUT_DIRTY_LG_CHUNK+6UL))+1UL ];
+
+/* ref_region_idx is the lookup without an input region index. */
+
+static ulong
+ref_region_idx( fd_vm_t const * vm,
+                ulong           offset ) {
+  uint left  = 0U;
+  uint right = vm->input_mem_regions_cnt - 1U;
+  while( left<right ) {
+    uint mid = (left+right) / 2U;
+    if( offset>=vm->input_mem_regions[ mid ].vaddr_offset+vm->input_mem_regions[ mid ].region_sz ) left = mid + 1U;
+    else                                                                                            right = mid;
+  }
+  return left;
+}
+
+static void
+vm_cfg( ulong region_cnt,
+        int   direct_mapping ) {
+  vm->input_mem_regions     = regions;
+  vm->input_mem_regions_cnt = (uint)region_cnt;
+  vm->direct_mapping        = direct_mapping;
+  fd_vm_mem_cfg( vm );
+}
+
+static ulong
+add_region( ulong region_cnt,
+            ulong region_sz,
+            uchar is_writable ) {
+  ulong vaddr_offset = region_cnt ? regions[ region_cnt-1UL ].vaddr_offset + regions[ region_cnt-1UL ].region_sz : 0UL;
+  regions[ region_cnt ] = (fd_vm_input_region_t){
+    .vaddr_offset = vaddr_offset,
+    .haddr        = (ulong)input + (vaddr_offset & ((sizeof(input)>>1)-1UL)),
+    .region_sz    = (uint)region_sz,
+    .is_writable  = is_writable
+  };
+  return region_cnt+1UL;
+}
+
+/* layout_accounts lays out the input region the way the BPF loader
+   serializer does with direct mapping, with a metadata region, a data
+   region and a resizing region per account.  Returns the number of
+   regions. */
+
+static ulong
+layout_accounts( fd_rng_t * rng,
+                 ulong      acct_cnt,
+                 ulong      data_sz_max ) {
+  ulong region_cnt = 0UL;
+  for( ulong i=0UL; i<acct_cnt; i++ ) {
+    ulong data_sz = fd_rng_ulong_roll( rng, data_sz_max+1UL );
+    region_cnt = add_region( region_cnt, 96UL,                (uchar)0 );
+    if( data_sz ) region_cnt = add_region( region_cnt, data_sz, (uchar)fd_rng_uint_roll( rng, 2U ) );
+    region_cnt = add_region( region_cnt, 10240UL+fd_rng_ulong_roll( rng, 8UL ), (uchar)1 );
+  }
+  return add_region( region_cnt, 64UL, (uchar)0 ); /* instruction data and program id */
+}
+
+static ulong
+input_sz( ulong region_cnt ) {
+  return regions[ region_cnt-1UL ].vaddr_offset + regions[ region_cnt-1UL ].region_sz;
+}
+
+static void
+test_equivalence( fd_rng_t * rng ) {
+  for( ulong iter=0UL; iter<2000UL; iter++ ) {
+
+    /* Random layouts, including empty regions and regions much larger
+       than a bucket */
+
+    ulong region_cnt = 1UL + fd_rng_ulong_roll( rng, REGION_MAX );
+    ulong sz_lg_max  = fd_rng_ulong_roll( rng, 25UL );
+    for( ulong r=0UL; r<region_cnt; r++ ) {
+      ulong sz = fd_rng_uint_roll( rng, 8U ) ? fd_rng_ulong_roll( rng, (1UL<<fd_rng_ulong_roll( rng, sz_lg_max+1UL ))+1UL ) : 0UL;
+      add_region( r, sz, (uchar)1 );
+    }
+    vm_cfg( region_cnt, 1 );
+    ulong sz = input_sz( region_cnt );
+    if( region_cnt>=FD_VM_INPUT_REGION_IDX_MIN_CNT ) {
+      FD_TEST( vm->input_region_idx_cnt );
+      FD_TEST( vm->input_region_idx_cnt<=FD_VM_INPUT_REGION_IDX_MAX );
+      FD_TEST( ((ulong)vm->input_region_idx_cnt<<vm->input_region_idx_lg_sz)>sz );
+    } else {
+      FD_TEST( !vm->input_region_idx_cnt );
+    }
+
+    /* Every region boundary, random offsets and offsets past the end
+       of the input region */
+
+    for( ulong r=0UL; r<region_cnt; r++ ) {
+      ulong off = regions[ r ].vaddr_offset;
+      for( ulong d=0UL; d<3UL; d++ ) {
+        ulong o = off+d-1UL;
+        FD_TEST( fd_vm_get_input_mem_region_idx( vm, o )==ref_region_idx( vm, o ) );
+      }
+    }
+    for( ulong j=0UL; j<1000UL; j++ ) {
+      ulong o = fd_rng_ulong_roll( rng, sz+2UL );
+      FD_TEST( fd_vm_get_input_mem_region_idx( vm, o )==ref_region_idx( vm, o ) );
+    }
+    for( ulong j=0UL; j<16UL; j++ ) {
+      ulong o = fd_rng_ulong( rng ) >> fd_rng_uint_roll( rng, 64U );
+      FD_TEST( fd_vm_get_input_mem_region_idx( vm, o )==ref_region_idx( vm, o ) );
+    }
+  }
+
+  /* The index is not used without direct mapping */
+
+  ulong region_cnt = layout_accounts( rng, 64UL, 1024UL );
+  vm_cfg( region_cnt, 0 );
+  FD_TEST( !vm->input_region_idx_cnt );
+  vm_cfg( region_cnt, 1 );
+  FD_TEST( vm->input_region_idx_cnt );
+}
+
+/* test_dirty checks that input region writes, and only those, mark
+   the dirty bitmap and that fd_vm_input_dirty_find walks exactly the
+   dirty chunks. */
+
+static void
+test_dirty( fd_rng_t * rng ) {
+  ulong const sz        = sizeof(input);
+  ulong const chunk_cnt = sz >> FD_VM_INPUT_DIRTY_LG_CHUNK;
+  static uchar ref[ sizeof(input) >> FD_VM_INPUT_DIRTY_LG_CHUNK ];
+
+  FD_TEST( fd_vm_input_dirty_footprint( 0UL )==0UL );
+  FD_TEST( fd_vm_input_dirty_footprint( 1UL )==8UL );
+  FD_TEST( fd_vm_input_dirty_footprint( 4096UL )==8UL );
+  FD_TEST( fd_vm_input_dirty_footprint( 4097UL )==16UL );
+  FD_TEST( fd_vm_input_dirty_footprint( sz )<=sizeof(dirty) );
+
+  for( ulong iter=0UL; iter<100UL; iter++ ) {
+    ulong region_cnt = add_region( 0UL, sz, (uchar)1 );
+    vm_cfg( region_cnt, 0 );
+    memset( dirty, 0, fd_vm_input_dirty_footprint( sz ) );
+    memset( ref,   0, sizeof(ref) );
+    vm->input_dirty = dirty;
+
+    ulong op_cnt = fd_rng_ulong_roll( rng, 256UL );
+    for( ulong op=0UL; op<op_cnt; op++ ) {
+      ulong r     = fd_rng_ulong_roll( rng, 16UL );
+      ulong acc_sz = r<12UL ? (1UL<<fd_rng_ulong_roll( rng, 4UL )) : 1UL+fd_rng_ulong_roll( rng, 65536UL );
+      ulong off   = fd_rng_ulong_roll( rng, sz+64UL );
+      uchar write = (uchar)(r&1UL);
+      uchar is_multi = 0;
+      ulong haddr = fd_vm_mem_haddr( vm, FD_VM_MEM_MAP_INPUT_REGION_START+off, acc_sz, vm->region_haddr, vm->region_st_sz, write, 0UL, &is_multi );
+      if( off+acc_sz<=sz ) {
+        FD_TEST( haddr==(ulong)input+off );
+        if( write ) {
+          for( ulong c=off>>FD_VM_INPUT_DIRTY_LG_CHUNK; c<=(off+acc_sz-1UL)>>FD_VM_INPUT_DIRTY_LG_CHUNK; c++ ) ref[ c ] = 1;
+        }
+      } else {
+        FD_TEST( !haddr );
+      }
+    }
+    for( ulong c=0UL; c<chunk_cnt; c++ ) FD_TEST( ((dirty[ c>>6 ]>>(c&63UL))&1UL)==(ulong)ref[ c ] );
+
+    /* Walk the dirty ranges of random byte ranges */
+
+    for( ulong j=0UL; j<64UL; j++ ) {
+      ulong off = fd_rng_ulong_roll( rng, sz+1UL );
+      ulong end = off + fd_rng_ulong_roll( rng, sz-off+1UL );
+      ulong cur = off;
+      ulong lo  = fd_vm_input_dirty_find( dirty, off, end, 1 );
+      while( lo<end ) {
+        FD_TEST( lo>=cur );
+        for( ulong b=cur; b<lo; b++ ) FD_TEST( !ref[ b>>FD_VM_INPUT_DIRTY_LG_CHUNK ] );
+        ulong hi = fd_vm_input_dirty_find( dirty, lo, end, 0 );
+        FD_TEST( hi>lo && hi<=end );
+        for( ulong b=lo; b<hi; b++ ) FD_TEST( ref[ b>>FD_VM_INPUT_DIRTY_LG_CHUNK ] );
+        FD_TEST( hi==end || !ref[ hi>>FD_VM_INPUT_DIRTY_LG_CHUNK ] );
+        cur = hi;
+        lo  = fd_vm_input_dirty_find( dirty, hi, end, 1 );
+      }
+      for( ulong b=cur; b<end; b++ ) FD_TEST( !ref[ b>>FD_VM_INPUT_DIRTY_LG_CHUNK ] );
+    }
+  }
+
+  /* Large marks */
+
+  memset( dirty, 0, sizeof(dirty) );
+  fd_vm_input_dirty_mark( dirty, 100UL, 0UL );
+  FD_TEST( fd_vm_input_dirty_find( dirty, 0UL, BIG_SZ, 1 )==BIG_SZ );
+  fd_vm_input_dirty_mark( dirty, 1000UL, BIG_SZ-2000UL );
+  FD_TEST( fd_vm_input_dirty_find( dirty, 0UL,  BIG_SZ, 1 )==960UL );
+  FD_TEST( fd_vm_input_dirty_find( dirty, 960UL, BIG_SZ, 0 )==fd_ulong_align_up( BIG_SZ-1000UL, 64UL ) );
+
+  vm->input_dirty = NULL;
+}
+
+/* bench_dirty models a program that reads a large account but only
+   writes a few words of it.  Reports the cost of copying out (writable
+   account) and comparing (read-only account) the serialized data in
+   full and only the dirty chunks, and the cost of tracking stores. */
+
+static void
+bench_dirty( fd_rng_t * rng,
+             ulong      data_sz,
+             ulong      st_cnt ) {
+  ulong region_cnt = 0UL;
+  regions[ region_cnt++ ] = (fd_vm_input_region_t){ .vaddr_offset = 0UL, .haddr = (ulong)big, .region_sz = (uint)data_sz, .is_writable = 1 };
+  vm_cfg( region_cnt, 0 );
+  memset( dirty, 0, fd_vm_input_dirty_footprint( data_sz ) );
+  vm->input_dirty = dirty;
+
+  static ulong vaddr[ 4096UL ];
+  for( ulong i=0UL; i<4096UL; i++ ) vaddr[ i ] = FD_VM_MEM_MAP_INPUT_REGION_START + fd_rng_ulong_roll( rng, data_sz-8UL );
+
+  for( ulong i=0UL; i<st_cnt; i++ ) {
+    uchar is_multi = 0;
+    ulong haddr = fd_vm_mem_haddr( vm, vaddr[ i ], 8UL, vm->region_haddr, vm->region_st_sz, 1, 0UL, &is_multi );
+    FD_TEST( haddr );
+    FD_STORE( ulong, haddr, fd_rng_ulong( rng ) );
+  }
+
+  ulong iter_cnt = fd_ulong_max( 4UL, (256UL<<20)/data_sz );
+  fd_memcpy( big_acc, big, data_sz ); /* warm up */
+
+  long dt_full = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_memcpy( big_acc, big, data_sz );
+    FD_COMPILER_MFENCE();
+  }
+  dt_full += fd_log_wallclock();
+
+  long dt_full_cmp = -fd_log_wallclock();
+  int  differs     = 0;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    differs |= !!memcmp( big_acc, big, data_sz );
+    FD_COMPILER_MFENCE();
+  }
+  dt_full_cmp += fd_log_wallclock();
+  FD_TEST( !differs );
+
+  long dt_dirty = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong lo = fd_vm_input_dirty_find( dirty, 0UL, data_sz, 1 );
+    while( lo<data_sz ) {
+      ulong hi = fd_vm_input_dirty_find( dirty, lo, data_sz, 0 );
+      fd_memcpy( big_acc+lo, big+lo, hi-lo );
+      lo = fd_vm_input_dirty_find( dirty, hi, data_sz, 1 );
+    }
+    FD_COMPILER_MFENCE();
+  }
+  dt_dirty += fd_log_wallclock();
+
+  long dt_dirty_cmp = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong lo = fd_vm_input_dirty_find( dirty, 0UL, data_sz, 1 );
+    while( lo<data_sz ) {
+      ulong hi = fd_vm_input_dirty_find( dirty, lo, data_sz, 0 );
+      differs |= !!memcmp( big_acc+lo, big+lo, hi-lo );
+      lo = fd_vm_input_dirty_find( dirty, hi, data_sz, 1 );
+    }
+    FD_COMPILER_MFENCE();
+  }
+  dt_dirty_cmp += fd_log_wallclock();
+  FD_TEST( !differs );
+
+  /* Store translation with and without tracking */
+
+  ulong st_iter = 1000UL;
+  ulong sum     = 0UL;
+  long  dt_st[2];
+  for( int track=0; track<2; track++ ) {
+    vm->input_dirty = track ? dirty : NULL;
+    dt_st[ track ] = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<st_iter; iter++ ) {
+      for( ulong i=0UL; i<4096UL; i++ ) {
+        uchar is_multi = 0;
+        sum += fd_vm_mem_haddr( vm, vaddr[ i ], 8UL, vm->region_haddr, vm->region_st_sz, 1, 0UL, &is_multi );
+      }
+      FD_COMPILER_FORGET( sum );
+    }
+    dt_st[ track ] += fd_log_wallclock();
+  }
+  vm->input_dirty = NULL;
+
+  FD_LOG_NOTICE(( "%8lu byte account, %3lu stores: copy out full %9.1f us, dirty %6.2f us; "
+                  "compare full %9.1f us, dirty %6.2f us; store %.2f ns untracked, %.2f ns tracked",
+                  data_sz, st_cnt,
+                  (double)dt_full     /(double)iter_cnt*1e-3, (double)dt_dirty    /(double)iter_cnt*1e-3,
+                  (double)dt_full_cmp /(double)iter_cnt*1e-3, (double)dt_dirty_cmp/(double)iter_cnt*1e-3,
+                  (double)dt_st[0]/(double)(st_iter*4096UL), (double)dt_st[1]/(double)(st_iter*4096UL) ));
+}
+
+static void
+bench( fd_rng_t * rng,
+       ulong      acct_cnt,
+       ulong      data_sz_max ) {
+  ulong region_cnt = layout_accounts( rng, acct_cnt, data_sz_max );
+  ulong sz         = input_sz( region_cnt );
+
+  static ulong vaddr[ 4096UL ];
+  for( ulong i=0UL; i<4096UL; i++ ) vaddr[ i ] = FD_VM_MEM_MAP_INPUT_REGION_START + fd_rng_ulong_roll( rng, sz-8UL );
+
+  ulong iter_cnt = 1000UL;
+  ulong sum      = 0UL;
+
+  /* Baseline: binary search over all regions */
+
+  vm_cfg( region_cnt, 1 );
+  vm->input_region_idx_cnt = 0U;
+  long dt_ref = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    for( ulong i=0UL; i<4096UL; i++ ) {
+      uchar is_multi = 0;
+      sum += fd_vm_mem_haddr( vm, vaddr[ i ], 8UL, vm->region_haddr, vm->region_ld_sz, 0, 0UL, &is_multi );
+    }
+    FD_COMPILER_FORGET( sum );
+  }
+  dt_ref += fd_log_wallclock();
+
+  /* With the input region index */
+
+  vm_cfg( region_cnt, 1 );
+  FD_TEST( vm->input_region_idx_cnt );
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    for( ulong i=0UL; i<4096UL; i++ ) {
+      uchar is_multi = 0;
+      sum -= fd_vm_mem_haddr( vm, vaddr[ i ], 8UL, vm->region_haddr, vm->region_ld_sz, 0, 0UL, &is_multi );
+    }
+    FD_COMPILER_FORGET( sum );
+  }
+  dt += fd_log_wallclock();
+  FD_TEST( !sum );
+
+  /* Cost of building the index */
+
+  long dt_cfg = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_vm_mem_cfg( vm );
+    FD_COMPILER_MFENCE();
+  }
+  dt_cfg += fd_log_wallclock();
+
+  ulong load_cnt = iter_cnt*4096UL;
+  FD_LOG_NOTICE(( "%4lu accounts (%4lu regions, %8lu bytes, bucket %5lu bytes): "
+                  "binary search %.2f ns/load, indexed %.2f ns/load, index build %.2f ns",
+                  acct_cnt, region_cnt, sz, 1UL<<vm->input_region_idx_lg_sz,
+                  (double)dt_ref/(double)load_cnt, (double)dt/(double)load_cnt, (double)dt_cfg/(double)iter_cnt ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_equivalence( rng );
+  test_dirty( rng );
+
+  bench( rng,  64UL,     165UL ); /* e.g. token accounts */
+  bench( rng,  64UL,   10240UL );
+  bench( rng, 128UL,    1024UL );
+  bench( rng, 255UL,    1024UL );
+  bench( rng, 255UL, 1UL<<20   );
+
+  bench_dirty( rng,   1UL<<20,   16UL ); /* e.g. oracle price update */
+  bench_dirty( rng,   4UL<<20,   64UL ); /* e.g. orderbook */
+  bench_dirty( rng,  BIG_SZ,    256UL );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
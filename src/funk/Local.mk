@@ -11,6 +11,7 @@ $(call make-unit-test,test_funk_concur2,test_funk_concur2,fd_funk fd_util)
 #$(call run-unit-test,test_funk_concur2,)
 $(call make-unit-test,test_funk_rec,test_funk_rec test_funk_common,fd_funk fd_util)
 $(call run-unit-test,test_funk_rec,)
+$(call run-unit-test,test_funk_rec,--rec-index 1)
 $(call make-unit-test,test_funk_txn,test_funk_txn test_funk_common,fd_funk fd_util)
 $(call run-unit-test,test_funk_txn,)
 $(call make-unit-test,test_funk_val,test_funk_val test_funk_common,fd_funk fd_util)
@@ -19,5 +20,7 @@ ifdef FD_HAS_HOSTED
 $(call make-unit-test,test_funk_txn2,test_funk_txn2,fd_funk fd_util)
 $(call run-unit-test,test_funk_txn2,)
 $(call make-unit-test,bench_funk_index,bench_funk_index,fd_funk fd_util)
+$(call make-unit-test,bench_funk_query,bench_funk_query,fd_funk fd_util)
+$(call make-unit-test,bench_funk_workload,bench_funk_workload,fd_funk fd_util)
 endif
 endif
@@ -29,14 +29,13 @@ run_benchmark( fd_funk_t * funk,
 static void
 stat_chains( fd_funk_t * funk ) {
   fd_funk_rec_map_t * rec_map = fd_funk_rec_map( funk );
-  fd_funk_rec_map_shmem_private_chain_t * chain_tbl = fd_funk_rec_map_shmem_private_chain( rec_map->map, 0UL );
   ulong chain_cnt = fd_funk_rec_map_chain_cnt( rec_map );
 
   double sum = 0.0;
   ulong min = ULONG_MAX;
   ulong max = 0UL;
   for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ ) {
-    ulong chain_len = fd_funk_rec_map_private_vcnt_cnt( chain_tbl[ chain_idx ].ver_cnt );
+    ulong chain_len = fd_funk_rec_map_private_vcnt_cnt( fd_funk_rec_map_shmem_private_chain_idx( rec_map->map, chain_idx )->ver_cnt );
     sum += (double)chain_len;
     min = fd_ulong_min( min, chain_len );
     max = fd_ulong_max( max, chain_len );
@@ -44,7 +43,7 @@ stat_chains( fd_funk_t * funk ) {
   double mean = sum / (double)chain_cnt;
   double var = 0.0;
   for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ ) {
-    double diff = (double)fd_funk_rec_map_private_vcnt_cnt( chain_tbl[ chain_idx ].ver_cnt ) - mean;
+    double diff = (double)fd_funk_rec_map_private_vcnt_cnt( fd_funk_rec_map_shmem_private_chain_idx( rec_map->map, chain_idx )->ver_cnt ) - mean;
     var += diff*diff;
   }
   var /= (double)chain_cnt;
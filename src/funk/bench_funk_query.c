@@ -0,0 +1,152 @@
+#include "fd_funk.h"
+#include "fd_funk_base.h"
+
+/* bench_funk_query measures fd_funk_rec_query_try_global from the tip
+   of a deep fork.  The fork is a chain of --depth in-prep transactions
+   where every transaction also has a dead end sibling.  Each
+   transaction (including the dead ends) writes --hot-cnt hot keys, so
+   a hot key has 2*depth versions on its hash chain, only half of which
+   are visible from the tip.  --cold-cnt cold keys only exist in the
+   last published transaction.  Lookups of the hot and cold keys are
+   timed separately.  --bucket 1 uses the bucketed record index. */
+
+#define FUNK_TAG 1UL
+
+static void
+insert( fd_funk_t *       funk,
+        fd_funk_txn_t *   txn,
+        fd_funk_rec_key_t key ) {
+  fd_funk_rec_prepare_t prepare[1];
+  int err = 0;
+  fd_funk_rec_t * rec = fd_funk_rec_prepare( funk, txn, &key, prepare, &err );
+  if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_prepare failed (%i-%s)", err, fd_funk_strerror( err ) ));
+  FD_TEST( fd_funk_val_truncate( rec, fd_funk_alloc( funk ), fd_funk_wksp( funk ), 0UL, 8UL, NULL ) );
+  fd_funk_rec_publish( funk, prepare );
+}
+
+static fd_funk_rec_key_t
+key_hot( ulong i ) {
+  fd_funk_rec_key_t key = {0};
+  key.ul[ 0 ] = fd_ulong_hash( i );
+  key.ul[ 1 ] = 1UL;
+  return key;
+}
+
+static fd_funk_rec_key_t
+key_cold( ulong i ) {
+  fd_funk_rec_key_t key = {0};
+  key.ul[ 0 ] = fd_ulong_hash( i );
+  key.ul[ 1 ] = 2UL;
+  return key;
+}
+
+__attribute__((noinline)) static ulong
+run_queries( fd_funk_t *     funk,
+             fd_funk_txn_t * tip,
+             fd_rng_t *      rng,
+             ulong           key_cnt,
+             int             hot,
+             ulong           iter_cnt ) {
+  ulong found = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong i = fd_rng_ulong_roll( rng, key_cnt );
+    fd_funk_rec_key_t key = hot ? key_hot( i ) : key_cold( i );
+    fd_funk_rec_query_t query[1];
+    fd_funk_txn_t const * txn_out = NULL;
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try_global( funk, tip, &key, &txn_out, query );
+    found += !!rec;
+    FD_COMPILER_FORGET( rec );
+  }
+  return found;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * name      = fd_env_strip_cmdline_cstr ( &argc, &argv, "--wksp",      NULL,            NULL );
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        depth     = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",     NULL,           256UL );
+  ulong        hot_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--hot-cnt",   NULL,            16UL );
+  ulong        cold_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--cold-cnt",  NULL,        262144UL );
+  ulong        iter_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt",  NULL,       1048576UL );
+  uint         rng_seed  = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed",  NULL,            1234U );
+  ulong        funk_seed = fd_env_strip_cmdline_ulong( &argc, &argv, "--funk-seed", NULL,          1234UL );
+  int          bucket    = fd_env_strip_cmdline_int  ( &argc, &argv, "--bucket",    NULL,               0 );
+
+  if( FD_UNLIKELY( !depth || !hot_cnt || !cold_cnt ) ) FD_LOG_ERR(( "--depth, --hot-cnt and --cold-cnt must be positive" ));
+
+  ulong txn_max = 2UL*depth;
+  ulong rec_max = cold_cnt + (txn_max+1UL)*hot_cnt;
+
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, rng_seed, 0UL ) );
+
+  fd_wksp_t * wksp;
+  if( name ) {
+    FD_LOG_NOTICE(( "Attaching to --wksp %s", name ));
+    wksp = fd_wksp_attach( name );
+  } else {
+    FD_LOG_NOTICE(( "--wksp not specified, using an anonymous local workspace, --page-sz %s, --page-cnt %lu, --near-cpu %lu",
+                    _page_sz, page_cnt, near_cpu ));
+    wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  }
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
+
+  int rec_index = bucket ? FD_FUNK_REC_INDEX_BUCKET : FD_FUNK_REC_INDEX_CHAIN;
+  void * funk_mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint_ext( txn_max, rec_max, rec_index ), FUNK_TAG );
+  if( FD_UNLIKELY( !funk_mem ) ) FD_LOG_ERR(( "failed to allocate funk" ));
+  fd_funk_t funk_[1];
+  fd_funk_t * funk = fd_funk_join( funk_, fd_funk_new_ext( funk_mem, FUNK_TAG, funk_seed, txn_max, rec_max, rec_index ) );
+  FD_TEST( funk );
+
+  FD_LOG_NOTICE(( "Populating (--depth %lu --hot-cnt %lu --cold-cnt %lu --bucket %i)", depth, hot_cnt, cold_cnt, bucket ));
+
+  for( ulong i=0UL; i<cold_cnt; i++ ) insert( funk, NULL, key_cold( i ) );
+  for( ulong i=0UL; i<hot_cnt;  i++ ) insert( funk, NULL, key_hot ( i ) );
+
+  fd_funk_txn_t * tip = NULL;
+  for( ulong d=0UL; d<depth; d++ ) {
+    fd_funk_txn_xid_t xid[1];
+
+    xid[0] = fd_funk_generate_xid();
+    fd_funk_txn_t * dead_end = fd_funk_txn_prepare( funk, tip, xid, 0 );
+    FD_TEST( dead_end );
+    for( ulong i=0UL; i<hot_cnt; i++ ) insert( funk, dead_end, key_hot( i ) );
+
+    xid[0] = fd_funk_generate_xid();
+    tip = fd_funk_txn_prepare( funk, tip, xid, 0 );
+    FD_TEST( tip );
+    for( ulong i=0UL; i<hot_cnt; i++ ) insert( funk, tip, key_hot( i ) );
+  }
+
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Warm up and sanity check */
+
+  FD_TEST( run_queries( funk, tip, rng, hot_cnt,  1, hot_cnt  )==hot_cnt  );
+  FD_TEST( run_queries( funk, tip, rng, cold_cnt, 0, cold_cnt )==cold_cnt );
+
+  for( int hot=1; hot>=0; hot-- ) {
+    ulong key_cnt = hot ? hot_cnt : cold_cnt;
+    long dt = -fd_log_wallclock();
+    ulong found = run_queries( funk, tip, rng, key_cnt, hot, iter_cnt );
+    dt += fd_log_wallclock();
+    FD_TEST( found==iter_cnt );
+    FD_LOG_NOTICE(( "%s key query_try_global from depth %lu: %.1f ns/query",
+                    hot ? "hot " : "cold", depth, (double)dt/(double)iter_cnt ));
+  }
+
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( funk_mem ) );
+  if( name ) fd_wksp_detach( wksp );
+  else       fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
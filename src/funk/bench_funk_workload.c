@@ -0,0 +1,526 @@
+#include "fd_funk.h"
+#include "fd_funk_base.h"
+#include <math.h>
+
+/* bench_funk_workload runs funk under an access pattern shaped like
+   replay.  The main tile plays the replay tile, every other tile
+   (--tile-cpus) plays an exec tile.
+
+   - --key-cnt accounts of --val-sz bytes are created in the root.
+     Reads and modifies choose accounts with a scrambled Zipfian
+     distribution of exponent --zipf-theta in [0,1) (0 is uniform), so
+     hot accounts are scattered over the hash chains.
+
+   - Each slot is a funk txn that is a child of the previous slot, or
+     with probability --fork-pct, a sibling of it (the previous slot
+     becomes a dead fork).  Every --publish-every slots, the ancestor
+     --fork-depth levels above the tip is published under the
+     fd_funk_txn_start_write lock, while the exec tiles are executing
+     the tip.  This also cancels the dead forks below it.
+
+   - A slot executes --slot-ops ops, split between reads (query global
+     and read the value), modifies (clone into the slot, then modify),
+     inserts of new accounts and erases of uniformly chosen accounts.
+     The mix is given by --read-pct, --modify-pct and --insert-pct,
+     erases are the remainder.  Like the replay scheduler, ops on the same account in a
+     slot are all given to the same exec tile, so a hot account
+     serializes on one tile.
+
+   Op streams only depend on --rng-seed (the interleaving of the exec
+   tiles does not).  Reports the op throughput, per op latency
+   percentiles (exec tiles, excluding scheduling), the latency of
+   publishes (including waiting for the write lock) and the memory used
+   by funk.  --bucket 1 uses the bucketed record index.  E.g.
+
+     bench_funk_workload --page-sz normal --page-cnt 1000000 --tile-cpus f5 */
+
+#define FUNK_TAG (1UL)
+#define OPS_TAG  (2UL)
+#define TILE_MAX (64UL)
+
+#define OP_READ   (0)
+#define OP_MODIFY (1)
+#define OP_INSERT (2)
+#define OP_ERASE  (3)
+#define OP_CNT    (4)
+
+static char const * op_name[ OP_CNT ] = { "read  ", "modify", "insert", "erase " };
+
+struct op {
+  ulong key_idx; /* account index, inserts use indices >= key_cnt */
+  ulong type;    /* OP_* */
+};
+
+typedef struct op op_t;
+
+/* Latency histogram.  Bucket b<8 holds b ticks.  Above that, each
+   power of 2 is split in 8 linear buckets (12.5% resolution). */
+
+#define LAT_BUCKET_CNT (496UL)
+
+static inline ulong
+lat_bucket( ulong ticks ) {
+  if( ticks<8UL ) return ticks;
+  int msb = fd_ulong_find_msb( ticks );
+  return (ulong)(msb-2)*8UL + ((ticks>>(msb-3)) & 7UL);
+}
+
+static inline ulong
+lat_bucket_lo( ulong b ) {
+  if( b<8UL ) return b;
+  ulong msb = b/8UL + 2UL;
+  return (8UL + (b & 7UL))<<(msb-3UL);
+}
+
+struct __attribute__((aligned(128))) exec_stat {
+  ulong op_cnt  [ OP_CNT ];
+  ulong miss_cnt[ OP_CNT ];
+  ulong tick_sum[ OP_CNT ];
+  ulong tick_max[ OP_CNT ];
+  ulong lat     [ OP_CNT ][ LAT_BUCKET_CNT ];
+};
+
+typedef struct exec_stat exec_stat_t;
+
+/* Zipfian sampler (Gray et al, "Quickly generating billion-record
+   synthetic databases", as used by YCSB).  O(n) setup, O(1) sample. */
+
+struct zipf {
+  ulong  n;
+  double theta;
+  double alpha;
+  double zetan;
+  double eta;
+  double zeta2_thresh;
+};
+
+typedef struct zipf zipf_t;
+
+static void
+zipf_init( zipf_t * z,
+           ulong    n,
+           double   theta ) {
+  double zetan = 0.0;
+  for( ulong i=1UL; i<=n; i++ ) zetan += 1.0/pow( (double)i, theta );
+  double zeta2 = 1.0 + pow( 0.5, theta );
+  z->n            = n;
+  z->theta        = theta;
+  z->alpha        = 1.0/(1.0-theta);
+  z->zetan        = zetan;
+  z->eta          = (1.0-pow( 2.0/(double)n, 1.0-theta ))/(1.0-zeta2/zetan);
+  z->zeta2_thresh = zeta2;
+}
+
+static ulong
+zipf_sample( zipf_t const * z,
+             fd_rng_t *     rng ) {
+  if( z->theta==0.0 ) return fd_rng_ulong_roll( rng, z->n );
+  double u  = fd_rng_double_o( rng );
+  double uz = u*z->zetan;
+  ulong  r;
+  if     ( uz<1.0             ) r = 0UL;
+  else if( uz<z->zeta2_thresh ) r = 1UL;
+  else                          r = (ulong)( (double)z->n * pow( z->eta*u - z->eta + 1.0, z->alpha ) );
+  /* Scramble ranks so hot accounts do not share a hash chain */
+  return fd_ulong_hash( fd_ulong_min( r, z->n-1UL ) ) % z->n;
+}
+
+/* State shared by the tiles */
+
+static fd_funk_t *   funk;
+static ulong         val_sz;
+static ulong         exec_cnt;
+static op_t *        exec_ops   [ TILE_MAX ];
+static ulong         exec_op_cnt[ TILE_MAX ];
+static exec_stat_t   exec_stat  [ TILE_MAX ];
+static ulong volatile slot_seq;  /* slot to execute, ULONG_MAX to halt */
+static ulong volatile done_cnt;  /* exec tiles done with slot_seq */
+
+static fd_funk_rec_key_t
+acc_key( ulong key_idx ) {
+  fd_funk_rec_key_t key = {0};
+  key.ul[ 0 ] = fd_ulong_hash( key_idx );
+  key.ul[ 1 ] = key_idx;
+  return key;
+}
+
+static fd_funk_txn_xid_t
+slot_xid( ulong slot ) {
+  fd_funk_txn_xid_t xid = { .ul = { slot, slot } };
+  return xid;
+}
+
+/* exec_op runs op on txn.  Returns 1 if the account was found (or
+   created) and 0 otherwise. */
+
+static inline int
+exec_op( fd_funk_txn_t * txn,
+         op_t const *    op,
+         ulong           slot ) {
+  fd_wksp_t *       wksp = fd_funk_wksp( funk );
+  fd_funk_rec_key_t key  = acc_key( op->key_idx );
+
+  switch( op->type ) {
+
+  case OP_READ: {
+    for(;;) {
+      fd_funk_rec_query_t   query[1];
+      fd_funk_rec_t const * rec = fd_funk_rec_query_try_global( funk, txn, &key, NULL, query );
+      if( FD_UNLIKELY( !rec || (rec->flags & FD_FUNK_REC_FLAG_ERASE) ) ) return 0;
+      ulong val = FD_LOAD( ulong, fd_funk_val( rec, wksp ) );
+      FD_COMPILER_FORGET( val );
+      if( FD_LIKELY( fd_funk_rec_query_test( query )==FD_FUNK_SUCCESS ) ) return 1;
+    }
+  }
+
+  case OP_MODIFY: {
+    fd_funk_rec_try_clone_safe( funk, txn, &key, alignof(ulong), val_sz );
+    fd_funk_rec_query_t query[1];
+    fd_funk_rec_t *     rec = fd_funk_rec_modify( funk, txn, &key, query );
+    if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_modify failed" ));
+    int found = !(rec->flags & FD_FUNK_REC_FLAG_ERASE); /* erased earlier in this slot */
+    if( FD_LIKELY( found ) ) {
+      ulong * val = fd_funk_val( rec, wksp );
+      FD_STORE( ulong, val, FD_LOAD( ulong, val )+1UL );
+    }
+    fd_funk_rec_modify_publish( query );
+    return found;
+  }
+
+  case OP_INSERT: {
+    fd_funk_rec_prepare_t prepare[1];
+    int err = 0;
+    fd_funk_rec_t * rec = fd_funk_rec_prepare( funk, txn, &key, prepare, &err );
+    if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_prepare failed (%i-%s)", err, fd_funk_strerror( err ) ));
+    void * val = fd_funk_val_truncate( rec, fd_funk_alloc( funk ), wksp, alignof(ulong), val_sz, &err );
+    if( FD_UNLIKELY( !val ) ) FD_LOG_ERR(( "fd_funk_val_truncate failed (%i-%s)", err, fd_funk_strerror( err ) ));
+    memset( val, 0, val_sz );
+    fd_funk_rec_publish( funk, prepare );
+    return 1;
+  }
+
+  case OP_ERASE: {
+    fd_funk_rec_try_clone_safe( funk, txn, &key, alignof(ulong), val_sz );
+    return fd_funk_rec_remove( funk, txn, &key, NULL, slot )==FD_FUNK_SUCCESS;
+  }
+
+  default:
+    FD_LOG_CRIT(( "unreachable" ));
+  }
+}
+
+/* exec_slot executes the ops of exec tile exec_idx for slot, like an
+   exec tile handling its share of the slot's transactions. */
+
+static void
+exec_slot( ulong exec_idx,
+           ulong slot ) {
+  fd_funk_txn_xid_t xid = slot_xid( slot );
+  fd_funk_txn_start_read( funk );
+  fd_funk_txn_t * txn = fd_funk_txn_query( &xid, fd_funk_txn_map( funk ) );
+  fd_funk_txn_end_read( funk );
+  if( FD_UNLIKELY( !txn ) ) FD_LOG_ERR(( "slot %lu not found", slot ));
+
+  exec_stat_t * stat   = &exec_stat[ exec_idx ];
+  op_t const *  op     = exec_ops   [ exec_idx ];
+  ulong         op_cnt = exec_op_cnt[ exec_idx ];
+  for( ulong i=0UL; i<op_cnt; i++ ) {
+    ulong type  = op[ i ].type;
+    long  t0    = fd_tickcount();
+    int   found = exec_op( txn, &op[ i ], slot );
+    ulong dt    = (ulong)fd_long_max( fd_tickcount()-t0, 0L );
+    stat->op_cnt  [ type ]++;
+    stat->miss_cnt[ type ] += (ulong)!found;
+    stat->tick_sum[ type ] += dt;
+    stat->tick_max[ type ]  = fd_ulong_max( stat->tick_max[ type ], dt );
+    stat->lat     [ type ][ lat_bucket( dt ) ]++;
+  }
+}
+
+static int
+exec_tile_main( int     argc,
+                char ** argv ) {
+  (void)argv;
+  ulong exec_idx = (ulong)argc;
+  ulong last     = 0UL;
+  for(;;) {
+    ulong slot;
+    while( (slot=slot_seq)==last ) FD_YIELD();
+    if( slot==ULONG_MAX ) break;
+    FD_COMPILER_MFENCE();
+    exec_slot( exec_idx, slot );
+    FD_COMPILER_MFENCE();
+    FD_ATOMIC_FETCH_AND_ADD( &done_cnt, 1UL );
+    last = slot;
+  }
+  return 0;
+}
+
+/* publish_root publishes the ancestor depth levels above tip, if any.
+   Returns the number of txns published. */
+
+static ulong
+publish_root( fd_funk_txn_t * tip,
+              ulong           depth ) {
+  fd_funk_txn_start_write( funk );
+  fd_funk_txn_pool_t * pool = fd_funk_txn_pool( funk );
+  fd_funk_txn_t *      txn  = tip;
+  for( ulong d=0UL; txn && d<depth; d++ ) txn = fd_funk_txn_parent( txn, pool );
+  ulong cnt = txn ? fd_funk_txn_publish( funk, txn, 1 ) : 0UL;
+  fd_funk_txn_end_write( funk );
+  return cnt;
+}
+
+static ulong
+funk_mem_used( fd_wksp_t * wksp ) {
+  ulong           tag = FUNK_TAG;
+  fd_wksp_usage_t usage[1];
+  return fd_wksp_usage( wksp, &tag, 1UL, usage )->used_sz;
+}
+
+static double
+tick_per_ns( void ) {
+  long w0 = fd_log_wallclock();
+  long t0 = fd_tickcount();
+  long w1; do w1 = fd_log_wallclock(); while( w1-w0<50000000L );
+  long t1 = fd_tickcount();
+  return (double)(t1-t0)/(double)(w1-w0);
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz    = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--page-sz",       NULL,      "gigantic" );
+  ulong        page_cnt    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--page-cnt",      NULL,             2UL );
+  ulong        near_cpu    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--near-cpu",      NULL, fd_log_cpu_id() );
+  ulong        key_cnt     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--key-cnt",       NULL,        1000000UL );
+  ulong        _val_sz     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--val-sz",        NULL,           256UL );
+  double       theta       = fd_env_strip_cmdline_double( &argc, &argv, "--zipf-theta",    NULL,            0.99 );
+  ulong        slot_cnt    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--slot-cnt",      NULL,            64UL );
+  ulong        slot_ops    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--slot-ops",      NULL,         65536UL );
+  ulong        fork_depth  = fd_env_strip_cmdline_ulong ( &argc, &argv, "--fork-depth",    NULL,            32UL );
+  uint         fork_pct    = fd_env_strip_cmdline_uint  ( &argc, &argv, "--fork-pct",      NULL,              5U );
+  ulong        publish_int = fd_env_strip_cmdline_ulong ( &argc, &argv, "--publish-every", NULL,             4UL );
+  uint         read_pct    = fd_env_strip_cmdline_uint  ( &argc, &argv, "--read-pct",      NULL,             70U );
+  uint         modify_pct  = fd_env_strip_cmdline_uint  ( &argc, &argv, "--modify-pct",    NULL,             25U );
+  uint         insert_pct  = fd_env_strip_cmdline_uint  ( &argc, &argv, "--insert-pct",    NULL,              4U );
+  uint         rng_seed    = fd_env_strip_cmdline_uint  ( &argc, &argv, "--rng-seed",      NULL,           1234U );
+  ulong        funk_seed   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--funk-seed",     NULL,          1234UL );
+  int          bucket      = fd_env_strip_cmdline_int   ( &argc, &argv, "--bucket",        NULL,               0 );
+
+  if( FD_UNLIKELY( !key_cnt || !slot_cnt || !slot_ops ) ) FD_LOG_ERR(( "--key-cnt, --slot-cnt and --slot-ops must be positive" ));
+  if( FD_UNLIKELY( _val_sz<sizeof(ulong)              ) ) FD_LOG_ERR(( "--val-sz must be at least %lu", sizeof(ulong) ));
+  if( FD_UNLIKELY( !(theta>=0.0 && theta<1.0)         ) ) FD_LOG_ERR(( "--zipf-theta must be in [0,1)" ));
+  if( FD_UNLIKELY( !publish_int                       ) ) FD_LOG_ERR(( "--publish-every must be positive" ));
+  if( FD_UNLIKELY( fork_pct>100U || read_pct+modify_pct+insert_pct>100U ) ) FD_LOG_ERR(( "bad percentages" ));
+  val_sz   = _val_sz;
+  exec_cnt = fd_ulong_max( fd_tile_cnt(), 2UL ) - 1UL;
+  if( FD_UNLIKELY( exec_cnt>TILE_MAX ) ) FD_LOG_ERR(( "too many tiles" ));
+
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, rng_seed, 0UL ) );
+
+  /* Every op creates at most one record.  Records of unpublished slots
+     (including dead forks) are bounded by the number of unpublished
+     slots.  Records published into the root only accumulate for
+     inserts and erases (tombstones). */
+
+  ulong unpub_max  = 2UL*(fork_depth+publish_int+1UL);
+  ulong ins_er_max = (ulong)( (double)(slot_cnt*slot_ops)*(double)(100U-read_pct-modify_pct)/100.0 * 1.1 ) + 1024UL;
+  ulong txn_max    = unpub_max + 2UL;
+  ulong rec_max    = key_cnt + ins_er_max + unpub_max*slot_ops;
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to create wksp" ));
+
+  int    rec_idx  = bucket ? FD_FUNK_REC_INDEX_BUCKET : FD_FUNK_REC_INDEX_CHAIN;
+  ulong  funk_sz  = fd_funk_footprint_ext( txn_max, rec_max, rec_idx );
+  void * funk_mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), funk_sz, FUNK_TAG );
+  if( FD_UNLIKELY( !funk_mem ) ) FD_LOG_ERR(( "failed to allocate funk (txn_max %lu rec_max %lu), increase --page-cnt", txn_max, rec_max ));
+  fd_funk_t funk_[1];
+  funk = fd_funk_join( funk_, fd_funk_new_ext( funk_mem, FUNK_TAG, funk_seed, txn_max, rec_max, rec_idx ) );
+  FD_TEST( funk );
+
+  for( ulong j=0UL; j<exec_cnt; j++ ) {
+    exec_ops[ j ] = fd_wksp_alloc_laddr( wksp, alignof(op_t), slot_ops*sizeof(op_t), OPS_TAG );
+    if( FD_UNLIKELY( !exec_ops[ j ] ) ) FD_LOG_ERR(( "failed to allocate ops, increase --page-cnt" ));
+  }
+
+  FD_LOG_NOTICE(( "Populating %lu accounts of %lu bytes (txn_max %lu rec_max %lu)", key_cnt, val_sz, txn_max, rec_max ));
+
+  for( ulong i=0UL; i<key_cnt; i++ ) {
+    op_t op = { .key_idx = i, .type = OP_INSERT };
+    exec_op( NULL, &op, 0UL );
+  }
+  ulong mem_base = funk_mem_used( wksp );
+  ulong mem_peak = mem_base;
+
+  zipf_t zipf[1];
+  zipf_init( zipf, key_cnt, theta );
+  double tpn = tick_per_ns();
+
+  FD_LOG_NOTICE(( "Running %lu slots of %lu ops on %lu exec tiles (--zipf-theta %g --fork-depth %lu --fork-pct %u --publish-every %lu, "
+                  "read/modify/insert/erase %u/%u/%u/%u%%)",
+                  slot_cnt, slot_ops, exec_cnt, theta, fork_depth, fork_pct, publish_int,
+                  read_pct, modify_pct, insert_pct, 100U-read_pct-modify_pct-insert_pct ));
+
+  int inline_exec = fd_tile_cnt()==1UL; /* no exec tiles, execute from the main tile */
+  if( !inline_exec ) {
+    for( ulong j=1UL; j<fd_tile_cnt(); j++ ) {
+      if( FD_UNLIKELY( !fd_tile_exec_new( j, exec_tile_main, (int)(j-1UL), NULL ) ) ) FD_LOG_ERR(( "fd_tile_exec_new failed" ));
+    }
+  }
+
+  ulong           next_key    = key_cnt;
+  fd_funk_txn_t * tip         = NULL;
+  long            exec_ns     = 0L;
+  long            slot_ns_max = 0L;
+  ulong           pub_cnt     = 0UL;
+  ulong           pub_txn_cnt = 0UL;
+  long            pub_ns_sum  = 0L;
+  long            pub_ns_max  = 0L;
+  ulong           fork_cnt    = 0UL;
+
+  for( ulong slot=1UL; slot<=slot_cnt; slot++ ) {
+
+    /* Schedule the slot's ops */
+
+    for( ulong j=0UL; j<exec_cnt; j++ ) exec_op_cnt[ j ] = 0UL;
+    for( ulong i=0UL; i<slot_ops; i++ ) {
+      uint  r = fd_rng_uint_roll( rng, 100U );
+      op_t  op;
+      if( r<read_pct+modify_pct+insert_pct && r>=read_pct+modify_pct ) {
+        op.key_idx = next_key++;
+        op.type    = OP_INSERT;
+      } else if( r>=read_pct+modify_pct ) {
+        op.key_idx = fd_rng_ulong_roll( rng, key_cnt ); /* closing an account is not related to its hotness */
+        op.type    = OP_ERASE;
+      } else {
+        op.key_idx = zipf_sample( zipf, rng );
+        op.type    = r<read_pct ? OP_READ : OP_MODIFY;
+      }
+      ulong j = fd_ulong_hash( op.key_idx ^ 0x5bd1e995UL ) % exec_cnt;
+      exec_ops[ j ][ exec_op_cnt[ j ]++ ] = op;
+    }
+
+    /* Prepare the slot on the tip or, to fork, on the tip's parent */
+
+    fd_funk_txn_xid_t xid = slot_xid( slot );
+    fd_funk_txn_start_write( funk );
+    fd_funk_txn_t * parent = tip;
+    if( tip && fd_rng_uint_roll( rng, 100U )<fork_pct ) {
+      parent = fd_funk_txn_parent( tip, fd_funk_txn_pool( funk ) );
+      fork_cnt++;
+    }
+    tip = fd_funk_txn_prepare( funk, parent, &xid, 1 );
+    fd_funk_txn_end_write( funk );
+    if( FD_UNLIKELY( !tip ) ) FD_LOG_ERR(( "fd_funk_txn_prepare failed" ));
+
+    /* Execute, publishing concurrently when due */
+
+    int  publish = !(slot % publish_int);
+    long t0      = fd_log_wallclock();
+    if( !inline_exec ) {
+      FD_COMPILER_MFENCE();
+      slot_seq = slot;
+      FD_COMPILER_MFENCE();
+    }
+    if( publish ) {
+      long p0 = fd_log_wallclock();
+      ulong cnt = publish_root( tip, fork_depth );
+      long p1 = fd_log_wallclock();
+      if( cnt ) {
+        pub_cnt++;
+        pub_txn_cnt += cnt;
+        pub_ns_sum  += p1-p0;
+        pub_ns_max   = fd_long_max( pub_ns_max, p1-p0 );
+      }
+    }
+    if( inline_exec ) {
+      exec_slot( 0UL, slot );
+    } else {
+      while( done_cnt<exec_cnt ) FD_YIELD();
+      FD_COMPILER_MFENCE();
+      done_cnt = 0UL;
+    }
+    long dt = fd_log_wallclock() - t0;
+    exec_ns    += dt;
+    slot_ns_max = fd_long_max( slot_ns_max, dt );
+
+    if( publish ) mem_peak = fd_ulong_max( mem_peak, funk_mem_used( wksp ) );
+  }
+
+  if( !inline_exec ) {
+    FD_COMPILER_MFENCE();
+    slot_seq = ULONG_MAX;
+    FD_COMPILER_MFENCE();
+    for( ulong j=1UL; j<fd_tile_cnt(); j++ ) fd_tile_exec_delete( fd_tile_exec( j ), NULL );
+  }
+
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Report */
+
+  exec_stat_t tot[1];
+  memset( tot, 0, sizeof(exec_stat_t) );
+  for( ulong j=0UL; j<exec_cnt; j++ ) {
+    for( ulong t=0UL; t<OP_CNT; t++ ) {
+      tot->op_cnt  [ t ] += exec_stat[ j ].op_cnt  [ t ];
+      tot->miss_cnt[ t ] += exec_stat[ j ].miss_cnt[ t ];
+      tot->tick_sum[ t ] += exec_stat[ j ].tick_sum[ t ];
+      tot->tick_max[ t ]  = fd_ulong_max( tot->tick_max[ t ], exec_stat[ j ].tick_max[ t ] );
+      for( ulong b=0UL; b<LAT_BUCKET_CNT; b++ ) tot->lat[ t ][ b ] += exec_stat[ j ].lat[ t ][ b ];
+    }
+  }
+
+  ulong op_tot = slot_cnt*slot_ops;
+  FD_LOG_NOTICE(( "%lu ops in %.3f s: %.3f Mops/s, slot mean %.3f ms max %.3f ms, %lu forks",
+                  op_tot, (double)exec_ns/1e9, (double)op_tot/((double)exec_ns/1e3),
+                  (double)exec_ns/(double)slot_cnt/1e6, (double)slot_ns_max/1e6, fork_cnt ));
+  FD_LOG_NOTICE(( "op           cnt    miss%%    mean ns     p50 ns     p99 ns   p99.9 ns     max ns" ));
+  static double const pct[3] = { 0.5, 0.99, 0.999 };
+  for( ulong t=0UL; t<OP_CNT; t++ ) {
+    ulong cnt = tot->op_cnt[ t ];
+    if( !cnt ) continue;
+    double p[3];
+    for( ulong k=0UL; k<3UL; k++ ) {
+      ulong rank = (ulong)( pct[ k ]*(double)cnt );
+      ulong acc  = 0UL;
+      ulong b    = 0UL;
+      for( ; b<LAT_BUCKET_CNT-1UL; b++ ) { acc += tot->lat[ t ][ b ]; if( acc>rank ) break; }
+      p[ k ] = (double)lat_bucket_lo( b+1UL )/tpn; /* upper edge of the bucket */
+    }
+    FD_LOG_NOTICE(( "%s %10lu %8.2f %10.1f %10.1f %10.1f %10.1f %10.1f",
+                    op_name[ t ], cnt, 100.0*(double)tot->miss_cnt[ t ]/(double)cnt,
+                    (double)tot->tick_sum[ t ]/(double)cnt/tpn, p[0], p[1], p[2],
+                    (double)tot->tick_max[ t ]/tpn ));
+  }
+  FD_LOG_NOTICE(( "publish: %lu publishes of %lu txns, mean %.1f us max %.1f us (incl write lock wait)",
+                  pub_cnt, pub_txn_cnt,
+                  pub_cnt ? (double)pub_ns_sum/(double)pub_cnt/1e3 : 0.0, (double)pub_ns_max/1e3 ));
+
+  ulong rec_cnt = 0UL;
+  fd_funk_all_iter_t iter[1];
+  for( fd_funk_all_iter_new( funk, iter ); !fd_funk_all_iter_done( iter ); fd_funk_all_iter_next( iter ) ) rec_cnt++;
+  ulong mem_end = funk_mem_used( wksp ) - funk_sz;
+  mem_base -= funk_sz;
+  mem_peak -= funk_sz;
+  FD_LOG_NOTICE(( "memory: %.1f MiB funk footprint, values %.1f MiB after populate, %.1f MiB peak, %.1f MiB at end for %lu records",
+                  (double)funk_sz/(double)(1UL<<20),
+                  (double)mem_base/(double)(1UL<<20), (double)mem_peak/(double)(1UL<<20), (double)mem_end/(double)(1UL<<20),
+                  rec_cnt ));
+
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( funk_mem ) );
+  for( ulong j=0UL; j<exec_cnt; j++ ) fd_wksp_free_laddr( exec_ops[ j ] );
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -7,11 +7,36 @@ fd_funk_align( void ) {
   return FD_FUNK_ALIGN;
 }
 
+/* fd_funk_rec_index_footprint returns the footprint of a record index
+   with rec_chain_cnt chains and the given layout (0 if unsupported). */
+
+static ulong
+fd_funk_rec_index_footprint( ulong rec_chain_cnt,
+                             int   rec_index ) {
+  switch( rec_index ) {
+  case FD_FUNK_REC_INDEX_CHAIN:  return fd_funk_rec_map_footprint       ( rec_chain_cnt );
+  case FD_FUNK_REC_INDEX_BUCKET: return fd_funk_rec_map_bucket_footprint( rec_chain_cnt );
+  default: break;
+  }
+  return 0UL;
+}
+
 ulong
 fd_funk_footprint( ulong txn_max,
                    ulong rec_max ) {
+  return fd_funk_footprint_ext( txn_max, rec_max, FD_FUNK_REC_INDEX_CHAIN );
+}
+
+ulong
+fd_funk_footprint_ext( ulong txn_max,
+                       ulong rec_max,
+                       int   rec_index ) {
   if( FD_UNLIKELY( rec_max>UINT_MAX ) ) return 0UL;
 
+  ulong rec_chain_cnt = fd_funk_rec_map_chain_cnt_est( rec_max );
+  ulong rec_map_sz    = fd_funk_rec_index_footprint( rec_chain_cnt, rec_index );
+  if( FD_UNLIKELY( !rec_map_sz ) ) return 0UL;
+
   ulong l = FD_LAYOUT_INIT;
 
   l = FD_LAYOUT_APPEND( l, alignof(fd_funk_shmem_t), sizeof(fd_funk_shmem_t) );
@@ -21,8 +46,7 @@ fd_funk_footprint( ulong txn_max,
   l = FD_LAYOUT_APPEND( l, fd_funk_txn_pool_align(), fd_funk_txn_pool_footprint() );
   l = FD_LAYOUT_APPEND( l, alignof(fd_funk_txn_t), sizeof(fd_funk_txn_t) * txn_max );
 
-  ulong rec_chain_cnt = fd_funk_rec_map_chain_cnt_est( rec_max );
-  l = FD_LAYOUT_APPEND( l, fd_funk_rec_map_align(), fd_funk_rec_map_footprint( rec_chain_cnt ) );
+  l = FD_LAYOUT_APPEND( l, fd_funk_rec_map_align(), rec_map_sz );
   l = FD_LAYOUT_APPEND( l, fd_funk_rec_pool_align(), fd_funk_rec_pool_footprint() );
   l = FD_LAYOUT_APPEND( l, alignof(fd_funk_rec_t), sizeof(fd_funk_rec_t) * rec_max );
 
@@ -41,6 +65,16 @@ fd_funk_new( void * shmem,
              ulong  seed,
              ulong  txn_max,
              ulong  rec_max ) {
+  return fd_funk_new_ext( shmem, wksp_tag, seed, txn_max, rec_max, FD_FUNK_REC_INDEX_CHAIN );
+}
+
+void *
+fd_funk_new_ext( void * shmem,
+                 ulong  wksp_tag,
+                 ulong  seed,
+                 ulong  txn_max,
+                 ulong  rec_max,
+                 int    rec_index ) {
   fd_funk_shmem_t * funk = shmem;
   fd_wksp_t *       wksp = fd_wksp_containing( funk );
 
@@ -74,6 +108,11 @@ fd_funk_new( void * shmem,
     return NULL;
   }
 
+  if( FD_UNLIKELY( (rec_index!=FD_FUNK_REC_INDEX_CHAIN) & (rec_index!=FD_FUNK_REC_INDEX_BUCKET) ) ) {
+    FD_LOG_WARNING(( "unsupported rec_index" ));
+    return NULL;
+  }
+
   FD_SCRATCH_ALLOC_INIT( l, funk+1 );
 
   ulong txn_chain_cnt = fd_funk_txn_map_chain_cnt_est( txn_max );
@@ -82,13 +121,13 @@ fd_funk_new( void * shmem,
   fd_funk_txn_t * txn_ele = (fd_funk_txn_t *)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_funk_txn_t), sizeof(fd_funk_txn_t) * txn_max );
 
   ulong rec_chain_cnt = fd_funk_rec_map_chain_cnt_est( rec_max );
-  void * rec_map = FD_SCRATCH_ALLOC_APPEND( l, fd_funk_rec_map_align(), fd_funk_rec_map_footprint( rec_chain_cnt ) );
+  void * rec_map = FD_SCRATCH_ALLOC_APPEND( l, fd_funk_rec_map_align(), fd_funk_rec_index_footprint( rec_chain_cnt, rec_index ) );
   void * rec_pool = FD_SCRATCH_ALLOC_APPEND( l, fd_funk_rec_pool_align(), fd_funk_rec_pool_footprint() );
   fd_funk_rec_t * rec_ele = (fd_funk_rec_t *)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_funk_rec_t), sizeof(fd_funk_rec_t) * rec_max );
 
   void * alloc = FD_SCRATCH_ALLOC_APPEND( l, fd_alloc_align(), fd_alloc_footprint() );
 
-  FD_TEST( _l == (ulong)funk + fd_funk_footprint( txn_max, rec_max ) );
+  FD_TEST( _l == (ulong)funk + fd_funk_footprint_ext( txn_max, rec_max, rec_index ) );
 
   fd_memset( funk, 0, sizeof(fd_funk_shmem_t) );
 
@@ -111,7 +150,9 @@ fd_funk_new( void * shmem,
   fd_funk_txn_xid_set_root( funk->root         );
   fd_funk_txn_xid_set_root( funk->last_publish );
 
-  funk->rec_map_gaddr = fd_wksp_gaddr_fast( wksp, fd_funk_rec_map_new( rec_map, rec_chain_cnt, seed ) );
+  void * rec_map2 = rec_index==FD_FUNK_REC_INDEX_BUCKET ? fd_funk_rec_map_bucket_new( rec_map, rec_chain_cnt, seed ) :
+                                                          fd_funk_rec_map_new       ( rec_map, rec_chain_cnt, seed );
+  funk->rec_map_gaddr = fd_wksp_gaddr_fast( wksp, rec_map2 );
   void * rec_pool2 = fd_funk_rec_pool_new( rec_pool );
   funk->rec_pool_gaddr = fd_wksp_gaddr_fast( wksp, rec_pool2 );
   fd_funk_rec_pool_t rec_join[1];
@@ -213,6 +254,7 @@ fd_funk_purify( void * shfunk ) {
   fd_funk_txn_map_reset( funk->txn_map );
   fd_funk_txn_pool_reset( funk->txn_pool, 0 );
   funk->shmem->child_head_cidx = funk->shmem->child_tail_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+  funk->shmem->ancestry_seq   += funk->shmem->ancestry_seq & 1UL; /* Crashed during relabel */
 
   return fd_funk_rec_purify( funk );
 }
@@ -378,6 +420,8 @@ fd_funk_verify( fd_funk_t * join ) {
 
   if( !txn_max ) TEST( fd_funk_txn_idx_is_null( child_tail_idx ) );
 
+  TEST( !(funk->ancestry_seq & 1UL) ); /* No relabel in progress */
+
   fd_funk_txn_xid_t const * root = fd_funk_root( join );
   TEST( root ); /* Practically guaranteed */
   TEST( fd_funk_txn_xid_eq_root( root ) );
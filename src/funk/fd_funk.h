@@ -155,6 +155,17 @@
 
 #define FD_FUNK_ALIGN (4096UL)
 
+/* FD_FUNK_REC_INDEX_* select the layout of the record index when a funk
+   is created.  CHAIN stores a chain head per hash chain and a lookup
+   follows the chain through the records.  BUCKET stores a cache line
+   per hash chain that also holds hash tags and indices of the first
+   records on the chain, such that a typical lookup touches one index
+   line before the record it is looking for.  BUCKET uses 4x the index
+   memory (~32 bytes per record instead of ~8). */
+
+#define FD_FUNK_REC_INDEX_CHAIN  (0)
+#define FD_FUNK_REC_INDEX_BUCKET (1)
+
 /* The details of a fd_funk_shmem_private are exposed here to facilitate
    inlining various operations. */
 
@@ -204,7 +215,13 @@ struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_shmem_private {
 
      last_publish is the ID of the last published transaction.  It will
      be the root transaction if no transactions have been published.
-     Will be the root transaction immediately after construction. */
+     Will be the root transaction immediately after construction.
+
+     ancestry_seq is a sequence lock over the ancestry intervals of all
+     in-preparation transactions (see fd_funk_txn_is_ancestor).  It is
+     odd while fd_funk_txn_prepare relabels them in place, such that
+     concurrent record queries from other processes can detect a torn
+     read and retry. */
 
   ulong txn_max;         /* In [0,FD_FUNK_TXN_IDX_NULL] */
   ulong txn_map_gaddr;   /* Non-zero wksp gaddr with tag wksp_tag
@@ -215,6 +232,7 @@ struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_shmem_private {
 
   uint  child_head_cidx; /* After decompression, in [0,txn_max) or FD_FUNK_TXN_IDX_NULL, FD_FUNK_TXN_IDX_NULL if txn_max 0 */
   uint  child_tail_cidx; /* " */
+  ulong ancestry_seq;    /* Odd while ancestry intervals are being relabeled */
 
   /* Padding to FD_FUNK_TXN_XID_ALIGN here */
 
@@ -295,6 +313,15 @@ FD_FN_CONST ulong
 fd_funk_footprint( ulong txn_max,
                    ulong rec_max );
 
+/* fd_funk_footprint_ext is fd_funk_footprint for a funk whose record
+   index has the layout rec_index (a FD_FUNK_REC_INDEX_*).  Returns 0 if
+   rec_index is not supported. */
+
+FD_FN_CONST ulong
+fd_funk_footprint_ext( ulong txn_max,
+                       ulong rec_max,
+                       int   rec_index );
+
 /* fd_funk_new formats an unused wksp allocation with the appropriate
    alignment and footprint as a funk.  Caller is not joined on return.
    Returns shmem on success and NULL on failure (shmem NULL, shmem
@@ -315,6 +342,19 @@ fd_funk_new( void * shmem,
              ulong  txn_max,
              ulong  rec_max );
 
+/* fd_funk_new_ext is fd_funk_new with the record index layout given by
+   rec_index (a FD_FUNK_REC_INDEX_*, fd_funk_new uses CHAIN).  shmem
+   should have a fd_funk_footprint_ext( txn_max, rec_max, rec_index )
+   footprint.  The layout is transparent to the rest of the API. */
+
+void *
+fd_funk_new_ext( void * shmem,
+                 ulong  wksp_tag,
+                 ulong  seed,
+                 ulong  txn_max,
+                 ulong  rec_max,
+                 int    rec_index );
+
 /* fd_funk_join joins the caller to a funk instance.  ljoin points to a
    fd_funk_t compatible memory region in the caller's address space,
    shfunk points to the first byte of the memory region backing the funk
@@ -36,6 +36,7 @@ static int fd_funk_rec_pool_is_in_pool( fd_funk_rec_t const * ele ) {
 #define MAP_MEMO              map_hash
 #define MAP_MAGIC             (0xf173da2ce77ecdb0UL) /* Firedancer rec db version 0 */
 #define MAP_MEMOIZE           1
+#define MAP_BUCKET            1
 #define MAP_IMPL_STYLE        2
 #include "../util/tmpl/fd_map_chain_para.c"
 
@@ -101,25 +102,47 @@ fd_funk_rec_modify_publish( fd_funk_rec_query_t * query ) {
   fd_funk_rec_map_modify_test( query );
 }
 
-fd_funk_rec_t const *
-fd_funk_rec_query_try_global( fd_funk_t const *         funk,
-                              fd_funk_txn_t const *     txn,
-                              fd_funk_rec_key_t const * key,
-                              fd_funk_txn_t const **    txn_out,
-                              fd_funk_rec_query_t *     query ) {
-#ifdef FD_FUNK_HANDHOLDING
-  if( FD_UNLIKELY( funk==NULL || key==NULL || query==NULL ) ) {
-    return NULL;
-  }
-  if( FD_UNLIKELY( txn && !fd_funk_txn_valid( funk, txn ) ) ) {
-    return NULL;
+/* fd_funk_rec_query_visible returns 1 if the record rec is visible from
+   txn and 0 otherwise.  Records of the last published transaction are
+   visible from everywhere.  Records of an in-prep transaction are
+   visible if that transaction is txn or one of its ancestors.  On
+   return 1, the transaction of rec (NULL if published) is stored at
+   *txn_out if txn_out is non-NULL. */
+
+static inline int
+fd_funk_rec_query_visible( fd_funk_rec_t const *  rec,
+                           fd_funk_txn_t const *  txn,
+                           fd_funk_txn_t const *  txn_pool_ele,
+                           fd_funk_txn_t const ** txn_out ) {
+  ulong                 rec_txn_idx = fd_funk_txn_idx( rec->txn_cidx );
+  fd_funk_txn_t const * rec_txn     = NULL;
+  int                   match;
+  if( FD_LIKELY( fd_funk_txn_idx_is_null( rec_txn_idx ) ) ) { /* opt for root find */
+    match = fd_funk_txn_xid_eq_root( rec->pair.xid );
+  } else {
+    rec_txn = txn_pool_ele + rec_txn_idx;
+    match   = !!txn && fd_funk_txn_is_ancestor( rec_txn, txn ) && fd_funk_txn_xid_eq( &rec_txn->xid, rec->pair.xid );
   }
-#endif
+  if( FD_LIKELY( match ) && txn_out ) *txn_out = rec_txn;
+  return match;
+}
+
+static fd_funk_rec_t const *
+fd_funk_rec_query_try_global_private( fd_funk_t const *         funk,
+                                      fd_funk_txn_t const *     txn,
+                                      fd_funk_rec_key_t const * key,
+                                      fd_funk_txn_t const **    txn_out,
+                                      fd_funk_rec_query_t *     query ) {
 
   /* Look for the first element in the hash chain with the right
-     record key. This takes advantage of the fact that elements with
-     the same record key appear on the same hash chain in order of
-     newest to oldest. */
+     record key that is visible from txn.  This takes advantage of the
+     fact that elements with the same record key appear on the same hash
+     chain in order of newest to oldest and that a transaction is frozen
+     (can't get new records) once it has children.  Thus the first
+     visible element is the youngest version in the path from txn to the
+     root.  Visibility is an O(1) ancestry interval test (see
+     fd_funk_txn_is_ancestor) so the cost does not depend on how deep
+     the fork is. */
 
   fd_funk_xid_key_pair_t pair[1];
   fd_funk_rec_key_set_pair( pair, txn, key );
@@ -133,35 +156,85 @@ fd_funk_rec_query_try_global( fd_funk_t const *         funk,
   query->chain   = chain;
   query->ver_cnt = chain->ver_cnt; /* After unlock */
 
-  for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter( funk->rec_map, chain_idx );
-       !fd_funk_rec_map_iter_done( iter );
-       iter = fd_funk_rec_map_iter_next( iter ) ) {
-    fd_funk_rec_t const * ele = fd_funk_rec_map_iter_ele_const( iter );
-    if( FD_LIKELY( hash == ele->map_hash ) && FD_LIKELY( fd_funk_rec_key_eq( key, ele->pair.key ) ) ) {
+  fd_funk_txn_t const * txn_pool_ele = funk->txn_pool->ele;
+
+  fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter( funk->rec_map, chain_idx );
+
+  if( fd_funk_rec_map_bucketed( funk->rec_map ) ) {
+
+    /* The bucket holds the hash tags and indices of the first records
+       on the chain in chain order.  Only touch the records whose tag
+       matches, then continue down the chain past the bucket. */
+
+    fd_funk_rec_map_shmem_private_bucket_t const * bucket = (fd_funk_rec_map_shmem_private_bucket_t const *)chain;
+
+    ulong rec_max = funk->rec_map->ele_max;
+    ulong tag_max = sizeof(bucket->tag)/sizeof(bucket->tag[0]);
+    ulong ele_cnt = fd_funk_rec_map_private_vcnt_cnt( query->ver_cnt );
+    ulong tag_cnt = fd_ulong_min( ele_cnt, tag_max );
+    uint  tag     = fd_funk_rec_map_private_tag( hash );
+    for( ulong tag_idx=0UL; tag_idx<tag_cnt; tag_idx++ ) {
+      if( FD_LIKELY( bucket->tag[ tag_idx ]!=tag ) ) continue;
+      ulong rec_idx = bucket->cidx[ tag_idx ];
+      if( FD_UNLIKELY( rec_idx>=rec_max ) ) return NULL; /* concurrent modification */
+      fd_funk_rec_t const * ele = iter.ele + rec_idx;
+      if( FD_LIKELY( hash==ele->map_hash ) && FD_LIKELY( fd_funk_rec_key_eq( key, ele->pair.key ) ) &&
+          fd_funk_rec_query_visible( ele, txn, txn_pool_ele, txn_out ) ) {
+        query->ele = ( FD_UNLIKELY( ele->flags & FD_FUNK_REC_FLAG_ERASE ) ? NULL :
+                       (fd_funk_rec_t *)ele );
+        return query->ele;
+      }
+    }
+    if( FD_LIKELY( ele_cnt<=tag_max ) ) return NULL;
 
-      /* For cur_txn in path from [txn] to [root] where root is NULL */
+    iter.ele_idx = bucket->cidx[ tag_max-1UL ];
+    if( FD_UNLIKELY( iter.ele_idx>=rec_max ) ) return NULL; /* concurrent modification */
+    iter = fd_funk_rec_map_iter_next( iter );
+  }
 
-      for( fd_funk_txn_t const * cur_txn = txn; ; cur_txn = fd_funk_txn_parent( cur_txn, funk->txn_pool ) ) {
-        /* If record ele is part of transaction cur_txn, we have a
-           match. According to the property above, this will be the
-           youngest descendent in the transaction stack. */
+  for( ; !fd_funk_rec_map_iter_done( iter ); iter = fd_funk_rec_map_iter_next( iter ) ) {
+    fd_funk_rec_t const * ele = fd_funk_rec_map_iter_ele_const( iter );
+    if( FD_LIKELY( hash == ele->map_hash ) && FD_LIKELY( fd_funk_rec_key_eq( key, ele->pair.key ) ) &&
+        fd_funk_rec_query_visible( ele, txn, txn_pool_ele, txn_out ) ) {
+      query->ele = ( FD_UNLIKELY( ele->flags & FD_FUNK_REC_FLAG_ERASE ) ? NULL :
+                     (fd_funk_rec_t *)ele );
+      return query->ele;
+    }
+  }
+  return NULL;
+}
 
-        int match = FD_UNLIKELY( cur_txn ) ? /* opt for root find (FIXME: eliminate branch with cmov into txn_xid_eq?) */
-          fd_funk_txn_xid_eq( &cur_txn->xid, ele->pair.xid ) :
-          fd_funk_txn_xid_eq_root( ele->pair.xid );
+fd_funk_rec_t const *
+fd_funk_rec_query_try_global( fd_funk_t const *         funk,
+                              fd_funk_txn_t const *     txn,
+                              fd_funk_rec_key_t const * key,
+                              fd_funk_txn_t const **    txn_out,
+                              fd_funk_rec_query_t *     query ) {
+#ifdef FD_FUNK_HANDHOLDING
+  if( FD_UNLIKELY( funk==NULL || key==NULL || query==NULL ) ) {
+    return NULL;
+  }
+  if( FD_UNLIKELY( txn && !fd_funk_txn_valid( funk, txn ) ) ) {
+    return NULL;
+  }
+#endif
 
-        if( FD_LIKELY( match ) ) {
-          if( txn_out ) *txn_out = cur_txn;
-          query->ele = ( FD_UNLIKELY( ele->flags & FD_FUNK_REC_FLAG_ERASE ) ? NULL :
-                         (fd_funk_rec_t *)ele );
-          return query->ele;
-        }
+  /* A prepare in another process can relabel the ancestry intervals
+     while we test them (see fd_funk_txn_is_ancestor).  Retry the lookup
+     until it saw a consistent labeling.  The relabel preserves all
+     ancestry relations, so the result stays valid afterwards. */
 
-        if( cur_txn == NULL ) break;
-      }
-    }
+  ulong const *         _seq     = &funk->shmem->ancestry_seq;
+  fd_funk_txn_t const * txn_out0 = txn_out ? *txn_out : NULL;
+  for(;;) {
+    ulong seq = FD_VOLATILE_CONST( *_seq );
+    if( FD_UNLIKELY( seq & 1UL ) ) { FD_SPIN_PAUSE(); continue; }
+    FD_COMPILER_MFENCE();
+    fd_funk_rec_t const * rec = fd_funk_rec_query_try_global_private( funk, txn, key, txn_out, query );
+    FD_COMPILER_MFENCE();
+    if( FD_LIKELY( FD_VOLATILE_CONST( *_seq )==seq ) ) return rec;
+    if( txn_out ) *txn_out = txn_out0;
   }
-  return NULL;
 }
 
 fd_funk_rec_t const *
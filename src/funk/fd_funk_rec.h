@@ -103,6 +103,7 @@ FD_STATIC_ASSERT( sizeof(fd_funk_rec_t) == 2U*FD_FUNK_REC_ALIGN, record size is
 #define MAP_MEMO              map_hash
 #define MAP_MAGIC             (0xf173da2ce77ecdb0UL) /* Firedancer rec db version 0 */
 #define MAP_MEMOIZE           1
+#define MAP_BUCKET            1
 #define MAP_IMPL_STYLE        1
 #include "../util/tmpl/fd_map_chain_para.c"
 #undef  MAP_MEMOIZE
@@ -235,7 +236,11 @@ int fd_funk_rec_query_test( fd_funk_rec_query_t * query );
    otherwise. *txn_out is set to the transaction where the record was
    found.
 
-   This is reasonably fast O(in_prep_ancestor_cnt).
+   This is O(versions of key on the hash chain), independent of the
+   depth of the fork: each candidate version is checked for visibility
+   with an O(1) ancestry test and the first visible one is the youngest.
+   Safe to call while a prepare in another process relabels the ancestry
+   intervals (the lookup is retried, see fd_funk_txn_is_ancestor).
 
    Important safety tip!  This function can encounter records
    that have the ERASE flag set (i.e. are tombstones of erased
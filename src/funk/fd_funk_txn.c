@@ -45,6 +45,85 @@ fd_funk_txn_end_write( fd_funk_t * funk FD_PARAM_UNUSED ) {
   fd_rwlock_unwrite( funk_txn_lock );
 }
 
+/* fd_funk_txn_ancestry_gap returns in *_gap_lo / *_gap_hi the exclusive
+   range of ancestry labels available to a new youngest child of
+   parent_idx (FD_FUNK_TXN_IDX_NULL for a child of funk).  See
+   fd_funk_txn_is_ancestor for details. */
+
+static void
+fd_funk_txn_ancestry_gap( fd_funk_t * funk,
+                          ulong       parent_idx,
+                          ulong *     _gap_lo,
+                          ulong *     _gap_hi ) {
+  fd_funk_txn_t * ele = funk->txn_pool->ele;
+
+  ulong gap_lo;
+  ulong gap_hi;
+  ulong youngest_idx;
+  if( FD_LIKELY( fd_funk_txn_idx_is_null( parent_idx ) ) ) { /* opt for incr pub */
+    gap_lo       = 0UL;
+    gap_hi       = ULONG_MAX;
+    youngest_idx = fd_funk_txn_idx( funk->shmem->child_tail_cidx );
+  } else {
+    gap_lo       = ele[ parent_idx ].ancestry_lo;
+    gap_hi       = ele[ parent_idx ].ancestry_hi;
+    youngest_idx = fd_funk_txn_idx( ele[ parent_idx ].child_tail_cidx );
+  }
+  if( !fd_funk_txn_idx_is_null( youngest_idx ) ) gap_lo = ele[ youngest_idx ].ancestry_hi;
+
+  *_gap_lo = gap_lo;
+  *_gap_hi = gap_hi;
+}
+
+/* fd_funk_txn_ancestry_relabel reassigns the ancestry intervals of all
+   in-prep transactions, spacing the interval end points of a depth
+   first traversal evenly over (0,ULONG_MAX).  This leaves at least
+   ULONG_MAX/(2 txn_max+2) labels (~2^31 at the txn_max limit) between
+   neighboring end points for subsequent prepares.  Uses the tree links
+   directly so needs no stack.  The intervals are rewritten in place
+   under funk->shmem->ancestry_seq, so that lock-free readers in other
+   processes (fd_funk_rec_query_try_global) detect the relabel and
+   retry. */
+
+static void
+fd_funk_txn_ancestry_relabel( fd_funk_t * funk ) {
+  fd_funk_txn_t * ele     = funk->txn_pool->ele;
+  ulong           txn_max = fd_funk_txn_pool_ele_max( funk->txn_pool );
+  ulong           stride  = ULONG_MAX / (2UL*txn_max + 2UL);
+  ulong           label   = 0UL;
+
+  ulong seq = funk->shmem->ancestry_seq;
+  FD_VOLATILE( funk->shmem->ancestry_seq ) = seq+1UL;
+  FD_COMPILER_MFENCE();
+
+  ulong txn_idx = fd_funk_txn_idx( funk->shmem->child_head_cidx );
+  while( !fd_funk_txn_idx_is_null( txn_idx ) ) {
+    label += stride;
+    ele[ txn_idx ].ancestry_lo = label;
+
+    ulong child_idx = fd_funk_txn_idx( ele[ txn_idx ].child_head_cidx );
+    if( !fd_funk_txn_idx_is_null( child_idx ) ) { txn_idx = child_idx; continue; }
+
+    /* txn_idx is childless.  Close it and any ancestors whose youngest
+       child we just closed, then continue with the next younger
+       sibling (if any). */
+
+    for(;;) {
+      label += stride;
+      ele[ txn_idx ].ancestry_hi = label;
+
+      ulong next_idx = fd_funk_txn_idx( ele[ txn_idx ].sibling_next_cidx );
+      if( !fd_funk_txn_idx_is_null( next_idx ) ) { txn_idx = next_idx; break; }
+
+      txn_idx = fd_funk_txn_idx( ele[ txn_idx ].parent_cidx );
+      if( fd_funk_txn_idx_is_null( txn_idx ) ) break;
+    }
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( funk->shmem->ancestry_seq ) = seq+2UL;
+}
+
 fd_funk_txn_t *
 fd_funk_txn_prepare( fd_funk_t *               funk,
                      fd_funk_txn_t *           parent,
@@ -110,6 +189,20 @@ fd_funk_txn_prepare( fd_funk_t *               funk,
   fd_funk_txn_xid_copy( &txn->xid, xid );
   ulong txn_idx = (ulong)(txn - funk->txn_pool->ele);
 
+  /* Carve out an ancestry interval for txn as the youngest child of
+     parent_idx, leaving 1/8 of the available space for any younger
+     siblings to come.  This needs at least 2 unused labels. */
+
+  ulong gap_lo;
+  ulong gap_hi;
+  fd_funk_txn_ancestry_gap( funk, parent_idx, &gap_lo, &gap_hi );
+  if( FD_UNLIKELY( (gap_hi-gap_lo)<3UL ) ) {
+    fd_funk_txn_ancestry_relabel( funk );
+    fd_funk_txn_ancestry_gap( funk, parent_idx, &gap_lo, &gap_hi );
+  }
+  txn->ancestry_lo = gap_lo + 1UL;
+  txn->ancestry_hi = gap_hi - 1UL - ((gap_hi-gap_lo)>>3);
+
   /* Join the family */
 
   ulong sibling_prev_idx = fd_funk_txn_idx( *_child_tail_cidx );
@@ -874,12 +967,17 @@ fd_funk_txn_verify( fd_funk_t * funk ) {
       TEST( IS_VALID( child_idx ) );
       TEST( !txn_pool->ele[ child_idx ].tag );
       TEST( fd_funk_txn_idx_is_null( fd_funk_txn_idx( txn_pool->ele[ child_idx ].parent_cidx ) ) );
+      TEST( (0UL<txn_pool->ele[ child_idx ].ancestry_lo) & (txn_pool->ele[ child_idx ].ancestry_lo<txn_pool->ele[ child_idx ].ancestry_hi) &
+            (txn_pool->ele[ child_idx ].ancestry_hi<ULONG_MAX) );
       txn_pool->ele[ child_idx ].tag        = 1UL;
       txn_pool->ele[ child_idx ].stack_cidx = fd_funk_txn_cidx( stack_idx );
       stack_idx                   = child_idx;
 
       ulong next_idx = fd_funk_txn_idx( txn_pool->ele[ child_idx ].sibling_next_cidx );
-      if( !fd_funk_txn_idx_is_null( next_idx ) ) TEST( fd_funk_txn_idx( txn_pool->ele[ next_idx ].sibling_prev_cidx )==child_idx );
+      if( !fd_funk_txn_idx_is_null( next_idx ) ) {
+        TEST( fd_funk_txn_idx( txn_pool->ele[ next_idx ].sibling_prev_cidx )==child_idx );
+        TEST( txn_pool->ele[ child_idx ].ancestry_hi<txn_pool->ele[ next_idx ].ancestry_lo );
+      }
       child_idx = next_idx;
     }
 
@@ -902,12 +1000,18 @@ fd_funk_txn_verify( fd_funk_t * funk ) {
         TEST( IS_VALID( child_idx ) );
         TEST( !txn_pool->ele[ child_idx ].tag );
         TEST( fd_funk_txn_idx( txn_pool->ele[ child_idx ].parent_cidx )==txn_idx );
+        TEST( (txn_pool->ele[ txn_idx ].ancestry_lo<txn_pool->ele[ child_idx ].ancestry_lo) &
+              (txn_pool->ele[ child_idx ].ancestry_lo<txn_pool->ele[ child_idx ].ancestry_hi) &
+              (txn_pool->ele[ child_idx ].ancestry_hi<txn_pool->ele[ txn_idx ].ancestry_hi) );
         txn_pool->ele[ child_idx ].tag        = 1UL;
         txn_pool->ele[ child_idx ].stack_cidx = fd_funk_txn_cidx( stack_idx );
         stack_idx                   = child_idx;
 
         ulong next_idx = fd_funk_txn_idx( txn_pool->ele[ child_idx ].sibling_next_cidx );
-        if( !fd_funk_txn_idx_is_null( next_idx ) ) TEST( fd_funk_txn_idx( txn_pool->ele[ next_idx ].sibling_prev_cidx )==child_idx );
+        if( !fd_funk_txn_idx_is_null( next_idx ) ) {
+          TEST( fd_funk_txn_idx( txn_pool->ele[ next_idx ].sibling_prev_cidx )==child_idx );
+          TEST( txn_pool->ele[ child_idx ].ancestry_hi<txn_pool->ele[ next_idx ].ancestry_lo );
+        }
         child_idx = next_idx;
       }
     }
@@ -46,6 +46,9 @@ struct __attribute__((aligned(FD_FUNK_TXN_ALIGN))) fd_funk_txn_private {
   uint   stack_cidx;        /* Internal use by funk */
   ulong  tag;               /* Internal use by funk */
 
+  ulong  ancestry_lo;       /* Ancestry interval, see fd_funk_txn_is_ancestor */
+  ulong  ancestry_hi;       /* " */
+
   uint  rec_head_idx;      /* Record map index of the first record, FD_FUNK_REC_IDX_NULL if none (from oldest to youngest) */
   uint  rec_tail_idx;      /* "                       last          " */
   uchar lock;              /* Internal use by funk for sychronizing modifications to txn object */
@@ -87,6 +90,34 @@ static inline ulong fd_funk_txn_idx ( uint  idx ) { return (ulong)idx; }
 
 static inline int fd_funk_txn_idx_is_null( ulong idx ) { return idx==FD_FUNK_TXN_IDX_NULL; }
 
+/* fd_funk_txn_is_ancestor returns 1 if in-prep transaction anc is txn
+   or one of txn's in-prep ancestors and 0 otherwise.  This is O(1)
+   regardless of how deep the fork is.
+
+   Each in-prep transaction is labeled with an interval
+   [ancestry_lo,ancestry_hi] such that the interval of a transaction
+   strictly contains the intervals of all its descendants and the
+   intervals of siblings are disjoint (ordered oldest to youngest).
+   The children of funk itself live in (0,ULONG_MAX).  A new child is
+   carved out of the unused space between its youngest sibling (or the
+   start of its parent's interval) and the end of its parent's interval,
+   leaving some room for younger siblings.  When that space runs out,
+   fd_funk_txn_prepare relabels all in-prep transactions in O(txn_max)
+   (rare, amortized over many prepares).  Publishing and cancelling
+   never need to relabel as removing transactions preserves nesting.
+
+   Like the other fork traversal operations, this assumes the caller is
+   not racing against a concurrent prepare / publish / cancel.  Readers
+   that do (e.g. fd_funk_rec_query_try_global from another process)
+   must bracket their ancestry tests with funk->shmem->ancestry_seq,
+   which is odd while a prepare relabels, and retry if it changed. */
+
+FD_FN_PURE static inline int
+fd_funk_txn_is_ancestor( fd_funk_txn_t const * anc,
+                         fd_funk_txn_t const * txn ) {
+  return (anc->ancestry_lo<=txn->ancestry_lo) & (txn->ancestry_lo<=anc->ancestry_hi);
+}
+
 /* Generate a globally unique pseudo-random xid */
 fd_funk_txn_xid_t fd_funk_generate_xid(void);
 
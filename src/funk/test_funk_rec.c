@@ -24,6 +24,7 @@ main( int     argc,
   ulong        txn_max  = fd_env_strip_cmdline_ulong( &argc, &argv, "--txn-max",   NULL,            32UL );
   uint         rec_max  = fd_env_strip_cmdline_uint(  &argc, &argv, "--rec-max",   NULL,             128 );
   ulong        iter_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-max",  NULL,       1048576UL );
+  int          rec_idx  = fd_env_strip_cmdline_int  ( &argc, &argv, "--rec-index", NULL, FD_FUNK_REC_INDEX_CHAIN );
   int          verbose  = fd_env_strip_cmdline_int  ( &argc, &argv, "--verbose",   NULL,               0 );
 
   fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
@@ -40,12 +41,12 @@ main( int     argc,
 
   if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
 
-  FD_LOG_NOTICE(( "Testing with --wksp-tag %lu --seed %lu --txn-max %lu --rxn-max %u --iter-max %lu --verbose %i",
-                  wksp_tag, seed, txn_max, rec_max, iter_max, verbose ));
+  FD_LOG_NOTICE(( "Testing with --wksp-tag %lu --seed %lu --txn-max %lu --rxn-max %u --iter-max %lu --rec-index %i --verbose %i",
+                  wksp_tag, seed, txn_max, rec_max, iter_max, rec_idx, verbose ));
 
-  void * shfunk = fd_funk_new( fd_wksp_alloc_laddr(
-      wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), wksp_tag ),
-      wksp_tag, seed, txn_max, rec_max );
+  void * shfunk = fd_funk_new_ext( fd_wksp_alloc_laddr(
+      wksp, fd_funk_align(), fd_funk_footprint_ext( txn_max, rec_max, rec_idx ), wksp_tag ),
+      wksp_tag, seed, txn_max, rec_max, rec_idx );
   fd_funk_t tst_[1];
   fd_funk_t * tst = fd_funk_join( tst_, shfunk );
   if( FD_UNLIKELY( !tst ) ) FD_LOG_ERR(( "Unable to create tst" ));
@@ -310,6 +310,15 @@ main( int     argc,
         else          cur = fd_funk_txn_child_tail( parent, pool );
         for( ; cur; cur = fd_funk_txn_sibling_prev( cur, pool ) ) if( cur==txn ) break;
         FD_TEST( cur );
+
+        /* Make sure the ancestry test agrees with walking up the
+           parents for another random live txn */
+
+        fd_funk_txn_t * other = fd_funk_txn_query( &recent_xid[ r & 63U ], map );
+        if( other ) {
+          for( cur = txn; cur; cur = fd_funk_txn_parent( cur, pool ) ) if( cur==other ) break;
+          FD_TEST( fd_funk_txn_is_ancestor( other, txn )==!!cur );
+        }
       }
 
       break;
@@ -321,6 +330,42 @@ main( int     argc,
 #endif
   }
 
+  /* Grow a long fork (with the occasional short dead end branch) while
+     publishing from the other end, such that the ancestry intervals get
+     nested deep enough to require relabeling many times over. */
+
+  fd_funk_txn_cancel_all( funk, verbose );
+  if( txn_max>=4UL ) {
+    fd_funk_txn_t * tip      = NULL;
+    ulong           live_cnt = 0UL;
+    ulong           seq0     = funk->shmem->ancestry_seq;
+    for( ulong iter=0UL; iter<16384UL; iter++ ) {
+      if( live_cnt+2UL>txn_max ) {
+        fd_funk_txn_t * oldest = fd_funk_last_publish_child_head( funk, pool );
+        FD_TEST( fd_funk_txn_publish( funk, oldest, verbose )==1UL );
+        live_cnt--;
+      }
+      fd_funk_txn_xid_t xid[1]; xid[0] = fd_funk_generate_xid();
+      if( !(fd_rng_uint( rng ) & 7U) ) { /* dead end */
+        fd_funk_txn_t * fork = fd_funk_txn_prepare( funk, tip ? fd_funk_txn_parent( tip, pool ) : NULL, xid, verbose );
+        FD_TEST( fork );
+        if( tip ) FD_TEST( !fd_funk_txn_is_ancestor( fork, tip ) & !fd_funk_txn_is_ancestor( tip, fork ) );
+        FD_TEST( fd_funk_txn_cancel( funk, fork, verbose )==1UL );
+        continue;
+      }
+      tip = fd_funk_txn_prepare( funk, tip, xid, verbose );
+      FD_TEST( tip );
+      live_cnt++;
+      for( fd_funk_txn_t * cur = tip; cur; cur = fd_funk_txn_parent( cur, pool ) ) FD_TEST( fd_funk_txn_is_ancestor( cur, tip ) );
+      if( !(iter & 1023UL) ) FD_TEST( !fd_funk_verify( funk ) );
+    }
+    FD_TEST( !fd_funk_verify( funk ) );
+
+    /* Relabels happened and left the sequence lock unlocked */
+    FD_TEST( funk->shmem->ancestry_seq>seq0 );
+    FD_TEST( !(funk->shmem->ancestry_seq & 1UL) );
+  }
+
   fd_funk_leave( funk, NULL );
   fd_wksp_free_laddr( fd_funk_delete( shfunk ) );
   if( name ) fd_wksp_detach( wksp );
@@ -6,8 +6,8 @@ $(call make-unit-test,test_float,test_float,fd_util)
 $(call make-unit-test,test_hash,test_hash,fd_util)
 $(call make-unit-test,test_uwide,test_uwide,fd_util)
 $(call make-unit-test,test_sat,test_sat,fd_util)
-$(call run-unit-test,test_bits,test_bits,)
-$(call run-unit-test,test_float,test_float,)
-$(call run-unit-test,test_hash,test_hash,)
-$(call run-unit-test,test_uwide,test_uwide,)
-$(call run-unit-test,test_sat,test_sat,)
+$(call run-unit-test,test_bits,)
+$(call run-unit-test,test_float,)
+$(call run-unit-test,test_hash,)
+$(call run-unit-test,test_uwide,)
+$(call run-unit-test,test_sat,)
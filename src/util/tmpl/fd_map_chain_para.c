@@ -168,6 +168,16 @@
      void *    mymap_leave    ( mymap_t * join );
      void *    mymap_delete   ( void * shmap );
 
+     // If MAP_BUCKET is non-zero, mymap_bucket_{footprint,new} are
+     // like mymap_{footprint,new} but create a mymap with the bucketed
+     // chain layout.  All other APIs work with either layout (e.g.
+     // mymap_join detects the layout).  mymap_bucketed returns 1 if the
+     // mymap uses the bucketed layout and 0 otherwise.
+
+     ulong  mymap_bucket_footprint( ulong chain_cnt );
+     void * mymap_bucket_new      ( void * shmem, ulong chain_cnt, ulong seed );
+     int    mymap_bucketed        ( mymap_t const * join );
+
      // mymap_{chain_cnt,seed} return the mymap configuration.  Assumes
      // join is a current local join.  The values will be valid for the
      // mymap lifetime.
@@ -1155,6 +1165,21 @@
 #define MAP_KEY_EQ_IS_SLOW 0
 #endif
 
+/* If MAP_BUCKET is defined to non-zero, a map can also be created with
+   a bucketed chain layout (see map_bucket_new below).  In a bucketed
+   map, the metadata of each chain is a 64 byte cache line that also
+   holds, for the first few elements on the chain, the element index and
+   a tag (the 32 msb of the key hash).  Queries use these to skip
+   elements that can't hold the key without touching them, so a typical
+   query touches a single metadata cache line before the element that
+   holds the key.  The cost is a 4x larger map footprint and a little
+   more work when modifying a chain.  Maps created with map_new are
+   unaffected (beyond the stride computation when locating a chain). */
+
+#ifndef MAP_BUCKET
+#define MAP_BUCKET 0
+#endif
+
 /* MAP_CNT_WIDTH gives the number of bits in a ulong to reserve for
    encoding the count in a versioned count.  Element store capacity
    should be representable in this width.  Default is 43 bits (e.g.
@@ -1207,6 +1232,11 @@
 
 #define MAP_(n) FD_EXPAND_THEN_CONCAT3(MAP_NAME,_,n)
 
+/* MAP_BUCKET_TAG_CNT is the number of chain elements cached in a
+   bucket.  6 for a uint MAP_IDX_T, 4 for a ulong MAP_IDX_T. */
+
+#define MAP_BUCKET_TAG_CNT ((64UL-sizeof(MAP_(shmem_private_chain_t)))/(sizeof(uint)+sizeof(MAP_IDX_T)))
+
 #if MAP_IMPL_STYLE!=2 /* need header */
 
 #include "../bits/fd_bits.h"
@@ -1229,6 +1259,24 @@ struct MAP_(shmem_private_chain) {
 
 typedef struct MAP_(shmem_private_chain) MAP_(shmem_private_chain_t);
 
+#if MAP_BUCKET
+
+/* A bucket is the metadata of a chain in a bucketed map.  Entries
+   [0,min(cnt,MAP_BUCKET_TAG_CNT)) mirror the first elements on the
+   chain in chain order.  They are only modified with the chain locked
+   such that they are covered by the chain version like the chain
+   linkage. */
+
+struct __attribute__((aligned(64))) MAP_(shmem_private_bucket) {
+  MAP_(shmem_private_chain_t) chain;                      /* Must be first */
+  uint                        tag [ MAP_BUCKET_TAG_CNT ]; /* tag[i] is the 32 msb of the memo of the i-th element on the chain */
+  MAP_IDX_T                   cidx[ MAP_BUCKET_TAG_CNT ]; /* cidx[i] is the compressed index of the i-th element on the chain */
+};
+
+typedef struct MAP_(shmem_private_bucket) MAP_(shmem_private_bucket_t);
+
+#endif
+
 struct __attribute__((aligned(MAP_ALIGN))) MAP_(shmem_private) {
 
   /* FIXME: consider having a memo of the chain in which an element is
@@ -1239,10 +1287,14 @@ struct __attribute__((aligned(MAP_ALIGN))) MAP_(shmem_private) {
   ulong magic;     /* == MAP_MAGIC */
   ulong seed;      /* Hash seed, arbitrary */
   ulong chain_cnt; /* Number of chains, positive integer power-of-two */
+# if MAP_BUCKET
+  ulong chain_sz;  /* Bytes per chain, sizeof(MAP_(shmem_private_chain_t)) or sizeof(MAP_(shmem_private_bucket_t)) */
+# endif
 
   /* Padding to MAP_ALIGN alignment here */
 
-  /* MAP_(shmem_private_chain_t) chain[ chain_cnt ] here */
+  /* MAP_(shmem_private_chain_t) chain[ chain_cnt ] here (or
+     MAP_(shmem_private_bucket_t) bucket[ chain_cnt ] if bucketed) */
 };
 
 typedef struct MAP_(shmem_private) MAP_(shmem_t);
@@ -1318,23 +1370,64 @@ FD_FN_CONST static inline ulong MAP_(private_vcnt)( ulong ver, ulong cnt ) { ret
 FD_FN_CONST static inline ulong MAP_(private_vcnt_ver)( ulong ver_cnt ) { return  ver_cnt >> MAP_CNT_WIDTH;  }
 FD_FN_CONST static inline ulong MAP_(private_vcnt_cnt)( ulong ver_cnt ) { return (ver_cnt << MAP_VER_WIDTH) >> MAP_VER_WIDTH; }
 
-/* map_shmem_private_chain returns the location in the caller's address
-   space of the map chain metadata associated with hash.  The chain
-   associated with hash 0 is the first chain.  Assumes map is valid.
-   map_shmem_private_chain_const is a const correct version. */
+/* map_shmem_private_chain_idx returns the location in the caller's
+   address space of the map chain metadata for chain chain_idx.  Assumes
+   map is valid and chain_idx is in [0,chain_cnt).
+   map_shmem_private_chain returns the location of the map chain
+   metadata associated with hash.  The chain associated with hash 0 is
+   the first chain.  Assumes map is valid.  The _const variants are
+   const correct versions. */
+
+FD_FN_PURE static inline MAP_(shmem_private_chain_t) *
+MAP_(shmem_private_chain_idx)( MAP_(shmem_t) * map,
+                               ulong           chain_idx ) {
+# if MAP_BUCKET
+  return (MAP_(shmem_private_chain_t) *)((ulong)(map+1) + chain_idx*map->chain_sz);
+# else
+  return (MAP_(shmem_private_chain_t) *)(map+1) + chain_idx;
+# endif
+}
+
+FD_FN_PURE static inline MAP_(shmem_private_chain_t) const *
+MAP_(shmem_private_chain_idx_const)( MAP_(shmem_t) const * map,
+                                     ulong                 chain_idx ) {
+# if MAP_BUCKET
+  return (MAP_(shmem_private_chain_t) const *)((ulong)(map+1) + chain_idx*map->chain_sz);
+# else
+  return (MAP_(shmem_private_chain_t) const *)(map+1) + chain_idx;
+# endif
+}
 
 FD_FN_PURE static inline MAP_(shmem_private_chain_t) *
 MAP_(shmem_private_chain)( MAP_(shmem_t) * map,
                            ulong           hash ) {
-  return (MAP_(shmem_private_chain_t) *)(map+1) + (hash & (map->chain_cnt-1UL));
+  return MAP_(shmem_private_chain_idx)( map, hash & (map->chain_cnt-1UL) );
 }
 
 FD_FN_PURE static inline MAP_(shmem_private_chain_t) const *
 MAP_(shmem_private_chain_const)( MAP_(shmem_t) const * map,
                                  ulong                 hash ) {
-  return (MAP_(shmem_private_chain_t) const *)(map+1) + (hash & (map->chain_cnt-1UL));
+  return MAP_(shmem_private_chain_idx_const)( map, hash & (map->chain_cnt-1UL) );
+}
+
+/* map_private_bucketed returns 1 if map uses the bucketed chain layout
+   and 0 otherwise.  Assumes map is valid.  Compile time 0 if the map
+   was not generated with MAP_BUCKET. */
+
+FD_FN_PURE static inline int
+MAP_(private_bucketed)( MAP_(shmem_t) const * map ) {
+# if MAP_BUCKET
+  return map->chain_sz==sizeof(MAP_(shmem_private_bucket_t));
+# else
+  (void)map;
+  return 0;
+# endif
 }
 
+/* map_private_tag returns the bucket tag of the key hash memo. */
+
+FD_FN_CONST static inline uint MAP_(private_tag)( ulong memo ) { return (uint)(memo>>32); }
+
 /* map_txn_private_info returns the location in the caller's address
    space of the txn info.  Assumes txn is valid. */
 
@@ -1382,8 +1475,12 @@ FD_FN_CONST static inline ulong MAP_(ele_max_max)( void ) { return (ulong)(MAP_I
 
 FD_FN_CONST static inline ulong
 MAP_(chain_max)( void ) {
-  return fd_ulong_pow2_dn( (ULONG_MAX - sizeof(MAP_(shmem_t)) - alignof(MAP_(shmem_t)) + 1UL) /
-                           sizeof(MAP_(shmem_private_chain_t)) );
+# if MAP_BUCKET
+  ulong chain_sz = sizeof(MAP_(shmem_private_bucket_t)); /* Supports both layouts */
+# else
+  ulong chain_sz = sizeof(MAP_(shmem_private_chain_t));
+# endif
+  return fd_ulong_pow2_dn( (ULONG_MAX - sizeof(MAP_(shmem_t)) - alignof(MAP_(shmem_t)) + 1UL) / chain_sz );
 }
 
 FD_FN_CONST static inline ulong
@@ -1414,6 +1511,19 @@ MAP_(footprint)( ulong chain_cnt ) {
                             alignof(MAP_(shmem_t)) ); /* no overflow */
 }
 
+#if MAP_BUCKET
+
+FD_FN_CONST static inline ulong
+MAP_(bucket_footprint)( ulong chain_cnt ) {
+  if( !(fd_ulong_is_pow2( chain_cnt ) & (chain_cnt<=MAP_(chain_max)())) ) return 0UL;
+  return fd_ulong_align_up( sizeof(MAP_(shmem_t)) + chain_cnt*sizeof(MAP_(shmem_private_bucket_t)),
+                            alignof(MAP_(shmem_t)) ); /* no overflow */
+}
+
+FD_FN_PURE static inline int MAP_(bucketed)( MAP_(t) const * join ) { return MAP_(private_bucketed)( join->map ); }
+
+#endif
+
 FD_FN_PURE static inline ulong MAP_(seed)     ( MAP_(t) const * join ) { return join->map->seed;      }
 FD_FN_PURE static inline ulong MAP_(chain_cnt)( MAP_(t) const * join ) { return join->map->chain_cnt; }
 
@@ -1509,7 +1619,7 @@ FD_FN_PURE static inline MAP_(iter_t)
 MAP_(iter)( MAP_(t) const * join,
             ulong           chain_idx ) {
   /* FIXME: consider iter = {NULL,NULL} if chain_idx >= join->map->chain_cnt? */
-  MAP_(shmem_private_chain_t) const * chain = MAP_(shmem_private_chain_const)( join->map, 0UL ) + chain_idx;
+  MAP_(shmem_private_chain_t) const * chain = MAP_(shmem_private_chain_idx_const)( join->map, chain_idx );
   MAP_(iter_t) iter;
   iter.ele     = join->ele;
   iter.ele_idx = MAP_(private_idx)( chain->head_cidx );
@@ -1536,6 +1646,9 @@ MAP_(iter_ele_const)( MAP_(iter_t) iter ) {
 }
 
 MAP_STATIC void *    MAP_(new)   ( void * shmem, ulong chain_cnt, ulong seed );
+#if MAP_BUCKET
+MAP_STATIC void *    MAP_(bucket_new)( void * shmem, ulong chain_cnt, ulong seed );
+#endif
 MAP_STATIC MAP_(t) * MAP_(join)  ( void * ljoin, void * shmap, void * shele, ulong ele_max );
 MAP_STATIC void *    MAP_(leave) ( MAP_(t) * join );
 MAP_STATIC void *    MAP_(delete)( void * shmap );
@@ -1727,10 +1840,78 @@ FD_PROTOTYPES_END
     }                                            \
   } while(0)
 
-MAP_STATIC void *
-MAP_(new)( void * shmem,
-           ulong  chain_cnt,
-           ulong  seed ) {
+/* map_private_bucket_front updates the bucket of a locked chain for
+   moving the element ele_idx with the given memo from position pos on
+   the chain to the head of the chain.  Pushing a new element is a move
+   from position cnt (the chain element count before the push).
+
+   map_private_bucket_pull updates the bucket of a locked chain for
+   the removal of the element at position pos.  cnt is the chain element
+   count after the removal.  Assumes the chain linkage has already been
+   updated.
+
+   These are no-ops if map is not bucketed. */
+
+static inline void
+MAP_(private_bucket_front)( MAP_(shmem_t) const *         map,
+                            MAP_(shmem_private_chain_t) * chain,
+                            ulong                         pos,
+                            ulong                         ele_idx,
+                            ulong                         memo ) {
+# if MAP_BUCKET
+  if( FD_LIKELY( !MAP_(private_bucketed)( map ) ) ) return;
+  MAP_(shmem_private_bucket_t) * bucket = (MAP_(shmem_private_bucket_t) *)chain;
+  for( ulong i=fd_ulong_min( pos, MAP_BUCKET_TAG_CNT-1UL ); i; i-- ) {
+    bucket->tag [ i ] = bucket->tag [ i-1UL ];
+    bucket->cidx[ i ] = bucket->cidx[ i-1UL ];
+  }
+  bucket->tag [ 0 ] = MAP_(private_tag)( memo );
+  bucket->cidx[ 0 ] = MAP_(private_cidx)( ele_idx );
+# else
+  (void)map; (void)chain; (void)pos; (void)ele_idx; (void)memo;
+# endif
+}
+
+static inline void
+MAP_(private_bucket_pull)( MAP_(shmem_t) const *         map,
+                           MAP_ELE_T const *             ele,
+                           MAP_(shmem_private_chain_t) * chain,
+                           ulong                         pos,
+                           ulong                         cnt ) {
+# if MAP_BUCKET
+  if( FD_LIKELY( !MAP_(private_bucketed)( map ) ) ) return;
+  if( pos>=MAP_BUCKET_TAG_CNT ) return;
+  MAP_(shmem_private_bucket_t) * bucket = (MAP_(shmem_private_bucket_t) *)chain;
+  ulong end = fd_ulong_min( cnt, MAP_BUCKET_TAG_CNT-1UL );
+  for( ulong i=pos; i<end; i++ ) {
+    bucket->tag [ i ] = bucket->tag [ i+1UL ];
+    bucket->cidx[ i ] = bucket->cidx[ i+1UL ];
+  }
+  if( cnt>=MAP_BUCKET_TAG_CNT ) {
+
+    /* The element that was just past the bucket moved into the last
+       entry.  It follows the second to last entry's element. */
+
+    ulong idx = MAP_(private_idx)( ele[ MAP_(private_idx)( bucket->cidx[ MAP_BUCKET_TAG_CNT-2UL ] ) ].MAP_NEXT );
+#   if MAP_MEMOIZE
+    ulong memo = ele[ idx ].MAP_MEMO;
+#   else
+    ulong memo = MAP_(key_hash)( &ele[ idx ].MAP_KEY, map->seed );
+#   endif
+    bucket->tag [ MAP_BUCKET_TAG_CNT-1UL ] = MAP_(private_tag)( memo );
+    bucket->cidx[ MAP_BUCKET_TAG_CNT-1UL ] = MAP_(private_cidx)( idx );
+  }
+# else
+  (void)map; (void)ele; (void)chain; (void)pos; (void)cnt;
+# endif
+}
+
+static void *
+MAP_(private_new)( void * shmem,
+                   ulong  chain_cnt,
+                   ulong  seed,
+                   ulong  footprint,
+                   ulong  chain_sz ) {
 
   if( FD_UNLIKELY( !shmem ) ) {
     FD_LOG_WARNING(( "NULL shmem" ));
@@ -1742,7 +1923,6 @@ MAP_(new)( void * shmem,
     return NULL;
   }
 
-  ulong footprint = MAP_(footprint)( chain_cnt );
   if( FD_UNLIKELY( !footprint ) ) {
     FD_LOG_WARNING(( "bad footprint" ));
     return NULL;
@@ -1756,13 +1936,18 @@ MAP_(new)( void * shmem,
 
   map->seed      = seed;
   map->chain_cnt = chain_cnt;
+# if MAP_BUCKET
+  map->chain_sz  = chain_sz;
+# else
+  (void)chain_sz;
+# endif
 
   /* Set all the chains to version 0 and empty */
 
-  MAP_(shmem_private_chain_t) * chain = MAP_(shmem_private_chain)( map, 0UL );
   for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ ) {
-    chain[ chain_idx ].ver_cnt   = MAP_(private_vcnt)( 0UL, 0UL );
-    chain[ chain_idx ].head_cidx = MAP_(private_cidx)( MAP_(private_idx_null)() );
+    MAP_(shmem_private_chain_t) * chain = MAP_(shmem_private_chain_idx)( map, chain_idx );
+    chain->ver_cnt   = MAP_(private_vcnt)( 0UL, 0UL );
+    chain->head_cidx = MAP_(private_cidx)( MAP_(private_idx_null)() );
   }
 
   FD_COMPILER_MFENCE();
@@ -1772,6 +1957,24 @@ MAP_(new)( void * shmem,
   return shmem;
 }
 
+MAP_STATIC void *
+MAP_(new)( void * shmem,
+           ulong  chain_cnt,
+           ulong  seed ) {
+  return MAP_(private_new)( shmem, chain_cnt, seed, MAP_(footprint)( chain_cnt ), sizeof(MAP_(shmem_private_chain_t)) );
+}
+
+#if MAP_BUCKET
+
+MAP_STATIC void *
+MAP_(bucket_new)( void * shmem,
+                  ulong  chain_cnt,
+                  ulong  seed ) {
+  return MAP_(private_new)( shmem, chain_cnt, seed, MAP_(bucket_footprint)( chain_cnt ), sizeof(MAP_(shmem_private_bucket_t)) );
+}
+
+#endif
+
 MAP_STATIC MAP_(t) *
 MAP_(join)( void * ljoin,
             void * shmap,
@@ -1895,6 +2098,7 @@ MAP_(insert)( MAP_(t) *   join,
     ele->MAP_MEMO    = memo;
 #   endif
     chain->head_cidx = MAP_(private_cidx)( ele_idx );
+    MAP_(private_bucket_front)( map, chain, ele_cnt, ele_idx, memo );
     ver_cnt          = MAP_(private_vcnt)( version, ele_cnt+1UL ); /* version updated on exit */
     err              = FD_MAP_SUCCESS;
 
@@ -1979,6 +2183,7 @@ MAP_(remove)( MAP_(t) *         join,
           FD_LIKELY( MAP_(key_eq)( &ele[ ele_idx ].MAP_KEY, key ) ) ) { /* optimize for found */
 
         *cur       = ele[ ele_idx ].MAP_NEXT;
+        MAP_(private_bucket_pull)( map, ele, chain, ele_cnt-ele_rem, ele_cnt-1UL );
         ver_cnt    = MAP_(private_vcnt)( version, ele_cnt-1UL ); /* version updated on exit */
         query->ele = &ele[ ele_idx ];
         err        = FD_MAP_SUCCESS;
@@ -2063,6 +2268,7 @@ MAP_(modify_try)( MAP_(t) *         join,
           *cur                    = ele[ ele_idx ].MAP_NEXT;
           ele[ ele_idx ].MAP_NEXT = chain->head_cidx;
           chain->head_cidx        = MAP_(private_cidx)( ele_idx );
+          MAP_(private_bucket_front)( map, chain, ele_cnt-ele_rem, ele_idx, memo );
         }
         query->ele  = &ele[ ele_idx ];
         err         = FD_MAP_SUCCESS;
@@ -2135,12 +2341,75 @@ MAP_(query_try)( MAP_(t) const *   join,
   if( FD_UNLIKELY( (now!=then) | (!!(then & (1UL<<MAP_CNT_WIDTH))) ) ) return FD_MAP_ERR_AGAIN;
   if( FD_UNLIKELY( ele_cnt>ele_max                                 ) ) return FD_MAP_ERR_CORRUPT;
 
+  MAP_IDX_T const * cur     = &chain->head_cidx;
+  ulong             ele_rem = ele_cnt;
+
+# if MAP_BUCKET
+  if( MAP_(private_bucketed)( map ) ) {
+
+    /* Speculatively search the bucket entries.  Only elements whose tag
+       matches are touched.  Validation is as below. */
+
+    MAP_(shmem_private_bucket_t) const * bucket = (MAP_(shmem_private_bucket_t) const *)chain;
+
+    uint  tag     = MAP_(private_tag)( memo );
+    ulong tag_cnt = fd_ulong_min( ele_cnt, MAP_BUCKET_TAG_CNT );
+    for( ulong tag_idx=0UL; tag_idx<tag_cnt; tag_idx++ ) {
+      FD_COMPILER_MFENCE();
+      uint  ele_tag = bucket->tag[ tag_idx ];
+      ulong ele_idx = MAP_(private_idx)( bucket->cidx[ tag_idx ] );
+      FD_COMPILER_MFENCE();
+      if( FD_LIKELY( ele_tag!=tag ) ) continue;
+
+      int corrupt = (ele_idx>=ele_max);
+      int found   = ( FD_LIKELY( !corrupt                                   ) &&
+#                     if MAP_MEMOIZE && MAP_KEY_EQ_IS_SLOW
+                      FD_LIKELY( ele[ ele_idx ].MAP_MEMO==memo              ) &&
+#                     endif
+                      FD_LIKELY( MAP_(key_eq)( &ele[ ele_idx ].MAP_KEY, key ) ) ) ? 1 : 0;
+
+      FD_COMPILER_MFENCE();
+      now = *_vc;
+      FD_COMPILER_MFENCE();
+
+      if( FD_UNLIKELY( now!=then ) ) return FD_MAP_ERR_AGAIN;
+      if( FD_UNLIKELY( corrupt   ) ) return FD_MAP_ERR_CORRUPT;
+
+      if( FD_LIKELY( found ) ) {
+        query->ele = (MAP_ELE_T *)&ele[ ele_idx ];
+        return FD_MAP_SUCCESS;
+      }
+    }
+
+    if( FD_LIKELY( ele_cnt<=MAP_BUCKET_TAG_CNT ) ) {
+      FD_COMPILER_MFENCE();
+      now = *_vc;
+      FD_COMPILER_MFENCE();
+      return fd_int_if( now==then, FD_MAP_ERR_KEY, FD_MAP_ERR_AGAIN );
+    }
+
+    /* The chain is longer than the bucket.  Continue the search from
+       the last bucket element. */
+
+    ulong ele_idx = MAP_(private_idx)( bucket->cidx[ MAP_BUCKET_TAG_CNT-1UL ] );
+
+    FD_COMPILER_MFENCE();
+    now = *_vc;
+    FD_COMPILER_MFENCE();
+
+    if( FD_UNLIKELY( now!=then          ) ) return FD_MAP_ERR_AGAIN;
+    if( FD_UNLIKELY( ele_idx>=ele_max ) ) return FD_MAP_ERR_CORRUPT;
+
+    cur     = &ele[ ele_idx ].MAP_NEXT;
+    ele_rem = ele_cnt - MAP_BUCKET_TAG_CNT;
+  }
+# endif
+
   /* Search the chain for key.  Since we know the numer of elements on
      the chain, we can bound this search to avoid corruption causing out
      of bound reads, infinite loops and such. */
 
-  MAP_IDX_T const * cur = &chain->head_cidx;
-  for( ulong ele_rem=ele_cnt; ele_rem; ele_rem-- ) {
+  for( ; ele_rem; ele_rem-- ) {
 
     /* Speculatively read the index of the chain, speculate if a valid
        index and, if so, speculate if the chain element matches the
@@ -2438,6 +2707,7 @@ MAP_(txn_insert)( MAP_(t) *   join,
   ele->MAP_MEMO    = memo;
 # endif
   chain->head_cidx = MAP_(private_cidx)( ele_idx );
+  MAP_(private_bucket_front)( map, chain, ele_cnt, ele_idx, memo );
   chain->ver_cnt   = MAP_(private_vcnt)( version, ele_cnt+1UL );
 
   return FD_MAP_SUCCESS;
@@ -2483,6 +2753,7 @@ MAP_(txn_remove)( MAP_(t) *         join,
 #       endif
         FD_LIKELY( MAP_(key_eq)( &ele[ ele_idx ].MAP_KEY, key ) ) ) { /* optimize for found */
       *cur           = ele[ ele_idx ].MAP_NEXT;
+      MAP_(private_bucket_pull)( map, ele, chain, ele_cnt-ele_rem, ele_cnt-1UL );
       chain->ver_cnt = MAP_(private_vcnt)( version, ele_cnt-1UL );
       query->ele     = &ele[ ele_idx ];
       return FD_MAP_SUCCESS;
@@ -2539,6 +2810,7 @@ MAP_(txn_modify)( MAP_(t) *         join,
         *cur                    = ele[ ele_idx ].MAP_NEXT;
         ele[ ele_idx ].MAP_NEXT = chain->head_cidx;
         chain->head_cidx        = MAP_(private_cidx)( ele_idx );
+        MAP_(private_bucket_front)( map, chain, ele_cnt-ele_rem, ele_idx, memo );
       }
       query->ele = &ele[ ele_idx ];
       return FD_MAP_SUCCESS;
@@ -2568,8 +2840,6 @@ MAP_(iter_lock)( MAP_(t) * join,
   ulong chain_cnt = map->chain_cnt;
   if( FD_UNLIKELY( lock_cnt>chain_cnt ) ) return FD_MAP_ERR_INVAL;
 
-  MAP_(shmem_private_chain_t) * chain = MAP_(shmem_private_chain)( join->map, 0UL );
-
   int err;
 
   ulong backoff      = 1UL<<32;                 /* in [1,2^16)*2^32 */
@@ -2589,13 +2859,13 @@ MAP_(iter_lock)( MAP_(t) * join,
 
     if( FD_UNLIKELY( chain_idx>=chain_cnt ) ) { /* optimize for valid lock_seq */
       for( ulong unlock_idx=0UL; unlock_idx<locked_cnt; unlock_idx++ )
-        chain[ lock_seq[ unlock_idx ] ].ver_cnt += (1UL<<MAP_CNT_WIDTH);
+        MAP_(shmem_private_chain_idx)( map, lock_seq[ unlock_idx ] )->ver_cnt += (1UL<<MAP_CNT_WIDTH);
       locked_cnt = 0UL;
       err = FD_MAP_ERR_AGAIN;
       break;
     }
 
-    MAP_CRIT( chain + chain_idx, 0 ) {
+    MAP_CRIT( MAP_(shmem_private_chain_idx)( map, chain_idx ), 0 ) {
 
       /* At this point, we got the lock.  Swap lock at locked_cnt and
          lock_idx and increment locked_cnt to move lock_idx to the
@@ -2627,7 +2897,7 @@ MAP_(iter_lock)( MAP_(t) * join,
          excessively long time to resolve so we bulk unlock. */
 
       for( ulong unlock_idx=0UL; unlock_idx<locked_cnt; unlock_idx++ )
-        chain[ lock_seq[ unlock_idx ] ].ver_cnt += (1UL<<MAP_CNT_WIDTH);
+        MAP_(shmem_private_chain_idx)( map, lock_seq[ unlock_idx ] )->ver_cnt += (1UL<<MAP_CNT_WIDTH);
       locked_cnt = 0UL;
 
       err = FD_MAP_ERR_AGAIN;
@@ -2664,11 +2934,11 @@ MAP_STATIC void
 MAP_(iter_unlock)( MAP_(t) *     join,
                    ulong const * lock_seq,
                    ulong         lock_cnt ) {
-  MAP_(shmem_private_chain_t) * chain = MAP_(shmem_private_chain)( join->map, 0UL );
+  MAP_(shmem_t) * map = join->map;
 
   FD_COMPILER_MFENCE();
   for( ulong lock_idx=0UL; lock_idx<lock_cnt; lock_idx++ )
-    chain[ lock_seq[ lock_idx ] ].ver_cnt += (1UL<<MAP_CNT_WIDTH);
+    MAP_(shmem_private_chain_idx)( map, lock_seq[ lock_idx ] )->ver_cnt += (1UL<<MAP_CNT_WIDTH);
   FD_COMPILER_MFENCE();
 }
 
@@ -2676,14 +2946,14 @@ MAP_STATIC void
 MAP_(reset)( MAP_(t) * join ) {
   MAP_(shmem_t) * map = join->map;
 
-  ulong                         chain_cnt = map->chain_cnt;
-  MAP_(shmem_private_chain_t) * chain     = MAP_(shmem_private_chain)( map, 0UL );
+  ulong chain_cnt = map->chain_cnt;
 
   for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ ) {
-    ulong ver_cnt = chain[ chain_idx ].ver_cnt;
+    MAP_(shmem_private_chain_t) * chain = MAP_(shmem_private_chain_idx)( map, chain_idx );
+    ulong ver_cnt = chain->ver_cnt;
     ulong version = MAP_(private_vcnt_ver)( ver_cnt );
-    chain[ chain_idx ].ver_cnt   = MAP_(private_vcnt)( version+2UL, 0UL );
-    chain[ chain_idx ].head_cidx = MAP_(private_cidx)( MAP_(private_idx_null)() );
+    chain->ver_cnt   = MAP_(private_vcnt)( version+2UL, 0UL );
+    chain->head_cidx = MAP_(private_cidx)( MAP_(private_idx_null)() );
   }
 }
 
@@ -2721,17 +2991,20 @@ MAP_(verify)( MAP_(t) const * join ) {
   /* seed is arbitrary */
   MAP_TEST( fd_ulong_is_pow2( chain_cnt ) );
   MAP_TEST( chain_cnt<=MAP_(chain_max)()  );
-
-  MAP_(shmem_private_chain_t) const * chain = MAP_(shmem_private_chain_const)( map, 0UL );
+# if MAP_BUCKET
+  MAP_TEST( (map->chain_sz==sizeof(MAP_(shmem_private_chain_t))) | (map->chain_sz==sizeof(MAP_(shmem_private_bucket_t))) );
+  int bucketed = MAP_(private_bucketed)( map );
+# endif
 
   /* Validate the map chains */
 
   ulong unmapped_ele_cnt = ele_max;
   for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ ) {
+    MAP_(shmem_private_chain_t) const * chain = MAP_(shmem_private_chain_idx_const)( map, chain_idx );
 
     /* Validate the chain length */
 
-    ulong ver_cnt = chain[ chain_idx ].ver_cnt;
+    ulong ver_cnt = chain->ver_cnt;
 
     ulong ele_cnt = MAP_(private_vcnt_cnt)( ver_cnt );
     MAP_TEST( ele_cnt<=unmapped_ele_cnt );
@@ -2739,7 +3012,7 @@ MAP_(verify)( MAP_(t) const * join ) {
 
     /* Validate chain linkage, element membership and element uniqueness */
 
-    ulong head_idx = MAP_(private_idx)( chain[ chain_idx ].head_cidx );
+    ulong head_idx = MAP_(private_idx)( chain->head_cidx );
     ulong cur_idx  = head_idx;
     for( ulong ele_rem=ele_cnt; ele_rem; ele_rem-- ) {
       MAP_TEST( cur_idx<ele_max );                                           /* In element store */
@@ -2753,6 +3026,15 @@ MAP_(verify)( MAP_(t) const * join ) {
       MAP_TEST( ele[ cur_idx ].MAP_MEMO==memo );
 #     endif
 
+#     if MAP_BUCKET
+      ulong pos = ele_cnt - ele_rem;
+      if( bucketed & (pos<MAP_BUCKET_TAG_CNT) ) {                            /* Bucket mirrors chain */
+        MAP_(shmem_private_bucket_t) const * bucket = (MAP_(shmem_private_bucket_t) const *)chain;
+        MAP_TEST( MAP_(private_idx)( bucket->cidx[ pos ] )==cur_idx );
+        MAP_TEST( bucket->tag[ pos ]==MAP_(private_tag)( memo ) );
+      }
+#     endif
+
       /* Note that we've already validated linkage from head_idx to
          cur_idx so pointer chasing here is safe. */
 
@@ -2808,6 +3090,8 @@ MAP_(strerror)( int err ) {
 
 #endif
 
+#undef MAP_BUCKET_TAG_CNT
+
 #undef MAP_
 #undef MAP_STATIC
 #undef MAP_VER_WIDTH
@@ -2816,6 +3100,7 @@ MAP_(strerror)( int err ) {
 #undef MAP_MAGIC
 #undef MAP_ALIGN
 #undef MAP_CNT_WIDTH
+#undef MAP_BUCKET
 #undef MAP_KEY_EQ_IS_SLOW
 #undef MAP_MEMO
 #undef MAP_MEMOIZE
@@ -28,8 +28,11 @@ typedef struct myele myele_t;
 #define MAP_MEMOIZE        1
 #define MAP_MEMO           mymemo
 #define MAP_KEY_EQ_IS_SLOW 1
+#define MAP_BUCKET         1
 #include "fd_map_chain_para.c"
 
+FD_STATIC_ASSERT( sizeof(mymap_shmem_private_bucket_t)==64UL, unit_test );
+
 FD_STATIC_ASSERT( FD_MAP_SUCCESS    == 0, unit_test );
 FD_STATIC_ASSERT( FD_MAP_ERR_INVAL  ==-1, unit_test );
 FD_STATIC_ASSERT( FD_MAP_ERR_AGAIN  ==-2, unit_test );
@@ -708,6 +711,24 @@ main( int     argc,
   FD_TEST(  mymap_join( map,         shmap,       NULL,        ele_max   )==(ele_max ? NULL : map) ); /* NULL shele */
   FD_TEST( !mymap_join( map,         shmap,       (void *)1UL, ele_max   )      ); /* misaligned shele */
   FD_TEST(  mymap_join( map,         shmap,       shele,       ele_max   )==map );
+  FD_TEST( !mymap_bucketed( map ) );
+
+  FD_TEST( !mymap_bucket_footprint( 0UL          ) ); /* Not a power of 2 */
+  FD_TEST( !mymap_bucket_footprint( chain_max<<1 ) ); /* Too many chains */
+  ulong bucket_footprint = mymap_bucket_footprint( chain_cnt );
+  FD_TEST( fd_ulong_is_aligned( bucket_footprint, align ) );
+  FD_TEST( bucket_footprint>footprint );
+
+  void * shbucket = shmem_alloc( align, bucket_footprint );
+  mymap_t bucket[1];
+
+  FD_TEST( !mymap_bucket_new( NULL,        chain_cnt,    seed )           ); /* NULL shmem */
+  FD_TEST( !mymap_bucket_new( (void *)1UL, chain_cnt,    seed )           ); /* misaligned shmem */
+  FD_TEST( !mymap_bucket_new( shbucket,    0UL,          seed )           ); /* Not a power of 2 */
+  FD_TEST(  mymap_bucket_new( shbucket,    chain_cnt,    seed )==shbucket );
+  FD_TEST(  mymap_join( bucket, shbucket, shele, ele_max )==bucket );
+  FD_TEST(  mymap_bucketed( bucket ) );
+  FD_TEST( !mymap_verify( bucket ) );
 
   FD_LOG_NOTICE(( "Testing accessors" ));
 
@@ -724,14 +745,14 @@ main( int     argc,
   /* FIXME: use tpool here */
 
   tile_pool     = pool;
-  tile_map      = map;
   tile_ele_max  = ele_max;
   tile_iter_cnt = iter_cnt;
 
   ulong tile_max = fd_tile_cnt();
-  for( ulong tile_cnt=1UL; tile_cnt<=tile_max; tile_cnt++ ) {
+  for( ulong layout=0UL; layout<2UL; layout++ ) for( ulong tile_cnt=1UL; tile_cnt<=tile_max; tile_cnt++ ) {
+    tile_map = layout ? bucket : map;
 
-    FD_LOG_NOTICE(( "Testing concurrent operation on %lu tiles", tile_cnt ));
+    FD_LOG_NOTICE(( "Testing concurrent operation on %lu tiles (%s)", tile_cnt, layout ? "bucketed" : "chained" ));
 
     FD_COMPILER_MFENCE();
     FD_VOLATILE( tile_go ) = 0;
@@ -749,10 +770,25 @@ main( int     argc,
     tile_main( 0, (char **)tile_cnt );
     for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ )fd_tile_exec_delete( fd_tile_exec( tile_idx ), NULL );
 
-    FD_TEST( !mymap_verify( map ) );
-    mymap_reset( map );
+    FD_TEST( !mymap_verify( tile_map ) );
+    mymap_reset( tile_map );
   }
 
+  /* Long chains spill past the bucket */
+
+  FD_LOG_NOTICE(( "Testing bucket overflow" ));
+
+  FD_TEST( mymap_leave( bucket )==bucket );
+  FD_TEST( mymap_delete( shbucket )==shbucket );
+  FD_TEST( mymap_join( bucket, mymap_bucket_new( shbucket, 1UL, seed ), shele, ele_max )==bucket );
+  tile_map      = bucket;
+  tile_iter_cnt = fd_ulong_min( iter_cnt, 100000UL );
+  tile_main( 0, (char **)1UL );
+  FD_TEST( !mymap_verify( bucket ) );
+  mymap_reset( bucket );
+  FD_TEST( mymap_leave( bucket )==bucket );
+  FD_TEST( mymap_delete( shbucket )==shbucket );
+
   FD_LOG_NOTICE(( "Testing destruction" ));
 
   FD_TEST( !mymap_leave( NULL )      ); /* NULL join */
@@ -336,6 +336,22 @@ fd_http_server_close( fd_http_server_t * http,
   close_conn( http, conn_id, reason );
 }
 
+int
+fd_http_server_respond( fd_http_server_t *                http,
+                        ulong                             conn_id,
+                        fd_http_server_response_t const * response ) {
+  FD_TEST( conn_id<http->max_conns );
+  FD_TEST( !response->defer );
+
+  struct fd_http_server_connection * conn = &http->conns[ conn_id ];
+  if( FD_UNLIKELY( http->pollfds[ conn_id ].fd==-1 || conn->state!=FD_HTTP_SERVER_CONNECTION_STATE_DEFERRED ) ) return -1;
+
+  conn->state    = FD_HTTP_SERVER_CONNECTION_STATE_WRITING_HEADER;
+  conn->response = *response;
+  if( FD_LIKELY( !conn->response.static_body ) ) conn_treap_ele_insert( http->conn_treap, conn, http->conns );
+  return 0;
+}
+
 void
 fd_http_server_ws_close( fd_http_server_t * http,
                          ulong              ws_conn_id,
@@ -613,6 +629,11 @@ read_conn_http( fd_http_server_t * http,
 
   fd_http_server_response_t response = http->callbacks.request( &request );
   if( FD_LIKELY( http->pollfds[ conn_idx ].fd==-1 ) ) return; /* Connection was closed by callback */
+  if( FD_UNLIKELY( response.defer ) ) {
+    /* Nothing to write until fd_http_server_respond is called */
+    conn->state = FD_HTTP_SERVER_CONNECTION_STATE_DEFERRED;
+    return;
+  }
   conn->response = response;
 
 #if FD_HTTP_SERVER_DEBUG
@@ -792,6 +813,7 @@ write_conn_http( fd_http_server_t * http,
   ulong         response_len;
   switch( conn->state ) {
     case FD_HTTP_SERVER_CONNECTION_STATE_READING:
+    case FD_HTTP_SERVER_CONNECTION_STATE_DEFERRED:
       return; /* No data staged for write yet. */
     case FD_HTTP_SERVER_CONNECTION_STATE_WRITING_HEADER:
       switch( conn->response.status ) {
@@ -1271,6 +1293,12 @@ fd_http_server_stage_len( fd_http_server_t * http ) {
   return http->stage_len;
 }
 
+uchar const *
+fd_http_server_stage_peek( fd_http_server_t * http ) {
+  if( FD_UNLIKELY( http->stage_err ) ) return NULL;
+  return http->oring+(http->stage_off%http->oring_sz);
+}
+
 void
 fd_http_server_printf( fd_http_server_t * http,
                        char const *       fmt,
@@ -135,11 +135,20 @@ typedef struct fd_http_server_request fd_http_server_request_t;
 
    If upgrade_websocket is true, the connection will be upgraded to a
    websocket, after which the handler will begin receiving websocket
-   frames. */
+   frames.
+
+   If defer is true, all other fields are ignored and nothing is sent
+   to the client yet.  The handler must later complete the request by
+   calling fd_http_server_respond with the connection_id of the
+   request, unless the connection is closed first (in which case the
+   close callback is invoked as usual).  This allows a request to be
+   answered asynchronously, for example after work done by another
+   tile. */
 
 struct fd_http_server_response {
   ulong status;                  /* Status code of the HTTP response */
   int   upgrade_websocket;       /* 1 if we should send a websocket upgrade response */
+  int   defer;                   /* 1 if the response will be provided later with fd_http_server_respond */
 
   char const * content_type;     /* Content-Type to set in the HTTP response */
   char const * cache_control;    /* Cache-Control to set in the HTTP response */
@@ -325,6 +334,14 @@ fd_http_server_stage_trunc( fd_http_server_t * http,
 ulong
 fd_http_server_stage_len( fd_http_server_t * http );
 
+/* fd_http_server_stage_peek returns a pointer to the contents of the
+   pending message, which are fd_http_server_stage_len contiguous bytes,
+   or NULL if the staging area is in an error state.  The pointer is
+   invalidated by the next append to the staging area. */
+
+uchar const *
+fd_http_server_stage_peek( fd_http_server_t * http );
+
 /* fd_http_server_printf appends the rendered format string fmt into the
    staging area of the outgoing ring buffer.  Assumes http is a current
    local join.
@@ -393,6 +410,22 @@ int
 fd_http_server_stage_body( fd_http_server_t *          http,
                            fd_http_server_response_t * response );
 
+/* fd_http_server_respond completes a request for which the request
+   callback returned a response with defer set.  conn_id is the
+   connection_id of the request, and response is the response to send,
+   with the same semantics as a response returned from the request
+   callback (the body is typically staged with fd_http_server_stage_body
+   just before calling).  response must not itself be deferred.
+
+   Returns 0 on success and -1 if the connection has no deferred request
+   outstanding, for example because it was closed and its id has since
+   been reused, in which case nothing is sent. */
+
+int
+fd_http_server_respond( fd_http_server_t *                http,
+                        ulong                             conn_id,
+                        fd_http_server_response_t const * response );
+
 /* Send the contents of the staging buffer as a a WebSocket message to a
    single client.  The staging buffer is then cleared.  Returns -1 on
    failure if the ring buffer is an error state, and then clears the
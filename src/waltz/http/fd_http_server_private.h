@@ -8,6 +8,7 @@
 #define FD_HTTP_SERVER_CONNECTION_STATE_READING        0
 #define FD_HTTP_SERVER_CONNECTION_STATE_WRITING_HEADER 1
 #define FD_HTTP_SERVER_CONNECTION_STATE_WRITING_BODY   2
+#define FD_HTTP_SERVER_CONNECTION_STATE_DEFERRED       3
 
 #define FD_HTTP_SERVER_PONG_STATE_NONE    0
 #define FD_HTTP_SERVER_PONG_STATE_WAITING 1
@@ -2,6 +2,11 @@
 #include "fd_http_server_private.h"
 #include "../../util/fd_util.h"
 
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
 void
 test_oring( void ) {
   fd_http_server_params_t params = {
@@ -64,6 +69,7 @@ test_oring( void ) {
   fd_http_server_printf( http, "01234567" );
   FD_TEST( http->stage_off==8UL );
   FD_TEST( http->stage_len==8UL );
+  FD_TEST( !memcmp( fd_http_server_stage_peek( http ), "01234567", 8UL ) );
   fd_http_server_unstage( http );
 
   http->stage_off = 16UL;
@@ -74,15 +80,101 @@ test_oring( void ) {
 
   http->stage_off = 0UL;
   fd_http_server_printf( http, "012345678" );
+  FD_TEST( !fd_http_server_stage_peek( http ) );
   FD_TEST( fd_http_server_stage_body( http, &response ) );
 }
 
+static ulong deferred_conn_id = ULONG_MAX;
+
+static fd_http_server_response_t
+defer_request( fd_http_server_request_t const * request ) {
+  deferred_conn_id = request->connection_id;
+  return (fd_http_server_response_t){ .defer = 1 };
+}
+
+/* poll_recv drives the server for a while and returns everything
+   received on fd, which the server closes once the response is sent. */
+
+static ulong
+poll_recv( fd_http_server_t * http,
+           int                fd,
+           char *             buf,
+           ulong              buf_sz ) {
+  ulong len = 0UL;
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    fd_http_server_poll( http, 1 );
+    long sz = recv( fd, buf+len, buf_sz-len-1UL, MSG_DONTWAIT );
+    if( !sz ) break;
+    if( sz>0L ) len += (ulong)sz;
+    else FD_TEST( errno==EAGAIN );
+  }
+  buf[ len ] = '\0';
+  return len;
+}
+
+void
+test_defer( void ) {
+  fd_http_server_params_t params = {
+    .max_connection_cnt    = 2UL,
+    .max_ws_connection_cnt = 0UL,
+    .max_request_len       = 1<<12,
+    .max_ws_recv_frame_len = 1<<12,
+    .max_ws_send_frame_cnt = 1,
+    .outgoing_buffer_sz    = 1<<12,
+  };
+
+  fd_http_server_callbacks_t callbacks = {
+    .request = defer_request,
+  };
+
+  static uchar scratch[ 1<<16 ] __attribute__((aligned(128UL)));
+  FD_TEST( fd_http_server_footprint( params )<=sizeof(scratch) );
+  fd_http_server_t * http = fd_http_server_join( fd_http_server_new( scratch, params, callbacks, NULL ) );
+  FD_TEST( fd_http_server_listen( http, fd_uint_bswap( 0x7f000001U ), 0 ) );
+
+  struct sockaddr_in addr;
+  socklen_t addr_sz = sizeof(addr);
+  FD_TEST( !getsockname( fd_http_server_fd( http ), fd_type_pun( &addr ), &addr_sz ) );
+
+  int fd = socket( AF_INET, SOCK_STREAM, 0 );
+  FD_TEST( fd>=0 );
+  FD_TEST( !connect( fd, fd_type_pun( &addr ), sizeof(addr) ) );
+
+  char const req[] = "GET /x HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  FD_TEST( send( fd, req, sizeof(req)-1UL, 0 )==(long)(sizeof(req)-1UL) );
+
+  /* The request is deferred, so nothing is written */
+
+  char buf[ 1024 ];
+  FD_TEST( !poll_recv( http, fd, buf, sizeof(buf) ) );
+  FD_TEST( deferred_conn_id<params.max_connection_cnt );
+  FD_TEST( fd_http_server_respond( http, (deferred_conn_id+1UL)%params.max_connection_cnt, &(fd_http_server_response_t){ .status = 200 } )==-1 );
+
+  /* Respond with a staged body */
+
+  fd_http_server_printf( http, "hello" );
+  fd_http_server_response_t response = { .status = 200, .content_type = "text/plain" };
+  FD_TEST( !fd_http_server_stage_body( http, &response ) );
+  FD_TEST( !fd_http_server_respond( http, deferred_conn_id, &response ) );
+  FD_TEST( fd_http_server_respond( http, deferred_conn_id, &response )==-1 );
+
+  ulong len = poll_recv( http, fd, buf, sizeof(buf) );
+  FD_TEST( len );
+  FD_TEST( !strncmp( buf, "HTTP/1.1 200 OK\r\n", 17UL ) );
+  FD_TEST( strstr( buf, "Content-Type: text/plain\r\n" ) );
+  FD_TEST( !strcmp( buf+len-5UL, "hello" ) );
+
+  FD_TEST( !close( fd ) );
+  FD_TEST( !close( fd_http_server_fd( http ) ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
   fd_boot( &argc, &argv );
 
   test_oring();
+  test_defer();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
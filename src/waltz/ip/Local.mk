@@ -6,4 +6,7 @@ $(call make-unit-test,test_fib4_netlink,test_fib4_netlink,fd_waltz fd_util)
 $(call run-unit-test,test_fib4_netlink)
 endif
 $(call make-unit-test,test_fib4,test_fib4,fd_waltz fd_util)
-$(call run-unit-test,test_fib4)
+# Two floating tiles, so LPM rebuilds race lookups even on one CPU
+test_fib4_args:=--tile-cpus f,f
+$(call run-unit-test,test_fib4,$(test_fib4_args))
+$(call make-unit-test,bench_fib4,bench_fib4,fd_waltz fd_util)
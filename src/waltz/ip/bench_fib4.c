@@ -0,0 +1,108 @@
+#include "fd_fib4.h"
+#include "fd_fib4_private.h"
+
+/* bench_fib4 measures fd_fib4_lookup throughput for route tables of
+   1K to --route-max routes.  Prefix lengths loosely follow an Internet
+   routing table (mostly /24, some /16 to /23, few shorter).  For each
+   table size, reports the time to build the LPM index and the lookup
+   rate with the index.  For tables up to --scan-max routes, also reports
+   the lookup rate of the route table scan used without an index. */
+
+#define FIB_TAG 1UL
+
+static int
+rand_prefix( fd_rng_t * rng ) {
+  uint r = fd_rng_uint_roll( rng, 100U );
+  if( r<60U ) return 24;
+  if( r<95U ) return 16 + (int)fd_rng_uint_roll( rng, 8U );
+  return 8 + (int)fd_rng_uint_roll( rng, 8U );
+}
+
+__attribute__((noinline)) static ulong
+run_lookups( fd_fib4_t const * fib,
+             fd_rng_t *        rng,
+             ulong             iter_cnt ) {
+  ulong acc = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_fib4_hop_t hop;
+    acc += fd_fib4_lookup( fib, &hop, fd_rng_uint( rng ), 0 )->if_idx;
+  }
+  return acc;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * name      = fd_env_strip_cmdline_cstr ( &argc, &argv, "--wksp",      NULL,            NULL );
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        route_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--route-max", NULL,        1UL<<20 );
+  ulong        scan_max  = fd_env_strip_cmdline_ulong( &argc, &argv, "--scan-max",  NULL,        1UL<<14 );
+  ulong        iter_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt",  NULL,        1UL<<22 );
+  uint         rng_seed  = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed",  NULL,           1234U );
+
+  if( FD_UNLIKELY( route_max<1024UL ) ) FD_LOG_ERR(( "--route-max must be at least 1024" ));
+
+  fd_rng_t rng_[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( rng_, rng_seed, 0UL ) );
+
+  fd_wksp_t * wksp;
+  if( name ) {
+    FD_LOG_NOTICE(( "Attaching to --wksp %s", name ));
+    wksp = fd_wksp_attach( name );
+  } else {
+    FD_LOG_NOTICE(( "--wksp not specified, using an anonymous local workspace, --page-sz %s, --page-cnt %lu, --near-cpu %lu",
+                    _page_sz, page_cnt, near_cpu ));
+    wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  }
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
+
+  for( ulong route_cnt=1024UL; route_cnt<=route_max; route_cnt<<=2 ) {
+    ulong  footprint = fd_fib4_footprint( route_cnt+1UL, 1UL );
+    void * fib_mem   = fd_wksp_alloc_laddr( wksp, fd_fib4_align(), footprint, FIB_TAG );
+    if( FD_UNLIKELY( !fib_mem ) ) FD_LOG_ERR(( "failed to allocate fib4 with %lu routes (%lu bytes)", route_cnt, footprint ));
+    fd_fib4_t * fib = fd_fib4_join( fd_fib4_new( fib_mem, route_cnt+1UL, 1UL, 1234UL ) );
+    FD_TEST( fib );
+
+    for( ulong j=0UL; j<route_cnt; j++ ) {
+      int  prefix = rand_prefix( rng );
+      uint addr   = fd_rng_uint( rng ) & fd_uint_mask( 32-prefix, 31 );
+      fd_fib4_hop_t hop = { .rtype=FD_FIB4_RTYPE_UNICAST, .if_idx=(uint)j+1U };
+      FD_TEST( fd_fib4_insert( fib, fd_uint_bswap( addr ), prefix, 0U, &hop ) );
+    }
+
+    if( route_cnt<=scan_max ) {
+      ulong scan_iter = fd_ulong_max( iter_cnt/route_cnt, 1024UL );
+      long dt = -fd_log_wallclock();
+      ulong acc = run_lookups( fib, rng, scan_iter );
+      dt += fd_log_wallclock();
+      FD_COMPILER_FORGET( acc );
+      FD_LOG_NOTICE(( "%8lu routes: scan %10.1f ns/lookup", route_cnt, (double)dt/(double)scan_iter ));
+    }
+
+    long build_dt = -fd_log_wallclock();
+    fd_fib4_lpm_build( fib );
+    build_dt += fd_log_wallclock();
+
+    ulong acc = run_lookups( fib, rng, iter_cnt>>4 ); /* warm up */
+    long dt = -fd_log_wallclock();
+    acc += run_lookups( fib, rng, iter_cnt );
+    dt += fd_log_wallclock();
+    FD_COMPILER_FORGET( acc );
+    FD_LOG_NOTICE(( "%8lu routes: lpm  %10.1f ns/lookup (%lu ranges, %lu KiB, built in %.3f ms)",
+                    route_cnt, (double)dt/(double)iter_cnt, fib->lpm_range_cnt, footprint>>10, (double)build_dt/1e6 ));
+
+    fd_wksp_free_laddr( fd_fib4_delete( fd_fib4_leave( fib ) ) );
+  }
+
+  if( name ) fd_wksp_detach( wksp );
+  else       fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -15,7 +15,7 @@ fd_fib4_align( void ) {
 FD_FN_CONST ulong
 fd_fib4_footprint( ulong route_max,
                    ulong route_peer_max ) {
-  if( route_max==0 || route_max>UINT_MAX ||
+  if( route_max==0 || route_max>(UINT_MAX>>1) ||
       route_peer_max==0 || route_peer_max>UINT_MAX ) return 0UL;
   ulong elem_max       = fd_fib4_hmap_get_ele_max( route_peer_max   );
   ulong probe_max      = fd_fib4_hmap_get_probe_max( elem_max );
@@ -23,12 +23,19 @@ fd_fib4_footprint( ulong route_max,
   ulong hmap_footprint = fd_fib4_hmap_footprint( elem_max, lock_cnt, probe_max );
   if( !hmap_footprint ) return 0UL;
 
-  return FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,
-      alignof(fd_fib4_t),            sizeof(fd_fib4_t)                     ),
-      alignof(fd_fib4_key_t),        route_max*sizeof(fd_fib4_key_t)       ),
-      alignof(fd_fib4_hop_t),        route_max*sizeof(fd_fib4_hop_t)       ),
-      fd_fib4_hmap_align(),          hmap_footprint                        ),
-      alignof(fd_fib4_hmap_entry_t), elem_max*sizeof(fd_fib4_hmap_entry_t) ),
+  ulong dir_cnt        = 1UL<<fd_fib4_lpm_dir_bits( route_max );
+  ulong range_max      = fd_fib4_lpm_range_max( route_max );
+
+  return FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND(
+                         FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,
+      alignof(fd_fib4_t),            sizeof(fd_fib4_t)                      ),
+      alignof(fd_fib4_key_t),        route_max*sizeof(fd_fib4_key_t)        ),
+      alignof(fd_fib4_hop_t),        route_max*sizeof(fd_fib4_hop_t)        ),
+      fd_fib4_hmap_align(),          hmap_footprint                         ),
+      alignof(fd_fib4_hmap_entry_t), elem_max*sizeof(fd_fib4_hmap_entry_t)  ),
+      alignof(fd_fib4_lpm_dir_t),    dir_cnt*sizeof(fd_fib4_lpm_dir_t)      ),
+      alignof(fd_fib4_lpm_range_t),  range_max*sizeof(fd_fib4_lpm_range_t)  ),
+      alignof(fd_fib4_lpm_rt_t),     route_max*sizeof(fd_fib4_lpm_rt_t)     ),
       alignof(fd_fib4_t) );
 }
 
@@ -46,7 +53,7 @@ fd_fib4_new( void * mem,
     FD_LOG_WARNING(( "unaligned mem" ));
     return NULL;
   }
-  if( FD_UNLIKELY( route_max==0 || route_max>UINT_MAX ) ) {
+  if( FD_UNLIKELY( route_max==0 || route_max>(UINT_MAX>>1) ) ) {
     FD_LOG_WARNING(( "invalid route_max" ));
     return NULL;
   }
@@ -66,6 +73,10 @@ fd_fib4_new( void * mem,
   FD_TEST( hmap_footprint );
   void * fib4_hmap_mem     = FD_SCRATCH_ALLOC_APPEND( l, fd_fib4_hmap_align(), hmap_footprint );
   void * fib4_hmap_ele_mem = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_fib4_hmap_entry_t), hmap_elem_max*sizeof(fd_fib4_hmap_entry_t) );
+  ulong lpm_dir_bits       = fd_fib4_lpm_dir_bits( route_max );
+  void * lpm_dir_mem       = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_fib4_lpm_dir_t),   (1UL<<lpm_dir_bits)*sizeof(fd_fib4_lpm_dir_t) );
+  void * lpm_range_mem     = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_fib4_lpm_range_t), fd_fib4_lpm_range_max( route_max )*sizeof(fd_fib4_lpm_range_t) );
+  void * lpm_scratch_mem   = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_fib4_lpm_rt_t),    route_max*sizeof(fd_fib4_lpm_rt_t) );
   FD_TEST( fib4_hmap_mem );
   FD_TEST( fib4_hmap_ele_mem );
   FD_SCRATCH_ALLOC_FINI( l, alignof(fd_fib4_t) );
@@ -84,6 +95,11 @@ fd_fib4_new( void * mem,
   fib4->hmap_elem_offset = (ulong)fib4_hmap_ele_mem - (ulong)fib4;
   fib4->hmap_max         = route_peer_max;
   fib4->hmap_cnt         = 0;
+  fib4->lpm_gen          = ULONG_MAX; /* no index yet */
+  fib4->lpm_dir_bits     = lpm_dir_bits;
+  fib4->lpm_dir_off      = (ulong)lpm_dir_mem     - (ulong)fib4;
+  fib4->lpm_range_off    = (ulong)lpm_range_mem   - (ulong)fib4;
+  fib4->lpm_scratch_off  = (ulong)lpm_scratch_mem - (ulong)fib4;
   keys[0].prio           = UINT_MAX;
   vals[0].rtype          = FD_FIB4_RTYPE_THROW;
 
@@ -107,7 +123,14 @@ fd_fib4_delete( void * mem ) {
 
 void
 fd_fib4_clear( fd_fib4_t * fib4 ) {
+  ulong const generation = fib4->generation;
+  FD_COMPILER_MFENCE();
+  fib4->generation = generation+1UL;
+  FD_COMPILER_MFENCE();
   fib4->cnt = 1UL;
+  FD_COMPILER_MFENCE();
+  fib4->generation = generation+2UL;
+  FD_COMPILER_MFENCE();
 
   if( fib4->hmap_cnt==0 ) return;
 
@@ -208,17 +231,120 @@ fd_fib4_insert( fd_fib4_t *     fib,
     .prio = prio
   };
   fd_fib4_hop_t * entry = fd_fib4_hop_tbl( fib ) + idx;
+  FD_TEST( hop );
+  fd_memcpy( entry, hop, sizeof(fd_fib4_hop_t) );
 
   FD_COMPILER_MFENCE();
   fib->generation = generation+2UL;
   FD_COMPILER_MFENCE();
 
-  FD_TEST( hop );
-  fd_memcpy( entry, hop, sizeof(fd_fib4_hop_t) );
-
   return 1;
 }
 
+#define SORT_NAME        fd_fib4_lpm_sort
+#define SORT_KEY_T       fd_fib4_lpm_rt_t
+#define SORT_BEFORE(a,b) ( (a).lo!=(b).lo   ? (a).lo<(b).lo     : \
+                           (a).hi!=(b).hi   ? (a).hi>(b).hi     : \
+                           (a).prio!=(b).prio ? (a).prio<(b).prio : \
+                           (a).idx<(b).idx )
+#include "../../util/tmpl/fd_sort.c"
+
+/* fd_fib4_lpm_push appends a range starting at start.  A range already
+   starting at start is superseded, and ranges resolving to the same
+   route as their predecessor are merged into it. */
+
+static void
+fd_fib4_lpm_push( fd_fib4_lpm_range_t * range,
+                  ulong *               range_cnt,
+                  uint                  start,
+                  uint                  idx ) {
+  ulong cnt = *range_cnt;
+  if( cnt && range[ cnt-1UL ].start==start ) cnt--;
+  if( cnt && range[ cnt-1UL ].idx==idx ) {
+    *range_cnt = cnt;
+    return;
+  }
+  range[ cnt ] = (fd_fib4_lpm_range_t){ .start=start, .idx=idx };
+  *range_cnt = cnt+1UL;
+}
+
+void
+fd_fib4_lpm_build( fd_fib4_t * fib ) {
+
+  ulong const generation = fib->generation;
+  FD_COMPILER_MFENCE();
+  fib->generation = generation+1UL;
+  FD_COMPILER_MFENCE();
+
+  /* Gather routes as address ranges.  Routes with bits set outside of
+     the mask never match (see fd_fib4_lookup) and are left out. */
+
+  fd_fib4_key_t const * keys   = fd_fib4_key_tbl_const( fib );
+  fd_fib4_lpm_rt_t *    rt     = fd_fib4_lpm_scratch( fib );
+  ulong                 rt_cnt = 0UL;
+  ulong                 cnt    = fib->cnt;
+  for( ulong j=0UL; j<cnt; j++ ) {
+    uint addr = keys[j].addr;
+    uint mask = keys[j].mask;
+    if( FD_UNLIKELY( addr & ~mask ) ) continue;
+    rt[ rt_cnt++ ] = (fd_fib4_lpm_rt_t){ .lo=addr, .hi=addr|~mask, .prio=keys[j].prio, .idx=(uint)j };
+  }
+
+  /* Sorting by start address, then by decreasing size yields a pre-order
+     walk of the prefix tree, with the preferred route first among
+     duplicate prefixes.  The dummy route at index 0 is always first. */
+
+  fd_fib4_lpm_sort_inplace( rt, rt_cnt );
+
+  /* Sweep over the prefixes, tracking the chain of prefixes containing
+     the current address.  Each prefix opens a range at its start and at
+     most one more range at its end (where the enclosing prefix takes
+     over again).  Prefixes are nested, so the chain is at most 33 deep. */
+
+  fd_fib4_lpm_range_t *    range     = fd_fib4_lpm_range( fib );
+  ulong                    range_cnt = 0UL;
+  fd_fib4_lpm_rt_t const * stack[ 33 ];
+  ulong                    depth     = 0UL;
+
+  stack[ depth++ ] = rt;
+  fd_fib4_lpm_push( range, &range_cnt, 0U, rt[0].idx );
+  for( ulong j=1UL; j<rt_cnt; j++ ) {
+    fd_fib4_lpm_rt_t const * r = rt+j;
+    if( r->lo==r[-1].lo && r->hi==r[-1].hi ) continue; /* shadowed duplicate */
+    while( stack[ depth-1UL ]->hi < r->lo ) {
+      uint end = stack[ --depth ]->hi;
+      fd_fib4_lpm_push( range, &range_cnt, end+1U, stack[ depth-1UL ]->idx );
+    }
+    fd_fib4_lpm_push( range, &range_cnt, r->lo, r->idx );
+    stack[ depth++ ] = r;
+  }
+  while( depth>1UL ) {
+    uint end = stack[ --depth ]->hi;
+    if( end!=UINT_MAX ) fd_fib4_lpm_push( range, &range_cnt, end+1U, stack[ depth-1UL ]->idx );
+  }
+
+  /* Point each direct table block to the ranges overlapping it */
+
+  fd_fib4_lpm_dir_t * dir   = fd_fib4_lpm_dir( fib );
+  ulong               bits  = fib->lpm_dir_bits;
+  ulong               shift = 32UL-bits;
+  ulong               r     = 0UL;
+  for( ulong b=0UL; b<(1UL<<bits); b++ ) {
+    ulong lo = b<<shift;
+    ulong hi = lo + (1UL<<shift) - 1UL;
+    while( r+1UL<range_cnt && range[ r+1UL ].start<=lo ) r++;
+    ulong e = r+1UL;
+    while( e<range_cnt && range[ e ].start<=hi ) e++;
+    dir[ b ] = (fd_fib4_lpm_dir_t){ .base=(uint)r, .cnt=(uint)(e-r) };
+  }
+
+  fib->lpm_range_cnt = range_cnt;
+  fib->lpm_gen       = generation+2UL;
+  FD_COMPILER_MFENCE();
+  fib->generation = generation+2UL;
+  FD_COMPILER_MFENCE();
+}
+
 fd_fib4_hop_t const *
 fd_fib4_lookup( fd_fib4_t const * fib,
                 fd_fib4_hop_t *   out,
@@ -258,19 +384,24 @@ fd_fib4_lookup( fd_fib4_t const * fib,
   ulong generation = FD_VOLATILE_CONST( fib->generation );
   FD_COMPILER_MFENCE();
 
-  ulong best_idx  = 0UL; /* dead route */
-  int   best_mask = 32;  /* least specific mask (/0) */
-  ulong cnt       = fib->cnt;
-  for( ulong j=0UL; j<cnt; j++ ) {
-    /* FIXME consider branch variant? */
-    int match         = (ip4_dst & keys[j].mask)==keys[j].addr;
-    int mask_bits     = fd_uint_find_lsb_w_default( keys[j].mask, 32 );
-    int more_specific = mask_bits< best_mask;
-    int less_costly   = mask_bits==best_mask && keys[j].prio<keys[best_idx].prio;
-    int better        = match && (more_specific || less_costly);
-    if( better ) {
-      best_idx  = j;
-      best_mask = mask_bits;
+  ulong best_idx = 0UL; /* dead route */
+  if( FD_LIKELY( fib->lpm_gen==generation ) ) {
+    best_idx = fd_fib4_lpm_query( fib, ip4_dst );
+  } else {
+    /* Route table was modified since the last fd_fib4_lpm_build */
+    int   best_mask = 32;  /* least specific mask (/0) */
+    ulong cnt       = fd_ulong_min( fib->cnt, fib->max );
+    for( ulong j=0UL; j<cnt; j++ ) {
+      /* FIXME consider branch variant? */
+      int match         = (ip4_dst & keys[j].mask)==keys[j].addr;
+      int mask_bits     = fd_uint_find_lsb_w_default( keys[j].mask, 32 );
+      int more_specific = mask_bits< best_mask;
+      int less_costly   = mask_bits==best_mask && keys[j].prio<keys[best_idx].prio;
+      int better        = match && (more_specific || less_costly);
+      if( better ) {
+        best_idx  = j;
+        best_mask = mask_bits;
+      }
     }
   }
   *out = fd_fib4_hop_tbl_const( fib )[ best_idx ];
@@ -3,8 +3,12 @@
 
 /* A fib4 stores IPv4 routes in a query-optimized data structure.
 
-   fib4 does not scale well to large numbers of routes.  Every route
-   lookup is O(n) where n is the number of routes in the FIB.
+   /32 routes are kept in a hash map.  All other routes are kept in a
+   route table, which is indexed by a longest-prefix-match structure
+   (built by fd_fib4_lpm_build) that resolves lookups in a direct table
+   access and a short binary search, independent of the number of
+   routes.  Until the index is rebuilt after a modification, lookups
+   fall back to an O(n) scan of the route table.
 
    fib4 only supports a minimal set of features required for end devices
    to operate.  Packet forwarding is not supported.
@@ -15,8 +19,6 @@
 
    A fib4 always has a dummy route at index 0.
 
-   FIXME: CONSIDER TRIE BASED DATA STRUCTURE
-
    Trivia: https://en.wikipedia.org/wiki/Forwarding_information_base */
 
 #include "../../util/fd_util_base.h"
@@ -111,6 +113,15 @@ fd_fib4_insert( fd_fib4_t *     fib,
                 uint            prio,
                 fd_fib4_hop_t * hop );
 
+/* fd_fib4_lpm_build rebuilds the lookup index over the route table.
+   Should be called once after a batch of fd_fib4_{clear,insert} calls.
+   Any modification invalidates the index, after which lookups are O(n)
+   in the number of routes until the next rebuild.  Takes O(n log n)
+   time and does not allocate. */
+
+void
+fd_fib4_lpm_build( fd_fib4_t * fib );
+
 /* Read APIs *************************************************************/
 
 /* fd_fib4_lookup resolves the next hop for an arbitrary IPv4 address.
@@ -238,6 +238,8 @@ fd_fib4_netlink_load_table( fd_fib4_t *    fib,
     return FD_FIB_NETLINK_ERR_SPACE;
   }
 
+  fd_fib4_lpm_build( fib );
+
   if( dump_intr ) {
     FD_LOG_DEBUG(( "received NLM_F_DUMP_INTR (our read of the routing table was overrun by a concurrent write)" ));
     return FD_FIB_NETLINK_ERR_INTR;
@@ -10,6 +10,9 @@ fib1_mem[ 1<<18 ];
 static uchar __attribute__((aligned(FD_FIB4_ALIGN)))
 fib2_mem[ 1<<18 ];
 
+static uchar __attribute__((aligned(FD_FIB4_ALIGN)))
+fib3_mem[ 1<<18 ];
+
 #if FD_HAS_HOSTED
 #include <stdio.h>
 
@@ -404,6 +407,182 @@ test_fib4_hmap( fd_fib4_t * fib ) {
   test_fib4_mix( fib );
 }
 
+/* test_fib4_lpm checks that lookups through the LPM index match the
+   route table scan for a random set of overlapping routes.  Addresses
+   are drawn from a few /12s such that prefixes nest and collide. */
+
+#define LPM_QUERY_MAX (4096UL)
+
+static uint lpm_query[ LPM_QUERY_MAX ];
+static uint lpm_expect[ LPM_QUERY_MAX ];
+
+static ulong
+test_fib4_lpm_queries( fd_fib4_t const * fib,
+                       fd_rng_t *        rng,
+                       uint const *      route_lo,
+                       uint const *      route_hi,
+                       ulong             route_cnt ) {
+  ulong cnt = 0UL;
+  for( ulong j=0UL; j<route_cnt && cnt+4UL<=LPM_QUERY_MAX; j++ ) {
+    lpm_query[ cnt++ ] = route_lo[j]-1U;
+    lpm_query[ cnt++ ] = route_lo[j];
+    lpm_query[ cnt++ ] = route_hi[j];
+    lpm_query[ cnt++ ] = route_hi[j]+1U;
+  }
+  while( cnt<LPM_QUERY_MAX ) lpm_query[ cnt++ ] = fd_rng_uint( rng ) & 0xc0ffffffU;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_fib4_hop_t hop;
+    lpm_expect[ i ] = fd_fib4_lookup( fib, &hop, fd_uint_bswap( lpm_query[ i ] ), 0 )->if_idx;
+  }
+  return cnt;
+}
+
+static void
+test_fib4_lpm( fd_fib4_t * fib,
+               fd_rng_t *  rng ) {
+  static uint route_lo[ 512 ];
+  static uint route_hi[ 512 ];
+
+  for( ulong iter=0UL; iter<32UL; iter++ ) {
+    fd_fib4_clear( fib );
+    FD_TEST( fib->lpm_gen!=fib->generation );
+
+    ulong route_cnt = fd_rng_ulong_roll( rng, fd_fib4_max( fib ) );
+    for( ulong j=0UL; j<route_cnt; j++ ) {
+      int  prefix = (int)fd_rng_uint_roll( rng, 32U );
+      uint mask   = prefix ? fd_uint_mask( 32-prefix, 31 ) : 0U;
+      uint addr   = ( fd_rng_uint_roll( rng, 4U )<<30 ) | ( fd_rng_uint( rng ) & 0x000fffffU );
+      if( fd_rng_uint_roll( rng, 8U ) ) addr &= mask; /* else: never matches */
+      route_lo[ j ] = addr & mask;
+      route_hi[ j ] = addr | ~mask;
+      fd_fib4_hop_t hop = { .rtype=FD_FIB4_RTYPE_UNICAST, .if_idx=(uint)j+1U };
+      FD_TEST( fd_fib4_insert( fib, fd_uint_bswap( addr ), prefix, fd_rng_uint_roll( rng, 3U ), &hop ) );
+    }
+
+    /* Expected results come from the route table scan */
+    ulong query_cnt = test_fib4_lpm_queries( fib, rng, route_lo, route_hi, route_cnt );
+
+    fd_fib4_lpm_build( fib );
+    FD_TEST( fib->lpm_gen==fib->generation );
+    FD_TEST( fib->lpm_range_cnt<=fd_fib4_lpm_range_max( route_cnt+1UL ) );
+    for( ulong i=0UL; i<query_cnt; i++ ) {
+      fd_fib4_hop_t hop;
+      FD_TEST( fd_fib4_lookup( fib, &hop, fd_uint_bswap( lpm_query[ i ] ), 0 )->if_idx==lpm_expect[ i ] );
+    }
+
+    /* Inserting a route invalidates the index */
+    if( route_cnt+1UL<fd_fib4_max( fib ) ) {
+      fd_fib4_hop_t hop = { .rtype=FD_FIB4_RTYPE_UNICAST, .if_idx=9999U };
+      FD_TEST( fd_fib4_insert( fib, FD_IP4_ADDR( 64,1,2,0 ), 24, 0U, &hop ) );
+      FD_TEST( fib->lpm_gen!=fib->generation );
+      FD_TEST( fd_fib4_lookup( fib, &hop, FD_IP4_ADDR( 64,1,2,3 ), 0 )->if_idx==9999U );
+      fd_fib4_lpm_build( fib );
+      FD_TEST( fd_fib4_lookup( fib, &hop, FD_IP4_ADDR( 64,1,2,3 ), 0 )->if_idx==9999U );
+    }
+  }
+
+  /* The dummy route resolves everything in an empty table */
+  fd_fib4_clear( fib );
+  fd_fib4_lpm_build( fib );
+  FD_TEST( fib->lpm_range_cnt==1UL );
+  fd_fib4_hop_t hop;
+  FD_TEST( fd_fib4_lookup( fib, &hop, FD_IP4_ADDR( 1,2,3,4 ), 0 )->rtype==FD_FIB4_RTYPE_THROW );
+  FD_TEST( fd_fib4_lookup( fib, &hop, 0xffffffffU,           0 )->rtype==FD_FIB4_RTYPE_THROW );
+}
+
+/* test_fib4_lpm_torn checks that lookups stay within the fib when the
+   LPM index they read is garbage, as it is when a rebuild races the
+   lookup.  The torn result itself is discarded by the generation check
+   in fd_fib4_lookup, so only the dead route or a route of the table
+   may come out. */
+
+static void
+test_fib4_lpm_torn( fd_fib4_t * fib,
+                    fd_rng_t *  rng ) {
+  fd_fib4_clear( fib );
+  fd_fib4_hop_t hop = { .rtype=FD_FIB4_RTYPE_UNICAST, .if_idx=1U };
+  FD_TEST( fd_fib4_insert( fib, FD_IP4_ADDR( 10,0,0,0 ), 8, 0U, &hop ) );
+  fd_fib4_lpm_build( fib );
+
+  fd_fib4_lpm_dir_t *   dir   = fd_fib4_lpm_dir( fib );
+  fd_fib4_lpm_range_t * range = fd_fib4_lpm_range( fib );
+  ulong dir_cnt   = 1UL<<fib->lpm_dir_bits;
+  ulong range_max = fd_fib4_lpm_range_max( fib->max );
+  for( ulong b=0UL; b<dir_cnt; b++ ) dir[ b ] = (fd_fib4_lpm_dir_t){ .base=fd_rng_uint( rng ), .cnt=fd_rng_uint( rng ) };
+  for( ulong r=0UL; r<range_max; r++ ) range[ r ] = (fd_fib4_lpm_range_t){ .start=fd_rng_uint( rng ), .idx=fd_rng_uint( rng ) };
+  dir[ 0 ]         = (fd_fib4_lpm_dir_t){ .base=UINT_MAX, .cnt=UINT_MAX };
+  dir[ dir_cnt-1 ] = (fd_fib4_lpm_dir_t){ .base=(uint)range_max-1U, .cnt=UINT_MAX };
+  FD_TEST( fib->lpm_gen==fib->generation );
+
+  for( ulong i=0UL; i<65536UL; i++ ) {
+    uint          ip4_dst = i==0UL ? 0U : i==1UL ? UINT_MAX : fd_rng_uint( rng );
+    fd_fib4_hop_t out;
+    uchar         rtype   = fd_fib4_lookup( fib, &out, ip4_dst, 0 )->rtype;
+    FD_TEST( rtype==FD_FIB4_RTYPE_THROW || rtype==FD_FIB4_RTYPE_UNICAST );
+  }
+
+  fd_fib4_lpm_build( fib );
+  FD_TEST( fd_fib4_lookup( fib, &hop, FD_IP4_ADDR( 10,1,2,3 ), 0 )->if_idx==1U );
+  FD_TEST( fd_fib4_lookup( fib, &hop, FD_IP4_ADDR( 11,1,2,3 ), 0 )->rtype==FD_FIB4_RTYPE_THROW );
+}
+
+/* test_fib4_lpm_concurrent runs lookups on another tile while the route
+   table is rewritten and its LPM index rebuilt over and over, like the
+   net tile does while the netlink tile updates the fib.  Lookups must
+   resolve to the dead route, a blackhole (torn read), or one of the
+   routes of the table. */
+
+static fd_fib4_t * lpm_tile_fib;
+static volatile int lpm_tile_done;
+
+static int
+test_fib4_lpm_reader( int     argc,
+                      char ** argv ) {
+  (void)argc; (void)argv;
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 5678U, 0UL ) );
+  ulong lookup_cnt = 0UL;
+  while( !lpm_tile_done ) {
+    fd_fib4_hop_t out;
+    fd_fib4_hop_t const * hop = fd_fib4_lookup( lpm_tile_fib, &out, fd_uint_bswap( fd_rng_uint( rng ) & 0xc0ffffffU ), 0 );
+    FD_TEST( hop->rtype==FD_FIB4_RTYPE_THROW || hop->rtype==FD_FIB4_RTYPE_BLACKHOLE ||
+             ( hop->rtype==FD_FIB4_RTYPE_UNICAST && hop->if_idx>=1U && hop->if_idx<=fd_fib4_max( lpm_tile_fib ) ) );
+    lookup_cnt++;
+  }
+  FD_LOG_NOTICE(( "%lu lookups during rebuilds", lookup_cnt ));
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return 0;
+}
+
+static void
+test_fib4_lpm_concurrent( fd_fib4_t * fib,
+                          fd_rng_t *  rng ) {
+  if( FD_UNLIKELY( fd_tile_cnt()<2UL ) ) {
+    FD_LOG_WARNING(( "skip: concurrent LPM test needs at least 2 tiles" ));
+    return;
+  }
+
+  lpm_tile_fib  = fib;
+  lpm_tile_done = 0;
+  fd_tile_exec_t * exec = fd_tile_exec_new( 1UL, test_fib4_lpm_reader, 0, NULL );
+  FD_TEST( exec );
+
+  for( ulong iter=0UL; iter<4096UL; iter++ ) {
+    fd_fib4_clear( fib );
+    ulong route_cnt = fd_rng_ulong_roll( rng, fd_fib4_max( fib ) );
+    for( ulong j=0UL; j<route_cnt; j++ ) {
+      int  prefix = 1+(int)fd_rng_uint_roll( rng, 31U );
+      uint mask   = fd_uint_mask( 32-prefix, 31 );
+      uint addr   = ( ( fd_rng_uint_roll( rng, 4U )<<30 ) | ( fd_rng_uint( rng ) & 0x000fffffU ) ) & mask;
+      fd_fib4_hop_t hop = { .rtype=FD_FIB4_RTYPE_UNICAST, .if_idx=(uint)j+1U };
+      FD_TEST( fd_fib4_insert( fib, fd_uint_bswap( addr ), prefix, fd_rng_uint_roll( rng, 3U ), &hop ) );
+    }
+    fd_fib4_lpm_build( fib );
+  }
+
+  lpm_tile_done = 1;
+  FD_TEST( !fd_tile_exec_delete( exec, NULL ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -537,6 +716,16 @@ main( int     argc,
   test_fib4_hmap( fib_main );
   test_fib4_hmap( fib_main );   // test again
 
+  /* Test the LPM index */
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+  FD_TEST( fd_fib4_footprint( 512UL, 16UL )<=sizeof(fib3_mem) );
+  fd_fib4_t * fib_lpm = fd_fib4_join( fd_fib4_new( fib3_mem, 512UL, 16UL, 123456UL ) );
+  test_fib4_lpm( fib_lpm, rng );
+  test_fib4_lpm_torn( fib_lpm, rng );
+  test_fib4_lpm_concurrent( fib_lpm, rng );
+  fd_fib4_delete( fd_fib4_leave( fib_lpm ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   fd_fib4_delete( fd_fib4_leave( fib_local ) );
   fd_fib4_delete( fd_fib4_leave( fib_main  ) );
 
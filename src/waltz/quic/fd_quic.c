@@ -328,6 +328,7 @@ fd_quic_set_clock( fd_quic_t *   quic,
   config->idle_timeout = (ulong)( ratio * (double)config->idle_timeout );
   config->ack_delay    = (ulong)( ratio * (double)config->ack_delay    );
   config->retry_ttl    = (ulong)( ratio * (double)config->retry_ttl    );
+  config->session_ticket_ttl = (ulong)( ratio * (double)config->session_ticket_ttl );
   /* Add more timing config here */
 
   config->tick_per_us = tick_per_us;
@@ -520,6 +521,16 @@ fd_quic_init( fd_quic_t * quic ) {
 
   /* State: Initialize TLS */
 
+  /* Session tickets are issued with a lifetime of session_ticket_ttl,
+     rounded down to seconds (but at least 1s if enabled). */
+
+  ulong ticket_lifetime = 0UL;
+  if( config->session_ticket_ttl ) {
+    ticket_lifetime = (ulong)( (double)config->session_ticket_ttl / ( config->tick_per_us * 1e6 ) );
+    ticket_lifetime = fd_ulong_min( fd_ulong_max( ticket_lifetime, 1UL ), FD_TLS_TICKET_LIFETIME_MAX );
+  }
+  int is_server = config->role==FD_QUIC_ROLE_SERVER;
+
   fd_quic_tls_cfg_t tls_cfg = {
     .max_concur_handshakes = limits->handshake_cnt,
 
@@ -527,6 +538,9 @@ fd_quic_init( fd_quic_t * quic ) {
     .secret_cb             = fd_quic_tls_cb_secret,
     .handshake_complete_cb = fd_quic_tls_cb_handshake_complete,
     .peer_params_cb        = fd_quic_tls_cb_peer_params,
+    .session_cb            = ( !is_server && ticket_lifetime ) ? fd_quic_tls_cb_session : NULL,
+
+    .ticket_lifetime       = is_server ? (uint)ticket_lifetime : 0U,
 
     .signer = {
       .ctx     = config->sign_ctx,
@@ -583,6 +597,11 @@ fd_quic_init( fd_quic_t * quic ) {
     return NULL;
   }
 
+  /* Session resumption */
+
+  state->ticket_key_rotate_at = fd_quic_now( quic ) + config->session_ticket_ttl;
+  fd_memset( state->session_cache, 0, sizeof(state->session_cache) );
+
   /* Initialize transport params */
 
   fd_quic_transport_params_t * tp = &state->transport_params;
@@ -1778,7 +1797,8 @@ fd_quic_handle_v1_initial( fd_quic_t *               quic,
         (void*)conn,
         1 /*is_server*/,
         tp,
-        state->now );
+        state->now,
+        NULL );
     fd_quic_tls_hs_cache_ele_push_tail( &state->hs_cache, tls_hs, state->hs_pool );
 
     conn->tls_hs = tls_hs;
@@ -2820,6 +2840,22 @@ fd_quic_tls_cb_peer_params( void *        context,
   fd_quic_apply_peer_params( conn, peer_tp );
 }
 
+void
+fd_quic_tls_cb_session( void *                   context,
+                        fd_tls_session_t const * session ) {
+  fd_quic_conn_t *        conn  = (fd_quic_conn_t *)context;
+  fd_quic_state_t *       state = fd_quic_get_state( conn->quic );
+  fd_quic_net_endpoint_t  peer  = conn->peer[0];
+
+  /* Newer tickets replace older ones (including ones of other peers
+     that happen to map to the same slot) */
+  fd_quic_session_ent_t * ent = fd_quic_session_cache_slot( state, peer.ip_addr, peer.udp_port );
+  ent->ip_addr  = peer.ip_addr;
+  ent->udp_port = peer.udp_port;
+  ent->valid    = 1;
+  ent->session  = *session;
+}
+
 void
 fd_quic_tls_cb_handshake_complete( fd_quic_tls_hs_t * hs,
                                    void *             context ) {
@@ -2879,6 +2915,14 @@ fd_quic_handle_crypto_frame( fd_quic_frame_ctx_t *    context,
     return rcv_sz;
   }
 
+  if( enc_level==fd_quic_enc_level_appdata_id &&
+      tls_hs->hs.base.state!=FD_TLS_HS_CONNECTED ) {
+    /* Post-handshake messages (session tickets) arriving before the
+       handshake completed.  Don't ack, so the peer retransmits. */
+    context->pkt->ack_flag |= ACK_FLAG_CANCEL;
+    return rcv_sz;
+  }
+
   if( enc_level > tls_hs->rx_enc_level ) {
     /* Discard data from any previous handshake level.  Currently only
        happens at the Initial->Handshake encryption level change. */
@@ -3046,6 +3090,13 @@ fd_quic_service( fd_quic_t * quic ) {
 
   long now_ticks = fd_tickcount();
 
+  if( FD_UNLIKELY( quic->config.session_ticket_ttl &&
+                   quic->config.role==FD_QUIC_ROLE_SERVER &&
+                   now>=state->ticket_key_rotate_at ) ) {
+    fd_quic_tls_rotate_ticket_key( state->tls );
+    state->ticket_key_rotate_at = now + quic->config.session_ticket_ttl;
+  }
+
   int cnt = 0;
   cnt += fd_quic_svc_poll_tail( quic, FD_QUIC_SVC_INSTANT, now );
   cnt += fd_quic_svc_poll_head( quic, FD_QUIC_SVC_ACK_TX,  now );
@@ -4018,8 +4069,8 @@ fd_quic_conn_service( fd_quic_t * quic, fd_quic_conn_t * conn, ulong now ) {
             /* user callback */
             fd_quic_cb_conn_new( quic, conn );
 
-            /* clear out hs_data here, as we don't need it anymore */
-            fd_quic_tls_clear_hs_data( conn->tls_hs, fd_quic_enc_level_appdata_id );
+            /* Keep app-level hs_data (session tickets) around until
+               acknowledged or the handshake object is freed. */
           }
 
           /* if we're the client, fd_quic_conn_tx will flush the hs
@@ -4237,6 +4288,14 @@ fd_quic_connect( fd_quic_t *  quic,
   tp->initial_source_connection_id_present = 1;
   tp->initial_source_connection_id_len     = FD_QUIC_CONN_ID_SZ;
 
+  /* Consume a cached session ticket for this peer, if any */
+
+  fd_tls_session_t const * session = NULL;
+  fd_quic_session_ent_t *  sess_ent = fd_quic_session_cache_slot( state, dst_ip_addr, dst_udp_port );
+  if( sess_ent->valid && sess_ent->ip_addr==dst_ip_addr && sess_ent->udp_port==dst_udp_port ) {
+    session = &sess_ent->session;
+  }
+
   /* Create a TLS handshake (free>0 validated above) */
 
   fd_quic_tls_hs_t * tls_hs = fd_quic_tls_hs_new(
@@ -4245,7 +4304,12 @@ fd_quic_connect( fd_quic_t *  quic,
       (void*)conn,
       0 /*is_server*/,
       tp,
-      state->now );
+      state->now,
+      session );
+  if( session ) {
+    /* fd_tls copied the session into the ClientHello */
+    fd_memset_explicit( sess_ent, 0, sizeof(fd_quic_session_ent_t) );
+  }
   if( FD_UNLIKELY( tls_hs->alert ) ) {
     FD_LOG_WARNING(( "fd_quic_tls_hs_client_new failed" ));
     /* shut down tls_hs */
@@ -166,6 +166,7 @@ struct __attribute__((aligned(16UL))) fd_quic_config {
   X( ack_threshold,               "%lu",    units, "bytes",        __VA_ARGS__ ) \
   X( retry_ttl,                   "%lu",    units, "ns",           __VA_ARGS__ ) \
   X( tls_hs_ttl,                  "%lu",    units, "ns",           __VA_ARGS__ ) \
+  X( session_ticket_ttl,          "%lu",    units, "ns",           __VA_ARGS__ ) \
   X( identity_public_key,         "%x",     hex32, "",             __VA_ARGS__ ) \
   X( sign,                        "%p",     ptr,   "",             __VA_ARGS__ ) \
   X( sign_ctx,                    "%p",     ptr,   "",             __VA_ARGS__ ) \
@@ -215,6 +216,14 @@ struct __attribute__((aligned(16UL))) fd_quic_config {
   ulong tls_hs_ttl;
 # define FD_QUIC_DEFAULT_TLS_HS_TTL (ulong)(3e9) /* 3s */
 
+  /* session_ticket_ttl: lifetime of TLS session tickets, also the
+     interval at which servers rotate their ticket key.  If non-zero,
+     servers issue session tickets and clients resume sessions with
+     peers they recently connected to.  Zero (the default) disables
+     resumption.  Interop with rustls is tested in
+     contrib/quic/rustls_compat. */
+  ulong session_ticket_ttl;
+
   /* TLS config ********************************************/
 
   /* identity_key: Ed25519 public key of node identity */
@@ -59,6 +59,23 @@ struct fd_quic_svc_queue {
 typedef struct fd_quic_svc_queue fd_quic_svc_queue_t;
 
 
+/* fd_quic_session_ent_t is a TLS session ticket received from the
+   server at the given address.  Entries are single use. */
+
+struct fd_quic_session_ent {
+  uint             ip_addr;
+  ushort           udp_port;
+  uchar            valid;
+  fd_tls_session_t session;
+};
+
+typedef struct fd_quic_session_ent fd_quic_session_ent_t;
+
+/* FD_QUIC_SESSION_CACHE_CNT is the number of slots in the client
+   session cache.  Power of 2. */
+
+#define FD_QUIC_SESSION_CACHE_CNT (64UL)
+
 /* fd_quic_state_t is the internal state of an fd_quic_t.  Valid for
    lifetime of join. */
 
@@ -116,6 +133,12 @@ struct __attribute__((aligned(16UL))) fd_quic_state_private {
   uchar retry_secret[FD_QUIC_RETRY_SECRET_SZ];
   uchar retry_iv    [FD_QUIC_RETRY_IV_SZ];
 
+  /* time of next session ticket key rotation (server only) */
+  ulong ticket_key_rotate_at;
+
+  /* session ticket cache, direct mapped by peer address (client only) */
+  fd_quic_session_ent_t session_cache[ FD_QUIC_SESSION_CACHE_CNT ];
+
   /* Scratch space for packet protection */
   uchar                   crypt_scratch[FD_QUIC_MTU];
 };
@@ -182,6 +205,17 @@ fd_quic_conn_query( fd_quic_conn_map_t * map,
   return entry->conn;
 }
 
+/* fd_quic_session_cache_slot returns the session cache slot of the
+   given peer address. */
+
+static inline fd_quic_session_ent_t *
+fd_quic_session_cache_slot( fd_quic_state_t * state,
+                            uint              ip_addr,
+                            ushort            udp_port ) {
+  ulong h = fd_ulong_hash( ( (ulong)ip_addr<<16 ) | (ulong)udp_port );
+  return &state->session_cache[ h & (FD_QUIC_SESSION_CACHE_CNT-1UL) ];
+}
+
 /* fd_quic_conn_service is called periodically to perform pending
    operations and time based operations.
 
@@ -275,6 +309,10 @@ fd_quic_tls_cb_peer_params( void *        context,
                             uchar const * peer_tp_enc,
                             ulong         peer_tp_enc_sz );
 
+void
+fd_quic_tls_cb_session( void *                   context,
+                        fd_tls_session_t const * session );
+
 void
 fd_quic_apply_peer_params( fd_quic_conn_t *                   conn,
                            fd_quic_transport_params_t const * peer_tp );
@@ -185,7 +185,8 @@ test_quic_server_alpn_fail( fd_quic_sandbox_t * sandbox,
       (void*)conn,
       1 /*is_server*/,
       tp,
-      state->now );
+      state->now,
+      NULL );
   conn->tls_hs = tls_hs;
 
   /* Send the TLS handshake message */
@@ -74,6 +74,18 @@ validate_quic_hs_tls_cache( fd_quic_t * quic ) {
 }
 
 
+/* counts CertificateVerify signatures issued by the server */
+ulong             server_sign_cnt = 0UL;
+fd_tls_sign_fn_t  server_sign_fn  = NULL;
+
+static void
+counting_sign( void *        ctx,
+               uchar         sig[ static 64 ],
+               uchar const   payload[ static 130 ] ) {
+  server_sign_cnt++;
+  server_sign_fn( ctx, sig, payload );
+}
+
 /* global "clock" */
 ulong now = 123;
 
@@ -135,6 +147,12 @@ main( int argc, char ** argv ) {
   server_quic->config.initial_rx_max_stream_data = 1<<16;
   client_quic->config.initial_rx_max_stream_data = 1<<16;
 
+  server_quic->config.session_ticket_ttl = (ulong)3600e9;
+  client_quic->config.session_ticket_ttl = (ulong)3600e9;
+
+  server_sign_fn           = server_quic->config.sign;
+  server_quic->config.sign = counting_sign;
+
   FD_LOG_NOTICE(( "Creating virtual pair" ));
   fd_quic_virtual_pair_t vp;
   fd_quic_virtual_pair_init( &vp, server_quic, client_quic );
@@ -164,6 +182,7 @@ main( int argc, char ** argv ) {
   }
 
   FD_TEST( server_complete && client_complete );
+  FD_TEST( server_sign_cnt==1UL );
 
   /* TODO detect missing QUIC transport params */
 
@@ -224,11 +243,44 @@ main( int argc, char ** argv ) {
   FD_TEST_CUSTOM( sizeof(fd_quic_tls_hs_cache_t) == fd_quic_tls_hs_cache_footprint( ),
                     "tls hs cache relies on footprint==sizeof, modify that impl" );
 
+  FD_LOG_NOTICE(( "Testing session resumption" ));
+
+  fd_quic_state_t *       client_state = fd_quic_get_state( client_quic );
+  fd_quic_session_ent_t * session      = fd_quic_session_cache_slot( client_state, 0U, 0 );
+  FD_TEST( session->valid );
+
+  server_complete = 0;
+  client_complete = 0;
+  fd_quic_conn_t * resume_conn = fd_quic_connect( client_quic, 0U, 0, 0U, 0 );
+  FD_TEST( resume_conn );
+  FD_TEST( resume_conn->tls_hs->hs.cli.psk_offered );
+  FD_TEST( !session->valid ); /* tickets are single use */
+
+  for( ulong j=0UL; j<20UL && !( server_complete && client_complete ); j++ ) {
+    fd_quic_service( client_quic );
+    fd_quic_service( server_quic );
+  }
+  FD_TEST( server_complete && client_complete );
+  FD_TEST( server_sign_cnt==1UL ); /* resumed without CertificateVerify */
+
+  /* the resumed connection was issued a fresh ticket */
+  for( ulong j=0UL; j<10UL; j++ ) {
+    fd_quic_service( client_quic );
+    fd_quic_service( server_quic );
+  }
+  FD_TEST( session->valid );
+
+  fd_quic_conn_close( resume_conn, 0 );
+  fd_quic_conn_close( server_conn, 0 );
+  for( ulong j=0UL; j<10UL; j++ ) {
+    fd_quic_service( client_quic );
+    fd_quic_service( server_quic );
+  }
+
   FD_LOG_NOTICE(( "Testing TLS cache - within ttl prevents eviction " ));
   client_quic->config.tls_hs_ttl = 5UL;
 
   ulong             prev_evicted = client_quic->metrics.hs_evicted_cnt;
-  fd_quic_state_t * client_state = fd_quic_get_state( client_quic );
   FD_TEST( prev_evicted == 0 );
 
   /* fill buffer, no eviction or failure */
@@ -108,7 +108,8 @@ main( int     argc,
       tls_client,
       0 /* is_server */,
       tmp_tp,
-      100UL ) );
+      100UL,
+      NULL ) );
 
   my_quic_tls_t    tls_server[1] = {0};
   fd_quic_tls_hs_t hs_server[1];
@@ -118,7 +119,8 @@ main( int     argc,
       tls_server,
       1 /* is_server */,
       tmp_tp,
-      100UL ) );
+      100UL,
+      NULL ) );
 
   // generate initial secrets for client
 
@@ -57,12 +57,24 @@ fd_quic_tls_tp_peer( void *        handshake,
                      uchar const * quic_tp,
                      ulong         quic_tp_sz );
 
+/* fd_quic_tls_session is called by fd_tls when the server issued a
+   session ticket. */
+
+void
+fd_quic_tls_session( void const *             handshake,
+                     fd_tls_session_t const * session );
+
+/* fd_quic_tls_clock is the session ticket clock provided to fd_tls.
+   Returns the wallclock in milliseconds. */
+
+ulong
+fd_quic_tls_clock( void * ctx );
+
 /* fd_quic_tls lifecycle API ******************************************/
 
 static void
-fd_quic_tls_init( fd_tls_t *    tls,
-                  fd_tls_sign_t signer,
-                  uchar const   cert_public_key[ static 32 ] );
+fd_quic_tls_init( fd_tls_t *                tls,
+                  fd_quic_tls_cfg_t const * cfg );
 
 fd_quic_tls_t *
 fd_quic_tls_new( fd_quic_tls_t *     self,
@@ -86,9 +98,11 @@ fd_quic_tls_new( fd_quic_tls_t *     self,
   self->secret_cb             = cfg->secret_cb;
   self->handshake_complete_cb = cfg->handshake_complete_cb;
   self->peer_params_cb        = cfg->peer_params_cb;
+  self->session_cb            = cfg->session_cb;
 
   /* Initialize fd_tls */
-  fd_quic_tls_init( &self->tls, cfg->signer, cfg->cert_public_key );
+  fd_quic_tls_init( &self->tls, cfg );
+  if( cfg->ticket_lifetime ) fd_quic_tls_rotate_ticket_key( self );
 
   return self;
 }
@@ -97,9 +111,8 @@ fd_quic_tls_new( fd_quic_tls_t *     self,
    the embedded fd_tls instance. */
 
 static void
-fd_quic_tls_init( fd_tls_t *    tls,
-                  fd_tls_sign_t signer,
-                  uchar const   cert_public_key[ static 32 ] ) {
+fd_quic_tls_init( fd_tls_t *                tls,
+                  fd_quic_tls_cfg_t const * cfg ) {
   tls = fd_tls_new( tls );
   *tls = (fd_tls_t) {
     .quic = 1,
@@ -107,12 +120,19 @@ fd_quic_tls_init( fd_tls_t *    tls,
       .ctx     = NULL,
       .rand_fn = fd_quic_tls_rand
     },
-    .sign = signer,
+    .sign = cfg->signer,
     .secrets_fn = fd_quic_tls_secrets,
     .sendmsg_fn = fd_quic_tls_sendmsg,
 
     .quic_tp_self_fn = fd_quic_tls_tp_self,
     .quic_tp_peer_fn = fd_quic_tls_tp_peer,
+
+    .clock = {
+      .ctx      = NULL,
+      .clock_fn = fd_quic_tls_clock
+    },
+    .session_fn      = cfg->session_cb ? fd_quic_tls_session : NULL,
+    .ticket_lifetime = cfg->ticket_lifetime,
   };
 
   /* Generate X25519 key */
@@ -121,7 +141,7 @@ fd_quic_tls_init( fd_tls_t *    tls,
   fd_x25519_public( tls->kex_public_key, tls->kex_private_key );
 
   /* Set up Ed25519 key */
-  fd_memcpy( tls->cert_public_key, cert_public_key, 32UL );
+  fd_memcpy( tls->cert_public_key, cfg->cert_public_key, 32UL );
 
   /* Generate X.509 cert */
   fd_x509_mock_cert( tls->cert_x509, tls->cert_public_key );
@@ -150,7 +170,8 @@ fd_quic_tls_hs_new( fd_quic_tls_hs_t * self,
                     void *             context,
                     int                is_server,
                     fd_quic_transport_params_t const * self_transport_params,
-                    ulong              now ) {
+                    ulong              now,
+                    fd_tls_session_t const * session ) {
   // clear the handshake bits
   fd_memset( self, 0, sizeof(fd_quic_tls_hs_t) );
 
@@ -190,6 +211,7 @@ fd_quic_tls_hs_new( fd_quic_tls_hs_t * self,
     fd_tls_estate_srv_new( &self->hs.srv );
   } else {
     fd_tls_estate_cli_new( &self->hs.cli );
+    self->hs.cli.session = session;
     long res = fd_tls_client_handshake( &quic_tls->tls, &self->hs.cli, NULL, 0UL, 0 );
     if( FD_UNLIKELY( res<0L ) ) {
       self->alert = (uint)-res;
@@ -201,6 +223,15 @@ fd_quic_tls_hs_new( fd_quic_tls_hs_t * self,
   return self;
 }
 
+void
+fd_quic_tls_rotate_ticket_key( fd_quic_tls_t * self ) {
+  uchar key[ 16 ];
+  if( FD_UNLIKELY( !fd_rng_secure( key, 16UL ) ) )
+    FD_LOG_ERR(( "fd_rng_secure failed: %s", fd_io_strerror( errno ) ));
+  fd_tls_rotate_ticket_key( &self->tls, key );
+  fd_memset_explicit( key, 0, 16UL );
+}
+
 void
 fd_quic_tls_hs_delete( fd_quic_tls_hs_t * self ) {
   if( !self ) return;
@@ -215,7 +246,11 @@ int
 fd_quic_tls_process( fd_quic_tls_hs_t * self ) {
 
   if( FD_UNLIKELY( self->hs.base.state==FD_TLS_HS_FAIL ) ) return FD_QUIC_FAILED;
-  if( self->hs.base.state==FD_TLS_HS_CONNECTED ) return FD_QUIC_SUCCESS;
+
+  /* Servers don't expect any post-handshake messages.  Clients might
+     still receive session tickets. */
+  int connected = self->hs.base.state==FD_TLS_HS_CONNECTED;
+  if( connected && self->is_server ) return FD_QUIC_SUCCESS;
 
   /* Process all fully received messages */
 
@@ -249,7 +284,7 @@ fd_quic_tls_process( fd_quic_tls_hs_t * self ) {
   switch( self->hs.base.state ) {
   case FD_TLS_HS_CONNECTED:
     /* handshake completed */
-    self->quic_tls->handshake_complete_cb( self, self->context );
+    if( !connected ) self->quic_tls->handshake_complete_cb( self, self->context );
     return FD_QUIC_SUCCESS;
   case FD_TLS_HS_FAIL:
     /* handshake permanently failed */
@@ -421,3 +456,20 @@ fd_quic_tls_tp_peer( void *        handshake,
 
   quic_tls->peer_params_cb( hs->context, quic_tp, quic_tp_sz );
 }
+
+void
+fd_quic_tls_session( void const *             handshake,
+                     fd_tls_session_t const * session ) {
+  /* Callback issued by fd_tls.  Bubble up callback to fd_quic_tls. */
+
+  fd_quic_tls_hs_t * hs       = (fd_quic_tls_hs_t *)handshake;
+  fd_quic_tls_t *    quic_tls = hs->quic_tls;
+
+  quic_tls->session_cb( hs->context, session );
+}
+
+ulong
+fd_quic_tls_clock( void * ctx ) {
+  (void)ctx;
+  return (ulong)fd_log_wallclock() / (ulong)1e6;
+}
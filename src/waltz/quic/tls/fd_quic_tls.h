@@ -29,7 +29,9 @@
 
      // create a client or a server handshake object
      //   call upon a new connection to manage the connection TLS handshake
-     fd_quic_tls_hs_t * hs = fd_quic_tls_hs_new( quic_tls, conn_id, conn_id_sz, is_server, transport_params, now );
+     //   session optionally points to a session ticket previously
+     //   delivered via session_cb (client only)
+     fd_quic_tls_hs_t * hs = fd_quic_tls_hs_new( quic_tls, conn_id, conn_id_sz, is_server, transport_params, now, session );
 
      // delete a handshake object
      //   NULL is allowed here
@@ -68,6 +70,10 @@ typedef void
                                   uchar const * quic_tp,
                                   ulong         quic_tp_sz );
 
+typedef void
+(* fd_quic_tls_cb_session_t)( void *                   context,
+                              fd_tls_session_t const * session );
+
 struct fd_quic_tls_secret {
   uint  enc_level;
   uchar read_secret [ FD_QUIC_SECRET_SZ ];
@@ -80,8 +86,16 @@ struct fd_quic_tls_cfg {
   fd_quic_tls_cb_handshake_complete_t  handshake_complete_cb;
   fd_quic_tls_cb_peer_params_t         peer_params_cb;
 
+  /* session_cb (optional) is called when the peer server issued a
+     session ticket.  If NULL, client handshakes do not store tickets. */
+  fd_quic_tls_cb_session_t             session_cb;
+
   ulong          max_concur_handshakes;
 
+  /* ticket_lifetime is the lifetime in seconds of session tickets
+     issued by the server.  Zero disables session tickets. */
+  uint          ticket_lifetime;
+
   /* Signing callback for TLS 1.3 CertificateVerify. Context of the
      signer must outlive the tls object. */
   fd_tls_sign_t signer;
@@ -107,6 +121,7 @@ struct fd_quic_tls {
   fd_quic_tls_cb_secret_t              secret_cb;
   fd_quic_tls_cb_handshake_complete_t  handshake_complete_cb;
   fd_quic_tls_cb_peer_params_t         peer_params_cb;
+  fd_quic_tls_cb_session_t             session_cb;
 
   /* ssl related */
   fd_tls_t tls;
@@ -195,15 +210,25 @@ fd_quic_tls_hs_new( fd_quic_tls_hs_t * self,
                     void *             context,
                     int                is_server,
                     fd_quic_transport_params_t const * self_transport_params,
-                    ulong              now );
+                    ulong              now,
+                    fd_tls_session_t const * session );
 
 void
 fd_quic_tls_hs_delete( fd_quic_tls_hs_t * hs );
 
+/* fd_quic_tls_rotate_ticket_key replaces the session ticket key with a
+   freshly generated one.  Tickets issued under the previous key remain
+   valid until the next rotation. */
+
+void
+fd_quic_tls_rotate_ticket_key( fd_quic_tls_t * self );
+
 /* fd_quic_tls_process processes any available TLS handshake messages
    from previously received CRYPTO frames.  Returns FD_QUIC_SUCCESS if
    any number of messages were processed (including no messages in there
-   is not enough data).  Returns FD_QUIC_FAILED if the TLS handshake
+   is not enough data).  Once the handshake completed, clients continue
+   to process post-handshake messages (NewSessionTicket) and servers
+   ignore further input.  Returns FD_QUIC_FAILED if the TLS handshake
    failed (not recoverable). */
 
 int
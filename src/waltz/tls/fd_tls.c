@@ -3,6 +3,7 @@
 #include "../../ballet/ed25519/fd_ed25519.h"
 #include "../../ballet/ed25519/fd_x25519.h"
 #include "../../ballet/hmac/fd_hmac.h"
+#include "../../ballet/aes/fd_aes_gcm.h"
 
 #include <assert.h>
 
@@ -287,6 +288,238 @@ fd_tls_send_cert_verify( fd_tls_t const *       this,
   return 0L;
 }
 
+/* Session resumption *************************************************/
+
+/* fd_tls_ticket_pt_t is the plaintext of a session ticket issued by an
+   fd_tls server.  See FD_TLS_TICKET_SZ for the ticket layout. */
+
+struct __attribute__((packed)) fd_tls_ticket_pt {
+  uchar psk[ 32 ];
+  ulong issue_ms;
+  uint  age_add;
+};
+
+typedef struct fd_tls_ticket_pt fd_tls_ticket_pt_t;
+
+FD_STATIC_ASSERT( 4UL+12UL+sizeof(fd_tls_ticket_pt_t)+16UL==FD_TLS_TICKET_SZ, layout );
+
+void
+fd_tls_rotate_ticket_key( fd_tls_t *  tls,
+                          uchar const key[ 16 ] ) {
+  tls->ticket_key[1] = tls->ticket_key[0];
+  fd_tls_ticket_key_t * cur = &tls->ticket_key[0];
+  cur->id    = tls->ticket_key[1].id + 1U;
+  cur->valid = 1U;
+  memcpy( cur->key, key, 16UL );
+}
+
+/* fd_tls_psk_key_schedule derives the PSK dependent parts of the TLS
+   1.3 key schedule (RFC 8446 Section 7.1).  binder_key is the
+   "res binder" key.  hs_derived is the salt of the handshake secret,
+   which replaces handshake_derived for resumed sessions. */
+
+static void
+fd_tls_psk_key_schedule( uchar const psk       [ 32 ],
+                         uchar       binder_key[ 32 ],
+                         uchar       hs_derived[ 32 ] ) {
+
+  static uchar const zeros[ 32 ] = {0};
+  uchar early_secret[ 32 ];
+  fd_hmac_sha256( /* data */ psk,   32UL,
+                  /* salt */ zeros, 32UL,
+                  /* out  */ early_secret );
+
+  fd_tls_hkdf_expand_label( binder_key, 32UL,
+                            early_secret,
+                            "res binder", 10UL,
+                            empty_hash,   32UL );
+
+  fd_tls_hkdf_expand_label( hs_derived, 32UL,
+                            early_secret,
+                            "derived",   7UL,
+                            empty_hash, 32UL );
+}
+
+/* fd_tls_psk_binder computes a PSK binder (RFC 8446 Section 4.2.11.2)
+   over the transcript state followed by the partial ClientHello at
+   [partial_ch,partial_ch+partial_ch_sz). */
+
+static void
+fd_tls_psk_binder( uchar               binder    [ 32 ],
+                   uchar const         binder_key[ 32 ],
+                   fd_sha256_t const * transcript,
+                   uchar const *       partial_ch,
+                   ulong               partial_ch_sz ) {
+
+  fd_sha256_t transcript_clone = *transcript;
+  fd_sha256_append( &transcript_clone, partial_ch, partial_ch_sz );
+  uchar transcript_hash[ 32 ];
+  fd_sha256_fini( &transcript_clone, transcript_hash );
+
+  uchar finished_key[ 32 ];
+  fd_tls_hkdf_expand_label( finished_key, 32UL,
+                            binder_key,
+                            "finished", 8UL,
+                            NULL,       0UL );
+
+  fd_hmac_sha256( /* data */ transcript_hash, 32UL,
+                  /* salt */ finished_key,    32UL,
+                  /* out  */ binder );
+}
+
+/* fd_tls_server_open_ticket attempts to recover the PSK from a session
+   ticket.  Rejects tickets that were not sealed with the current or
+   previous ticket key, tickets older than the server's ticket lifetime,
+   and tickets where the client's view of the ticket age is off by more
+   than FD_TLS_TICKET_AGE_TOLERANCE_MS.  On success, writes the PSK to
+   psk and returns 1.  On failure, returns 0 (the server should then
+   fall back to a full handshake). */
+
+static int
+fd_tls_server_open_ticket( fd_tls_t const * server,
+                           uchar const *    ticket,
+                           ulong            ticket_sz,
+                           uint             obfuscated_ticket_age,
+                           uchar            psk[ 32 ] ) {
+
+  if( FD_UNLIKELY( ticket_sz!=FD_TLS_TICKET_SZ ) ) return 0;
+
+  uint key_id = FD_LOAD( uint, ticket );
+  fd_tls_ticket_key_t const * key = NULL;
+  for( ulong j=0UL; j<2UL; j++ ) {
+    if( server->ticket_key[j].valid && server->ticket_key[j].id==key_id ) {
+      key = &server->ticket_key[j];
+      break;
+    }
+  }
+  if( FD_UNLIKELY( !key ) ) return 0;
+
+  fd_aes_gcm_t gcm[1];
+  fd_tls_ticket_pt_t pt;
+  fd_aes_128_gcm_init( gcm, key->key, ticket+4UL );
+  int ok = fd_aes_gcm_decrypt( gcm, ticket+16UL, (uchar *)&pt, sizeof(fd_tls_ticket_pt_t),
+                               /* aad */ ticket, 4UL, ticket+16UL+sizeof(fd_tls_ticket_pt_t) );
+  if( FD_UNLIKELY( ok!=FD_AES_GCM_DECRYPT_OK ) ) return 0;
+
+  /* Replay window: Reject expired tickets and tickets that were
+     presented at an unexpected time (RFC 8446 Section 8.3) */
+
+  ulong now_ms     = fd_tls_clock( &server->clock );
+  ulong age_ms     = now_ms - fd_ulong_min( pt.issue_ms, now_ms );
+  ulong client_age = (ulong)( obfuscated_ticket_age - pt.age_add );
+  ulong max_age    = (ulong)fd_uint_min( server->ticket_lifetime, FD_TLS_TICKET_LIFETIME_MAX ) * 1000UL;
+  ulong age_delta  = fd_ulong_max( age_ms, client_age ) - fd_ulong_min( age_ms, client_age );
+  ok = ( age_ms<=max_age ) & ( age_delta<=FD_TLS_TICKET_AGE_TOLERANCE_MS );
+
+  if( ok ) memcpy( psk, pt.psk, 32UL );
+  fd_memset_explicit( &pt, 0, sizeof(fd_tls_ticket_pt_t) );
+  return ok;
+}
+
+/* fd_tls_server_send_ticket issues a session ticket.  Called after the
+   server sent its Finished.  master_secret is the handshake's master
+   secret.  transcript_hash is the transcript hash ClientHello..client
+   Finished.  Returns 0L on success and negated TLS alert number on
+   failure. */
+
+static long
+fd_tls_server_send_ticket( fd_tls_t const *      server,
+                           fd_tls_estate_srv_t * hs,
+                           uchar const           master_secret  [ 32 ],
+                           uchar const           transcript_hash[ 32 ] ) {
+
+  /* Derive resumption PSK.  Only one ticket is issued per connection,
+     so the ticket nonce is constant. */
+
+  uchar res_secret[ 32 ];
+  fd_tls_hkdf_expand_label( res_secret, 32UL,
+                            master_secret,
+                            "res master",    10UL,
+                            transcript_hash, 32UL );
+
+  static uchar const ticket_nonce[ 1 ] = {0};
+  fd_tls_ticket_pt_t pt;
+  fd_tls_hkdf_expand_label( pt.psk, 32UL,
+                            res_secret,
+                            "resumption", 10UL,
+                            ticket_nonce, 1UL );
+
+  /* Random IV and ticket age obfuscation */
+
+  uchar rand[ 16 ];
+  if( FD_UNLIKELY( !fd_tls_rand( &server->rand, rand, 16UL ) ) )
+    return fd_tls_alert( &hs->base, FD_TLS_ALERT_INTERNAL_ERROR, FD_TLS_REASON_RAND_FAIL );
+
+  pt.issue_ms = fd_tls_clock( &server->clock );
+  pt.age_add  = FD_LOAD( uint, rand+12UL );
+
+  /* Seal ticket */
+
+  fd_tls_ticket_key_t const * key = &server->ticket_key[0];
+  uchar ticket[ FD_TLS_TICKET_SZ ];
+  FD_STORE( uint, ticket, key->id );
+  memcpy( ticket+4UL, rand, 12UL );
+
+  fd_aes_gcm_t gcm[1];
+  fd_aes_128_gcm_init( gcm, key->key, ticket+4UL );
+  fd_aes_gcm_encrypt( gcm, ticket+16UL, (uchar const *)&pt, sizeof(fd_tls_ticket_pt_t),
+                      /* aad */ ticket, 4UL, ticket+16UL+sizeof(fd_tls_ticket_pt_t) );
+  fd_memset_explicit( &pt,        0, sizeof(fd_tls_ticket_pt_t) );
+  fd_memset_explicit( res_secret, 0, 32UL );
+
+  /* Create NewSessionTicket message */
+
+# define MSG_BUFSZ 256UL
+  uchar msg_buf[ MSG_BUFSZ ];
+
+  ulong nst_sz;
+
+  do {
+    uchar *       wire     = msg_buf;
+    uchar * const wire_end = msg_buf + MSG_BUFSZ;
+
+    /* Leave space for message header */
+
+    void * hdr_ptr = wire;
+    wire += sizeof(fd_tls_msg_hdr_t);
+    fd_tls_msg_hdr_t hdr = { .type = FD_TLS_MSG_NEW_SESSION_TICKET };
+
+    /* Construct NewSessionTicket */
+
+    fd_tls_new_session_ticket_t nst = {
+      .ticket_lifetime = fd_uint_min( server->ticket_lifetime, FD_TLS_TICKET_LIFETIME_MAX ),
+      .ticket_age_add  = FD_LOAD( uint, rand+12UL ),
+      .ticket_nonce    = ticket_nonce,
+      .ticket_nonce_sz = sizeof(ticket_nonce),
+      .ticket          = ticket,
+      .ticket_sz       = FD_TLS_TICKET_SZ
+    };
+
+    /* Encode NewSessionTicket */
+
+    long encode_res = fd_tls_encode_new_session_ticket( &nst, wire, (ulong)(wire_end-wire) );
+    if( FD_UNLIKELY( encode_res<0L ) )
+      return fd_tls_alert( &hs->base, (uint)(-encode_res), FD_TLS_REASON_NST_ENCODE );
+    wire += (ulong)encode_res;
+
+    hdr.sz = fd_uint_to_tls_u24( (uint)encode_res );
+    fd_tls_encode_msg_hdr( &hdr, hdr_ptr, sizeof(fd_tls_msg_hdr_t) );
+    nst_sz = (ulong)(wire - msg_buf);
+  } while(0);
+
+  /* Send NewSessionTicket message */
+
+  if( FD_UNLIKELY( !server->sendmsg_fn(
+        hs,
+        msg_buf, nst_sz,
+        FD_TLS_LEVEL_APPLICATION,
+        /* flush */ 1 ) ) )
+    return fd_tls_alert( &hs->base, FD_TLS_ALERT_INTERNAL_ERROR, FD_TLS_REASON_SENDMSG_FAIL );
+
+# undef MSG_BUFSZ
+  return 0L;
+}
+
 static long fd_tls_server_hs_start        ( fd_tls_t const *, fd_tls_estate_srv_t *, uchar const *, ulong, uint );
 static long fd_tls_server_hs_wait_finished( fd_tls_t const *, fd_tls_estate_srv_t *, uchar const *, ulong, uint );
 
@@ -494,6 +727,43 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
       return fd_tls_alert( &handshake->base, FD_TLS_ALERT_NO_APPLICATION_PROTOCOL, FD_TLS_REASON_ALPN_NEG );
   }
 
+  /* Attempt session resumption
+
+     The ticket is only considered if the ClientHello can complete the
+     handshake (has an X25519 key share).  Tickets that fail to open
+     result in a full handshake.  Binder mismatches abort the handshake
+     (RFC 8446 Section 4.2.11). */
+
+  int   resume = 0;
+  uchar psk_hs_derived[ 32 ];
+  if( ch.psk.identity_sz ) {
+    if( FD_UNLIKELY( !ch.psk_kex_modes.present ) )
+      return fd_tls_alert( &handshake->base, FD_TLS_ALERT_MISSING_EXTENSION, FD_TLS_REASON_PSK_NO_MODES );
+
+    uchar psk[ 32 ];
+    if( ch.psk_kex_modes.psk_dhe_ke &&
+        ch.key_share.has_x25519     &&
+        server->ticket_lifetime     &&
+        fd_tls_server_open_ticket( server, ch.psk.identity, ch.psk.identity_sz, ch.psk.obfuscated_ticket_age, psk ) ) {
+
+      uchar binder_key[ 32 ];
+      fd_tls_psk_key_schedule( psk, binder_key, psk_hs_derived );
+      fd_memset_explicit( psk, 0, 32UL );
+
+      uchar binder_expected[ 32 ];
+      fd_tls_psk_binder( binder_expected, binder_key, &transcript, record, (ulong)( ch.psk.binders - record ) );
+
+      int match = 0;
+      for( ulong i=0; i<32UL; i++ )
+        match |= ch.psk.binder[i] ^ binder_expected[i];
+      if( FD_UNLIKELY( match!=0 ) )
+        return fd_tls_alert( &handshake->base, FD_TLS_ALERT_DECRYPT_ERROR, FD_TLS_REASON_PSK_BINDER );
+
+      resume = 1;
+    }
+  }
+  handshake->resumed = !!resume;
+
   /* Record client hello in transcript hash */
 
   fd_sha256_append( &transcript, record, read_sz );
@@ -536,6 +806,8 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
       .cipher_suite = FD_TLS_CIPHER_SUITE_AES_128_GCM_SHA256,
       .key_share    = { .has_x25519 = 1 },
       .session_id   = ch.session_id,
+      .has_psk      = (uchar)resume,
+      .psk_identity = 0
     };
     memcpy( sh.random,           server_random,          32UL );
     memcpy( sh.key_share.x25519, server->kex_public_key, 32UL );
@@ -585,8 +857,8 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
   /* Derive main handshake secret */
 
   uchar handshake_secret[ 32 ];
-  fd_hmac_sha256( /* data */ ecdh_ikm,          32UL,
-                  /* salt */ handshake_derived, 32UL,
+  fd_hmac_sha256( /* data */ ecdh_ikm,                                   32UL,
+                  /* salt */ resume ? psk_hs_derived : handshake_derived, 32UL,
                   /* out  */ handshake_secret );
 
   /* Derive client/server handshake secrets */
@@ -655,9 +927,12 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
       }
     };
 
-    /* Negotiate raw public keys if available */
+    /* Negotiate raw public keys if available
+       (No certificates are exchanged when resuming a session) */
 
-    if( ch.server_cert_types.raw_pubkey ) {
+    if( resume ) {
+      /* skip */
+    } else if( ch.server_cert_types.raw_pubkey ) {
       handshake->server_cert_rpk = 1;
       ee.server_cert.cert_type   = FD_TLS_CERTTYPE_RAW_PUBKEY;
     } else if( !server->cert_x509_sz ) {
@@ -666,7 +941,7 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
       return fd_tls_alert( &handshake->base, FD_TLS_ALERT_UNSUPPORTED_CERTIFICATE, FD_TLS_REASON_NO_X509 );
     }
 
-    if( ch.client_cert_types.raw_pubkey ) {
+    if( !resume && ch.client_cert_types.raw_pubkey ) {
       handshake->client_cert_rpk = 1;
       ee.client_cert.cert_type   = FD_TLS_CERTTYPE_RAW_PUBKEY;
     }
@@ -697,37 +972,41 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
 
   fd_sha256_append( &transcript, msg_buf, server_ee_sz );
 
-  /* Send Certificate *************************************************/
+  if( !resume ) {
 
-  ulong cert_msg_sz;
-  if( ch.server_cert_types.raw_pubkey ) {
-    long sz = fd_tls_encode_raw_public_key( server->cert_public_key, msg_buf, MSG_BUFSZ );
-    FD_TEST( sz>=0L );
-    cert_msg_sz = (ulong)sz;
-  } else {
-    long sz = fd_tls_encode_cert_x509( server->cert_x509, server->cert_x509_sz, msg_buf, MSG_BUFSZ );
-    FD_TEST( sz>=0L );
-    cert_msg_sz = (ulong)sz;
-  }
+    /* Send Certificate ***********************************************/
 
-  /* Send certificate message */
+    ulong cert_msg_sz;
+    if( ch.server_cert_types.raw_pubkey ) {
+      long sz = fd_tls_encode_raw_public_key( server->cert_public_key, msg_buf, MSG_BUFSZ );
+      FD_TEST( sz>=0L );
+      cert_msg_sz = (ulong)sz;
+    } else {
+      long sz = fd_tls_encode_cert_x509( server->cert_x509, server->cert_x509_sz, msg_buf, MSG_BUFSZ );
+      FD_TEST( sz>=0L );
+      cert_msg_sz = (ulong)sz;
+    }
 
-  if( FD_UNLIKELY( !server->sendmsg_fn(
-        handshake,
-        msg_buf, cert_msg_sz,
-        FD_TLS_LEVEL_HANDSHAKE,
-        /* flush */ 0 ) ) )
-    return fd_tls_alert( &handshake->base, FD_TLS_ALERT_INTERNAL_ERROR, FD_TLS_REASON_SENDMSG_FAIL );
+    /* Send certificate message */
+
+    if( FD_UNLIKELY( !server->sendmsg_fn(
+          handshake,
+          msg_buf, cert_msg_sz,
+          FD_TLS_LEVEL_HANDSHAKE,
+          /* flush */ 0 ) ) )
+      return fd_tls_alert( &handshake->base, FD_TLS_ALERT_INTERNAL_ERROR, FD_TLS_REASON_SENDMSG_FAIL );
+
+    /* Record Certificate message in transcript hash */
 
-  /* Record Certificate message in transcript hash */
+    fd_sha256_append( &transcript, msg_buf, cert_msg_sz );
 
-  fd_sha256_append( &transcript, msg_buf, cert_msg_sz );
+    /* Send CertificateVerify *****************************************/
 
-  /* Send CertificateVerify *******************************************/
+    long cvfy_res = fd_tls_send_cert_verify( server, &handshake->base, &transcript, 0 );
+    if( FD_UNLIKELY( !!cvfy_res ) ) return cvfy_res;
+    /* CertificateVerify already included in transcript hash */
 
-  long cvfy_res = fd_tls_send_cert_verify( server, &handshake->base, &transcript, 0 );
-  if( FD_UNLIKELY( !!cvfy_res ) ) return cvfy_res;
-  /* CertificateVerify already included in transcript hash */
+  }
 
   /* Send Finished ****************************************************/
 
@@ -804,6 +1083,36 @@ fd_tls_server_hs_start( fd_tls_t const *      const server,
                       /* write secret */ server_app_secret,
                       FD_TLS_LEVEL_APPLICATION );
 
+  /* Issue session ticket *********************************************/
+
+  /* The server does not request client certs, so it can predict the
+     client Finished and derive the resumption secret right away (RFC
+     8446 Section 4.6.1).  This avoids storing the master secret. */
+
+  if( ch.psk_kex_modes.psk_dhe_ke &&
+      server->ticket_lifetime     &&
+      server->ticket_key[0].valid ) {
+
+    uchar client_finished_key[ 32 ];
+    fd_tls_hkdf_expand_label( client_finished_key, 32UL,
+                              client_hs_secret,
+                              "finished", 8UL,
+                              NULL,       0UL );
+
+    /* Reuse fin_rec for expected client Finished */
+    fd_hmac_sha256( /* data */ transcript_hash,     32UL,
+                    /* salt */ client_finished_key, 32UL,
+                    /* out  */ fin_rec.fin.verify );
+
+    transcript_clone = transcript;
+    fd_sha256_append( &transcript_clone, &fin_rec, sizeof(fin_rec) );
+    uchar res_transcript_hash[ 32 ];
+    fd_sha256_fini( &transcript_clone, res_transcript_hash );
+
+    long ticket_res = fd_tls_server_send_ticket( server, handshake, master_secret, res_transcript_hash );
+    if( FD_UNLIKELY( ticket_res<0L ) ) return ticket_res;
+  }
+
   /* Finish up ********************************************************/
 
   /* Store transcript hash state */
@@ -1001,6 +1310,7 @@ static long fd_tls_client_hs_wait_cert_cr    ( fd_tls_t const *, fd_tls_estate_c
 static long fd_tls_client_hs_wait_cert       ( fd_tls_t const *, fd_tls_estate_cli_t *, uchar const *, ulong, uint );
 static long fd_tls_client_hs_wait_cert_verify( fd_tls_t const *, fd_tls_estate_cli_t *, uchar const *, ulong, uint );
 static long fd_tls_client_hs_wait_finished   ( fd_tls_t const *, fd_tls_estate_cli_t *, uchar const *, ulong, uint );
+static long fd_tls_client_hs_connected       ( fd_tls_t const *, fd_tls_estate_cli_t *, uchar const *, ulong, uint );
 
 long
 fd_tls_client_handshake( fd_tls_t const *      client,
@@ -1031,6 +1341,9 @@ fd_tls_client_handshake( fd_tls_t const *      client,
   case FD_TLS_HS_WAIT_FINISHED:
     /* Incoming Server Finished */
     return fd_tls_client_hs_wait_finished( client, handshake, record, record_sz, encryption_level );
+  case FD_TLS_HS_CONNECTED:
+    /* Incoming post-handshake message */
+    return fd_tls_client_hs_connected( client, handshake, record, record_sz, encryption_level );
   default:
     return fd_tls_alert( &handshake->base, FD_TLS_ALERT_HANDSHAKE_FAILURE, FD_TLS_REASON_ILLEGAL_STATE );
   }
@@ -1048,8 +1361,9 @@ fd_tls_client_hs_start( fd_tls_t const * const      client,
   if( FD_UNLIKELY( quic_tp_sz > (long)FD_TLS_EXT_QUIC_PARAMS_SZ_MAX ) )
     return fd_tls_alert( &handshake->base, FD_TLS_ALERT_DECODE_ERROR, FD_TLS_REASON_QUIC_TP_OVERSZ );
 
-  /* Message buffer */
-# define MSG_BUFSZ 512UL
+  /* Message buffer (fits max QUIC transport params and a PSK offer
+     with a max size ticket) */
+# define MSG_BUFSZ 1280UL
   uchar msg_buf[ MSG_BUFSZ ];
 
   /* Transcript hasher */
@@ -1066,6 +1380,25 @@ fd_tls_client_hs_start( fd_tls_t const * const      client,
   /* Remember client random for SSLKEYLOGFILE */
   fd_memcpy( handshake->base.client_random, client_random, 32UL );
 
+  /* Offer session if it has not expired yet.  Sessions are single-use,
+     the reference is dropped immediately. */
+
+  fd_tls_session_t const * session = handshake->session;
+  handshake->session = NULL;
+
+  int   offer_psk = 0;
+  uint  obfuscated_ticket_age = 0U;
+  if( session && session->ticket_sz && client->clock.clock_fn ) {
+    ulong now_ms  = fd_tls_clock( &client->clock );
+    ulong age_ms  = now_ms - fd_ulong_min( session->recv_ms, now_ms );
+    ulong max_age = (ulong)fd_uint_min( session->lifetime, FD_TLS_TICKET_LIFETIME_MAX ) * 1000UL;
+    offer_psk = age_ms < max_age;
+    /* If the server identity is pinned, only resume sessions with it */
+    if( handshake->server_pubkey_pin )
+      offer_psk &= 0==memcmp( handshake->server_pubkey, session->server_pubkey, 32UL );
+    obfuscated_ticket_age = (uint)age_ms + session->age_add;
+  }
+
   /* Create client hello message */
 
   ulong client_hello_sz;
@@ -1095,10 +1428,19 @@ fd_tls_client_hs_start( fd_tls_t const * const      client,
       .alpn = {
         .buf   = client->alpn,
         .bufsz = client->alpn_sz,
+      },
+      .psk_kex_modes = {
+        .present    = !!( client->session_fn || offer_psk ),
+        .psk_dhe_ke = !!( client->session_fn || offer_psk )
       }
     };
     memcpy( ch.random,           client_random,          32UL );
     memcpy( ch.key_share.x25519, client->kex_public_key, 32UL );
+    if( offer_psk ) {
+      ch.psk.identity              = session->ticket;
+      ch.psk.identity_sz           = session->ticket_sz;
+      ch.psk.obfuscated_ticket_age = obfuscated_ticket_age;
+    }
 
     /* Encode client hello */
 
@@ -1112,6 +1454,22 @@ fd_tls_client_hs_start( fd_tls_t const * const      client,
     client_hello_sz = (ulong)(wire - msg_buf);
   } while(0);
 
+  /* Fill in PSK binder (the last 32 bytes of the ClientHello, which is
+     covered by the binder up to the binder list size prefix) */
+
+  if( offer_psk ) {
+    uchar binder_key[ 32 ];
+    uchar hs_derived[ 32 ];
+    fd_tls_psk_key_schedule( session->psk, binder_key, hs_derived );
+    fd_tls_psk_binder( msg_buf+client_hello_sz-32UL, binder_key,
+                       &handshake->transcript, msg_buf, client_hello_sz-35UL );
+
+    memcpy( handshake->psk, session->psk, 32UL );
+    if( !handshake->server_pubkey_pin )
+      memcpy( handshake->server_pubkey, session->server_pubkey, 32UL );
+    handshake->psk_offered = 1;
+  }
+
   /* Call back with client hello */
 
   if( FD_UNLIKELY( !client->sendmsg_fn(
@@ -1180,6 +1538,18 @@ fd_tls_client_hs_wait_sh( fd_tls_t const *      const client,
   /* TODO: For now, cryptographic parameters are hardcoded in the
            decoder.  Thus, we skip checks. */
 
+  /* Check whether server resumed session */
+
+  uchar psk_hs_derived[ 32 ];
+  if( sh->has_psk ) {
+    if( FD_UNLIKELY( ( !handshake->psk_offered ) | ( sh->psk_identity!=0 ) ) )
+      return fd_tls_alert( &handshake->base, FD_TLS_ALERT_ILLEGAL_PARAMETER, FD_TLS_REASON_PSK_SELECT );
+    uchar binder_key[ 32 ];
+    fd_tls_psk_key_schedule( handshake->psk, binder_key, psk_hs_derived );
+    handshake->psk_accepted = 1;
+  }
+  fd_memset_explicit( handshake->psk, 0, 32UL );
+
   /* Derive handshake secrets *****************************************/
 
   /* TODO: This code is duplicated server-side */
@@ -1202,8 +1572,8 @@ fd_tls_client_hs_wait_sh( fd_tls_t const *      const client,
   /* Derive main handshake secret */
 
   uchar handshake_secret[ 32 ];
-  fd_hmac_sha256( /* data */ ecdh_ikm,          32UL,
-                  /* salt */ handshake_derived, 32UL,
+  fd_hmac_sha256( /* data */ ecdh_ikm,                                                   32UL,
+                  /* salt */ handshake->psk_accepted ? psk_hs_derived : handshake_derived, 32UL,
                   /* out  */ handshake_secret );
 
   /* Derive client/server handshake secrets */
@@ -1343,7 +1713,10 @@ fd_tls_client_hs_wait_ee( fd_tls_t const *      const client,
 
   /* Finish up ********************************************************/
 
-  handshake->base.state = FD_TLS_HS_WAIT_CERT_CR;
+  /* Resumed sessions skip server authentication (server_pubkey was
+     restored from the session) */
+
+  handshake->base.state = handshake->psk_accepted ? FD_TLS_HS_WAIT_FINISHED : FD_TLS_HS_WAIT_CERT_CR;
 
   return (long)read_sz;
 }
@@ -1688,6 +2061,7 @@ fd_tls_client_hs_wait_finished( fd_tls_t const *      const client,
 
   /* Export transcript hash up to this point */
 
+  fd_sha256_t res_transcript = hs->transcript;
   fd_sha256_fini( &hs->transcript, transcript_hash );
 
   /* Derive "Finished" key */
@@ -1713,10 +2087,99 @@ fd_tls_client_hs_wait_finished( fd_tls_t const *      const client,
         /* flush */ 1 ) ) )
     return fd_tls_alert( &hs->base, FD_TLS_ALERT_INTERNAL_ERROR, FD_TLS_REASON_SENDMSG_FAIL );
 
+  /* Derive resumption secret for session tickets */
+
+  if( client->session_fn ) {
+    fd_sha256_append( &res_transcript, &fin_rec, sizeof(fin_rec) );
+    fd_sha256_fini( &res_transcript, transcript_hash );
+    fd_tls_hkdf_expand_label( hs->resumption_secret, 32UL,
+                              hs->master_secret,
+                              "res master",    10UL,
+                              transcript_hash, 32UL );
+  }
+
   hs->base.state = FD_TLS_HS_CONNECTED;
   return (long)read_sz;
 }
 
+/* fd_tls_client_hs_connected handles post-handshake messages.  Only
+   NewSessionTicket is supported.  Tickets that cannot be stored are
+   silently ignored. */
+
+static long
+fd_tls_client_hs_connected( fd_tls_t const *      const client,
+                            fd_tls_estate_cli_t * const hs,
+                            uchar const *         const record,
+                            ulong                 const record_sz,
+                            uint                  const encryption_level ) {
+
+  if( FD_UNLIKELY( encryption_level != FD_TLS_LEVEL_APPLICATION ) )
+    return fd_tls_alert( &hs->base, FD_TLS_ALERT_INTERNAL_ERROR, FD_TLS_REASON_WRONG_ENC_LVL );
+
+  /* Read NewSessionTicket ********************************************/
+
+  fd_tls_new_session_ticket_t nst = {0};
+
+  ulong read_sz;
+  do {
+    uchar const *       wire     = record;
+    uchar const * const wire_end = record + record_sz;
+
+    /* Decode message header */
+
+    fd_tls_msg_hdr_t msg_hdr = {0};
+    long decode_res = fd_tls_decode_msg_hdr( &msg_hdr, wire, (ulong)(wire_end-wire) );
+    if( FD_UNLIKELY( decode_res<0L ) )
+      return fd_tls_alert( &hs->base, FD_TLS_ALERT_DECODE_ERROR, FD_TLS_REASON_NST_PARSE );
+    wire += (ulong)decode_res;
+
+    if( FD_UNLIKELY( msg_hdr.type != FD_TLS_MSG_NEW_SESSION_TICKET ) )
+      return fd_tls_alert( &hs->base, FD_TLS_ALERT_UNEXPECTED_MESSAGE, FD_TLS_REASON_NST_EXPECTED );
+
+    /* Decode NewSessionTicket */
+
+    ulong msg_sz = fd_tls_u24_to_uint( msg_hdr.sz );
+    if( FD_UNLIKELY( msg_sz > (ulong)(wire_end-wire) ) )
+      return fd_tls_alert( &hs->base, FD_TLS_ALERT_DECODE_ERROR, FD_TLS_REASON_NST_PARSE );
+
+    decode_res = fd_tls_decode_new_session_ticket( &nst, wire, msg_sz );
+    if( FD_UNLIKELY( decode_res<0L ) )
+      return fd_tls_alert( &hs->base, (uint)(-decode_res), FD_TLS_REASON_NST_PARSE );
+    if( FD_UNLIKELY( (ulong)decode_res != msg_sz ) )
+      return fd_tls_alert( &hs->base, FD_TLS_ALERT_DECODE_ERROR, FD_TLS_REASON_NST_PARSE );
+    wire += (ulong)decode_res;
+
+    read_sz = (ulong)(wire - record);
+  } while(0);
+
+  /* Store session ****************************************************/
+
+  if( ( !client->session_fn               ) |
+      ( !client->clock.clock_fn           ) |
+      ( !nst.ticket_lifetime              ) |  /* lifetime 0 means "do not use" */
+      ( nst.ticket_nonce_sz > 64UL        ) |
+      ( nst.ticket_sz > FD_TLS_SESSION_TICKET_SZ_MAX ) )
+    return (long)read_sz;
+
+  fd_tls_session_t session = {
+    .recv_ms   = fd_tls_clock( &client->clock ),
+    .lifetime  = fd_uint_min( nst.ticket_lifetime, FD_TLS_TICKET_LIFETIME_MAX ),
+    .age_add   = nst.ticket_age_add,
+    .ticket_sz = nst.ticket_sz
+  };
+  fd_tls_hkdf_expand_label( session.psk, 32UL,
+                            hs->resumption_secret,
+                            "resumption",     10UL,
+                            nst.ticket_nonce, nst.ticket_nonce_sz );
+  memcpy( session.server_pubkey, hs->server_pubkey, 32UL );
+  memcpy( session.ticket,        nst.ticket,        nst.ticket_sz );
+
+  client->session_fn( hs, &session );
+
+  fd_memset_explicit( session.psk, 0, 32UL );
+  return (long)read_sz;
+}
+
 char const *
 fd_tls_alert_cstr( uint alert ) {
   switch( alert ) {
@@ -1870,6 +2333,18 @@ fd_tls_reason_cstr( uint reason ) {
     return "ALPN negotiation failed";
   case FD_TLS_REASON_NO_ALPN:
     return "peer did not send ALPN extension";
+  case FD_TLS_REASON_PSK_NO_MODES:
+    return "ClientHello offered a PSK without psk_key_exchange_modes";
+  case FD_TLS_REASON_PSK_BINDER:
+    return "PSK binder mismatch";
+  case FD_TLS_REASON_PSK_SELECT:
+    return "server selected a PSK that was not offered";
+  case FD_TLS_REASON_NST_EXPECTED:
+    return "expected NewSessionTicket, but got other message type";
+  case FD_TLS_REASON_NST_PARSE:
+    return "failed to decode NewSessionTicket";
+  case FD_TLS_REASON_NST_ENCODE:
+    return "failed to encode NewSessionTicket";
   default:
     FD_LOG_WARNING(( "Missing fd_tls_reason_cstr code for %u (memory corruption?)", reason ));
     __attribute__((fallthrough));
@@ -22,8 +22,20 @@
    ### Key Exchange
 
    Peers exchange symmetric keys using X25519, an Elliptic Curve Diffie-
-   Hellman key exchange scheme using Curve25519.  Pre-shared keys and
-   other key exchange schemes are currently not supported.
+   Hellman key exchange scheme using Curve25519.  Other key exchange
+   schemes are currently not supported.
+
+   ### Session Resumption
+
+   Servers may issue stateless session tickets after the handshake.
+   A ticket is the resumption PSK sealed with a server-side AES-GCM
+   ticket key.  Clients may resume a session in a later handshake using
+   the psk_dhe_ke mode, which skips certificate authentication but
+   still performs an X25519 exchange (forward secrecy).  0-RTT (early
+   data) is not supported, thus replayed ClientHellos gain an attacker
+   nothing but a handshake.  Tickets are bounded by a lifetime and a
+   ticket age tolerance window and are invalidated by rotating the
+   ticket key twice.
 
    ### Data Confidentiality and Integratity
 
@@ -192,6 +204,36 @@ fd_tls_sign( fd_tls_sign_t const * sign,
 
 extern char const fd_tls13_cli_sign_prefix[ 98 ];
 
+/* fd_tls_clock_fn_t is called by fd_tls to read the current wallclock
+   time in milliseconds.  Only used for session tickets.  Should be
+   monotonic and consistent across the server instances sharing a
+   ticket key. */
+
+typedef ulong
+(* fd_tls_clock_fn_t)( void * ctx );
+
+struct fd_tls_clock_vt {
+  void *            ctx;
+  fd_tls_clock_fn_t clock_fn;
+};
+
+typedef struct fd_tls_clock_vt fd_tls_clock_t;
+
+static inline ulong
+fd_tls_clock( fd_tls_clock_t const * clock ) {
+  return clock->clock_fn( clock->ctx );
+}
+
+/* fd_tls_session_fn_t is called by an fd_tls client when the server
+   issued a session ticket.  session points to the new session, which
+   is valid for the lifetime of the call (the callee should copy it).
+   The session may be passed to a future handshake via
+   fd_tls_estate_cli_t::session. */
+
+typedef void
+(* fd_tls_session_fn_t)( void const *             handshake,
+                         fd_tls_session_t const * session );
+
 /* Public API *********************************************************/
 
 /* Handshake state identifiers */
@@ -228,6 +270,38 @@ extern char const fd_tls13_cli_sign_prefix[ 98 ];
 
 # define FD_TLS_EXT_QUIC_PARAMS_SZ_MAX (510UL)
 
+/* FD_TLS_TICKET_LIFETIME_MAX is the max session ticket lifetime in
+   seconds (7 days, RFC 8446 Section 4.6.1). */
+
+#define FD_TLS_TICKET_LIFETIME_MAX (604800U)
+
+/* FD_TLS_TICKET_AGE_TOLERANCE_MS is the max permitted difference
+   between the ticket age reported by the client and the actual ticket
+   age observed by the server.  Should cover RTT and clock drift. */
+
+#define FD_TLS_TICKET_AGE_TOLERANCE_MS (10000UL)
+
+/* FD_TLS_TICKET_SZ is the size of session tickets issued by fd_tls
+   servers.  Format:
+
+     uint  key_id       fd_tls_ticket_key_t::id
+     uchar iv[12]       random AES-GCM IV
+     uchar ct[44]       encrypted psk[32], issue_ms[8], age_add[4]
+     uchar tag[16]      AES-GCM tag (AAD is key_id) */
+
+#define FD_TLS_TICKET_SZ (76UL)
+
+/* fd_tls_ticket_key_t is a symmetric key used to seal and open session
+   tickets. */
+
+struct fd_tls_ticket_key {
+  uint  id;
+  uint  valid;
+  uchar key[ 16 ];
+};
+
+typedef struct fd_tls_ticket_key fd_tls_ticket_key_t;
+
 /* fd_tls_t contains the local TLS config.  It is typically shared
    across multiple TLS handshakes. */
 
@@ -280,6 +354,22 @@ struct fd_tls {
   uchar alpn[ 32 ];
   ulong alpn_sz;
 
+  /* Session resumption (optional).
+
+     Servers issue session tickets if ticket_lifetime is non-zero and a
+     ticket key was installed via fd_tls_rotate_ticket_key.  Tickets
+     sealed with ticket_key[0] (current) or ticket_key[1] (previous)
+     are accepted.  ticket_lifetime is in seconds and is clamped to
+     FD_TLS_TICKET_LIFETIME_MAX.
+
+     Clients request tickets if session_fn is set.
+
+     Both roles require clock to be set. */
+  fd_tls_clock_t      clock;
+  fd_tls_session_fn_t session_fn;
+  fd_tls_ticket_key_t ticket_key[2];
+  uint                ticket_lifetime;
+
   /* Flags */
   ulong quic            :  1;
   ulong _flags_reserved : 63;
@@ -350,6 +440,13 @@ typedef struct fd_tls fd_tls_t;
 #define FD_TLS_REASON_ALPN_NEG       (1002)  /* ALPN negotiation failed */
 #define FD_TLS_REASON_NO_ALPN        (1003)  /* no ALPN extension */
 
+#define FD_TLS_REASON_PSK_NO_MODES   (1101)  /* pre_shared_key without psk_key_exchange_modes */
+#define FD_TLS_REASON_PSK_BINDER     (1102)  /* PSK binder mismatch */
+#define FD_TLS_REASON_PSK_SELECT     (1103)  /* server selected a PSK that was not offered */
+#define FD_TLS_REASON_NST_EXPECTED   (1104)  /* wanted NewSessionTicket, got another msg type */
+#define FD_TLS_REASON_NST_PARSE      (1105)  /* failed to parse NewSessionTicket */
+#define FD_TLS_REASON_NST_ENCODE     (1106)  /* failed to encode NewSessionTicket */
+
 FD_PROTOTYPES_BEGIN
 
 FD_FN_CONST ulong
@@ -378,6 +475,17 @@ fd_tls_alert_cstr( uint alert );
 char const *
 fd_tls_reason_cstr( uint reason );
 
+/* fd_tls_rotate_ticket_key installs a new session ticket key.  key
+   points to 16 bytes of secure randomness.  The current key becomes the
+   previous key, which is still accepted for tickets issued before the
+   rotation.  Tickets sealed with older keys are rejected (resulting in
+   a full handshake).  Should be called periodically (at least once per
+   ticket lifetime) to limit the impact of key compromise. */
+
+void
+fd_tls_rotate_ticket_key( fd_tls_t *  tls,
+                          uchar const key[ static 16 ] );
+
 /* fd_tls_server_handshake ingests a TLS message from the client.
    Synchronously processes the message (API may become async in the
    future).  Record must be complete (does not defragment).  Returns
@@ -392,8 +500,9 @@ fd_tls_server_handshake( fd_tls_t const *      tls,
                          uint                  encryption_level );
 
 /* fd_tls_client_handshake is the client-side equivalent of
-   fd_tls_server_handshake.  Must not be called with messages sent after
-   the handshake was completed (such as NewSessionTicket). */
+   fd_tls_server_handshake.  After the handshake was completed, accepts
+   NewSessionTicket messages at the APPLICATION encryption level (other
+   post-handshake messages are rejected). */
 
 long
 fd_tls_client_handshake( fd_tls_t const *      client,
@@ -135,6 +135,7 @@ struct fd_tls_estate_srv {
   uchar  client_cert     : 1;  /* 0: no client auth  1: client cert */
   uchar  client_cert_rpk : 1;  /* 0: X.509  1: raw public key */
   uchar  hello_retry     : 1;
+  uchar  resumed         : 1;  /* 1 if client resumed a session via PSK */
 
   fd_tls_transcript_t transcript;
   uchar               client_hs_secret[32];
@@ -169,6 +170,32 @@ fd_tls_estate_srv_delete( fd_tls_estate_srv_t * estate ) {
 FD_PROTOTYPES_END
 
 
+/* Session ************************************************************/
+
+/* FD_TLS_SESSION_TICKET_SZ_MAX is the max ticket size that a client
+   will store.  Larger tickets are ignored.  Fits the stateless tickets
+   issued by rustls (~400 bytes). */
+
+#define FD_TLS_SESSION_TICKET_SZ_MAX (512UL)
+
+/* fd_tls_session_t holds the client-side state required to resume a
+   TLS session (RFC 8446, Section 2.2).  Created from a NewSessionTicket
+   sent by the server after the handshake.  Contains secret key
+   material.  A session should be used at most once, as reusing tickets
+   allows an observer to correlate connections. */
+
+struct fd_tls_session {
+  uchar  psk          [ 32 ];  /* resumption PSK */
+  uchar  server_pubkey[ 32 ];  /* server identity authenticated in original handshake */
+  ulong  recv_ms;              /* wallclock (fd_tls_clock_t) at ticket receipt */
+  uint   lifetime;             /* ticket lifetime in seconds */
+  uint   age_add;              /* ticket age obfuscation */
+  ushort ticket_sz;            /* 0 indicates unused session */
+  uchar  ticket[ FD_TLS_SESSION_TICKET_SZ_MAX ];
+};
+
+typedef struct fd_tls_session fd_tls_session_t;
+
 /* Client *************************************************************/
 
 /* fd_tls_estate_cli contains TLS client handshake state while waiting
@@ -202,6 +229,18 @@ struct fd_tls_estate_cli {
   uchar client_cert_nox509 : 1;
   uchar client_cert_rpk    : 1;
   uchar server_pubkey_pin  : 1;  /* if 1, require cert to match server_pubkey */
+  uchar psk_offered        : 1;  /* 1 if ClientHello offered session */
+  uchar psk_accepted       : 1;  /* 1 if server resumed session */
+
+  /* session is an optional session to resume.  Only read during the
+     first call to fd_tls_client_handshake (when sending ClientHello).
+     If psk_offered, psk holds the session PSK. */
+  fd_tls_session_t const * session;
+  uchar                    psk[ 32 ];
+
+  /* resumption_secret is derived after the handshake completed.  Used
+     to derive PSKs from session tickets issued by the server. */
+  uchar resumption_secret[ 32 ];
 
   fd_sha256_t transcript;
 };
@@ -139,6 +139,16 @@ fd_tls_decode_client_hello( fd_tls_client_hello_t * out,
     case FD_TLS_EXT_ALPN:
       ext_parse_res = fd_tls_decode_ext_alpn( &out->alpn, ext_data, ext_sz );
       break;
+    case FD_TLS_EXT_PSK_KEY_EXCHANGE_MODES:
+      ext_parse_res = fd_tls_decode_ext_psk_kex_modes( &out->psk_kex_modes, ext_data, ext_sz );
+      break;
+    case FD_TLS_EXT_PRE_SHARED_KEY:
+      /* RFC 8446 mandates that pre_shared_key is the last extension
+         (binders are computed over everything preceding it) */
+      if( FD_UNLIKELY( wire_laddr + ext_sz != list_stop ) )
+        return -(long)FD_TLS_ALERT_ILLEGAL_PARAMETER;
+      ext_parse_res = fd_tls_decode_ext_psk( &out->psk, ext_data, ext_sz );
+      break;
     default:
       ext_parse_res = (long)ext_sz;
       break;
@@ -254,6 +264,47 @@ fd_tls_encode_client_hello( fd_tls_client_hello_t const * in,
 # undef FIELDS
   }
 
+  /* Add PSK key exchange modes */
+
+  if( in->psk_kex_modes.psk_dhe_ke ) {
+    ushort psk_modes_ext_type = FD_TLS_EXT_PSK_KEY_EXCHANGE_MODES;
+    ushort psk_modes_ext_sz   = 2;
+    uchar  psk_modes_sz       = 1;
+    uchar  psk_mode           = FD_TLS_PSK_KE_MODE_PSK_DHE_KE;
+#   define FIELDS( FIELD )                      \
+    FIELD( 0, &psk_modes_ext_type, ushort, 1 ); \
+    FIELD( 1, &psk_modes_ext_sz,   ushort, 1 ); \
+    FIELD( 2, &psk_modes_sz,       uchar,  1 ); \
+    FIELD( 3, &psk_mode,           uchar,  1 );
+    FD_TLS_ENCODE_STATIC_BATCH( FIELDS )
+# undef FIELDS
+  }
+
+  /* Add pre-shared key offer.  Must be the last extension.  The binder
+     is copied as-is, callers typically patch it after encoding (it is
+     the last 32 bytes of the message). */
+
+  if( in->psk.identity_sz ) {
+    ushort psk_identity_sz   = in->psk.identity_sz;
+    ushort psk_identities_sz = (ushort)( 2UL + psk_identity_sz + 4UL );
+    uchar  psk_binder_sz     = 32;
+    ushort psk_binders_sz    = 33;
+    ushort psk_ext_type      = FD_TLS_EXT_PRE_SHARED_KEY;
+    ushort psk_ext_sz        = (ushort)( 2UL + psk_identities_sz + 2UL + psk_binders_sz );
+#   define FIELDS( FIELD )                                              \
+    FIELD( 0, &psk_ext_type,                  ushort, 1               ); \
+    FIELD( 1, &psk_ext_sz,                    ushort, 1               ); \
+    FIELD( 2, &psk_identities_sz,             ushort, 1               ); \
+    FIELD( 3, &psk_identity_sz,               ushort, 1               ); \
+    FIELD( 4,  in->psk.identity,              uchar,  psk_identity_sz ); \
+    FIELD( 5, &in->psk.obfuscated_ticket_age, uint,   1               ); \
+    FIELD( 6, &psk_binders_sz,                ushort, 1               ); \
+    FIELD( 7, &psk_binder_sz,                 uchar,  1               ); \
+    FIELD( 8,  in->psk.binder,                uchar,  32UL            );
+    FD_TLS_ENCODE_STATIC_BATCH( FIELDS )
+# undef FIELDS
+  }
+
   FD_STORE( ushort, extension_tot_sz, fd_ushort_bswap( (ushort)( (ulong)wire_laddr - extension_start ) ) );
   return (long)( wire_laddr - (ulong)wire );
 }
@@ -332,6 +383,11 @@ fd_tls_decode_server_hello( fd_tls_server_hello_t * out,
       /* Copy transport params as-is (TODO...) */
       ext_parse_res = (long)ext_sz;
       break;
+    case FD_TLS_EXT_PRE_SHARED_KEY:
+      FD_TLS_DECODE_FIELD( &out->psk_identity, ushort );
+      out->has_psk  = 1;
+      ext_parse_res = 2L;
+      break;
     default:
       /* Reject unsolicited extensions */
       return -(long)FD_TLS_ALERT_ILLEGAL_PARAMETER;
@@ -406,6 +462,17 @@ fd_tls_encode_server_hello( fd_tls_server_hello_t const * in,
     FD_TLS_ENCODE_STATIC_BATCH( FIELDS )
 # undef FIELDS
 
+  if( in->has_psk ) {
+    ushort ext_psk_ext_type = FD_TLS_EXT_PRE_SHARED_KEY;
+    ushort ext_psk_ext_sz   = sizeof(ushort);
+#   define FIELDS( FIELD )                           \
+      FIELD( 0, &ext_psk_ext_type,  ushort, 1    ) \
+      FIELD( 1, &ext_psk_ext_sz,    ushort, 1    ) \
+      FIELD( 2, &in->psk_identity,  ushort, 1    )
+      FD_TLS_ENCODE_STATIC_BATCH( FIELDS )
+#   undef FIELDS
+  }
+
   *extension_tot_sz = fd_ushort_bswap( (ushort)( (ulong)wire_laddr - extension_start ) );
   return (long)( wire_laddr - (ulong)wire );
 }
@@ -519,6 +586,60 @@ fd_tls_decode_enc_ext( fd_tls_enc_ext_t * const out,
   return (long)( wire_laddr - (ulong)wire );
 }
 
+long
+fd_tls_decode_new_session_ticket( fd_tls_new_session_ticket_t * out,
+                                  uchar const *                 wire,
+                                  ulong                         wire_sz ) {
+
+  ulong wire_laddr = (ulong)wire;
+
+# define FIELDS( FIELD )                               \
+    FIELD( 0, &out->ticket_lifetime, uint,  1 ) \
+    FIELD( 1, &out->ticket_age_add,  uint,  1 ) \
+    FIELD( 2, &out->ticket_nonce_sz, uchar, 1 )
+    FD_TLS_DECODE_STATIC_BATCH( FIELDS )
+# undef FIELDS
+
+  out->ticket_nonce = FD_TLS_SKIP_FIELDS( uchar, out->ticket_nonce_sz );
+
+  FD_TLS_DECODE_FIELD( &out->ticket_sz, ushort );
+  if( FD_UNLIKELY( !out->ticket_sz ) )
+    return -(long)FD_TLS_ALERT_DECODE_ERROR;
+  out->ticket = FD_TLS_SKIP_FIELDS( uchar, out->ticket_sz );
+
+  /* Skip extensions (early_data is the only one defined) */
+
+  ushort ext_sz;
+  FD_TLS_DECODE_FIELD( &ext_sz, ushort );
+  uchar const * ext = FD_TLS_SKIP_FIELDS( uchar, ext_sz );
+  (void)ext;
+
+  return (long)( wire_laddr - (ulong)wire );
+}
+
+long
+fd_tls_encode_new_session_ticket( fd_tls_new_session_ticket_t const * in,
+                                  uchar *                             wire,
+                                  ulong                               wire_sz ) {
+
+  ulong wire_laddr = (ulong)wire;
+
+  ushort ext_sz = 0;
+
+# define FIELDS( FIELD )                                              \
+    FIELD( 0, &in->ticket_lifetime, uint,   1                   ) \
+    FIELD( 1, &in->ticket_age_add,  uint,   1                   ) \
+    FIELD( 2, &in->ticket_nonce_sz, uchar,  1                   ) \
+    FIELD( 3,  in->ticket_nonce,    uchar,  in->ticket_nonce_sz ) \
+    FIELD( 4, &in->ticket_sz,       ushort, 1                   ) \
+    FIELD( 5,  in->ticket,          uchar,  in->ticket_sz       ) \
+    FIELD( 6, &ext_sz,              ushort, 1                   )
+    FD_TLS_ENCODE_STATIC_BATCH( FIELDS )
+# undef FIELDS
+
+  return (long)( wire_laddr - (ulong)wire );
+}
+
 long
 fd_tls_encode_cert_x509( uchar const * x509,
                          ulong         x509_sz,
@@ -926,6 +1047,97 @@ fd_tls_encode_ext_cert_type( fd_tls_ext_cert_type_t in,
   return (long)( wire_laddr - (ulong)wire );
 }
 
+long
+fd_tls_decode_ext_psk_kex_modes( fd_tls_ext_psk_kex_modes_t * out,
+                                 uchar const *                wire,
+                                 ulong                        wire_sz ) {
+
+  ulong wire_laddr = (ulong)wire;
+
+  out->present = 1;
+  FD_TLS_DECODE_LIST_BEGIN( uchar, alignof(uchar) ) {
+    uchar mode;
+    FD_TLS_DECODE_FIELD( &mode, uchar );
+    switch( mode ) {
+    case FD_TLS_PSK_KE_MODE_PSK_DHE_KE: out->psk_dhe_ke = 1; break;
+    default:
+      /* Ignore unsupported modes (psk_ke) ... */
+      break;
+    }
+  }
+  FD_TLS_DECODE_LIST_END
+
+  return (long)( wire_laddr - (ulong)wire );
+}
+
+long
+fd_tls_decode_ext_psk( fd_tls_ext_psk_t * out,
+                       uchar const *      wire,
+                       ulong              wire_sz ) {
+
+  ulong wire_laddr = (ulong)wire;
+
+  /* PskIdentity identities<7..2^16-1> */
+
+  ulong identity_cnt = 0UL;
+  FD_TLS_DECODE_LIST_BEGIN( ushort, alignof(uchar) ) {
+    ushort identity_sz;
+    FD_TLS_DECODE_FIELD( &identity_sz, ushort );
+
+    /* Bounds check identity */
+    if( FD_UNLIKELY( (!identity_sz) | (wire_laddr + identity_sz > list_stop) ) )
+      return -(long)FD_TLS_ALERT_DECODE_ERROR;
+    uchar const * identity = (uchar const *)wire_laddr;
+    wire_laddr += identity_sz;
+    wire_sz    -= identity_sz;
+
+    uint obfuscated_ticket_age;
+    FD_TLS_DECODE_FIELD( &obfuscated_ticket_age, uint );
+
+    /* Remember first identity */
+    if( !identity_cnt ) {
+      out->identity              = identity;
+      out->identity_sz           = identity_sz;
+      out->obfuscated_ticket_age = obfuscated_ticket_age;
+    }
+    identity_cnt++;
+  }
+  FD_TLS_DECODE_LIST_END
+
+  if( FD_UNLIKELY( !identity_cnt ) )
+    return -(long)FD_TLS_ALERT_DECODE_ERROR;
+
+  /* PskBinderEntry binders<33..2^16-1> */
+
+  out->binders = (uchar const *)wire_laddr;
+  ulong binder_cnt = 0UL;
+  FD_TLS_DECODE_LIST_BEGIN( ushort, alignof(uchar) ) {
+    uchar binder_sz;
+    FD_TLS_DECODE_FIELD( &binder_sz, uchar );
+
+    /* Bounds check binder */
+    if( FD_UNLIKELY( wire_laddr + binder_sz > list_stop ) )
+      return -(long)FD_TLS_ALERT_DECODE_ERROR;
+
+    /* Remember first binder */
+    if( !binder_cnt ) {
+      if( FD_UNLIKELY( binder_sz!=32UL ) )
+        return -(long)FD_TLS_ALERT_ILLEGAL_PARAMETER;
+      memcpy( out->binder, (uchar const *)wire_laddr, 32UL );
+    }
+    binder_cnt++;
+
+    wire_laddr += binder_sz;
+    wire_sz    -= binder_sz;
+  }
+  FD_TLS_DECODE_LIST_END
+
+  if( FD_UNLIKELY( binder_cnt!=identity_cnt ) )
+    return -(long)FD_TLS_ALERT_ILLEGAL_PARAMETER;
+
+  return (long)( wire_laddr - (ulong)wire );
+}
+
 long
 fd_tls_decode_ext_opaque( fd_tls_ext_opaque_t * const out,
                           uchar const *         const wire,
@@ -81,6 +81,34 @@ union fd_tls_ext_cert_type_list {
 
 typedef union fd_tls_ext_cert_type_list fd_tls_ext_cert_type_list_t;
 
+/* Pre-shared key exchange modes (RFC 8446)
+   Type: FD_TLS_EXT_PSK_KEY_EXCHANGE_MODES */
+
+struct fd_tls_ext_psk_kex_modes {
+  uchar present    : 1;  /* if 0, indicates that this extension is missing */
+  uchar psk_dhe_ke : 1;
+};
+
+typedef struct fd_tls_ext_psk_kex_modes fd_tls_ext_psk_kex_modes_t;
+
+/* Pre-shared key offer (RFC 8446, Section 4.2.11)
+   Type: FD_TLS_EXT_PRE_SHARED_KEY
+
+   fd_tls only considers the first PSK identity offered by a client.
+   On decode, identity and binders point into the decoded buffer.
+   binders points to the size prefix of the binder list, i.e. the end
+   of the partial ClientHello that binders are computed over. */
+
+struct fd_tls_ext_psk {
+  uchar const * identity;
+  ushort        identity_sz;  /* if 0, indicates that this extension is missing */
+  uint          obfuscated_ticket_age;
+  uchar const * binders;
+  uchar         binder[ 32 ];
+};
+
+typedef struct fd_tls_ext_psk fd_tls_ext_psk_t;
+
 struct fd_tls_ext_cert_type {
   uchar cert_type;
 };
@@ -148,6 +176,8 @@ struct fd_tls_client_hello {
   fd_tls_ext_cert_type_list_t       client_cert_types;
   fd_tls_ext_quic_tp_t              quic_tp;
   fd_tls_ext_alpn_t                 alpn;
+  fd_tls_ext_psk_kex_modes_t        psk_kex_modes;
+  fd_tls_ext_psk_t                  psk;  /* always last on the wire */
 };
 
 typedef struct fd_tls_client_hello fd_tls_client_hello_t;
@@ -161,6 +191,9 @@ struct fd_tls_server_hello {
 
   fd_tls_ext_opaque_t session_id;
   fd_tls_key_share_t  key_share;
+
+  uchar  has_psk;       /* 1 if pre_shared_key extension present */
+  ushort psk_identity;  /* index of PSK identity selected by server */
 };
 
 typedef struct fd_tls_server_hello fd_tls_server_hello_t;
@@ -198,6 +231,22 @@ struct __attribute__((packed)) fd_tls_finished {
 
 typedef struct fd_tls_finished fd_tls_finished_t;
 
+/* fd_tls_new_session_ticket_t describes a NewSessionTicket (RFC 8446,
+   Section 4.6.1).  On decode, ticket_nonce and ticket point into the
+   decoded buffer.  Extensions are ignored (fd_tls never accepts early
+   data). */
+
+struct fd_tls_new_session_ticket {
+  uint          ticket_lifetime;  /* in seconds */
+  uint          ticket_age_add;
+  uchar const * ticket_nonce;
+  uchar         ticket_nonce_sz;
+  uchar const * ticket;
+  ushort        ticket_sz;
+};
+
+typedef struct fd_tls_new_session_ticket fd_tls_new_session_ticket_t;
+
 /* Enums **************************************************************/
 
 /* TLS Legacy Version field */
@@ -217,8 +266,10 @@ typedef struct fd_tls_finished fd_tls_finished_t;
 #define FD_TLS_EXT_ALPN                  ((ushort)16)
 #define FD_TLS_EXT_CLIENT_CERT_TYPE      ((ushort)19)
 #define FD_TLS_EXT_SERVER_CERT_TYPE      ((ushort)20)
+#define FD_TLS_EXT_PRE_SHARED_KEY        ((ushort)41)
+#define FD_TLS_EXT_EARLY_DATA            ((ushort)42)
 #define FD_TLS_EXT_SUPPORTED_VERSIONS    ((ushort)43)
-#define FD_TLS_EXT_KEY_SHARE             ((ushort)51)
+#define FD_TLS_EXT_PSK_KEY_EXCHANGE_MODES ((ushort)45)
 #define FD_TLS_EXT_KEY_SHARE             ((ushort)51)
 #define FD_TLS_EXT_QUIC_TRANSPORT_PARAMS ((ushort)57)
 
@@ -268,6 +319,11 @@ typedef struct fd_tls_finished fd_tls_finished_t;
 
 #define FD_TLS_VERSION_TLS13 ((ushort)0x0304)
 
+/* TLS psk_key_exchange_modes extension */
+
+#define FD_TLS_PSK_KE_MODE_PSK_KE     ((uchar)0)
+#define FD_TLS_PSK_KE_MODE_PSK_DHE_KE ((uchar)1)
+
 /* TLS key_share extension */
 
 #define FD_TLS_KEY_SHARE_TYPE_X25519 ((ushort)29)
@@ -438,6 +494,16 @@ fd_tls_encode_enc_ext( fd_tls_enc_ext_t const * in,
                        uchar *                  wire,
                        ulong                    wire_sz );
 
+long
+fd_tls_decode_new_session_ticket( fd_tls_new_session_ticket_t * out,
+                                  uchar const *                 wire,
+                                  ulong                         wire_sz );
+
+long
+fd_tls_encode_new_session_ticket( fd_tls_new_session_ticket_t const * in,
+                                  uchar *                             wire,
+                                  ulong                               wire_sz );
+
 long
 fd_tls_encode_cert_x509( uchar const * x509,
                          ulong         x509_sz,
@@ -516,6 +582,20 @@ fd_tls_encode_ext_cert_type( fd_tls_ext_cert_type_t in,
                              uchar const *          wire,
                              ulong                  wire_sz );
 
+long
+fd_tls_decode_ext_psk_kex_modes( fd_tls_ext_psk_kex_modes_t * out,
+                                 uchar const *                wire,
+                                 ulong                        wire_sz );
+
+/* fd_tls_decode_ext_psk decodes the ClientHello variant of the
+   pre_shared_key extension.  Rejects mismatched identity and binder
+   counts and first binders that are not 32 bytes long (SHA-256). */
+
+long
+fd_tls_decode_ext_psk( fd_tls_ext_psk_t * out,
+                       uchar const *      wire,
+                       ulong              wire_sz );
+
 /* fd_tls_decode_ext_opaque is special:
    out->{buf,buf_sz} will be set to {wire,wire_sz}.
    i.e. lifetime of out->quic_tp is that of wire. */
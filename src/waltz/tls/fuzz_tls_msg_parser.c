@@ -60,6 +60,11 @@ LLVMFuzzerTestOneInput( uchar const * data,
       fd_tls_decode_finished( &fin, data, rec_sz );
       break;
     }
+    case FD_TLS_MSG_NEW_SESSION_TICKET: {
+      fd_tls_new_session_ticket_t nst = {0};
+      fd_tls_decode_new_session_ticket( &nst, data, rec_sz );
+      break;
+    }
   }
   return 0;
 }
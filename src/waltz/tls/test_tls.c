@@ -44,7 +44,8 @@ test_client_hello_decode( void ) {
         0xcf, 0x24, 0x6d, 0x65, 0x48, 0xfd, 0xdf, 0x77, 0x52, 0xd5, 0x87, 0xac, 0xff, 0x9e, 0x93, 0xa5,
         0x3c, 0x8b, 0x46, 0xdd, 0xb2, 0x2d, 0x1f, 0xbc, 0xef, 0x82, 0xe6, 0x71, 0x57, 0xab, 0x11, 0x3c
       }
-    }
+    },
+    .psk_kex_modes = { .present = 1, .psk_dhe_ke = 1 }
   };
   /* TODO compare QUIC transport params */
   /* Clear out QUIC transport params, as those will have to be compared separately */
@@ -91,12 +92,50 @@ test_server_finished_decode( void ) {
   FD_TEST( sz>=0L );
 }
 
+static void
+test_new_session_ticket( void ) {
+  static uchar const nonce [  1 ] = { 0x00 };
+  static uchar const ticket[ 20 ] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+                                      0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14 };
+  fd_tls_new_session_ticket_t nst = {
+    .ticket_lifetime = 7200U,
+    .ticket_age_add  = 0xdeadbeefU,
+    .ticket_nonce    = nonce,
+    .ticket_nonce_sz = sizeof(nonce),
+    .ticket          = ticket,
+    .ticket_sz       = sizeof(ticket)
+  };
+
+  uchar buf[ 64 ];
+  long sz = fd_tls_encode_new_session_ticket( &nst, buf, sizeof(buf) );
+  FD_TEST( sz==(long)( 4+4+1+sizeof(nonce)+2+sizeof(ticket)+2 ) );
+  FD_TEST( fd_tls_encode_new_session_ticket( &nst, buf, (ulong)sz-1UL )<0L );
+
+  fd_tls_new_session_ticket_t out = {0};
+  FD_TEST( fd_tls_decode_new_session_ticket( &out, buf, (ulong)sz )==sz );
+  FD_TEST( out.ticket_lifetime==7200U       );
+  FD_TEST( out.ticket_age_add ==0xdeadbeefU );
+  FD_TEST( out.ticket_nonce_sz==1           );
+  FD_TEST( out.ticket_sz      ==20          );
+  FD_TEST( 0==memcmp( out.ticket, ticket, sizeof(ticket) ) );
+
+  /* Truncated message */
+  FD_TEST( fd_tls_decode_new_session_ticket( &out, buf, (ulong)sz-3UL )<0L );
+
+  /* Empty ticket is invalid */
+  nst.ticket_sz = 0;
+  sz = fd_tls_encode_new_session_ticket( &nst, buf, sizeof(buf) );
+  FD_TEST( sz>0L );
+  FD_TEST( fd_tls_decode_new_session_ticket( &out, buf, (ulong)sz )<0L );
+}
+
 static void
 test_tls_proto( void ) {
   test_client_hello_decode();
   test_server_hello_encode();
   test_server_hello_decode();
   test_server_finished_decode();
+  test_new_session_ticket();
 }
 
 /* Client/server integration test *************************************/
@@ -241,6 +280,170 @@ test_tls_pair( fd_rng_t * rng ) {
   fd_tls_delete( fd_tls_leave( client ) );
 }
 
+/* Session resumption tests */
+
+static ulong test_clock_ms = 1000000UL;
+
+static ulong
+test_tls_clock( void * ctx ) {
+  (void)ctx;
+  return test_clock_ms;
+}
+
+static fd_tls_session_t test_session[1];
+static ulong            test_session_cnt;
+
+static void
+test_tls_session( void const *             handshake,
+                  fd_tls_session_t const * session ) {
+  (void)handshake;
+  *test_session = *session;
+  test_session_cnt++;
+}
+
+static void
+test_tls_resume_hs( fd_tls_t *               client,
+                    fd_tls_t *               server,
+                    fd_tls_estate_cli_t *    cli_hs,
+                    fd_tls_estate_srv_t *    srv_hs,
+                    fd_tls_session_t const * session ) {
+
+  test_record_reset( &test_server_out );
+  test_record_reset( &test_client_out );
+
+  FD_TEST( fd_tls_estate_srv_new( srv_hs ) );
+  test_server_hs = srv_hs;
+  FD_TEST( fd_tls_estate_cli_new( cli_hs ) );
+  cli_hs->session = session;
+
+  FD_TEST( fd_tls_client_handshake( client, cli_hs, NULL, 0UL, FD_TLS_LEVEL_INITIAL )==0L );
+  FD_TEST( !cli_hs->session );
+  test_tls_server_respond( server, srv_hs );
+  test_tls_client_respond( client, cli_hs );
+  test_tls_server_respond( server, srv_hs );
+
+  FD_TEST( srv_hs->base.state==FD_TLS_HS_CONNECTED );
+  FD_TEST( cli_hs->base.state==FD_TLS_HS_CONNECTED );
+  FD_TEST( srv_hs->resumed==cli_hs->psk_accepted );
+  FD_TEST( 0==memcmp( cli_hs->server_pubkey, server->cert_public_key, 32UL ) );
+}
+
+static void
+test_tls_resume( fd_rng_t * rng ) {
+
+  fd_tls_t _client[1]; fd_tls_t * client = fd_tls_join( fd_tls_new( _client ) );
+  fd_tls_t _server[1]; fd_tls_t * server = fd_tls_join( fd_tls_new( _server ) );
+  prepare_tls_pair( rng, client, server );
+
+  fd_tls_clock_t clock = { .clock_fn = test_tls_clock };
+  client->clock      = clock;
+  client->session_fn = test_tls_session;
+  server->clock           = clock;
+  server->ticket_lifetime = 3600U;
+
+  uchar ticket_key[ 16 ];
+  for( ulong b=0; b<16UL; b++ ) ticket_key[b] = fd_rng_uchar( rng );
+  fd_tls_rotate_ticket_key( server, ticket_key );
+
+  fd_tls_estate_srv_t srv_hs[1];
+  fd_tls_estate_cli_t cli_hs[1];
+  fd_tls_session_t    session[1];
+
+  /* Full handshake issues a ticket */
+
+  test_session_cnt = 0UL;
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, NULL );
+  FD_TEST( !cli_hs->psk_offered );
+  FD_TEST( !srv_hs->resumed );
+  FD_TEST( test_session_cnt==1UL );
+  FD_TEST( test_session->ticket_sz==FD_TLS_TICKET_SZ );
+  FD_TEST( test_session->lifetime ==3600U );
+  FD_TEST( 0==memcmp( test_session->server_pubkey, server->cert_public_key, 32UL ) );
+  *session = *test_session;
+
+  /* Resumed handshake skips certificates and issues a new ticket */
+
+  test_clock_ms += 2000UL;
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, session );
+  FD_TEST( cli_hs->psk_offered );
+  FD_TEST( cli_hs->psk_accepted );
+  FD_TEST( test_session_cnt==2UL );
+  FD_TEST( 0!=memcmp( test_session->psk, session->psk, 32UL ) );
+
+  /* Resumption still works after one key rotation */
+
+  for( ulong b=0; b<16UL; b++ ) ticket_key[b] = fd_rng_uchar( rng );
+  fd_tls_rotate_ticket_key( server, ticket_key );
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, session );
+  FD_TEST( cli_hs->psk_accepted );
+
+  /* ... but not after two */
+
+  fd_tls_rotate_ticket_key( server, ticket_key );
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, session );
+  FD_TEST( cli_hs->psk_offered );
+  FD_TEST( !cli_hs->psk_accepted );
+  *session = *test_session;
+
+  /* Server rejects tickets where the client's view of the ticket age
+     is off */
+
+  fd_tls_session_t skewed[1] = { *session };
+  test_clock_ms  += 60000UL;
+  skewed->recv_ms = test_clock_ms;
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, skewed );
+  FD_TEST( cli_hs->psk_offered );
+  FD_TEST( !cli_hs->psk_accepted );
+  *session = *test_session;
+
+  /* Server rejects expired tickets */
+
+  test_clock_ms  += 3601000UL;
+  skewed[0]       = *session;
+  skewed->recv_ms = test_clock_ms;
+  skewed->age_add = session->age_add + 3601000U;
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, skewed );
+  FD_TEST( cli_hs->psk_offered );
+  FD_TEST( !cli_hs->psk_accepted );
+
+  /* Client does not offer expired sessions */
+
+  test_clock_ms += 3601000UL;
+  test_tls_resume_hs( client, server, cli_hs, srv_hs, session );
+  FD_TEST( !cli_hs->psk_offered );
+
+  /* Client does not offer sessions to a different pinned server */
+
+  *session = *test_session;
+  test_record_reset( &test_client_out );
+  FD_TEST( fd_tls_estate_cli_new( cli_hs ) );
+  cli_hs->session           = session;
+  cli_hs->server_pubkey_pin = 1;
+  FD_TEST( fd_tls_client_handshake( client, cli_hs, NULL, 0UL, FD_TLS_LEVEL_INITIAL )==0L );
+  FD_TEST( !cli_hs->psk_offered );
+
+  /* Bad binder aborts the handshake */
+
+  session->psk[0] ^= 1;
+  test_record_reset( &test_client_out );
+  FD_TEST( fd_tls_estate_srv_new( srv_hs ) );
+  FD_TEST( fd_tls_estate_cli_new( cli_hs ) );
+  cli_hs->session = session;
+  FD_TEST( fd_tls_client_handshake( client, cli_hs, NULL, 0UL, FD_TLS_LEVEL_INITIAL )==0L );
+  FD_TEST( cli_hs->psk_offered );
+  test_record_t * rec = test_record_recv( &test_client_out );
+  FD_TEST( rec );
+  long res = fd_tls_server_handshake( server, srv_hs, rec->buf, rec->cur, rec->level );
+  FD_TEST( res==-(long)FD_TLS_ALERT_DECRYPT_ERROR );
+  FD_TEST( srv_hs->base.reason==FD_TLS_REASON_PSK_BINDER );
+
+  test_server_hs = NULL;
+  fd_tls_estate_srv_delete( srv_hs );
+  fd_tls_estate_cli_delete( cli_hs );
+  fd_tls_delete( fd_tls_leave( server ) );
+  fd_tls_delete( fd_tls_leave( client ) );
+}
+
 static void
 test_tls_client_wrong_ciphersuite( fd_rng_t * rng ) {
 
@@ -335,6 +538,7 @@ main( int     argc,
 
   test_tls_proto();
   test_tls_pair( rng );
+  test_tls_resume( rng );
   test_tls_client_wrong_ciphersuite( rng );
   test_tls_server_wrong_ciphersuite( rng );
 
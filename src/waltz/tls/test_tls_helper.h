@@ -106,7 +106,7 @@ test_record_send( test_record_buf_t * buf,
 static FD_FN_UNUSED test_record_t *
 test_record_recv( test_record_buf_t * buf ) {
   if( buf->recv==buf->send ) return NULL;
-  return &buf->records[ buf->recv++ ];
+  return &buf->records[ (buf->recv++ % TEST_RECORD_BUF_CNT) ];
 }
 
 static FD_FN_UNUSED void